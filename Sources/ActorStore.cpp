@@ -0,0 +1,285 @@
+/*
+	File:	ActorStore.cpp
+	Version:	1.0
+	Date:	18th October 2026
+	Author:	agent
+
+	Exposes:	Implementation of the ActorStore class.
+	Requires:	X3DAudio (for X3DAUDIO_VECTOR).
+
+	Description:
+	The arrays of a store of moving actors, and the loops over them.
+	*	See ActorStore.hpp for details.
+*/
+
+// System includes.
+#include <Windows.h>
+#include <X3DAudio.h>
+#include <math.h>
+#include <float.h>
+#include <vector>
+#include <algorithm>
+using std::vector;
+
+// Application includes.
+#include "ActorStore.hpp"
+
+// Anonymous namespace for the helper functions
+namespace
+{
+	// Orders actors by their squared distances, held apart from them
+	struct NearerThan
+	{
+		const float *Distance;
+		inline bool operator()(UINT32 First, UINT32 Second) const { return Distance[First] < Distance[Second]; }
+	};
+}
+// end anonymous namespace.
+
+
+
+// Function:		ActorStore() - ActorStore constructor
+// Description:		Creates an empty store
+// In:				N/a
+// Out:				N/a
+ActorStore::ActorStore()
+{
+}
+// End ActorStore constructor
+
+
+
+// Function:		Reserve(size_t) - Reserve function
+// Description:		Makes room in the arrays for a number of actors, so adding them doesn't reallocate
+// In:				size_t Count - the number of actors
+// Out:				N/a
+void ActorStore::Reserve(size_t Count)
+{
+	mPositionX.reserve(Count);
+	mPositionY.reserve(Count);
+	mPositionZ.reserve(Count);
+	mVelocityX.reserve(Count);
+	mVelocityZ.reserve(Count);
+	mTargetX.reserve(Count);
+	mTargetZ.reserve(Count);
+	mSpeed.reserve(Count);
+	mState.reserve(Count);
+	mKind.reserve(Count);
+	mEmitter.reserve(Count);
+	mArriving.reserve(Count);
+}
+// End Reserve function
+
+
+
+// Function:		Clear() - Clear function
+// Description:		Removes every actor; the memory is kept
+// In:				N/a
+// Out:				N/a
+void ActorStore::Clear()
+{
+	mPositionX.clear();
+	mPositionY.clear();
+	mPositionZ.clear();
+	mVelocityX.clear();
+	mVelocityZ.clear();
+	mTargetX.clear();
+	mTargetZ.clear();
+	mSpeed.clear();
+	mState.clear();
+	mKind.clear();
+	mEmitter.clear();
+	mArriving.clear();
+	mArrived.clear();
+}
+// End Clear function
+
+
+
+// Function:		AddActor(X3DAUDIO_VECTOR, float, BYTE) - Add Actor function
+// Description:		Adds an idle actor with no emitter
+// In:				const X3DAUDIO_VECTOR &Position - its position, float Speed - its speed in units per second,
+//					BYTE Kind - what the actor is, for its owner
+// Out:				size_t - the actor's index
+size_t ActorStore::AddActor(const X3DAUDIO_VECTOR &Position, float Speed, BYTE Kind)
+{
+	mPositionX.push_back(Position.x);
+	mPositionY.push_back(Position.y);
+	mPositionZ.push_back(Position.z);
+	mVelocityX.push_back(0.0f);
+	mVelocityZ.push_back(0.0f);
+	mTargetX.push_back(Position.x);
+	mTargetZ.push_back(Position.z);
+	mSpeed.push_back(Speed);
+	mState.push_back(ACTOR_IDLE);
+	mKind.push_back(Kind);
+	mEmitter.push_back(ACTOR_NO_EMITTER);
+	mArriving.push_back(0);
+	return mPositionX.size() - 1;
+}
+// End AddActor function
+
+
+
+// Function:		SetTarget(size_t, float, float) - Set Target function
+// Description:		Sends an actor towards a target at its speed; an actor sent to where it is arrives in the next move
+// In:				size_t Actor - the actor, float X, float Z - the target
+// Out:				N/a
+void ActorStore::SetTarget(size_t Actor, float X, float Z)
+{
+	mTargetX[Actor] = X;
+	mTargetZ[Actor] = Z;
+	mState[Actor] = ACTOR_MOVING;
+
+	// The velocity is the speed along the direction to the target
+	float ToX = X - mPositionX[Actor];
+	float ToZ = Z - mPositionZ[Actor];
+	float Distance = sqrtf((ToX * ToX) + (ToZ * ToZ));
+	if (Distance > 0.0f)
+	{
+		mVelocityX[Actor] = ToX * (mSpeed[Actor] / Distance);
+		mVelocityZ[Actor] = ToZ * (mSpeed[Actor] / Distance);
+	}
+	else
+	{
+		mVelocityX[Actor] = 0.0f;
+		mVelocityZ[Actor] = 0.0f;
+	}
+}
+// End SetTarget function
+
+
+
+// Function:		Stop(size_t) - Stop function
+// Description:		Stops an actor where it is, with no target
+// In:				size_t Actor - the actor
+// Out:				N/a
+void ActorStore::Stop(size_t Actor)
+{
+	mTargetX[Actor] = mPositionX[Actor];
+	mTargetZ[Actor] = mPositionZ[Actor];
+	mVelocityX[Actor] = 0.0f;
+	mVelocityZ[Actor] = 0.0f;
+	mState[Actor] = ACTOR_IDLE;
+}
+// End Stop function
+
+
+
+// Function:		Update(float) - Update function
+// Description:		Moves every actor for a time, putting those within a step of their targets on them; GetArrived then
+//					lists the actors that arrived
+// In:				float DeltaTime - the time in seconds
+// Out:				size_t - the number of actors that arrived
+size_t ActorStore::Update(float DeltaTime)
+{
+	mArrived.clear();
+	const size_t Count = mPositionX.size();
+	if (Count == 0)
+	{
+		return 0;
+	}
+
+	// The arrays are read through pointers so the compiler knows the loop doesn't change their sizes
+	float *PositionX = &mPositionX[0];
+	float *PositionZ = &mPositionZ[0];
+	float *VelocityX = &mVelocityX[0];
+	float *VelocityZ = &mVelocityZ[0];
+	const float *TargetX = &mTargetX[0];
+	const float *TargetZ = &mTargetZ[0];
+	const float *Speed = &mSpeed[0];
+	UINT32 *State = &mState[0];
+	UINT32 *Arriving = &mArriving[0];
+
+	// Test each actor for arrival and move it, with selects rather than branches
+	UINT32 Arrivals = 0;
+	for (size_t i = 0; i < Count; i++)
+	{
+		float ToX = TargetX[i] - PositionX[i];
+		float ToZ = TargetZ[i] - PositionZ[i];
+		float StepLength = Speed[i] * DeltaTime;
+		UINT32 Arrives = UINT32((((ToX * ToX) + (ToZ * ToZ)) <= (StepLength * StepLength)) & (State[i] == ACTOR_MOVING));
+		PositionX[i] = Arrives ? TargetX[i] : PositionX[i] + (VelocityX[i] * DeltaTime);
+		PositionZ[i] = Arrives ? TargetZ[i] : PositionZ[i] + (VelocityZ[i] * DeltaTime);
+		VelocityX[i] = Arrives ? 0.0f : VelocityX[i];
+		VelocityZ[i] = Arrives ? 0.0f : VelocityZ[i];
+		State[i] = Arrives ? UINT32(ACTOR_ARRIVED) : State[i];
+		Arriving[i] = Arrives;
+		Arrivals += Arrives;
+	}
+
+	// Few actors arrive in an update, so they are only listed when there are some
+	if (Arrivals > 0)
+	{
+		for (size_t i = 0; i < Count; i++)
+		{
+			if (Arriving[i] != 0)
+			{
+				mArrived.push_back(UINT32(i));
+			}
+		}
+	}
+	return Arrivals;
+}
+// End Update function
+
+
+
+// Function:		FindNearest(float, float, BYTE, size_t, vector<UINT32>) - Find Nearest function
+// Description:		Finds the actors of a kind nearest a point along the x and z plane, nearest first
+// In:				float X, float Z - the point, BYTE Kind - the kind, size_t Count - the most actors to find,
+//					vector<UINT32> &Nearest - set to the actors found
+// Out:				N/a
+void ActorStore::FindNearest(float X, float Z, BYTE Kind, size_t Count, vector<UINT32> &Nearest)
+{
+	Nearest.clear();
+	const size_t ActorCount = mPositionX.size();
+	if ((ActorCount == 0) || (Count == 0))
+	{
+		return;
+	}
+
+	// The squared distance to every actor, with the actors of other kinds put furthest away
+	mDistance.resize(ActorCount);
+	mCandidates.resize(ActorCount);
+	const float *PositionX = &mPositionX[0];
+	const float *PositionZ = &mPositionZ[0];
+	const BYTE *ActorKind = &mKind[0];
+	float *Distance = &mDistance[0];
+	for (size_t i = 0; i < ActorCount; i++)
+	{
+		float ToX = PositionX[i] - X;
+		float ToZ = PositionZ[i] - Z;
+		Distance[i] = (ActorKind[i] == Kind) ? ((ToX * ToX) + (ToZ * ToZ)) : FLT_MAX;
+		mCandidates[i] = UINT32(i);
+	}
+
+	// Only the nearest are put in order
+	if (Count > ActorCount)
+	{
+		Count = ActorCount;
+	}
+	NearerThan Order = { Distance };
+	std::partial_sort(mCandidates.begin(), mCandidates.begin() + Count, mCandidates.end(), Order);
+	for (size_t i = 0; (i < Count) && (Distance[mCandidates[i]] < FLT_MAX); i++)
+	{
+		Nearest.push_back(mCandidates[i]);
+	}
+}
+// End FindNearest function
+
+
+
+// Function:		GetMemoryUsed() - Get Memory Used function
+// Description:		Works out the memory the arrays take
+// In:				N/a
+// Out:				size_t - the bytes used
+size_t ActorStore::GetMemoryUsed() const
+{
+	return sizeof(ActorStore) +
+		(mPositionX.capacity() + mPositionY.capacity() + mPositionZ.capacity() + mVelocityX.capacity() + mVelocityZ.capacity() +
+		mTargetX.capacity() + mTargetZ.capacity() + mSpeed.capacity() + mDistance.capacity()) * sizeof(float) +
+		mKind.capacity() * sizeof(BYTE) + mEmitter.capacity() * sizeof(int) +
+		(mState.capacity() + mArriving.capacity() + mArrived.capacity() + mCandidates.capacity()) * sizeof(UINT32);
+}
+// End GetMemoryUsed function
@@ -0,0 +1,150 @@
+/*
+	File:	ActorStore.hpp
+	Version:	1.0
+	Date:	18th October 2026
+	Author:	agent
+
+	Exposes:	ActorStore, ActorState.
+	Requires:	X3DAudio (for X3DAUDIO_VECTOR).
+
+	Description:
+	Holds the state of many moving actors, such as a swarm of critters, as a structure of arrays rather than an object for each:
+	one array for each of the actors' x positions, z positions, velocities, targets, speeds, states, kinds and emitter handles.
+	An actor is its index into the arrays.
+
+	The store exposes behaviour to:
+	*	Add actors at a position with a speed and kind, and send each towards a target along the x and z plane;
+	*	Move every actor for a time, in a single loop over the arrays: an actor within a step of its target is put on it and
+		stopped, and the others move on by their velocity. The loop has no calls and no branches other than selects, and reads
+		and writes each array in order, so it streams through memory and can be vectorised; an actor that isn't moving has no
+		velocity, so it is moved by nothing rather than skipped;
+	*	List the actors that arrived at their targets in the last move, so their owner can give them new ones;
+	*	Find the actors of a kind nearest to a point, e.g. to give the nearest the few voices there are to play them;
+	*	Give each actor the handle of the emitter playing it, which is kept for the actor's owner; ACTOR_NO_EMITTER if none.
+
+	Actors move at a fixed height; only their x and z positions change.
+*/
+
+// Define the class
+#ifndef __ACTORSTORE_HPP__
+#define __ACTORSTORE_HPP__
+
+// System includes.
+#include <Windows.h>
+#include <X3DAudio.h>
+#include <vector>
+using std::vector;
+
+// The emitter handle of an actor that has no emitter
+#define ACTOR_NO_EMITTER -1
+
+// The states of an actor
+enum ActorState
+{
+	ACTOR_IDLE,			// Standing still, with no target
+	ACTOR_MOVING,		// Heading for its target
+	ACTOR_ARRIVED		// Standing on its target
+};
+
+// The ActorStore class
+class ActorStore
+{
+// Public Member functions and variables
+public:
+
+	// Function:		ActorStore() - ActorStore constructor
+	// Description:		Creates an empty store
+	// In:				N/a
+	// Out:				N/a
+	ActorStore();
+
+	// Function:		Reserve(size_t) - Reserve function
+	// Description:		Makes room in the arrays for a number of actors, so adding them doesn't reallocate
+	// In:				size_t Count - the number of actors
+	// Out:				N/a
+	void Reserve(size_t Count);
+
+	// Function:		Clear() - Clear function
+	// Description:		Removes every actor; the memory is kept
+	// In:				N/a
+	// Out:				N/a
+	void Clear();
+
+	// Function:		AddActor(X3DAUDIO_VECTOR, float, BYTE) - Add Actor function
+	// Description:		Adds an idle actor with no emitter
+	// In:				const X3DAUDIO_VECTOR &Position - its position, float Speed - its speed in units per second,
+	//					BYTE Kind - what the actor is, for its owner
+	// Out:				size_t - the actor's index
+	size_t AddActor(const X3DAUDIO_VECTOR &Position, float Speed, BYTE Kind);
+
+	// Function:		SetTarget(size_t, float, float) - Set Target function
+	// Description:		Sends an actor towards a target at its speed; an actor sent to where it is arrives in the next move
+	// In:				size_t Actor - the actor, float X, float Z - the target
+	// Out:				N/a
+	void SetTarget(size_t Actor, float X, float Z);
+
+	// Function:		Stop(size_t) - Stop function
+	// Description:		Stops an actor where it is, with no target
+	// In:				size_t Actor - the actor
+	// Out:				N/a
+	void Stop(size_t Actor);
+
+	// Function:		Update(float) - Update function
+	// Description:		Moves every actor for a time, putting those within a step of their targets on them; GetArrived then
+	//					lists the actors that arrived
+	// In:				float DeltaTime - the time in seconds
+	// Out:				size_t - the number of actors that arrived
+	size_t Update(float DeltaTime);
+
+	// Function:		FindNearest(float, float, BYTE, size_t, vector<UINT32>) - Find Nearest function
+	// Description:		Finds the actors of a kind nearest a point along the x and z plane, nearest first
+	// In:				float X, float Z - the point, BYTE Kind - the kind, size_t Count - the most actors to find,
+	//					vector<UINT32> &Nearest - set to the actors found
+	// Out:				N/a
+	void FindNearest(float X, float Z, BYTE Kind, size_t Count, vector<UINT32> &Nearest);
+
+	// Function:		GetMemoryUsed() - Get Memory Used function
+	// Description:		Works out the memory the arrays take
+	// In:				N/a
+	// Out:				size_t - the bytes used
+	size_t GetMemoryUsed() const;
+
+	// Accessors for the actors
+	inline size_t GetCount() const { return mPositionX.size(); }
+	inline X3DAUDIO_VECTOR GetPosition(size_t Actor) const { X3DAUDIO_VECTOR Position = { mPositionX[Actor], mPositionY[Actor], mPositionZ[Actor] }; return Position; }
+	inline ActorState GetState(size_t Actor) const { return ActorState(mState[Actor]); }
+	inline BYTE GetKind(size_t Actor) const { return mKind[Actor]; }
+	inline int GetEmitter(size_t Actor) const { return mEmitter[Actor]; }
+	inline void SetEmitter(size_t Actor, int Handle) { mEmitter[Actor] = Handle; }
+	inline const vector<UINT32>& GetArrived() const { return mArrived; }
+
+// Private member functions and variables
+private:
+
+	// The actors' positions, velocities in units per second, targets and speeds
+	vector<float> mPositionX;
+	vector<float> mPositionY;
+	vector<float> mPositionZ;
+	vector<float> mVelocityX;
+	vector<float> mVelocityZ;
+	vector<float> mTargetX;
+	vector<float> mTargetZ;
+	vector<float> mSpeed;
+
+	// The actors' ActorState values and kinds, and the handles of the emitters playing them. The states are as wide as the
+	// floats, so the update loop works on whole lanes, and aren't bytes, which the compiler must assume can alias the floats
+	vector<UINT32> mState;
+	vector<BYTE> mKind;
+	vector<int> mEmitter;
+
+	// Set for each actor that arrived in the last update, and the list of them
+	vector<UINT32> mArriving;
+	vector<UINT32> mArrived;
+
+	// The squared distances and actors FindNearest sorts
+	vector<float> mDistance;
+	vector<UINT32> mCandidates;
+};
+// end ActorStore class.
+
+#endif
@@ -0,0 +1,1623 @@
+/*
+	File:	BenchmarkSuite.cpp
+	Version:	1.0
+	Date:	18th October 2026
+	Author:	agent
+
+	Exposes:	Implementation of the BenchmarkSuite class.
+	Requires:	Room, RoomGrid, RoomLayout, PathFinder, ActorStore, CritterSwarm, Emitter, XACore, XASound, NullSourceVoice, PCMWave, WaveFileManager, GameTimer, Spatializer, stu::v3f, stu::batch.
+
+	Description:
+	Microbenchmarks of the framework and game hot paths.
+	*	See BenchmarkSuite.hpp for details.
+*/
+
+// System includes.
+#include <windows.h>
+#include <X3DAudio.h>
+#include <math.h>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <ctime>
+using std::string;
+using std::vector;
+using std::ofstream;
+using std::istringstream;
+using std::ostringstream;
+using std::endl;
+
+// Framework includes.
+#include "XACore.hpp"
+#include "XASound.hpp"
+#include "NullSourceVoice.hpp"
+#include "PCMWave.hpp"
+#include "WaveFileManager.hpp"
+#include "GameTimer.h"
+#include "Spatializer.hpp"
+using AllanMilne::Audio::XACore;
+using AllanMilne::Audio::Spatializer;
+using AllanMilne::Audio::XASound;
+using AllanMilne::Audio::NullSourceVoice;
+using AllanMilne::Audio::PCMWave;
+using AllanMilne::Audio::WaveFmt;
+using AllanMilne::Audio::WaveFileManager;
+
+// Application includes.
+#include "BenchmarkSuite.hpp"
+#include "GhostEscape.hpp"
+#include "Room.hpp"
+#include "RoomGrid.hpp"
+#include "RoomLayout.hpp"
+#include "PathFinder.hpp"
+#include "ActorStore.hpp"
+#include "CritterSwarm.hpp"
+#include "Emitter.hpp"
+#include "DistanceCurves.hpp"
+#include "StuVector3.hpp"
+#include "StuVector3Batch.hpp"
+using stu::v3f;
+using stu::v3fView;
+
+// Anonymous namespace for the benchmark files and helper functions
+namespace
+{
+	// A wave the room also loads, so it is already in the WaveFileManager cache
+	const string CachedWaveFile = "Sounds/BatsSound.wav";
+	// A wave nothing in the game loads, so loading it always misses the cache and it can be unloaded safely
+	const string UncachedWaveFile = "Sounds/DoorShut.wav";
+
+	// The seed of the benchmark room
+	const unsigned int RoomSeed = 1;
+
+	// The sizes of the benchmark grids
+	const int GridSizes[BENCHMARK_GRID_SIZES] = { 16, 256, 4096 };
+
+	// A xorshift generator for the grid layouts and lookups; cheap enough not to hide the cost of a lookup
+	inline unsigned int NextRandom(unsigned int &State)
+	{
+		State ^= State << 13;
+		State ^= State >> 17;
+		State ^= State << 5;
+		return State;
+	}
+
+	// The number of actors in each actor store
+	const size_t ActorCounts[BENCHMARK_ACTOR_STORES] = { 1000, 100000 };
+
+	// A random room position along an axis of a room of the given size, in sixteenths of a unit
+	inline float RandomRoomPosition(unsigned int &State, int Size)
+	{
+		return 1.0f + float(NextRandom(State) % (Size * 16)) / 16.0f;
+	}
+
+	// Writes the text layout of a mansion of BENCHMARK_MANSION_ROOMS rooms from 16 to 64 cells square, each with a door, the ghost's
+	// stages, a dozen obstacles and three emitters
+	string MansionText()
+	{
+		const char *Obstacles[] = { "wall", "table", "piano", "radio", "typewriter" };
+		const char *ObstacleSounds[] = { "", "TableCollision", "PianoCollision", "RadioCollision", "TypewriterCollision" };
+		const char *Stages[] = { "knocking", "piano", "typewriter", "radio" };
+		unsigned int State = RoomSeed;
+		ostringstream Text;
+		Text << "# A generated mansion for the layout benchmarks\n";
+		for (int Room = 0; Room < BENCHMARK_MANSION_ROOMS; Room++)
+		{
+			int Size = 16 + (Room % 4) * 16;
+			Text << "room Room" << Room << ' ' << Size << ' ' << Size << '\n';
+			Text << "door " << Size / 2 << " 0\n";
+			Text << "emitter outdoor " << Size / 2 << " -1.5 Sounds/OutdoorSound.wav\n";
+			for (int i = 0; i < 12; i++)
+			{
+				int Type = int(NextRandom(State) % 5);
+				Text << "obstacle " << Obstacles[Type] << ' ' << 2 + NextRandom(State) % (Size - 4) << ' '
+					<< 2 + NextRandom(State) % (Size - 4) << ' ' << 2 + NextRandom(State) % 3 << ' ' << 2 + NextRandom(State) % 3;
+				if (Type > 0)
+				{
+					Text << " Sounds/" << ObstacleSounds[Type] << ".wav";
+				}
+				Text << '\n';
+			}
+			for (int i = 0; i < 4; i++)
+			{
+				Text << "stage " << Stages[i] << ' ' << 2 + NextRandom(State) % (Size - 4) << ' ' << 2 + NextRandom(State) % (Size - 4) << '\n';
+			}
+			Text << "emitter critter " << Size / 4 << ' ' << Size / 2 << " Sounds/BatsSound.wav\n";
+			Text << "emitter critter " << (3 * Size) / 4 << ' ' << Size / 2 << " Sounds/MiceSound.wav\n";
+		}
+		return Text.str();
+	}
+
+	// The CPU time used by the calling thread, in seconds
+	double ThreadCpuTime()
+	{
+		FILETIME Creation, Exit, Kernel, User;
+		if (!GetThreadTimes(GetCurrentThread(), &Creation, &Exit, &Kernel, &User))
+		{
+			return 0.0;
+		}
+		ULARGE_INTEGER KernelTime, UserTime;
+		KernelTime.LowPart = Kernel.dwLowDateTime;
+		KernelTime.HighPart = Kernel.dwHighDateTime;
+		UserTime.LowPart = User.dwLowDateTime;
+		UserTime.HighPart = User.dwHighDateTime;
+		// The times are in 100 nanosecond units
+		return double(KernelTime.QuadPart + UserTime.QuadPart) * 1.0e-7;
+	}
+
+	// Write a string as a JSON string; the benchmark names and options need no escaping other than quotes and backslashes
+	void WriteJsonString(std::ostream &Json, const string &Text)
+	{
+		Json << '"';
+		for (auto Character = Text.begin(); Character != Text.end(); ++Character)
+		{
+			if ((*Character == '"') || (*Character == '\\'))
+			{
+				Json << '\\';
+			}
+			Json << *Character;
+		}
+		Json << '"';
+	}
+}
+// end anonymous namespace.
+
+
+
+// Function:		BenchmarkSuite() - BenchmarkSuite constructor
+// Description:		Registers the benchmarks and sets the default options; nothing is created until Run or RunBenchmarks is called
+// In:				N/a
+// Out:				N/a
+BenchmarkSuite::BenchmarkSuite()
+	: mMinTime(BENCHMARK_MIN_TIME), mRepetitions(1), mRoom(NULL), mTickRoom(NULL), mEmitter(NULL), mSound(NULL), mActorRandom(RoomSeed), mSwarm(NULL), mSpatializer(NULL), mMemoryBytes(0), mItems(0), mMixMacs(0.0), mSink(0.0f)
+{
+	const Benchmark Benchmarks[] =
+	{
+		{ "PCMWave/LoadFromDisk", &BenchmarkSuite::LoadWaveFromDisk },
+		{ "PCMWave/LoadFromMemory", &BenchmarkSuite::LoadWaveFromMemory },
+		{ "WaveFileManager/LoadWaveHit", &BenchmarkSuite::LoadWaveHit },
+		{ "WaveFileManager/LoadWaveMiss", &BenchmarkSuite::LoadWaveMiss },
+		{ "v3f/Arithmetic", &BenchmarkSuite::VectorArithmetic },
+		{ "v3f/Normalise", &BenchmarkSuite::VectorNormalise },
+		{ "v3f/Distance", &BenchmarkSuite::VectorDistance },
+		{ "v3f/PerObject/Distance/1024", &BenchmarkSuite::PerObjectDistance },
+		{ "v3f/PerObject/Normalise/1024", &BenchmarkSuite::PerObjectNormalise },
+		{ "v3f/PerObject/Dot/1024", &BenchmarkSuite::PerObjectDot },
+		{ "v3f/PerObject/Lerp/1024", &BenchmarkSuite::PerObjectLerp },
+		{ "v3fBatch/Distance/1024", &BenchmarkSuite::BatchDistance },
+		{ "v3fBatch/Normalise/1024", &BenchmarkSuite::BatchNormalise },
+		{ "v3fBatch/Dot/1024", &BenchmarkSuite::BatchDot },
+		{ "v3fBatch/Lerp/1024", &BenchmarkSuite::BatchLerp },
+		{ "Room/HitWallOrDoor", &BenchmarkSuite::HitWallOrDoor },
+		{ "RoomGrid/GetCell/16", &BenchmarkSuite::GridCell16 },
+		{ "RoomGrid/GetCell/256", &BenchmarkSuite::GridCell256 },
+		{ "RoomGrid/GetCell/4096", &BenchmarkSuite::GridCell4096 },
+		{ "RoomGrid/IsBlocked/16", &BenchmarkSuite::GridBlocked16 },
+		{ "RoomGrid/IsBlocked/256", &BenchmarkSuite::GridBlocked256 },
+		{ "RoomGrid/IsBlocked/4096", &BenchmarkSuite::GridBlocked4096 },
+		{ "RoomLayout/LoadMansionText", &BenchmarkSuite::LoadMansionText },
+		{ "RoomLayout/LoadMansionBinary", &BenchmarkSuite::LoadMansionBinary },
+		{ "RoomLayout/RasterizeMansion", &BenchmarkSuite::RasterizeMansion },
+		{ "PathFinder/AStar/16", &BenchmarkSuite::AStar16 },
+		{ "PathFinder/AStar/1024", &BenchmarkSuite::AStar1024 },
+		{ "PathFinder/FlowFieldBuild/16", &BenchmarkSuite::FlowFieldBuild16 },
+		{ "PathFinder/FlowFieldBuild/1024", &BenchmarkSuite::FlowFieldBuild1024 },
+		{ "PathFinder/FlowDirection/16", &BenchmarkSuite::FlowDirection16 },
+		{ "PathFinder/FlowDirection/1024", &BenchmarkSuite::FlowDirection1024 },
+		{ "ActorStore/Update/1000", &BenchmarkSuite::ActorUpdate1000 },
+		{ "ActorStore/Update/100000", &BenchmarkSuite::ActorUpdate100000 },
+		{ "CritterSwarm/Update/1000", &BenchmarkSuite::SwarmUpdate },
+		{ "Spatializer/Batch/256", &BenchmarkSuite::SpatializeBatch },
+		{ "X3DAudio/Calculate/256", &BenchmarkSuite::SpatializeX3DAudio },
+		{ "PerEmitter/Tick/10", &BenchmarkSuite::PerEmitterTick10 },
+		{ "PerEmitter/Tick/100", &BenchmarkSuite::PerEmitterTick100 },
+		{ "PerEmitter/Tick/1000", &BenchmarkSuite::PerEmitterTick1000 },
+		{ "Emitter/UpdateEmitter", &BenchmarkSuite::UpdateEmitter },
+		{ "Emitter/StaticPose/Calculate", &BenchmarkSuite::StaticPoseCalculate },
+		{ "Emitter/StaticPose/Table", &BenchmarkSuite::StaticPoseTable },
+		{ "Emitter/StaticPose/Walk/Calculate", &BenchmarkSuite::WalkPoseCalculate },
+		{ "Emitter/StaticPose/Walk/Table", &BenchmarkSuite::WalkPoseTable },
+		{ "XASound/Apply3D", &BenchmarkSuite::Apply3D },
+		{ "XASound/HeartbeatFrame", &BenchmarkSuite::HeartbeatFrame },
+		{ "Room/UpdateRoom", &BenchmarkSuite::UpdateRoom, &BenchmarkSuite::PrepareTickRoom }
+	};
+	mBenchmarks.assign(Benchmarks, Benchmarks + sizeof(Benchmarks) / sizeof(Benchmarks[0]));
+
+	SecureZeroMemory(&mListener, sizeof(X3DAUDIO_LISTENER));
+	SecureZeroMemory(&mEmitterSettings, sizeof(X3DAUDIO_EMITTER));
+	SecureZeroMemory(&mSpatialListener, sizeof(X3DAUDIO_LISTENER));
+	SecureZeroMemory(&mTickListener, sizeof(X3DAUDIO_LISTENER));
+	SecureZeroMemory(&mPoseListener, sizeof(X3DAUDIO_LISTENER));
+	for (int i = 0; i < 2; i++)
+	{
+		mPoseSounds[i] = NULL;
+		mPoseEmitters[i] = NULL;
+	}
+	SecureZeroMemory(&mSpatialCone, sizeof(X3DAUDIO_CONE));
+}
+// End BenchmarkSuite constructor
+
+
+
+// Function:		~BenchmarkSuite() - BenchmarkSuite destructor
+// Description:		Deletes anything left by the benchmarks and switches the simulated clock off
+// In:				N/a
+// Out:				N/a
+BenchmarkSuite::~BenchmarkSuite()
+{
+	TearDown();
+}
+// End BenchmarkSuite destructor
+
+
+
+// Function:		Run(string) - Run function
+// Description:		Reads the options from the command line, runs the benchmarks and writes the JSON results
+// In:				const string &CommandLine - the application's command line
+// Out:				int - the application exit code; 0 if the benchmarks ran, 1 if the options were invalid or a benchmark failed
+int BenchmarkSuite::Run(const string &CommandLine)
+{
+	string Filter;
+	string OutFile;
+
+	istringstream Arguments(CommandLine);
+	string Option;
+	while (Arguments >> Option)
+	{
+		bool Valid = true;
+		if (Option == "-benchmark")
+		{
+			continue;
+		}
+		else if (Option == "-filter")
+		{
+			Valid = !(Arguments >> Filter).fail();
+		}
+		else if (Option == "-mintime")
+		{
+			Valid = (Arguments >> mMinTime) && (mMinTime > 0.0);
+		}
+		else if (Option == "-repetitions")
+		{
+			Valid = (Arguments >> mRepetitions) && (mRepetitions > 0);
+		}
+		else if (Option == "-out")
+		{
+			Valid = !(Arguments >> OutFile).fail();
+		}
+		else
+		{
+			Valid = false;
+		}
+
+		if (!Valid)
+		{
+			std::cerr << "Benchmark run: invalid option " << Option << endl;
+			return 1;
+		}
+	}
+
+	bool Ok = RunBenchmarks(Filter);
+
+	if (OutFile.empty())
+	{
+		WriteJson(std::cout);
+	}
+	else
+	{
+		ofstream Json(OutFile.c_str());
+		if (!Json.is_open())
+		{
+			std::cerr << "Benchmark run: could not create " << OutFile << endl;
+			return 1;
+		}
+		WriteJson(Json);
+	}
+	return Ok ? 0 : 1;
+}
+// End Run function
+
+
+
+// Function:		RunBenchmarks(string) - Run Benchmarks function
+// Description:		Creates the null audio device and runs the benchmarks whose names contain the filter; a benchmark that
+//					fails is recorded as failed and the rest still run
+// In:				const string &Filter - the text the names must contain; empty for all
+// Out:				bool - false if the null audio device could not be created or any benchmark failed
+bool BenchmarkSuite::RunBenchmarks(const string &Filter)
+{
+	// The null device has to be the first core created; the sounds would otherwise try to use a real device
+	if (!XACore::CreateInstance(true) || !XACore::GetInstance()->IsNullDevice())
+	{
+		return false;
+	}
+	if (!SetUp())
+	{
+		TearDown();
+		return false;
+	}
+
+	// A failed benchmark skips its remaining repetitions, but not the benchmarks after it
+	bool Ok = true;
+	for (auto ToRun = mBenchmarks.begin(); ToRun != mBenchmarks.end(); ++ToRun)
+	{
+		if (string(ToRun->Name).find(Filter) == string::npos)
+		{
+			continue;
+		}
+		for (unsigned int Repetition = 0; Repetition < mRepetitions; Repetition++)
+		{
+			if (!RunBenchmark(*ToRun, Repetition))
+			{
+				BenchmarkResult Result = BenchmarkResult();
+				Result.Name = ToRun->Name;
+				Result.Repetition = Repetition;
+				Result.Failed = true;
+				mResults.push_back(Result);
+				std::cerr << "Benchmark run: " << ToRun->Name << " failed" << endl;
+				Ok = false;
+				break;
+			}
+		}
+	}
+
+	TearDown();
+	return Ok;
+}
+// End RunBenchmarks function
+
+
+
+// Function:		RunBenchmark(Benchmark) - Run Benchmark function
+// Description:		Runs a benchmark with more iterations until a run takes the minimum time, and records the result, or
+//					records it as failed
+// In:				const Benchmark &ToRun - the benchmark, unsigned int Repetition - the repetition number
+// Out:				bool - false if the benchmark could not be set up or failed
+bool BenchmarkSuite::RunBenchmark(const Benchmark &ToRun, unsigned int Repetition)
+{
+	const double SecondsPerCount = GameTimer::GetSecondsPerPerformanceCount();
+	unsigned long Iterations = 1;
+	while (true)
+	{
+		NullSourceVoice::ResetCallCount();
+		mMemoryBytes = 0;
+		mItems = 0;
+		mMixMacs = 0.0;
+		if ((ToRun.Prepare != NULL) && !(this->*ToRun.Prepare)())
+		{
+			return false;
+		}
+		const __int64 StartCount = GameTimer::ReadPerformanceCounter();
+		const double StartCpu = ThreadCpuTime();
+		if (!(this->*ToRun.Function)(Iterations))
+		{
+			return false;
+		}
+		const double RealTime = double(GameTimer::ReadPerformanceCounter() - StartCount) * SecondsPerCount;
+		const double CpuTime = ThreadCpuTime() - StartCpu;
+		const unsigned long VoiceCalls = NullSourceVoice::GetCallCount();
+
+		if ((RealTime >= mMinTime) || (Iterations >= BENCHMARK_MAX_ITERATIONS))
+		{
+			BenchmarkResult Result;
+			Result.Name = ToRun.Name;
+			Result.Repetition = Repetition;
+			Result.Iterations = Iterations;
+			Result.RealTime = RealTime * 1.0e9 / double(Iterations);
+			Result.CpuTime = CpuTime * 1.0e9 / double(Iterations);
+			Result.VoiceCalls = double(VoiceCalls) / double(Iterations);
+			Result.MemoryBytes = double(mMemoryBytes);
+			Result.ItemsPerSecond = (RealTime > 0.0) ? double(mItems) * double(Iterations) / RealTime : 0.0;
+			Result.MixMacs = mMixMacs;
+			Result.Failed = false;
+			mResults.push_back(Result);
+			return true;
+		}
+
+		// Aim a little past the minimum time from the rate so far, growing by at most 10 times as a short run's time is unreliable
+		double Multiplier = (RealTime > 0.0) ? (mMinTime * 1.4 / RealTime) : 10.0;
+		if (Multiplier > 10.0)
+		{
+			Multiplier = 10.0;
+		}
+		double Next = double(Iterations) * Multiplier;
+		if (Next > double(BENCHMARK_MAX_ITERATIONS))
+		{
+			Next = double(BENCHMARK_MAX_ITERATIONS);
+		}
+		Iterations = (Next > double(Iterations)) ? (unsigned long)Next : Iterations + 1;
+	}
+}
+// End RunBenchmark function
+
+
+
+// Function:		SetUp() / TearDown() - Set Up and Tear Down functions
+// Description:		Create the room, emitter and sounds shared by the benchmarks, and delete them
+// In:				N/a
+// Out:				bool - false if the room or sounds could not be created
+bool BenchmarkSuite::SetUp()
+{
+	// The simulated clock keeps the room's timers the same on every run; the benchmarks are timed on the real clock
+	GameTimer::UseSimulatedClock(true);
+
+	// As HeadlessDriver::RunPlaythrough does before the first tick
+	mRoom = new Room(RoomSeed);
+	if (!mRoom->IsValid())
+	{
+		return false;
+	}
+	mRoom->Reset();
+
+	mSound = new XASound(CachedWaveFile);
+	if (!mSound->IsValid())
+	{
+		return false;
+	}
+
+	// A listener at the centre of the room facing forward, with an emitter a few steps in front of it
+	mListener.OrientFront.z = 1.0f;
+	mListener.OrientTop.y = 1.0f;
+	mListener.Position.x = float(ROOM_X_SIZE / 2);
+	mListener.Position.z = float(ROOM_Z_SIZE / 2);
+	X3DAUDIO_VECTOR EmitterPosition = mListener.Position;
+	EmitterPosition.z += 3.0f;
+	mEmitter = new Emitter(mSound, EmitterPosition, &mListener, true);
+	mEmitter->PlayEmitter();
+
+	// The same emitter settings the Emitter class creates, for timing the sound's Apply3D on its own
+	mEmitterSettings.ChannelCount = mSound->GetChannelCount();
+	mEmitterSettings.CurveDistanceScaler = 1.0f;
+	mEmitterSettings.Position = EmitterPosition;
+
+	// Grids walled round the edges, with a scattering of obstacles covering about a quarter of the floor
+	unsigned int State = RoomSeed;
+	for (int i = 0; i < BENCHMARK_GRID_SIZES; i++)
+	{
+		RoomGrid &Grid = mGrids[i];
+		int Size = GridSizes[i];
+		Grid.Resize(Size, Size);
+		Grid.FillRect(0, 0, Size - 1, 0, WALL_VALUE);
+		Grid.FillRect(0, Size - 1, Size - 1, Size - 1, WALL_VALUE);
+		Grid.FillRect(0, 0, 0, Size - 1, WALL_VALUE);
+		Grid.FillRect(Size - 1, 0, Size - 1, Size - 1, WALL_VALUE);
+		for (int Obstacle = 0; Obstacle < (Size * Size) / 16; Obstacle++)
+		{
+			int X = int(NextRandom(State) % Size);
+			int Z = int(NextRandom(State) % Size);
+			Grid.FillRect(X, Z, X + 1, Z + 1, BYTE(TABLE_VALUE + NextRandom(State) % 4));
+		}
+	}
+
+	// The path maps: the default room, and a map walled round the edges with about a quarter of it covered in obstacles up to 8 cells across.
+	// Each has its start and goal cells chosen at random from its free cells, with every goal different
+	RoomLayout::GetDefault().Rasterize(0, mPathMaps[0]);
+	RoomGrid &Generated = mPathMaps[1];
+	const int MapSize = BENCHMARK_PATH_MAP_SIZE;
+	Generated.Resize(MapSize, MapSize);
+	Generated.FillRect(0, 0, MapSize - 1, 0, WALL_VALUE);
+	Generated.FillRect(0, MapSize - 1, MapSize - 1, MapSize - 1, WALL_VALUE);
+	Generated.FillRect(0, 0, 0, MapSize - 1, WALL_VALUE);
+	Generated.FillRect(MapSize - 1, 0, MapSize - 1, MapSize - 1, WALL_VALUE);
+	for (int Obstacle = 0; Obstacle < (MapSize * MapSize) / 80; Obstacle++)
+	{
+		int X = int(NextRandom(State) % MapSize);
+		int Z = int(NextRandom(State) % MapSize);
+		int Width = 1 + int(NextRandom(State) % 8);
+		int Depth = 1 + int(NextRandom(State) % 8);
+		Generated.FillRect(X, Z, X + Width - 1, Z + Depth - 1, BYTE(TABLE_VALUE + NextRandom(State) % 4));
+	}
+	for (int Map = 0; Map < BENCHMARK_PATH_MAPS; Map++)
+	{
+		const RoomGrid &TheMap = mPathMaps[Map];
+		mPathFinders[Map].SetGrid(TheMap);
+		// Each field is built whole in one go
+		mPathFinders[Map].SetFlowBudget(size_t(TheMap.GetWidth()) * size_t(TheMap.GetDepth()));
+		mPathStarts[Map].clear();
+		mPathGoals[Map].clear();
+		while (mPathGoals[Map].size() < BENCHMARK_PATH_QUERIES)
+		{
+			GridCell Cell = { int(NextRandom(State) % TheMap.GetWidth()), int(NextRandom(State) % TheMap.GetDepth()) };
+			if (TheMap.IsBlocked(Cell.X, Cell.Z))
+			{
+				continue;
+			}
+			if (mPathStarts[Map].size() == mPathGoals[Map].size())
+			{
+				mPathStarts[Map].push_back(Cell);
+				continue;
+			}
+			bool Used = false;
+			for (auto Goal = mPathGoals[Map].begin(); (Goal != mPathGoals[Map].end()) && (!Used); ++Goal)
+			{
+				Used = (Goal->X == Cell.X) && (Goal->Z == Cell.Z);
+			}
+			if (!Used)
+			{
+				mPathGoals[Map].push_back(Cell);
+			}
+		}
+	}
+
+	// The actor stores, their actors scattered over the room at the critters' speeds, each heading for another random place
+	for (int Store = 0; Store < BENCHMARK_ACTOR_STORES; Store++)
+	{
+		ActorStore &Actors = mActorStores[Store];
+		Actors.Clear();
+		Actors.Reserve(ActorCounts[Store]);
+		for (size_t i = 0; i < ActorCounts[Store]; i++)
+		{
+			X3DAUDIO_VECTOR Position = { RandomRoomPosition(State, ROOM_X_SIZE), 0.0f, RandomRoomPosition(State, ROOM_Z_SIZE) };
+			float Speed = SWARM_MIN_SPEED + float(NextRandom(State) % 16) * ((SWARM_MAX_SPEED - SWARM_MIN_SPEED) / 16.0f);
+			size_t Actor = Actors.AddActor(Position, Speed, 0);
+			Actors.SetTarget(Actor, RandomRoomPosition(State, ROOM_X_SIZE), RandomRoomPosition(State, ROOM_Z_SIZE));
+		}
+	}
+
+	// The vectors for the vector benchmarks, scattered over the room and up to the ceiling
+	mVectorsA.resize(BENCHMARK_VECTOR_COUNT);
+	mVectorsB.resize(BENCHMARK_VECTOR_COUNT);
+	mVectorsOut.resize(BENCHMARK_VECTOR_COUNT);
+	mVectorResults.resize(BENCHMARK_VECTOR_COUNT);
+	for (size_t i = 0; i < BENCHMARK_VECTOR_COUNT; i++)
+	{
+		X3DAUDIO_VECTOR A = { RandomRoomPosition(State, ROOM_X_SIZE), RandomRoomPosition(State, 2), RandomRoomPosition(State, ROOM_Z_SIZE) };
+		X3DAUDIO_VECTOR B = { RandomRoomPosition(State, ROOM_X_SIZE), RandomRoomPosition(State, 2), RandomRoomPosition(State, ROOM_Z_SIZE) };
+		mVectorsA[i] = A;
+		mVectorsB[i] = B;
+		mVectorsOut[i] = A;
+	}
+
+	// The spatial emitters round a listener at the centre of the room, turned a little so its axes aren't the room's: each with
+	// the distance curves of one of the game's emitter types, and every third with a cone like Emitter::CreateEmitterCone's
+	mSpatializer = new Spatializer(XACore::GetInstance()->GetDeviceDetails().OutputFormat.dwChannelMask);
+	if (!mSpatializer->IsValid())
+	{
+		return false;
+	}
+	mSpatialListener.OrientFront.x = sinf(0.3f);
+	mSpatialListener.OrientFront.z = cosf(0.3f);
+	mSpatialListener.OrientTop.y = 1.0f;
+	mSpatialListener.Position = mListener.Position;
+	mSpatialCone.InnerAngle = 1.0f;
+	mSpatialCone.OuterAngle = 1.2f;
+	mSpatialCone.InnerVolume = 1.5f;
+	mSpatialCone.OuterVolume = 0.5f;
+	mSpatialEmitters.resize(BENCHMARK_SPATIAL_EMITTERS);
+	mSpatialEmitterList.resize(BENCHMARK_SPATIAL_EMITTERS);
+	for (size_t i = 0; i < BENCHMARK_SPATIAL_EMITTERS; i++)
+	{
+		X3DAUDIO_EMITTER &Spatial = mSpatialEmitters[i];
+		SecureZeroMemory(&Spatial, sizeof(X3DAUDIO_EMITTER));
+		Spatial.Position.x = RandomRoomPosition(State, ROOM_X_SIZE);
+		Spatial.Position.y = RandomRoomPosition(State, 2);
+		Spatial.Position.z = RandomRoomPosition(State, ROOM_Z_SIZE);
+		Spatial.OrientTop.y = 1.0f;
+		float Facing = float(NextRandom(State) % 628) / 100.0f;
+		Spatial.OrientFront.x = sinf(Facing);
+		Spatial.OrientFront.z = cosf(Facing);
+		Spatial.ChannelCount = 1;
+		Spatial.DopplerScaler = 1.0f;
+		DistanceCurveSet *Curves = DistanceCurves::GetCurveSet(EmitterType(i % EMITTER_TYPE_COUNT));
+		Spatial.CurveDistanceScaler = Curves->DistanceScaler;
+		Spatial.pVolumeCurve = Curves->Volume.GetCurve();
+		Spatial.pLFECurve = Curves->LFE.GetCurve();
+		Spatial.pCone = ((i % 3) == 0) ? &mSpatialCone : NULL;
+		mSpatialEmitterList[i] = &Spatial;
+		if (!mSpatializer->IsSupported(&Spatial, &mSpatialListener))
+		{
+			return false;
+		}
+	}
+	mSpatialMatrices.resize(BENCHMARK_SPATIAL_EMITTERS * mSpatializer->GetChannelCount());
+	mSpatialReference.resize(mSpatialMatrices.size());
+
+	// The tick emitters, playing the cached wave at random places in the room, heard by a listener at its centre; each has the
+	// distance curves of one of the game's emitter types
+	mTickListener.OrientFront.z = 1.0f;
+	mTickListener.OrientTop.y = 1.0f;
+	mTickListener.Position = mListener.Position;
+	for (size_t i = 0; i < BENCHMARK_TICK_EMITTERS; i++)
+	{
+		XASound *TickSound = new XASound(CachedWaveFile);
+		mTickSounds.push_back(TickSound);
+		if (!TickSound->IsValid())
+		{
+			return false;
+		}
+		X3DAUDIO_VECTOR Position = { RandomRoomPosition(State, ROOM_X_SIZE), 0.0f, RandomRoomPosition(State, ROOM_Z_SIZE) };
+		Emitter *TickEmitter = new Emitter(TickSound, Position, &mTickListener, true);
+		mTickEmitters.push_back(TickEmitter);
+		TickEmitter->SetEmitterType(EmitterType(i % EMITTER_TYPE_COUNT));
+		TickEmitter->PlayEmitter();
+	}
+
+	// Two still emitters by the wall in front of the room's centre, one keeping its settings in a panning table
+	mPoseListener.OrientFront.z = 1.0f;
+	mPoseListener.OrientTop.y = 1.0f;
+	mPoseListener.Position = mListener.Position;
+	for (int i = 0; i < 2; i++)
+	{
+		mPoseSounds[i] = new XASound(CachedWaveFile);
+		if (!mPoseSounds[i]->IsValid())
+		{
+			return false;
+		}
+		X3DAUDIO_VECTOR Position = { float(ROOM_X_SIZE / 2), 0.0f, float(ROOM_Z_SIZE - 2) };
+		mPoseEmitters[i] = new Emitter(mPoseSounds[i], Position, &mPoseListener, true);
+		mPoseEmitters[i]->SetEmitterType(OUTDOOR_EMITTER);
+		mPoseEmitters[i]->PlayEmitter();
+	}
+	mPoseEmitters[1]->EnablePanningTable();
+
+	// The swarm, heard by the benchmark listener at the centre of the room
+	mSwarm = new CritterSwarm(&mListener, RoomSeed, BENCHMARK_SWARM_SIZE, mRoom->GetGrid());
+	if (!mSwarm->IsValid())
+	{
+		return false;
+	}
+
+	// The mansion's layout, written as text and compiled to a binary file in the temporary folder
+	char TempFolder[MAX_PATH];
+	DWORD TempLength = GetTempPath(MAX_PATH, TempFolder);
+	if ((TempLength == 0) || (TempLength >= MAX_PATH))
+	{
+		return false;
+	}
+	mMansionTextFile = string(TempFolder) + "GhostEscapeMansion.txt";
+	mMansionBinaryFile = string(TempFolder) + "GhostEscapeMansion.layout";
+	ofstream Text(mMansionTextFile.c_str());
+	Text << MansionText();
+	Text.close();
+	if (Text.fail() || (!mMansion.Load(mMansionTextFile)) || (!mMansion.Save(mMansionBinaryFile)))
+	{
+		return false;
+	}
+	return true;
+}
+
+void BenchmarkSuite::TearDown()
+{
+	if (mSwarm != NULL)
+	{
+		mSwarm->Stop();
+		delete mSwarm;
+		mSwarm = NULL;
+	}
+	delete mSpatializer;
+	mSpatializer = NULL;
+	for (auto TickEmitter = mTickEmitters.begin(); TickEmitter != mTickEmitters.end(); ++TickEmitter)
+	{
+		(*TickEmitter)->StopEmitter();
+		delete *TickEmitter;
+	}
+	mTickEmitters.clear();
+	for (auto TickSound = mTickSounds.begin(); TickSound != mTickSounds.end(); ++TickSound)
+	{
+		delete *TickSound;
+	}
+	mTickSounds.clear();
+	for (int i = 0; i < 2; i++)
+	{
+		if (mPoseEmitters[i] != NULL)
+		{
+			mPoseEmitters[i]->StopEmitter();
+			delete mPoseEmitters[i];
+			mPoseEmitters[i] = NULL;
+		}
+		delete mPoseSounds[i];
+		mPoseSounds[i] = NULL;
+	}
+	delete mEmitter;
+	mEmitter = NULL;
+	delete mSound;
+	mSound = NULL;
+	if (mTickRoom != NULL)
+	{
+		mTickRoom->Stop();
+		delete mTickRoom;
+		mTickRoom = NULL;
+	}
+	if (mRoom != NULL)
+	{
+		mRoom->Stop();
+		delete mRoom;
+		mRoom = NULL;
+	}
+	if (!mMansionTextFile.empty())
+	{
+		DeleteFile(mMansionTextFile.c_str());
+		DeleteFile(mMansionBinaryFile.c_str());
+		mMansionTextFile.clear();
+		mMansionBinaryFile.clear();
+	}
+	GameTimer::UseSimulatedClock(false);
+}
+// End SetUp and TearDown functions
+
+
+
+// Function:		LoadWaveFromDisk(unsigned long) - benchmark
+// Description:		Parses a .wav file into a new PCMWave, bypassing the WaveFileManager cache
+// In:				unsigned long Iterations - the number of times to load the file
+// Out:				bool - false if the file could not be loaded
+bool BenchmarkSuite::LoadWaveFromDisk(unsigned long Iterations)
+{
+	for (unsigned long i = 0; i < Iterations; i++)
+	{
+		PCMWave Wave(UncachedWaveFile);
+		if (Wave.GetStatus() != PCMWave::OK)
+		{
+			return false;
+		}
+		mSink = mSink + float(Wave.GetDataSize());
+	}
+	return true;
+}
+// End LoadWaveFromDisk function
+
+
+
+// Function:		LoadWaveFromMemory(unsigned long) - benchmark
+// Description:		Creates a new PCMWave from the sample data of a wave already loaded, which copies the data
+// In:				unsigned long Iterations - the number of waves to create
+// Out:				bool - false if the source wave could not be loaded
+bool BenchmarkSuite::LoadWaveFromMemory(unsigned long Iterations)
+{
+	const PCMWave *Source = WaveFileManager::GetInstance().LoadWave(CachedWaveFile);
+	if (Source->GetStatus() != PCMWave::OK)
+	{
+		return false;
+	}
+	const WaveFmt &Format = Source->GetWaveFormat();
+	for (unsigned long i = 0; i < Iterations; i++)
+	{
+		PCMWave Wave(CachedWaveFile, Format.nChannels, Format.wBitsPerSample, Format.nSamplesPerSec, Source->GetDataSize(), Source->GetWaveData());
+		mSink = mSink + float(Wave.GetWaveData()[0]);
+	}
+	return true;
+}
+// End LoadWaveFromMemory function
+
+
+
+// Function:		LoadWaveHit(unsigned long) - benchmark
+// Description:		Looks up a wave that is already in the WaveFileManager cache
+// In:				unsigned long Iterations - the number of lookups
+// Out:				bool - true
+bool BenchmarkSuite::LoadWaveHit(unsigned long Iterations)
+{
+	WaveFileManager &Manager = WaveFileManager::GetInstance();
+	for (unsigned long i = 0; i < Iterations; i++)
+	{
+		mSink = mSink + float(Manager.LoadWave(CachedWaveFile)->GetDataSize());
+	}
+	return true;
+}
+// End LoadWaveHit function
+
+
+
+// Function:		LoadWaveMiss(unsigned long) - benchmark
+// Description:		Loads a wave that isn't in the WaveFileManager cache, then unloads it so the next load misses too
+// In:				unsigned long Iterations - the number of loads
+// Out:				bool - false if the file could not be loaded
+bool BenchmarkSuite::LoadWaveMiss(unsigned long Iterations)
+{
+	WaveFileManager &Manager = WaveFileManager::GetInstance();
+	for (unsigned long i = 0; i < Iterations; i++)
+	{
+		PCMWave *Wave = Manager.LoadWave(UncachedWaveFile);
+		bool Loaded = (Wave->GetStatus() == PCMWave::OK);
+		mSink = mSink + float(Wave->GetDataSize());
+		Manager.UnloadWave(UncachedWaveFile);
+		if (!Loaded)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+// End LoadWaveMiss function
+
+
+
+// Function:		VectorArithmetic(unsigned long) - benchmark
+// Description:		Adds, subtracts and scales vectors and takes their dot and cross products
+// In:				unsigned long Iterations - the number of sets of operations
+// Out:				bool - true
+bool BenchmarkSuite::VectorArithmetic(unsigned long Iterations)
+{
+	v3f A = { 1.0f, 2.0f, 3.0f };
+	v3f B = { -2.0f, 0.5f, 4.0f };
+	for (unsigned long i = 0; i < Iterations; i++)
+	{
+		// Move the inputs each iteration so the compiler can't work the results out once
+		A.x = float(i & 0xFF);
+		v3f Sum = A + B;
+		v3f Difference = A - B;
+		v3f Scaled = Sum * 0.5f;
+		v3f Cross = v3f::Cross(Scaled, Difference);
+		mSink = mSink + v3f::Dot(Cross, A);
+	}
+	return true;
+}
+// End VectorArithmetic function
+
+
+
+// Function:		VectorNormalise(unsigned long) - benchmark
+// Description:		Normalises a vector
+// In:				unsigned long Iterations - the number of vectors to normalise
+// Out:				bool - true
+bool BenchmarkSuite::VectorNormalise(unsigned long Iterations)
+{
+	for (unsigned long i = 0; i < Iterations; i++)
+	{
+		v3f Direction = { float(i & 0xFF) + 1.0f, 2.0f, -3.0f };
+		Direction.Normalise();
+		mSink = mSink + Direction.x;
+	}
+	return true;
+}
+// End VectorNormalise function
+
+
+
+// Function:		VectorDistance(unsigned long) - benchmark
+// Description:		Finds the distance between two points, as the room does between the player and the ghost
+// In:				unsigned long Iterations - the number of distances
+// Out:				bool - true
+bool BenchmarkSuite::VectorDistance(unsigned long Iterations)
+{
+	v3f Player = { 8.0f, 0.0f, 8.0f };
+	for (unsigned long i = 0; i < Iterations; i++)
+	{
+		v3f Ghost = { float(i & 0xF), 0.0f, 12.0f };
+		mSink = mSink + v3f::Distance(Player, Ghost);
+	}
+	return true;
+}
+// End VectorDistance function
+
+
+
+// Function:		VectorsPerObject(VectorOperation, unsigned long) / VectorsBatched(VectorOperation, unsigned long) - Vector functions
+// Description:		Do an operation on each of the BENCHMARK_VECTOR_COUNT vectors, or pairs of vectors, one at a time with v3f or
+//					with the batch functions; normalising is done in place on the output vectors
+// In:				VectorOperation Operation - the operation, unsigned long Iterations - the number of times through the vectors
+// Out:				bool - true
+bool BenchmarkSuite::VectorsPerObject(VectorOperation Operation, unsigned long Iterations)
+{
+	const size_t Count = mVectorsA.size();
+	for (unsigned long Iteration = 0; Iteration < Iterations; Iteration++)
+	{
+		for (size_t i = 0; i < Count; i++)
+		{
+			// Copy the X3DAUDIO_VECTORs into v3f objects, as the room and ghost did
+			v3f A = { mVectorsA[i].x, mVectorsA[i].y, mVectorsA[i].z };
+			v3f B = { mVectorsB[i].x, mVectorsB[i].y, mVectorsB[i].z };
+			switch (Operation)
+			{
+			case VECTOR_DISTANCE:
+				mVectorResults[i] = v3f::Distance(A, B);
+				break;
+			case VECTOR_NORMALISE:
+				{
+					v3f Out = { mVectorsOut[i].x, mVectorsOut[i].y, mVectorsOut[i].z };
+					Out.Normalise();
+					X3DAUDIO_VECTOR Result = { Out.x, Out.y, Out.z };
+					mVectorsOut[i] = Result;
+				}
+				break;
+			case VECTOR_DOT:
+				mVectorResults[i] = v3f::Dot(A, B);
+				break;
+			case VECTOR_LERP:
+				{
+					v3f Out = A + ((B - A) * 0.25f);
+					X3DAUDIO_VECTOR Result = { Out.x, Out.y, Out.z };
+					mVectorsOut[i] = Result;
+				}
+				break;
+			}
+		}
+	}
+	mSink = mSink + mVectorResults[0] + mVectorsOut[0].x;
+	return true;
+}
+
+bool BenchmarkSuite::VectorsBatched(VectorOperation Operation, unsigned long Iterations)
+{
+	// The views are of the X3DAUDIO_VECTOR arrays themselves; nothing is copied
+	const size_t Count = mVectorsA.size();
+	const v3fView A = stu::MakeView(&mVectorsA[0]);
+	const v3fView B = stu::MakeView(&mVectorsB[0]);
+	const v3fView Out = stu::MakeView(&mVectorsOut[0]);
+	for (unsigned long Iteration = 0; Iteration < Iterations; Iteration++)
+	{
+		switch (Operation)
+		{
+		case VECTOR_DISTANCE:
+			stu::batch::Distance(A, B, &mVectorResults[0], Count);
+			break;
+		case VECTOR_NORMALISE:
+			stu::batch::Normalise(Out, Count);
+			break;
+		case VECTOR_DOT:
+			stu::batch::Dot(A, B, &mVectorResults[0], Count);
+			break;
+		case VECTOR_LERP:
+			stu::batch::Lerp(A, B, 0.25f, Out, Count);
+			break;
+		}
+	}
+	mSink = mSink + mVectorResults[0] + mVectorsOut[0].x;
+	return true;
+}
+// End Vector functions
+
+
+
+// Function:		PerObject<op>(unsigned long) / Batch<op>(unsigned long) - benchmarks
+// Description:		Distance, normalise, dot product and lerp of the vectors, one at a time and batched
+// In:				unsigned long Iterations - the number of times through the vectors
+// Out:				bool - true
+bool BenchmarkSuite::PerObjectDistance(unsigned long Iterations) { return VectorsPerObject(VECTOR_DISTANCE, Iterations); }
+bool BenchmarkSuite::PerObjectNormalise(unsigned long Iterations) { return VectorsPerObject(VECTOR_NORMALISE, Iterations); }
+bool BenchmarkSuite::PerObjectDot(unsigned long Iterations) { return VectorsPerObject(VECTOR_DOT, Iterations); }
+bool BenchmarkSuite::PerObjectLerp(unsigned long Iterations) { return VectorsPerObject(VECTOR_LERP, Iterations); }
+bool BenchmarkSuite::BatchDistance(unsigned long Iterations) { return VectorsBatched(VECTOR_DISTANCE, Iterations); }
+bool BenchmarkSuite::BatchNormalise(unsigned long Iterations) { return VectorsBatched(VECTOR_NORMALISE, Iterations); }
+bool BenchmarkSuite::BatchDot(unsigned long Iterations) { return VectorsBatched(VECTOR_DOT, Iterations); }
+bool BenchmarkSuite::BatchLerp(unsigned long Iterations) { return VectorsBatched(VECTOR_LERP, Iterations); }
+// End vector benchmark functions
+
+
+
+// Function:		CalculateX3DAudio(size_t, float) - Calculate X3DAudio function
+// Description:		Works out the output matrix of one of the spatial emitters with X3DAudioCalculate
+// In:				size_t Index - the emitter, float *Matrix - set to its matrix
+// Out:				N/a
+void BenchmarkSuite::CalculateX3DAudio(size_t Index, float *Matrix)
+{
+	X3DAUDIO_DSP_SETTINGS Settings;
+	SecureZeroMemory(&Settings, sizeof(X3DAUDIO_DSP_SETTINGS));
+	Settings.SrcChannelCount = mSpatialEmitters[Index].ChannelCount;
+	Settings.DstChannelCount = mSpatializer->GetChannelCount();
+	Settings.pMatrixCoefficients = Matrix;
+	XACore::GetInstance()->Calculate3D(&mSpatialEmitters[Index], &mSpatialListener, X3DAUDIO_CALCULATE_MATRIX, Settings);
+}
+// End CalculateX3DAudio function
+
+
+
+// Function:		SpatializeBatch(unsigned long) / SpatializeX3DAudio(unsigned long) - benchmarks
+// Description:		Work out the output matrices of the spatial emitters with the Spatializer in one batch, or with X3DAudio an emitter
+//					at a time, counting the emitters as the items
+// In:				unsigned long Iterations - the number of times through the emitters
+// Out:				bool - true
+bool BenchmarkSuite::SpatializeBatch(unsigned long Iterations)
+{
+	const size_t Channels = mSpatializer->GetChannelCount();
+	for (unsigned long i = 0; i < Iterations; i++)
+	{
+		mSpatializer->CalculateMatrices(&mSpatialListener, &mSpatialEmitterList[0], mSpatialEmitterList.size(), &mSpatialMatrices[0], Channels);
+	}
+	mSink = mSink + mSpatialMatrices[0];
+	mItems = mSpatialEmitterList.size();
+	mMemoryBytes = mSpatialMatrices.capacity() * sizeof(float);
+	return true;
+}
+
+bool BenchmarkSuite::SpatializeX3DAudio(unsigned long Iterations)
+{
+	const size_t Channels = mSpatializer->GetChannelCount();
+	for (unsigned long i = 0; i < Iterations; i++)
+	{
+		for (size_t Index = 0; Index < mSpatialEmitters.size(); Index++)
+		{
+			CalculateX3DAudio(Index, &mSpatialReference[Index * Channels]);
+		}
+	}
+	mSink = mSink + mSpatialReference[0];
+	mItems = mSpatialEmitters.size();
+	return true;
+}
+// End spatializer benchmark functions
+
+
+
+// Function:		TickEmitters(size_t, unsigned long) - Tick Emitters function
+// Description:		Ticks a number of the tick emitters, each with its own 3D calculation: each tick the listener turns a little,
+//					an eighth of the emitters move, every emitter is updated and the changes committed.
+//					The mixer's work for a tick is modelled, as the null device has none.
+// In:				size_t Count - the emitters, unsigned long Iterations - the number of ticks
+// Out:				bool - true
+bool BenchmarkSuite::TickEmitters(size_t Count, unsigned long Iterations)
+{
+	const float DeltaTime = 1.0f / TICK_RATE;
+
+	size_t Mover = 0;
+	for (unsigned long Tick = 0; Tick < Iterations; Tick++)
+	{
+		// The listener turns a full circle every 256 ticks
+		float Facing = float(Tick % 256) * (X3DAUDIO_2PI / 256.0f);
+		mTickListener.OrientFront.x = sinf(Facing);
+		mTickListener.OrientFront.z = cosf(Facing);
+
+		// An eighth of the emitters take a small step round the room in turn
+		for (size_t Step = 0; Step < (Count + 7) / 8; Step++)
+		{
+			X3DAUDIO_VECTOR Position = mTickEmitters[Mover]->mEmitter.Position;
+			Position.x = (Position.x < float(ROOM_X_SIZE - 1)) ? Position.x + 0.1f : 1.0f;
+			mTickEmitters[Mover]->SetPosition(Position);
+			Mover = (Mover + 1) % Count;
+		}
+
+		for (size_t i = 0; i < Count; i++)
+		{
+			mTickEmitters[i]->UpdateEmitter();
+		}
+		XASound::CommitChanges(DeltaTime);
+	}
+	mItems = Count;
+
+	// Each voice is mixed into the speakers with a multiply-add for each source channel and speaker of every frame
+	const double FramesPerTick = double(BENCHMARK_MIX_RATE) * DeltaTime;
+	const double Destinations = double(XACore::GetInstance()->GetChannelCount());
+	mMixMacs = 0.0;
+	for (size_t i = 0; i < Count; i++)
+	{
+		mMixMacs += FramesPerTick * double(mTickSounds[i]->GetChannelCount()) * Destinations;
+	}
+	return true;
+}
+// End TickEmitters function
+
+bool BenchmarkSuite::PerEmitterTick10(unsigned long Iterations) { return TickEmitters(10, Iterations); }
+bool BenchmarkSuite::PerEmitterTick100(unsigned long Iterations) { return TickEmitters(100, Iterations); }
+bool BenchmarkSuite::PerEmitterTick1000(unsigned long Iterations) { return TickEmitters(1000, Iterations); }
+
+
+
+// Function:		HitWallOrDoor(unsigned long) - benchmark
+// Description:		Checks the room grid for the step ahead of the player; the player isn't moved, so the same cell is checked each time
+// In:				unsigned long Iterations - the number of checks
+// Out:				bool - true
+bool BenchmarkSuite::HitWallOrDoor(unsigned long Iterations)
+{
+	for (unsigned long i = 0; i < Iterations; i++)
+	{
+		mSink = mSink + (mRoom->HitWallOrDoor() ? 1.0f : 0.0f);
+	}
+	return true;
+}
+// End HitWallOrDoor function
+
+
+
+// Function:		QueryGrid(int, bool, unsigned long) - Query Grid function
+// Description:		Looks up random cells of one of the benchmark grids, and records the memory the grid uses
+// In:				int Grid - the grid, bool Collision - true to read the collision bits rather than the values,
+//					unsigned long Iterations - the number of lookups
+// Out:				bool - true
+bool BenchmarkSuite::QueryGrid(int Grid, bool Collision, unsigned long Iterations)
+{
+	const RoomGrid &TheGrid = mGrids[Grid];
+	// The sizes are powers of 2, so a mask keeps the random cells in the grid
+	const unsigned int Mask = (unsigned int)(GridSizes[Grid] - 1);
+	unsigned int State = RoomSeed;
+	unsigned int Total = 0;
+	for (unsigned long i = 0; i < Iterations; i++)
+	{
+		unsigned int Random = NextRandom(State);
+		int X = int(Random & Mask);
+		int Z = int((Random >> 16) & Mask);
+		Total += Collision ? (unsigned int)(TheGrid.IsBlocked(X, Z)) : (unsigned int)(TheGrid.GetCell(X, Z));
+	}
+	mSink = mSink + float(Total);
+	mMemoryBytes = TheGrid.GetMemoryUsed();
+	return true;
+}
+// End QueryGrid function
+
+
+
+// Function:		GridCell16(unsigned long) ... GridBlocked4096(unsigned long) - benchmarks
+// Description:		Look up cell values or collision bits of the 16, 256 and 4096 cell square grids
+// In:				unsigned long Iterations - the number of lookups
+// Out:				bool - true
+bool BenchmarkSuite::GridCell16(unsigned long Iterations) { return QueryGrid(0, false, Iterations); }
+bool BenchmarkSuite::GridCell256(unsigned long Iterations) { return QueryGrid(1, false, Iterations); }
+bool BenchmarkSuite::GridCell4096(unsigned long Iterations) { return QueryGrid(2, false, Iterations); }
+bool BenchmarkSuite::GridBlocked16(unsigned long Iterations) { return QueryGrid(0, true, Iterations); }
+bool BenchmarkSuite::GridBlocked256(unsigned long Iterations) { return QueryGrid(1, true, Iterations); }
+bool BenchmarkSuite::GridBlocked4096(unsigned long Iterations) { return QueryGrid(2, true, Iterations); }
+// End grid benchmark functions
+
+
+
+// Function:		LoadMansionText(unsigned long) / LoadMansionBinary(unsigned long) - benchmarks
+// Description:		Load the mansion's layout from its text file, which is parsed, or its binary file, which is mapped and checked
+// In:				unsigned long Iterations - the number of times to load the layout
+// Out:				bool - false if the layout could not be loaded
+bool BenchmarkSuite::LoadMansionText(unsigned long Iterations)
+{
+	for (unsigned long i = 0; i < Iterations; i++)
+	{
+		RoomLayout Layout;
+		if (!Layout.Load(mMansionTextFile))
+		{
+			return false;
+		}
+		mSink = mSink + float(Layout.GetRoomCount());
+		mMemoryBytes = Layout.GetSize();
+	}
+	return true;
+}
+
+bool BenchmarkSuite::LoadMansionBinary(unsigned long Iterations)
+{
+	for (unsigned long i = 0; i < Iterations; i++)
+	{
+		RoomLayout Layout;
+		if (!Layout.Load(mMansionBinaryFile))
+		{
+			return false;
+		}
+		mSink = mSink + float(Layout.GetRoomCount());
+		mMemoryBytes = Layout.GetSize();
+	}
+	return true;
+}
+// End LoadMansionText and LoadMansionBinary functions
+
+
+
+// Function:		RasterizeMansion(unsigned long) - benchmark
+// Description:		Fills a grid from the layout of each room of the mansion in turn
+// In:				unsigned long Iterations - the number of times to fill the grids of the whole mansion
+// Out:				bool - false if a room could not be filled in
+bool BenchmarkSuite::RasterizeMansion(unsigned long Iterations)
+{
+	for (unsigned long i = 0; i < Iterations; i++)
+	{
+		for (UINT32 Room = 0; Room < mMansion.GetRoomCount(); Room++)
+		{
+			if (!mMansion.Rasterize(Room, mMansionGrid))
+			{
+				return false;
+			}
+		}
+		mSink = mSink + float(mMansionGrid.GetCell(1, 1));
+	}
+	mMemoryBytes = mMansion.GetSize();
+	return true;
+}
+// End RasterizeMansion function
+
+
+
+// Function:		FindPaths(int, unsigned long) - Find Paths function
+// Description:		Finds A* paths between the start and goal cells chosen on one of the path maps, and records the memory the path finder uses
+// In:				int Map - the map, unsigned long Iterations - the number of paths
+// Out:				bool - false if a path could not be found
+bool BenchmarkSuite::FindPaths(int Map, unsigned long Iterations)
+{
+	PathFinder &Finder = mPathFinders[Map];
+	for (unsigned long i = 0; i < Iterations; i++)
+	{
+		const GridCell &Start = mPathStarts[Map][i % BENCHMARK_PATH_QUERIES];
+		const GridCell &Goal = mPathGoals[Map][i % BENCHMARK_PATH_QUERIES];
+		// A goal cut off by the obstacles is a valid query; it is just the slowest
+		Finder.FindPath(Start.X, Start.Z, Goal.X, Goal.Z, mPath);
+		mSink = mSink + float(mPath.size());
+	}
+	mMemoryBytes = Finder.GetMemoryUsed();
+	return true;
+}
+// End FindPaths function
+
+
+
+// Function:		BuildFlowFields(int, unsigned long) - Build Flow Fields function
+// Description:		Builds whole flow fields to each goal cell chosen on one of the path maps in turn; the goals are all different,
+//					so none is in the path finder's cache, and records the memory the path finder uses
+// In:				int Map - the map, unsigned long Iterations - the number of fields
+// Out:				bool - false if a field could not be built
+bool BenchmarkSuite::BuildFlowFields(int Map, unsigned long Iterations)
+{
+	PathFinder &Finder = mPathFinders[Map];
+	for (unsigned long i = 0; i < Iterations; i++)
+	{
+		const GridCell &Goal = mPathGoals[Map][i % BENCHMARK_PATH_QUERIES];
+		if (!Finder.GetFlowField(Goal.X, Goal.Z).IsComplete())
+		{
+			return false;
+		}
+	}
+	mMemoryBytes = Finder.GetMemoryUsed();
+	return true;
+}
+// End BuildFlowFields function
+
+
+
+// Function:		QueryFlow(int, unsigned long) - Query Flow function
+// Description:		Finds the flow direction from each start cell chosen on one of the path maps in turn towards the first goal
+// In:				int Map - the map, unsigned long Iterations - the number of directions
+// Out:				bool - false if the field doesn't lead from a start cell
+bool BenchmarkSuite::QueryFlow(int Map, unsigned long Iterations)
+{
+	PathFinder &Finder = mPathFinders[Map];
+	X3DAUDIO_VECTOR Target = { PathFinder::CellToPosition(mPathGoals[Map][0].X), 0.0f, PathFinder::CellToPosition(mPathGoals[Map][0].Z) };
+	X3DAUDIO_VECTOR Position = Target;
+	X3DAUDIO_VECTOR Direction;
+	for (unsigned long i = 0; i < Iterations; i++)
+	{
+		// The start cells are offset from their centres, so the mover isn't at the target even if it shares its cell
+		const GridCell &Start = mPathStarts[Map][i % BENCHMARK_PATH_QUERIES];
+		Position.x = PathFinder::CellToPosition(Start.X) - 0.25f;
+		Position.z = PathFinder::CellToPosition(Start.Z) - 0.25f;
+		if (Finder.GetFlowDirection(Position, Target, Direction))
+		{
+			mSink = mSink + Direction.x;
+		}
+	}
+	mMemoryBytes = Finder.GetMemoryUsed();
+	return true;
+}
+// End QueryFlow function
+
+
+
+// Function:		AStar16(unsigned long) ... FlowDirection1024(unsigned long) - benchmarks
+// Description:		Find paths, build flow fields and find flow directions on the 16 by 16 room and the generated map
+// In:				unsigned long Iterations - the number of paths, fields or directions
+// Out:				bool - false if a field could not be built
+bool BenchmarkSuite::AStar16(unsigned long Iterations) { return FindPaths(0, Iterations); }
+bool BenchmarkSuite::AStar1024(unsigned long Iterations) { return FindPaths(1, Iterations); }
+bool BenchmarkSuite::FlowFieldBuild16(unsigned long Iterations) { return BuildFlowFields(0, Iterations); }
+bool BenchmarkSuite::FlowFieldBuild1024(unsigned long Iterations) { return BuildFlowFields(1, Iterations); }
+bool BenchmarkSuite::FlowDirection16(unsigned long Iterations) { return QueryFlow(0, Iterations); }
+bool BenchmarkSuite::FlowDirection1024(unsigned long Iterations) { return QueryFlow(1, Iterations); }
+// End path benchmark functions
+
+
+
+// Function:		UpdateActors(int, unsigned long) - Update Actors function
+// Description:		Moves the actors of one of the actor stores for a tick at a time, sending those that arrived to new random
+//					targets in the room, and records the memory the store uses
+// In:				int Store - the store, unsigned long Iterations - the number of ticks
+// Out:				bool - true
+bool BenchmarkSuite::UpdateActors(int Store, unsigned long Iterations)
+{
+	ActorStore &Actors = mActorStores[Store];
+	const float DeltaTime = 1.0f / TICK_RATE;
+	for (unsigned long i = 0; i < Iterations; i++)
+	{
+		if (Actors.Update(DeltaTime) > 0)
+		{
+			const vector<UINT32> &Arrived = Actors.GetArrived();
+			for (auto Actor = Arrived.begin(); Actor != Arrived.end(); ++Actor)
+			{
+				Actors.SetTarget(*Actor, RandomRoomPosition(mActorRandom, ROOM_X_SIZE), RandomRoomPosition(mActorRandom, ROOM_Z_SIZE));
+			}
+		}
+	}
+	mSink = mSink + Actors.GetPosition(0).x;
+	mMemoryBytes = Actors.GetMemoryUsed();
+	return true;
+}
+// End UpdateActors function
+
+
+
+// Function:		ActorUpdate1000(unsigned long) / ActorUpdate100000(unsigned long) - benchmarks
+// Description:		Move the 1000 and 100000 actors of the actor stores
+// In:				unsigned long Iterations - the number of ticks
+// Out:				bool - true
+bool BenchmarkSuite::ActorUpdate1000(unsigned long Iterations) { return UpdateActors(0, Iterations); }
+bool BenchmarkSuite::ActorUpdate100000(unsigned long Iterations) { return UpdateActors(1, Iterations); }
+// End actor store benchmark functions
+
+
+
+// Function:		SwarmUpdate(unsigned long) - benchmark
+// Description:		A tick of the swarm of BENCHMARK_SWARM_SIZE critters, with its emitters' changes committed as the game loop does,
+//					and records the memory its critters use
+// In:				unsigned long Iterations - the number of ticks
+// Out:				bool - true
+bool BenchmarkSuite::SwarmUpdate(unsigned long Iterations)
+{
+	const float DeltaTime = 1.0f / TICK_RATE;
+	for (unsigned long i = 0; i < Iterations; i++)
+	{
+		mSwarm->UpdateSwarm(DeltaTime);
+		XASound::CommitChanges(DeltaTime);
+		GameTimer::AdvanceSimulatedClock(DeltaTime);
+	}
+	mMemoryBytes = mSwarm->GetMemoryUsed();
+	return true;
+}
+// End SwarmUpdate function
+
+
+
+// Function:		UpdateEmitter(unsigned long) - benchmark
+// Description:		Updates a playing emitter's 3D settings as the listener moves across the room
+// In:				unsigned long Iterations - the number of updates
+// Out:				bool - true
+bool BenchmarkSuite::UpdateEmitter(unsigned long Iterations)
+{
+	for (unsigned long i = 0; i < Iterations; i++)
+	{
+		mListener.Position.x = float(i % ROOM_X_SIZE);
+		mEmitter->UpdateEmitter();
+	}
+	return true;
+}
+// End UpdateEmitter function
+
+
+
+// Function:		UpdatePoses(int, unsigned long) - Update Poses function
+// Description:		Updates one of the pose emitters with the listener at each of the poses in turn
+// In:				int Index - 0 for the emitter without a panning table, 1 for the one with, unsigned long Iterations - the updates
+// Out:				bool - true
+bool BenchmarkSuite::UpdatePoses(int Index, unsigned long Iterations)
+{
+	const int Poses = BENCHMARK_POSE_CELLS * 8;
+	for (unsigned long i = 0; i < Iterations; i++)
+	{
+		int Pose = int(i % Poses);
+		mPoseListener.Position.x = float(ROOM_X_SIZE / 2 - BENCHMARK_POSE_CELLS / 2 + Pose / 8);
+		mPoseListener.OrientFront = Directions::Orientations[Pose % 8];
+		mPoseEmitters[Index]->UpdateEmitter();
+	}
+	const PanningTable *Table = mPoseEmitters[Index]->GetPanningTable();
+	mMemoryBytes = (Table != NULL) ? Table->GetMemoryUsed() : 0;
+	return true;
+}
+// End UpdatePoses function
+
+
+
+// Function:		StaticPoseCalculate(unsigned long) / StaticPoseTable(unsigned long) - benchmarks
+// Description:		Update the still emitters, without and with the panning table, at the poses
+// In:				unsigned long Iterations - the number of updates
+// Out:				bool - true
+bool BenchmarkSuite::StaticPoseCalculate(unsigned long Iterations) { return UpdatePoses(0, Iterations); }
+bool BenchmarkSuite::StaticPoseTable(unsigned long Iterations) { return UpdatePoses(1, Iterations); }
+// End static pose benchmark functions
+
+
+
+// Function:		WalkPoses(int, unsigned long) - Walk Poses function
+// Description:		Updates one of the pose emitters as the listener walks diagonally out and back, looking round after each step
+// In:				int Index - 0 for the emitter without a panning table, 1 for the one with, unsigned long Iterations - the updates
+// Out:				bool - true
+bool BenchmarkSuite::WalkPoses(int Index, unsigned long Iterations)
+{
+	const unsigned long FramesPerStep = BENCHMARK_WALK_FRAMES + 8;
+	const unsigned long Steps = BENCHMARK_POSE_CELLS - 1;
+	const X3DAUDIO_LISTENER Standing = mPoseListener;
+	X3DAUDIO_VECTOR Target = Standing.Position;
+	Target.x = float(ROOM_X_SIZE / 2 - BENCHMARK_POSE_CELLS / 2);
+	X3DAUDIO_VECTOR From = Target;
+	int Direction = Listener::NorthEast;
+	for (unsigned long i = 0; i < Iterations; i++)
+	{
+		// Each step is added to the target of the last, as Listener::MoveForward does, so the rounding errors build up as in the game
+		unsigned long Frame = i % FramesPerStep;
+		if (Frame == 0)
+		{
+			Direction = (((i / FramesPerStep) / Steps) % 2 == 0) ? Listener::NorthEast : Listener::SouthWest;
+			From = Target;
+			Target.x += Directions::Orientations[Direction].x;
+			Target.z += Directions::Orientations[Direction].z;
+		}
+
+		if (Frame + 1 < BENCHMARK_WALK_FRAMES)
+		{
+			// Part way through the step; only whether the velocity is zero matters to the emitter
+			float Fraction = float(Frame + 1) / float(BENCHMARK_WALK_FRAMES);
+			mPoseListener.Position.x = From.x + ((Target.x - From.x) * Fraction);
+			mPoseListener.Position.z = From.z + ((Target.z - From.z) * Fraction);
+			mPoseListener.Velocity.x = Target.x - From.x;
+			mPoseListener.Velocity.z = Target.z - From.z;
+			mPoseListener.OrientFront = Directions::Orientations[Direction];
+		}
+		else
+		{
+			// At the end of the step, then looking round
+			mPoseListener.Position = Target;
+			mPoseListener.Velocity.x = 0.0f;
+			mPoseListener.Velocity.z = 0.0f;
+			mPoseListener.OrientFront = Directions::Orientations[(Frame < BENCHMARK_WALK_FRAMES) ? Direction : int(Frame - BENCHMARK_WALK_FRAMES)];
+		}
+		mPoseEmitters[Index]->UpdateEmitter();
+	}
+	mPoseListener = Standing;
+	const PanningTable *Table = mPoseEmitters[Index]->GetPanningTable();
+	mMemoryBytes = (Table != NULL) ? Table->GetMemoryUsed() : 0;
+	return true;
+}
+// End WalkPoses function
+
+
+
+// Function:		WalkPoseCalculate(unsigned long) / WalkPoseTable(unsigned long) - benchmarks
+// Description:		Update the still emitters, without and with the panning table, as the listener walks
+// In:				unsigned long Iterations - the number of updates
+// Out:				bool - true
+bool BenchmarkSuite::WalkPoseCalculate(unsigned long Iterations) { return WalkPoses(0, Iterations); }
+bool BenchmarkSuite::WalkPoseTable(unsigned long Iterations) { return WalkPoses(1, Iterations); }
+// End walking pose benchmark functions
+
+
+
+// Function:		Apply3D(unsigned long) - benchmark
+// Description:		Calculates a sound's 3D settings on the null device's software voice and sets them as its targets
+// In:				unsigned long Iterations - the number of calculations
+// Out:				bool - true
+bool BenchmarkSuite::Apply3D(unsigned long Iterations)
+{
+	for (unsigned long i = 0; i < Iterations; i++)
+	{
+		mListener.Position.x = float(i % ROOM_X_SIZE);
+		mSound->Apply3D(&mEmitterSettings, &mListener);
+	}
+	return true;
+}
+// End Apply3D function
+
+
+
+// Function:		HeartbeatFrame(unsigned long) - benchmark
+// Description:		Makes the parameter changes and queries Player::UpdateHeartbeat makes to a playing sound each frame, and commits them
+// In:				unsigned long Iterations - the number of frames
+// Out:				bool - true
+bool BenchmarkSuite::HeartbeatFrame(unsigned long Iterations)
+{
+	const float DeltaTime = 1.0f / TICK_RATE;
+	for (unsigned long i = 0; i < Iterations; i++)
+	{
+		// The ghost distance changes a little every frame, as it does while the player or ghost moves
+		float Distance = float(i % 64) * 0.25f;
+		mSound->SetVolume(-2.0f * Distance);
+		mSound->SetPitch(50.0f - 5.0f * Distance);
+		mSound->AdjustVolume(0.0f);
+		mSound->SetFilterCutoffFrequency(4000.0f);
+		mSink = mSink + mSound->GetVolume() + mSound->GetPitch() + mSound->GetFilterCutoffFrequency();
+		mSink = mSink + (mSound->IsFiltered() ? 1.0f : 0.0f) + (mSound->IsPlaying() ? 1.0f : 0.0f);
+		XASound::CommitChanges(DeltaTime);
+	}
+	return true;
+}
+// End HeartbeatFrame function
+
+
+
+// Function:		PrepareTickRoom() - Prepare Tick Room function
+// Description:		Replaces the room UpdateRoom ticks with a new one, reset on a restarted simulated clock
+// In:				N/a
+// Out:				bool - false if the room could not be created
+bool BenchmarkSuite::PrepareTickRoom()
+{
+	if (mTickRoom != NULL)
+	{
+		mTickRoom->Stop();
+		delete mTickRoom;
+		mTickRoom = NULL;
+	}
+
+	// As HeadlessDriver::RunPlaythrough does, so the run's ticks start from the same state whatever ran before
+	GameTimer::UseSimulatedClock(true);
+	mTickRoom = new Room(RoomSeed);
+	if (!mTickRoom->IsValid())
+	{
+		return false;
+	}
+	mTickRoom->Reset();
+	return true;
+}
+// End PrepareTickRoom function
+
+
+
+// Function:		UpdateRoom(unsigned long) - benchmark
+// Description:		Runs full game ticks of a new room as the headless driver does, with no commands given
+// In:				unsigned long Iterations - the number of ticks
+// Out:				bool - true
+bool BenchmarkSuite::UpdateRoom(unsigned long Iterations)
+{
+	const float DeltaTime = 1.0f / TICK_RATE;
+	for (unsigned long i = 0; i < Iterations; i++)
+	{
+		mTickRoom->UpdateRoom(DeltaTime);
+		XASound::CommitChanges(DeltaTime);
+		GameTimer::AdvanceSimulatedClock(DeltaTime);
+	}
+	return true;
+}
+// End UpdateRoom function
+
+
+
+// Function:		WriteJson(ostream) - Write JSON function
+// Description:		Writes the results in Google Benchmark's JSON format
+// In:				ostream &Json - the stream to write to
+// Out:				N/a
+void BenchmarkSuite::WriteJson(ostream &Json) const
+{
+	char Date[32];
+	time_t Now = time(NULL);
+	strftime(Date, sizeof(Date), "%Y-%m-%dT%H:%M:%S", localtime(&Now));
+	SYSTEM_INFO System;
+	GetSystemInfo(&System);
+
+	Json << "{" << endl;
+	Json << "  \"context\": {" << endl;
+	Json << "    \"date\": \"" << Date << "\"," << endl;
+	Json << "    \"executable\": \"GhostEscape\"," << endl;
+	Json << "    \"num_cpus\": " << System.dwNumberOfProcessors << "," << endl;
+#ifdef NDEBUG
+	Json << "    \"library_build_type\": \"release\"" << endl;
+#else
+	Json << "    \"library_build_type\": \"debug\"" << endl;
+#endif
+	Json << "  }," << endl;
+	Json << "  \"benchmarks\": [";
+
+	Json << std::fixed << std::setprecision(3);
+	for (auto Result = mResults.begin(); Result != mResults.end(); ++Result)
+	{
+		Json << ((Result == mResults.begin()) ? "" : ",") << endl;
+		Json << "    {" << endl;
+		Json << "      \"name\": ";
+		WriteJsonString(Json, Result->Name);
+		Json << "," << endl;
+		Json << "      \"run_name\": ";
+		WriteJsonString(Json, Result->Name);
+		Json << "," << endl;
+		Json << "      \"run_type\": \"iteration\"," << endl;
+		Json << "      \"repetitions\": " << mRepetitions << "," << endl;
+		Json << "      \"repetition_index\": " << Result->Repetition << "," << endl;
+		Json << "      \"threads\": 1," << endl;
+		Json << "      \"iterations\": " << Result->Iterations << "," << endl;
+		Json << "      \"real_time\": " << Result->RealTime << "," << endl;
+		Json << "      \"cpu_time\": " << Result->CpuTime << "," << endl;
+		if (Result->Failed)
+		{
+			Json << "      \"time_unit\": \"ns\"," << endl;
+			Json << "      \"error_occurred\": true," << endl;
+			Json << "      \"error_message\": \"could not be set up or failed\"" << endl;
+			Json << "    }";
+			continue;
+		}
+		Json << "      \"time_unit\": \"ns\"," << endl;
+		Json << "      \"voice_calls\": " << Result->VoiceCalls;
+		if (Result->MemoryBytes > 0.0)
+		{
+			Json << "," << endl << "      \"bytes_used\": " << Result->MemoryBytes;
+		}
+		if (Result->ItemsPerSecond > 0.0)
+		{
+			Json << "," << endl << "      \"items_per_second\": " << Result->ItemsPerSecond;
+		}
+		if (Result->MixMacs > 0.0)
+		{
+			Json << "," << endl << "      \"mix_macs\": " << Result->MixMacs;
+		}
+		Json << endl;
+		Json << "    }";
+	}
+	Json << endl << "  ]" << endl;
+	Json << "}" << endl;
+}
+// End WriteJson function
@@ -0,0 +1,403 @@
+/*
+	File:	BenchmarkSuite.hpp
+	Version:	1.0
+	Date:	18th October 2026
+	Author:	agent
+
+	Exposes:	BenchmarkSuite, BenchmarkResult.
+	Requires:	Room, RoomGrid, RoomLayout, PathFinder, ActorStore, CritterSwarm, Emitter, PanningTable, XACore, XASound, NullSourceVoice, PCMWave, WaveFileManager, GameTimer, Spatializer, stu::v3f, stu::batch.
+
+	Description:
+	Microbenchmarks of the framework and game hot paths, so their speed can be tracked between commits.
+
+	Each benchmark is a function that runs its operation a given number of times. As with Google Benchmark, the suite
+	runs it with more iterations until the run takes at least the minimum time, then reports the real and CPU time per iteration,
+	and the number of calls made to the source voices per iteration.
+	*	XACore is created on its null device and GameTimer's simulated clock is used, as for a headless run
+		(see HeadlessDriver.hpp), so no audio device is needed and the room sees the same times on every run;
+	*	the times are read from the performance counter through GameTimer, bypassing the simulated clock;
+	*	the voice calls are counted by the null device's NullSourceVoice, and show how often a path goes to the audio engine;
+	*	the results are written as JSON in Google Benchmark's format, so its compare.py can be used to compare two runs;
+	the voice calls are written as a user counter, voice_calls, the memory used by a data structure as bytes_used, and the
+	items a benchmark works on as items_per_second (so the spatializer's emitters per microsecond are items_per_second / 1e6);
+	*	the null device has no mixer, so the times are of the game's thread only. Where the mixer's work grows with a benchmark's
+		size, it is modelled and written as mix_macs: the multiply-adds the XAudio2 mixer would do each iteration to mix the
+		voices through their output matrices, at BENCHMARK_MIX_RATE;
+	*	the sounds are loaded from the Sounds folder, so the suite must be run from the folder holding it;
+	*	the mansion's layout files are written to the temporary folder while the suite runs.
+
+	The benchmarks are:
+		PCMWave/LoadFromDisk			parse a .wav file into a PCMWave;
+		PCMWave/LoadFromMemory			create a PCMWave from sample data already in memory;
+		WaveFileManager/LoadWaveHit		look up a wave that is already loaded;
+		WaveFileManager/LoadWaveMiss	load a wave that isn't, then unload it;
+		v3f/Arithmetic					add, subtract, scale, dot and cross product;
+		v3f/Normalise					normalise a vector;
+		v3f/Distance					distance between two points;
+		v3f/PerObject/<op>/1024			distance, normalise, dot product or lerp of BENCHMARK_VECTOR_COUNT X3DAUDIO_VECTORs, each
+										copied into a v3f and worked on one at a time, as the game did;
+		v3fBatch/<op>/1024				the same over the same X3DAUDIO_VECTORs, with the batch functions working on them in place;
+		Room/HitWallOrDoor				collision lookup for the step ahead of the player;
+		RoomGrid/GetCell/<n>			cell value lookups at random cells of an n by n grid, for n = 16, 256 and 4096;
+		RoomGrid/IsBlocked/<n>			collision bit lookups at random cells of an n by n grid;
+		RoomLayout/LoadMansionText		load and parse a text layout of a BENCHMARK_MANSION_ROOMS room mansion;
+		RoomLayout/LoadMansionBinary	load the same mansion compiled to its binary form, which is mapped rather than parsed;
+		RoomLayout/RasterizeMansion		fill a grid from the layout of each room of the mansion in turn;
+		PathFinder/AStar/<n>			A* paths between random free cells, on the 16 by 16 room and on a generated map
+										BENCHMARK_PATH_MAP_SIZE cells square, a quarter covered in obstacles up to 8 cells across;
+		PathFinder/FlowFieldBuild/<n>	build a whole flow field to a random free cell, on the same maps;
+		PathFinder/FlowDirection/<n>	the direction from a random free cell towards a target whose flow field is cached;
+		ActorStore/Update/<n>			move n actors for a tick and send those that arrived to new random targets, for n = 1000
+										and 100000;
+		CritterSwarm/Update/1000		a tick of a swarm of 1000 critters in the room, with its emitters' changes committed;
+		Spatializer/Batch/256			the output matrices of BENCHMARK_SPATIAL_EMITTERS emitters, with cones and the game's distance
+										curves, from the portable Spatializer in one batch;
+		X3DAudio/Calculate/256			the same matrices from X3DAudioCalculate, an emitter at a time (that they match is checked
+										by HeadlessDriver's -checkspatializer);
+		PerEmitter/Tick/<n>				a tick of n playing emitters, for n = 10, 100 and 1000, each working out its own matrix for
+										the speakers with X3DAudio, as the listener turns and an eighth of the emitters move;
+										mix_macs is each voice mixed into the speakers;
+		Emitter/UpdateEmitter			3D update of a playing emitter with the listener moving;
+		Emitter/StaticPose/Calculate	3D update of a still emitter as the listener stands at BENCHMARK_POSE_CELLS cells in turn,
+										facing each of the 8 orientations at each, calculated with X3DAudio every time;
+		Emitter/StaticPose/Table		the same updates of an emitter with a PanningTable, which copies the settings kept for
+										the poses instead; bytes_used is the table's memory;
+		Emitter/StaticPose/Walk/Calculate	the still emitter's updates as the listener walks BENCHMARK_POSE_CELLS - 1 steps north
+		Emitter/StaticPose/Walk/Table		east and back again, gliding over BENCHMARK_WALK_FRAMES updates and then looking round
+										the 8 orientations after each step, without and with the panning table; the diagonal
+										steps leave the listener off the whole cells, and its position is built up step by step
+										as Listener::MoveForward does;
+		XASound/Apply3D					3D calculation for a sound on the null device's software voice;
+		XASound/HeartbeatFrame			one frame of Player::UpdateHeartbeat's volume and pitch changes, queries and commit;
+		Room/UpdateRoom					a full game tick, with the sounds' changes committed; each run is of a new room on a
+										restarted simulated clock, as a headless playthrough is, so every run times the same ticks.
+
+	It is run from WinMain when the command line contains -benchmark, with the optional arguments:
+		-filter <text>		only run the benchmarks whose names contain the text;
+		-mintime <s>		the minimum time of each benchmark run in seconds (default BENCHMARK_MIN_TIME);
+		-repetitions <n>	run each benchmark n times (default 1);
+		-out <file>			write the JSON to the file rather than standard output.
+*/
+
+// Define the class
+#ifndef __BENCHMARKSUITE_HPP__
+#define __BENCHMARKSUITE_HPP__
+
+// System includes.
+#include <Windows.h>
+#include <X3DAudio.h>
+#include <string>
+#include <vector>
+#include <ostream>
+using std::string;
+using std::vector;
+using std::ostream;
+
+// Framework includes.
+#include "XASound.hpp"
+using AllanMilne::Audio::XASound;
+
+// Application includes.
+#include "RoomGrid.hpp"
+#include "RoomLayout.hpp"
+#include "PathFinder.hpp"
+#include "ActorStore.hpp"
+
+// The default minimum time of a benchmark run, in seconds
+#define BENCHMARK_MIN_TIME 0.5
+// The most iterations a benchmark run is given
+#define BENCHMARK_MAX_ITERATIONS 1000000000UL
+// The number of grid sizes the RoomGrid lookups are timed at
+#define BENCHMARK_GRID_SIZES 3
+// The number of rooms in the mansion the layout loads are timed with
+#define BENCHMARK_MANSION_ROOMS 100
+// The number of maps the paths are timed on, the size of the generated map, and the number of start and goal cells chosen on each
+#define BENCHMARK_PATH_MAPS 2
+#define BENCHMARK_PATH_MAP_SIZE 1024
+#define BENCHMARK_PATH_QUERIES 64
+// The number of actor stores timed, the number of actors in each, and the number of critters in the swarm
+#define BENCHMARK_ACTOR_STORES 2
+#define BENCHMARK_SWARM_SIZE 1000
+// The number of vectors the per-object and batch vector math is timed over
+#define BENCHMARK_VECTOR_COUNT 1024
+// The number of emitters spatialized at a time
+#define BENCHMARK_SPATIAL_EMITTERS 256
+// The most emitters ticked at once
+#define BENCHMARK_TICK_EMITTERS 1000
+// The mixing rate the modelled mixer work is worked out at; XAudio2's mastering voice usually runs at 48kHz
+#define BENCHMARK_MIX_RATE 48000
+// The cells the listener stands at for the static pose benchmarks; with the 8 orientations, these fill a panning table
+#define BENCHMARK_POSE_CELLS 4
+// The updates the listener takes over each step of the walking pose benchmarks
+#define BENCHMARK_WALK_FRAMES 4
+
+// The result of one benchmark run
+struct BenchmarkResult
+{
+	string Name;
+	unsigned int Repetition;
+	unsigned long Iterations;
+	double RealTime;		// Nanoseconds per iteration
+	double CpuTime;			// Nanoseconds of this thread's CPU time per iteration
+	double VoiceCalls;		// Calls made to the source voices per iteration
+	double MemoryBytes;		// Memory used by the data structure benchmarked; 0 if not measured
+	double ItemsPerSecond;	// Items worked on per second of real time; 0 if not counted
+	double MixMacs;			// Multiply-adds the mixer would do per iteration, modelled; 0 if not modelled
+	bool Failed;			// The benchmark could not be set up or failed; it has no times
+};
+
+// Forward declarations.
+class Room;
+class Emitter;
+class CritterSwarm;
+namespace AllanMilne { namespace Audio { class Spatializer; } }
+
+// The BenchmarkSuite class
+class BenchmarkSuite
+{
+// Public Member functions and variables
+public:
+
+	// Function:		BenchmarkSuite() - BenchmarkSuite constructor
+	// Description:		Registers the benchmarks and sets the default options; nothing is created until Run or RunBenchmarks is called
+	// In:				N/a
+	// Out:				N/a
+	BenchmarkSuite();
+
+	// Function:		~BenchmarkSuite() - BenchmarkSuite destructor
+	// Description:		Deletes anything left by the benchmarks and switches the simulated clock off
+	// In:				N/a
+	// Out:				N/a
+	~BenchmarkSuite();
+
+	// Function:		Run(string) - Run function
+	// Description:		Reads the options from the command line, runs the benchmarks and writes the JSON results
+	// In:				const string &CommandLine - the application's command line
+	// Out:				int - the application exit code; 0 if the benchmarks ran, 1 if the options were invalid or a benchmark failed
+	int Run(const string &CommandLine);
+
+	// Function:		RunBenchmarks(string) - Run Benchmarks function
+	// Description:		Creates the null audio device and runs the benchmarks whose names contain the filter; a benchmark that
+	//					fails is recorded as failed and the rest still run
+	// In:				const string &Filter - the text the names must contain; empty for all
+	// Out:				bool - false if the null audio device could not be created or any benchmark failed
+	bool RunBenchmarks(const string &Filter);
+
+	// Function:		WriteJson(ostream) - Write JSON function
+	// Description:		Writes the results in Google Benchmark's JSON format
+	// In:				ostream &Json - the stream to write to
+	// Out:				N/a
+	void WriteJson(ostream &Json) const;
+
+	inline void SetMinTime(double Seconds) { mMinTime = Seconds; }
+	inline void SetRepetitions(unsigned int Repetitions) { mRepetitions = Repetitions; }
+	inline const vector<BenchmarkResult>& GetResults() const { return mResults; }
+
+// Private member functions and variables
+private:
+
+	// A benchmark runs its operation the given number of times; it returns false if it could not be set up
+	typedef bool (BenchmarkSuite::*BenchmarkFunction)(unsigned long Iterations);
+	// A benchmark's preparation is done before each of its runs, untimed; it returns false if it fails
+	typedef bool (BenchmarkSuite::*PrepareFunction)();
+
+	struct Benchmark
+	{
+		const char *Name;
+		BenchmarkFunction Function;
+		PrepareFunction Prepare;	// NULL if the benchmark needs none
+	};
+
+	// Function:		RunBenchmark(Benchmark) - Run Benchmark function
+	// Description:		Runs a benchmark with more iterations until a run takes the minimum time, and records the result, or
+	//					records it as failed
+	// In:				const Benchmark &ToRun - the benchmark, unsigned int Repetition - the repetition number
+	// Out:				bool - false if the benchmark could not be set up or failed
+	bool RunBenchmark(const Benchmark &ToRun, unsigned int Repetition);
+
+	// Function:		SetUp() / TearDown() - Set Up and Tear Down functions
+	// Description:		Create the room, emitter and sounds shared by the benchmarks, and delete them
+	// In:				N/a
+	// Out:				bool - false if the room or sounds could not be created
+	bool SetUp();
+	void TearDown();
+
+	// Function:		QueryGrid(int, bool, unsigned long) - Query Grid function
+	// Description:		Looks up random cells of one of the benchmark grids, and records the memory the grid uses
+	// In:				int Grid - the grid, bool Collision - true to read the collision bits rather than the values,
+	//					unsigned long Iterations - the number of lookups
+	// Out:				bool - true
+	bool QueryGrid(int Grid, bool Collision, unsigned long Iterations);
+
+	// Function:		FindPaths(int, unsigned long) - Find Paths function
+	// Description:		Finds A* paths between the start and goal cells chosen on one of the path maps, and records the memory the path finder uses
+	// In:				int Map - the map, unsigned long Iterations - the number of paths
+	// Out:				bool - false if a path could not be found
+	bool FindPaths(int Map, unsigned long Iterations);
+
+	// Function:		BuildFlowFields(int, unsigned long) - Build Flow Fields function
+	// Description:		Builds whole flow fields to each goal cell chosen on one of the path maps in turn; the goals are all different,
+	//					so none is in the path finder's cache, and records the memory the path finder uses
+	// In:				int Map - the map, unsigned long Iterations - the number of fields
+	// Out:				bool - false if a field could not be built
+	bool BuildFlowFields(int Map, unsigned long Iterations);
+
+	// Function:		QueryFlow(int, unsigned long) - Query Flow function
+	// Description:		Finds the flow direction from each start cell chosen on one of the path maps in turn towards the first goal
+	// In:				int Map - the map, unsigned long Iterations - the number of directions
+	// Out:				bool - false if the field doesn't lead from a start cell
+	bool QueryFlow(int Map, unsigned long Iterations);
+
+	// Function:		UpdateActors(int, unsigned long) - Update Actors function
+	// Description:		Moves the actors of one of the actor stores for a tick at a time, sending those that arrived to new random
+	//					targets in the room, and records the memory the store uses
+	// In:				int Store - the store, unsigned long Iterations - the number of ticks
+	// Out:				bool - true
+	bool UpdateActors(int Store, unsigned long Iterations);
+
+	// The operations the per-object and batch vector benchmarks time
+	enum VectorOperation { VECTOR_DISTANCE, VECTOR_NORMALISE, VECTOR_DOT, VECTOR_LERP };
+
+	// Function:		VectorsPerObject(VectorOperation, unsigned long) / VectorsBatched(VectorOperation, unsigned long) - Vector functions
+	// Description:		Do an operation on each of the BENCHMARK_VECTOR_COUNT vectors, or pairs of vectors, one at a time with v3f or
+	//					with the batch functions; normalising is done in place on the output vectors
+	// In:				VectorOperation Operation - the operation, unsigned long Iterations - the number of times through the vectors
+	// Out:				bool - true
+	bool VectorsPerObject(VectorOperation Operation, unsigned long Iterations);
+	bool VectorsBatched(VectorOperation Operation, unsigned long Iterations);
+
+	// Function:		CalculateX3DAudio(size_t, float) - Calculate X3DAudio function
+	// Description:		Works out the output matrix of one of the spatial emitters with X3DAudioCalculate
+	// In:				size_t Index - the emitter, float *Matrix - set to its matrix
+	// Out:				N/a
+	void CalculateX3DAudio(size_t Index, float *Matrix);
+
+	// Function:		TickEmitters(size_t, unsigned long) - Tick Emitters function
+	// Description:		Ticks a number of the tick emitters, each with its own 3D calculation: each tick the listener turns a little,
+	//					an eighth of the emitters move, every emitter is updated and the changes committed
+	// In:				size_t Count - the emitters, unsigned long Iterations - the number of ticks
+	// Out:				bool - true
+	bool TickEmitters(size_t Count, unsigned long Iterations);
+
+	// Function:		UpdatePoses(int, unsigned long) - Update Poses function
+	// Description:		Updates one of the pose emitters with the listener at each of the poses in turn
+	// In:				int Index - 0 for the emitter without a panning table, 1 for the one with, unsigned long Iterations - the updates
+	// Out:				bool - true
+	bool UpdatePoses(int Index, unsigned long Iterations);
+
+	// Function:		WalkPoses(int, unsigned long) - Walk Poses function
+	// Description:		Updates one of the pose emitters as the listener walks diagonally out and back, looking round after each step
+	// In:				int Index - 0 for the emitter without a panning table, 1 for the one with, unsigned long Iterations - the updates
+	// Out:				bool - true
+	bool WalkPoses(int Index, unsigned long Iterations);
+
+	// Function:		PrepareTickRoom() - Prepare Tick Room function
+	// Description:		Replaces the room UpdateRoom ticks with a new one, reset on a restarted simulated clock
+	// In:				N/a
+	// Out:				bool - false if the room could not be created
+	bool PrepareTickRoom();
+
+	// The benchmarks
+	bool LoadWaveFromDisk(unsigned long Iterations);
+	bool LoadWaveFromMemory(unsigned long Iterations);
+	bool LoadWaveHit(unsigned long Iterations);
+	bool LoadWaveMiss(unsigned long Iterations);
+	bool VectorArithmetic(unsigned long Iterations);
+	bool VectorNormalise(unsigned long Iterations);
+	bool VectorDistance(unsigned long Iterations);
+	bool PerObjectDistance(unsigned long Iterations);
+	bool PerObjectNormalise(unsigned long Iterations);
+	bool PerObjectDot(unsigned long Iterations);
+	bool PerObjectLerp(unsigned long Iterations);
+	bool BatchDistance(unsigned long Iterations);
+	bool BatchNormalise(unsigned long Iterations);
+	bool BatchDot(unsigned long Iterations);
+	bool BatchLerp(unsigned long Iterations);
+	bool SpatializeBatch(unsigned long Iterations);
+	bool SpatializeX3DAudio(unsigned long Iterations);
+	bool PerEmitterTick10(unsigned long Iterations);
+	bool PerEmitterTick100(unsigned long Iterations);
+	bool PerEmitterTick1000(unsigned long Iterations);
+	bool HitWallOrDoor(unsigned long Iterations);
+	bool GridCell16(unsigned long Iterations);
+	bool GridCell256(unsigned long Iterations);
+	bool GridCell4096(unsigned long Iterations);
+	bool GridBlocked16(unsigned long Iterations);
+	bool GridBlocked256(unsigned long Iterations);
+	bool GridBlocked4096(unsigned long Iterations);
+	bool LoadMansionText(unsigned long Iterations);
+	bool LoadMansionBinary(unsigned long Iterations);
+	bool RasterizeMansion(unsigned long Iterations);
+	bool AStar16(unsigned long Iterations);
+	bool AStar1024(unsigned long Iterations);
+	bool FlowFieldBuild16(unsigned long Iterations);
+	bool FlowFieldBuild1024(unsigned long Iterations);
+	bool FlowDirection16(unsigned long Iterations);
+	bool FlowDirection1024(unsigned long Iterations);
+	bool ActorUpdate1000(unsigned long Iterations);
+	bool ActorUpdate100000(unsigned long Iterations);
+	bool SwarmUpdate(unsigned long Iterations);
+	bool UpdateEmitter(unsigned long Iterations);
+	bool StaticPoseCalculate(unsigned long Iterations);
+	bool StaticPoseTable(unsigned long Iterations);
+	bool WalkPoseCalculate(unsigned long Iterations);
+	bool WalkPoseTable(unsigned long Iterations);
+	bool Apply3D(unsigned long Iterations);
+	bool HeartbeatFrame(unsigned long Iterations);
+	bool UpdateRoom(unsigned long Iterations);
+
+	vector<Benchmark> mBenchmarks;
+	vector<BenchmarkResult> mResults;
+	double mMinTime;
+	unsigned int mRepetitions;
+
+	// Shared by the benchmarks; created by SetUp
+	Room *mRoom;
+	Room *mTickRoom;									// Ticked by UpdateRoom; a new one for each run
+	Emitter *mEmitter;
+	XASound *mSound;
+	X3DAUDIO_LISTENER mListener;
+	X3DAUDIO_EMITTER mEmitterSettings;		// For timing XASound::Apply3D on its own
+	RoomGrid mGrids[BENCHMARK_GRID_SIZES];	// 16, 256 and 4096 cells square
+	string mMansionTextFile;
+	string mMansionBinaryFile;
+	RoomLayout mMansion;
+	RoomGrid mMansionGrid;
+	RoomGrid mPathMaps[BENCHMARK_PATH_MAPS];			// The default room, and the generated map
+	PathFinder mPathFinders[BENCHMARK_PATH_MAPS];
+	vector<GridCell> mPathStarts[BENCHMARK_PATH_MAPS];
+	vector<GridCell> mPathGoals[BENCHMARK_PATH_MAPS];	// All different, so each flow field built is new
+	vector<GridCell> mPath;
+	ActorStore mActorStores[BENCHMARK_ACTOR_STORES];	// 1000 and 100000 actors moving about the room
+	unsigned int mActorRandom;
+	CritterSwarm *mSwarm;
+	vector<X3DAUDIO_VECTOR> mVectorsA;				// The vectors the vector benchmarks work on, in pairs from A and B,
+	vector<X3DAUDIO_VECTOR> mVectorsB;				// into the output vectors and results
+	vector<X3DAUDIO_VECTOR> mVectorsOut;
+	vector<float> mVectorResults;
+	AllanMilne::Audio::Spatializer *mSpatializer;		// For the device's speakers
+	X3DAUDIO_LISTENER mSpatialListener;					// Turned a little from the room's axes
+	X3DAUDIO_CONE mSpatialCone;
+	vector<X3DAUDIO_EMITTER> mSpatialEmitters;
+	vector<const X3DAUDIO_EMITTER*> mSpatialEmitterList;
+	vector<float> mSpatialMatrices;						// BENCHMARK_SPATIAL_EMITTERS matrices, one for each emitter
+	vector<float> mSpatialReference;					// The same from X3DAudio
+	X3DAUDIO_LISTENER mTickListener;						// Heard by the tick emitters, at the centre of the room
+	vector<XASound*> mTickSounds;
+	vector<Emitter*> mTickEmitters;						// Playing, scattered over the room
+	X3DAUDIO_LISTENER mPoseListener;					// Stepped through the poses near the pose emitters
+	XASound *mPoseSounds[2];
+	Emitter *mPoseEmitters[2];							// Playing, still; the second has a panning table
+
+	// Set by a benchmark to the memory used by the data structure it times, to the items it works on each iteration, and to
+	// the mixer's modelled multiply-adds each iteration
+	size_t mMemoryBytes;
+	size_t mItems;
+	double mMixMacs;
+
+	// Results are added to this so the compiler can't remove the work being timed
+	volatile float mSink;
+};
+// end BenchmarkSuite class.
+
+#endif
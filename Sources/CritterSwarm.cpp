@@ -0,0 +1,301 @@
+/*
+	File:	CritterSwarm.cpp
+	Version:	1.1
+	Date:	18th October 2026
+	Author:	agent
+
+	Exposes:	Implementation of the CritterSwarm class.
+	Requires:	ActorStore, RoomGrid, Emitter, XASound, Random, Profiler.
+
+	Description:
+	The critters of a swarm and the emitters that play the nearest of them.
+	*	See CritterSwarm.hpp for details.
+
+	The sound files of the critters are set in the anonymous namespace.
+*/
+
+// System includes.
+#include <Windows.h>
+#include <X3DAudio.h>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <algorithm>
+using std::string;
+using std::vector;
+
+// Framework includes.
+#include "XASound.hpp"
+#include "Profiler.hpp"
+using AllanMilne::Audio::XASound;
+
+// Application includes.
+#include "CritterSwarm.hpp"
+
+// Anonymous namespace defining the sound files and the heights of the critters
+namespace
+{
+	const string BatSoundFile = "Sounds/BatsSound.wav";
+	const string MiceSoundFile = "Sounds/MiceSound.wav";
+
+	// Bats fly at head height and mice run along the floor, as MovingCritter's do
+	const float BatHeight = 1.0f;
+	const float MiceHeight = 0.0f;
+}
+// end anonymous namespace.
+
+
+
+// Function:		CritterSwarm(X3DAUDIO_LISTENER, unsigned int, size_t, RoomGrid) - CritterSwarm constructor
+// Description:		Creates the emitters and scatters the critters over the free cells of the grid, each heading for another
+// In:				X3DAUDIO_LISTENER *Listener - the player's listener, unsigned int Seed - the seed for the swarm's random generator,
+//					size_t Count - the number of critters, const RoomGrid &Grid - the room's grid, which must outlive the swarm
+// Out:				N/a
+CritterSwarm::CritterSwarm(X3DAUDIO_LISTENER *Listener, unsigned int Seed, size_t Count, const RoomGrid &Grid)
+	: mGrid(&Grid), mListener(Listener), mVoiceTime(SWARM_VOICE_INTERVAL), mRandom(Seed, SWARM_RANDOM_STREAM)
+{
+	// Create the emitters, silent until they are given critters; filtering is enabled so that the critter distance curve's
+	// low pass filter can be applied to them
+	X3DAUDIO_VECTOR Origin = { 0.0f, 0.0f, 0.0f };
+	for (int Voice = 0; Voice < SWARM_VOICES; Voice++)
+	{
+		mVoiceSounds[Voice] = new XASound((Voice < SWARM_VOICES / 2) ? BatSoundFile : MiceSoundFile, true);
+		mVoices[Voice] = new Emitter(mVoiceSounds[Voice], Origin, mListener, true);
+		mVoices[Voice]->SetEmitterType(CRITTER_EMITTER);
+		mVoiceCritter[Voice] = ACTOR_NO_EMITTER;
+	}
+
+	// Scatter the critters, alternating bats and mice; a critter that finds no free cell starts in the middle of the room
+	mCritters.Reserve(Count);
+	for (size_t i = 0; i < Count; i++)
+	{
+		BYTE Kind = BYTE(i % KIND_COUNT);
+		X3DAUDIO_VECTOR Position = { float(mGrid->GetWidth()) * 0.5f + 1.0f, (Kind == BATS) ? BatHeight : MiceHeight,
+			float(mGrid->GetDepth()) * 0.5f + 1.0f };
+		FindRandomCell(Position.x, Position.z, false);
+		float Speed = SWARM_MIN_SPEED + (mRandom.NextFloat() * (SWARM_MAX_SPEED - SWARM_MIN_SPEED));
+		size_t Critter = mCritters.AddActor(Position, Speed, Kind);
+		SendToRandomCell(Critter);
+	}
+}
+// End CritterSwarm constructor
+
+
+
+// Function:		~CritterSwarm() - CritterSwarm destructor
+// Description:		Stops and deletes the emitters and their sounds
+// In:				N/a
+// Out:				N/a
+CritterSwarm::~CritterSwarm()
+{
+	for (int Voice = 0; Voice < SWARM_VOICES; Voice++)
+	{
+		mVoices[Voice]->StopEmitter();
+		delete mVoices[Voice];
+		delete mVoiceSounds[Voice];
+	}
+}
+// End CritterSwarm destructor
+
+
+
+// Function:		UpdateSwarm(float) - Update Swarm function
+// Description:		Moves the critters, gives those that arrived new targets, finds the nearest critters for the emitters when
+//					the interval has passed, and moves the emitters with their critters
+// In:				float DeltaTime - the time in seconds since the last update
+// Out:				N/a
+void CritterSwarm::UpdateSwarm(float DeltaTime)
+{
+	PROFILE_SCOPE("CritterSwarm::UpdateSwarm");
+
+	// Move every critter, then send those that arrived on to their next cells
+	if (mCritters.Update(DeltaTime) > 0)
+	{
+		const vector<UINT32> &Arrived = mCritters.GetArrived();
+		for (auto Critter = Arrived.begin(); Critter != Arrived.end(); ++Critter)
+		{
+			SendToRandomCell(*Critter);
+		}
+	}
+
+	mVoiceTime += DeltaTime;
+	if (mVoiceTime >= SWARM_VOICE_INTERVAL)
+	{
+		AssignVoices();
+		mVoiceTime = 0.0f;
+	}
+
+	// Move the emitters with their critters
+	for (int Voice = 0; Voice < SWARM_VOICES; Voice++)
+	{
+		if (mVoiceCritter[Voice] != ACTOR_NO_EMITTER)
+		{
+			mVoices[Voice]->SetPosition(mCritters.GetPosition(mVoiceCritter[Voice]));
+			mVoices[Voice]->UpdateEmitter();
+		}
+	}
+}
+// End UpdateSwarm function
+
+
+
+// Function:		UpdateEmitters() - Update Emitters function
+// Description:		Updates the emitters that are following critters, for the listener's current position and orientation
+// In:				N/a
+// Out:				N/a
+void CritterSwarm::UpdateEmitters()
+{
+	for (int Voice = 0; Voice < SWARM_VOICES; Voice++)
+	{
+		if (mVoiceCritter[Voice] != ACTOR_NO_EMITTER)
+		{
+			mVoices[Voice]->UpdateEmitter();
+		}
+	}
+}
+// End UpdateEmitters function
+
+
+
+// Function:		Stop() - Stop function
+// Description:		Stops the emitters playing
+// In:				N/a
+// Out:				N/a
+void CritterSwarm::Stop()
+{
+	for (int Voice = 0; Voice < SWARM_VOICES; Voice++)
+	{
+		mVoices[Voice]->StopEmitter();
+	}
+}
+// End Stop function
+
+
+
+// Function:		IsValid() - Is Valid function
+// Description:		Returns true if the emitters' sounds have been set up correctly, false otherwise
+// In:				N/a
+// Out:				bool - True if all sounds were created successfully, false if not
+bool CritterSwarm::IsValid() const
+{
+	for (int Voice = 0; Voice < SWARM_VOICES; Voice++)
+	{
+		if (!mVoiceSounds[Voice]->IsValid())
+		{
+			return false;
+		}
+	}
+	return true;
+}
+// End IsValid function
+
+
+
+// Function:		FindRandomCell(float, float, bool) - Find Random Cell function
+// Description:		Chooses a cell of the grid at random, up to SWARM_TARGET_TRIES times until a free one is found; if asked,
+//					the cell must also be in sight of the room position passed in, with no wall or obstacle on the straight
+//					line to it
+// In:				float &X, float &Z - the room position the cell must be in sight of, set to the room position of the
+//					centre of the cell found, bool InSight - true if the cell must be in sight
+// Out:				bool - false if none of the cells tried is free, or in sight if asked
+bool CritterSwarm::FindRandomCell(float &X, float &Z, bool InSight)
+{
+	if ((mGrid->GetWidth() <= 0) || (mGrid->GetDepth() <= 0))
+	{
+		return false;
+	}
+
+	// Cell (x, z) covers the room positions from (x + 1, z + 1) to (x + 2, z + 2), so the grid is 1 behind the room
+	const float FromX = X - 1.0f;
+	const float FromZ = Z - 1.0f;
+	for (int Try = 0; Try < SWARM_TARGET_TRIES; Try++)
+	{
+		int CellX = int(mRandom.NextBelow(UINT32(mGrid->GetWidth())));
+		int CellZ = int(mRandom.NextBelow(UINT32(mGrid->GetDepth())));
+		if ((!mGrid->IsBlocked(CellX, CellZ)) && ((!InSight) || mGrid->IsLineClear(FromX, FromZ, float(CellX) + 0.5f, float(CellZ) + 0.5f)))
+		{
+			X = float(CellX) + 1.5f;
+			Z = float(CellZ) + 1.5f;
+			return true;
+		}
+	}
+	return false;
+}
+// End FindRandomCell function
+
+
+
+// Function:		SendToRandomCell(size_t) - Send To Random Cell function
+// Description:		Sends a critter to the centre of a free cell in its sight chosen at random; if none of the cells tried is
+//					free and in sight, to where it is, so it tries again on the next update
+// In:				size_t Critter - the critter
+// Out:				N/a
+void CritterSwarm::SendToRandomCell(size_t Critter)
+{
+	// A critter in a blocked cell, which only happens if it found no free cell to start in, can see nothing, so it runs
+	// for any free cell to get out
+	X3DAUDIO_VECTOR Target = mCritters.GetPosition(Critter);
+	bool InSight = !mGrid->IsBlocked(int(floorf(Target.x - 1.0f)), int(floorf(Target.z - 1.0f)));
+	FindRandomCell(Target.x, Target.z, InSight);
+	mCritters.SetTarget(Critter, Target.x, Target.z);
+}
+// End SendToRandomCell function
+
+
+
+// Function:		AssignVoices() - Assign Voices function
+// Description:		Gives the emitters of each kind to the critters of that kind nearest the listener, leaving a critter that
+//					stays among the nearest with the emitter it has, and pauses the emitters left without a critter
+// In:				N/a
+// Out:				N/a
+void CritterSwarm::AssignVoices()
+{
+	const int KindVoices = SWARM_VOICES / KIND_COUNT;
+	for (int Kind = 0; Kind < KIND_COUNT; Kind++)
+	{
+		const int FirstVoice = Kind * KindVoices;
+		mCritters.FindNearest(mListener->Position.x, mListener->Position.z, BYTE(Kind), KindVoices, mNearest);
+
+		// Free the emitters whose critters are no longer among the nearest
+		bool Freed[SWARM_VOICES] = { false };
+		for (int Voice = FirstVoice; Voice < FirstVoice + KindVoices; Voice++)
+		{
+			int Critter = mVoiceCritter[Voice];
+			if ((Critter != ACTOR_NO_EMITTER) && (std::find(mNearest.begin(), mNearest.end(), UINT32(Critter)) == mNearest.end()))
+			{
+				mCritters.SetEmitter(Critter, ACTOR_NO_EMITTER);
+				mVoiceCritter[Voice] = ACTOR_NO_EMITTER;
+				Freed[Voice] = true;
+			}
+		}
+
+		// Give the free emitters to the nearest critters without one
+		int Voice = FirstVoice;
+		for (auto Critter = mNearest.begin(); Critter != mNearest.end(); ++Critter)
+		{
+			if (mCritters.GetEmitter(*Critter) != ACTOR_NO_EMITTER)
+			{
+				continue;
+			}
+			while (mVoiceCritter[Voice] != ACTOR_NO_EMITTER)
+			{
+				Voice++;
+			}
+			mVoiceCritter[Voice] = int(*Critter);
+			mCritters.SetEmitter(*Critter, Voice);
+			mVoices[Voice]->SetPosition(mCritters.GetPosition(*Critter));
+			mVoices[Voice]->PlayEmitter();
+		}
+
+		// Pause the emitters freed and not given another critter, which only happens when there are fewer critters of the kind
+		// than emitters
+		for (Voice = FirstVoice; Voice < FirstVoice + KindVoices; Voice++)
+		{
+			if (Freed[Voice] && (mVoiceCritter[Voice] == ACTOR_NO_EMITTER))
+			{
+				mVoices[Voice]->PauseEmitter();
+			}
+		}
+	}
+}
+// End AssignVoices function
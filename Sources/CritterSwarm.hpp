@@ -0,0 +1,160 @@
+/*
+	File:	CritterSwarm.hpp
+	Version:	1.1
+	Date:	18th October 2026
+	Author:	agent
+
+	Exposes:	CritterSwarm.
+	Requires:	ActorStore, RoomGrid, Emitter, XASound, Random.
+
+	Description:
+	Models a swarm of bats and mice scurrying about the room, hundreds or thousands of them rather than MovingCritter's one group.
+	The critters are held in an ActorStore rather than as objects, so a tick moves them all in a single loop over its arrays.
+
+	The class exposes behaviour to:
+	*	Scatter the critters over the free cells of the room's grid, alternating bats and mice, each with its own speed;
+	*	Send each critter to a new free cell, chosen at random, whenever it arrives at its last one; the critters run in
+		straight lines, so only cells in sight are chosen, with no wall or obstacle on the line to them (see
+		RoomGrid::IsLineClear). A critter gets round an obstacle over several runs rather than following a path, so a swarm of
+		thousands needs no paths or flow fields of its own;
+	*	Play the critters through a few voices: SWARM_VOICES emitters, half for bats and half for mice, which follow the critters
+		of their kind nearest the listener. The nearest are found again every SWARM_VOICE_INTERVAL seconds; a critter that stays
+		among the nearest keeps its emitter, and the ActorStore holds the emitter handle of each critter.
+*/
+
+// Define the class
+#ifndef __CRITTERSWARM_HPP__
+#define __CRITTERSWARM_HPP__
+
+// System includes.
+#include <Windows.h>
+#include <X3DAudio.h>
+#include <vector>
+using std::vector;
+
+// Framework includes.
+#include "XASound.hpp"
+using AllanMilne::Audio::XASound;
+
+// Application includes.
+#include "ActorStore.hpp"
+#include "RoomGrid.hpp"
+#include "Emitter.hpp"
+#include "Random.hpp"
+
+// The number of emitters playing the swarm; half play the nearest bats and half the nearest mice
+#define SWARM_VOICES 8
+
+// The time (in seconds) between finding the critters nearest the listener for the emitters to follow
+#define SWARM_VOICE_INTERVAL 0.25f
+
+// The range of the critters' speeds, in units per second
+#define SWARM_MIN_SPEED 1.5f
+#define SWARM_MAX_SPEED 4.0f
+
+// The number of random cells tried for a critter's next target before it waits where it is for a tick and tries again
+#define SWARM_TARGET_TRIES 8
+
+// The stream of the swarm's random generator, so its sequence differs from the player's, ghost's and critters'
+#define SWARM_RANDOM_STREAM 4
+
+// The CritterSwarm class
+class CritterSwarm
+{
+// Public Member functions and variables
+public:
+
+	// Function:		CritterSwarm(X3DAUDIO_LISTENER, unsigned int, size_t, RoomGrid) - CritterSwarm constructor
+	// Description:		Creates the emitters and scatters the critters over the free cells of the grid, each heading for another
+	// In:				X3DAUDIO_LISTENER *Listener - the player's listener, unsigned int Seed - the seed for the swarm's random generator,
+	//					size_t Count - the number of critters, const RoomGrid &Grid - the room's grid, which must outlive the swarm
+	// Out:				N/a
+	CritterSwarm(X3DAUDIO_LISTENER *Listener, unsigned int Seed, size_t Count, const RoomGrid &Grid);
+
+	// Function:		~CritterSwarm() - CritterSwarm destructor
+	// Description:		Stops and deletes the emitters and their sounds
+	// In:				N/a
+	// Out:				N/a
+	~CritterSwarm();
+
+	// Function:		UpdateSwarm(float) - Update Swarm function
+	// Description:		Moves the critters, gives those that arrived new targets, finds the nearest critters for the emitters when
+	//					the interval has passed, and moves the emitters with their critters
+	// In:				float DeltaTime - the time in seconds since the last update
+	// Out:				N/a
+	void UpdateSwarm(float DeltaTime);
+
+	// Function:		UpdateEmitters() - Update Emitters function
+	// Description:		Updates the emitters that are following critters, for the listener's current position and orientation
+	// In:				N/a
+	// Out:				N/a
+	void UpdateEmitters();
+
+	// Function:		Stop() - Stop function
+	// Description:		Stops the emitters playing
+	// In:				N/a
+	// Out:				N/a
+	void Stop();
+
+	// Function:		IsValid() - Is Valid function
+	// Description:		Returns true if the emitters' sounds have been set up correctly, false otherwise
+	// In:				N/a
+	// Out:				bool - True if all sounds were created successfully, false if not
+	bool IsValid() const;
+
+	// The critters, and the memory they take
+	inline const ActorStore& GetCritters() const { return mCritters; }
+	inline size_t GetMemoryUsed() const { return mCritters.GetMemoryUsed(); }
+
+// Private member functions and variables
+private:
+
+	// The kinds of critter, which are their kinds in the ActorStore
+	enum CritterKind { BATS, MICE, KIND_COUNT };
+
+	// Function:		FindRandomCell(float, float, bool) - Find Random Cell function
+	// Description:		Chooses a cell of the grid at random, up to SWARM_TARGET_TRIES times until a free one is found; if asked,
+	//					the cell must also be in sight of the room position passed in, with no wall or obstacle on the straight
+	//					line to it
+	// In:				float &X, float &Z - the room position the cell must be in sight of, set to the room position of the
+	//					centre of the cell found, bool InSight - true if the cell must be in sight
+	// Out:				bool - false if none of the cells tried is free, or in sight if asked
+	bool FindRandomCell(float &X, float &Z, bool InSight);
+
+	// Function:		SendToRandomCell(size_t) - Send To Random Cell function
+	// Description:		Sends a critter to the centre of a free cell in its sight chosen at random; if none of the cells tried is
+	//					free and in sight, to where it is, so it tries again on the next update
+	// In:				size_t Critter - the critter
+	// Out:				N/a
+	void SendToRandomCell(size_t Critter);
+
+	// Function:		AssignVoices() - Assign Voices function
+	// Description:		Gives the emitters of each kind to the critters of that kind nearest the listener, leaving a critter that
+	//					stays among the nearest with the emitter it has, and pauses the emitters left without a critter
+	// In:				N/a
+	// Out:				N/a
+	void AssignVoices();
+
+	// The critters
+	ActorStore mCritters;
+
+	// The room's grid, which isn't owned, and the player's listener
+	const RoomGrid *mGrid;
+	X3DAUDIO_LISTENER *mListener;
+
+	// The emitters and their sounds, and the critter each is following; ACTOR_NO_EMITTER if none. The first half play bats,
+	// the second half mice
+	Emitter *mVoices[SWARM_VOICES];
+	XASound *mVoiceSounds[SWARM_VOICES];
+	int mVoiceCritter[SWARM_VOICES];
+
+	// The time since the nearest critters were last found, and the critters found
+	float mVoiceTime;
+	vector<UINT32> mNearest;
+
+	// The swarm's own random generator, for the critters' places, speeds and targets
+	Random mRandom;
+};
+// end CritterSwarm class.
+
+#endif
@@ -0,0 +1,212 @@
+/*
+	--Original--
+	file:	DistanceCurves.cpp
+	Version:	1.0
+	Date:		18th October 2026
+	Author:		agent
+
+	Exposes:	Implementation of the DistanceCurve and DistanceCurves classes.
+	Requires:	X3DAudio
+
+	Description:
+	Holds the distance curves of each emitter type and the lookup tables used to evaluate them.
+	*	See DistanceCurves.hpp for details.
+
+	The room is 16 by 16 units, so the ghost and its events are heard over about 20 units; the critters start and end well
+	outside the room so their curves reach further. The outdoor noise is filtered by the door, so it has no air absorption curve.
+*/
+
+// Application includes
+#include "DistanceCurves.hpp"
+
+// Anonymous namespace defining the curve points for each emitter type; distances are normalised to the set's DistanceScaler
+namespace
+{
+	// Ghost: stays clear close by, then fades so that the player has to search for it
+	const X3DAUDIO_DISTANCE_CURVE_POINT GhostVolume[] = { {0.0f, 1.0f}, {0.1f, 1.0f}, {0.5f, 0.35f}, {1.0f, 0.1f} };
+	const X3DAUDIO_DISTANCE_CURVE_POINT GhostLFE[] = { {0.0f, 1.0f}, {0.25f, 0.5f}, {1.0f, 0.0f} };
+	const X3DAUDIO_DISTANCE_CURVE_POINT GhostLPF[] = { {0.0f, 1.0f}, {0.5f, 0.75f}, {1.0f, 0.45f} };
+	const X3DAUDIO_DISTANCE_CURVE_POINT GhostReverb[] = { {0.0f, 1.0f}, {1.0f, 0.7f} };
+
+	// Events (piano, typewriter, knocking, radio): louder at a distance than the ghost so they can be found from across the room
+	const X3DAUDIO_DISTANCE_CURVE_POINT EventVolume[] = { {0.0f, 1.0f}, {0.15f, 1.0f}, {0.6f, 0.5f}, {1.0f, 0.2f} };
+	const X3DAUDIO_DISTANCE_CURVE_POINT EventLFE[] = { {0.0f, 1.0f}, {0.3f, 0.6f}, {1.0f, 0.1f} };
+	const X3DAUDIO_DISTANCE_CURVE_POINT EventLPF[] = { {0.0f, 1.0f}, {0.6f, 0.8f}, {1.0f, 0.55f} };
+	const X3DAUDIO_DISTANCE_CURVE_POINT EventReverb[] = { {0.0f, 1.0f}, {1.0f, 0.7f} };
+
+	// Critters: pass close by the player from well outside the room, fading out completely at the ends of their path
+	const X3DAUDIO_DISTANCE_CURVE_POINT CritterVolume[] = { {0.0f, 1.0f}, {0.2f, 0.8f}, {0.6f, 0.25f}, {1.0f, 0.0f} };
+	const X3DAUDIO_DISTANCE_CURVE_POINT CritterLFE[] = { {0.0f, 1.0f}, {0.2f, 0.3f}, {1.0f, 0.0f} };
+	const X3DAUDIO_DISTANCE_CURVE_POINT CritterLPF[] = { {0.0f, 1.0f}, {0.3f, 0.7f}, {1.0f, 0.3f} };
+	const X3DAUDIO_DISTANCE_CURVE_POINT CritterReverb[] = { {0.0f, 1.0f}, {1.0f, 0.5f} };
+
+	// Outdoor noise: a gentle fall off so it can be followed to the door from anywhere in the room
+	const X3DAUDIO_DISTANCE_CURVE_POINT OutdoorVolume[] = { {0.0f, 1.0f}, {0.3f, 0.6f}, {1.0f, 0.2f} };
+	const X3DAUDIO_DISTANCE_CURVE_POINT OutdoorLFE[] = { {0.0f, 1.0f}, {1.0f, 0.3f} };
+	const X3DAUDIO_DISTANCE_CURVE_POINT OutdoorReverb[] = { {0.0f, 0.8f}, {1.0f, 0.4f} };
+
+	// The number of points in a fixed size array of points
+	template <int Count>
+	inline int PointCount(const X3DAUDIO_DISTANCE_CURVE_POINT (&)[Count]) { return Count; }
+}
+
+
+// Static member initialisations
+DistanceCurveSet DistanceCurves::mCurveSets[EMITTER_TYPE_COUNT];
+bool DistanceCurves::mBuilt = false;
+
+
+
+// Function:		DistanceCurve() - Distance Curve constructor
+// Description:		Creates an empty curve; an empty curve is not passed to X3DAudio so its default is used
+// In:				N/a
+// Out:				N/a
+DistanceCurve::DistanceCurve()
+{
+	mCurve.pPoints = mPoints;
+	mCurve.PointCount = 0;
+	for (int i = 0; i <= DISTANCE_CURVE_TABLE_SIZE; i++)
+	{
+		mTable[i] = 1.0f;
+	}
+}
+// End DistanceCurve constructor
+
+
+
+// Function:		SetPoints(X3DAUDIO_DISTANCE_CURVE_POINT, int) - Set Points function
+// Description:		Copies the points of the curve and precomputes the lookup table from them. The first point must be at distance 0
+//					and the last at 1, in increasing order of distance, as X3DAudio requires.
+// In:				const X3DAUDIO_DISTANCE_CURVE_POINT *Points - the points, int PointCount - the number of points (at most
+//					MAX_DISTANCE_CURVE_POINTS)
+// Out:				bool - false if the points are not a valid curve, in which case the curve is left empty
+bool DistanceCurve::SetPoints(const X3DAUDIO_DISTANCE_CURVE_POINT *Points, int PointCount)
+{
+	mCurve.PointCount = 0;
+
+	// Check the points are a curve X3DAudio will accept
+	if ((PointCount < 2) || (PointCount > MAX_DISTANCE_CURVE_POINTS))
+	{
+		return false;
+	}
+	if ((Points[0].Distance != 0.0f) || (Points[PointCount - 1].Distance != 1.0f))
+	{
+		return false;
+	}
+	for (int i = 1; i < PointCount; i++)
+	{
+		if (Points[i].Distance <= Points[i - 1].Distance)
+		{
+			return false;
+		}
+	}
+
+	for (int i = 0; i < PointCount; i++)
+	{
+		mPoints[i] = Points[i];
+	}
+	mCurve.PointCount = PointCount;
+
+	// Sample the curve at even distances; each sample is a linear interpolation between the points either side of it
+	int Segment = 0;
+	for (int i = 0; i <= DISTANCE_CURVE_TABLE_SIZE; i++)
+	{
+		float Distance = float(i) / float(DISTANCE_CURVE_TABLE_SIZE);
+		while ((Segment < PointCount - 2) && (Distance > mPoints[Segment + 1].Distance))
+		{
+			Segment++;
+		}
+		const X3DAUDIO_DISTANCE_CURVE_POINT &Start = mPoints[Segment];
+		const X3DAUDIO_DISTANCE_CURVE_POINT &End = mPoints[Segment + 1];
+		float Fraction = (Distance - Start.Distance) / (End.Distance - Start.Distance);
+		mTable[i] = Start.DSPSetting + ((End.DSPSetting - Start.DSPSetting) * Fraction);
+	}
+	return true;
+}
+// End SetPoints function
+
+
+
+// Function:		Evaluate(float) - Evaluate function
+// Description:		Returns the value of the curve at a normalised distance from the lookup table; distances past 1 hold the last value
+// In:				float NormalisedDistance - the distance divided by the curve set's DistanceScaler
+// Out:				float - the value of the curve, or 1 if the curve is empty
+float DistanceCurve::Evaluate(float NormalisedDistance) const
+{
+	if (NormalisedDistance <= 0.0f)
+	{
+		return mTable[0];
+	}
+	if (NormalisedDistance >= 1.0f)
+	{
+		return mTable[DISTANCE_CURVE_TABLE_SIZE];
+	}
+
+	// Interpolate between the two samples either side of the distance
+	float Position = NormalisedDistance * DISTANCE_CURVE_TABLE_SIZE;
+	int Index = int(Position);
+	float Fraction = Position - float(Index);
+	return mTable[Index] + ((mTable[Index + 1] - mTable[Index]) * Fraction);
+}
+// End Evaluate function
+
+
+
+// Function:		GetCurveSet(EmitterType) - Get Curve Set function
+// Description:		Returns the curve set for a type of emitter, building all of the curve sets the first time it is called
+// In:				EmitterType Type - the type of emitter
+// Out:				DistanceCurveSet* - the curve set, or NULL if the type is not valid
+DistanceCurveSet* DistanceCurves::GetCurveSet(EmitterType Type)
+{
+	if ((Type < 0) || (Type >= EMITTER_TYPE_COUNT))
+	{
+		return NULL;
+	}
+	if (!mBuilt)
+	{
+		BuildCurveSets();
+	}
+	return &mCurveSets[Type];
+}
+// End GetCurveSet function
+
+
+
+// Function:		BuildCurveSets() - Build Curve Sets function
+// Description:		Sets the points of the curves for every type of emitter
+// In:				N/a
+// Out:				N/a
+void DistanceCurves::BuildCurveSets()
+{
+	DistanceCurveSet &Ghost = mCurveSets[GHOST_EMITTER];
+	Ghost.DistanceScaler = 20.0f;
+	Ghost.Volume.SetPoints(GhostVolume, PointCount(GhostVolume));
+	Ghost.LFE.SetPoints(GhostLFE, PointCount(GhostLFE));
+	Ghost.LPFDirect.SetPoints(GhostLPF, PointCount(GhostLPF));
+	Ghost.Reverb.SetPoints(GhostReverb, PointCount(GhostReverb));
+
+	DistanceCurveSet &Event = mCurveSets[EVENT_EMITTER];
+	Event.DistanceScaler = 20.0f;
+	Event.Volume.SetPoints(EventVolume, PointCount(EventVolume));
+	Event.LFE.SetPoints(EventLFE, PointCount(EventLFE));
+	Event.LPFDirect.SetPoints(EventLPF, PointCount(EventLPF));
+	Event.Reverb.SetPoints(EventReverb, PointCount(EventReverb));
+
+	DistanceCurveSet &Critter = mCurveSets[CRITTER_EMITTER];
+	Critter.DistanceScaler = 30.0f;
+	Critter.Volume.SetPoints(CritterVolume, PointCount(CritterVolume));
+	Critter.LFE.SetPoints(CritterLFE, PointCount(CritterLFE));
+	Critter.LPFDirect.SetPoints(CritterLPF, PointCount(CritterLPF));
+	Critter.Reverb.SetPoints(CritterReverb, PointCount(CritterReverb));
+
+	DistanceCurveSet &Outdoor = mCurveSets[OUTDOOR_EMITTER];
+	Outdoor.DistanceScaler = 20.0f;
+	Outdoor.Volume.SetPoints(OutdoorVolume, PointCount(OutdoorVolume));
+	Outdoor.LFE.SetPoints(OutdoorLFE, PointCount(OutdoorLFE));
+	Outdoor.Reverb.SetPoints(OutdoorReverb, PointCount(OutdoorReverb));
+
+	mBuilt = true;
+}
+// End BuildCurveSets function
+
+// end of code.
@@ -0,0 +1,128 @@
+/*
+	file:	DistanceCurves.hpp
+	Version:	1.0
+	Date:		18th October 2026
+	Author:		agent
+
+	Exposes:	EmitterType, DistanceCurve, DistanceCurveSet, DistanceCurves
+	Requires:	X3DAudio
+
+	Description:
+	Without curves X3DAudio attenuates every emitter with the same inverse distance law and applies no air absorption.
+	These classes hold piecewise distance curves for each type of emitter in the application (ghost, ghost events, critters
+	and the outdoor noise) so that each can fall off in its own way:
+	*	Volume - the gain applied to the output matrix
+	*	LFE - the gain of the low frequency effects channel
+	*	LPF direct - the low pass filter coefficient for the direct path (air absorption; high frequencies fade with distance)
+	*	Reverb - the send level to the reverberant sound, used for the level of the early reflections
+
+	Curve distances are normalised; 1.0 is the DistanceScaler of the curve set, which is set as the emitter's CurveDistanceScaler.
+	Each curve is passed to X3DAudio as an X3DAUDIO_DISTANCE_CURVE, and a lookup table of evenly spaced samples is precomputed
+	from its points so the application can evaluate the curve without searching the points (used for the reverb send level).
+
+	The curve sets are built once, the first time one is requested, and are shared by all emitters of the same type.
+*/
+
+// Define the class
+#ifndef DISTANCE_CURVES_H
+#define DISTANCE_CURVES_H
+
+// System includes
+#include <Windows.h>
+#include <X3DAudio.h>
+
+// The maximum number of points in a curve
+#define MAX_DISTANCE_CURVE_POINTS 8
+
+// The number of intervals in a curve's lookup table; the table holds one more sample than this
+#define DISTANCE_CURVE_TABLE_SIZE 64
+
+// The types of emitter that have their own distance curves
+enum EmitterType {
+	GHOST_EMITTER,
+	EVENT_EMITTER,
+	CRITTER_EMITTER,
+	OUTDOOR_EMITTER,
+	EMITTER_TYPE_COUNT
+};
+
+// The DistanceCurve class
+class DistanceCurve
+{
+
+// Public Member Functions and Variables
+public:
+	// Function:		DistanceCurve() - Distance Curve constructor
+	// Description:		Creates an empty curve; an empty curve is not passed to X3DAudio so its default is used
+	// In:				N/a
+	// Out:				N/a
+	DistanceCurve();
+
+	// Function:		SetPoints(X3DAUDIO_DISTANCE_CURVE_POINT, int) - Set Points function
+	// Description:		Copies the points of the curve and precomputes the lookup table from them. The first point must be at distance 0
+	//					and the last at 1, in increasing order of distance, as X3DAudio requires.
+	// In:				const X3DAUDIO_DISTANCE_CURVE_POINT *Points - the points, int PointCount - the number of points (at most
+	//					MAX_DISTANCE_CURVE_POINTS)
+	// Out:				bool - false if the points are not a valid curve, in which case the curve is left empty
+	bool SetPoints(const X3DAUDIO_DISTANCE_CURVE_POINT *Points, int PointCount);
+
+	// Function:		Evaluate(float) - Evaluate function
+	// Description:		Returns the value of the curve at a normalised distance from the lookup table; distances past 1 hold the last value
+	// In:				float NormalisedDistance - the distance divided by the curve set's DistanceScaler
+	// Out:				float - the value of the curve, or 1 if the curve is empty
+	float Evaluate(float NormalisedDistance) const;
+
+	// Function:		GetCurve() - Get Curve function
+	// Description:		Returns the curve in the form X3DAudio uses, or NULL if the curve is empty
+	// In:				N/a
+	// Out:				X3DAUDIO_DISTANCE_CURVE* - the curve
+	inline X3DAUDIO_DISTANCE_CURVE* GetCurve() { return (mCurve.PointCount > 0) ? &mCurve : NULL; }
+
+// Private Member Functions and Variables
+private:
+	// The points of the curve and the X3DAudio curve struct that refers to them
+	X3DAUDIO_DISTANCE_CURVE_POINT mPoints[MAX_DISTANCE_CURVE_POINTS];
+	X3DAUDIO_DISTANCE_CURVE mCurve;
+
+	// Samples of the curve at distances 0, 1/DISTANCE_CURVE_TABLE_SIZE ... 1
+	float mTable[DISTANCE_CURVE_TABLE_SIZE + 1];
+};
+// End of DistanceCurve class
+
+// The curves for one type of emitter
+struct DistanceCurveSet
+{
+	float DistanceScaler;		// The distance in world units that the curves' distance of 1.0 represents
+	DistanceCurve Volume;
+	DistanceCurve LFE;
+	DistanceCurve LPFDirect;	// Left empty for emitters whose filter is controlled elsewhere
+	DistanceCurve Reverb;
+};
+
+// The DistanceCurves class
+class DistanceCurves
+{
+
+// Public Member Functions and Variables
+public:
+	// Function:		GetCurveSet(EmitterType) - Get Curve Set function
+	// Description:		Returns the curve set for a type of emitter, building all of the curve sets the first time it is called
+	// In:				EmitterType Type - the type of emitter
+	// Out:				DistanceCurveSet* - the curve set, or NULL if the type is not valid
+	static DistanceCurveSet* GetCurveSet(EmitterType Type);
+
+// Private Member Functions and Variables
+private:
+	// Function:		BuildCurveSets() - Build Curve Sets function
+	// Description:		Sets the points of the curves for every type of emitter
+	// In:				N/a
+	// Out:				N/a
+	static void BuildCurveSets();
+
+	// The curve sets for each emitter type
+	static DistanceCurveSet mCurveSets[EMITTER_TYPE_COUNT];
+	static bool mBuilt;
+};
+// End of DistanceCurves class
+
+#endif
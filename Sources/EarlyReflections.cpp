@@ -0,0 +1,746 @@
+/*
+	--Original--
+	file:	EarlyReflections.cpp
+	Version:	1.2
+	Date:		18th October 2026
+	Author:		agent
+
+	Exposes:	Implementation of the EarlyReflections class.
+	Requires:	X3DAudio, XASound, XACore, PCMWave
+
+	Description:
+	Has the functionality to find the image sources of an emitter in the rectangular room, select the audible reflections
+	and render them as delayed, attenuated and spatialised tap voices.
+	*	See EarlyReflections.hpp for details.
+
+	The image table is built from the room bounds; for an image, Position = Sign * SourcePosition + Offset on the x and z axes,
+	so moving the source only needs the signs and offsets rather than a new search.
+	Only the walls are modelled; the floor and ceiling are not, so the y position of each image is the source's y position.
+*/
+
+// System includes
+#include <math.h>
+
+// Framework includes
+#include "XACore.hpp"
+using AllanMilne::Audio::XACore;
+
+// Application includes
+#include "EarlyReflections.hpp"
+
+
+// Static member initialisations; the room bounds default to the wall cells of the 16 by 16 room
+float EarlyReflections::mMinX = 1.0f;
+float EarlyReflections::mMaxX = 16.0f;
+float EarlyReflections::mMinZ = 1.0f;
+float EarlyReflections::mMaxZ = 16.0f;
+float EarlyReflections::mDoorMinX = 0.0f;
+float EarlyReflections::mDoorMaxX = 0.0f;
+bool EarlyReflections::mDoorOpen = false;
+EarlyReflections::ImageSource EarlyReflections::mImages[IMAGE_SOURCE_COUNT];
+list<EarlyReflections*> EarlyReflections::mInstances;
+int EarlyReflections::mTapsRenderedThisFrame = 0;
+unsigned long EarlyReflections::mTotalTapsRendered = 0;
+unsigned long EarlyReflections::mTapsDeferred = 0;
+unsigned long EarlyReflections::mCacheHits = 0;
+unsigned long EarlyReflections::mCacheMisses = 0;
+
+
+
+// Function:		EarlyReflections(X3DAUDIO_EMITTER, X3DAUDIO_LISTENER) - Early Reflections constructor
+// Description:		Stores the emitter and listener structs that the reflections are based on and registers the object so
+//					that it is updated in UpdateFrame. No taps are created until SetSound is called.
+// In:				const X3DAUDIO_EMITTER *ParentEmitter - the emitter struct of the emitter that owns this object
+//					X3DAUDIO_LISTENER *Listener - pointer to the Player's listener struct
+// Out:				N/a
+EarlyReflections::EarlyReflections(const X3DAUDIO_EMITTER *ParentEmitter, X3DAUDIO_LISTENER *Listener)
+{
+	mParentEmitter = ParentEmitter;
+	mListener = Listener;
+
+	// No sound or taps until SetSound is called
+	mSound = NULL;
+	mTaps = NULL;
+	mCurrentSet.TapCount = 0;
+	mCurrentKey = 0;
+	mSendLevel = 0.0f;
+	mOnsetBaseline = 0;
+	mOnsetRunning = false;
+
+	// Build the image table the first time a reflection object is created
+	if (mInstances.empty())
+	{
+		BuildImageTable();
+	}
+
+	// Add this object to the list so that UpdateFrame updates its taps
+	mInstances.push_back(this);
+}
+// End EarlyReflections constructor
+
+
+
+// Function:		~EarlyReflections() - Early Reflections destructor
+// Description:		Stops and deletes all of the tap sounds and removes the object from the update list
+// In:				N/a
+// Out:				N/a
+EarlyReflections::~EarlyReflections()
+{
+	for (auto WaveTaps = mTapVoices.begin(); WaveTaps != mTapVoices.end(); ++WaveTaps)
+	{
+		for (auto Tap = WaveTaps->second.begin(); Tap != WaveTaps->second.end(); ++Tap)
+		{
+			delete Tap->Sound;
+		}
+	}
+	mInstances.remove(this);
+}
+// End EarlyReflections destructor
+
+
+
+// Function:		SetRoomBounds(float, float, float, float) - Set Room Bounds function
+// Description:		Sets the positions of the four wall planes used to find the image sources. Shared by all reflection objects.
+// In:				float MinX, float MaxX - the x positions of the left and right walls
+//					float MinZ, float MaxZ - the z positions of the bottom (door) and top walls
+// Out:				N/a
+void EarlyReflections::SetRoomBounds(float MinX, float MaxX, float MinZ, float MaxZ)
+{
+	mMinX = MinX;
+	mMaxX = MaxX;
+	mMinZ = MinZ;
+	mMaxZ = MaxZ;
+	BuildImageTable();
+
+	// Any cached reflection sets were found for the old bounds
+	for (auto Instance = mInstances.begin(); Instance != mInstances.end(); ++Instance)
+	{
+		(*Instance)->mSetCache.clear();
+		if ((*Instance)->mTaps != NULL)
+		{
+			(*Instance)->SelectReflectionSet();
+		}
+	}
+}
+// End SetRoomBounds function
+
+
+
+// Function:		SetDoor(float, float, bool) - Set Door function
+// Description:		Sets the span of the door in the bottom wall and if it is open. An open door does not reflect, so reflections
+//					from the door span are dropped; a closed door reflects less than the walls.
+// In:				float DoorX - the x position of the centre of the door, float DoorWidth - the width of the door
+//					bool DoorOpen - true if the door is open
+// Out:				N/a
+void EarlyReflections::SetDoor(float DoorX, float DoorWidth, bool DoorOpen)
+{
+	// Whether the door is open is part of the cache key, but where it is isn't; sets found for another span are no use
+	bool Moved = (mDoorMinX != DoorX - (DoorWidth / 2.0f)) || (mDoorMaxX != DoorX + (DoorWidth / 2.0f));
+	mDoorMinX = DoorX - (DoorWidth / 2.0f);
+	mDoorMaxX = DoorX + (DoorWidth / 2.0f);
+	mDoorOpen = DoorOpen;
+
+	for (auto Instance = mInstances.begin(); Instance != mInstances.end(); ++Instance)
+	{
+		if (Moved)
+		{
+			(*Instance)->mSetCache.clear();
+		}
+		if ((*Instance)->mTaps != NULL)
+		{
+			(*Instance)->SelectReflectionSet();
+		}
+	}
+}
+// End SetDoor function
+
+
+
+// Function:		BuildImageTable() - Build Image Table function
+// Description:		Fills the static image table with the sign/offset of the 12 images for the current room bounds
+// In:				N/a
+// Out:				N/a
+void EarlyReflections::BuildImageTable()
+{
+	// Reflecting a coordinate c in a wall at w gives 2w - c, so each image is a sign and an offset on each axis
+	const float RoomWidth = mMaxX - mMinX;
+	const float RoomDepth = mMaxZ - mMinZ;
+
+	// Sign/offset pairs for the x axis: direct, left wall, right wall, left then right, right then left
+	const float XSign[] = { 1.0f, -1.0f, -1.0f, 1.0f, 1.0f };
+	const float XOffset[] = { 0.0f, 2.0f * mMinX, 2.0f * mMaxX, 2.0f * RoomWidth, -2.0f * RoomWidth };
+	// Same for the z axis: direct, bottom wall, top wall, bottom then top, top then bottom
+	const float ZSign[] = { 1.0f, -1.0f, -1.0f, 1.0f, 1.0f };
+	const float ZOffset[] = { 0.0f, 2.0f * mMinZ, 2.0f * mMaxZ, 2.0f * RoomDepth, -2.0f * RoomDepth };
+	// The number of reflections for each entry above
+	const int AxisOrder[] = { 0, 1, 1, 2, 2 };
+	// Where the bottom wall is as seen from the listener for each z entry (the bottom wall is the last reflection except
+	// for bottom then top, where it is the first and is seen through the top wall)
+	const float DoorPlane[] = { 0.0f, mMinZ, 0.0f, 2.0f * mMaxZ - mMinZ, mMinZ };
+
+	// Combine the x and z entries, keeping only first and second order images
+	int Image = 0;
+	for (int X = 0; X < 5; X++)
+	{
+		for (int Z = 0; Z < 5; Z++)
+		{
+			int Order = AxisOrder[X] + AxisOrder[Z];
+			if ((Order == 0) || (Order > 2))
+			{
+				continue;
+			}
+			mImages[Image].SignX = XSign[X];
+			mImages[Image].OffsetX = XOffset[X];
+			mImages[Image].SignZ = ZSign[Z];
+			mImages[Image].OffsetZ = ZOffset[Z];
+			mImages[Image].Order = Order;
+			mImages[Image].UsesDoorWall = ((Z == 1) || (Z == 3) || (Z == 4));
+			mImages[Image].DoorPlaneZ = DoorPlane[Z];
+			Image++;
+		}
+	}
+}
+// End BuildImageTable function
+
+
+
+// Function:		UpdateFrame() - Update Frame function
+// Description:		Called once a frame from the Room. Starts taps whose onset delay has passed, and carries out the Apply3D calls
+//					for them and for taps that need updating, up to REFLECTION_TAP_BUDGET calls in total. Starts and updates over
+//					the budget are left until the next frame. While an emitter has taps waiting to start, its voice's clock is
+//					read with GetState once a frame.
+// In:				N/a
+// Out:				N/a
+void EarlyReflections::UpdateFrame()
+{
+	mTapsRenderedThisFrame = 0;
+	int Budget = REFLECTION_TAP_BUDGET;
+
+	for (auto Instance = mInstances.begin(); Instance != mInstances.end(); ++Instance)
+	{
+		(*Instance)->UpdateTaps(Budget);
+	}
+
+	// Move the first object to the back so that a different object gets the first share of the budget next frame
+	if (mInstances.size() > 1)
+	{
+		mInstances.splice(mInstances.end(), mInstances, mInstances.begin());
+	}
+}
+// End UpdateFrame function
+
+
+
+// Function:		SetSound(XASound) - Set Sound function
+// Description:		Sets the sound the reflections are made from. Taps are created from the sound's wave the first time that wave
+//					is used and kept for when the emitter changes back to it.
+// In:				XASound *Sound - the emitter's current sound
+// Out:				N/a
+void EarlyReflections::SetSound(XASound *Sound)
+{
+	// Stop the taps of the previous sound
+	Stop();
+
+	mSound = Sound;
+	mTaps = NULL;
+	if ((mSound == NULL) || (!mSound->IsValid()) || (mSound->GetWave() == NULL))
+	{
+		return;
+	}
+
+	// Find the taps for this wave, creating them the first time the wave is used
+	PCMWave *Wave = mSound->GetWave();
+	auto WaveTaps = mTapVoices.find(Wave);
+	if (WaveTaps == mTapVoices.end())
+	{
+		vector<TapVoice> NewTaps(MAX_REFLECTION_TAPS);
+		for (int i = 0; i < MAX_REFLECTION_TAPS; i++)
+		{
+			NewTaps[i].Sound = new XASound(Wave);
+			NewTaps[i].Pending = false;
+			NewTaps[i].Stale = false;
+			SecureZeroMemory(&NewTaps[i].Emitter, sizeof(X3DAUDIO_EMITTER));
+		}
+		WaveTaps = mTapVoices.insert(std::make_pair(Wave, NewTaps)).first;
+	}
+	mTaps = &WaveTaps->second;
+
+	// Select the reflections for the current positions
+	SelectReflectionSet();
+}
+// End SetSound function
+
+
+
+// Function:		Play() - Play function
+// Description:		Marks the start of the emitter's sound so each tap starts playing once the emitter voice has played
+//					its delay in samples
+// In:				N/a
+// Out:				N/a
+void EarlyReflections::Play()
+{
+	if ((mTaps == NULL) || (!mSound->IsPlaying()))
+	{
+		return;
+	}
+
+	// Store the voice's sample count now, so the onsets are counted from the start of this play
+	XAUDIO2_VOICE_STATE State;
+	mSound->GetSourceVoice()->GetState(&State);
+	mOnsetBaseline = State.SamplesPlayed;
+	mOnsetRunning = true;
+
+	// All selected taps wait for their onset
+	for (int i = 0; i < mCurrentSet.TapCount; i++)
+	{
+		(*mTaps)[i].Sound->Stop();
+		(*mTaps)[i].Pending = true;
+	}
+}
+// End Play function
+
+
+
+// Function:		Stop() - Stop function
+// Description:		Stops all of the taps and cancels any taps waiting to start
+// In:				N/a
+// Out:				N/a
+void EarlyReflections::Stop()
+{
+	mOnsetRunning = false;
+	if (mTaps == NULL)
+	{
+		return;
+	}
+	for (auto Tap = mTaps->begin(); Tap != mTaps->end(); ++Tap)
+	{
+		Tap->Sound->Stop();
+		Tap->Pending = false;
+	}
+}
+// End Stop function
+
+
+
+// Function:		Pause() - Pause function
+// Description:		Pauses the taps that are playing and cancels any taps waiting to start
+// In:				N/a
+// Out:				N/a
+void EarlyReflections::Pause()
+{
+	mOnsetRunning = false;
+	if (mTaps == NULL)
+	{
+		return;
+	}
+	for (auto Tap = mTaps->begin(); Tap != mTaps->end(); ++Tap)
+	{
+		Tap->Sound->Pause();
+		Tap->Pending = false;
+	}
+}
+// End Pause function
+
+
+
+// Function:		Update() - Update function
+// Description:		Called when the emitter or the listener moves or turns. If both are still in the same grid cells, the images of the
+//					current taps are translated with the source; otherwise the reflection set for the new cells is selected.
+//					Either way the taps are marked to have their 3D settings applied in UpdateFrame.
+// In:				N/a
+// Out:				N/a
+void EarlyReflections::Update()
+{
+	if (mTaps == NULL)
+	{
+		return;
+	}
+
+	// Only select a new set when a cell changes; otherwise the images just follow the source
+	if (GetCellKey() != mCurrentKey)
+	{
+		SelectReflectionSet();
+	}
+	else
+	{
+		PlaceTaps();
+	}
+}
+// End Update function
+
+
+
+// Function:		SetSendLevel(float) - Set Send Level function
+// Description:		Sets the level of the reflections relative to the taps' wall reflection gains. The emitter sets this from its
+//					reverb distance curve, so the reflections of a distant source are quieter relative to it.
+// In:				float SendLevel - the send level in dB (0 for the reflections at their full level)
+// Out:				N/a
+void EarlyReflections::SetSendLevel(float SendLevel)
+{
+	if (SendLevel == mSendLevel)
+	{
+		return;
+	}
+	mSendLevel = SendLevel;
+
+	// The new level is ramped to by the tap sounds when they commit their changes
+	if (mTaps == NULL)
+	{
+		return;
+	}
+	for (int i = 0; i < mCurrentSet.TapCount; i++)
+	{
+		(*mTaps)[i].Sound->SetVolume(mCurrentSet.Taps[i].Gain + mSendLevel);
+	}
+}
+// End SetSendLevel function
+
+
+
+// Function:		GetCellKey() - Get Cell Key function
+// Description:		Returns the cache key for the current listener cell, source cell and door state
+// In:				N/a
+// Out:				UINT64 - the cache key
+UINT64 EarlyReflections::GetCellKey() const
+{
+	// Cells are 1 unit squares; the room fits within 0-255 on each axis so each cell coordinate packs into a byte,
+	// and the door state has a bit of its own above them
+	UINT64 ListenerX = UINT64(max(0, min(255, int(floor(mListener->Position.x)))));
+	UINT64 ListenerZ = UINT64(max(0, min(255, int(floor(mListener->Position.z)))));
+	UINT64 SourceX = UINT64(max(0, min(255, int(floor(mParentEmitter->Position.x)))));
+	UINT64 SourceZ = UINT64(max(0, min(255, int(floor(mParentEmitter->Position.z)))));
+	UINT64 Door = mDoorOpen ? 1 : 0;
+	return ListenerX | (ListenerZ << 8) | (SourceX << 16) | (SourceZ << 24) | (Door << 32);
+}
+// End GetCellKey function
+
+
+
+// Function:		SourceInRoom() - Source In Room function
+// Description:		Returns true if the source is inside the room walls; sources outside the room have no reflections
+// In:				N/a
+// Out:				bool - true if inside the room
+bool EarlyReflections::SourceInRoom() const
+{
+	const X3DAUDIO_VECTOR &Position = mParentEmitter->Position;
+	return ((Position.x > mMinX) && (Position.x < mMaxX) && (Position.z > mMinZ) && (Position.z < mMaxZ));
+}
+// End SourceInRoom function
+
+
+
+// Function:		FindReflectionSet(ReflectionSet) - Find Reflection Set function
+// Description:		Finds the image positions for the current source position, the path length from each to the listener, and selects
+//					the MAX_REFLECTION_TAPS loudest images with their delays and gains.
+// In:				ReflectionSet *Set - the set to fill
+// Out:				N/a
+void EarlyReflections::FindReflectionSet(ReflectionSet *Set)
+{
+	Set->TapCount = 0;
+	if (!SourceInRoom())
+	{
+		return;
+	}
+
+	const X3DAUDIO_VECTOR &Source = mParentEmitter->Position;
+	const X3DAUDIO_VECTOR &ListenerPos = mListener->Position;
+	float Scaler = (mParentEmitter->CurveDistanceScaler > 0.0f) ? mParentEmitter->CurveDistanceScaler : 1.0f;
+
+	// Length of the direct path, which the tap delays are measured from
+	float DX = Source.x - ListenerPos.x;
+	float DY = Source.y - ListenerPos.y;
+	float DZ = Source.z - ListenerPos.z;
+	float DirectLength = sqrt((DX * DX) + (DY * DY) + (DZ * DZ));
+
+	// Level of each image; used to keep the loudest
+	float Levels[MAX_REFLECTION_TAPS];
+
+	for (int i = 0; i < IMAGE_SOURCE_COUNT; i++)
+	{
+		const ImageSource &Image = mImages[i];
+		float ImageX = (Image.SignX * Source.x) + Image.OffsetX;
+		float ImageZ = (Image.SignZ * Source.z) + Image.OffsetZ;
+
+		// Amplitude after the reflections; the door wall is checked where the path meets it
+		float Amplitude = 1.0f;
+		for (int Reflection = 0; Reflection < Image.Order; Reflection++)
+		{
+			Amplitude *= WALL_REFLECTION;
+		}
+		if (Image.UsesDoorWall)
+		{
+			// Find where the path from the listener to the image crosses the bottom wall, and fold it back into the room
+			float Along = (Image.DoorPlaneZ - ListenerPos.z) / (ImageZ - ListenerPos.z);
+			float HitX = ListenerPos.x + (Along * (ImageX - ListenerPos.x));
+			if (HitX < mMinX) { HitX = (2.0f * mMinX) - HitX; }
+			if (HitX > mMaxX) { HitX = (2.0f * mMaxX) - HitX; }
+
+			if ((HitX >= mDoorMinX) && (HitX <= mDoorMaxX))
+			{
+				// An open door lets the reflection out of the room; a closed door reflects less than a wall
+				if (mDoorOpen)
+				{
+					continue;
+				}
+				Amplitude *= DOOR_REFLECTION / WALL_REFLECTION;
+			}
+		}
+
+		// Level at the listener with the same inverse distance law that X3DAudio uses for the default volume curve
+		float IX = ImageX - ListenerPos.x;
+		float IZ = ImageZ - ListenerPos.z;
+		float PathLength = sqrt((IX * IX) + (DY * DY) + (IZ * IZ));
+		float Level = 20.0f * log10(Amplitude * Scaler / max(PathLength, Scaler));
+		if (Level < REFLECTION_FLOOR_DB)
+		{
+			continue;
+		}
+
+		// Insert the tap in order of level, keeping only the loudest MAX_REFLECTION_TAPS
+		int Position = Set->TapCount;
+		while ((Position > 0) && (Levels[Position - 1] < Level))
+		{
+			if (Position < MAX_REFLECTION_TAPS)
+			{
+				Set->Taps[Position] = Set->Taps[Position - 1];
+				Levels[Position] = Levels[Position - 1];
+			}
+			Position--;
+		}
+		if (Position < MAX_REFLECTION_TAPS)
+		{
+			Set->Taps[Position].ImageIndex = i;
+			Set->Taps[Position].Delay = (PathLength - DirectLength) / X3DAUDIO_SPEED_OF_SOUND;
+			Set->Taps[Position].Gain = 20.0f * log10(Amplitude);
+			Levels[Position] = Level;
+			if (Set->TapCount < MAX_REFLECTION_TAPS)
+			{
+				Set->TapCount++;
+			}
+		}
+	}
+}
+// End FindReflectionSet function
+
+
+
+// Function:		SelectReflectionSet() - Select Reflection Set function
+// Description:		Looks up the reflection set for the current cells in the cache, finding it if it isn't cached, and assigns
+//					the taps to the tap voices.
+// In:				N/a
+// Out:				N/a
+void EarlyReflections::SelectReflectionSet()
+{
+	mCurrentKey = GetCellKey();
+
+	auto Cached = mSetCache.find(mCurrentKey);
+	if (Cached != mSetCache.end())
+	{
+		mCurrentSet = Cached->second;
+		mCacheHits++;
+	}
+	else
+	{
+		// Keep the cache bounded; the whole cache is cleared as the sets are cheap to find again
+		if (mSetCache.size() >= REFLECTION_CACHE_LIMIT)
+		{
+			mSetCache.clear();
+		}
+		FindReflectionSet(&mCurrentSet);
+		mSetCache[mCurrentKey] = mCurrentSet;
+		mCacheMisses++;
+	}
+
+	// Stop the voices that are no longer used and set the gain of the ones that are
+	for (int i = 0; i < MAX_REFLECTION_TAPS; i++)
+	{
+		TapVoice &Voice = (*mTaps)[i];
+		if (i >= mCurrentSet.TapCount)
+		{
+			Voice.Sound->Stop();
+			Voice.Pending = false;
+			continue;
+		}
+		Voice.Sound->SetVolume(mCurrentSet.Taps[i].Gain + mSendLevel);
+
+		// A tap that joins while the emitter is playing waits for its onset like the others; StartTap aligns it to the direct sound
+		if (mOnsetRunning || mSound->IsPlaying())
+		{
+			if (!Voice.Sound->IsPlaying())
+			{
+				Voice.Pending = true;
+				mOnsetRunning = true;
+			}
+		}
+	}
+	PlaceTaps();
+}
+// End SelectReflectionSet function
+
+
+
+// Function:		PlaceTaps() - Place Taps function
+// Description:		Sets the tap emitter positions from the images of the current source position and marks them as stale
+// In:				N/a
+// Out:				N/a
+void EarlyReflections::PlaceTaps()
+{
+	const X3DAUDIO_VECTOR &Source = mParentEmitter->Position;
+	for (int i = 0; i < mCurrentSet.TapCount; i++)
+	{
+		TapVoice &Voice = (*mTaps)[i];
+		const ImageSource &Image = mImages[mCurrentSet.Taps[i].ImageIndex];
+
+		// Each tap uses the emitter's settings, positioned at its image; the cone is not mirrored so is not used
+		Voice.Emitter = *mParentEmitter;
+		Voice.Emitter.pCone = NULL;
+		Voice.Emitter.Position.x = (Image.SignX * Source.x) + Image.OffsetX;
+		Voice.Emitter.Position.z = (Image.SignZ * Source.z) + Image.OffsetZ;
+		Voice.Stale = true;
+	}
+}
+// End PlaceTaps function
+
+
+
+// Function:		StartTap(TapVoice, ReflectionTap, UINT64) - Start Tap function
+// Description:		Starts a tap voice at the point in the wave the direct sound had reached its delay ago, wrapping for looped sounds
+// In:				TapVoice &Voice - the tap to start, const ReflectionTap &Tap - its delay/gain, UINT64 PlayedSamples - the number
+//					of samples the emitter voice has played since it started
+// Out:				bool - true if the tap was started, false if its onset hasn't been reached or a one-shot sound has already ended
+bool EarlyReflections::StartTap(TapVoice &Voice, const ReflectionTap &Tap, UINT64 PlayedSamples)
+{
+	PCMWave *Wave = mSound->GetWave();
+	UINT64 DelaySamples = UINT64(Tap.Delay * Wave->GetWaveFormat().nSamplesPerSec);
+	if (PlayedSamples < DelaySamples)
+	{
+		return false;
+	}
+
+	// Where in the wave the tap should be now, in frames: the direct sound plays its region from its start, and a looped sound
+	// then repeats its loop, which is the whole region unless the wave or the sound marks a loop after an intro
+	const XAUDIO2_BUFFER &Source = mSound->GetBuffer();
+	UINT64 Frames = Wave->GetDataSize() / Wave->GetWaveFormat().nBlockAlign;
+	UINT64 PlayEnd = (Source.PlayLength > 0) ? (UINT64(Source.PlayBegin) + Source.PlayLength) : Frames;
+	UINT64 Position = Source.PlayBegin + (PlayedSamples - DelaySamples);
+	bool Looped = mSound->IsLooped();
+	UINT64 LoopBegin = Looped ? Source.LoopBegin : 0;
+	UINT64 LoopEnd = (Looped && (Source.LoopLength > 0)) ? (LoopBegin + Source.LoopLength) : PlayEnd;
+	if (Looped && (Position >= LoopEnd))
+	{
+		Position = (LoopEnd > LoopBegin) ? (LoopBegin + ((Position - LoopBegin) % (LoopEnd - LoopBegin))) : Source.PlayBegin;
+	}
+	else if ((!Looped) && (Position >= PlayEnd))
+	{
+		// The reflection of a one-shot sound that has already finished; nothing to play
+		Voice.Pending = false;
+		return false;
+	}
+
+	// Start the tap from the position with the same looping as the emitter's sound. XAudio2 only takes a play length of 0
+	// for the whole buffer, so the tap plays to the end of the region, with the loop given in full within it
+	Voice.Sound->Stop();
+	XAUDIO2_BUFFER &Buffer = Voice.Sound->GetBuffer();
+	Buffer.PlayBegin = UINT32(Position);
+	Buffer.PlayLength = UINT32(PlayEnd - Position);
+	Buffer.LoopCount = Looped ? XAUDIO2_LOOP_INFINITE : 0;
+	Buffer.LoopBegin = UINT32(LoopBegin);
+	Buffer.LoopLength = Looped ? UINT32(LoopEnd - LoopBegin) : 0;
+	Voice.Sound->Play();
+	Buffer.PlayBegin = 0;
+	Buffer.PlayLength = 0;
+	Voice.Pending = false;
+
+	// The tap isn't playing if the voice refused its buffer
+	return Voice.Sound->IsPlaying();
+}
+// End StartTap function
+
+
+
+// Function:		UpdateTaps(int) - Update Taps function
+// Description:		Starts any taps whose delay has passed and applies the 3D settings to stale taps, within the budget
+// In:				int &Budget - the number of Apply3D calls left this frame; reduced by the calls made
+// Out:				N/a
+void EarlyReflections::UpdateTaps(int &Budget)
+{
+	if (mTaps == NULL)
+	{
+		return;
+	}
+
+	// Start the taps whose onset has been reached on the emitter voice's clock. Reading the clock takes a GetState call on the
+	// emitter voice every frame while taps are waiting; it is skipped once the budget is spent
+	if (mOnsetRunning && (Budget <= 0))
+	{
+		for (int i = 0; i < mCurrentSet.TapCount; i++)
+		{
+			if ((*mTaps)[i].Pending)
+			{
+				mTapsDeferred++;
+			}
+		}
+	}
+	else if (mOnsetRunning)
+	{
+		XAUDIO2_VOICE_STATE State;
+		mSound->GetSourceVoice()->GetState(&State);
+		// If the count was reset when the voice started, the baseline is from before the start
+		if (State.SamplesPlayed < mOnsetBaseline)
+		{
+			mOnsetBaseline = 0;
+		}
+		UINT64 Played = State.SamplesPlayed - mOnsetBaseline;
+
+		bool StillPending = false;
+		for (int i = 0; i < mCurrentSet.TapCount; i++)
+		{
+			TapVoice &Voice = (*mTaps)[i];
+			if (!Voice.Pending)
+			{
+				continue;
+			}
+			// A tap must have its 3D settings before it is heard, so starting it applies them and counts against the budget.
+			// A tap over the budget starts on a later frame, from the point the direct sound has reached by then
+			if (Budget <= 0)
+			{
+				mTapsDeferred++;
+				StillPending = true;
+				continue;
+			}
+			if (StartTap(Voice, mCurrentSet.Taps[i], Played))
+			{
+				Voice.Sound->Apply3D(&Voice.Emitter, mListener, X3DAUDIO_CALCULATE_MATRIX);
+				Voice.Stale = false;
+				Budget--;
+				mTapsRenderedThisFrame++;
+				mTotalTapsRendered++;
+			}
+			StillPending = StillPending || Voice.Pending;
+		}
+		mOnsetRunning = StillPending;
+	}
+
+	// Apply the 3D settings to the stale taps that are playing, within the budget
+	for (int i = 0; i < mCurrentSet.TapCount; i++)
+	{
+		TapVoice &Voice = (*mTaps)[i];
+		if ((!Voice.Stale) || (!Voice.Sound->IsPlaying()))
+		{
+			continue;
+		}
+		if (Budget <= 0)
+		{
+			mTapsDeferred++;
+			continue;
+		}
+		Voice.Sound->Apply3D(&Voice.Emitter, mListener, X3DAUDIO_CALCULATE_MATRIX);
+		Voice.Stale = false;
+		Budget--;
+		mTapsRenderedThisFrame++;
+		mTotalTapsRendered++;
+	}
+}
+// End UpdateTaps function
+
+// end of code.
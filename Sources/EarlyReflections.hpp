@@ -0,0 +1,293 @@
+/*
+	file:	EarlyReflections.hpp
+	Version:	1.2
+	Date:		18th October 2026
+	Author:		agent
+
+	Exposes:	EarlyReflections
+	Requires:	X3DAudio, XASound, XACore, PCMWave
+
+	Description:
+	This class renders the early reflections of an emitter's sound using an image-source model of the room. The room is an
+	axis-aligned box on the X-Z plane, so each wall reflection of a source can be modelled as a mirror image of the source behind
+	that wall. First order images (one wall) and second order images (two walls) are found for the emitter's position, and the
+	strongest of these are rendered as 'taps'. A tap is an extra source voice playing the same wave data as the emitter's sound,
+	started once the emitter's voice has played the extra path length delay in samples (so the tap stays sample aligned with
+	the direct sound, even if it joins late), attenuated by the wall reflection coefficients, and spatialised from the
+	position of its image using X3DAudio.
+
+	The object exposes behaviour to:
+	*	Set the room geometry (wall planes and the door span) that is shared by all reflection objects
+	*	Follow the emitter's sound as it is played, paused, stopped or changed
+	*	Follow the source and listener as they move; within a grid cell the images are translated with the source rather than
+		the reflection set being rebuilt
+	*	Update the taps each frame within a shared per-frame budget of Apply3D calls
+	*	Scale the level of all the taps by a send level, set from the emitter's reverb distance curve
+
+	The reflection set (which images are audible, their delay and gain) is cached per listener grid cell and source grid cell,
+	so moving around the room only recalculates the set the first time a cell pair is visited.
+	The number of taps rendered, deferred by the budget, and the cache hits/misses are counted so the cost can be inspected.
+
+	An EarlyReflections object is owned by an Emitter when reflections are enabled for that emitter.
+*/
+
+// Define the class
+#ifndef EARLY_REFLECTIONS_H
+#define EARLY_REFLECTIONS_H
+
+// System includes
+#include <Windows.h>
+#include <X3DAudio.h>
+#include <list>
+#include <map>
+#include <vector>
+using std::list;
+using std::map;
+using std::vector;
+
+// Framework includes.
+#include "XASound.hpp"
+#include "PCMWave.hpp"
+using AllanMilne::Audio::XASound;
+using AllanMilne::Audio::PCMWave;
+
+// The number of image sources found for a source in a rectangular room (4 first order, 8 second order)
+#define IMAGE_SOURCE_COUNT 12
+
+// The maximum number of taps (extra voices) rendered for each emitter
+#define MAX_REFLECTION_TAPS 4
+
+// The maximum number of tap Apply3D calls carried out across all emitters each frame
+#define REFLECTION_TAP_BUDGET 16
+
+// Amplitude reflection coefficients for the walls and the closed door
+#define WALL_REFLECTION 0.6f
+#define DOOR_REFLECTION 0.4f
+
+// Taps quieter than this (in dB) are not rendered
+#define REFLECTION_FLOOR_DB -30.0f
+
+// The maximum number of cached reflection sets kept for each emitter before the cache is cleared
+#define REFLECTION_CACHE_LIMIT 128
+
+// The EarlyReflections class
+class EarlyReflections
+{
+
+// Public Member Functions and Variables
+public:
+	// Function:		EarlyReflections(X3DAUDIO_EMITTER, X3DAUDIO_LISTENER) - Early Reflections constructor
+	// Description:		Stores the emitter and listener structs that the reflections are based on and registers the object so
+	//					that it is updated in UpdateFrame. No taps are created until SetSound is called.
+	// In:				const X3DAUDIO_EMITTER *ParentEmitter - the emitter struct of the emitter that owns this object
+	//					X3DAUDIO_LISTENER *Listener - pointer to the Player's listener struct
+	// Out:				N/a
+	EarlyReflections(const X3DAUDIO_EMITTER *ParentEmitter, X3DAUDIO_LISTENER *Listener);
+
+	// Function:		~EarlyReflections() - Early Reflections destructor
+	// Description:		Stops and deletes all of the tap sounds and removes the object from the update list
+	// In:				N/a
+	// Out:				N/a
+	~EarlyReflections();
+
+	// Function:		SetRoomBounds(float, float, float, float) - Set Room Bounds function
+	// Description:		Sets the positions of the four wall planes used to find the image sources. Shared by all reflection objects.
+	// In:				float MinX, float MaxX - the x positions of the left and right walls
+	//					float MinZ, float MaxZ - the z positions of the bottom (door) and top walls
+	// Out:				N/a
+	static void SetRoomBounds(float MinX, float MaxX, float MinZ, float MaxZ);
+
+	// Function:		SetDoor(float, float, bool) - Set Door function
+	// Description:		Sets the span of the door in the bottom wall and if it is open. An open door does not reflect, so reflections
+	//					from the door span are dropped; a closed door reflects less than the walls.
+	// In:				float DoorX - the x position of the centre of the door, float DoorWidth - the width of the door
+	//					bool DoorOpen - true if the door is open
+	// Out:				N/a
+	static void SetDoor(float DoorX, float DoorWidth, bool DoorOpen);
+
+	// Function:		UpdateFrame() - Update Frame function
+	// Description:		Called once a frame from the Room. Starts taps whose onset delay has passed, and carries out the Apply3D calls
+	//					for them and for taps that need updating, up to REFLECTION_TAP_BUDGET calls in total. Starts and updates over
+	//					the budget are left until the next frame. While an emitter has taps waiting to start, its voice's clock is
+	//					read with GetState once a frame.
+	// In:				N/a
+	// Out:				N/a
+	static void UpdateFrame();
+
+	// Function:		SetSound(XASound) - Set Sound function
+	// Description:		Sets the sound the reflections are made from. Taps are created from the sound's wave the first time that wave
+	//					is used and kept for when the emitter changes back to it.
+	// In:				XASound *Sound - the emitter's current sound
+	// Out:				N/a
+	void SetSound(XASound *Sound);
+
+	// Function:		Play() - Play function
+	// Description:		Marks the start of the emitter's sound so each tap starts playing once the emitter voice has played
+	//					its delay in samples
+	// In:				N/a
+	// Out:				N/a
+	void Play();
+
+	// Function:		Stop() - Stop function
+	// Description:		Stops all of the taps and cancels any taps waiting to start
+	// In:				N/a
+	// Out:				N/a
+	void Stop();
+
+	// Function:		Pause() - Pause function
+	// Description:		Pauses the taps that are playing and cancels any taps waiting to start
+	// In:				N/a
+	// Out:				N/a
+	void Pause();
+
+	// Function:		Update() - Update function
+	// Description:		Called when the emitter or the listener moves or turns. If both are still in the same grid cells, the images of the
+	//					current taps are translated with the source; otherwise the reflection set for the new cells is selected.
+	//					Either way the taps are marked to have their 3D settings applied in UpdateFrame.
+	// In:				N/a
+	// Out:				N/a
+	void Update();
+
+	// Function:		SetSendLevel(float) - Set Send Level function
+	// Description:		Sets the level of the reflections relative to the taps' wall reflection gains. The emitter sets this from its
+	//					reverb distance curve, so the reflections of a distant source are quieter relative to it.
+	// In:				float SendLevel - the send level in dB (0 for the reflections at their full level)
+	// Out:				N/a
+	void SetSendLevel(float SendLevel);
+
+	// Functions to access the instrumentation counters
+	static inline int GetTapsRenderedThisFrame() { return mTapsRenderedThisFrame; }
+	static inline unsigned long GetTotalTapsRendered() { return mTotalTapsRendered; }
+	static inline unsigned long GetTapsDeferred() { return mTapsDeferred; }
+	static inline unsigned long GetCacheHits() { return mCacheHits; }
+	static inline unsigned long GetCacheMisses() { return mCacheMisses; }
+
+// Private Member Functions and Variables
+private:
+	// An image of the source reflected in one or two walls; Position = Sign * SourcePosition + Offset on each axis
+	struct ImageSource
+	{
+		float SignX, SignZ;
+		float OffsetX, OffsetZ;
+		int Order;				// Number of walls the path reflects from
+		bool UsesDoorWall;		// True if the path reflects from the bottom wall that holds the door
+		float DoorPlaneZ;		// The z of the bottom wall as seen from the listener (unfolded), to find where the path meets it
+	};
+
+	// A tap selected from the images, with its delay and gain
+	struct ReflectionTap
+	{
+		int ImageIndex;			// Index into the image table
+		float Delay;			// Delay after the direct sound in seconds
+		float Gain;				// Gain in dB
+	};
+
+	// The set of taps selected for a listener cell/source cell pair
+	struct ReflectionSet
+	{
+		ReflectionTap Taps[MAX_REFLECTION_TAPS];
+		int TapCount;
+	};
+
+	// A rendered tap voice and its emitter struct
+	struct TapVoice
+	{
+		XASound *Sound;
+		X3DAUDIO_EMITTER Emitter;
+		bool Pending;			// Waiting for its onset delay before it starts playing
+		bool Stale;				// Needs an Apply3D call
+	};
+
+	// Function:		BuildImageTable() - Build Image Table function
+	// Description:		Fills the static image table with the sign/offset of the 12 images for the current room bounds
+	// In:				N/a
+	// Out:				N/a
+	static void BuildImageTable();
+
+	// Function:		FindReflectionSet(ReflectionSet) - Find Reflection Set function
+	// Description:		Finds the image positions for the current source position, the path length from each to the listener, and selects
+	//					the MAX_REFLECTION_TAPS loudest images with their delays and gains.
+	// In:				ReflectionSet *Set - the set to fill
+	// Out:				N/a
+	void FindReflectionSet(ReflectionSet *Set);
+
+	// Function:		SelectReflectionSet() - Select Reflection Set function
+	// Description:		Looks up the reflection set for the current cells in the cache, finding it if it isn't cached, and assigns
+	//					the taps to the tap voices.
+	// In:				N/a
+	// Out:				N/a
+	void SelectReflectionSet();
+
+	// Function:		PlaceTaps() - Place Taps function
+	// Description:		Sets the tap emitter positions from the images of the current source position and marks them as stale
+	// In:				N/a
+	// Out:				N/a
+	void PlaceTaps();
+
+	// Function:		GetCellKey() - Get Cell Key function
+	// Description:		Returns the cache key for the current listener cell, source cell and door state
+	// In:				N/a
+	// Out:				UINT64 - the cache key
+	UINT64 GetCellKey() const;
+
+	// Function:		SourceInRoom() - Source In Room function
+	// Description:		Returns true if the source is inside the room walls; sources outside the room have no reflections
+	// In:				N/a
+	// Out:				bool - true if inside the room
+	bool SourceInRoom() const;
+
+	// Function:		StartTap(TapVoice, ReflectionTap, UINT64) - Start Tap function
+	// Description:		Starts a tap voice at the point in the wave the direct sound had reached its delay ago, wrapping for looped sounds
+	// In:				TapVoice &Voice - the tap to start, const ReflectionTap &Tap - its delay/gain, UINT64 PlayedSamples - the number
+	//					of samples the emitter voice has played since it started
+	// Out:				bool - true if the tap was started, false if its onset hasn't been reached or a one-shot sound has already ended
+	bool StartTap(TapVoice &Voice, const ReflectionTap &Tap, UINT64 PlayedSamples);
+
+	// Function:		UpdateTaps(int) - Update Taps function
+	// Description:		Starts any taps whose delay has passed and applies the 3D settings to stale taps, within the budget
+	// In:				int &Budget - the number of Apply3D calls left this frame; reduced by the calls made
+	// Out:				N/a
+	void UpdateTaps(int &Budget);
+
+	// The emitter and listener the reflections are based on
+	const X3DAUDIO_EMITTER *mParentEmitter;
+	X3DAUDIO_LISTENER *mListener;
+
+	// The emitter's current sound and the tap voices for its wave
+	XASound *mSound;
+	vector<TapVoice> *mTaps;
+
+	// Tap voices for each wave that has been used by this emitter
+	map<PCMWave*, vector<TapVoice> > mTapVoices;
+
+	// The current reflection set and the cache of sets found so far
+	ReflectionSet mCurrentSet;
+	map<UINT64, ReflectionSet> mSetCache;
+	UINT64 mCurrentKey;
+
+	// The send level in dB added to the gain of each tap
+	float mSendLevel;
+
+	// The emitter voice's SamplesPlayed count when the sound started, used to time the tap onsets on the audio clock
+	UINT64 mOnsetBaseline;
+	bool mOnsetRunning;
+
+	// The room geometry shared by all reflection objects
+	static float mMinX, mMaxX, mMinZ, mMaxZ;
+	static float mDoorMinX, mDoorMaxX;
+	static bool mDoorOpen;
+	static ImageSource mImages[IMAGE_SOURCE_COUNT];
+
+	// All reflection objects, so they can be updated once a frame
+	static list<EarlyReflections*> mInstances;
+
+	// Instrumentation counters
+	static int mTapsRenderedThisFrame;
+	static unsigned long mTotalTapsRendered;
+	static unsigned long mTapsDeferred;
+	static unsigned long mCacheHits;
+	static unsigned long mCacheMisses;
+};
+// End of EarlyReflections class
+
+#endif
@@ -6,7 +6,7 @@
 	Author:		Cassie Bennett
 
 	Exposes:	Implementation of the Emitter class.
-	Requires:	X3DAudio, XASound, XACore, StuVector3
+	Requires:	X3DAudio, XASound, XACore, StuVector3, GameTimer, TraceLog
 
 	Description:
 	Has the functionality for the Emitter object to initialise and set the new positions and sounds of emitter objects throughout
@@ -17,6 +17,9 @@
 	The functions for the Emitters are called through their emitter objects. 
 */
 
+// Framework includes
+#include "TraceLog.hpp"
+
 // Application includes
 #include "Emitter.hpp"
 
@@ -41,6 +44,23 @@ Emitter::Emitter(XASound *EmitterSound, X3DAUDIO_VECTOR EmitterPosition, X3DAUDI
 	// Store the start position of the emitter
 	mStartPosition = EmitterPosition;
 
+	// Reflections are off until EnableReflections is called
+	mReflections = NULL;
+
+	// The default distance law is used until SetEmitterType is called
+	mCurveSet = NULL;
+
+	// Doppler is off until EnableDoppler is called
+	mDopplerOn = false;
+	mDopplerScaler = 0.0f;
+	mDopplerRatio = 1.0f;
+	mMotionInterval = 0.0f;
+	mMotionValid = false;
+	mMotionTimer = new GameTimer();
+
+	// The settings are calculated every update until EnablePanningTable is called
+	mPanning = NULL;
+
 	// Cannot proceed if emitter sound is invalid
 	if (!mSound->IsValid()) 
 	{
@@ -56,10 +76,8 @@ Emitter::Emitter(XASound *EmitterSound, X3DAUDIO_VECTOR EmitterPosition, X3DAUDI
 	// Initialise emitter by setting all variables of the struct to 0
 	SecureZeroMemory (&mEmitter, sizeof(X3DAUDIO_EMITTER));
 
-	// Store the details of the source voice
-	XAUDIO2_VOICE_DETAILS details;
-	mSound->GetSourceVoice()->GetVoiceDetails(&details);
-	mEmitter.ChannelCount = details.InputChannels;
+	// Store the channel count of the sound, which the sound keeps from its source voice
+	mEmitter.ChannelCount = mSound->GetChannelCount();
 	mEmitter.CurveDistanceScaler = 1.0f;
 	mEmitter.Position = EmitterPosition;	// Store the position of the emitter in the struct
 
@@ -92,6 +110,23 @@ Emitter::Emitter(XASound *EmitterSound, X3DAUDIO_VECTOR EmitterPosition, X3DAUDI
 	// Store the start position of the emitter
 	mStartPosition = EmitterPosition;
 
+	// Reflections are off until EnableReflections is called
+	mReflections = NULL;
+
+	// The default distance law is used until SetEmitterType is called
+	mCurveSet = NULL;
+
+	// Doppler is off until EnableDoppler is called
+	mDopplerOn = false;
+	mDopplerScaler = 0.0f;
+	mDopplerRatio = 1.0f;
+	mMotionInterval = 0.0f;
+	mMotionValid = false;
+	mMotionTimer = new GameTimer();
+
+	// The settings are calculated every update until EnablePanningTable is called
+	mPanning = NULL;
+
 	// Cannot proceed if emitter sound is invalid
 	if (!mSound->IsValid()) 
 	{
@@ -114,10 +149,8 @@ Emitter::Emitter(XASound *EmitterSound, X3DAUDIO_VECTOR EmitterPosition, X3DAUDI
 	// Initialise emitter by setting all variables of the struct to 0
 	SecureZeroMemory (&mEmitter, sizeof(X3DAUDIO_EMITTER));
 
-	// Store the details of the source voice
-	XAUDIO2_VOICE_DETAILS details;
-	mSound->GetSourceVoice()->GetVoiceDetails(&details);
-	mEmitter.ChannelCount = details.InputChannels;
+	// Store the channel count of the sound, which the sound keeps from its source voice
+	mEmitter.ChannelCount = mSound->GetChannelCount();
 	mEmitter.CurveDistanceScaler = 1.0f;
 	mEmitter.Position = EmitterPosition;		// Store the position of the emitter in the struct
 
@@ -130,6 +163,206 @@ Emitter::Emitter(XASound *EmitterSound, X3DAUDIO_VECTOR EmitterPosition, X3DAUDI
 // End of emitter constructor
 
 
+
+// Function:		~Emitter() - Emitter Destructor
+// Description:		Deletes the early reflections object if reflections were enabled, and the motion timer
+// In:				N/a
+// Out:				N/a
+Emitter::~Emitter()
+{
+	delete mReflections;
+	delete mMotionTimer;
+	delete mPanning;
+}
+// End of Emitter destructor
+
+
+
+// Function:		EnableReflections() - Enable Reflections function
+// Description:		Creates an EarlyReflections object for the emitter so that reflections of its sound from the room walls are
+//					rendered. The reflections follow the emitter's sound, position and play state from then on.
+// In:				N/a
+// Out:				N/a
+void Emitter::EnableReflections()
+{
+	// Cannot have reflections without a valid sound, or if they are already enabled
+	if ((!mSound->IsValid()) || (mReflections != NULL))
+	{
+		return;
+	}
+	mReflections = new EarlyReflections(&mEmitter, mListener);
+	mReflections->SetSound(mSound);
+}
+// End EnableReflections function
+
+
+
+// Function:		SetEmitterType(EmitterType) - Set Emitter Type function
+// Description:		Selects the distance curves for the type of emitter and sets them in the emitter struct. The low pass filter
+//					curve is only applied if the emitter's sound was created with filtering enabled.
+// In:				EmitterType Type - the type of the emitter
+// Out:				N/a
+void Emitter::SetEmitterType(EmitterType Type)
+{
+	mCurveSet = DistanceCurves::GetCurveSet(Type);
+	ApplyDistanceCurves();
+	ForgetSettings();
+}
+// End SetEmitterType function
+
+
+
+// Function:		ApplyDistanceCurves() - Apply Distance Curves function
+// Description:		Sets the curve distance scaler and the curves of the emitter's curve set in the emitter struct; used when the
+//					type is set and after the struct is re-initialised for a new sound
+// In:				N/a
+// Out:				N/a
+void Emitter::ApplyDistanceCurves()
+{
+	if (mCurveSet == NULL)
+	{
+		return;
+	}
+	mEmitter.CurveDistanceScaler = mCurveSet->DistanceScaler;
+	mEmitter.pVolumeCurve = mCurveSet->Volume.GetCurve();
+	mEmitter.pLFECurve = mCurveSet->LFE.GetCurve();
+	mEmitter.pLPFDirectCurve = mCurveSet->LPFDirect.GetCurve();
+	mEmitter.pReverbCurve = mCurveSet->Reverb.GetCurve();
+}
+// End ApplyDistanceCurves function
+
+
+
+// Function:		EnableDoppler(float) - Enable Doppler function
+// Description:		Turns on doppler for the emitter. From then on UpdateEmitter measures the emitter's velocity and applies the
+//					smoothed doppler ratio to its sound.
+// In:				float DopplerScaler - the X3DAudio doppler scaler; the room is small and sources move slowly, so values above 1
+//					exaggerate the shift so that it can be heard
+// Out:				N/a
+void Emitter::EnableDoppler(float DopplerScaler)
+{
+	if (!mSound->IsValid())
+	{
+		return;
+	}
+	mDopplerOn = true;
+	mDopplerScaler = DopplerScaler;
+	mEmitter.DopplerScaler = mDopplerScaler;
+	ResetMotion();
+}
+// End EnableDoppler function
+
+
+
+// Function:		UpdateVelocity() - Update Velocity function
+// Description:		Measures the emitter's velocity from its change in position since the last measurement, using the motion timer
+//					for the time passed, and sets it in the emitter struct
+// In:				N/a
+// Out:				float - the time in seconds the velocity was measured over, 0 if it was not measured this update
+float Emitter::UpdateVelocity()
+{
+	mMotionTimer->Tick();
+	if (!mMotionValid)
+	{
+		mLastPosition = mEmitter.Position;
+		mMotionInterval = 0.0f;
+		mMotionValid = true;
+		return 0.0f;
+	}
+	mMotionInterval += mMotionTimer->GetDeltaTime();
+
+	// Too short an interval gives a noisy velocity from the small change in position, so wait for more time to pass
+	if (mMotionInterval < VELOCITY_MIN_INTERVAL)
+	{
+		return 0.0f;
+	}
+
+	float Interval = mMotionInterval;
+	if (Interval > VELOCITY_MAX_INTERVAL)
+	{
+		// The emitter hasn't been updated for a while; start measuring again from here rather than averaging over the gap
+		mEmitter.Velocity.x = 0.0f;
+		mEmitter.Velocity.y = 0.0f;
+		mEmitter.Velocity.z = 0.0f;
+	}
+	else
+	{
+		v3f Velocity = { (mEmitter.Position.x - mLastPosition.x) / Interval,
+						 (mEmitter.Position.y - mLastPosition.y) / Interval,
+						 (mEmitter.Position.z - mLastPosition.z) / Interval };
+
+		// A jump to a new position would be measured as a very high speed; limit it
+		float Speed = Velocity.Magnitude();
+		if (Speed > MAX_EMITTER_SPEED)
+		{
+			Velocity *= (MAX_EMITTER_SPEED / Speed);
+		}
+		mEmitter.Velocity.x = Velocity.x;
+		mEmitter.Velocity.y = Velocity.y;
+		mEmitter.Velocity.z = Velocity.z;
+	}
+
+	mLastPosition = mEmitter.Position;
+	mMotionInterval = 0.0f;
+	return Interval;
+}
+// End UpdateVelocity function
+
+
+
+// Function:		UpdateDoppler(float) - Update Doppler function
+// Description:		Calculates the doppler ratio for the emitter's velocity and the listener's, moves the smoothed ratio towards it
+//					over the time passed, clamps it and sets it on the sound
+// In:				float Interval - the time in seconds since the ratio was last smoothed
+// Out:				N/a
+void Emitter::UpdateDoppler(float Interval)
+{
+	IXACore *Core = XACore::GetInstance();
+	if (Core == NULL)
+	{
+		return;
+	}
+
+	// Only the doppler factor is calculated, so no matrix is needed
+	X3DAUDIO_DSP_SETTINGS DSPSettings;
+	SecureZeroMemory(&DSPSettings, sizeof(X3DAUDIO_DSP_SETTINGS));
+	DSPSettings.SrcChannelCount = mEmitter.ChannelCount;
+	DSPSettings.DstChannelCount = Core->GetChannelCount();
+	Core->Calculate3D(&mEmitter, mListener, X3DAUDIO_CALCULATE_DOPPLER, DSPSettings);
+
+	// Smooth the ratio with a time constant so that it changes at the same rate whatever the update rate is
+	float Smoothing = 1.0f - exp(-Interval / DOPPLER_SMOOTHING_TIME);
+	mDopplerRatio += (DSPSettings.DopplerFactor - mDopplerRatio) * Smoothing;
+	if (mDopplerRatio < DOPPLER_MIN_RATIO)
+	{
+		mDopplerRatio = DOPPLER_MIN_RATIO;
+	}
+	else if (mDopplerRatio > DOPPLER_MAX_RATIO)
+	{
+		mDopplerRatio = DOPPLER_MAX_RATIO;
+	}
+	mSound->SetDopplerRatio(mDopplerRatio);
+}
+// End UpdateDoppler function
+
+
+
+// Function:		ResetMotion() - Reset Motion function
+// Description:		Zeroes the velocity, sets the sound's doppler ratio back to 1 and restarts the velocity measurement from the
+//					current position; used when the emitter's sound changes
+// In:				N/a
+// Out:				N/a
+void Emitter::ResetMotion()
+{
+	mEmitter.Velocity.x = 0.0f;
+	mEmitter.Velocity.y = 0.0f;
+	mEmitter.Velocity.z = 0.0f;
+	mDopplerRatio = 1.0f;
+	mSound->SetDopplerRatio(mDopplerRatio);
+	mMotionValid = false;
+}
+// End ResetMotion function
+
 // Function:		CreateEmitterCone() - Create Emitter Cone function
 // Description:		Creates an emitter cone for emitters who have a cone object. It sets the cone orientation based on the sound position
 //					and the orientation position, normalises and sets this to the emitter sound's orientation. The Cone struct is initialised 
@@ -156,11 +389,46 @@ void Emitter::CreateEmitterCone()
 	mCone.OuterAngle = mCone.InnerAngle + 0.2f;
 	mCone.OuterVolume = 0.5f;
 	mEmitter.pCone = &mCone;
+	ForgetSettings();
 }
 //End of CreateEmitterCone function
 
 
 
+// Function:		EnablePanningTable() - Enable Panning Table function
+// Description:		Creates a PanningTable for the emitter. While the emitter stays still and the listener stands still facing one
+//					of the orientations, UpdateEmitter copies the settings kept for that pose to the sound instead of calculating
+//					them; poses part way through a move or turn are calculated as before.
+// In:				N/a
+// Out:				N/a
+void Emitter::EnablePanningTable()
+{
+	if (mPanning != NULL)
+	{
+		return;
+	}
+	mPanning = new PanningTable();
+}
+// End EnablePanningTable function
+
+
+
+// Function:		ForgetSettings() - Forget Settings function
+// Description:		Drops the 3D settings kept for the emitter in the panning table; used when a change to the emitter, e.g. its
+//					curves or cone, means they no longer match what UpdateEmitter would calculate
+// In:				N/a
+// Out:				N/a
+void Emitter::ForgetSettings()
+{
+	if (mPanning != NULL)
+	{
+		mPanning->Clear();
+	}
+}
+// End ForgetSettings function
+
+
+
 // Function:		UpdateEmitter() - Update Emitter function
 // Description:		Calculates and applys 3D audio DSP settings to the emitters sound based on the Listener's position and orientation
 //					Therefore updates how the emitters sound settings should be 
@@ -168,12 +436,55 @@ void Emitter::CreateEmitterCone()
 // Out:				N/a
 void Emitter::UpdateEmitter()
 {
+	TRACE_SCOPE("Emitter::UpdateEmitter", "audio");
+
 	// If the Emitter sound is currently playing, calculate and apply the 3D settings to the sound based on the position/orientation
-	// of the player using the Apply3D function in the XACore class and passing in the emitters sound, the address of the emitter, the 
-	// listener struct and the calculation matrix.
+	// of the player using the sound's Apply3D function and passing in the address of the emitter, the listener struct and the
+	// calculation matrix. The new matrix is ramped to over the sound's RampTime, a few ticks' commits, so turns don't click.
+	// If the emitter has a low pass filter curve and its sound can be filtered, the filter for the distance is calculated too (air absorption)
+	// With doppler on, the velocity is measured first and the smoothed doppler ratio is set on the sound
+	float Interval = 0.0f;
+	if (mDopplerOn)
+	{
+		Interval = UpdateVelocity();
+	}
 	if (mSound->IsPlaying())
 	{
-		XACore::GetInstance()->Apply3D(mSound->GetSourceVoice(), &mEmitter, mListener, X3DAUDIO_CALCULATE_MATRIX);
+		unsigned int Flags = X3DAUDIO_CALCULATE_MATRIX;
+		if ((mCurveSet != NULL) && (mEmitter.pLPFDirectCurve != NULL) && mSound->IsFiltered())
+		{
+			Flags |= X3DAUDIO_CALCULATE_LPF_DIRECT;
+		}
+		// The panning table has the settings if the listener is at a pose it has been at before
+		X3DAUDIO_DSP_SETTINGS Settings;
+		if ((mPanning != NULL) && mPanning->GetSettings(&mEmitter, mListener, Flags, Settings))
+		{
+			mSound->Apply3DSettings(Settings, Flags);
+		}
+		else
+		{
+			mSound->Apply3D(&mEmitter, mListener, Flags);
+		}
+		if (mDopplerOn && (Interval > 0.0f))
+		{
+			UpdateDoppler(Interval);
+		}
+	}
+
+	// Move the reflections with the emitter/listener; their 3D settings are applied in EarlyReflections::UpdateFrame
+	if (mReflections != NULL)
+	{
+		// The reflections are the room's reverberant sound, so their level follows the reverb curve from the lookup table
+		if ((mCurveSet != NULL) && (mEmitter.pReverbCurve != NULL))
+		{
+			float dx = mEmitter.Position.x - mListener->Position.x;
+			float dy = mEmitter.Position.y - mListener->Position.y;
+			float dz = mEmitter.Position.z - mListener->Position.z;
+			float Distance = sqrt((dx * dx) + (dy * dy) + (dz * dz)) / mCurveSet->DistanceScaler;
+			float SendLevel = mCurveSet->Reverb.Evaluate(Distance);
+			mReflections->SetSendLevel((SendLevel > 0.001f) ? (20.0f * log10(SendLevel)) : -60.0f);
+		}
+		mReflections->Update();
 	}
 }
 // End of UpdateEmitter function
@@ -192,13 +503,11 @@ void Emitter::ResetEmitter(bool IsPlaying)
 	{
 		mEmitter.pCone = &mCone;
 	}
+	ForgetSettings();
 	// If the sound is playing when it is reset, play the sound.
 	if (IsPlaying)
 	{
-		if (mSound->IsValid()) 
-		{
-			mSound->Play();
-		}
+		PlayEmitter();
 	}
 	// Update the emitter to its settings
 	UpdateEmitter();
@@ -215,10 +524,16 @@ void Emitter::ResetEmitter(bool IsPlaying)
 // Out:				N/a
 void Emitter::ChangeEmitterSound(XASound *EmitterSound, X3DAUDIO_VECTOR EmitterPosition, bool IsLooped)
 {
-	// Stop the current sound from playing
+	TRACE_SCOPE("Emitter::ChangeEmitterSound", "audio");
+
+	// Stop the current sound from playing, leaving it without a doppler shift for when it is next used
 	if (mSound->IsValid()) 
 	{
 		mSound->Stop();
+		if (mDopplerOn)
+		{
+			mSound->SetDopplerRatio(1.0f);
+		}
 	}
 	
 	// Assign the mSound XASound object to the new sound passed into this function
@@ -230,20 +545,32 @@ void Emitter::ChangeEmitterSound(XASound *EmitterSound, X3DAUDIO_VECTOR EmitterP
 	// Re-initialise emitter for the new sound
 	SecureZeroMemory (&mEmitter, sizeof(X3DAUDIO_EMITTER));
 
-	// Get the new source voice details and the new position and assign this info to the emitter struct
-	XAUDIO2_VOICE_DETAILS details;
-	mSound->GetSourceVoice()->GetVoiceDetails(&details);
-	mEmitter.ChannelCount = details.InputChannels;
+	// Get the new sound's channel count and the new position and assign this info to the emitter struct
+	mEmitter.ChannelCount = mSound->GetChannelCount();
 	mEmitter.CurveDistanceScaler = 1.0f;
 	mEmitter.Position = EmitterPosition;
 
+	// Keep the curves of the emitter's type; the settings kept for the old sound are no use for the new one
+	ApplyDistanceCurves();
+	ForgetSettings();
+
+	// Keep doppler on, starting the velocity again from the new position
+	if (mDopplerOn)
+	{
+		mEmitter.DopplerScaler = mDopplerScaler;
+		ResetMotion();
+	}
+
 	mConeOn = false;
 
-	// If the sound is valid, play the sound.
-	if (mSound->IsValid()) 
+	// The reflections are made from the new sound
+	if (mReflections != NULL)
 	{
-		mSound->Play();
+		mReflections->SetSound(mSound);
 	}
+
+	// If the sound is valid, play the sound.
+	PlayEmitter();
 	
 	// Update the emitter with the new sound and settings
 	UpdateEmitter();
@@ -263,6 +590,11 @@ void Emitter::StopEmitter()
 	{
 		mSound->Stop();
 	}
+	// Stop the reflections too
+	if (mReflections != NULL)
+	{
+		mReflections->Stop();
+	}
 }
 // End StopEmitter function
 
@@ -277,7 +609,13 @@ void Emitter::PlayEmitter()
 	// If the sound is valid, play the sound
 	if (mSound->IsValid())
 	{
+		// Only start the reflections if the sound is starting; Play has no effect on a sound that is already playing
+		bool WasPlaying = mSound->IsPlaying();
 		mSound->Play();
+		if ((mReflections != NULL) && (!WasPlaying))
+		{
+			mReflections->Play();
+		}
 	}
 }
 // End PlayEmitter function
@@ -295,6 +633,11 @@ void Emitter::PauseEmitter()
 	{
 		mSound->Pause();
 	}
+	// Pause the reflections too
+	if (mReflections != NULL)
+	{
+		mReflections->Pause();
+	}
 }
 // End PauseEmitter function
 
@@ -323,6 +666,11 @@ void Emitter::SetEmitterFilter(XAUDIO2_FILTER_TYPE FilterType, float Frequency,
 
 void Emitter::SetPosition(X3DAUDIO_VECTOR NewPosition)
 {
+	// The settings kept in the panning table were for the old position
+	if ((mPanning != NULL) && ((NewPosition.x != mEmitter.Position.x) || (NewPosition.y != mEmitter.Position.y) || (NewPosition.z != mEmitter.Position.z)))
+	{
+		mPanning->Clear();
+	}
 	// Set the position of the emitter to the new position passed into this function
 	mEmitter.Position = NewPosition;
 }
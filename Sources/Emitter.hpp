@@ -1,11 +1,11 @@
 /*
 	file:	Emitter.hpp
-	Version:	3.0
-	Date:		1st May 2015
+	Version:	3.2
+	Date:		18th October 2026
 	Author:		Cassie Bennett
 
 	Exposes:	Emitter
-	Requires:	X3DAudio, XASound, XACore, StuVector3
+	Requires:	X3DAudio, XASound, XACore, StuVector3, EarlyReflections, DistanceCurves, PanningTable, GameTimer
 
 	Description:
 	This Emitter class is based and expanded upon the Emitter example initialisation given by Allan Milne in the RoomEscape solution
@@ -20,6 +20,11 @@
 	*	Set the filter of the emitter's sound
 	*	Play, Stop, Pause, and check if the emitter is active
 	*	Set the emitter to loop, and also reset the emitter
+	*	Enable early reflections of the emitter's sound from the room walls
+	*	Set the type of the emitter, which selects the distance curves for its volume, LFE, air absorption (low pass filter)
+		and reflection send level; without a type X3DAudio's default inverse distance law is used
+	*	Enable doppler; the emitter's velocity is found from its change in position over the real time between updates (so it
+		does not depend on the frame rate), and the doppler ratio is smoothed and clamped before it is applied to the sound
 
 	Emitter objects are used throughout the application to encapsulate an object in the scene that produces sounds at specific positions
 
@@ -40,10 +45,32 @@ using AllanMilne::Audio::XASound;
 
 #include "XACore.hpp"
 using AllanMilne::Audio::XACore;
+using AllanMilne::Audio::IXACore;
+
+#include "GameTimer.h"
 
 #include "StuVector3.hpp"
 using namespace stu;
 
+// Application includes.
+#include "EarlyReflections.hpp"
+#include "DistanceCurves.hpp"
+#include "PanningTable.hpp"
+
+// The shortest time (in seconds) over which the emitter's velocity is measured; updates closer together than this are combined
+#define VELOCITY_MIN_INTERVAL 0.01f
+
+// Updates further apart than this (in seconds) restart the velocity measurement, so a long pause isn't read as movement
+#define VELOCITY_MAX_INTERVAL 0.25f
+
+// The greatest speed (units per second) an emitter can have; a jump to a new position is not heard as a doppler shift
+#define MAX_EMITTER_SPEED 10.0f
+
+// The time constant (in seconds) the doppler ratio is smoothed over, and the range it is clamped to
+#define DOPPLER_SMOOTHING_TIME 0.1f
+#define DOPPLER_MIN_RATIO 0.5f
+#define DOPPLER_MAX_RATIO 2.0f
+
 // The Emitter Class
 class Emitter
 {
@@ -75,6 +102,48 @@ public:
 	//					bool IsLooped - simple bool to tell the constructor whether to loop the sound or not
 	// Out:				N/a
 	Emitter(XASound *EmitterSound, X3DAUDIO_VECTOR EmitterPosition, X3DAUDIO_LISTENER *Listener, v3f *SoundPosition, v3f *OrientationPosition, bool IsLooped);
+
+	// Function:		~Emitter() - Emitter Destructor
+	// Description:		Deletes the early reflections object if reflections were enabled, and the motion timer
+	// In:				N/a
+	// Out:				N/a
+	~Emitter();
+
+	// Function:		EnableReflections() - Enable Reflections function
+	// Description:		Creates an EarlyReflections object for the emitter so that reflections of its sound from the room walls are
+	//					rendered. The reflections follow the emitter's sound, position and play state from then on.
+	// In:				N/a
+	// Out:				N/a
+	void EnableReflections();
+
+	// Function:		SetEmitterType(EmitterType) - Set Emitter Type function
+	// Description:		Selects the distance curves for the type of emitter and sets them in the emitter struct. The low pass filter
+	//					curve is only applied if the emitter's sound was created with filtering enabled.
+	// In:				EmitterType Type - the type of the emitter
+	// Out:				N/a
+	void SetEmitterType(EmitterType Type);
+
+	// Function:		EnableDoppler(float) - Enable Doppler function
+	// Description:		Turns on doppler for the emitter. From then on UpdateEmitter measures the emitter's velocity and applies the
+	//					smoothed doppler ratio to its sound.
+	// In:				float DopplerScaler - the X3DAudio doppler scaler; the room is small and sources move slowly, so values above 1
+	//					exaggerate the shift so that it can be heard
+	// Out:				N/a
+	void EnableDoppler(float DopplerScaler);
+
+	// Function:		EnablePanningTable() - Enable Panning Table function
+	// Description:		Creates a PanningTable for the emitter, so that its 3D settings are kept for the listener poses it is heard from
+	//					and copied to its sound when the listener comes back to one. Only for emitters that stay still; the table is
+	//					cleared whenever the emitter moves.
+	// In:				N/a
+	// Out:				N/a
+	void EnablePanningTable();
+
+	// Function:		GetPanningTable() - Get Panning Table function
+	// Description:		Accessor for the emitter's panning table
+	// In:				N/a
+	// Out:				const PanningTable* - the table, NULL if it is not enabled
+	inline const PanningTable *GetPanningTable() const { return mPanning; }
 	
 	// Function:		UpdateEmitter() - Update Emitter function
 	// Description:		Calculates and applys 3D audio DSP settings to the emitters sound based on the Listener's position and orientation
@@ -159,6 +228,41 @@ private:
 	// Out:				N/a
 	inline void LoopEmitter(bool Loop) { mSound->SetLooped(Loop); }
 
+	// Function:		ApplyDistanceCurves() - Apply Distance Curves function
+	// Description:		Sets the curve distance scaler and the curves of the emitter's curve set in the emitter struct; used when the
+	//					type is set and after the struct is re-initialised for a new sound
+	// In:				N/a
+	// Out:				N/a
+	void ApplyDistanceCurves();
+
+	// Function:		UpdateVelocity() - Update Velocity function
+	// Description:		Measures the emitter's velocity from its change in position since the last measurement, using the motion timer
+	//					for the time passed, and sets it in the emitter struct
+	// In:				N/a
+	// Out:				float - the time in seconds the velocity was measured over, 0 if it was not measured this update
+	float UpdateVelocity();
+
+	// Function:		UpdateDoppler(float) - Update Doppler function
+	// Description:		Calculates the doppler ratio for the emitter's velocity and the listener's, moves the smoothed ratio towards it
+	//					over the time passed, clamps it and sets it on the sound
+	// In:				float Interval - the time in seconds since the ratio was last smoothed
+	// Out:				N/a
+	void UpdateDoppler(float Interval);
+
+	// Function:		ResetMotion() - Reset Motion function
+	// Description:		Zeroes the velocity, sets the sound's doppler ratio back to 1 and restarts the velocity measurement from the
+	//					current position; used when the emitter's sound changes
+	// In:				N/a
+	// Out:				N/a
+	void ResetMotion();
+
+	// Function:		ForgetSettings() - Forget Settings function
+	// Description:		Drops the 3D settings kept for the emitter in the panning table; used when a change to the emitter, e.g. its
+	//					curves or cone, means they no longer match what UpdateEmitter would calculate
+	// In:				N/a
+	// Out:				N/a
+	void ForgetSettings();
+
 	// This is the XASound object for the emitter
 	XASound *mSound;
 
@@ -180,6 +284,26 @@ private:
 
 	// Bool to tell if the emitter is currently playing a sound or not
 	bool mActive;
+
+	// The early reflections of the emitter's sound, NULL if reflections are not enabled
+	EarlyReflections *mReflections;
+
+	// The distance curves for the emitter's type, NULL if no type has been set
+	DistanceCurveSet *mCurveSet;
+
+	// Doppler state; the scaler is kept as the emitter struct is cleared when its sound changes
+	bool mDopplerOn;
+	float mDopplerScaler;
+	float mDopplerRatio;
+
+	// The position the velocity is measured from, the time since it was recorded, and the timer that measures this
+	X3DAUDIO_VECTOR mLastPosition;
+	float mMotionInterval;
+	bool mMotionValid;
+	GameTimer *mMotionTimer;
+
+	// The 3D settings kept for the listener's poses, NULL if the panning table is not enabled
+	PanningTable *mPanning;
 };
 // End of Emitter class
 
@@ -5,6 +5,11 @@
 #include "GameTimer.h"
 #include <windows.h>
 
+// The simulated clock is off until switched on
+bool GameTimer::mSimulated = false;
+double GameTimer::mSimulatedTime = 0.0;
+double GameTimer::mCountsPerSecond = 0.0;
+
 GameTimer::GameTimer()
 : mSecondsPerCount(0.0), mDeltaTime(-1.0), mBaseCount(0), 
   mPausedCount(0), mPreviousCount(0), mCurrentCount(0), mIsStopped(false)
@@ -55,8 +60,7 @@ float GameTimer::GetElapsedTime() const
 // Must be called at least once before use
 void GameTimer::Reset()
 {
-	__int64 currTime;
-	QueryPerformanceCounter((LARGE_INTEGER*)&currTime);
+	__int64 currTime = ReadCounter();
 
 	mBaseCount = currTime;
 	mPreviousCount = currTime;
@@ -76,8 +80,7 @@ void GameTimer::Start()
 	// Can only start a stopped timer
 	if( mIsStopped )
 	{
-		__int64 startTime;
-		QueryPerformanceCounter((LARGE_INTEGER*)&startTime);
+		__int64 startTime = ReadCounter();
 		// Keep track of how long we've been paused, cumulative since last call to Reset()
 		mPausedCount += (startTime - mStopCount);	
 
@@ -91,8 +94,7 @@ void GameTimer::Stop()
 {
 	if( !mIsStopped )
 	{
-		__int64 currTime;
-		QueryPerformanceCounter((LARGE_INTEGER*)&currTime);
+		__int64 currTime = ReadCounter();
 
 		mStopCount = currTime;	// Start counting stop time
 		mIsStopped  = true;
@@ -107,8 +109,7 @@ void GameTimer::Tick()
 		return;
 	}
 
-	__int64 currTime;
-	QueryPerformanceCounter((LARGE_INTEGER*)&currTime);
+	__int64 currTime = ReadCounter();
 	mCurrentCount = currTime;
 
 	// We know how long a single count is, we know how many counts have passed since we last counted
@@ -127,3 +128,53 @@ void GameTimer::Tick()
 	}
 }
 
+
+// Switch the simulated clock on or off for all timers
+// The simulated counter counts at the performance counter frequency so existing timers convert it correctly
+void GameTimer::UseSimulatedClock(bool useSimulated)
+{
+	if( useSimulated )
+	{
+		__int64 countsPerSec;
+		QueryPerformanceFrequency((LARGE_INTEGER*)&countsPerSec);
+		mCountsPerSecond = static_cast<double>(countsPerSec);
+		mSimulatedTime = 0.0;
+	}
+	mSimulated = useSimulated;
+}
+
+// Move the simulated clock on; no effect unless the simulated clock is in use
+void GameTimer::AdvanceSimulatedClock(double seconds)
+{
+	if( mSimulated && seconds > 0.0 )
+	{
+		mSimulatedTime += seconds;
+	}
+}
+
+// Read the current count from the performance counter or the simulated clock
+__int64 GameTimer::ReadCounter()
+{
+	if( mSimulated )
+	{
+		return static_cast<__int64>(mSimulatedTime * mCountsPerSecond);
+	}
+
+	return ReadPerformanceCounter();
+}
+
+// Read the performance counter whether or not the simulated clock is in use
+__int64 GameTimer::ReadPerformanceCounter()
+{
+	__int64 currTime;
+	QueryPerformanceCounter((LARGE_INTEGER*)&currTime);
+	return currTime;
+}
+
+// The time in seconds of a single performance counter step
+double GameTimer::GetSecondsPerPerformanceCount()
+{
+	__int64 countsPerSec;
+	QueryPerformanceFrequency((LARGE_INTEGER*)&countsPerSec);
+	return 1.0 / static_cast<double>(countsPerSec);
+}
@@ -35,7 +35,27 @@ public:
 	void Stop();  // Call to pause timer
 	void Tick();  // Call each frame in game loop
 
+	// Simulated clock for deterministic (e.g. headless) runs.
+	// While it is in use every timer reads the simulated counter rather than the performance counter,
+	// so time only passes when AdvanceSimulatedClock() is called. The simulated counter restarts from 0 each time it is switched on,
+	// so switch it on before any timers are reset; restarting it gives each run the same clock values.
+	static void UseSimulatedClock(bool useSimulated);
+	static void AdvanceSimulatedClock(double seconds);
+	static inline bool IsSimulatedClock() { return mSimulated; }
+
+	// Direct access to the performance counter, bypassing the simulated clock, for measuring how long code takes to run
+	static __int64 ReadPerformanceCounter();
+	static double GetSecondsPerPerformanceCount();
+
 private:
+	// Read the performance counter, or the simulated counter if it is in use
+	static __int64 ReadCounter();
+
+	// Simulated clock state; the simulated time is held in seconds and converted to performance counter counts
+	static bool mSimulated;
+	static double mSimulatedTime;
+	static double mCountsPerSecond;
+
 	// Double precision internally
 	double mSecondsPerCount;
 	double mDeltaTime;
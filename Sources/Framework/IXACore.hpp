@@ -1,6 +1,6 @@
 /*
 	file:	IXACore.hpp
-	Version:	2.2
+	Version:	2.4
 	Date:	June 2013; April 2013; September 2012.
 	Authors:	Stuart and Allan Milne.
 
@@ -58,6 +58,12 @@ public:
 	virtual const XAUDIO2_DEVICE_DETAILS& GetDeviceDetails () = 0;
 
 	virtual void Apply3D (IXAudio2SourceVoice* aVoice, const X3DAUDIO_EMITTER* anEmitter, const X3DAUDIO_LISTENER* aListener, const unsigned int flags) const = 0;
+	virtual void Calculate3D (const X3DAUDIO_EMITTER* anEmitter, const X3DAUDIO_LISTENER* aListener, const unsigned int flags, X3DAUDIO_DSP_SETTINGS &aSettings) const = 0;
+
+	//--- Voice creation and operation sets; these go through the core so they also work with the null device.
+	virtual HRESULT CreateSourceVoice (IXAudio2SourceVoice** aVoice, const WAVEFORMATEX* aFormat, const UINT32 flags) = 0;
+	virtual HRESULT CommitChanges (const UINT32 operationSet) = 0;
+	virtual bool IsNullDevice () const = 0;
 
 }; // end IXACore interface.
 
@@ -79,6 +85,15 @@ incorporates X3DAudio functionality:
 ---- 11/6/13 changes
 Removed listener entries from interface, it is now client responsibility to manage listener
 and supply XAudio2 listener type to Apply3D methods exposed by core.
+
+=== Version 2.3 changes.
+Added Calculate3D() to calculate 3D DSP settings without applying them to a voice;
+- allows the settings to be applied as ramped targets by XASound.
+
+=== Version 2.4 changes.
+Added CreateSourceVoice(), CommitChanges() and IsNullDevice();
+- the core can be created on a null device, with no XAudio2 engine, for headless runs;
+  source voices are then software NullSourceVoice objects and operation sets are ignored.
 */
 
 #endif
\ No newline at end of file
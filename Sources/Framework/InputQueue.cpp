@@ -0,0 +1,166 @@
+/*
+	file:	InputQueue.cpp
+	Version:	1.1
+	Date:	18th October 2026.
+	Author:	agent.
+
+	Namespace:	AllanMilne
+	Exposes:	InputQueue implementation.
+	Requires:	GameTimer, TraceLog.
+
+	Description:
+	A queue of timestamped keyboard events fed from the window procedure.
+	this is the implementation file - see InputQueue.hpp for details.
+
+*/
+
+// system includes.
+#include <windows.h>
+#include <deque>
+#include <map>
+using std::deque;
+using std::map;
+
+// framework includes.
+#include "GameTimer.h"
+#include "InputQueue.hpp"
+#include "TraceLog.hpp"
+
+namespace AllanMilne {
+
+	//--- Initialise the static instance field.
+	InputQueue *InputQueue::mInstance = NULL;
+
+//--- Get the singleton instance - use lazy evaluation.
+InputQueue& InputQueue::GetInstance ()
+{
+	// Instance already created so return it.
+	if (mInstance) { return *mInstance; }
+	// First time called so instantiate the object.
+	mInstance = new InputQueue ();
+	return *mInstance;
+} // end static GetInstance function.
+
+//--- Delete the queue instance.
+void InputQueue::DeleteInstance ()
+{
+	delete mInstance;
+	mInstance = NULL;
+} // end static DeleteInstance function.
+
+//--- Add the event for a WM_KEYDOWN or WM_KEYUP message; other messages are ignored.
+void InputQueue::OnKeyMessage (const UINT aMessage, const WPARAM aKey, const LPARAM aFlags)
+{
+	if (aMessage != WM_KEYDOWN && aMessage != WM_KEYUP) return;
+	TRACE_SCOPE ("InputQueue::OnKeyMessage", "input");
+	InputEvent keyEvent;
+	keyEvent.Key = aKey;
+	keyEvent.Pressed = (aMessage == WM_KEYDOWN);
+	keyEvent.Repeat = keyEvent.Pressed && ((aFlags & (1 << 30)) != 0);
+	keyEvent.Time = GetTime();
+	keyEvent.TraceFlow = 0;
+#ifdef TRACING_ENABLED
+	// Start a flow from the key press that the command and sounds it causes continue.
+	if (keyEvent.Pressed && TraceLog::IsTracing()) {
+		TraceLog &trace = TraceLog::GetInstance();
+		keyEvent.TraceFlow = trace.NewFlowId();
+		trace.AddFlow ("Key press", "input", TraceLog::FlowStart, keyEvent.TraceFlow);
+	}
+#endif
+	PushEvent (keyEvent);
+} // end OnKeyMessage function.
+
+//--- Add an event directly; its Repeat field is set if the key is already down.
+void InputQueue::PushEvent (const InputEvent &anEvent)
+{
+	InputEvent keyEvent = anEvent;
+	bool wasDown = IsKeyDown (keyEvent.Key);
+	if (keyEvent.Pressed && wasDown) {
+		keyEvent.Repeat = true;
+	}
+	mKeyDown[keyEvent.Key] = keyEvent.Pressed;
+
+	// Drop the oldest event rather than grow without limit if the application stops taking events.
+	if (mEvents.size() >= MaxEvents) {
+		mEvents.pop_front();
+		++mDroppedEvents;
+	}
+	mEvents.push_back (keyEvent);
+} // end PushEvent function.
+
+//--- Take the oldest event from the queue; returns false if the queue is empty.
+bool InputQueue::NextEvent (InputEvent &anEvent)
+{
+	if (mEvents.empty()) return false;
+	anEvent = mEvents.front();
+	mEvents.pop_front();
+	return true;
+} // end NextEvent function.
+
+//--- Map a key to a command value.
+void InputQueue::MapKey (const WPARAM aKey, const int aCommand, const bool aRepeats)
+{
+	KeyMapping mapping;
+	mapping.Command = aCommand;
+	mapping.Repeats = aRepeats;
+	mKeyMap[aKey] = mapping;
+} // end MapKey function.
+
+void InputQueue::UnmapKey (const WPARAM aKey)
+{
+	mKeyMap.erase (aKey);
+} // end UnmapKey function.
+
+//--- Take the next mapped command from the queue; events that do not produce a command are discarded.
+bool InputQueue::NextCommand (int &aCommand, float &aTime)
+{
+	InputEvent keyEvent;
+	while (NextEvent (keyEvent)) {
+		if (!keyEvent.Pressed) continue;
+		map<WPARAM, KeyMapping>::const_iterator mapping = mKeyMap.find (keyEvent.Key);
+		if (mapping == mKeyMap.end()) continue;
+		if (keyEvent.Repeat && !mapping->second.Repeats) continue;
+		aCommand = mapping->second.Command;
+		aTime = keyEvent.Time;
+		mCommandFlow = keyEvent.TraceFlow;
+		return true;
+	}
+	return false;
+} // end NextCommand function.
+
+//--- Remove all waiting events; key up/down state is kept.
+void InputQueue::Clear ()
+{
+	mEvents.clear();
+} // end Clear function.
+
+//--- True if the key's last event was a key down.
+bool InputQueue::IsKeyDown (const WPARAM aKey) const
+{
+	map<WPARAM, bool>::const_iterator key = mKeyDown.find (aKey);
+	return (key != mKeyDown.end()) && key->second;
+} // end IsKeyDown function.
+
+//--- The current time, in seconds, on the clock used to stamp the events.
+float InputQueue::GetTime ()
+{
+	// The timer's current count is only updated by Tick().
+	mClock->Tick();
+	return mClock->GetElapsedTime();
+} // end GetTime function.
+
+// Constructor & destructor are hidden to implement singleton patern.
+InputQueue::InputQueue ()
+{
+	mClock = new GameTimer ();
+	mClock->Reset ();
+	mDroppedEvents = 0;
+	mCommandFlow = 0;
+} // end InputQueue constructor.
+
+InputQueue::~InputQueue ()
+{
+	delete mClock;
+} // end InputQueue destructor.
+
+} // end AllanMilne namespace.
@@ -0,0 +1,128 @@
+/*
+	file:	InputQueue.hpp
+	Version:	1.1
+	Date:	18th October 2026.
+	Author:	agent.
+
+	Namespace:	AllanMilne
+	Exposes:	InputEvent, InputQueue.
+	Requires:	GameTimer, TraceLog.
+
+	Description:
+	A queue of timestamped keyboard events fed from the window procedure,
+	replacing per-frame polling of GetAsyncKeyState() for each key of interest.
+
+	*	WinCore's window procedure passes WM_KEYDOWN and WM_KEYUP messages to OnKeyMessage();
+	*	each event is stamped with the time it was received on the queue's high resolution clock, so the delay from
+		a key press to the action it causes can be measured against GetTime();
+	*	key downs generated by keyboard auto-repeat are marked as repeats;
+	*	keys are mapped to application defined command values; NextCommand() returns the commands in the order
+		their keys were pressed, discarding key ups, unmapped keys, and repeats of keys not mapped to repeat;
+	*	events can also be pushed directly, e.g. from a script, through PushEvent();
+	*	while a TraceLog trace is running each key press starts a trace flow, and GetCommandFlow() gives the flow
+		of the last command so the code actioning it can continue the flow.
+
+	The queue holds at most MaxEvents events; if it is full the oldest event is dropped.
+
+	Note this implementation is NOT thread safe; events are added and removed on the window thread.
+
+	Exposed and implemented as a singleton pattern.
+
+*/
+
+#ifndef __INPUTQUEUE_HPP__
+#define __INPUTQUEUE_HPP__
+
+// system includes.
+#include <windows.h>
+#include <deque>
+#include <map>
+using std::deque;
+using std::map;
+
+// forward declaration of non-namespaced component.
+class GameTimer;
+
+namespace AllanMilne {
+
+//--- A single key event.
+struct InputEvent {
+	WPARAM Key;			// virtual key code.
+	bool Pressed;		// true for a key down, false for a key up.
+	bool Repeat;		// true if the key down was generated by auto-repeat.
+	float Time;			// seconds on the queue's clock when the event was received.
+	unsigned long TraceFlow;	// trace flow started by the key press; 0 if none.
+};
+
+class InputQueue
+{
+public:
+
+	//--- Get the singleton instance - use lazy evaluation.
+	static InputQueue& GetInstance ();
+
+	//--- Delete the queue instance.
+	static void DeleteInstance ();
+
+	//--- Add the event for a WM_KEYDOWN or WM_KEYUP message; other messages are ignored.
+	//--- Bit 30 of the message flags is the previous key state, which identifies auto-repeated key downs.
+	void OnKeyMessage (const UINT aMessage, const WPARAM aKey, const LPARAM aFlags);
+
+	//--- Add an event directly; its Repeat field is set if the key is already down.
+	void PushEvent (const InputEvent &anEvent);
+
+	//--- Take the oldest event from the queue; returns false if the queue is empty.
+	bool NextEvent (InputEvent &anEvent);
+
+	//--- Map a key to a command value; repeated key downs only produce the command if aRepeats is true.
+	void MapKey (const WPARAM aKey, const int aCommand, const bool aRepeats=false);
+	void UnmapKey (const WPARAM aKey);
+
+	//--- Take the next mapped command from the queue along with the time its key was pressed;
+	//--- events that do not produce a command are discarded. Returns false if no command is waiting.
+	bool NextCommand (int &aCommand, float &aTime);
+
+	//--- The trace flow of the key press that gave the last command; 0 if it was not traced.
+	inline unsigned long GetCommandFlow () const { return mCommandFlow; }
+
+	//--- Remove all waiting events, e.g. after a modal dialog; key up/down state is kept.
+	void Clear ();
+
+	//--- True if the key's last event was a key down.
+	bool IsKeyDown (const WPARAM aKey) const;
+
+	//--- The current time, in seconds, on the clock used to stamp the events.
+	float GetTime ();
+
+	//--- Number of events dropped because the queue was full.
+	inline unsigned long GetDroppedEvents () const { return mDroppedEvents; }
+
+	//--- Most events held before the oldest is dropped.
+	static const unsigned int MaxEvents = 64;
+
+private:
+	// the singleton instance.
+	static InputQueue *mInstance;
+
+	// Constructor & destructor are hidden to implement singleton patern.
+	InputQueue ();
+	~InputQueue ();
+
+	// The command a key is mapped to.
+	struct KeyMapping {
+		int Command;
+		bool Repeats;
+	};
+
+	deque<InputEvent> mEvents;
+	map<WPARAM, KeyMapping> mKeyMap;
+	map<WPARAM, bool> mKeyDown;
+	GameTimer *mClock;
+	unsigned long mDroppedEvents;
+	unsigned long mCommandFlow;
+
+}; // end InputQueue class.
+
+} // end AllanMilne namespace.
+
+#endif
@@ -0,0 +1,142 @@
+/*
+	file:	LoopFinder.cpp
+	Version:	1.1
+	Date:	18th October 2026.
+	Author:	agent.
+
+	Namespace:	AllanMilne::Audio
+	Exposes:	LoopFinder implementation.
+	Requires:	PCMWave.
+
+	Description:
+	Finds seamless loop points in a wave and trims it to its intro and loop.
+	this is the implementation file - see LoopFinder.hpp for details.
+
+*/
+
+// system includes.
+#include <string>
+#include <vector>
+using std::string;
+using std::vector;
+
+// framework includes.
+#include "LoopFinder.hpp"
+#include "PCMWave.hpp"
+
+namespace AllanMilne {
+namespace Audio {
+
+LoopFinder::LoopFinder ()
+	: mLoopBegin(0), mLoopLength(0), mMismatch(0.0f), mJoinLoudness(0.0f)
+{ } // end constructor.
+
+//--- Search the rising zero crossings of the mono mix for the loop whose join matches best.
+bool LoopFinder::Find (const PCMWave &aWave, const float aMinLength, const float aMaxLength, const float aMaxIntro)
+{
+	mLoopBegin = 0;
+	mLoopLength = 0;
+	mMismatch = 0.0f;
+	mJoinLoudness = 0.0f;
+	const WaveFmt &format = aWave.GetWaveFormat();
+	if (aWave.GetStatus() != PCMWave::OK || format.wBitsPerSample != 16 || format.nChannels == 0 || aMinLength <= 0.0f || aMaxLength < aMinLength || aMaxIntro < 0.0f) {
+		return false;
+	}
+
+	// mix the channels to mono.
+	const size_t frames = aWave.GetDataSize() / format.nBlockAlign;
+	const short *samples = (const short*)aWave.GetWaveData();
+	vector<float> mono (frames);
+	double energy = 0.0;
+	for (size_t i=0; i<frames; ++i) {
+		float sum = 0.0f;
+		for (unsigned short c=0; c<format.nChannels; ++c) {
+			sum += samples[i * format.nChannels + c];
+		}
+		mono[i] = sum / format.nChannels;
+		energy += double(mono[i]) * mono[i];
+	}
+	// the energy of two windows at the wave's average loudness, added to the energy of the windows scored so that quiet joins score well.
+	const double loudness = (frames > 0) ? 2.0 * LOOPFINDER_WINDOW * energy / frames : 0.0;
+
+	// the rising zero crossings far enough from the ends to be scored.
+	const size_t half = LOOPFINDER_WINDOW / 2;
+	vector<size_t> crossings;
+	for (size_t i=half; i+half<=frames; ++i) {
+		if (mono[i-1] < 0.0f && mono[i] >= 0.0f) crossings.push_back (i);
+	}
+
+	const size_t minLength = size_t(aMinLength * format.nSamplesPerSec);
+	const size_t maxLength = size_t(aMaxLength * format.nSamplesPerSec);
+	const size_t maxIntro = size_t(aMaxIntro * format.nSamplesPerSec);
+
+	// the begin candidates, skipping crossings evenly if there are too many; the intro is at least half a window.
+	vector<size_t> begins;
+	for (size_t i=0; i<crossings.size() && crossings[i]<=half+maxIntro; ++i) begins.push_back (crossings[i]);
+	const size_t beginStep = (begins.size() + LOOPFINDER_BEGINS - 1) / LOOPFINDER_BEGINS;
+
+	bool found = false;
+	for (size_t b=0; b<begins.size(); b+=beginStep) {
+		const size_t begin = begins[b];
+		// the end candidates for this begin.
+		size_t first = 0;
+		while (first < crossings.size() && crossings[first] < begin + minLength) ++first;
+		size_t last = first;
+		while (last < crossings.size() && crossings[last] <= begin + maxLength) ++last;
+		if (last == first) continue;
+		const size_t endStep = (last - first + LOOPFINDER_ENDS - 1) / LOOPFINDER_ENDS;
+		for (size_t e=first; e<last; e+=endStep) {
+			float mismatch = Mismatch (mono, begin, crossings[e], loudness);
+			if (!found || mismatch < mMismatch) {
+				found = true;
+				mMismatch = mismatch;
+				mLoopBegin = (unsigned long)begin;
+				mLoopLength = (unsigned long)(crossings[e] - begin);
+			}
+		}
+	}
+
+	// the loudness of the windows round the join found, against the wave's average.
+	if (found && loudness > 0.0) {
+		const size_t end = mLoopBegin + mLoopLength;
+		double joinEnergy = 0.0;
+		for (size_t k=0; k<LOOPFINDER_WINDOW; ++k) {
+			joinEnergy += double(mono[mLoopBegin - half + k]) * mono[mLoopBegin - half + k] + double(mono[end - half + k]) * mono[end - half + k];
+		}
+		mJoinLoudness = float(joinEnergy / loudness);
+	}
+	return found;
+} // end Find function.
+
+//--- The squared differences of the windows round the two points over the energy of both padded with two windows of the wave's average loudness.
+float LoopFinder::Mismatch (const vector<float> &aMono, const size_t aBegin, const size_t anEnd, const double aLoudness) const
+{
+	const size_t half = LOOPFINDER_WINDOW / 2;
+	double difference = 0.0;
+	double energy = aLoudness;
+	for (size_t k=0; k<LOOPFINDER_WINDOW; ++k) {
+		const double atBegin = aMono[aBegin - half + k];
+		const double atEnd = aMono[anEnd - half + k];
+		difference += (atBegin - atEnd) * (atBegin - atEnd);
+		energy += atBegin * atBegin + atEnd * atEnd;
+	}
+	return (energy > 0.0) ? float(difference / energy) : 0.0f;
+} // end Mismatch function.
+
+//--- Copy the frames up to the end of the loop into a new wave and set its loop.
+PCMWave* LoopFinder::Trim (const PCMWave &aWave) const
+{
+	if (mLoopLength == 0) return NULL;
+	const WaveFmt &format = aWave.GetWaveFormat();
+	const size_t size = size_t(mLoopBegin + mLoopLength) * format.nBlockAlign;
+	if (size > aWave.GetDataSize()) return NULL;
+	PCMWave *trimmed = new PCMWave (aWave.GetFileName(), format.nChannels, format.wBitsPerSample, format.nSamplesPerSec, size, aWave.GetWaveData());
+	if (trimmed->GetStatus() != PCMWave::OK || !trimmed->SetLoop (mLoopBegin, mLoopLength)) {
+		delete trimmed;
+		return NULL;
+	}
+	return trimmed;
+} // end Trim function.
+
+} // end Audio namespace.
+} // end AllanMilne namespace.
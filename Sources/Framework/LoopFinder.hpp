@@ -0,0 +1,88 @@
+/*
+	file:	LoopFinder.hpp
+	Version:	1.1
+	Date:	18th October 2026.
+	Author:	agent.
+
+	Namespace:	AllanMilne::Audio
+	Exposes:	LoopFinder.
+	Requires:	PCMWave.
+
+	Description:
+	Finds loop points in a 16 bit PCM wave where the sound can repeat without a click, and trims the wave to the frames
+	before the loop (the intro) and the loop, so a long recording that is only ever looped can be held in a fraction of its size.
+	Used offline through the game's -trimloop command line option (see Main_GhostEscape.cpp); the trimmed file marks its
+	loop in a 'smpl' chunk, which PCMWave reads and XASound loops (see PCMWave.hpp and XASound.hpp).
+
+	*	the channels are mixed to mono and the loop is searched for between rising zero crossings, so the join has no step;
+	*	a loop from B to E is scored by how well the LOOPFINDER_WINDOW frames around E match those around B, as the sum of
+		squared differences over the energy of both plus that of two windows at the wave's average loudness. The padding makes
+		the score a measure of how loud the step at the join is against the sound as a whole, not of how alike the windows
+		are: 0 is a perfect match, and two unrelated windows score about 0.5 at the wave's average loudness, towards 1 when much
+		louder and towards 0 when much quieter. So a join where the sound is quiet, and a step can't be heard, scores well even
+		if its windows are unalike; GetJoinLoudness gives the loudness to read the score against;
+	*	B is tried at up to LOOPFINDER_BEGINS crossings within the longest intro asked for, and E at up to LOOPFINDER_ENDS
+		crossings that give a loop length within the range asked for; the best scoring pair is the loop. The intro is at
+		least half a window, so that the frames before B can be scored.
+
+	The search only looks at the join, so the length range should be chosen by ear: long enough that the repeat isn't noticed.
+*/
+
+#ifndef __LOOPFINDER_HPP__
+#define __LOOPFINDER_HPP__
+
+// system includes.
+#include <vector>
+using std::vector;
+
+//--- The frames around the loop points compared when scoring a loop.
+#define LOOPFINDER_WINDOW 512
+
+//--- The most loop begin and end candidates tried; crossings are skipped evenly beyond these.
+#define LOOPFINDER_BEGINS 64
+#define LOOPFINDER_ENDS 4096
+
+namespace AllanMilne {
+namespace Audio {
+
+// forward declarations.
+	class PCMWave;
+
+class LoopFinder
+{
+public:
+
+	LoopFinder ();
+
+	//--- Find the best loop of a wave with an intro of at most aMaxIntro seconds and a length between aMinLength and aMaxLength seconds.
+	//--- Returns false if the wave is not 16 bit PCM or is too short for such a loop.
+	bool Find (const PCMWave &aWave, const float aMinLength, const float aMaxLength, const float aMaxIntro);
+
+	//--- The loop found, in sample frames, and its score; 0 until a loop is found.
+	inline unsigned long GetLoopBegin () const { return mLoopBegin; }
+	inline unsigned long GetLoopLength () const { return mLoopLength; }
+	inline float GetMismatch () const { return mMismatch; }
+
+	//--- The mean energy of the windows round the join found over the wave's average; 1 at the average loudness, 0 until a loop is found.
+	inline float GetJoinLoudness () const { return mJoinLoudness; }
+
+	//--- A new wave of the intro and loop of the wave the loop was found in, with the loop set; NULL if no loop has been found.
+	//--- The caller owns the wave.
+	PCMWave* Trim (const PCMWave &aWave) const;
+
+private:
+	unsigned long mLoopBegin;
+	unsigned long mLoopLength;
+	float mMismatch;
+	float mJoinLoudness;
+
+	//--- The score of a loop from aBegin to anEnd of the mono mix; both must be at least half a window from the ends.
+	//--- aLoudness is the energy of two windows at the wave's average loudness, which pads the energy the differences are measured against.
+	float Mismatch (const vector<float> &aMono, const size_t aBegin, const size_t anEnd, const double aLoudness) const;
+
+}; // end LoopFinder class.
+
+} // end Audio namespace.
+} // end AllanMilne namespace.
+
+#endif
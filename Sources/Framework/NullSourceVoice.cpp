@@ -0,0 +1,364 @@
+/*
+	file:	NullSourceVoice.cpp
+	Version:	1.1
+	Date:	18th October 2026.
+	Author:	agent.
+
+	Namespace:	AllanMilne::Audio
+	Exposes:	NullSourceVoice implementation.
+	Requires:	XAudio2, GameTimer.
+
+	Description:
+	A software stand-in for an XAudio2 source voice used with XACore's null device.
+	this is the implementation file - see NullSourceVoice.hpp for details.
+
+*/
+
+// system includes.
+#include <XAudio2.h>
+#include <deque>
+#include <vector>
+#include <algorithm>
+using std::deque;
+using std::vector;
+
+// framework includes.
+#include "GameTimer.h"
+#include "NullSourceVoice.hpp"
+
+namespace AllanMilne {
+namespace Audio {
+
+//--- Initialise the static call count.
+unsigned long NullSourceVoice::mCallCount = 0;
+
+//--- Create a voice for the given format and XAudio2 voice creation flags.
+NullSourceVoice::NullSourceVoice (const WAVEFORMATEX &aFormat, const UINT32 aFlags)
+	: mBlockAlign(aFormat.nBlockAlign), mRunning(false), mPosition(0.0), mSamplesPlayed(0.0), mFrequencyRatio(1.0f),
+	  mVolume(1.0f), mMatrixDestinations(0)
+{
+	mDetails.CreationFlags = aFlags;
+	mDetails.InputChannels = aFormat.nChannels;
+	mDetails.InputSampleRate = aFormat.nSamplesPerSec;
+	mChannelVolumes.assign (aFormat.nChannels, 1.0f);
+
+	// XAudio2 defaults: filter fully open.
+	mFilter.Type = LowPassFilter;
+	mFilter.Frequency = XAUDIO2_MAX_FILTER_FREQUENCY;
+	mFilter.OneOverQ = 1.0f;
+	mOutputFilter = mFilter;
+
+	mClock = new GameTimer ();
+	mClock->Reset ();
+} // end constructor.
+
+NullSourceVoice::~NullSourceVoice ()
+{
+	delete mClock;
+} // end destructor.
+
+//=== IXAudio2Voice methods.
+
+void NullSourceVoice::GetVoiceDetails (XAUDIO2_VOICE_DETAILS *pVoiceDetails)
+{
+	++mCallCount;
+	if (pVoiceDetails != NULL) *pVoiceDetails = mDetails;
+} // end GetVoiceDetails function.
+
+//--- There is no voice graph, so the sends are accepted and ignored.
+HRESULT NullSourceVoice::SetOutputVoices (const XAUDIO2_VOICE_SENDS *pSendList)
+{
+	++mCallCount;
+	return S_OK;
+} // end SetOutputVoices function.
+
+//--- Effects are not processed; only the number of effects and their enabled states are kept.
+HRESULT NullSourceVoice::SetEffectChain (const XAUDIO2_EFFECT_CHAIN *pEffectChain)
+{
+	++mCallCount;
+	UINT32 count = (pEffectChain != NULL) ? pEffectChain->EffectCount : 0;
+	mEffectsEnabled.assign (count, TRUE);
+	return S_OK;
+} // end SetEffectChain function.
+
+HRESULT NullSourceVoice::EnableEffect (UINT32 EffectIndex, UINT32 OperationSet)
+{
+	++mCallCount;
+	if (EffectIndex >= mEffectsEnabled.size()) return XAUDIO2_E_INVALID_CALL;
+	mEffectsEnabled[EffectIndex] = TRUE;
+	return S_OK;
+} // end EnableEffect function.
+
+HRESULT NullSourceVoice::DisableEffect (UINT32 EffectIndex, UINT32 OperationSet)
+{
+	++mCallCount;
+	if (EffectIndex >= mEffectsEnabled.size()) return XAUDIO2_E_INVALID_CALL;
+	mEffectsEnabled[EffectIndex] = FALSE;
+	return S_OK;
+} // end DisableEffect function.
+
+void NullSourceVoice::GetEffectState (UINT32 EffectIndex, BOOL *pEnabled)
+{
+	++mCallCount;
+	if (pEnabled == NULL) return;
+	*pEnabled = (EffectIndex < mEffectsEnabled.size()) ? mEffectsEnabled[EffectIndex] : FALSE;
+} // end GetEffectState function.
+
+HRESULT NullSourceVoice::SetEffectParameters (UINT32 EffectIndex, const void *pParameters, UINT32 ParametersByteSize, UINT32 OperationSet)
+{
+	++mCallCount;
+	if (EffectIndex >= mEffectsEnabled.size()) return XAUDIO2_E_INVALID_CALL;
+	return S_OK;
+} // end SetEffectParameters function.
+
+//--- There are no effect instances to read parameters from.
+HRESULT NullSourceVoice::GetEffectParameters (UINT32 EffectIndex, void *pParameters, UINT32 ParametersByteSize)
+{
+	++mCallCount;
+	if (EffectIndex >= mEffectsEnabled.size()) return XAUDIO2_E_INVALID_CALL;
+	return E_NOTIMPL;
+} // end GetEffectParameters function.
+
+//--- The filter can only be set on a voice created with XAUDIO2_VOICE_USEFILTER, as for XAudio2.
+HRESULT NullSourceVoice::SetFilterParameters (const XAUDIO2_FILTER_PARAMETERS *pParameters, UINT32 OperationSet)
+{
+	++mCallCount;
+	if (pParameters == NULL || !(mDetails.CreationFlags & XAUDIO2_VOICE_USEFILTER)) return XAUDIO2_E_INVALID_CALL;
+	mFilter = *pParameters;
+	return S_OK;
+} // end SetFilterParameters function.
+
+void NullSourceVoice::GetFilterParameters (XAUDIO2_FILTER_PARAMETERS *pParameters)
+{
+	++mCallCount;
+	if (pParameters != NULL) *pParameters = mFilter;
+} // end GetFilterParameters function.
+
+HRESULT NullSourceVoice::SetOutputFilterParameters (IXAudio2Voice *pDestinationVoice, const XAUDIO2_FILTER_PARAMETERS *pParameters, UINT32 OperationSet)
+{
+	++mCallCount;
+	if (pParameters == NULL) return XAUDIO2_E_INVALID_CALL;
+	mOutputFilter = *pParameters;
+	return S_OK;
+} // end SetOutputFilterParameters function.
+
+void NullSourceVoice::GetOutputFilterParameters (IXAudio2Voice *pDestinationVoice, XAUDIO2_FILTER_PARAMETERS *pParameters)
+{
+	++mCallCount;
+	if (pParameters != NULL) *pParameters = mOutputFilter;
+} // end GetOutputFilterParameters function.
+
+HRESULT NullSourceVoice::SetVolume (float Volume, UINT32 OperationSet)
+{
+	++mCallCount;
+	if (Volume < -XAUDIO2_MAX_VOLUME_LEVEL || Volume > XAUDIO2_MAX_VOLUME_LEVEL) return XAUDIO2_E_INVALID_CALL;
+	mVolume = Volume;
+	return S_OK;
+} // end SetVolume function.
+
+void NullSourceVoice::GetVolume (float *pVolume)
+{
+	++mCallCount;
+	if (pVolume != NULL) *pVolume = mVolume;
+} // end GetVolume function.
+
+HRESULT NullSourceVoice::SetChannelVolumes (UINT32 Channels, const float *pVolumes, UINT32 OperationSet)
+{
+	++mCallCount;
+	if (pVolumes == NULL || Channels != mDetails.InputChannels) return XAUDIO2_E_INVALID_CALL;
+	mChannelVolumes.assign (pVolumes, pVolumes + Channels);
+	return S_OK;
+} // end SetChannelVolumes function.
+
+void NullSourceVoice::GetChannelVolumes (UINT32 Channels, float *pVolumes)
+{
+	++mCallCount;
+	if (pVolumes == NULL || Channels != mDetails.InputChannels) return;
+	std::copy (mChannelVolumes.begin(), mChannelVolumes.end(), pVolumes);
+} // end GetChannelVolumes function.
+
+HRESULT NullSourceVoice::SetOutputMatrix (IXAudio2Voice *pDestinationVoice, UINT32 SourceChannels, UINT32 DestinationChannels, const float *pLevelMatrix, UINT32 OperationSet)
+{
+	++mCallCount;
+	if (pLevelMatrix == NULL || SourceChannels != mDetails.InputChannels || DestinationChannels == 0) return XAUDIO2_E_INVALID_CALL;
+	mOutputMatrix.assign (pLevelMatrix, pLevelMatrix + SourceChannels * DestinationChannels);
+	mMatrixDestinations = DestinationChannels;
+	return S_OK;
+} // end SetOutputMatrix function.
+
+//--- Returns zeros if the matrix has not been set for this number of destination channels.
+void NullSourceVoice::GetOutputMatrix (IXAudio2Voice *pDestinationVoice, UINT32 SourceChannels, UINT32 DestinationChannels, float *pLevelMatrix)
+{
+	++mCallCount;
+	if (pLevelMatrix == NULL) return;
+	if (SourceChannels != mDetails.InputChannels || DestinationChannels != mMatrixDestinations) {
+		std::fill (pLevelMatrix, pLevelMatrix + SourceChannels * DestinationChannels, 0.0f);
+		return;
+	}
+	std::copy (mOutputMatrix.begin(), mOutputMatrix.end(), pLevelMatrix);
+} // end GetOutputMatrix function.
+
+void NullSourceVoice::DestroyVoice ()
+{
+	++mCallCount;
+	delete this;
+} // end DestroyVoice function.
+
+//=== IXAudio2SourceVoice methods.
+
+HRESULT NullSourceVoice::Start (UINT32 Flags, UINT32 OperationSet)
+{
+	++mCallCount;
+	// Time while stopped is not played.
+	Advance ();
+	mRunning = true;
+	return S_OK;
+} // end Start function.
+
+HRESULT NullSourceVoice::Stop (UINT32 Flags, UINT32 OperationSet)
+{
+	++mCallCount;
+	Advance ();
+	mRunning = false;
+	return S_OK;
+} // end Stop function.
+
+//--- Queue a buffer; the play and loop regions are checked as XAudio2 would check them.
+HRESULT NullSourceVoice::SubmitSourceBuffer (const XAUDIO2_BUFFER *pBuffer, const XAUDIO2_BUFFER_WMA *pBufferWMA)
+{
+	++mCallCount;
+	if (pBuffer == NULL || pBufferWMA != NULL || mBlockAlign == 0) return XAUDIO2_E_INVALID_CALL;
+	Advance ();
+
+	QueuedBuffer queued;
+	queued.Buffer = *pBuffer;
+	UINT32 totalSamples = pBuffer->AudioBytes / mBlockAlign;
+	// XAudio2 only plays to the end of the buffer when the whole buffer is played.
+	if (pBuffer->PlayLength == 0 && pBuffer->PlayBegin != 0) return XAUDIO2_E_INVALID_CALL;
+	queued.PlayEnd = (pBuffer->PlayLength > 0) ? pBuffer->PlayBegin + pBuffer->PlayLength : totalSamples;
+	if (pBuffer->PlayBegin >= queued.PlayEnd || queued.PlayEnd > totalSamples) return XAUDIO2_E_INVALID_CALL;
+
+	queued.LoopsLeft = pBuffer->LoopCount;
+	queued.LoopEnd = queued.PlayEnd;
+	if (pBuffer->LoopCount > 0) {
+		queued.LoopEnd = (pBuffer->LoopLength > 0) ? pBuffer->LoopBegin + pBuffer->LoopLength : queued.PlayEnd;
+		if (pBuffer->LoopBegin >= queued.LoopEnd || queued.LoopEnd <= pBuffer->PlayBegin || queued.LoopEnd > queued.PlayEnd) return XAUDIO2_E_INVALID_CALL;
+	}
+
+	if (mBuffers.empty()) {
+		mPosition = pBuffer->PlayBegin;
+	}
+	mBuffers.push_back (queued);
+	return S_OK;
+} // end SubmitSourceBuffer function.
+
+//--- Remove the queued buffers; a running voice keeps the buffer it is playing.
+HRESULT NullSourceVoice::FlushSourceBuffers ()
+{
+	++mCallCount;
+	Advance ();
+	if (mRunning && !mBuffers.empty()) {
+		mBuffers.erase (mBuffers.begin() + 1, mBuffers.end());
+	}
+	else {
+		mBuffers.clear();
+		mPosition = 0.0;
+	}
+	return S_OK;
+} // end FlushSourceBuffers function.
+
+HRESULT NullSourceVoice::Discontinuity ()
+{
+	++mCallCount;
+	return S_OK;
+} // end Discontinuity function.
+
+//--- The buffer playing stops looping and plays on to its end.
+HRESULT NullSourceVoice::ExitLoop (UINT32 OperationSet)
+{
+	++mCallCount;
+	Advance ();
+	if (!mBuffers.empty()) {
+		mBuffers.front().LoopsLeft = 0;
+	}
+	return S_OK;
+} // end ExitLoop function.
+
+void NullSourceVoice::GetState (XAUDIO2_VOICE_STATE *pVoiceState)
+{
+	++mCallCount;
+	if (pVoiceState == NULL) return;
+	Advance ();
+	pVoiceState->pCurrentBufferContext = mBuffers.empty() ? NULL : mBuffers.front().Buffer.pContext;
+	pVoiceState->BuffersQueued = UINT32(mBuffers.size());
+	pVoiceState->SamplesPlayed = UINT64(mSamplesPlayed);
+} // end GetState function.
+
+HRESULT NullSourceVoice::SetFrequencyRatio (float Ratio, UINT32 OperationSet)
+{
+	++mCallCount;
+	if (mDetails.CreationFlags & XAUDIO2_VOICE_NOPITCH) return XAUDIO2_E_INVALID_CALL;
+	// The position so far was played at the old ratio.
+	Advance ();
+	mFrequencyRatio = std::max (XAUDIO2_MIN_FREQ_RATIO, std::min (Ratio, XAUDIO2_MAX_FREQ_RATIO));
+	return S_OK;
+} // end SetFrequencyRatio function.
+
+void NullSourceVoice::GetFrequencyRatio (float *pRatio)
+{
+	++mCallCount;
+	if (pRatio != NULL) *pRatio = mFrequencyRatio;
+} // end GetFrequencyRatio function.
+
+//--- As for XAudio2, the rate can only be changed while no buffers are queued.
+HRESULT NullSourceVoice::SetSourceSampleRate (UINT32 NewSourceSampleRate)
+{
+	++mCallCount;
+	if (!mBuffers.empty() || NewSourceSampleRate == 0) return XAUDIO2_E_INVALID_CALL;
+	mDetails.InputSampleRate = NewSourceSampleRate;
+	return S_OK;
+} // end SetSourceSampleRate function.
+
+//=== Private helpers.
+
+//--- Move the play position on by the time since it was last advanced.
+void NullSourceVoice::Advance ()
+{
+	mClock->Tick ();
+	if (!mRunning) return;
+
+	double samples = double(mClock->GetDeltaTime()) * mDetails.InputSampleRate * mFrequencyRatio;
+	while (samples > 0.0 && !mBuffers.empty()) {
+		QueuedBuffer &current = mBuffers.front();
+		bool looping = (current.LoopsLeft > 0);
+		double regionEnd = looping ? current.LoopEnd : current.PlayEnd;
+		double step = std::min (samples, regionEnd - mPosition);
+		if (step < 0.0) step = 0.0;
+		mPosition += step;
+		mSamplesPlayed += step;
+		samples -= step;
+		if (mPosition < regionEnd) break;
+
+		if (looping) {
+			// Back to the start of the loop region for another pass.
+			mPosition = current.Buffer.LoopBegin;
+			if (current.LoopsLeft != XAUDIO2_LOOP_INFINITE) --current.LoopsLeft;
+		}
+		else {
+			EndBuffer ();
+		}
+	}
+} // end Advance function.
+
+//--- Remove the buffer at the front of the queue and move to the start of the next one.
+void NullSourceVoice::EndBuffer ()
+{
+	if (mBuffers.front().Buffer.Flags & XAUDIO2_END_OF_STREAM) {
+		mSamplesPlayed = 0.0;
+	}
+	mBuffers.pop_front ();
+	mPosition = mBuffers.empty() ? 0.0 : mBuffers.front().Buffer.PlayBegin;
+} // end EndBuffer function.
+
+} // end Audio namespace.
+} // end AllanMilne namespace.
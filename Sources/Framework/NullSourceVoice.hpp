@@ -0,0 +1,139 @@
+/*
+	file:	NullSourceVoice.hpp
+	Version:	1.1
+	Date:	18th October 2026.
+	Author:	agent.
+
+	Namespace:	AllanMilne::Audio
+	Exposes:	NullSourceVoice.
+	Requires:	XAudio2, GameTimer.
+
+	Description:
+	A software stand-in for an XAudio2 source voice, created by XACore when it is using the null device,
+	so sounds can be created, played and queried without an audio device; no audio is rendered.
+
+	*	the voice implements the XAudio2 2.7 IXAudio2SourceVoice interface so the rest of the framework is unchanged;
+	*	playback is simulated on a GameTimer, so with GameTimer's simulated clock it is deterministic:
+		the play position advances by the elapsed time times the sample rate and frequency ratio,
+		submitted buffers are consumed in order, loop regions repeat LoopCount times (or until ExitLoop() is called),
+		and GetState() reports the buffers queued and samples played as XAudio2 would;
+	*	SubmitSourceBuffer() rejects the play and loop regions XAudio2 rejects, with XAUDIO2_E_INVALID_CALL: a PlayBegin
+		without a PlayLength, a region past the end of the audio, or a loop that is empty or not inside the play region;
+	*	volumes, output matrix, filter and effect settings are stored and returned but have no other effect;
+	*	operation sets are ignored - every change takes effect immediately;
+	*	DestroyVoice() deletes the object, as the engine would;
+	*	every call made to a voice through the XAudio2 interface is counted, so tests and benchmarks can see how often
+		the framework goes to the engine; GetCallCount() gives the calls made to all null voices since ResetCallCount().
+
+	Note that SamplesPlayed counts from the voice's creation and is only reset when a buffer marked XAUDIO2_END_OF_STREAM ends.
+
+*/
+
+#ifndef __NULLSOURCEVOICE_HPP__
+#define __NULLSOURCEVOICE_HPP__
+
+// system includes.
+#include <XAudio2.h>
+#include <deque>
+#include <vector>
+using std::deque;
+using std::vector;
+
+// forward declaration of non-namespaced component.
+class GameTimer;
+
+namespace AllanMilne {
+namespace Audio {
+
+class NullSourceVoice : public IXAudio2SourceVoice
+{
+public:
+
+	//--- Create a voice for the given format and XAudio2 voice creation flags.
+	NullSourceVoice (const WAVEFORMATEX &aFormat, const UINT32 aFlags);
+
+	//=== IXAudio2Voice methods.
+	STDMETHOD_(void, GetVoiceDetails) (XAUDIO2_VOICE_DETAILS *pVoiceDetails);
+	STDMETHOD(SetOutputVoices) (const XAUDIO2_VOICE_SENDS *pSendList);
+	STDMETHOD(SetEffectChain) (const XAUDIO2_EFFECT_CHAIN *pEffectChain);
+	STDMETHOD(EnableEffect) (UINT32 EffectIndex, UINT32 OperationSet);
+	STDMETHOD(DisableEffect) (UINT32 EffectIndex, UINT32 OperationSet);
+	STDMETHOD_(void, GetEffectState) (UINT32 EffectIndex, BOOL *pEnabled);
+	STDMETHOD(SetEffectParameters) (UINT32 EffectIndex, const void *pParameters, UINT32 ParametersByteSize, UINT32 OperationSet);
+	STDMETHOD(GetEffectParameters) (UINT32 EffectIndex, void *pParameters, UINT32 ParametersByteSize);
+	STDMETHOD(SetFilterParameters) (const XAUDIO2_FILTER_PARAMETERS *pParameters, UINT32 OperationSet);
+	STDMETHOD_(void, GetFilterParameters) (XAUDIO2_FILTER_PARAMETERS *pParameters);
+	STDMETHOD(SetOutputFilterParameters) (IXAudio2Voice *pDestinationVoice, const XAUDIO2_FILTER_PARAMETERS *pParameters, UINT32 OperationSet);
+	STDMETHOD_(void, GetOutputFilterParameters) (IXAudio2Voice *pDestinationVoice, XAUDIO2_FILTER_PARAMETERS *pParameters);
+	STDMETHOD(SetVolume) (float Volume, UINT32 OperationSet);
+	STDMETHOD_(void, GetVolume) (float *pVolume);
+	STDMETHOD(SetChannelVolumes) (UINT32 Channels, const float *pVolumes, UINT32 OperationSet);
+	STDMETHOD_(void, GetChannelVolumes) (UINT32 Channels, float *pVolumes);
+	STDMETHOD(SetOutputMatrix) (IXAudio2Voice *pDestinationVoice, UINT32 SourceChannels, UINT32 DestinationChannels, const float *pLevelMatrix, UINT32 OperationSet);
+	STDMETHOD_(void, GetOutputMatrix) (IXAudio2Voice *pDestinationVoice, UINT32 SourceChannels, UINT32 DestinationChannels, float *pLevelMatrix);
+	STDMETHOD_(void, DestroyVoice) ();
+
+	//=== IXAudio2SourceVoice methods.
+	STDMETHOD(Start) (UINT32 Flags, UINT32 OperationSet);
+	STDMETHOD(Stop) (UINT32 Flags, UINT32 OperationSet);
+	STDMETHOD(SubmitSourceBuffer) (const XAUDIO2_BUFFER *pBuffer, const XAUDIO2_BUFFER_WMA *pBufferWMA);
+	STDMETHOD(FlushSourceBuffers) ();
+	STDMETHOD(Discontinuity) ();
+	STDMETHOD(ExitLoop) (UINT32 OperationSet);
+	STDMETHOD_(void, GetState) (XAUDIO2_VOICE_STATE *pVoiceState);
+	STDMETHOD(SetFrequencyRatio) (float Ratio, UINT32 OperationSet);
+	STDMETHOD_(void, GetFrequencyRatio) (float *pRatio);
+	STDMETHOD(SetSourceSampleRate) (UINT32 NewSourceSampleRate);
+
+	//--- Number of interface calls made to all null voices since the count was last reset.
+	static inline unsigned long GetCallCount () { return mCallCount; }
+	static inline void ResetCallCount () { mCallCount = 0; }
+
+private:
+
+	//--- Only DestroyVoice() deletes the voice.
+	virtual ~NullSourceVoice ();
+
+	//--- A submitted buffer with its play and loop regions in samples.
+	struct QueuedBuffer {
+		XAUDIO2_BUFFER Buffer;
+		UINT32 PlayEnd;			// one past the last sample to play.
+		UINT32 LoopEnd;			// one past the last sample of the loop region.
+		UINT32 LoopsLeft;		// loops still to play; XAUDIO2_LOOP_INFINITE loops until ExitLoop().
+	};
+
+	//--- Move the play position on by the time since it was last advanced; called before any change to, or query of, the play state.
+	void Advance ();
+
+	//--- Remove the buffer at the front of the queue and move to the start of the next one.
+	void EndBuffer ();
+
+	XAUDIO2_VOICE_DETAILS mDetails;
+	UINT32 mBlockAlign;
+
+	// Playback state.
+	deque<QueuedBuffer> mBuffers;
+	bool mRunning;
+	double mPosition;			// samples into the front buffer.
+	double mSamplesPlayed;
+	float mFrequencyRatio;
+	GameTimer *mClock;
+
+	// Stored settings.
+	float mVolume;
+	vector<float> mChannelVolumes;
+	vector<float> mOutputMatrix;
+	UINT32 mMatrixDestinations;
+	XAUDIO2_FILTER_PARAMETERS mFilter;
+	XAUDIO2_FILTER_PARAMETERS mOutputFilter;
+	vector<BOOL> mEffectsEnabled;
+
+	// Interface calls made to all null voices.
+	static unsigned long mCallCount;
+
+}; // end NullSourceVoice class.
+
+} // end Audio namespace.
+} // end AllanMilne namespace.
+
+#endif
@@ -1,7 +1,7 @@
 /*
 	File:	PCMWave.cpp
-	Version:	2.2
-	Date:	20th March 2013; September 2012.
+	Version:	2.4
+	Date:	18th October 2026; 20th March 2013; September 2012.
 	Author:	Allan c. Milne.
 
 	Namespace:	AllanMilne::Audio
@@ -16,6 +16,9 @@
 
 #include <fstream>
 #include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
 using namespace std;
 
 #include "PCMWave.hpp"
@@ -31,6 +34,8 @@ namespace Audio {
 PCMWave::PCMWave (const string &aFilename, unsigned short aChannels, unsigned short aBitDepth, unsigned long aSampleRate, size_t aSize, char *aData)
 {
 	mFileName = aFilename;
+	mLoopBegin = 0;
+	mLoopLength = 0;
 	mWaveFormat.wFormatTag = 1;		// WAVE_FORMAT_PCM
 	mWaveFormat.nChannels = aChannels;
 	mWaveFormat.nSamplesPerSec = aSampleRate;
@@ -58,6 +63,8 @@ PCMWave::PCMWave (const string &aFilename)
 	mSize = 0;
 	mWaveData = NULL;
 	mStatus = Undefined;
+	mLoopBegin = 0;
+	mLoopLength = 0;
 
 	ifstream infile (aFilename, ios::binary);
 	if (!infile.good()) {
@@ -183,8 +190,9 @@ void PCMWave::ReadWaveFile (ifstream *anInfile)
 		return;
 	}
 	// read in format fields into WaveFmt struct.
+	// a block align of 0 would leave the data without frames, and every frame count a division by 0.
 	anInfile->read ((char*)&mWaveFormat, sizeof(WaveFmt));
-	if (!anInfile->good()) {
+	if (!anInfile->good() || mWaveFormat.nBlockAlign == 0) {
 		memset ((void*)&mWaveFormat, 0, sizeof (WaveFmt));
 		mStatus = InvalidFmt;
 		return;
@@ -211,8 +219,137 @@ void PCMWave::ReadWaveFile (ifstream *anInfile)
 	}
 	mSize = (size_t)chunkSize;
 	mStatus = OK;		// data chunk read without error. 
+	ReadMarkers (anInfile);
 } // end ReadWaveFile function.
 
+//--- anonymous namespace for the cue point ordering used when reading regions.
+namespace {
+	struct CuePoint {
+		unsigned long Id;
+		unsigned long Offset;
+	};
+	bool CueBefore (const CuePoint &aFirst, const CuePoint &aSecond)
+	{
+		return aFirst.Offset < aSecond.Offset;
+	}
+} // end anonymous namespace.
+
+//--- read the regions from the 'cue ' chunk and the 'labl'/'ltxt' chunks of a 'LIST' chunk of type 'adtl',
+//--- and the loop from the 'smpl' chunk.
+//--- Chunks are word aligned, so a chunk of odd size is followed by a pad byte.
+//--- Sizes read from the file are trusted only as far as the end of the file and of the chunk enclosing them.
+void PCMWave::ReadMarkers (ifstream *anInfile)
+{
+	unsigned long cueTag = ' euc';
+	unsigned long smplTag = 'lpms';
+	unsigned long listTag = 'TSIL';
+	unsigned long adtlTag = 'ltda';
+	unsigned long lablTag = 'lbal';
+	unsigned long ltxtTag = 'txtl';
+	if (mWaveFormat.nBlockAlign == 0) return;		// a malformed 'fmt ' chunk; the data has no frames to mark.
+	unsigned long frames = mSize / mWaveFormat.nBlockAlign;
+	vector<CuePoint> cues;
+	map<unsigned long, string> names;
+	map<unsigned long, unsigned long> lengths;
+
+	// walk the chunks after the RIFF header.
+	anInfile->clear ();
+	anInfile->seekg (0, ios::end);
+	const streamoff fileEnd = anInfile->tellg();
+	anInfile->seekg (12);
+	unsigned long header[2];
+	while (anInfile->read ((char*)header, 8)) {
+		streamoff chunkEnd = (streamoff)anInfile->tellg() + header[1] + (header[1] & 1);
+		if (chunkEnd > fileEnd) {
+			// a chunk running past the end of the file is cut short at it.
+			chunkEnd = fileEnd;
+			header[1] = (unsigned long)(fileEnd - anInfile->tellg());
+		}
+		if (header[0] == cueTag && header[1] >= 4) {
+			// cue point count, then 24 bytes per point: id, position, chunk id, chunk start, block start, sample offset.
+			unsigned long count = 0;
+			anInfile->read ((char*)&count, 4);
+			for (unsigned long i=0; i<count && (i+1)*24 <= header[1]-4; ++i) {
+				unsigned long point[6];
+				if (!anInfile->read ((char*)point, 24)) break;
+				CuePoint cue = { point[0], point[5] };
+				if (cue.Offset < frames) cues.push_back (cue);
+			}
+		}
+		else if (header[0] == smplTag && header[1] >= 36 + 24) {
+			// 36 bytes of sampler fields, the 8th of which is the loop count, then 24 bytes per loop:
+			// cue point id, type, first frame, last frame, fraction, play count.
+			unsigned long fields[9];
+			unsigned long loop[6];
+			if (anInfile->read ((char*)fields, 36) && fields[7] > 0 && anInfile->read ((char*)loop, 24)) {
+				if (loop[2] <= loop[3] && loop[3] < frames) {
+					mLoopBegin = loop[2];
+					mLoopLength = loop[3] - loop[2] + 1;
+				}
+			}
+		}
+		else if (header[0] == listTag && header[1] >= 4) {
+			unsigned long listType = 0;
+			anInfile->read ((char*)&listType, 4);
+			if (listType == adtlTag) {
+				// sub-chunks up to the end of the list; a sub-chunk running past it ends the list.
+				streamoff listEnd = (streamoff)anInfile->tellg() + header[1] - 4;
+				unsigned long sub[2];
+				while ((streamoff)anInfile->tellg() + 8 <= listEnd && anInfile->read ((char*)sub, 8)) {
+					if (sub[1] > listEnd - (streamoff)anInfile->tellg()) break;
+					streamoff subEnd = (streamoff)anInfile->tellg() + sub[1] + (sub[1] & 1);
+					if (sub[0] == lablTag && sub[1] > 4) {
+						// cue point id then a null terminated name.
+						unsigned long id = 0;
+						vector<char> text (sub[1] - 4 + 1, '\0');
+						if (anInfile->read ((char*)&id, 4) && anInfile->read (&text[0], sub[1] - 4)) {
+							names[id] = string (&text[0]);
+						}
+					}
+					else if (sub[0] == ltxtTag && sub[1] >= 8) {
+						// cue point id then the length of the region in frames.
+						unsigned long fields[2];
+						if (anInfile->read ((char*)fields, 8)) lengths[fields[0]] = fields[1];
+					}
+					anInfile->seekg (subEnd);
+				}
+			}
+		}
+		anInfile->seekg (chunkEnd);
+	}
+	anInfile->clear ();
+
+	// a region for each cue point; without a length it runs to the next cue point.
+	sort (cues.begin(), cues.end(), CueBefore);
+	for (size_t i=0; i<cues.size(); ++i) {
+		Region region;
+		region.Begin = cues[i].Offset;
+		region.Length = ((i+1 < cues.size()) ? cues[i+1].Offset : frames) - region.Begin;
+		map<unsigned long, unsigned long>::const_iterator length = lengths.find (cues[i].Id);
+		if (length != lengths.end() && length->second > 0) {
+			region.Length = (length->second < frames - region.Begin) ? length->second : frames - region.Begin;
+		}
+		map<unsigned long, string>::const_iterator name = names.find (cues[i].Id);
+		if (name != names.end()) region.Name = name->second;
+		if (region.Length > 0) mRegions.push_back (region);
+	}
+} // end ReadMarkers function.
+
+//--- Set the loop, if it is within the data; a length of 0 removes the loop.
+bool PCMWave::SetLoop (const unsigned long aBegin, const unsigned long aLength)
+{
+	if (aLength == 0) {
+		mLoopBegin = 0;
+		mLoopLength = 0;
+		return true;
+	}
+	unsigned long frames = (mWaveFormat.nBlockAlign > 0) ? mSize / mWaveFormat.nBlockAlign : 0;
+	if (aBegin >= frames || aLength > frames - aBegin) return false;
+	mLoopBegin = aBegin;
+	mLoopLength = aLength;
+	return true;
+} // end SetLoop function.
+
 //--- find the chunk with tag = supplied ID (as  packed 4 character tag); 
 //--- file is positioned after the tag; if not found then file position is undefined.
 bool PCMWave::FindChunk (ifstream *anInfile, unsigned long aTag)
@@ -244,9 +381,12 @@ bool PCMWave::FindChunk (ifstream *anInfile, unsigned long aTag)
 void PCMWave::WriteWaveFile (ofstream *anOutfile)
 {
 	unsigned long fields[3];		// use to create chunk header fields.
+	// a loop is written in a sampler chunk after the data, which is padded to a word boundary.
+	unsigned long pad = mSize & 1;
+	unsigned long smplSize = HasLoop() ? 8 + 36 + 24 : 0;
 	// write RIFF header fields.
 	fields[0] = 'FFIR';
-	fields[1] = mSize + 44;		// buffer size + chunk header fields + fmt chunk data.
+	fields[1] = mSize + 36 + pad + smplSize;		// 'WAVE' tag + fmt and data chunks + sampler chunk.
 	fields[2] = 'EVAW';
 	anOutfile->write ((char*)fields, 12);
 	if (!anOutfile->good()) {
@@ -275,16 +415,38 @@ void PCMWave::WriteWaveFile (ofstream *anOutfile)
 		return;
 	}
 	anOutfile->write (mWaveData, mSize);
+	if (pad > 0) anOutfile->put ('\0');
 	if (!anOutfile->good()) {
 		mStatus = DataWriteError;
 		return;
 	}
+	// write the sampler chunk: the sample period in nanoseconds, MIDI unity note 60 and one forward loop, all else 0.
+	if (HasLoop()) {
+		unsigned long smpl[2 + 9 + 6] = { 0 };
+		smpl[0] = 'lpms';
+		smpl[1] = 36 + 24;
+		smpl[2 + 2] = (mWaveFormat.nSamplesPerSec > 0) ? 1000000000 / mWaveFormat.nSamplesPerSec : 0;
+		smpl[2 + 3] = 60;
+		smpl[2 + 7] = 1;
+		smpl[11 + 2] = mLoopBegin;
+		smpl[11 + 3] = mLoopBegin + mLoopLength - 1;
+		anOutfile->write ((char*)smpl, sizeof(smpl));
+		if (!anOutfile->good()) {
+			mStatus = DataWriteError;
+			return;
+		}
+	}
 	mStatus = OK;		// all write operations succeeded.
 } // end WriteWaveFile function.
 
 /* Version history.
 === 2.2
 Removed checks for NULL before calls to delete since delete works ok for null references.
+=== 2.3
+Reads named regions of the sample data from the cue points and associated data list of a .wav file.
+=== 2.4
+Reads the loop of a .wav file's sampler chunk and writes it when saving; the loop can be set through SetLoop().
+The RIFF chunk size written no longer counts the 8 bytes of the RIFF header.
 */
 
 } // end Audio namespace.
@@ -1,7 +1,7 @@
 /*
 	File:	PCMWave.hpp
-	Version:	2.1
-	Date:	21st September 2012.
+	Version:	2.4
+	Date:	18th October 2026; 21st September 2012.
 	Authors:	Allan & stuart Milne.
 
 	Namespace:	AllanMilne::Audio
@@ -31,6 +31,16 @@
 
 	A PCMWave object can also be saved to a file in .wav format.
 
+	A .wav file can name regions of its sample data, as a sound sheet does to hold many short sounds in one buffer (see SoundSheet.hpp).
+	The regions are read from the cue points of the 'cue ' chunk, named by the 'labl' chunks of a 'LIST' chunk of type 'adtl'
+	and given lengths by its 'ltxt' chunks; a cue point without a length runs to the next cue point or the end of the data.
+	Regions are in sample frames from the start of the data; they are not written when the object is saved.
+
+	A .wav file can also mark a loop in the 'smpl' chunk, so that a sound looped by XASound plays the frames before the loop
+	once as an intro and then repeats the loop, rather than repeating the whole of a long recording.
+	Only the first loop of the chunk is read, and it is played forwards whatever its type; its end is inclusive in the chunk.
+	The loop can also be set by the client (see LoopFinder.hpp) and is written in a 'smpl' chunk when the object is saved.
+
 	The object also exposes a status attribute that indicates if an error was detected when instantiating the object;
 	possible values for this attribute are exposed as an enum in the interface.
 
@@ -43,7 +53,9 @@
 // system includes.
 #include <fstream>
 #include <string>
+#include <vector>
 using std::string;
+using std::vector;
 using std::ifstream;
 using std::ofstream;
 
@@ -92,12 +104,34 @@ public:
 	// return PCM wave status value as a string.
 	string& GetStatusDescription () const;
 
+	//--- A named region of the sample data; Begin and Length are in sample frames.
+	struct Region {
+		string Name;
+		unsigned long Begin;
+		unsigned long Length;
+	};
+
+	// The regions read from the .wav file, in the order of their cue points in the data; none if the file has no cue points.
+	inline size_t GetRegionCount () const { return mRegions.size(); }
+	inline const Region& GetRegion (const size_t anIndex) const { return mRegions[anIndex]; }
+
+	// The loop read from the .wav file, in sample frames from the start of the data; the length is 0 if there is no loop.
+	inline bool HasLoop () const { return mLoopLength > 0; }
+	inline unsigned long GetLoopBegin () const { return mLoopBegin; }
+	inline unsigned long GetLoopLength () const { return mLoopLength; }
+
+	// Set the loop; returns false, leaving the loop unchanged, if it is not within the data. A length of 0 removes the loop.
+	bool SetLoop (const unsigned long aBegin, const unsigned long aLength);
+
 private:
 	string mFileName;		// file name of this sound sample.
 	WaveFmt mWaveFormat;		// the wave format attributes.
 	size_t mSize;			// number of bytes of sample data.
 	char *mWaveData;		// Pointer to the sample sound data buffer.
 	Status mStatus;	// indicates status of this object.
+	vector<Region> mRegions;		// named regions of the sample data.
+	unsigned long mLoopBegin;		// first frame of the loop.
+	unsigned long mLoopLength;		// frames in the loop; 0 if there is none.
 
 	//--- .wav file I/O helper functions.
 
@@ -108,6 +142,10 @@ private:
 	// file is positioned after the tag; if not found then file position is undefined.
 	bool FindChunk (ifstream *anInFile, unsigned long aTag);
 
+	// read the regions from the cue points and associated data list, and the loop from the sampler chunk, if the file has them;
+	// errors leave no regions or loop.
+	void ReadMarkers (ifstream *anInfile);
+
 	// Write .wav file with the state of this object.
 	void WriteWaveFile (ofstream *anOutfile);
 
@@ -0,0 +1,274 @@
+/*
+	file:	Profiler.cpp
+	Version:	1.0
+	Date:	18th October 2026.
+	Author:	agent.
+
+	Namespace:	AllanMilne
+	Exposes:	ProfileHistogram, Profiler and ScopedTimer implementation.
+	Requires:	GameTimer.
+
+	Description:
+	Lightweight instrumentation measuring how long named scopes of code take to run.
+	this is the implementation file - see Profiler.hpp for details.
+
+*/
+
+// system includes.
+#include <windows.h>
+#include <cstring>
+#include <ostream>
+#include <iomanip>
+using std::ostream;
+using std::endl;
+using std::setw;
+using std::left;
+using std::right;
+using std::fixed;
+using std::setprecision;
+
+// framework includes.
+#include "GameTimer.h"
+#include "Profiler.hpp"
+
+namespace AllanMilne {
+
+//=== ProfileHistogram.
+
+ProfileHistogram::ProfileHistogram ()
+{
+	Reset();
+} // end ProfileHistogram constructor.
+
+//--- Add a duration; each field is updated with an interlocked operation so no lock is needed.
+void ProfileHistogram::Record (const ULONGLONG aNanoseconds)
+{
+	InterlockedIncrement64 (&mBuckets[BucketIndex (aNanoseconds)]);
+	InterlockedIncrement64 (&mCount);
+	// Raise the maximum unless another thread has already raised it past this duration.
+	LONGLONG value = (LONGLONG)aNanoseconds;
+	LONGLONG oldMax = mMax;
+	while (value > oldMax) {
+		LONGLONG seen = InterlockedCompareExchange64 (&mMax, value, oldMax);
+		if (seen == oldMax) break;
+		oldMax = seen;
+	}
+} // end Record function.
+
+//--- Remove all recorded durations.
+void ProfileHistogram::Reset ()
+{
+	for (int i=0; i<BucketCount; ++i) {
+		mBuckets[i] = 0;
+	}
+	mCount = 0;
+	mMax = 0;
+} // end Reset function.
+
+//--- The duration that the given percentage of durations are no longer than.
+ULONGLONG ProfileHistogram::GetValueAtPercentile (const double aPercentile) const
+{
+	ULONGLONG count = GetCount();
+	if (count == 0) return 0;
+
+	// The rank of the wanted duration, counting from 1.
+	ULONGLONG rank = (ULONGLONG)(aPercentile / 100.0 * (double)count + 0.5);
+	if (rank < 1) rank = 1;
+	if (rank > count) rank = count;
+
+	ULONGLONG seen = 0;
+	for (int i=0; i<BucketCount; ++i) {
+		seen += (ULONGLONG)mBuckets[i];
+		if (seen >= rank) {
+			ULONGLONG top = BucketTop (i);
+			return (top < GetMax()) ? top : GetMax();
+		}
+	}
+	return GetMax();
+} // end GetValueAtPercentile function.
+
+//--- The bucket a duration is counted in; the top SubBucketBits bits of the duration select the bucket.
+int ProfileHistogram::BucketIndex (const ULONGLONG aNanoseconds)
+{
+	const ULONGLONG exactLimit = 1ULL << SubBucketBits;
+	if (aNanoseconds < exactLimit) return (int)aNanoseconds;
+
+	// Shift the duration down until only its top SubBucketBits bits are left, between exactLimit/2 and exactLimit.
+	int shift = 0;
+	ULONGLONG mantissa = aNanoseconds;
+	while (mantissa >= exactLimit) {
+		mantissa >>= 1;
+		++shift;
+	}
+	int index = shift * (int)(exactLimit / 2) + (int)mantissa;
+	return (index < BucketCount) ? index : BucketCount - 1;
+} // end BucketIndex function.
+
+//--- The longest duration counted in a bucket.
+ULONGLONG ProfileHistogram::BucketTop (const int anIndex)
+{
+	const int halfLimit = 1 << (SubBucketBits - 1);
+	if (anIndex < 2 * halfLimit) return (ULONGLONG)anIndex;
+	int shift = anIndex / halfLimit - 1;
+	ULONGLONG mantissa = (ULONGLONG)(anIndex % halfLimit + halfLimit);
+	return ((mantissa + 1) << shift) - 1;
+} // end BucketTop function.
+
+//=== Profiler.
+
+	//--- Initialise the static instance field and the calling thread's buffer.
+	Profiler *Profiler::mInstance = NULL;
+	__declspec(thread) Profiler::ThreadBuffer *Profiler::mThreadBuffer = NULL;
+
+//--- Get the singleton instance - use lazy evaluation.
+Profiler& Profiler::GetInstance ()
+{
+	// Instance already created so return it.
+	if (mInstance) { return *mInstance; }
+	// First time called so instantiate the object.
+	mInstance = new Profiler ();
+	return *mInstance;
+} // end static GetInstance function.
+
+//--- Delete the profiler instance; other threads must have stopped recording.
+void Profiler::DeleteInstance ()
+{
+	delete mInstance;
+	mInstance = NULL;
+	mThreadBuffer = NULL;
+} // end static DeleteInstance function.
+
+Profiler::Profiler ()
+	: mScopeCount (0), mBuffers (NULL)
+{
+	InitializeCriticalSection (&mLock);
+	mNanosecondsPerCount = GameTimer::GetSecondsPerPerformanceCount() * 1.0e9;
+	for (int i=0; i<MaxScopes; ++i) {
+		mScopeNames[i] = NULL;
+		mHistograms[i] = NULL;
+	}
+} // end Profiler constructor.
+
+Profiler::~Profiler ()
+{
+	for (int i=0; i<MaxScopes; ++i) {
+		delete mHistograms[i];
+	}
+	while (mBuffers != NULL) {
+		ThreadBuffer *next = mBuffers->Next;
+		delete mBuffers;
+		mBuffers = next;
+	}
+	DeleteCriticalSection (&mLock);
+} // end Profiler destructor.
+
+//--- Get the index of the scope with this name, registering it if it is new.
+int Profiler::RegisterScope (const char *aName)
+{
+	EnterCriticalSection (&mLock);
+	int scope = -1;
+	for (int i=0; i<mScopeCount; ++i) {
+		if (strcmp (mScopeNames[i], aName) == 0) {
+			scope = i;
+			break;
+		}
+	}
+	if (scope < 0 && mScopeCount < MaxScopes) {
+		// Fill in the scope before it is counted, so threads reading the scopes without the lock never see it half made.
+		scope = mScopeCount;
+		mScopeNames[scope] = aName;
+		mHistograms[scope] = new ProfileHistogram ();
+		InterlockedIncrement (&mScopeCount);
+	}
+	LeaveCriticalSection (&mLock);
+	return scope;
+} // end RegisterScope function.
+
+//--- Add a duration to the calling thread's buffer.
+void Profiler::AddSample (const int aScope, const LONGLONG aCounts)
+{
+	if (aScope < 0) return;
+	ThreadBuffer *buffer = GetThreadBuffer();
+	Sample &sample = buffer->Samples[buffer->Used];
+	sample.Scope = aScope;
+	sample.Counts = aCounts;
+	if (++buffer->Used == SamplesPerBuffer) {
+		Flush (*buffer);
+	}
+} // end AddSample function.
+
+//--- Add the samples in the calling thread's buffer to the histograms.
+void Profiler::FlushThread ()
+{
+	if (mThreadBuffer != NULL) {
+		Flush (*mThreadBuffer);
+	}
+} // end FlushThread function.
+
+//--- Write the count, p50, p99 and max of every scope that has samples.
+void Profiler::WriteReport (ostream &aReport)
+{
+	FlushThread();
+	aReport << left << setw(32) << "scope" << right << setw(10) << "count"
+			<< setw(12) << "p50 (us)" << setw(12) << "p99 (us)" << setw(12) << "max (us)" << endl;
+	aReport << fixed << setprecision(2);
+	for (int i=0; i<mScopeCount; ++i) {
+		const ProfileHistogram &histogram = *mHistograms[i];
+		if (histogram.GetCount() == 0) continue;
+		aReport << left << setw(32) << mScopeNames[i] << right << setw(10) << histogram.GetCount()
+				<< setw(12) << histogram.GetValueAtPercentile(50.0) / 1000.0
+				<< setw(12) << histogram.GetValueAtPercentile(99.0) / 1000.0
+				<< setw(12) << histogram.GetMax() / 1000.0 << endl;
+	}
+} // end WriteReport function.
+
+//--- Clear every scope's histogram.
+void Profiler::Reset ()
+{
+	FlushThread();
+	for (int i=0; i<mScopeCount; ++i) {
+		mHistograms[i]->Reset();
+	}
+} // end Reset function.
+
+//--- Get the calling thread's buffer, creating it on the thread's first sample.
+Profiler::ThreadBuffer* Profiler::GetThreadBuffer ()
+{
+	if (mThreadBuffer != NULL) return mThreadBuffer;
+	mThreadBuffer = new ThreadBuffer ();
+	mThreadBuffer->Used = 0;
+	EnterCriticalSection (&mLock);
+	mThreadBuffer->Next = mBuffers;
+	mBuffers = mThreadBuffer;
+	LeaveCriticalSection (&mLock);
+	return mThreadBuffer;
+} // end GetThreadBuffer function.
+
+//--- Add a buffer's samples to the histograms and empty it.
+void Profiler::Flush (ThreadBuffer &aBuffer)
+{
+	for (int i=0; i<aBuffer.Used; ++i) {
+		const Sample &sample = aBuffer.Samples[i];
+		LONGLONG counts = (sample.Counts > 0) ? sample.Counts : 0;
+		mHistograms[sample.Scope]->Record ((ULONGLONG)((double)counts * mNanosecondsPerCount));
+	}
+	aBuffer.Used = 0;
+} // end Flush function.
+
+//=== ScopedTimer.
+
+//--- Start timing; the scope is not timed if it could not be registered.
+ScopedTimer::ScopedTimer (const int aScope)
+	: mScope (aScope), mStart (GameTimer::ReadPerformanceCounter())
+{
+} // end ScopedTimer constructor.
+
+//--- Stop timing and add the duration to the profiler.
+ScopedTimer::~ScopedTimer ()
+{
+	if (mScope < 0) return;
+	LONGLONG counts = GameTimer::ReadPerformanceCounter() - mStart;
+	Profiler::GetInstance().AddSample (mScope, counts);
+} // end ScopedTimer destructor.
+
+} // end AllanMilne namespace.
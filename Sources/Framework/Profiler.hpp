@@ -0,0 +1,188 @@
+/*
+	file:	Profiler.hpp
+	Version:	1.0
+	Date:	18th October 2026.
+	Author:	agent.
+
+	Namespace:	AllanMilne
+	Exposes:	ProfileHistogram, Profiler, ScopedTimer, PROFILE_SCOPE.
+	Requires:	GameTimer.
+
+	Description:
+	Lightweight instrumentation measuring how long named scopes of code take to run.
+
+	*	PROFILE_SCOPE("name") at the start of a block times the rest of the block with a ScopedTimer;
+		the scope name is registered once, the first time the block is run;
+	*	the time is read from the performance counter through GameTimer, bypassing its simulated clock,
+		so the times are real even in a headless run;
+	*	each thread writes its samples into its own buffer, with no locking; when the buffer is full the thread
+		adds the samples to the scopes' histograms using interlocked operations, so threads never wait on each other;
+	*	the histograms are log-linear like HdrHistogram: values below 32ns are exact, and above that each power of two
+		is split into 16 buckets, so every value is held to within about 6%;
+	*	WriteReport() writes the count, p50, p99 and max of every scope, in microseconds.
+		Samples still in another thread's buffer are not included until that thread fills its buffer or calls FlushThread().
+
+	Profiling is compiled in to debug builds, or any build with PROFILING defined; otherwise PROFILE_SCOPE expands to nothing
+	and PROFILING_ENABLED is not defined, so code using the Profiler directly should test it.
+
+	Exposed and implemented as a singleton pattern.
+
+*/
+
+#ifndef __PROFILER_HPP__
+#define __PROFILER_HPP__
+
+// system includes.
+#include <windows.h>
+#include <ostream>
+using std::ostream;
+
+//--- Profiling is in debug builds, and in release builds only if asked for.
+#if !defined(NDEBUG) || defined(PROFILING)
+#define PROFILING_ENABLED
+#endif
+
+namespace AllanMilne {
+
+//--- Histogram of durations in nanoseconds; Record() may be called from any thread.
+class ProfileHistogram
+{
+public:
+	ProfileHistogram ();
+
+	//--- Add a duration; lock free.
+	void Record (const ULONGLONG aNanoseconds);
+
+	//--- Remove all recorded durations; not safe while other threads are recording.
+	void Reset ();
+
+	//--- Number of durations recorded and the longest, in nanoseconds.
+	inline ULONGLONG GetCount () const { return (ULONGLONG)mCount; }
+	inline ULONGLONG GetMax () const { return (ULONGLONG)mMax; }
+
+	//--- The duration, in nanoseconds, that the given percentage of durations are no longer than;
+	//--- reported as the top of the bucket it falls in, but never more than the longest duration.
+	ULONGLONG GetValueAtPercentile (const double aPercentile) const;
+
+	//--- Values below 2^SubBucketBits are held exactly; each power of two above is split into 2^(SubBucketBits-1) buckets.
+	static const int SubBucketBits = 5;
+	//--- Enough buckets for durations up to 2^43ns (over two hours); longer durations are put in the last bucket.
+	static const int BucketCount = 640;
+
+	//--- Conversions between a duration and its bucket.
+	static int BucketIndex (const ULONGLONG aNanoseconds);
+	static ULONGLONG BucketTop (const int anIndex);
+
+private:
+	volatile LONGLONG mBuckets[BucketCount];
+	volatile LONGLONG mCount;
+	volatile LONGLONG mMax;
+
+}; // end ProfileHistogram class.
+
+class Profiler
+{
+public:
+
+	//--- Get the singleton instance - use lazy evaluation.
+	static Profiler& GetInstance ();
+
+	//--- Delete the profiler instance and all threads' sample buffers.
+	static void DeleteInstance ();
+
+	//--- Get the index of the scope with this name, registering it if it is new.
+	//--- The name must last as long as the profiler; a string literal is expected.
+	int RegisterScope (const char *aName);
+
+	//--- Add a duration, in performance counter counts, to the calling thread's buffer; adds the buffer to the histograms when it is full.
+	void AddSample (const int aScope, const LONGLONG aCounts);
+
+	//--- Add the samples in the calling thread's buffer to the histograms.
+	void FlushThread ();
+
+	//--- Write the count, p50, p99 and max of every scope that has samples; flushes the calling thread first.
+	void WriteReport (ostream &aReport);
+
+	//--- Clear every scope's histogram; flushes the calling thread first.
+	void Reset ();
+
+	//--- Most scopes that can be registered; later scopes are given the index -1 and not timed.
+	static const int MaxScopes = 64;
+	//--- Samples a thread buffers before adding them to the histograms.
+	static const int SamplesPerBuffer = 256;
+
+private:
+	// the singleton instance.
+	static Profiler *mInstance;
+
+	// Constructor & destructor are hidden to implement singleton patern.
+	Profiler ();
+	~Profiler ();
+
+	// One timed run of a scope.
+	struct Sample {
+		int Scope;
+		LONGLONG Counts;
+	};
+
+	// A thread's samples waiting to be added to the histograms; buffers are kept in a list so they can be deleted.
+	struct ThreadBuffer {
+		Sample Samples[SamplesPerBuffer];
+		int Used;
+		ThreadBuffer *Next;
+	};
+
+	// Get the calling thread's buffer, creating it on the thread's first sample.
+	ThreadBuffer* GetThreadBuffer ();
+
+	// The calling thread's buffer; NULL until the thread's first sample.
+	static __declspec(thread) ThreadBuffer *mThreadBuffer;
+
+	// Add a buffer's samples to the histograms and empty it.
+	void Flush (ThreadBuffer &aBuffer);
+
+	// Registered scopes; mScopeCount is only increased once a scope is complete.
+	const char *mScopeNames[MaxScopes];
+	ProfileHistogram *mHistograms[MaxScopes];
+	volatile LONG mScopeCount;
+
+	// Every thread's buffer; the lock is only taken to register a scope or add a thread.
+	ThreadBuffer *mBuffers;
+	CRITICAL_SECTION mLock;
+
+	// Nanoseconds in a performance counter count.
+	double mNanosecondsPerCount;
+
+}; // end Profiler class.
+
+//--- Times the block it is declared in, from its construction to its destruction.
+class ScopedTimer
+{
+public:
+	explicit ScopedTimer (const int aScope);
+	~ScopedTimer ();
+
+private:
+	int mScope;
+	LONGLONG mStart;
+
+	// Not copyable.
+	ScopedTimer (const ScopedTimer&);
+	ScopedTimer& operator= (const ScopedTimer&);
+
+}; // end ScopedTimer class.
+
+} // end AllanMilne namespace.
+
+//--- Time the rest of the enclosing block under the given scope name; nothing when profiling is compiled out.
+#ifdef PROFILING_ENABLED
+#define PROFILE_CONCAT_NAME(aPrefix, aLine) aPrefix##aLine
+#define PROFILE_UNIQUE_NAME(aPrefix, aLine) PROFILE_CONCAT_NAME(aPrefix, aLine)
+#define PROFILE_SCOPE(aName) \
+	static const int PROFILE_UNIQUE_NAME(profileScope, __LINE__) = AllanMilne::Profiler::GetInstance().RegisterScope(aName); \
+	AllanMilne::ScopedTimer PROFILE_UNIQUE_NAME(profileTimer, __LINE__) (PROFILE_UNIQUE_NAME(profileScope, __LINE__))
+#else
+#define PROFILE_SCOPE(aName)
+#endif
+
+#endif
@@ -0,0 +1,125 @@
+/*
+	file:	SoundSheet.cpp
+	Version:	1.0
+	Date:	18th October 2026.
+	Author:	agent.
+
+	Namespace:	AllanMilne::Audio
+	Exposes:	SoundSheet implementation.
+	Requires:	XASound, PCMWave, WaveFileManager.
+
+	Description:
+	Named regions of one .wav file played on a pool of voices.
+	this is the implementation file - see SoundSheet.hpp for details.
+
+*/
+
+// system includes.
+#include <XAudio2.h>
+#include <string>
+#include <vector>
+using std::string;
+using std::vector;
+
+// framework includes.
+#include "SoundSheet.hpp"
+#include "XASound.hpp"
+#include "PCMWave.hpp"
+#include "WaveFileManager.hpp"
+
+namespace AllanMilne {
+namespace Audio {
+
+//--- Load the sheet from a .wav file and create a pool of voices for it.
+SoundSheet::SoundSheet (const string &aFileName, const UINT32 aVoices, const bool filtered)
+	: mWave(NULL), mValid(false), mClock(0)
+{
+	mWave = WaveFileManager::GetInstance().LoadWave (aFileName);
+	if (mWave == NULL || mWave->GetStatus() != PCMWave::OK || mWave->GetRegionCount() == 0 || aVoices == 0) return;
+	for (UINT32 i=0; i<aVoices; ++i) {
+		XASound *voice = new XASound (mWave, filtered);
+		mVoices.push_back (voice);
+		mVoiceUsed.push_back (0);
+		if (!voice->IsValid()) return;
+	}
+	mValid = true;
+} // end constructor.
+
+//--- The wave is the WaveFileManager's, so only the voices are deleted.
+SoundSheet::~SoundSheet ()
+{
+	for (size_t i=0; i<mVoices.size(); ++i) {
+		if (mVoices[i]->IsValid()) mVoices[i]->Stop();
+		delete mVoices[i];
+	}
+	mVoices.clear();
+} // end destructor.
+
+size_t SoundSheet::GetRegionCount () const
+{
+	return (mWave != NULL) ? mWave->GetRegionCount() : 0;
+} // end GetRegionCount function.
+
+//--- The index of the region with the given name; -1 if there is none.
+int SoundSheet::FindRegion (const string &aName) const
+{
+	for (size_t i=0; i<GetRegionCount(); ++i) {
+		if (mWave->GetRegion(i).Name == aName) return int(i);
+	}
+	return -1;
+} // end FindRegion function.
+
+//--- The length of a region in seconds; 0 if there is no such region.
+float SoundSheet::GetRegionDuration (const int aRegion) const
+{
+	if (aRegion < 0 || size_t(aRegion) >= GetRegionCount() || mWave->GetWaveFormat().nSamplesPerSec == 0) return 0.0f;
+	return float(mWave->GetRegion(aRegion).Length) / float(mWave->GetWaveFormat().nSamplesPerSec);
+} // end GetRegionDuration function.
+
+//--- A voice that is not playing, or the one given out longest ago, stopped and set to play the region.
+XASound* SoundSheet::GetVoice (const int aRegion)
+{
+	if (!mValid || aRegion < 0 || size_t(aRegion) >= GetRegionCount()) return NULL;
+	size_t chosen = 0;
+	for (size_t i=0; i<mVoices.size(); ++i) {
+		if (!mVoices[i]->IsPlaying() && !mVoices[i]->IsPaused()) {
+			chosen = i;
+			break;
+		}
+		if (mVoiceUsed[i] < mVoiceUsed[chosen]) chosen = i;
+	}
+	XASound *voice = mVoices[chosen];
+	voice->Stop();
+	const PCMWave::Region &region = mWave->GetRegion (aRegion);
+	voice->SetPlayRegion (region.Begin, region.Length);
+	mVoiceUsed[chosen] = ++mClock;
+	return voice;
+} // end GetVoice function.
+
+//--- Play a region on a voice, returning the voice; NULL if it could not be played.
+XASound* SoundSheet::Play (const int aRegion)
+{
+	XASound *voice = GetVoice (aRegion);
+	if (voice != NULL) voice->Play();
+	return voice;
+} // end Play function.
+
+//--- True if any of the voices is playing.
+bool SoundSheet::IsPlaying () const
+{
+	for (size_t i=0; i<mVoices.size(); ++i) {
+		if (mVoices[i]->IsPlaying()) return true;
+	}
+	return false;
+} // end IsPlaying function.
+
+//--- Stop all of the voices.
+void SoundSheet::Stop ()
+{
+	for (size_t i=0; i<mVoices.size(); ++i) {
+		if (mVoices[i]->IsValid()) mVoices[i]->Stop();
+	}
+} // end Stop function.
+
+} // end Audio namespace.
+} // end AllanMilne namespace.
@@ -0,0 +1,90 @@
+/*
+	file:	SoundSheet.hpp
+	Version:	1.0
+	Date:	18th October 2026.
+	Author:	agent.
+
+	Namespace:	AllanMilne::Audio
+	Exposes:	SoundSheet.
+	Requires:	XASound, PCMWave, WaveFileManager.
+
+	Description:
+	Many short sounds held as named regions of one .wav file - a sound sheet - and played on a small pool of voices.
+	A client with several variants of a sound (footsteps, pain cries, ...) loads one file into one buffer and creates a voice
+	for each sound that can play at once, rather than a file, a buffer and a voice for every variant.
+
+	*	the regions are those of the file's PCMWave, read from its cue points and associated data list (see PCMWave.hpp);
+		the wave is loaded through the WaveFileManager so it is shared with any other sound of the same file;
+	*	the voices are XASounds of the wave, each set to play a region through XASound::SetPlayRegion();
+	*	GetVoice() gives a voice that is not playing set to a region, or if all are playing the one that started longest ago,
+		stopped; the client can set it up before playing it, e.g. hand it to an Emitter. Play() does this and plays it;
+	*	a voice stays the client's until the sheet gives it out again, so it should be used for one play of its region.
+
+	All the sounds of a sheet have the same format, that of the file.
+*/
+
+#ifndef __SOUNDSHEET_HPP__
+#define __SOUNDSHEET_HPP__
+
+// system includes.
+#include <XAudio2.h>
+#include <string>
+#include <vector>
+using std::string;
+using std::vector;
+
+namespace AllanMilne {
+namespace Audio {
+
+// forward declarations.
+	class XASound;
+	class PCMWave;
+
+class SoundSheet
+{
+public:
+
+	//--- Load the sheet from a .wav file and create a pool of voices for it, filtered if asked for.
+	SoundSheet (const string &aFileName, const UINT32 aVoices, const bool filtered=false);
+	~SoundSheet ();
+
+	//--- False if the file could not be loaded, has no regions, or a voice could not be created.
+	inline bool IsValid () const { return mValid; }
+
+	inline PCMWave* GetWave () const { return mWave; }
+	inline size_t GetVoiceCount () const { return mVoices.size(); }
+	size_t GetRegionCount () const;
+
+	//--- The index of the region with the given name; -1 if there is none.
+	int FindRegion (const string &aName) const;
+
+	//--- The length of a region in seconds; 0 if there is no such region.
+	float GetRegionDuration (const int aRegion) const;
+
+	//--- A stopped voice set to play a region; NULL if the sheet is not valid or there is no such region.
+	XASound* GetVoice (const int aRegion);
+
+	//--- Play a region on a voice, returning the voice; NULL if it could not be played.
+	XASound* Play (const int aRegion);
+
+	//--- True if any of the voices is playing.
+	bool IsPlaying () const;
+
+	//--- Stop all of the voices.
+	void Stop ();
+
+private:
+	PCMWave *mWave;
+	bool mValid;
+
+	// The voices, and the order they were given out in; the voice with the lowest count is taken when all are playing.
+	vector<XASound*> mVoices;
+	vector<unsigned long> mVoiceUsed;
+	unsigned long mClock;
+
+}; // end SoundSheet class.
+
+} // end Audio namespace.
+} // end AllanMilne namespace.
+
+#endif
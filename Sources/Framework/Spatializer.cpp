@@ -0,0 +1,257 @@
+/*
+	file:	Spatializer.cpp
+	Version:	1.1
+	Date:	18th October 2026.
+	Author:	agent.
+
+	Namespace:	AllanMilne::Audio
+	Exposes:	Spatializer implementation.
+	Requires:	X3DAudio (for its structures only), stu::v3f batch math.
+
+	Description:
+	A portable, batched stand-in for X3DAudioCalculate's output matrix.
+	this is the implementation file - see Spatializer.hpp for details.
+
+*/
+
+// system includes.
+#include <XAudio2.h>
+#include <X3DAudio.h>
+#include <math.h>
+#include <vector>
+#include <algorithm>
+using std::vector;
+
+// framework includes.
+#include "Spatializer.hpp"
+#include "StuVector3Batch.hpp"
+
+namespace AllanMilne {
+namespace Audio {
+
+namespace {
+
+	//--- The emitters worked on together; the structure of arrays is padded to a multiple of this.
+	const size_t PackSize = 8;
+
+	//--- The most speakers of a channel mask the spatializer places.
+	const UINT32 MaxSpeakers = 11;
+
+	//--- The azimuths of the speakers, clockwise from the front, in the order of their bits in a channel mask;
+	//--- a negative azimuth marks the LFE speaker.
+	const UINT32 SpeakerBits[MaxSpeakers] = {
+		SPEAKER_FRONT_LEFT, SPEAKER_FRONT_RIGHT, SPEAKER_FRONT_CENTER, SPEAKER_LOW_FREQUENCY, SPEAKER_BACK_LEFT, SPEAKER_BACK_RIGHT,
+		SPEAKER_FRONT_LEFT_OF_CENTER, SPEAKER_FRONT_RIGHT_OF_CENTER, SPEAKER_BACK_CENTER, SPEAKER_SIDE_LEFT, SPEAKER_SIDE_RIGHT
+	};
+	const float SpeakerAzimuths[MaxSpeakers] = {
+		7.0f * X3DAUDIO_PI / 4.0f, X3DAUDIO_PI / 4.0f, 0.0f, -1.0f, 5.0f * X3DAUDIO_PI / 4.0f, 3.0f * X3DAUDIO_PI / 4.0f,
+		15.0f * X3DAUDIO_PI / 8.0f, X3DAUDIO_PI / 8.0f, X3DAUDIO_PI, 3.0f * X3DAUDIO_PI / 2.0f, X3DAUDIO_PI / 2.0f
+	};
+
+	//--- The level of a curve at a scaled distance; beyond the last point the curve keeps its last level.
+	float EvaluateCurve (const X3DAUDIO_DISTANCE_CURVE &aCurve, const float aDistance)
+	{
+		const X3DAUDIO_DISTANCE_CURVE_POINT *points = aCurve.pPoints;
+		if (aCurve.PointCount == 0) return 1.0f;
+		if (aDistance <= points[0].Distance) return points[0].DSPSetting;
+		for (UINT32 i = 1; i < aCurve.PointCount; ++i) {
+			if (aDistance < points[i].Distance) {
+				const float fraction = (aDistance - points[i-1].Distance) / (points[i].Distance - points[i-1].Distance);
+				return points[i-1].DSPSetting + fraction * (points[i].DSPSetting - points[i-1].DSPSetting);
+			}
+		}
+		return points[aCurve.PointCount - 1].DSPSetting;
+	} // end EvaluateCurve function.
+
+	//--- Resize an array of the batch to the padded count, zeroing the padding.
+	inline float *Prepare (vector<float> &anArray, const size_t count, const size_t padded)
+	{
+		anArray.resize (padded);
+		std::fill (anArray.begin() + count, anArray.end(), 0.0f);
+		return &anArray[0];
+	} // end Prepare function.
+
+} // end anonymous namespace.
+
+//--- Set up for the speakers of a channel mask, e.g. the device's SPEAKER_STEREO.
+Spatializer::Spatializer (const UINT32 aChannelMask)
+	: mChannelCount(0), mValid(true), mLFEChannel(-1)
+{
+	UINT32 known = 0;
+	vector<std::pair<float, UINT32> > ring;
+	for (UINT32 i = 0; i < MaxSpeakers; ++i) {
+		known |= SpeakerBits[i];
+		if ((aChannelMask & SpeakerBits[i]) == 0) continue;
+		if (SpeakerAzimuths[i] < 0.0f) {
+			mLFEChannel = int(mChannelCount);
+		}
+		else {
+			ring.push_back (std::make_pair (SpeakerAzimuths[i], mChannelCount));
+		}
+		++mChannelCount;
+	}
+	mValid = ((aChannelMask & ~known) == 0) && !ring.empty();
+
+	std::sort (ring.begin(), ring.end());
+	for (auto speaker = ring.begin(); speaker != ring.end(); ++speaker) {
+		mSpeakerAzimuths.push_back (speaker->first);
+		mSpeakerChannels.push_back (speaker->second);
+	}
+} // end constructor.
+
+//--- True if the emitter and listener use only the settings the spatializer reproduces.
+bool Spatializer::IsSupported (const X3DAUDIO_EMITTER *anEmitter, const X3DAUDIO_LISTENER *aListener) const
+{
+	if (!mValid || anEmitter == NULL || aListener == NULL) return false;
+	if (anEmitter->ChannelCount == 0) return false;
+	if (anEmitter->ChannelCount > 1 && anEmitter->ChannelRadius != 0.0f) return false;
+	return (anEmitter->InnerRadius == 0.0f) && (aListener->pCone == NULL);
+} // end IsSupported function.
+
+//--- Calculate the output matrices of a batch of emitters heard by a listener.
+void Spatializer::CalculateMatrices (const X3DAUDIO_LISTENER *aListener, const X3DAUDIO_EMITTER *const *emitters, const size_t count,
+	float *matrices, const size_t matrixStride)
+{
+	if (count == 0 || !mValid) return;
+
+	// Gather the batch into structure of arrays form.
+	const size_t padded = ((count + PackSize - 1) / PackSize) * PackSize;
+	float *positionX = Prepare (mPositionX, count, padded);
+	float *positionY = Prepare (mPositionY, count, padded);
+	float *positionZ = Prepare (mPositionZ, count, padded);
+	float *frontX = Prepare (mFrontX, count, padded);
+	float *frontY = Prepare (mFrontY, count, padded);
+	float *frontZ = Prepare (mFrontZ, count, padded);
+	float *right = Prepare (mRight, count, padded);
+	float *ahead = Prepare (mAhead, count, padded);
+	float *distance = Prepare (mDistance, count, padded);
+	float *coneCosine = Prepare (mConeCosine, count, padded);
+	for (size_t i = 0; i < count; ++i) {
+		const X3DAUDIO_EMITTER &emitter = *emitters[i];
+		positionX[i] = emitter.Position.x;
+		positionY[i] = emitter.Position.y;
+		positionZ[i] = emitter.Position.z;
+		const bool hasCone = (emitter.pCone != NULL);
+		frontX[i] = hasCone ? emitter.OrientFront.x : 0.0f;
+		frontY[i] = hasCone ? emitter.OrientFront.y : 0.0f;
+		frontZ[i] = hasCone ? emitter.OrientFront.z : 0.0f;
+	}
+
+	// The listener's axes; X3DAudio is left handed, so its right is top cross front.
+	const X3DAUDIO_VECTOR &front = aListener->OrientFront;
+	const X3DAUDIO_VECTOR &top = aListener->OrientTop;
+	const stu::v3f rightAxis = { top.y * front.z - top.z * front.y, top.z * front.x - top.x * front.z, top.x * front.y - top.y * front.x };
+	const stu::v3f frontAxis = { front.x, front.y, front.z };
+	const stu::v3f listenerPosition = { aListener->Position.x, aListener->Position.y, aListener->Position.z };
+
+	// The geometry, a pack at a time: each emitter's offset from the listener along its right and front, its distance, and the
+	// cosine of the angle between its front and the direction to the listener (0 for an emitter on the listener).
+	const stu::v3fView positions = stu::MakeView (positionX, positionY, positionZ);
+	const stu::v3fView fronts = stu::MakeView (frontX, frontY, frontZ);
+	const stu::v3f8 listener = stu::v3f8::Splat (listenerPosition);
+	const stu::v3f8 rightPack = stu::v3f8::Splat (rightAxis);
+	const stu::v3f8 frontPack = stu::v3f8::Splat (frontAxis);
+	const stu::simd8f nearZero = stu::Splat8 (stu::math::FloatZeroBarrier);
+	for (size_t i = 0; i < padded; i += PackSize) {
+		const stu::v3f8 position = stu::v3f8::Load (positions, i);
+		const stu::v3f8 offset = { stu::Sub (position.x, listener.x), stu::Sub (position.y, listener.y), stu::Sub (position.z, listener.z) };
+		const stu::simd8f squared = stu::Dot (offset, offset);
+		const stu::simd8f length = stu::Sqrt (squared);
+		stu::Store8 (right + i, stu::Dot (offset, rightPack));
+		stu::Store8 (ahead + i, stu::Dot (offset, frontPack));
+		stu::Store8 (distance + i, length);
+		// The listener is at -offset from the emitter.
+		const stu::simd8f towards = stu::Sub (stu::Splat8 (0.0f), stu::Dot (offset, stu::v3f8::Load (fronts, i)));
+		stu::Store8 (coneCosine + i, stu::KeepIfAtLeast (squared, nearZero, stu::Div (towards, length)));
+	}
+
+	// The volumes, angles and speaker gains, an emitter at a time.
+	float gains[MaxSpeakers];
+	for (size_t i = 0; i < count; ++i) {
+		const X3DAUDIO_EMITTER &emitter = *emitters[i];
+		const float scaler = (emitter.CurveDistanceScaler > 0.0f) ? emitter.CurveDistanceScaler : 1.0f;
+		const float scaled = distance[i] / scaler;
+		const float volume = EmitterVolume (emitter, distance[i], coneCosine[i]);
+
+		// The azimuth in [0, 2 pi), clockwise from the listener's front.
+		float azimuth = 0.0f;
+		if (right[i] != 0.0f || ahead[i] != 0.0f) {
+			azimuth = atan2f (right[i], ahead[i]);
+			if (azimuth < 0.0f) azimuth += X3DAUDIO_2PI;
+		}
+		std::fill (gains, gains + mChannelCount, 0.0f);
+		Pan (azimuth, volume, gains);
+		if (mLFEChannel >= 0) {
+			gains[mLFEChannel] = (emitter.pLFECurve != NULL) ? EvaluateCurve (*emitter.pLFECurve, scaled)
+				: ((scaled < 1.0f) ? 1.0f - scaled : 0.0f);
+		}
+
+		// Every source channel is at the emitter's position, so each has the same gains.
+		float *matrix = matrices + i * matrixStride;
+		const UINT32 sources = emitter.ChannelCount;
+		for (UINT32 speaker = 0; speaker < mChannelCount; ++speaker) {
+			for (UINT32 source = 0; source < sources; ++source) {
+				matrix[speaker * sources + source] = gains[speaker];
+			}
+		}
+	}
+} // end CalculateMatrices function.
+
+//--- The volume of an emitter at a distance from the listener, from its volume curve and cone.
+float Spatializer::EmitterVolume (const X3DAUDIO_EMITTER &anEmitter, const float aDistance, const float aConeCosine)
+{
+	const float scaler = (anEmitter.CurveDistanceScaler > 0.0f) ? anEmitter.CurveDistanceScaler : 1.0f;
+	const float scaled = aDistance / scaler;
+
+	float volume = 1.0f;
+	if (anEmitter.pVolumeCurve != NULL) {
+		volume = EvaluateCurve (*anEmitter.pVolumeCurve, scaled);
+	}
+	else if (scaled > 1.0f) {
+		volume = 1.0f / scaled;
+	}
+
+	if (anEmitter.pCone != NULL) {
+		const X3DAUDIO_CONE &cone = *anEmitter.pCone;
+		const float cosine = (aDistance > stu::math::FloatZeroBarrier) ? aConeCosine : 1.0f;
+		const float angle = 2.0f * acosf ((cosine > 1.0f) ? 1.0f : ((cosine < -1.0f) ? -1.0f : cosine));
+		float coneVolume = cone.OuterVolume;
+		if (angle <= cone.InnerAngle) {
+			coneVolume = cone.InnerVolume;
+		}
+		else if (angle < cone.OuterAngle) {
+			const float fraction = (angle - cone.InnerAngle) / (cone.OuterAngle - cone.InnerAngle);
+			coneVolume = cone.InnerVolume + fraction * (cone.OuterVolume - cone.InnerVolume);
+		}
+		volume *= coneVolume;
+	}
+	return volume;
+} // end EmitterVolume function.
+
+//--- The gains of the speakers for an emitter at an azimuth, added to by the volume given.
+void Spatializer::Pan (const float anAzimuth, const float aVolume, float *gains) const
+{
+	const size_t speakers = mSpeakerAzimuths.size();
+	if (speakers == 1) {
+		gains[mSpeakerChannels[0]] += aVolume;
+		return;
+	}
+
+	// The speaker at or anticlockwise of the azimuth, and the one after it; before the first speaker is after the last.
+	size_t before = speakers - 1;
+	for (size_t i = 0; i < speakers && mSpeakerAzimuths[i] <= anAzimuth; ++i) {
+		before = i;
+	}
+	const size_t after = (before + 1) % speakers;
+	float span = mSpeakerAzimuths[after] - mSpeakerAzimuths[before];
+	float offset = anAzimuth - mSpeakerAzimuths[before];
+	if (span <= 0.0f) span += X3DAUDIO_2PI;
+	if (offset < 0.0f) offset += X3DAUDIO_2PI;
+	// Constant power: the squares of the two gains add up to the square of the volume wherever the emitter is between them.
+	const float turn = (offset / span) * (X3DAUDIO_PI / 2.0f);
+	gains[mSpeakerChannels[before]] += cosf (turn) * aVolume;
+	gains[mSpeakerChannels[after]] += sinf (turn) * aVolume;
+} // end Pan function.
+
+} // end Audio namespace.
+} // end AllanMilne namespace.
@@ -0,0 +1,108 @@
+/*
+	file:	Spatializer.hpp
+	Version:	1.1
+	Date:	18th October 2026.
+	Author:	agent.
+
+	Namespace:	AllanMilne::Audio
+	Exposes:	Spatializer.
+	Requires:	X3DAudio (for its structures only), stu::v3f batch math.
+
+	Description:
+	A portable stand-in for the output matrix part of X3DAudioCalculate, working on a batch of emitters for one listener
+	rather than one emitter per call, so it can be used where X3DAudio isn't available and many emitters are updated at once.
+
+	*	the spatializer is set up for the speakers of a channel mask, as X3DAudioInitialize is;
+	*	CalculateMatrices() fills the X3DAUDIO_CALCULATE_MATRIX output for each emitter of a batch: the level of source
+		channel S in speaker D is at [SourceChannels * D + S], as X3DAudio and IXAudio2Voice::SetOutputMatrix use;
+	*	the emitters and listener are the X3DAudio structures, so the game's emitters can be passed as they are;
+	*	the geometry - emitter positions in the listener's frame, distances and cone angles - is worked out 8 emitters at a time
+		with the stu::v3f batch math (SSE, AVX or NEON, or scalar); the angles, curves and speaker gains are then found one
+		emitter at a time.
+
+	The matrix is modelled on X3DAudio's documented behaviour for what the game uses:
+	*	the distance is scaled by the emitter's CurveDistanceScaler and looked up on its volume curve; with no curve,
+		the inverse square law default is used (no attenuation up to 1, then 1 / distance);
+	*	with a cone, the volume is scaled by InnerVolume within half the inner angle of the emitter's front, OuterVolume
+		beyond half the outer angle, and linearly between;
+	*	the azimuth of the emitter round the listener (clockwise from the listener's front, ignoring height) pans it between
+		the two speakers either side of it with a constant power (sine and cosine) law. Each speaker is at the azimuth of its
+		channel mask bit, so stereo's front left and right are 45 degrees either side of the front. An emitter on the
+		listener pans to the front;
+	*	an LFE speaker gets the LFE curve's level, by default 1 falling linearly to 0 at a scaled distance of 1.
+
+	IsSupported() says whether an emitter and listener use only these: an emitter with more than one channel must have a
+	ChannelRadius of 0, the emitter's InnerRadius must be 0 and the listener must have no cone. Doppler, low pass filter and
+	reverb settings are not calculated.
+
+	HeadlessDriver's -checkspatializer mode compares every coefficient with X3DAudio's, for the game's emitter types swept
+	round the listener on the mono to 7.1 speaker layouts, and fails if one differs by more than SPATIALIZER_TOLERANCE.
+	Measured worst-case error against X3DAudio: not yet measured. The check has only been built and run against a
+	stand-in for X3DAudio, as the real library needs Windows; record the largest difference it reports there in this
+	paragraph, and until it passes use X3DAudio wherever the output must match it.
+
+*/
+
+#ifndef __SPATIALIZER_HPP__
+#define __SPATIALIZER_HPP__
+
+// system includes.
+#include <X3DAudio.h>
+#include <vector>
+using std::vector;
+
+//--- The largest difference allowed between a matrix coefficient and X3DAudio's.
+#define SPATIALIZER_TOLERANCE 1.0e-3f
+
+namespace AllanMilne {
+namespace Audio {
+
+class Spatializer
+{
+public:
+
+	//--- Set up for the speakers of a channel mask, e.g. the device's SPEAKER_STEREO.
+	Spatializer (const UINT32 aChannelMask);
+
+	//--- True if every speaker of the mask is one the spatializer places; the upper (top) speakers are not.
+	inline bool IsValid () const { return mValid; }
+	inline UINT32 GetChannelCount () const { return mChannelCount; }
+
+	//--- True if the emitter and listener use only the settings the spatializer reproduces; see above.
+	bool IsSupported (const X3DAUDIO_EMITTER *anEmitter, const X3DAUDIO_LISTENER *aListener) const;
+
+	//--- Calculate the output matrices of a batch of emitters heard by a listener.
+	//--- the matrix of emitter i is written from matrices[i * matrixStride], and is its ChannelCount by GetChannelCount() coefficients;
+	//--- matrixStride must be at least the largest of these.
+	void CalculateMatrices (const X3DAUDIO_LISTENER *aListener, const X3DAUDIO_EMITTER *const *emitters, const size_t count,
+		float *matrices, const size_t matrixStride);
+
+private:
+
+	//--- The volume of an emitter at a distance from the listener, from its volume curve and cone as described above;
+	//--- aConeCosine is the cosine of the angle between the emitter's front and the direction to the listener.
+	static float EmitterVolume (const X3DAUDIO_EMITTER &anEmitter, const float aDistance, const float aConeCosine);
+
+	//--- The gains of the speakers for an emitter at an azimuth, added to by the volume given.
+	void Pan (const float anAzimuth, const float aVolume, float *gains) const;
+
+	UINT32 mChannelCount;
+	bool mValid;
+
+	// The speakers round the listener in clockwise order from the front, as azimuths and channels, and the LFE channel; -1 if none.
+	vector<float> mSpeakerAzimuths;
+	vector<UINT32> mSpeakerChannels;
+	int mLFEChannel;
+
+	// The batch in structure of arrays form, padded to a whole number of packs: the emitters' positions and fronts (zero
+	// for those without cones), and the geometry worked out from them.
+	vector<float> mPositionX, mPositionY, mPositionZ;
+	vector<float> mFrontX, mFrontY, mFrontZ;
+	vector<float> mRight, mAhead, mDistance, mConeCosine;
+
+}; // end Spatializer class.
+
+} // end Audio namespace.
+} // end AllanMilne namespace.
+
+#endif
@@ -0,0 +1,343 @@
+/*
+	file:	TraceLog.cpp
+	Version:	1.1
+	Date:	18th October 2026.
+	Author:	agent.
+
+	Namespace:	AllanMilne
+	Exposes:	TraceLog and TraceScope implementation.
+	Requires:	GameTimer.
+
+	Description:
+	A timeline of game and audio events written as Chrome Trace Event JSON.
+	this is the implementation file - see TraceLog.hpp for details.
+
+*/
+
+// system includes.
+#include <windows.h>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iomanip>
+using std::string;
+using std::vector;
+using std::ofstream;
+using std::ostream;
+using std::fixed;
+using std::setprecision;
+
+// framework includes.
+#include "GameTimer.h"
+#include "TraceLog.hpp"
+
+//=== anonymous namespace for the JSON helper.
+namespace {
+
+	//--- Write a string as a JSON string, escaping the characters that need it.
+	void WriteJsonString (ostream &aStream, const char *aText)
+	{
+		aStream << '"';
+		for (const char *c = (aText != NULL) ? aText : ""; *c != '\0'; ++c) {
+			if (*c == '"' || *c == '\\') {
+				aStream << '\\' << *c;
+			}
+			else if ((unsigned char)*c < 0x20) {
+				aStream << ' ';
+			}
+			else {
+				aStream << *c;
+			}
+		}
+		aStream << '"';
+	} // end WriteJsonString function.
+
+} // end anonymous namespace.
+
+namespace AllanMilne {
+
+	//--- Initialise the static instance field, tracing flag and the calling thread's flow.
+	TraceLog *TraceLog::mInstance = NULL;
+	volatile bool TraceLog::mTracing = false;
+	__declspec(thread) unsigned long TraceLog::mCurrentFlow = 0;
+
+//--- Get the singleton instance - use lazy evaluation.
+TraceLog& TraceLog::GetInstance ()
+{
+	// Instance already created so return it.
+	if (mInstance) { return *mInstance; }
+	// First time called so instantiate the object.
+	mInstance = new TraceLog ();
+	return *mInstance;
+} // end static GetInstance function.
+
+//--- Delete the instance, stopping the trace if it is running.
+void TraceLog::DeleteInstance ()
+{
+	delete mInstance;
+	mInstance = NULL;
+} // end static DeleteInstance function.
+
+TraceLog::TraceLog ()
+	: mFirstFlowId (0), mLastAudibleFlow (0), mMixerEventsDropped (0), mEventsWritten (0), mWriter (NULL), mWake (NULL),
+	  mStopping (false), mNextFlowId (0), mProcessId (0), mStartCount (0), mMicrosecondsPerCount (0.0)
+{
+	InitializeCriticalSection (&mLock);
+} // end TraceLog constructor.
+
+TraceLog::~TraceLog ()
+{
+	Stop();
+	DeleteCriticalSection (&mLock);
+} // end TraceLog destructor.
+
+//--- Create the trace file and start the writer thread.
+bool TraceLog::Start (const string &aFileName)
+{
+	if (mTracing) return false;
+	mFile.open (aFileName.c_str());
+	if (!mFile.is_open()) return false;
+	mFile << "{\"traceEvents\":[" << fixed << setprecision(3);
+
+	mEventsWritten = 0;
+	mMixerEventsDropped = 0;
+	// The writer thread isn't running, so this thread can take the mixer's events left from the last trace.
+	TraceEvent stale;
+	while (mMixerEvents.Pop (stale)) { }
+	mFirstFlowId = (unsigned long)mNextFlowId;
+	mLastAudibleFlow = 0;
+	mProcessId = GetCurrentProcessId();
+	mStartCount = GameTimer::ReadPerformanceCounter();
+	mMicrosecondsPerCount = GameTimer::GetSecondsPerPerformanceCount() * 1.0e6;
+	mStopping = false;
+	mWake = CreateEvent (NULL, FALSE, FALSE, NULL);
+	mWriter = CreateThread (NULL, 0, WriterThread, this, 0, NULL);
+	if (mWriter == NULL) {
+		CloseHandle (mWake);
+		mWake = NULL;
+		mFile.close();
+		return false;
+	}
+	mTracing = true;
+	return true;
+} // end Start function.
+
+//--- Write the remaining events, close the file and stop the writer thread.
+void TraceLog::Stop ()
+{
+	if (!mTracing) return;
+	mTracing = false;
+
+	// The writer thread writes whatever is pending before it finishes.
+	mStopping = true;
+	SetEvent (mWake);
+	WaitForSingleObject (mWriter, INFINITE);
+	CloseHandle (mWriter);
+	CloseHandle (mWake);
+	mWriter = NULL;
+	mWake = NULL;
+
+	// Events added by threads that checked the flag just before it was cleared are dropped; the mixer's are when the next trace starts.
+	EnterCriticalSection (&mLock);
+	mPending.clear();
+	LeaveCriticalSection (&mLock);
+
+	mFile << "\n],\"displayTimeUnit\":\"ms\"}\n";
+	mFile.close();
+} // end Stop function.
+
+//--- Add a slice on the calling thread.
+void TraceLog::AddSlice (const char *aName, const char *aCategory, const LONGLONG aStart, const LONGLONG anEnd)
+{
+	TraceEvent slice = { aName, aCategory, 'X', aStart, anEnd, GetCurrentThreadId(), 0 };
+	AddEvent (slice);
+} // end AddSlice function.
+
+//--- Add an instant event on the calling thread.
+void TraceLog::AddInstant (const char *aName, const char *aCategory)
+{
+	LONGLONG now = GameTimer::ReadPerformanceCounter();
+	TraceEvent instant = { aName, aCategory, 'i', now, now, GetCurrentThreadId(), 0 };
+	AddEvent (instant);
+} // end AddInstant function.
+
+//--- Add a flow event on the calling thread.
+void TraceLog::AddFlow (const char *aName, const char *aCategory, const char aPhase, const unsigned long aFlowId, const LONGLONG aTime)
+{
+	LONGLONG time = (aTime != 0) ? aTime : GameTimer::ReadPerformanceCounter();
+	TraceEvent flow = { aName, aCategory, aPhase, time, time, GetCurrentThreadId(), aFlowId };
+	AddEvent (flow);
+} // end AddFlow function.
+
+//--- Label the calling thread's track.
+void TraceLog::NameThread (const char *aName)
+{
+	TraceEvent name = { aName, "", 'M', 0, 0, GetCurrentThreadId(), 0 };
+	AddEvent (name);
+} // end NameThread function.
+
+//--- A new flow identifier; 0 is skipped when the identifier wraps.
+unsigned long TraceLog::NewFlowId ()
+{
+	unsigned long id = (unsigned long)InterlockedIncrement (&mNextFlowId);
+	if (id == 0) {
+		id = (unsigned long)InterlockedIncrement (&mNextFlowId);
+	}
+	return id;
+} // end NewFlowId function.
+
+//--- Queue a flow to be ended in the next audio processing pass; the game thread is the ring's only producer.
+void TraceLog::QueueAudibleFlow (const unsigned long aFlowId)
+{
+	// A command that starts several sounds queues its flow once.
+	if (!mTracing || aFlowId == 0 || aFlowId == mLastAudibleFlow) return;
+	mLastAudibleFlow = aFlowId;
+	if (!mAudibleFlows.Push (aFlowId)) {
+		InterlockedIncrement (&mMixerEventsDropped);
+	}
+} // end QueueAudibleFlow function.
+
+//--- Add the sound start step and the end of a flow now.
+void TraceLog::EndAudibleFlowNow (const unsigned long aFlowId)
+{
+	if (!mTracing || aFlowId == 0 || aFlowId == mLastAudibleFlow) return;
+	mLastAudibleFlow = aFlowId;
+	AddFlow ("Sound start", "audio", FlowStep, aFlowId);
+	AddFlow ("Audible", "audio", FlowEnd, aFlowId);
+} // end EndAudibleFlowNow function.
+
+//--- Add a slice on the mixer thread.
+void TraceLog::AddMixerSlice (const char *aName, const char *aCategory, const LONGLONG aStart, const LONGLONG anEnd)
+{
+	TraceEvent slice = { aName, aCategory, 'X', aStart, anEnd, GetCurrentThreadId(), 0 };
+	AddMixerEvent (slice);
+} // end AddMixerSlice function.
+
+//--- Label the mixer thread's track.
+void TraceLog::NameMixerThread (const char *aName)
+{
+	TraceEvent name = { aName, "", 'M', 0, 0, GetCurrentThreadId(), 0 };
+	AddMixerEvent (name);
+} // end NameMixerThread function.
+
+//--- End the queued flows on the mixer thread, the flow ring's only consumer; flows from an earlier trace are skipped.
+void TraceLog::EndAudibleFlows (const LONGLONG aTime)
+{
+	if (!mTracing) return;
+	const DWORD thread = GetCurrentThreadId();
+	unsigned long id;
+	while (mAudibleFlows.Pop (id)) {
+		if (LONG(id - mFirstFlowId) > 0) {
+			TraceEvent flow = { "Audible", "audio", FlowEnd, aTime, aTime, thread, id };
+			AddMixerEvent (flow);
+		}
+	}
+} // end EndAudibleFlows function.
+
+//--- Add an event to the pending list; the lock is held only for the copy.
+void TraceLog::AddEvent (const TraceEvent &anEvent)
+{
+	if (!mTracing) return;
+	EnterCriticalSection (&mLock);
+	mPending.push_back (anEvent);
+	LeaveCriticalSection (&mLock);
+} // end AddEvent function.
+
+//--- Add an event to the mixer's ring; the mixer thread is its only producer.
+void TraceLog::AddMixerEvent (const TraceEvent &anEvent)
+{
+	if (!mTracing) return;
+	if (!mMixerEvents.Push (anEvent)) {
+		InterlockedIncrement (&mMixerEventsDropped);
+	}
+} // end AddMixerEvent function.
+
+//--- The writer thread.
+DWORD WINAPI TraceLog::WriterThread (LPVOID aTraceLog)
+{
+	TraceLog *log = static_cast<TraceLog*>(aTraceLog);
+	bool stopping = false;
+	while (!stopping) {
+		WaitForSingleObject (log->mWake, WriteInterval);
+		// Read the flag before writing so events added before Stop() was called are written on this pass.
+		stopping = log->mStopping;
+		log->WritePending();
+	}
+	return 0;
+} // end WriterThread function.
+
+//--- Take the pending events and write them to the file.
+void TraceLog::WritePending ()
+{
+	EnterCriticalSection (&mLock);
+	mWriting.swap (mPending);
+	LeaveCriticalSection (&mLock);
+	// The writer thread is the only consumer of the mixer's ring.
+	TraceEvent mixerEvent;
+	while (mMixerEvents.Pop (mixerEvent)) {
+		mWriting.push_back (mixerEvent);
+	}
+	for (vector<TraceEvent>::const_iterator event = mWriting.begin(); event != mWriting.end(); ++event) {
+		WriteEvent (*event, mEventsWritten == 0);
+		++mEventsWritten;
+	}
+	mWriting.clear();
+	mFile.flush();
+} // end WritePending function.
+
+//--- Write one event as a JSON object; events after the first are preceded by a comma.
+void TraceLog::WriteEvent (const TraceEvent &anEvent, const bool aFirst)
+{
+	mFile << (aFirst ? "\n" : ",\n");
+	if (anEvent.Phase == 'M') {
+		mFile << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << mProcessId << ",\"tid\":" << anEvent.ThreadId
+			  << ",\"args\":{\"name\":";
+		WriteJsonString (mFile, anEvent.Name);
+		mFile << "}}";
+		return;
+	}
+
+	mFile << "{\"name\":";
+	WriteJsonString (mFile, anEvent.Name);
+	mFile << ",\"cat\":";
+	WriteJsonString (mFile, anEvent.Category);
+	mFile << ",\"ph\":\"" << anEvent.Phase << "\",\"pid\":" << mProcessId << ",\"tid\":" << anEvent.ThreadId
+		  << ",\"ts\":" << (anEvent.Start - mStartCount) * mMicrosecondsPerCount;
+	switch (anEvent.Phase) {
+	case 'X':
+		mFile << ",\"dur\":" << (anEvent.End - anEvent.Start) * mMicrosecondsPerCount;
+		break;
+	case 'i':
+		mFile << ",\"s\":\"t\"";
+		break;
+	case 'f':
+		// Bind the end of a flow to the slice it is inside rather than the next slice.
+		mFile << ",\"id\":" << anEvent.FlowId << ",\"bp\":\"e\"";
+		break;
+	default:
+		mFile << ",\"id\":" << anEvent.FlowId;
+		break;
+	}
+	mFile << '}';
+} // end WriteEvent function.
+
+//=== TraceScope.
+
+//--- Start the slice if a trace is running.
+TraceScope::TraceScope (const char *aName, const char *aCategory)
+	: mName (aName), mCategory (aCategory), mStart (0), mActive (TraceLog::IsTracing())
+{
+	if (mActive) {
+		mStart = GameTimer::ReadPerformanceCounter();
+	}
+} // end TraceScope constructor.
+
+//--- End the slice and add it to the trace.
+TraceScope::~TraceScope ()
+{
+	if (mActive && TraceLog::IsTracing()) {
+		TraceLog::GetInstance().AddSlice (mName, mCategory, mStart, GameTimer::ReadPerformanceCounter());
+	}
+} // end TraceScope destructor.
+
+} // end AllanMilne namespace.
@@ -0,0 +1,263 @@
+/*
+	file:	TraceLog.hpp
+	Version:	1.1
+	Date:	18th October 2026.
+	Author:	agent.
+
+	Namespace:	AllanMilne
+	Exposes:	TraceEvent, SingleProducerRing, TraceLog, TraceScope, TRACE_SCOPE, TRACE_INSTANT.
+	Requires:	GameTimer.
+
+	Description:
+	A timeline of game and audio events written as Chrome Trace Event JSON, to be opened in chrome://tracing or the Perfetto UI.
+
+	*	TRACE_SCOPE("name", "category") at the start of a block records the block as a slice on the calling thread's track;
+		TRACE_INSTANT("name", "category") records a single moment;
+	*	names and categories must be string literals, or otherwise last until the trace is stopped, as only the pointers are kept;
+	*	flow events link slices on the same or different threads into a chain drawn as arrows, e.g. from a key press
+		to the sound it starts and on to the mixer pass that first plays it:
+		-	a flow is started with NewFlowId() and AddFlow(... FlowStart ...) inside the slice it starts from;
+		-	SetCurrentFlow() tells code further along which flow it is acting for, e.g. while a command is actioned;
+		-	XASound::Play() adds a step to the current flow once the voice has started, and queues it with QueueAudibleFlow();
+		-	the queued flows are ended by EndAudibleFlows() from the XAudio2 engine callback in the next processing pass;
+			on XACore's null device, which has no processing passes, Play() ends the flow at the sound start instead,
+			with EndAudibleFlowNow();
+	*	the calling thread's id is recorded with every event; NameThread() labels a thread's track;
+	*	events are added to a pending list under a short lock and formatted and written to the file by a background thread,
+		so tracing doesn't wait on the disk;
+	*	the XAudio2 mixer thread must never wait on the game thread, so it takes no lock: its events (AddMixerSlice,
+		NameMixerThread and the flow ends) go through a preallocated ring read by the writer thread, and the flows queued
+		for it by the game thread through another; if a ring is full the event is dropped and counted rather than waited for;
+	*	the time is read from the performance counter through GameTimer, bypassing its simulated clock.
+
+	Nothing is recorded until Start() is called, and each event costs only a flag test while not tracing.
+	Tracing is compiled in to debug builds, or any build with TRACING defined; otherwise the macros expand to nothing.
+
+	Exposed and implemented as a singleton pattern.
+
+*/
+
+#ifndef __TRACELOG_HPP__
+#define __TRACELOG_HPP__
+
+// system includes.
+#include <windows.h>
+#include <string>
+#include <vector>
+#include <fstream>
+using std::string;
+using std::vector;
+using std::ofstream;
+
+//--- Tracing is in debug builds, and in release builds only if asked for.
+#if !defined(NDEBUG) || defined(TRACING)
+#define TRACING_ENABLED
+#endif
+
+namespace AllanMilne {
+
+//--- A fixed size queue from one producer thread to one consumer thread that takes no lock and allocates nothing.
+//--- Push() must only be called on the producer thread and Pop() on the consumer thread; aSize is a power of 2.
+template <typename T, LONG aSize>
+class SingleProducerRing
+{
+public:
+	SingleProducerRing () : mWrite (0), mRead (0) { }
+
+	//--- Add an item; returns false, and drops the item, if the ring is full.
+	bool Push (const T &anItem)
+	{
+		// the consumer has finished with the slot before it is reused, and the item is written before the new index publishes it.
+		const LONG write = ReadIndex (mWrite);
+		const LONG read = ReadIndex (mRead);
+		if (ULONG(write) - ULONG(read) == ULONG(aSize)) return false;
+		mItems[write & (aSize - 1)] = anItem;
+		InterlockedExchange (&mWrite, write + 1);
+		return true;
+	}
+
+	//--- Take the oldest item; returns false if the ring is empty.
+	bool Pop (T &anItem)
+	{
+		// the item is read after it was published, and before its slot is released.
+		const LONG read = ReadIndex (mRead);
+		if (read == ReadIndex (mWrite)) return false;
+		anItem = mItems[read & (aSize - 1)];
+		InterlockedExchange (&mRead, read + 1);
+		return true;
+	}
+
+private:
+	T mItems[aSize];
+	volatile LONG mWrite;
+	volatile LONG mRead;
+
+	//--- The indices are only read and written with interlocked operations, which are full barriers.
+	static inline LONG ReadIndex (volatile LONG &anIndex) { return InterlockedCompareExchange (&anIndex, 0, 0); }
+
+}; // end SingleProducerRing class.
+
+//--- A single trace event; the phase is the Chrome Trace Event "ph" value.
+struct TraceEvent {
+	const char *Name;
+	const char *Category;
+	char Phase;				// 'X' slice, 'i' instant, 's'/'t'/'f' flow start/step/end, 'M' thread name.
+	LONGLONG Start;			// performance counter counts.
+	LONGLONG End;			// slices only.
+	DWORD ThreadId;
+	unsigned long FlowId;	// flow events only.
+};
+
+class TraceLog
+{
+public:
+
+	//--- Flow event phases.
+	static const char FlowStart = 's';
+	static const char FlowStep = 't';
+	static const char FlowEnd = 'f';
+
+	//--- Get the singleton instance - use lazy evaluation.
+	static TraceLog& GetInstance ();
+
+	//--- Delete the instance, stopping the trace if it is running.
+	static void DeleteInstance ();
+
+	//--- True while a trace is being written; cheap enough to test before every event.
+	static inline bool IsTracing () { return mTracing; }
+
+	//--- Create the trace file and start the writer thread; returns false if the file could not be created or a trace is running.
+	bool Start (const string &aFileName);
+
+	//--- Write the remaining events, close the file and stop the writer thread.
+	void Stop ();
+
+	//--- Add a slice from aStart to anEnd, in performance counter counts, on the calling thread.
+	void AddSlice (const char *aName, const char *aCategory, const LONGLONG aStart, const LONGLONG anEnd);
+
+	//--- Add an instant event at the current time on the calling thread.
+	void AddInstant (const char *aName, const char *aCategory);
+
+	//--- Add a flow event at the current time, or at aTime if given, on the calling thread.
+	void AddFlow (const char *aName, const char *aCategory, const char aPhase, const unsigned long aFlowId, const LONGLONG aTime=0);
+
+	//--- Label the calling thread's track in the timeline.
+	void NameThread (const char *aName);
+
+	//--- A new flow identifier; never 0.
+	unsigned long NewFlowId ();
+
+	//--- The flow the calling thread is acting for; 0 for none.
+	static inline void SetCurrentFlow (const unsigned long aFlowId) { mCurrentFlow = aFlowId; }
+	static inline unsigned long GetCurrentFlow () { return mCurrentFlow; }
+
+	//--- Queue a flow to be ended in the next audio processing pass; called on the game thread only.
+	void QueueAudibleFlow (const unsigned long aFlowId);
+
+	//--- Add the sound start step and end a flow at once, for a device with no processing passes; called on the game thread only.
+	//--- A command that starts several sounds ends its flow at the first.
+	void EndAudibleFlowNow (const unsigned long aFlowId);
+
+	//--- Events on the XAudio2 mixer thread; they take no lock, and are only called on that thread.
+	//--- End the queued flows at aTime, from within the processing pass slice.
+	void AddMixerSlice (const char *aName, const char *aCategory, const LONGLONG aStart, const LONGLONG anEnd);
+	void NameMixerThread (const char *aName);
+	void EndAudibleFlows (const LONGLONG aTime);
+
+	//--- Number of events written by the last or current trace, and the mixer thread's events and queued flows dropped
+	//--- because their ring was full.
+	inline unsigned long GetEventsWritten () const { return mEventsWritten; }
+	inline unsigned long GetMixerEventsDropped () const { return (unsigned long)mMixerEventsDropped; }
+
+private:
+	// the singleton instance and the tracing flag.
+	static TraceLog *mInstance;
+	static volatile bool mTracing;
+
+	// The calling thread's current flow.
+	static __declspec(thread) unsigned long mCurrentFlow;
+
+	// Constructor & destructor are hidden to implement singleton patern.
+	TraceLog ();
+	~TraceLog ();
+
+	// Add an event to the pending list, or on the mixer thread to its ring.
+	void AddEvent (const TraceEvent &anEvent);
+	void AddMixerEvent (const TraceEvent &anEvent);
+
+	// The writer thread; writes the pending events every WriteInterval milliseconds, or when woken by Stop().
+	static DWORD WINAPI WriterThread (LPVOID aTraceLog);
+	void WritePending ();
+	void WriteEvent (const TraceEvent &anEvent, const bool aFirst);
+
+	// How often the writer thread wakes, in milliseconds.
+	static const DWORD WriteInterval = 100;
+
+	// The mixer thread's events that can wait between two writes (a pass every 10ms or so adds 1 to 3), and the flows
+	// that can wait for a processing pass.
+	static const LONG MixerEventCount = 1024;
+	static const LONG AudibleFlowCount = 64;
+
+	// Events waiting to be written; guarded by mLock.
+	vector<TraceEvent> mPending;
+	CRITICAL_SECTION mLock;
+
+	// The mixer thread's events waiting to be written, and the flows waiting for a processing pass. Flows queued in an
+	// earlier trace are no newer than mFirstFlowId and aren't ended; the last flow queued is only used by the game thread.
+	SingleProducerRing<TraceEvent, MixerEventCount> mMixerEvents;
+	SingleProducerRing<unsigned long, AudibleFlowCount> mAudibleFlows;
+	unsigned long mFirstFlowId;
+	unsigned long mLastAudibleFlow;
+	volatile LONG mMixerEventsDropped;
+
+	// Only used by the writer thread while the trace runs.
+	vector<TraceEvent> mWriting;
+	ofstream mFile;
+	unsigned long mEventsWritten;
+
+	HANDLE mWriter;
+	HANDLE mWake;
+	volatile bool mStopping;
+	volatile LONG mNextFlowId;
+
+	// The trace's process id, start time and the microseconds in a performance counter count.
+	DWORD mProcessId;
+	LONGLONG mStartCount;
+	double mMicrosecondsPerCount;
+
+}; // end TraceLog class.
+
+//--- Records the block it is declared in as a slice, if a trace was running when it started.
+class TraceScope
+{
+public:
+	TraceScope (const char *aName, const char *aCategory);
+	~TraceScope ();
+
+private:
+	const char *mName;
+	const char *mCategory;
+	LONGLONG mStart;
+	bool mActive;
+
+	// Not copyable.
+	TraceScope (const TraceScope&);
+	TraceScope& operator= (const TraceScope&);
+
+}; // end TraceScope class.
+
+} // end AllanMilne namespace.
+
+//--- Record the rest of the enclosing block, or a single moment; nothing when tracing is compiled out.
+#ifdef TRACING_ENABLED
+#define TRACE_CONCAT_NAME(aPrefix, aLine) aPrefix##aLine
+#define TRACE_UNIQUE_NAME(aPrefix, aLine) TRACE_CONCAT_NAME(aPrefix, aLine)
+#define TRACE_SCOPE(aName, aCategory) AllanMilne::TraceScope TRACE_UNIQUE_NAME(traceScope, __LINE__) (aName, aCategory)
+#define TRACE_INSTANT(aName, aCategory) \
+	do { if (AllanMilne::TraceLog::IsTracing()) AllanMilne::TraceLog::GetInstance().AddInstant (aName, aCategory); } while (0)
+#else
+#define TRACE_SCOPE(aName, aCategory)
+#define TRACE_INSTANT(aName, aCategory)
+#endif
+
+#endif
@@ -1,18 +1,19 @@
 /*
 	File:	WinCore.cpp
-	Version:	2.2.1
-	Date: 20th March 2014; 2013; 2012; 2006.
+	Version:	2.4
+	Date: 18th October 2026; 20th March 2014; 2013; 2012; 2006.
 	Author:	Allan C. Milne
 
 	Namespace:	AllanMilne
 	Exposes:	WinCore implementation.
-	Requires:	IState, Gametimer.
+	Requires:	IState, Gametimer, InputQueue.
 
 	Description:
 	A basic Windows framework providing 
 	*	initialization of the windows environment;
 	*	Windows message loop handling;
-	*	an application state frame process function with time delta information.
+	*	an application state frame process function called at a fixed tick rate with the tick length as its time delta;
+	*	optionally, GameTimer's simulated clock advanced by one tick length per tick, so the game's timers see the fixed ticks.
 
 	notes:
 	*	Any project using this class must have its character set to multibyte, not unicode.
@@ -33,12 +34,22 @@
 #include "IState.hpp"
 #include "Gametimer.h"
 #include "WinCore.hpp"
+#include "InputQueue.hpp"
+
+//--- High resolution waitable timers are available from Windows 10 1803; not defined by older SDKs.
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
 
 namespace AllanMilne 
 {
 
+//=== static members.
+const float WinCore::DefaultTickRate = 60.0f;
+const float WinCore::MaxFrameTime = 0.25f;
+
 //=== Windows message processing.
-//=== Escape key terminates application.
+//=== Escape key terminates application; key downs and ups are passed to the InputQueue.
 LRESULT CALLBACK WndProc (HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
 {
 	switch( msg )
@@ -50,6 +61,11 @@ LRESULT CALLBACK WndProc (HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
 		//--- check for escape key; if pressed then terminate application.
 		if( wParam == VK_ESCAPE )
 			DestroyWindow(hwnd);
+		else
+			InputQueue::GetInstance().OnKeyMessage (msg, wParam, lParam);
+		break;
+	case WM_KEYUP:
+		InputQueue::GetInstance().OnKeyMessage (msg, wParam, lParam);
 		break;
 	}
 	return DefWindowProc(hwnd, msg, wParam, lParam);
@@ -60,7 +76,11 @@ WinCore::WinCore (IState *aState)
 {
 	mState = aState;
 	mHwnd = NULL;
-	mTimer = new GameTimer ();
+	mTickRate = DefaultTickRate;
+	mTicksRun = 0;
+	mRunTime = 0.0f;
+	mIdleTime = 0.0f;
+	mSimulatedClock = false;
 } // end WinCore constructor.
 
 //=== Destructor.
@@ -69,8 +89,6 @@ WinCore::WinCore (IState *aState)
 //=== 2. We do not delete the mState field since this object was not responsible for creating it - it was passed to it in the constructor.
 WinCore::~WinCore ()
 {
-	delete mTimer;
-	mTimer = NULL;
 } // end WinCore destructor.
 
 //=== Create the application window; returns false if any errors detected.
@@ -123,7 +141,7 @@ WinCore::~WinCore ()
 
 //===  Encapsulates calling of the windows message processing function.
 //=== Calls the application state object Setup() function then
-	//=== calls ProcessFrame() function every time around the messsage loop.
+	//=== calls ProcessFrame() function once per tick, waiting between ticks rather than spinning.
 //=== The state object Cleanup() function is called when the message loop is terminated.
 void WinCore::RunApp ()
 {
@@ -132,33 +150,137 @@ void WinCore::RunApp ()
 		MessageBox (NULL, TEXT (" IState::Setup failed - application aborted."), TEXT ("WinCore::RunApp() - Failed"), MB_OK | MB_ICONERROR );
 		return;
 	}
-	mTimer->Reset ();		// start timing.
+
+	//--- Timer used to wait for the next tick; fall back to a standard resolution timer if high resolution is not supported.
+	//--- If neither can be created the wait times out on the message wait instead, to the nearest millisecond.
+	HANDLE waitTimer = CreateWaitableTimerEx (NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+	if (waitTimer == NULL) {
+		waitTimer = CreateWaitableTimer (NULL, TRUE, NULL);
+	}
+
+	const float tickTime = 1.0f / mTickRate;
+	float accumulator = 0.0f;
+	mTicksRun = 0;
+	mRunTime = 0.0f;
+	mIdleTime = 0.0f;
+	//--- real time is read from the performance counter, as GameTimer reads the simulated clock when it is in use.
+	__int64 lastCount = GameTimer::ReadPerformanceCounter ();		// start timing.
 
 	MSG msg;
 	ZeroMemory(&msg, sizeof(MSG));
 	//--- The Windows message processing loop.
 	bool continueLoop = true;
-	while (msg.message != WM_QUIT && continueLoop)
+	while (continueLoop)
 	{
-		if (PeekMessage (&msg, 0, 0, 0, PM_REMOVE))
+		//--- handle all waiting messages before running any ticks.
+		while (PeekMessage (&msg, 0, 0, 0, PM_REMOVE))
 		{
+			if (msg.message == WM_QUIT) {
+				continueLoop = false;
+				break;
+			}
 			TranslateMessage(&msg);
 			DispatchMessage(&msg);
 		}
-		else
+		if (!continueLoop) break;
+
+		//--- add the real time passed, limited so a stall does not cause a long burst of ticks.
+		float frameTime = RealTimeSince (lastCount);
+		mRunTime += frameTime;
+		if (frameTime > MaxFrameTime) frameTime = MaxFrameTime;
+		accumulator += frameTime;
+
+		//--- call the frame processing function once for each whole tick. ---
+		while (accumulator >= tickTime && continueLoop)
 		{
-			// get elapsed time for the current call.
-			mTimer->Tick ();
-			//--- call the frame processing function. ---
-			continueLoop = mState->ProcessFrame (mTimer->GetDeltaTime());
+			continueLoop = mState->ProcessFrame (tickTime);
+			if (mSimulatedClock) {
+				GameTimer::AdvanceSimulatedClock (tickTime);
+			}
+			accumulator -= tickTime;
+			++mTicksRun;
 		}
+		if (!continueLoop) break;
+
+		//--- sleep until the next tick is due.
+		WaitForTick (waitTimer, tickTime - accumulator);
 	} // end while loop.
+
+	if (waitTimer != NULL) {
+		CloseHandle (waitTimer);
+	}
 	//--- clean up game-wide resources we have allocated.
 	mState->Cleanup ();
 } // end RunApp function.
 
+//=== Values <= 0 are ignored.
+void WinCore::SetTickRate (const float aTickRate)
+{
+	if (aTickRate <= 0.0f) return;
+	mTickRate = aTickRate;
+} // end SetTickRate function.
+
+//=== The simulated clock restarts from 0 when it is switched on, before the timers of the objects created in Initialize() are reset.
+void WinCore::UseSimulatedClock (const bool aUseSimulated)
+{
+	mSimulatedClock = aUseSimulated;
+	GameTimer::UseSimulatedClock (aUseSimulated);
+} // end UseSimulatedClock function.
+
+//=== Seconds of real time since the performance counter value given, which is moved on to now.
+float WinCore::RealTimeSince (__int64 &aCount)
+{
+	__int64 now = GameTimer::ReadPerformanceCounter ();
+	float seconds = float((now - aCount) * GameTimer::GetSecondsPerPerformanceCount ());
+	aCount = now;
+	return seconds;
+} // end RealTimeSince function.
+
+//=== Fraction of the time in RunApp() spent waiting for ticks.
+float WinCore::GetIdleFraction () const
+{
+	if (mRunTime <= 0.0f) return 0.0f;
+	float fraction = mIdleTime / mRunTime;
+	return (fraction > 1.0f) ? 1.0f : fraction;
+} // end GetIdleFraction function.
+
+//=== Wait until the given time has passed or a window message arrives; a message ends the wait early so input is not delayed.
+void WinCore::WaitForTick (HANDLE aWaitTimer, const float aTime)
+{
+	if (aTime <= 0.0f) return;
+	__int64 idleCount = GameTimer::ReadPerformanceCounter ();
+
+	if (aWaitTimer != NULL) {
+		// Relative due times are negative, in 100 nanosecond units.
+		LARGE_INTEGER dueTime;
+		dueTime.QuadPart = -(LONGLONG)(aTime * 10000000.0f);
+		if (SetWaitableTimer (aWaitTimer, &dueTime, 0, NULL, NULL, FALSE)) {
+			MsgWaitForMultipleObjects (1, &aWaitTimer, FALSE, INFINITE, QS_ALLINPUT);
+		}
+		else {
+			MsgWaitForMultipleObjects (0, NULL, FALSE, (DWORD)(aTime * 1000.0f), QS_ALLINPUT);
+		}
+	}
+	else {
+		MsgWaitForMultipleObjects (0, NULL, FALSE, (DWORD)(aTime * 1000.0f), QS_ALLINPUT);
+	}
+
+	mIdleTime += RealTimeSince (idleCount);
+} // end WaitForTick function.
+
 /* Version history.
 
+=== 2.4
+UseSimulatedClock() drives GameTimer's simulated clock from the fixed tick, e.g. so a recorded game can be replayed headless.
+The loop and the idle time are timed on the performance counter directly rather than with GameTimer objects.
+
+=== 2.3
+Message loop runs ProcessFrame() at a fixed tick rate (SetTickRate()) from an accumulator of real elapsed time,
+with the tick length passed as the delta time.
+Waits for the next tick on a (high resolution where available) waitable timer instead of spinning; messages end the wait.
+Tick count and idle fraction are kept for load measurement.
+Key down/up messages are passed to the InputQueue.
+
 === 2.2.1
 Added check for return value of ProcessFrame() in message processing loop;
 - if returned false then the loop (& hence application) is terminated.
@@ -1,7 +1,7 @@
 /*
 	File:	winCore.hpp
-	Version:	2.2
-	Date: 22nd April 2013; August 2012; 2006.
+	Version:	2.4
+	Date: 18th October 2026; 22nd April 2013; August 2012; 2006.
 	Author:	Allan C. Milne
 
 	Namespace:	AllanMilne
@@ -15,6 +15,13 @@
 	You should instantiate an object of this WinCore class,
 	passing the pointer to an object of a class implementing IState as an argument to the constructor.
 
+	The message loop runs the application at a fixed tick rate;
+	*	real elapsed time is accumulated and IState::ProcessFrame() is called once for each whole tick, always with the tick length as its delta time;
+	*	when no tick is due the loop waits, on a high resolution waitable timer where available, until the next tick or a window message;
+	*	the tick count and the fraction of time spent waiting are kept so the load can be inspected;
+	*	with UseSimulatedClock(true), GameTimer's simulated clock is advanced by the tick length after each tick, so every
+		GameTimer in the game sees exactly the fixed ticks, as a headless run does, rather than the real time between them.
+
 */
 
 #ifndef __WINCORE_HPP__
@@ -25,9 +32,6 @@
 #include <string>
 using std::string;
 
-// forward declaration of non-namespaced component.
-class GameTimer;
-
 namespace AllanMilne {
 
 // forward declaration of AllanMilne namespace component.
@@ -58,13 +62,42 @@ public:
 	//--- The state object Cleanup() function is called when the loop terminates.
 	void RunApp ();
 
+	//--- Set the number of ticks (calls to ProcessFrame) per second; must be called before RunApp().
+	//--- Values <= 0 are ignored; the default is DefaultTickRate.
+	void SetTickRate (const float aTickRate);
+	inline float GetTickRate () const { return mTickRate; }
+
+	//--- Drive GameTimer's simulated clock from the fixed tick; must be called before Initialize(), since switching the
+	//--- simulated clock on restarts it and the timers of the objects created by IState::Initialize() must start on it.
+	void UseSimulatedClock (const bool aUseSimulated);
+
+	//--- Load information from the last or current RunApp(); the number of ticks run and the fraction (0..1) of time spent waiting.
+	inline unsigned long GetTicksRun () const { return mTicksRun; }
+	float GetIdleFraction () const;
+
+	//--- Default tick rate, and the longest real time (seconds) caught up in one pass of the loop; any more is dropped rather than
+	//--- running a burst of ticks after a stall.
+	static const float DefaultTickRate;
+	static const float MaxFrameTime;
+
 
 private:
 
 	HWND mHwnd;				// Handle to current window.
-	GameTimer *mTimer;		// Pointer to a timing class for use in calculating delta times between frames.
 	IState*mState;			// pointer to state processing object.
 
+	float mTickRate;			// ticks per second.
+	unsigned long mTicksRun;	// ticks run by RunApp().
+	float mRunTime;				// real time spent in RunApp(), in seconds.
+	float mIdleTime;			// time spent waiting for the next tick, in seconds.
+	bool mSimulatedClock;		// GameTimer's simulated clock is advanced by each tick.
+
+	//--- Seconds of real time since a performance counter value, which is moved on to now.
+	float RealTimeSince (__int64 &aCount);
+
+	//--- Wait until the given time has passed or a window message arrives.
+	void WaitForTick (HANDLE aWaitTimer, const float aTime);
+
 }; // end WinCore class.
 
 } // end AllanMilne namespace.
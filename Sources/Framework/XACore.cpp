@@ -1,7 +1,7 @@
 /* 
 	file:	XACore.cpp
-	Version:	2.3
-	Date:	18th February 2014; April 2013; 2012.
+	Version:	2.8
+	Date:	18th October 2026; 18th February 2014; April 2013; 2012.
 	Authors:	Stuart and Allan Milne.
 
 	Namespace:	AllanMilne::Audio
@@ -16,6 +16,13 @@
 	Version history:
 	2.3	corrected bug in Apply3D.
 		Did not free memory allocated for the output matrix in DSP settings.
+	2.4	added Calculate3D to calculate DSP settings without applying them;
+		used by XASound to ramp 3D settings rather than hard-setting them.
+	2.5	added the null device for headless runs, with CreateSourceVoice() and CommitChanges()
+		so XASound does not use the engine directly.
+	2.6	Apply3D() and Calculate3D() are timed by the Profiler in builds with profiling.
+	2.7	an engine callback records the processing passes in the TraceLog timeline.
+	2.8	the engine callback adds its events without taking TraceLog's lock.
 
 */
 // Include library dependencies
@@ -26,10 +33,50 @@
 
 // framework includes.
 #include "XACore.hpp"
+#include "NullSourceVoice.hpp"
+#include "Profiler.hpp"
+#include "TraceLog.hpp"
+#include "GameTimer.h"
 
 namespace AllanMilne {
 namespace Audio {
 
+//=== the engine callback, declared in XACore.hpp so that it is deleted as itself.
+
+//--- Records each processing pass as a slice on the mixer thread while a trace is running;
+//--- the sounds started since the last pass first play in this pass, so their flows end here.
+//--- It only uses TraceLog's mixer thread events, which take no lock, so the mixer never waits for the game thread.
+class TraceEngineCallback : public IXAudio2EngineCallback
+{
+public:
+	TraceEngineCallback () : mPassStart (0), mThreadNamed (false) { }
+	virtual ~TraceEngineCallback () { }
+
+	STDMETHOD_(void, OnProcessingPassStart) (THIS)
+	{
+		mPassStart = TraceLog::IsTracing() ? GameTimer::ReadPerformanceCounter() : 0;
+	}
+
+	STDMETHOD_(void, OnProcessingPassEnd) (THIS)
+	{
+		if (mPassStart == 0 || !TraceLog::IsTracing()) return;
+		TraceLog &trace = TraceLog::GetInstance();
+		if (!mThreadNamed) {
+			trace.NameMixerThread ("XAudio2 mixer");
+			mThreadNamed = true;
+		}
+		trace.AddMixerSlice ("XAudio2 processing pass", "mixer", mPassStart, GameTimer::ReadPerformanceCounter());
+		trace.EndAudibleFlows (mPassStart);
+	}
+
+	STDMETHOD_(void, OnCriticalError) (THIS_ HRESULT Error) { }
+
+private:
+	LONGLONG mPassStart;
+	bool mThreadNamed;
+}; // end TraceEngineCallback class.
+
+
 //=== static members.
 
 //--- initialize fields to indicate instance not yet created.
@@ -38,12 +85,12 @@ XACore::Status XACore::mStatus = XACore::Undefined;
 	
 //--- Create the instance, initializing XAudio2, mastering voice and X3DAudio.
 //--- Only does this if not already attempted; returns true if instance is valid, false otherwise.
-bool XACore::CreateInstance ()
+bool XACore::CreateInstance (const bool nullDevice)
 {
 	if (mStatus == Undefined)
 	{ 
 		// the constructor will set the mStatus field to indicate success or failure.
-		mInstance = new XACore(); 
+		mInstance = new XACore(nullDevice); 
 	}
 	return (mStatus == OK);
 } // end CreateInstance function.
@@ -64,6 +111,7 @@ void XACore::DeleteInstance ()
 //--- Only applies those settings compatible with the supplied flags and source voice creation flags.
 void XACore::Apply3D (IXAudio2SourceVoice *aVoice, const X3DAUDIO_EMITTER* anEmitter, const X3DAUDIO_LISTENER* aListener, const unsigned int flags) const
 {
+	PROFILE_SCOPE ("XACore::Apply3D");
 	// Guard against invalid initialisation.
 	if (mStatus != OK) return;
 
@@ -102,12 +150,54 @@ void XACore::Apply3D (IXAudio2SourceVoice *aVoice, const X3DAUDIO_EMITTER* anEmi
 	}
 } // end Apply3D function.
 
+//--- Calculate 3D audio DSP settings without applying them to a voice.
+//--- The caller sets the source/destination channel counts and provides the matrix space in the settings struct.
+void XACore::Calculate3D (const X3DAUDIO_EMITTER* anEmitter, const X3DAUDIO_LISTENER* aListener, const unsigned int flags, X3DAUDIO_DSP_SETTINGS &aSettings) const
+{
+	PROFILE_SCOPE ("XACore::Calculate3D");
+	// Guard against invalid initialisation.
+	if (mStatus != OK) return;
+	X3DAudioCalculate (m3DHandle, aListener, anEmitter, flags, &aSettings);
+} // end Calculate3D function.
+
+//--- Create a source voice routed to the mastering voice, or a NullSourceVoice on the null device.
+HRESULT XACore::CreateSourceVoice (IXAudio2SourceVoice** aVoice, const WAVEFORMATEX* aFormat, const UINT32 flags)
+{
+	if (mStatus != OK || aVoice == NULL || aFormat == NULL) return XAUDIO2_E_INVALID_CALL;
+	if (mNullDevice) {
+		*aVoice = new NullSourceVoice (*aFormat, flags);
+		return S_OK;
+	}
+	return mXAEngine->CreateSourceVoice (aVoice, aFormat, flags);
+} // end CreateSourceVoice function.
+
+//--- Apply the changes queued in an operation set; null device voices apply their changes immediately.
+HRESULT XACore::CommitChanges (const UINT32 operationSet)
+{
+	if (mStatus != OK) return XAUDIO2_E_INVALID_CALL;
+	if (mNullDevice) return S_OK;
+	return mXAEngine->CommitChanges (operationSet);
+} // end CommitChanges function.
+
 //--- private constructor to hide it from explicit instantiation;
 //--- initializes XAudio2, X3DAudio and the listener.
 //--- sets the status flag.
-XACore::XACore () 
-	: mXAEngine(NULL), mMasteringVoice(NULL), mChannelCount(0)
+XACore::XACore (const bool nullDevice) 
+	: mXAEngine(NULL), mMasteringVoice(NULL), mChannelCount(0), mNullDevice(nullDevice), mEngineCallback(NULL)
 {
+	if (mNullDevice)
+	{
+		// No engine or device; describe a stereo device so 3D calculations have an output format to work to.
+		SecureZeroMemory (&mDetails, sizeof(XAUDIO2_DEVICE_DETAILS));
+		mDetails.OutputFormat.Format.nChannels = 2;
+		mDetails.OutputFormat.Format.nSamplesPerSec = 44100;
+		mDetails.OutputFormat.dwChannelMask = SPEAKER_STEREO;
+		mChannelCount = 2;
+		X3DAudioInitialize (SPEAKER_STEREO, X3DAUDIO_SPEED_OF_SOUND, m3DHandle);
+		mStatus = OK;
+		return;
+	}
+
 	HRESULT hr;		// use to catch XAudio2 function call results.
 	CoInitializeEx( NULL, COINIT_MULTITHREADED );
 	hr = XAudio2Create (&mXAEngine, 0, XAUDIO2_DEFAULT_PROCESSOR);
@@ -120,6 +210,10 @@ XACore::XACore ()
 		return;
 	}
 	mXAEngine->StartEngine();
+#ifdef TRACING_ENABLED
+	mEngineCallback = new TraceEngineCallback ();
+	mXAEngine->RegisterForCallbacks (mEngineCallback);
+#endif
 	// Retrieve information about the audio device.
 	// Note the Windows 8 SdK distribution of XAudio2 requires an alternative approach to retrieving this information.
 	mXAEngine->GetDeviceDetails (0, &mDetails); 
@@ -151,11 +245,15 @@ XACore::~XACore ()
 {
 	if (mXAEngine != NULL)
 		mXAEngine->StopEngine ();
+	if (mXAEngine != NULL && mEngineCallback != NULL)
+		mXAEngine->UnregisterForCallbacks (mEngineCallback);
+	delete mEngineCallback;
 	if (mMasteringVoice != NULL)
 		mMasteringVoice->DestroyVoice ();
 	if (mXAEngine != NULL) 
 		mXAEngine->Release();
-	CoUninitialize();
+	if (!mNullDevice)
+		CoUninitialize();
 	mInstance = NULL;
 	mStatus = Undefined;
 } // end destructor method.
@@ -1,6 +1,6 @@
 /*
 	file:	XACore.hpp
-	Version:	2.3
+	Version:	2.7
 	Date:	23rd April 2013; 2012.
 	Authors:	Stuart and Allan Milne.
 
@@ -13,6 +13,12 @@
 	as defined in the IXACore interface;
 	* see IXACore.hpp for details.
 	this introduces the static members required for the singleton pattern.
+
+	The instance can be created on a null device for headless runs; there is then no XAudio2 engine or mastering voice,
+	X3DAudio is set up for stereo output, and source voices are NullSourceVoice objects that simulate playback.
+
+	On a real device an engine callback records each XAudio2 processing pass on the mixer thread's track while a
+	TraceLog trace is running, and ends the trace flows of the sounds started since the last pass.
 	
 */
 
@@ -29,6 +35,9 @@
 namespace AllanMilne {
 namespace Audio {
 
+// forward declarations.
+	class TraceEngineCallback;
+
 class XACore : public IXACore
 {
 public:
@@ -37,8 +46,9 @@ public:
 	static inline IXACore* GetInstance() { return mInstance; }
 
 	//--- Create the instance, initializing XAudio2, mastering voice and X3DAudio.
+	//--- If nullDevice is true only X3DAudio is initialized and no audio is rendered.
 	//--- Only does this if not already attempted; returns true if instance is valid, false otherwise.
-	static bool CreateInstance ();
+	static bool CreateInstance (const bool nullDevice=false);
 
 	//--- Delete the instance, releasing resources as appropriate.
 	static void DeleteInstance ();
@@ -62,6 +72,18 @@ public:
 	//--- Default is to calculate for output matrix only
 	void Apply3D (IXAudio2SourceVoice* aVoice, const X3DAUDIO_EMITTER* anEmitter, const X3DAUDIO_LISTENER* aListener, const unsigned int flags=X3DAUDIO_CALCULATE_MATRIX) const;
 
+	//--- Calculate 3D audio DSP settings without applying them to a voice.
+	//--- The caller sets the source/destination channel counts and provides the matrix space in the settings struct.
+	void Calculate3D (const X3DAUDIO_EMITTER* anEmitter, const X3DAUDIO_LISTENER* aListener, const unsigned int flags, X3DAUDIO_DSP_SETTINGS &aSettings) const;
+
+	//--- Create a source voice routed to the mastering voice, or a NullSourceVoice on the null device.
+	HRESULT CreateSourceVoice (IXAudio2SourceVoice** aVoice, const WAVEFORMATEX* aFormat, const UINT32 flags);
+
+	//--- Apply the changes queued in an operation set; nothing to do on the null device.
+	HRESULT CommitChanges (const UINT32 operationSet);
+
+	inline bool IsNullDevice () const { return mNullDevice; }
+
 
 private:
 
@@ -71,7 +93,7 @@ private:
 
 	//--- private constructor to hide it from explicit instantiation;
 	//--- initializes XAudio2, X3DAudio and the listener.
-	XACore ();
+	XACore (const bool nullDevice);
 	virtual ~XACore ();
 
 	//--- The fundamental audio elements.
@@ -82,6 +104,8 @@ private:
 	//--- Referenced attributes provided here for efficiency.
 	int mChannelCount;			// No. of channels on audio device
 	XAUDIO2_DEVICE_DETAILS mDetails;	// Audio device information
+	bool mNullDevice;			// True if running without an XAudio2 engine.
+	TraceEngineCallback *mEngineCallback;	// Traces the processing passes; NULL on the null device.
 
 }; // end XACore interface.
 
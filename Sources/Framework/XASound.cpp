@@ -1,12 +1,12 @@
 /*
 	file:	XASound.cpp
-	Version:	2.0
+	Version:	3.5
 	Date:	22nd April 2013; September 2012.
 	Authors:	Stuart & Allan Milne.
 
 	Namespace:	AllanMilne::Audio.
 	Exposes:	XASound implementation.
-	Requires:	XACore, WaveFileManager, PCMWave.
+	Requires:	XACore, WaveFileManager, PCMWave, Profiler, TraceLog.
 
 	Description:
 	This is the implementation of the XASound class that models an XAudio2 sound encapsulating a source voice and associated sound buffer.
@@ -19,14 +19,21 @@
 // system includes.
 #define XAUDIO2_HELPER_FUNCTIONS
 #include <XAudio2.h>
+#include <X3DAudio.h>
+#include <cmath>
 #include <string>
+#include <vector>
+#include <algorithm>
 using std::string;
+using std::vector;
 
 // framework includes.
 #include "XACore.hpp"
 #include "WaveFileManager.hpp"
 #include "PCMWave.hpp"
 #include "XASound.hpp"
+#include "Profiler.hpp"
+#include "TraceLog.hpp"
 
 //=== anonymous namespace to encapsulate private helper functions.
 namespace {
@@ -42,9 +49,10 @@ namespace {
 		WAVEFORMATEX wFmt;
 		memcpy_s (&wFmt, sizeof (WaveFmt), &(aWave->GetWaveFormat()), sizeof (WaveFmt));
 		// Create the source voice for the specified wave format; return if failed.
-		// Source voice will be routed directly to the mastering voice since no target voice is specified.
+		// Source voice will be routed directly to the mastering voice since no target voice is specified;
+		// the core creates a software voice instead if it is running on the null device.
 		unsigned int flag = (filtered) ? XAUDIO2_VOICE_USEFILTER : 0;
-		HRESULT hr = XACore::GetInstance()->GetEngine()->CreateSourceVoice (aVoice, &wFmt, flag );
+		HRESULT hr = XACore::GetInstance()->CreateSourceVoice (aVoice, &wFmt, flag );
 		if( FAILED( hr ) ) return;
 
 		// Create and initialise the XAudio2 buffer struct from the PCMWave object.
@@ -64,46 +72,68 @@ namespace {
 	} // end InitXASound function.
 
 
-	//--- Apply pan value to supplied source voice.
-	//--- Assumes stereo output channels.
+	//--- Calculate the output matrix for a pan value.
+	//--- Assumes stereo output channels; the matrix must hold aChannels*2 values.
 	//--- Centred sound has output volumes at { 0.5, 0.5 }.
-	void DoPan (const float aPan, IXAudio2SourceVoice *aVoice)
+	void DoPan (const float aPan, const UINT32 aChannels, float *aMatrix)
 	{
-		XAUDIO2_VOICE_DETAILS details;
-		aVoice->GetVoiceDetails(&details);
-		int matrixSize = details.InputChannels * 2;			// assuming stereo output channels.
-		float *matrix = new float[matrixSize];
+		int matrixSize = aChannels * 2;			// assuming stereo output channels.
 		float halfPan = aPan / 2.0f;
 		for (int i=0; i<matrixSize; i+=2)
-			matrix[i] = 0.5f - halfPan;
+			aMatrix[i] = 0.5f - halfPan;
 		for (int i=1; i<matrixSize; i+=2)
-			matrix[i] = 0.5f + halfPan;
-		// 1st param = NULL indicates single destination voice.
-		aVoice->SetOutputMatrix(NULL, details.InputChannels, 2, matrix);
-		delete [] matrix;
+			aMatrix[i] = 0.5f + halfPan;
 	} // end doPan function.
 
+	//--- Linear interpolation between two parameter values; aFraction is 0..1.
+	inline float Lerp (const float aFrom, const float aTo, const float aFraction)
+	{
+		return aFrom + (aTo - aFrom) * aFraction;
+	} // end Lerp function.
+
+	//--- Limit a frequency ratio to the range allowed for a source voice created with the default maximum ratio.
+	inline float ClampFrequencyRatio (const float aRatio)
+	{
+		if (aRatio < XAUDIO2_MIN_FREQ_RATIO) return XAUDIO2_MIN_FREQ_RATIO;
+		if (aRatio > XAUDIO2_DEFAULT_FREQ_RATIO) return XAUDIO2_DEFAULT_FREQ_RATIO;
+		return aRatio;
+	} // end ClampFrequencyRatio function.
+
 } // end anonymous namespace.
 
 
 namespace AllanMilne {
 namespace Audio {
 
+//=== static members.
+
+//--- A ramp lasts 5 XAudio2 processing quanta of 10ms; the steps are sent by CommitChanges(), at most 4 of them, so a 60Hz
+//--- frame (16.7ms) takes a ramp a third of the way. A ramp of one quantum would always be complete by the first commit.
+const float XASound::RampTime = 0.05f;
+const int XASound::RampSteps = 4;
+
+vector<XASound*> XASound::mQueuedSounds;
+UINT32 XASound::mOperationSet = 0;
+float XASound::mCommitElapsed = 0.0f;
+
 //=== Behaviour extending the ISound interface.
 
 //--- Overloaded constructor methods:
 //--- Provide a .wav file name.
 XASound::XASound (const string &aFileName, const bool filtered)
-	: mSourceVoice(NULL), mIsPaused(false), mPan(0)
+	: mSourceVoice(NULL), mWave(NULL), mIsPaused(false), mPan(0), mVoiceStarted(false)
 {
 	PCMWave *waveBuffer = WaveFileManager::GetInstance().LoadWave (aFileName);
+	mWave = waveBuffer;
 	InitXASound (waveBuffer, filtered, &mSourceVoice, &mXABuffer);
+	InitParameters ();
 } // end constructor with file name.
 //--- Provide an encapsulated wave buffer.
 XASound::XASound (PCMWave *aWave, const bool filtered)
-	: mSourceVoice(NULL), mIsPaused(false), mPan(0)
+	: mSourceVoice(NULL), mWave(aWave), mIsPaused(false), mPan(0), mVoiceStarted(false)
 {
 	InitXASound (aWave, filtered, &mSourceVoice, &mXABuffer);
+	InitParameters ();
 } // end constructor with PCMWave.
 //--- end overloaded constructor functions.
 
@@ -112,6 +142,9 @@ XASound::XASound (PCMWave *aWave, const bool filtered)
 //--- Do not delete data buffer referenced by mXABuffer since we were not responsible for creating it.
 XASound::~XASound ()
 {
+	if (mQueued) {
+		mQueuedSounds.erase (std::remove (mQueuedSounds.begin(), mQueuedSounds.end(), this), mQueuedSounds.end());
+	}
 	if (mSourceVoice != NULL) {
 		mSourceVoice->Stop();
 		mSourceVoice->FlushSourceBuffers();
@@ -128,8 +161,210 @@ void XASound::RouteToSubmixVoice (IXAudio2SubmixVoice* aSubmixVoice)
 	XAUDIO2_SEND_DESCRIPTOR sendDesc = { 0, aSubmixVoice };
 	XAUDIO2_VOICE_SENDS sendList = { 1, &sendDesc };
 	mSourceVoice->SetOutputVoices (&sendList);
+	mMatrixDstChannels = 0;
+	mMatrixSent = false;
 } // end RouteToSubmixVoice function.
 
+//--- Output matrix; levels of each source channel to each destination channel, laid out as for IXAudio2Voice::SetOutputMatrix().
+//--- No effect if the channel counts do not match the source voice or the matrix is larger than MaxMatrixSize.
+void XASound::SetOutputMatrix (const float *aMatrix, const UINT32 aSrcChannels, const UINT32 aDstChannels)
+{
+	if (mSourceVoice == NULL || aSrcChannels != mChannels) return;
+	UINT32 matrixSize = aSrcChannels * aDstChannels;
+	if (matrixSize == 0 || matrixSize > MaxMatrixSize) return;
+
+	// A change of destination channels cannot be ramped from the old matrix.
+	if (aDstChannels != mMatrixDstChannels) {
+		mMatrixDstChannels = aDstChannels;
+		mMatrixSent = false;
+	}
+	else if (memcmp (mTarget.Matrix, aMatrix, matrixSize * sizeof(float)) == 0) {
+		return;		// no change to the target.
+	}
+	memcpy (mTarget.Matrix, aMatrix, matrixSize * sizeof(float));
+	TargetChanged (MatrixChange);
+} // end SetOutputMatrix function.
+
+//--- Calculate the 3D audio DSP settings for this sound's voice and set them as the targets for the output matrix,
+//--- doppler frequency ratio and direct low pass filter as selected by the flags.
+void XASound::Apply3D (const X3DAUDIO_EMITTER* anEmitter, const X3DAUDIO_LISTENER* aListener, const unsigned int flags)
+{
+	PROFILE_SCOPE ("XASound::Apply3D");
+	IXACore *core = XACore::GetInstance();
+	if (mSourceVoice == NULL || core == NULL) return;
+
+	// Set up DSP settings; the matrix is held on the stack rather than allocated for each call.
+	float matrix[MaxMatrixSize];
+	X3DAUDIO_DSP_SETTINGS DSPSettings;
+	SecureZeroMemory (&DSPSettings, sizeof(X3DAUDIO_DSP_SETTINGS));
+	DSPSettings.SrcChannelCount = mChannels;
+	DSPSettings.DstChannelCount = core->GetChannelCount();
+	DSPSettings.pMatrixCoefficients = matrix;
+	unsigned int calcFlags = flags;
+	if (DSPSettings.SrcChannelCount * DSPSettings.DstChannelCount > MaxMatrixSize) {
+		calcFlags &= ~X3DAUDIO_CALCULATE_MATRIX;
+	}
+
+	core->Calculate3D (anEmitter, aListener, calcFlags, DSPSettings);
+	Apply3DSettings (DSPSettings, calcFlags);
+} // end Apply3D function.
+
+//--- Set the targets from 3D audio DSP settings already calculated for this sound's voice.
+void XASound::Apply3DSettings (const X3DAUDIO_DSP_SETTINGS &aSettings, const unsigned int flags)
+{
+	if ((flags & X3DAUDIO_CALCULATE_MATRIX) && aSettings.pMatrixCoefficients != NULL) {
+		SetOutputMatrix (aSettings.pMatrixCoefficients, aSettings.SrcChannelCount, aSettings.DstChannelCount);
+	}
+	if ((flags & X3DAUDIO_CALCULATE_DOPPLER) && aSettings.DopplerFactor != mDopplerRatio) {
+		mDopplerRatio = aSettings.DopplerFactor;
+		mTarget.FrequencyRatio = ClampFrequencyRatio (mPitchRatio * mDopplerRatio);
+		TargetChanged (FrequencyChange);
+	}
+	if ((flags & X3DAUDIO_CALCULATE_LPF_DIRECT) && mFiltered) {
+		XAUDIO2_FILTER_PARAMETERS FilterParameters = { 
+			LowPassFilter, 
+			2.0f * sinf(X3DAUDIO_PI/6.0f * aSettings.LPFDirectCoefficient), 
+			1.0f 
+		}; 
+		SetFilterParameters (FilterParameters);
+	}
+} // end Apply3DSettings function.
+
+//--- Send the queued parameter changes of all sounds to their voices; call once per frame.
+//--- All changes are sent in one operation set so they take effect in the same processing pass.
+void XASound::CommitChanges (const float deltaTime)
+{
+	PROFILE_SCOPE ("XASound::CommitChanges");
+	const float stepTime = RampTime / RampSteps;
+	if (mQueuedSounds.empty()) {
+		// nothing waiting; the next change can be sent straight away.
+		mCommitElapsed = stepTime;
+		return;
+	}
+	// Ramps advance every frame, but changes are only sent once a ramp step has passed.
+	for (vector<XASound*>::iterator it = mQueuedSounds.begin(); it != mQueuedSounds.end(); ++it) {
+		(*it)->mRampElapsed += deltaTime;
+	}
+	mCommitElapsed += deltaTime;
+	IXACore *core = XACore::GetInstance();
+	if (mCommitElapsed < stepTime || core == NULL) return;
+	mCommitElapsed = 0.0f;
+
+	// Operation set 0 means commit now, so it is skipped when the identifier wraps.
+	if (++mOperationSet == XAUDIO2_COMMIT_NOW) ++mOperationSet;
+
+	vector<XASound*>::iterator it = mQueuedSounds.begin();
+	while (it != mQueuedSounds.end()) {
+		XASound *sound = *it;
+		// A sound that is not playing, or has just started, cannot click so takes its targets immediately.
+		float fraction = 1.0f;
+		if (!sound->mSnap && sound->IsPlaying()) {
+			fraction = sound->mRampElapsed / RampTime;
+			if (fraction > 1.0f) fraction = 1.0f;
+		}
+		sound->SendParameters (fraction, mOperationSet);
+		sound->mSnap = false;
+		if (sound->mChanges == 0) {
+			sound->mQueued = false;
+			it = mQueuedSounds.erase (it);
+		}
+		else {
+			++it;
+		}
+	}
+	core->CommitChanges (mOperationSet);
+} // end CommitChanges function.
+
+//--- Send this sound's queued parameter changes to the voice now, without a ramp.
+void XASound::ApplyChangesNow ()
+{
+	if (mChanges == 0) return;
+	SendParameters (1.0f, XAUDIO2_COMMIT_NOW);
+} // end ApplyChangesNow function.
+
+//--- Read the voice details and set the parameter state to the XAudio2 voice defaults; called from the constructors.
+void XASound::InitParameters ()
+{
+	mFiltered = false;
+	mChannels = 0;
+	mSampleRate = 0;
+	if (mSourceVoice != NULL) {
+		XAUDIO2_VOICE_DETAILS details;
+		mSourceVoice->GetVoiceDetails (&details);
+		mFiltered = ((details.CreationFlags & XAUDIO2_VOICE_USEFILTER) != 0);
+		mChannels = details.InputChannels;
+		mSampleRate = details.InputSampleRate;
+	}
+	ZeroMemory (&mTarget, sizeof(VoiceParameters));
+	mTarget.Volume = 1.0f;
+	mTarget.FrequencyRatio = 1.0f;
+	mTarget.Filter.Type = LowPassFilter;
+	mTarget.Filter.Frequency = XAUDIO2_MAX_FILTER_FREQUENCY;
+	mTarget.Filter.OneOverQ = 1.0f;
+	mStart = mTarget;
+	mCurrent = mTarget;
+	mPitchRatio = 1.0f;
+	mDopplerRatio = 1.0f;
+	mMatrixDstChannels = 0;
+	mMatrixSent = false;
+	mRampElapsed = 0.0f;
+	mSnap = false;
+	mQueued = false;
+	mChanges = 0;
+} // end InitParameters function.
+
+//--- Add this sound to the list of sounds to be committed.
+void XASound::Queue ()
+{
+	if (mQueued) return;
+	mQueuedSounds.push_back (this);
+	mQueued = true;
+} // end Queue function.
+
+//--- Record that targets have changed; restarts the ramp from the current values and queues the sound.
+//--- Several changes before the next commit only restart the ramp, so they are sent as one change.
+void XASound::TargetChanged (const int aChanges)
+{
+	mStart = mCurrent;
+	mRampElapsed = 0.0f;
+	mChanges |= aChanges;
+	Queue ();
+} // end TargetChanged function.
+
+//--- Set the current values the given fraction (0..1) along the ramp, and send the changed values to the voice.
+//--- Once the ramp is complete the changes are cleared.
+void XASound::SendParameters (const float aFraction, const UINT32 anOperationSet)
+{
+	if (mSourceVoice == NULL) return;
+	if (mChanges & VolumeChange) {
+		mCurrent.Volume = Lerp (mStart.Volume, mTarget.Volume, aFraction);
+		mSourceVoice->SetVolume (mCurrent.Volume, anOperationSet);
+	}
+	if (mChanges & FrequencyChange) {
+		mCurrent.FrequencyRatio = Lerp (mStart.FrequencyRatio, mTarget.FrequencyRatio, aFraction);
+		mSourceVoice->SetFrequencyRatio (mCurrent.FrequencyRatio, anOperationSet);
+	}
+	if ((mChanges & FilterChange) && mFiltered) {
+		mCurrent.Filter.Type = mTarget.Filter.Type;
+		mCurrent.Filter.Frequency = Lerp (mStart.Filter.Frequency, mTarget.Filter.Frequency, aFraction);
+		mCurrent.Filter.OneOverQ = Lerp (mStart.Filter.OneOverQ, mTarget.Filter.OneOverQ, aFraction);
+		mSourceVoice->SetFilterParameters (&mCurrent.Filter, anOperationSet);
+	}
+	if ((mChanges & MatrixChange) && mMatrixDstChannels > 0) {
+		// The first matrix is not ramped since the voice's default matrix is not known.
+		float fraction = (mMatrixSent) ? aFraction : 1.0f;
+		UINT32 matrixSize = mChannels * mMatrixDstChannels;
+		for (UINT32 i=0; i<matrixSize; ++i)
+			mCurrent.Matrix[i] = Lerp (mStart.Matrix[i], mTarget.Matrix[i], fraction);
+		// 1st param = NULL indicates single destination voice.
+		mSourceVoice->SetOutputMatrix (NULL, mChannels, mMatrixDstChannels, mCurrent.Matrix, anOperationSet);
+		mMatrixSent = true;
+	}
+	if (aFraction >= 1.0f) {
+		mChanges = 0;
+	}
+} // end SendParameters function.
+
 //--- Panning - is only applied if we have stereo device channels; assumes output channels = device channels.
 //--- Works best for mono sources - multiple channels will be merged.
 //--- Value is between -1 and 1;
@@ -143,7 +378,10 @@ void XASound::SetPan (const float aPan)
 	if (aPan<-1.0f || aPan>1.0f) return;
 
 	mPan = aPan;
-	DoPan (mPan, mSourceVoice);
+	float matrix[MaxMatrixSize];
+	if (mChannels * 2 > MaxMatrixSize) return;
+	DoPan (mPan, mChannels, matrix);
+	SetOutputMatrix (matrix, mChannels, 2);
 } // end SetPan function.
 
 void XASound::AdjustPan (const float anAmount)
@@ -155,7 +393,10 @@ void XASound::AdjustPan (const float anAmount)
 	mPan += anAmount;
 	if (mPan < -1.0f) mPan = -1.0f;
 	if (mPan >1.0f) mPan = 1.0f;
-	DoPan (mPan, mSourceVoice);
+	float matrix[MaxMatrixSize];
+	if (mChannels * 2 > MaxMatrixSize) return;
+	DoPan (mPan, mChannels, matrix);
+	SetOutputMatrix (matrix, mChannels, 2);
 } // end AdjustPan function.
 
 
@@ -164,15 +405,16 @@ void XASound::AdjustPan (const float anAmount)
 
 float XASound::GetPitch () const
 {
-	float freqRatio;
-	mSourceVoice->GetFrequencyRatio (&freqRatio);
-	return XAudio2FrequencyRatioToSemitones (freqRatio);
+	return XAudio2FrequencyRatioToSemitones (mPitchRatio);
 } // end GetPitch function.
 
 void XASound::SetPitch (const float aPitch)
 {
 	float freqRatio = XAudio2SemitonesToFrequencyRatio (aPitch);
-	mSourceVoice->SetFrequencyRatio (freqRatio);
+	if (freqRatio == mPitchRatio) return;
+	mPitchRatio = freqRatio;
+	mTarget.FrequencyRatio = ClampFrequencyRatio (mPitchRatio * mDopplerRatio);
+	TargetChanged (FrequencyChange);
 } // end SetPitch function.
 
 void XASound::AdjustPitch (const float anAmount)
@@ -182,39 +424,33 @@ void XASound::AdjustPitch (const float anAmount)
 	SetPitch (semi);
 } // end AdjustPitch function.
 
+//--- The doppler ratio is combined with the pitch in the same way as by Apply3D().
+void XASound::SetDopplerRatio (const float aRatio)
+{
+	if (aRatio <= 0.0f || aRatio == mDopplerRatio) return;
+	mDopplerRatio = aRatio;
+	mTarget.FrequencyRatio = ClampFrequencyRatio (mPitchRatio * mDopplerRatio);
+	TargetChanged (FrequencyChange);
+} // end SetDopplerRatio function.
+
 
 //--- Filtering behaviour; if source voice has not been enabled with filtering then these functions have no effect.
-
-bool XASound::IsFiltered () const
-{
-	XAUDIO2_VOICE_DETAILS details;
-	mSourceVoice->GetVoiceDetails (&details);
-	return ((details.CreationFlags & XAUDIO2_VOICE_USEFILTER) != 0);
-} // end IsFiltered function.
+//--- The getters return the target filter parameters.
 
 //--- Returns cut-off frequency in Hz.
 float XASound::GetFilterCutoffFrequency () const
 {
 	if (!IsFiltered()) return 0.0f;
-	XAUDIO2_FILTER_PARAMETERS params;
-	mSourceVoice->GetFilterParameters (&params);
-	XAUDIO2_VOICE_DETAILS details;
-	mSourceVoice->GetVoiceDetails (&details);
-	return XAudio2RadiansToCutoffFrequency (params.Frequency, static_cast<float>(details.InputSampleRate));
+	return XAudio2RadiansToCutoffFrequency (mTarget.Filter.Frequency, static_cast<float>(mSampleRate));
 } // end GetFilterCutoffFrequency function.
 
 //--- Sets cut-off frequency in Hz; if <0 then sets to 0Hz.
 void XASound::SetFilterCutoffFrequency (const float aFrequency)
 {
 	if (!IsFiltered()) return;
-	XAUDIO2_FILTER_PARAMETERS params;
-	mSourceVoice->GetFilterParameters (&params);
-	XAUDIO2_VOICE_DETAILS details;
-	mSourceVoice->GetVoiceDetails (&details);
-	float freq = (aFrequency<0) ? 0.0f : XAudio2CutoffFrequencyToRadians (aFrequency, details.InputSampleRate);
-	params.Frequency = freq;
-	mSourceVoice->SetFilterParameters (&params);
-	return;
+	XAUDIO2_FILTER_PARAMETERS params = mTarget.Filter;
+	params.Frequency = (aFrequency<0) ? 0.0f : XAudio2CutoffFrequencyToRadians (aFrequency, mSampleRate);
+	SetFilterParameters (params);
 } // end SetFilterCutoffFrequency function.
 
 //--- Adjust cutoff frequency in Hz; will not go below 0.
@@ -228,9 +464,7 @@ void XASound::AdjustFilterCutoffFrequency (const float anAmount)
 //--- In range 0 to 1.
 float XASound::GetFilter1OverQ () const
 {
-	XAUDIO2_FILTER_PARAMETERS params;
-	mSourceVoice->GetFilterParameters (&params);
-	return params.OneOverQ;
+	return mTarget.Filter.OneOverQ;
 } // end GetFilter1OverQ function.
 
 //--- if < 0 set to 0; if >1 set to 1.
@@ -238,10 +472,9 @@ void XASound::SetFilter1OverQ (const float a1OverQ)
 {
 	float q = (a1OverQ<0.0f) ? 0.0f : a1OverQ;
 	if (q > 1.0f) q = 1.0f;
-	XAUDIO2_FILTER_PARAMETERS params;
-	mSourceVoice->GetFilterParameters (&params);
+	XAUDIO2_FILTER_PARAMETERS params = mTarget.Filter;
 	params.OneOverQ = q;
-	mSourceVoice->SetFilterParameters (&params);
+	SetFilterParameters (params);
 } // end SetFilter1OverQ function.
 
 //--- Range as for above.
@@ -253,49 +486,47 @@ void XASound::AdjustFilter1OverQ (const float anAmount)
 
 XAUDIO2_FILTER_TYPE XASound::GetFilterType () const
 {
-	XAUDIO2_FILTER_PARAMETERS params;
-	mSourceVoice->GetFilterParameters (&params);
-	return params.Type;
+	return mTarget.Filter.Type;
 } // end GetFiltertype function.
 
 void XASound::SetFilterType (const XAUDIO2_FILTER_TYPE aType)
 {
-	XAUDIO2_FILTER_PARAMETERS params;
-	mSourceVoice->GetFilterParameters (&params);
+	XAUDIO2_FILTER_PARAMETERS params = mTarget.Filter;
 	params.Type = aType;
-	mSourceVoice->SetFilterParameters (&params);
+	SetFilterParameters (params);
 } // end SetFilterType function.
 
 //--- Set all filter parameters explicitly; frequency is in Hz; limits as above.
 void XASound::SetFilter (const XAUDIO2_FILTER_TYPE aType, const float aFrequency, const float a1OverQ)
 {
 	if (!IsFiltered()) return;
-	XAUDIO2_VOICE_DETAILS details;
-	mSourceVoice->GetVoiceDetails (&details);
 	XAUDIO2_FILTER_PARAMETERS params;
-	params.Frequency = (aFrequency<0.0f) ? 0.0f : XAudio2CutoffFrequencyToRadians (aFrequency, details.InputSampleRate);
+	params.Frequency = (aFrequency<0.0f) ? 0.0f : XAudio2CutoffFrequencyToRadians (aFrequency, mSampleRate);
 	params.Type = aType;
 	float q = (a1OverQ<0.0f) ? 0.0f : a1OverQ;
 	if (q > 1.0f) q = 1.0f;
 	params.OneOverQ = q;
-	mSourceVoice->SetFilterParameters (&params);
+	SetFilterParameters (params);
 } // end SetFilter function.
 
-//--- returns the underlying XAudio2 filter struct.
+//--- returns the target filter parameters; zeroed if the sound is not filtered.
 XAUDIO2_FILTER_PARAMETERS XASound::GetFilterParameters () const
 {
 	XAUDIO2_FILTER_PARAMETERS params;
 	ZeroMemory (&params, sizeof(XAUDIO2_FILTER_PARAMETERS));
 	if (!IsFiltered()) return params;
-	mSourceVoice->GetFilterParameters(&params);
-	return params;
+	return mTarget.Filter;
 } // end GetFilterParameters function.
 
 //--- Set using an XAudio2 filter parameters struct.
+//--- All other filter mutators come through here; a change of filter type takes effect at the start of the ramp.
 void XASound::SetFilterParameters (XAUDIO2_FILTER_PARAMETERS &aParameters)
 {
 	if (!IsFiltered()) return;
-	mSourceVoice->SetFilterParameters (&aParameters);
+	if (aParameters.Type == mTarget.Filter.Type && aParameters.Frequency == mTarget.Filter.Frequency
+		&& aParameters.OneOverQ == mTarget.Filter.OneOverQ) return;
+	mTarget.Filter = aParameters;
+	TargetChanged (FilterChange);
 } // end SetFilterParameters function.
 
 
@@ -303,17 +534,41 @@ void XASound::SetFilterParameters (XAUDIO2_FILTER_PARAMETERS &aParameters)
 
 //--- Play the sound with associated flags;
 //--- always plays from the start of the sound sample, even if previously paused.
-//--- No action if already playing.
+//--- No action if already playing; the sound stays stopped if the voice rejects its buffer.
 void XASound::Play (int aFlags)
 {
 	if (IsPlaying()) { return; }
+	TRACE_SCOPE ("XASound::Play", "audio");
 	if (mIsPaused)
 	{	// reset buffer.
 		mSourceVoice->FlushSourceBuffers();
 		mIsPaused = false;
 	}
-	mSourceVoice->SubmitSourceBuffer (&mXABuffer);
-	mSourceVoice->Start (aFlags, XAUDIO2_COMMIT_NOW);
+	// The sound starts with its target parameters; changes made in the rest of this frame are not ramped either.
+	ApplyChangesNow ();
+	mSnap = true;
+	Queue ();
+	// a buffer the voice rejects, e.g. with an invalid play or loop region, leaves the sound stopped.
+	if (FAILED (mSourceVoice->SubmitSourceBuffer (&mXABuffer))) { return; }
+	if (FAILED (mSourceVoice->Start (aFlags, XAUDIO2_COMMIT_NOW))) {
+		mSourceVoice->FlushSourceBuffers();
+		return;
+	}
+	mVoiceStarted = true;
+#ifdef TRACING_ENABLED
+	// Continue the flow of the command that started the sound, to end when the mixer first plays it;
+	// the null device has no mixer passes, so there the flow ends here.
+	if (TraceLog::IsTracing() && TraceLog::GetCurrentFlow() != 0) {
+		TraceLog &trace = TraceLog::GetInstance();
+		if (XACore::GetInstance()->IsNullDevice()) {
+			trace.EndAudibleFlowNow (TraceLog::GetCurrentFlow());
+		}
+		else {
+			trace.AddFlow ("Sound start", "audio", TraceLog::FlowStep, TraceLog::GetCurrentFlow());
+			trace.QueueAudibleFlow (TraceLog::GetCurrentFlow());
+		}
+	}
+#endif
 } // end Play method.
 
 //--- Stop the sound plaing; play position is reset back to the start of the sound sample.
@@ -323,9 +578,11 @@ void XASound::Stop ()
 {
 	if (IsPlaying() || mIsPaused)
 	{
+		TRACE_SCOPE ("XASound::Stop", "audio");
 		mSourceVoice->Stop();
 		mSourceVoice->FlushSourceBuffers();
 		mIsPaused = false;
+		mVoiceStarted = false;
 	}
 } // end Stop method.
 
@@ -337,6 +594,7 @@ void XASound::Pause ()
 	{
 		mSourceVoice->Stop();
 		mIsPaused = true;
+		mVoiceStarted = false;
 	}
 } // end Pause method.
 
@@ -348,6 +606,7 @@ void XASound::Unpause ()
 	{
 		mSourceVoice->Start(0);
 		mIsPaused = false;
+		mVoiceStarted = true;
 	}
 } // end Unpause method.
 
@@ -359,12 +618,15 @@ void XASound::TogglePause ()
 } // end TogglePause method.
 
 //--- Returns true if sound is actually playing; i.e. not stopped or paused.
+//--- The voice is only asked while it has been started; once its buffer has finished it cannot play again until Play() is called.
 bool XASound::IsPlaying () const
 {
-	if (mIsPaused) { return false; }
+	PROFILE_SCOPE ("XASound::IsPlaying");
+	if (mIsPaused || !mVoiceStarted) { return false; }
 	XAUDIO2_VOICE_STATE vState;
 	mSourceVoice->GetState (&vState);
-	return ( vState.BuffersQueued > 0 );
+	mVoiceStarted = ( vState.BuffersQueued > 0 );
+	return mVoiceStarted;
 } // end IsPlaying method.
 
 //--- Volume controls; actioned for all states.
@@ -373,9 +635,7 @@ bool XASound::IsPlaying () const
 
 float XASound::GetVolume () const
 {
-	float volume;
-	mSourceVoice->GetVolume (&volume);
-	return XAudio2AmplitudeRatioToDecibels (volume);
+	return XAudio2AmplitudeRatioToDecibels (mTarget.Volume);
 } // end GetVolume method.
 
 //--- Does nothing if supplied value is out of XAudio2 allowable range.
@@ -384,7 +644,9 @@ void XASound::SetVolume (const float aVolume)
 	float ampRatio = XAudio2DecibelsToAmplitudeRatio (aVolume);
 	// Guard against to large or small values.
 	if (ampRatio<-XAUDIO2_MAX_VOLUME_LEVEL || ampRatio>XAUDIO2_MAX_VOLUME_LEVEL) { return; }
-	mSourceVoice->SetVolume (ampRatio);
+	if (ampRatio == mTarget.Volume) { return; }
+	mTarget.Volume = ampRatio;
+	TargetChanged (VolumeChange);
 } // end SetVolume method.
 
 //--- Does nothing if supplied value is out of XAudio2 allowable range.
@@ -409,11 +671,69 @@ void XASound::SetLooped (const bool aLooped)
 	if (IsPlaying() || mIsPaused) { return; }
 	if (aLooped) {
 		mXABuffer.LoopCount = XAUDIO2_LOOP_INFINITE;
+		LoopWaveOrRegion ();
 	}
 	else {
+		mXABuffer.LoopBegin = 0;
+		mXABuffer.LoopLength = 0;
 		mXABuffer.LoopCount = 0;
 	}
 } // end SetLooped method.
 
+//--- Only actioned if the sound is stopped and the region is within the wave.
+void XASound::SetPlayRegion (const UINT32 aBegin, const UINT32 aLength)
+{
+	// Guard against playing or paused.
+	if (IsPlaying() || mIsPaused || mWave == NULL) { return; }
+	UINT32 frames = mWave->GetDataSize() / mWave->GetWaveFormat().nBlockAlign;
+	if (aBegin >= frames || aLength > frames - aBegin) { return; }
+	if (aBegin > 0 && aLength == 0) {
+		// XAudio2 only takes a length of 0 for the whole buffer.
+		mXABuffer.PlayLength = frames - aBegin;
+	}
+	else {
+		mXABuffer.PlayLength = aLength;
+	}
+	mXABuffer.PlayBegin = aBegin;
+	if (IsLooped()) {
+		LoopWaveOrRegion ();
+	}
+} // end SetPlayRegion method.
+
+//--- Only actioned if the sound is looped and stopped, and the loop is within the region being played.
+void XASound::SetLoopRegion (const UINT32 aBegin, const UINT32 aLength)
+{
+	// Guard against playing, paused or not looped.
+	if (IsPlaying() || mIsPaused || !IsLooped() || mWave == NULL) { return; }
+	if (aLength == 0) {
+		LoopWaveOrRegion ();
+		return;
+	}
+	UINT32 playEnd = (mXABuffer.PlayLength > 0) ? mXABuffer.PlayBegin + mXABuffer.PlayLength : mWave->GetDataSize() / mWave->GetWaveFormat().nBlockAlign;
+	if (aBegin < mXABuffer.PlayBegin || aBegin >= playEnd || aLength > playEnd - aBegin) { return; }
+	mXABuffer.LoopBegin = aBegin;
+	mXABuffer.LoopLength = aLength;
+} // end SetLoopRegion method.
+
+//--- No action if the sound is not looped or not playing.
+void XASound::ExitLoop ()
+{
+	if (!IsLooped() || !IsPlaying()) { return; }
+	mSourceVoice->ExitLoop (XAUDIO2_COMMIT_NOW);
+} // end ExitLoop method.
+
+//--- The wave's loop if it is within the region being played, otherwise the region; both are 0 for the whole wave.
+void XASound::LoopWaveOrRegion ()
+{
+	mXABuffer.LoopBegin = mXABuffer.PlayBegin;
+	mXABuffer.LoopLength = mXABuffer.PlayLength;
+	if (mWave == NULL || !mWave->HasLoop()) { return; }
+	UINT32 playEnd = (mXABuffer.PlayLength > 0) ? mXABuffer.PlayBegin + mXABuffer.PlayLength : mWave->GetDataSize() / mWave->GetWaveFormat().nBlockAlign;
+	if (mWave->GetLoopBegin() >= mXABuffer.PlayBegin && mWave->GetLoopBegin() + mWave->GetLoopLength() <= playEnd) {
+		mXABuffer.LoopBegin = mWave->GetLoopBegin();
+		mXABuffer.LoopLength = mWave->GetLoopLength();
+	}
+} // end LoopWaveOrRegion function.
+
 } // end audio namespace.
 } // end AllanMilne namespace.
\ No newline at end of file
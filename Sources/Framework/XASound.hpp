@@ -1,6 +1,6 @@
 /*
 	file:	XASound.hpp
-	Version:	2.1
+	Version:	3.5
 	Date:	23rd April 2013; September 2012.
 	Authors:	Stuart & Allan Milne.
 
@@ -28,6 +28,26 @@
 	mutator functions for pan, pitch and filtering are defined as virtual;
 	this allows XA3DSound to override with empty functions since these attributes are not relevant if using 3D.
 
+	Volume, pan/output matrix, pitch and filter changes are not sent to the source voice when the mutators are called.
+	* The mutators record a target value and queue the sound; the getters return these targets.
+	* CommitChanges() should be called once per frame; it sends the queued changes of all sounds as a single XAudio2 operation set,
+	so several changes to a parameter within a frame collapse into one voice call.
+	* While a sound is playing each change is ramped from the value last sent to the new target over RampTime, in up to RampSteps
+	steps, rather than being hard-set; this removes the clicks (zipper noise) of abrupt changes.
+	The steps can only be sent when CommitChanges() is called, so the ramp spans several frames: at 60 frames a second a change
+	reaches its target in 3 steps, one per frame. A target that changes every frame is followed a step behind.
+	* A sound that is stopped or has just been started takes its targets immediately, with no ramp.
+
+	The voice is only asked for what this class cannot know itself.
+	* The voice details (channels, sample rate and whether the voice was created with a filter) are read once when the sound is created.
+	* IsPlaying() only asks for the voice state while the voice has been started and its buffer may still be playing;
+	a stopped, paused or finished sound is known not to be playing without asking.
+
+	A looped sound repeats the whole of the region being played unless its wave marks a loop (see PCMWave.hpp).
+	* If the wave's loop is within the region, the frames before the loop are played once as an intro and the loop is repeated;
+	a long recording can then be held as a short intro and loop rather than looped whole.
+	* SetLoopRegion() loops another part of the region; ExitLoop() ends the looping so the frames after the loop play as an outro.
+
 */
 
 #ifndef __XASOUND_HPP__
@@ -35,8 +55,11 @@
 
 // system includes.
 #include <XAudio2.h>
+#include <X3DAudio.h>
 #include <string>
+#include <vector>
 using std::string;
+using std::vector;
 
 // framework include.
 #include "ISound.hpp"
@@ -61,6 +84,10 @@ public:
 	//--- Query if sound is valid; has a sourcevoice that can play back audio
 	bool IsValid() const { return GetSourceVoice() != nullptr; }
 
+	//--- The source voice's input channels and sample rate, read when the sound was created; 0 if the sound is not valid.
+	inline UINT32 GetChannelCount () const { return mChannels; }
+	inline UINT32 GetSampleRate () const { return mSampleRate; }
+
 	//--- destructor.
 	virtual ~XASound ();
 
@@ -70,9 +97,40 @@ public:
 	//--- access to the XAudio2 buffer
 	inline XAUDIO2_BUFFER& GetBuffer () { return mXABuffer; }
 
+	//--- access to the wave data this sound plays; the wave is owned by the WaveFileManager or the client, not by this sound.
+	//--- Allows further voices to be created that share the same sample data.
+	inline PCMWave* GetWave () const { return mWave; }
+
 	//--- Route this sound through the specified submix voice.
+	//--- The output matrix is for the new destination, so the next one set is not ramped from the old.
 	void RouteToSubmixVoice (IXAudio2SubmixVoice* aSubmixVoice);
 
+	//--- Output matrix; levels of each source channel to each destination channel, laid out as for IXAudio2Voice::SetOutputMatrix().
+	//--- No effect if the channel counts do not match the source voice or the matrix is larger than MaxMatrixSize.
+	void SetOutputMatrix (const float *aMatrix, const UINT32 aSrcChannels, const UINT32 aDstChannels);
+
+	//--- Calculate the 3D audio DSP settings for this sound's voice and set them as the targets for the output matrix,
+	//--- doppler frequency ratio and direct low pass filter as selected by the flags.
+	//--- The doppler ratio is combined with the pitch; the filter is only set if the sound is filtered.
+	void Apply3D (const X3DAUDIO_EMITTER* anEmitter, const X3DAUDIO_LISTENER* aListener, const unsigned int flags=X3DAUDIO_CALCULATE_MATRIX);
+
+	//--- Set the targets from 3D audio DSP settings already calculated for this sound's voice, as Apply3D() does once it has
+	//--- calculated them; e.g. settings a client has kept for a listener pose it comes back to.
+	void Apply3DSettings (const X3DAUDIO_DSP_SETTINGS &aSettings, const unsigned int flags);
+
+	//--- Send the queued parameter changes of all sounds to their voices; call once per frame.
+	//--- Parameters are stepped towards their targets by the time passed; does nothing until 1/RampSteps of a ramp has passed.
+	static void CommitChanges (const float deltaTime);
+
+	//--- Send this sound's queued parameter changes to the voice now, without a ramp.
+	void ApplyChangesNow ();
+
+	//--- Length of a parameter ramp in seconds (several frames and XAudio2 processing quanta) and the most steps it is sent in.
+	static const float RampTime;
+	static const int RampSteps;
+	//--- Largest output matrix held; 2 source channels to 8 destination channels.
+	static const int MaxMatrixSize = 16;
+
 	//--- Panning - is only applied if we have stereo device channels; assumes output channels = device channels.
 	//--- Works best for mono sources - multiple channels will be merged.
 	//--- Value is between -1 and 1;
@@ -84,14 +142,20 @@ public:
 
 	//--- Pitch control; values are in semitones.
 	//--- this adjusts the frequency ratio of the source voice; if you want to use the native frequency ratio then access the source voice directly.
+	//--- any doppler ratio set through Apply3D() is applied on top of the pitch and is not included in GetPitch().
 	float GetPitch () const;
 	virtual void SetPitch (const float aPitch);
 	virtual void AdjustPitch (const float anAmount);
 
+	//--- Doppler part of the frequency ratio, applied on top of the pitch; 1 = no shift.
+	//--- Normally set through Apply3D(); setting it directly lets a client smooth or limit the doppler shift it calculates.
+	inline float GetDopplerRatio () const { return mDopplerRatio; }
+	void SetDopplerRatio (const float aRatio);
+
 	//--- Filtering behaviour; if source voice has not been enabled with filtering then these functions have no effect.
 	//--- cut-off frequency is in Hz; if <0 then set to 0.
 	//--- 1/Q value is between 0 and 1.0; if outside range then set to 0 or 1 respectively.
-	bool IsFiltered () const;
+	inline bool IsFiltered () const { return mFiltered; }
 	float GetFilterCutoffFrequency () const;
 	virtual void SetFilterCutoffFrequency (const float aFrequency);
 	virtual void AdjustFilterCutoffFrequency (const float anAmount);
@@ -109,7 +173,7 @@ public:
 
 	//--- Play the sound with associated flags;
 	//--- always plays from the start of the sound sample, even if previously paused.
-	//--- No action if already playing.
+	//--- No action if already playing; the sound stays stopped if the voice rejects its buffer.
 	void Play (int aFlags=0);
 
 	//--- Returns true if sound is actually playing; i.e. not stopped or paused.
@@ -138,6 +202,21 @@ public:
 	void SetLooped (const bool aLooped);
 	bool IsLooped () const;
 
+	//--- Play only a region of the wave, from a sample frame for a number of frames; a looped sound loops the region,
+	//--- or the wave's loop if it is within the region.
+	//--- A length of 0 plays to the end of the wave; (0, 0) plays the whole wave, as when the sound is created.
+	//--- Only actioned if the sound is in the stopped state and the region is within the wave.
+	void SetPlayRegion (const UINT32 aBegin, const UINT32 aLength);
+
+	//--- Loop part of the region being played, from a sample frame for a number of frames, rather than the wave's loop or the region;
+	//--- a length of 0 goes back to the wave's loop or the region.
+	//--- Only actioned if the sound is looped and in the stopped state, and the loop is within the region.
+	void SetLoopRegion (const UINT32 aBegin, const UINT32 aLength);
+
+	//--- End the looping of a playing sound; it plays to the end of its loop and then the rest of the region, and stops.
+	//--- No action if the sound is not looped or not playing; the sound loops again the next time it is played.
+	void ExitLoop ();
+
 	//--- Volume controls; actioned for all states.
 	//--- Note volume units are in dB; if you want to use the XAudio2 amplitude multiplier units then access directly via the source voice.
 	//--- Set and adjust methods do nothing if supplied value is out of XAudio2 allowable range.
@@ -149,9 +228,64 @@ protected:		// Fields are protected to allow a subclass to extend this functiona
 
 	IXAudio2SourceVoice *mSourceVoice;
 	XAUDIO2_BUFFER		mXABuffer;
+	PCMWave				*mWave;
 	bool				mIsPaused;
 	float mPan;
 
+	//--- True from starting the voice until it is stopped or paused, or IsPlaying() finds its buffer has finished;
+	//--- while false the voice is known not to be playing.
+	mutable bool		mVoiceStarted;
+
+	//--- Voice details kept so the getters and mutators do not query the voice.
+	bool				mFiltered;
+	UINT32				mChannels;
+	UINT32				mSampleRate;
+
+	//--- Parameter state for ramping; a value is held as the target, the value at the start of the current ramp,
+	//--- and the value last sent to the voice (current).
+	//--- Volume is an amplitude ratio; pitch and doppler are frequency ratios; the filter frequency is in radians.
+	struct VoiceParameters {
+		float Volume;
+		float FrequencyRatio;
+		XAUDIO2_FILTER_PARAMETERS Filter;
+		float Matrix[MaxMatrixSize];
+	};
+	VoiceParameters		mTarget, mStart, mCurrent;
+	float				mPitchRatio;			// pitch part of the target frequency ratio.
+	float				mDopplerRatio;			// doppler part of the target frequency ratio.
+	UINT32				mMatrixDstChannels;		// 0 until an output matrix has been set.
+	bool				mMatrixSent;			// false until the first matrix has been sent; it is not ramped from the voice default.
+	float				mRampElapsed;			// time into the current ramp.
+	bool				mSnap;					// send the next targets without a ramp.
+	bool				mQueued;				// in the list of sounds with changes to commit.
+	int					mChanges;				// ParameterChange flags of the parameters being ramped.
+
+	//--- Flags identifying the parameters with changes to send.
+	enum ParameterChange {
+		VolumeChange = 1, FrequencyChange = 2, FilterChange = 4, MatrixChange = 8
+	};
+
+	//--- Read the voice details and set the parameter state to the XAudio2 voice defaults; called from the constructors.
+	void InitParameters ();
+
+	//--- Add this sound to the list of sounds to be committed.
+	void Queue ();
+
+	//--- Set the loop of a looped sound to the wave's loop if it is within the region being played, otherwise to the region.
+	void LoopWaveOrRegion ();
+
+	//--- Record that the targets identified by the ParameterChange flags have changed;
+	//--- restarts the ramp from the current values and queues the sound.
+	void TargetChanged (const int aChanges);
+
+	//--- Set the current values the given fraction (0..1) along the ramp, and send the changed values to the voice.
+	void SendParameters (const float aFraction, const UINT32 anOperationSet);
+
+	//--- Sounds with changes waiting for CommitChanges(), and the operation set used for the last commit.
+	static vector<XASound*> mQueuedSounds;
+	static UINT32 mOperationSet;
+	static float mCommitElapsed;
+
 }; // end XASound class.
 
 } // end Audio namespace.
@@ -165,6 +299,44 @@ Constructor changed to take full responsibility for creating the source voice an
 - introduces optional filter enable flag.
 Volume getter/setter uses dB units rather than the amplitude multiplier.
 Introduces panning, pitch, and filtering  behaviour.
+=== 2.2
+Retains the PCMWave the sound was created from; exposed via GetWave() so that further voices can share the sample data.
+=== 2.3
+Volume, pan, pitch and filter mutators set targets that are committed once per frame through CommitChanges();
+- changes within a frame are coalesced and sent in one operation set;
+- changes to a playing sound are ramped over one processing quantum.
+Getters return the targets rather than querying the voice.
+Added SetOutputMatrix() and Apply3D() so 3D settings are ramped in the same way.
+=== 2.4
+Added SetDopplerRatio() so a client can set a smoothed doppler ratio rather than the raw ratio from Apply3D().
+=== 2.5
+Source voices are created, and operation sets committed, through XACore so sounds also work on its null device.
+=== 2.6
+Apply3D(), CommitChanges() and IsPlaying() are timed by the Profiler in builds with profiling.
+=== 2.7
+Play() and Stop() are recorded by the TraceLog in builds with tracing; Play() continues the current trace flow.
+=== 2.8
+IsPlaying() does not query the voice while the sound is known to be stopped, paused or finished;
+a tick of the game (the Room/UpdateRoom benchmark) makes 2.8 calls to the voices rather than 6.9.
+Exposes the channel count and sample rate so clients do not need to ask the voice for its details.
+=== 2.9
+Added RouteToMasteringVoice(); routing a sound starts its output matrix afresh for the new destination.
+The output matrix holds 2 source channels to 16 destinations so a stereo sound can be sent to a 3rd order AmbisonicBus.
+=== 3.0
+Added Apply3DSettings() so settings calculated earlier can be applied without calculating them again.
+=== 3.1
+Added SetPlayRegion() so a sound can play one region of a wave, e.g. a sound of a SoundSheet.
+=== 3.2
+A looped sound loops the wave's loop, if it has one within the region being played, after playing the frames before it once.
+Added SetLoopRegion() and ExitLoop() to loop part of the region and to let the sound play out after its loop.
+=== 3.3
+Play() checks that the voice took the buffer, so a sound whose buffer is rejected is not marked as playing.
+=== 3.4
+Ramps last 50ms rather than one 10ms processing quantum, so they span several frames; a frame is longer than a quantum,
+so a one quantum ramp was always complete at the first commit and the change was hard-set.
+=== 3.5
+Removed RouteToMasteringVoice() and the larger output matrix of 2.9, with the ambisonic bus they were added for;
+the output matrix is back to 2 source channels to 8 destinations.
 */
 
 #endif
\ No newline at end of file
@@ -10,7 +10,8 @@
 	This is an implementation of the Ghost class that models the ghost with its movement, emitter and event emitter.
 	* see Ghost.hpp for details.
 
-	All of the string file names for the XASound objects within the class are set in the anonymous namespace to be used for initialising
+	All of the string file names for the XASound objects within the class are set in the anonymous namespace to be used for initialising;
+	the stages' sounds given by the room's layout are used in place of the stage files
 */
 
 // System includes.
@@ -47,62 +48,76 @@ namespace
 	const string KnockingFile = "Sounds/KnockingSound.wav";
 	const string GhostYellFile = "Sounds/GhostYell.wav";
 	const string GhostDeathFile = "Sounds/GhostDeath.wav";
+
+	// Gives the sound of a stage from the layout, or the stage's own file if the layout gives none
+	string StageSound(const LayoutStage *Stages, int Stage, const RoomLayout &Layout, const string &DefaultFile)
+	{
+		const char *LayoutFile = Layout.GetString(Stages[Stage].Sound);
+		return (LayoutFile[0] != '\0') ? string(LayoutFile) : DefaultFile;
+	}
 }
 
 
 
-// Function:		Ghost(Player) - Ghost Constructor
+// Function:		Ghost(Player, unsigned int, RoomLayout, UINT32, PathFinder) - Ghost Constructor
 // Description:		The Ghost constructor sets up all of the XASound objects needed for the ghost as well as the Ghost Emitter and the
 //					Event emitter. Also calls SetUpGhost to set up the positions/settings for objects the ghost can interact with
 // In:				Player* - Pointer to the player object so that the Player's listener can be used to create the emitters and to update 
 //					them. 
+//					unsigned int Seed - the seed for the ghost's random generator, used to choose the stages and laughs
+//					const RoomLayout &Layout, UINT32 RoomIndex - the layout and room giving the stages' positions and sounds
+//					PathFinder *RoomPaths - the room's path finder, for the ghost's paths between stages; NULL to move in straight lines
 // Out:				N/a
-Ghost::Ghost (Player *PlayerListener)
+Ghost::Ghost (Player *PlayerListener, unsigned int Seed, const RoomLayout &Layout, UINT32 RoomIndex, PathFinder *RoomPaths)
+	: mPathFinder(RoomPaths), mNextWaypoint(0), mStageBag(STAGE_COUNT), mRandom(Seed, GHOST_RANDOM_STREAM)
 {
+	const LayoutStage *Stages = Layout.GetStages(RoomIndex);
+
 	// Create the XASound objects with the strings for their file names
-	mGhostDefaultSound = new XASound(DefaultGhostFile);		// Default ghost breathing sound
+	// Filtering is enabled so that the emitters' low pass distance curves can be applied to them
+	mGhostDefaultSound = new XASound(DefaultGhostFile, true);		// Default ghost breathing sound
 	mGhostSounds.push_back(mGhostDefaultSound);
 
-	mTypeWriterSound = new XASound(TypeWriterFile);			// Typewriter sound
+	mTypeWriterSound = new XASound(StageSound(Stages, TYPEWRITER, Layout, TypeWriterFile), true);	// Typewriter sound
 	mGhostSounds.push_back(mTypeWriterSound);
 
-	mPianoSound = new XASound(PianoFile);					// Piano sound
+	mPianoSound = new XASound(StageSound(Stages, PIANO, Layout, PianoFile), true);				// Piano sound
 	mGhostSounds.push_back(mPianoSound);
 
-	mDoorSound = new XASound(KnockingFile);					// Door Sound
+	mDoorSound = new XASound(StageSound(Stages, KNOCKING, Layout, KnockingFile), true);			// Door Sound
 	mGhostSounds.push_back(mDoorSound);
 
-	mGhostYellSound = new XASound(GhostYellFile);			// Ghost Yell Sound
+	mGhostYellSound = new XASound(GhostYellFile, true);			// Ghost Yell Sound
 	mGhostSounds.push_back(mGhostYellSound);
 
-	mGhostLaughSound = new XASound(GhostLaugh2File);		// Ghost Laugh Sound
+	mGhostLaughSound = new XASound(GhostLaugh2File, true);		// Ghost Laugh Sound
 	mGhostSounds.push_back(mGhostLaughSound);	
 
-	mGhostLaugh1 = new XASound(GhostLaugh1File);			// Ghost Laugh 1 Sound
+	mGhostLaugh1 = new XASound(GhostLaugh1File, true);			// Ghost Laugh 1 Sound
 	mGhostSounds.push_back(mGhostLaugh1);
 
-	mGhostLaugh2 = new XASound(GhostLaugh2File);			// Ghost Laugh 2 Sound
+	mGhostLaugh2 = new XASound(GhostLaugh2File, true);			// Ghost Laugh 2 Sound
 	mGhostSounds.push_back(mGhostLaugh2);
 
-	mGhostLaugh3 = new XASound(GhostLaugh3File);			// Ghost Laugh 3 Sound
+	mGhostLaugh3 = new XASound(GhostLaugh3File, true);			// Ghost Laugh 3 Sound
 	mGhostSounds.push_back(mGhostLaugh3);
 
-	mVoiceIntroSound = new XASound(GhostIntroFile);			// Voice Intro sound
+	mVoiceIntroSound = new XASound(GhostIntroFile, true);			// Voice Intro sound
 	mGhostSounds.push_back(mVoiceIntroSound);
 
-	mRadioSound = new XASound(RadioFile);					// Radio Sound
+	mRadioSound = new XASound(StageSound(Stages, RADIO, Layout, RadioFile), true);				// Radio Sound
 	mGhostSounds.push_back(mRadioSound);
 
-	mGhostDeathSound = new XASound(GhostDeathFile);			// Ghost Death Sound
+	mGhostDeathSound = new XASound(GhostDeathFile, true);			// Ghost Death Sound
 	mGhostSounds.push_back(mGhostDeathSound);
 
 	// Store the pointer to the Player object
 	mPlayerReference = PlayerListener;
 
-	// Position of the ghost in the scene
-	mGhostPosition.x = 8.0f;
+	// Position of the ghost in the scene; it starts just behind the door
+	mGhostPosition.x = Layout.GetRoom(RoomIndex).DoorX;
 	mGhostPosition.y = 0.0f;
-	mGhostPosition.z = -1.0f; 
+	mGhostPosition.z = Layout.GetRoom(RoomIndex).DoorZ - 1.0f;
 
 	// Initialise the Ghost Path vector to 0s
 	mGhostPath.x = 0.0f;
@@ -112,6 +127,18 @@ Ghost::Ghost (Player *PlayerListener)
 	// Create the emitters with their initial sounds, positions and the player listener, and if they loop or not
 	mGhostEmitter = new Emitter(mVoiceIntroSound, mGhostPosition, PlayerListener->GetListenerStruct(), false);
 	mEventEmitter = new Emitter(mGhostYellSound, mGhostPosition, PlayerListener->GetListenerStruct(), true);
+
+	// Use the distance curves for the ghost's voice and for its events
+	mGhostEmitter->SetEmitterType(GHOST_EMITTER);
+	mEventEmitter->SetEmitterType(EVENT_EMITTER);
+
+	// The ghost moves between its events, so its voice is doppler shifted; the events stay where they are
+	mGhostEmitter->EnableDoppler(5.0f);
+	mEventEmitter->EnablePanningTable();
+
+	// Both emitters are inside the room, so render their reflections from the walls
+	mGhostEmitter->EnableReflections();
+	mEventEmitter->EnableReflections();
 	
 	// Ghost Bool Initialisations
 	mGhostStart = true;		// Ghost is created 
@@ -122,18 +149,24 @@ Ghost::Ghost (Player *PlayerListener)
 	mAtStage = false;		// Not yet at the state
 	mGhostLaughing = false; // Ghost not laughing
 
+	// The ghost hasn't made a journey yet
+	mUnmovedTime = 0.0f;
+	mJourneySteps = 0;
+	mJourneys = 0;
+
 	// The amount of stages the ghost has been through is currently 0
 	mStageCount = 0;
 
 	// Call SetUpGhost to set up the events of the scene
-	SetUpGhost();
+	SetUpGhost(Stages);
 } 
 // end Room constructor.
 
 
 
 // Function:		~Ghost() - Ghost Destructor
-// Description:		The ghost destructor calls StopEmitter on both of the emitters within the class to stop playing their sounds
+// Description:		The ghost destructor calls StopEmitter on both of the emitters within the class to stop playing their sounds,
+//					then deletes the emitters and the sounds
 // In:				N/a
 // Out:				N/a
 Ghost::~Ghost()
@@ -141,6 +174,14 @@ Ghost::~Ghost()
 	// Stop both emitters
 	mGhostEmitter->StopEmitter();
 	mEventEmitter->StopEmitter();
+
+	// The emitters' reflections use the sounds, so the emitters are deleted first
+	delete mGhostEmitter;
+	delete mEventEmitter;
+	for (auto GhostSound = mGhostSounds.begin(); GhostSound != mGhostSounds.end(); ++ GhostSound)
+	{
+		delete *GhostSound;
+	}
 } 
 // end ghost destructor.
 	
@@ -167,32 +208,32 @@ bool Ghost::IsValid()
 
 
 
-// Function:		SetUpGhost() - Set Up Ghost function
+// Function:		SetUpGhost(LayoutStage) - Set Up Ghost function
 // Description:		This function sets the positions of the objects that the ghost can interact with in the room, and also initialises
 //					the bools to signify these stages are available to true so that the ghost can interact with them
-// In:				N/a
+// In:				const LayoutStage *Stages - the room's stages from its layout, in GhostState order
 // Out:				N/a
-void Ghost::SetUpGhost()
+void Ghost::SetUpGhost(const LayoutStage *Stages)
 {
 	// Set up the door position
-	mDoorPosition.x = 8;
+	mDoorPosition.x = Stages[KNOCKING].X;
 	mDoorPosition.y = 0;
-	mDoorPosition.z = 0;
+	mDoorPosition.z = Stages[KNOCKING].Z;
 
 	// Set up the piano position
-	mPianoPosition.x = 2;
+	mPianoPosition.x = Stages[PIANO].X;
 	mPianoPosition.y = 0;
-	mPianoPosition.z = 14;
+	mPianoPosition.z = Stages[PIANO].Z;
 
 	// Set up the typewriter position
-	mTypeWriterPosition.x = 2;
+	mTypeWriterPosition.x = Stages[TYPEWRITER].X;
 	mTypeWriterPosition.y = 0;
-	mTypeWriterPosition.z = 2;
+	mTypeWriterPosition.z = Stages[TYPEWRITER].Z;
 
 	// Set up the radio position
-	mRadioPosition.x = 13;
+	mRadioPosition.x = Stages[RADIO].X;
 	mRadioPosition.y = 0;
-	mRadioPosition.z = 9;
+	mRadioPosition.z = Stages[RADIO].Z;
 
 	// Initialise Ghost Target vector to 0 for x, y and z 
 	mGhostTargetPosition.x = 0;
@@ -204,12 +245,8 @@ void Ghost::SetUpGhost()
 	mGhostPath.y = 0;
 	mGhostPath.z = 0;
 
-	// Set the 'Available' bools to true
-	// These bools are to signify that the stages haven't been visited before, therefore they are available
-	mPianoAvailable = true;
-	mTypewriterAvailable = true;
-	mDoorAvailable = true;
-	mRadioAvailable = true;
+	// Put all of the stages in the bag, to signify that the stages haven't been visited before, therefore they are available
+	mStageBag.Refill();
 }
 // End SetUpGhost function
 
@@ -245,18 +282,18 @@ void Ghost::InitialiseGhost()
 // End InitialiseGhost function
 
 
-// Function:		UpdateGhost() - Update Ghost function
+// Function:		UpdateGhost(float) - Update Ghost function
 // Description:		This function carries out the frame updates for the ghost. The only case where this is needed is if the ghost has
 //					a new target and needs to move to that target, meaning mMoving will be set to true. This then calls 
 //					MoveGhostToNewPosition() each frame until the ghost is no longer moving. 
-// In:				N/a
+// In:				float DeltaTime - the time in seconds since the last update
 // Out:				N/a
-void Ghost::UpdateGhost()
+void Ghost::UpdateGhost(float DeltaTime)
 {
 	// If the ghost is moving from a stage to another, call this function in order to move the ghost until it reaches it's target
 	if (mMoving)
 	{
-		MoveGhostToNewPosition();
+		MoveGhostToNewPosition(DeltaTime);
 	}
 
 	// If the ghost is set to laughing
@@ -320,68 +357,130 @@ void Ghost::Stop()
 
 
 // Function:		SetGhostPath() - Set Ghost Path function
-// Description:		Finds the vector between the ghost starting position and the target position from one ghost stage to the next
-//					This vector is then used to move the ghost dynamically along that path in the MoveGhostToNewPosition function
+// Description:		Finds the path from the ghost's position round the room's walls and obstacles to its target position, as the
+//					waypoints the ghost heads for in turn; if there is no path the only waypoint is the target. Then heads the ghost
+//					for the first waypoint
 // In:				N/a
 // Out:				N/a
 void Ghost::SetGhostPath()
 {
-	// Get the vector for the start position of the ghost
-	v3f StartingPosition = {mGhostPosition.x, mGhostPosition.y, mGhostPosition.z};
-	// Get the vector for the target position of the ghost
-	// This will depend on which stage the ghost is moving to next
-	v3f TargetPosition = {mGhostTargetPosition.x, mGhostTargetPosition.y, mGhostTargetPosition.z};
-
-	// Create the Path vector (y stays at 0 as ghost only moves along the x and z plane)
-	X3DAUDIO_VECTOR PathVector;
-	// The path vector is the direction vector from the start position to the target position (therefore = target position - starting position)
-	PathVector.x = TargetPosition.x - StartingPosition.x;
-	PathVector.y = 0;
-	PathVector.z = TargetPosition.z - StartingPosition.z;
-
-	// Normalise this vector and multiply it by the speed of the ghosts movement defined in Ghost.hpp
-	float Length = sqrt((PathVector.x * PathVector.x) + (PathVector.y * PathVector.y) + (PathVector.z * PathVector.z));
+	// Find the path to the target; the ghost starts outside the room and its stages are on top of their objects, so the path
+	// finder takes it to the nearest free cells at each end. Without a path the ghost moves straight to the target
+	if ((mPathFinder == NULL) || (!mPathFinder->FindPath(mGhostPosition, mGhostTargetPosition, mGhostWaypoints)))
+	{
+		mGhostWaypoints.assign(1, mGhostTargetPosition);
+	}
+	// The ghost only moves along the x and z plane
+	for (auto Waypoint = mGhostWaypoints.begin(); Waypoint != mGhostWaypoints.end(); ++Waypoint)
+	{
+		Waypoint->y = mGhostPosition.y;
+	}
+	mNextWaypoint = 0;
+	HeadForNextWaypoint();
 
-	PathVector.x = (PathVector.x / Length) * SPEED;
-	PathVector.y = (PathVector.y / Length) * SPEED;
-	PathVector.z = (PathVector.z / Length) * SPEED;
+	// The journey's sub-steps are counted from now
+	mUnmovedTime = 0.0f;
+	mJourneySteps = 0;
 
 	// Set mMoving to true so that the ghost will update the position in the UpdateGhost function
 	mMoving = true;
+}
+// End SetGhostPath function
+
+
+
+// Function:		HeadForNextWaypoint() - Head For Next Waypoint function
+// Description:		Finds the vector from the ghost's position to its next waypoint, normalised and multiplied by the ghost's speed
+//					This vector (the ghost's velocity in units per second) is then used to move the ghost in the
+//					MoveGhostToNewPosition function
+// In:				N/a
+// Out:				N/a
+void Ghost::HeadForNextWaypoint()
+{
+	const X3DAUDIO_VECTOR &Waypoint = mGhostWaypoints[mNextWaypoint];
+
+	// The path vector is the direction vector from the ghost's position to the waypoint (y stays at 0 as ghost only moves along the x and z plane)
+	X3DAUDIO_VECTOR PathVector;
+	PathVector.x = Waypoint.x - mGhostPosition.x;
+	PathVector.y = 0;
+	PathVector.z = Waypoint.z - mGhostPosition.z;
+
+	// Normalise this vector and multiply it by the speed of the ghosts movement defined in Ghost.hpp, giving its velocity in units per second
+	float Length = sqrt((PathVector.x * PathVector.x) + (PathVector.z * PathVector.z));
+	if (Length > 0.0f)
+	{
+		PathVector.x = (PathVector.x / Length) * GHOST_SPEED;
+		PathVector.z = (PathVector.z / Length) * GHOST_SPEED;
+	}
 
-	// Store the path vector needed to move this ghost along the path
+	// Store the path vector needed to move this ghost to the waypoint
 	mGhostPath = PathVector;
 }
-// End SetGhostPath function
+// End HeadForNextWaypoint function
 
 
 
-	// Function:		MoveGhostToNewPosition() - Move Ghost To New Position function
-	// Description:		Move the ghost along the path vector found in SetGhostPath until it reaches its target position
+	// Function:		MoveGhostToNewPosition(float) - Move Ghost To New Position function
+	// Description:		Move the ghost along its path's waypoints until it reaches its target position, in sub-steps
+	//					of GHOST_SUBSTEP_TIME so that it can't pass through the target range during a long update.
 	//					Then changes the sound used for the emitter to the sound for the current state
-	// In:				N/a
+	// In:				float DeltaTime - the time in seconds to move the ghost for
 	// Out:				N/a
-void Ghost::MoveGhostToNewPosition()
+void Ghost::MoveGhostToNewPosition(float DeltaTime)
 {
-	// Set the ghost position to the current position plus the ghost path vector to move the ghost along the path
-	mGhostPosition.x += mGhostPath.x;
-	mGhostPosition.y += mGhostPath.y;
-	mGhostPosition.z += mGhostPath.z;
-
-	// Find the distance between the ghost and its target position
-	v3f GhostPos = {mGhostPosition.x, mGhostPosition.y, mGhostPosition.z };
-	v3f TargetPos = {mGhostTargetPosition.x, mGhostTargetPosition.y, mGhostTargetPosition.z };
-	float Distance = v3f::Distance(GhostPos, TargetPos);
-
-	// Set the new position of the emitter and update it to change the settings to reflect the position change
-	mGhostEmitter->SetPosition(mGhostPosition);
-	mGhostEmitter->UpdateEmitter();
+	// Move the ghost along the path's waypoints by its velocity for the time passed, so it moves at the same speed whatever the tick rate.
+	// The time is moved in sub-steps of GHOST_SUBSTEP_TIME with the arrival test after each, so a long update (a low tick rate
+	// or a stall) can't carry the ghost straight through the HIT_TARGET_RANGE of its target. Time short of a sub-step is kept
+	// for the next update, so the ghost passes through the same positions, and arrives after the same sub-steps, at any tick rate
+	mUnmovedTime += DeltaTime;
+	const unsigned int FirstStep = mJourneySteps;
+	bool Arrived = false;
+	while ((mUnmovedTime >= GHOST_SUBSTEP_TIME) && (!Arrived))
+	{
+		const float StepTime = GHOST_SUBSTEP_TIME;
+		mUnmovedTime -= StepTime;
+		mJourneySteps++;
+
+		// Move towards the next waypoint; on reaching it, stop there and head for the one after it
+		const X3DAUDIO_VECTOR &Waypoint = mGhostWaypoints[mNextWaypoint];
+		float ToX = Waypoint.x - mGhostPosition.x;
+		float ToZ = Waypoint.z - mGhostPosition.z;
+		float StepLength = GHOST_SPEED * StepTime;
+		if (((ToX * ToX) + (ToZ * ToZ)) <= (StepLength * StepLength))
+		{
+			mGhostPosition.x = Waypoint.x;
+			mGhostPosition.z = Waypoint.z;
+			if (mNextWaypoint + 1 < mGhostWaypoints.size())
+			{
+				mNextWaypoint++;
+				HeadForNextWaypoint();
+			}
+		}
+		else
+		{
+			mGhostPosition.x += mGhostPath.x * StepTime;
+			mGhostPosition.y += mGhostPath.y * StepTime;
+			mGhostPosition.z += mGhostPath.z * StepTime;
+		}
+
+		// Find the distance between the ghost and its target position
+		Arrived = (stu::batch::Distance(mGhostPosition, mGhostTargetPosition) < HIT_TARGET_RANGE);
+	}
+
+	// Set the new position of the emitter and update it to change the settings to reflect the position change; at a tick
+	// rate above 120 Hz most updates don't move the ghost
+	if (mJourneySteps != FirstStep)
+	{
+		mGhostEmitter->SetPosition(mGhostPosition);
+		mGhostEmitter->UpdateEmitter();
+	}
 
 	// If the ghost is within the HIT_TARGET_RANGE of its target position, then set the ghost to its target position and change the emitter
-	if (Distance < HIT_TARGET_RANGE)
+	if (Arrived)
 	{
 		// Ghost is no longer moving
 		mMoving = false;
+		mJourneys++;
 		// Set the ghost position to its actual target position and then update the emitter position and play it
 		mGhostPosition = mGhostTargetPosition;
 		mGhostEmitter->SetPosition(mGhostPosition);
@@ -434,7 +533,7 @@ void Ghost::DefeatGhost()
 
 // Function:		SetNewStage() - Set New Stage function
 // Description:		This function is called when the ghost needs to change its stage, and if the ghost hasn't reached its stage
-//					limit, will randomly select a stage to carry out as long as that stage is available. This ensures each play
+//					limit, will draw a stage that hasn't been visited yet from the stage bag. This ensures each play
 //					of the game is different and randomised. It then sets the ghost state, target position and path to the new stage.
 //					The Ghost yell sound is played if it is not the first movement to a stage, and the event emitter is stopped.
 // In:				N/a
@@ -452,73 +551,36 @@ void Ghost::SetNewStage()
 		return;
 	}
 
-	bool NewStageSet = false;
-	
-	// Check until the new stage is set
-	while (!NewStageSet)
+	// Draw a stage that hasn't been visited yet from the bag, so that each play of the game is different and randomised.
+	// The values in the bag correspond to the definitions for each stage in the Ghost.hpp file
+	int NewStage;
+	if (!mStageBag.Draw(mRandom, NewStage))
 	{
-		// Find a random number between 0 and 4 which corresponds to the definitions for each stage in the Ghost.hpp file
-		int NewStage = rand() % 4;
-		
-		// For each stage, if the stage is available, it will change the mCurrentState variable to the new state, it will set the ghost
-		// target position to the stages position, it will call SetGhostPath and increase the stage count for the ghost.
-		// In addition, it will make that stage no longer available, so that it can't be carried out again, and breaks out of the while loop
-		// by setting NewStageSet to true.
-
-		// If the new stage is the PIANO stage
-		if (NewStage == PIANO)
-		{
-			if (mPianoAvailable)
-			{
-				mCurrentState = PIANO;
-				mGhostTargetPosition = mPianoPosition;
-				SetGhostPath();
-				mStageCount++;
-				mPianoAvailable = false;
-				NewStageSet = true;
-			}
-		}
-		// If the new stage is the KNOCKING stage
-		if (NewStage == KNOCKING)
-		{
-			if (mDoorAvailable)
-			{
-				mCurrentState = KNOCKING;
-				mGhostTargetPosition = mDoorPosition;
-				SetGhostPath();
-				mStageCount++;
-				mDoorAvailable = false;
-				NewStageSet = true;
-			}
-		}
-		// If the new stage is the TYPEWRITER stage
-		if (NewStage == TYPEWRITER)
-		{
-			if (mTypewriterAvailable)
-			{
-				mCurrentState = TYPEWRITER;
-				mGhostTargetPosition = mTypeWriterPosition;
-				SetGhostPath();
-				mStageCount++;
-				mTypewriterAvailable = false;
-				NewStageSet = true;
-			}
-		}
-		// If the new stage is the RADIO stage
-		if (NewStage == RADIO)
-		{
-			if (mRadioAvailable)
-			{
-				mCurrentState = RADIO;
-				mGhostTargetPosition = mRadioPosition;
-				SetGhostPath();
-				mStageCount++;
-				mRadioAvailable = false;
-				NewStageSet = true;
+		// Every stage has been visited
+		DefeatGhost();
+		return;
+	}
 
-			}
-		}
+	// Change the mCurrentState variable to the new state and set the ghost target position to the stage's position
+	mCurrentState = GhostState(NewStage);
+	switch (mCurrentState)
+	{
+	case PIANO:
+		mGhostTargetPosition = mPianoPosition;
+		break;
+	case KNOCKING:
+		mGhostTargetPosition = mDoorPosition;
+		break;
+	case TYPEWRITER:
+		mGhostTargetPosition = mTypeWriterPosition;
+		break;
+	case RADIO:
+		mGhostTargetPosition = mRadioPosition;
+		break;
 	}
+	// Set the path to the new stage and increase the stage count for the ghost
+	SetGhostPath();
+	mStageCount++;
 
 	// If this is the first movement of the ghost from its starting position to the first stage, play the ghost laugh sound
 	if (mGhostStart)
@@ -565,7 +627,7 @@ void Ghost::GhostLaugh()
 void Ghost::SetGhostLaugh()
 {
 	// Find a random number between 1 and 3 and use this as the ID for the different laugh sound objects
-	int GhostLaughID = rand() % 3 + 1;
+	int GhostLaughID = mRandom.Range(1, 3);
 
 	if (GhostLaughID == 1)
 	{
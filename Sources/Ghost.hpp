@@ -5,7 +5,7 @@
 	Author:	Cassie Bennett
 
 	Exposes:	Ghost
-	Requires:	XASound, Player, Emitter, StuVector
+	Requires:	XASound, Player, Emitter, StuVector, RoomLayout, PathFinder
 
 	Description:
 	This class models the ghost within the game that has a position and is rendered in audio. 
@@ -17,9 +17,10 @@
 
 	The class exposes behaviour to:
 	*	Set up the ghost object with a Ghost emitter and an Event emitter
-	*	Set up the positions of the objects within the room that the ghost interacts with
+	*	Set up the positions and sounds of the objects within the room that the ghost interacts with, from the room's layout
 	*	Selects a new random stage out of the four possible stages for the ghost so that each playthrough is different
-	*	When the ghost selects a new stage, dynamically moves the emitter from its original position to the next stages position
+	*	When the ghost selects a new stage, dynamically moves the emitter from its original position to the next stages position,
+		along a path round the room's walls and obstacles
 	*	Plays the appropriate ghost sounds for the game and the events
 */
 
@@ -32,7 +33,9 @@
 #include <X3DAudio.h>
 #include <memory>
 #include <list>
+#include <vector>
 using std::list;
+using std::vector;
 
 // Framework includes.
 #include "XASound.hpp"
@@ -42,6 +45,10 @@ using AllanMilne::Audio::XASound;
 #include "Emitter.hpp"
 #include "Player.hpp"
 #include "StuVector3.hpp"
+#include "StuVector3Batch.hpp"
+#include "Random.hpp"
+#include "RoomLayout.hpp"
+#include "PathFinder.hpp"
 using namespace stu;
 
 // Define the detection range which is the distance the player must be within in order to affect the ghost
@@ -50,28 +57,42 @@ using namespace stu;
 // Define the hit target range which is used when moving the ghost to detect if it is within range of its next stage
 #define HIT_TARGET_RANGE 2.0
 
-// Define the speed of the movement for the ghost
-#define SPEED 0.00005
+// Define the speed of the movement for the ghost in units per second
+#define GHOST_SPEED 1.5f
+
+// The time (in seconds) the ghost is moved for between arrival tests. The updates' times are added up and the ghost is moved
+// in whole sub-steps, the rest being kept for the next update, so a journey takes the same number of sub-steps at any tick rate
+#define GHOST_SUBSTEP_TIME (1.0f / 120.0f)
 
 // Define the amount of stages the ghost has (max = 4)
 #define STAGE_LIMIT 4
 
+// The number of different stages (GhostState values) the ghost can move to
+#define STAGE_COUNT 4
+
+// The stream of the ghost's random generator, so its sequence differs from the player's and critters' for the same seed
+#define GHOST_RANDOM_STREAM 2
+
 // The Ghost Class
 class Ghost 
 {
 
 // Public Member Functions and Variables
 public:
-	// Function:		Ghost(Player) - Ghost Constructor
+	// Function:		Ghost(Player, unsigned int, RoomLayout, UINT32, PathFinder) - Ghost Constructor
 	// Description:		The Ghost constructor sets up all of the XASound objects needed for the ghost as well as the Ghost Emitter and the
 	//					Event emitter. Also calls SetUpGhost to set up the positions/settings for objects the ghost can interact with
 	// In:				Player* - Pointer to the player object so that the Player's listener can be used to create the emitters and to update 
 	//					them. 
+	//					unsigned int Seed - the seed for the ghost's random generator, used to choose the stages and laughs
+	//					const RoomLayout &Layout, UINT32 RoomIndex - the layout and room giving the stages' positions and sounds
+	//					PathFinder *RoomPaths - the room's path finder, for the ghost's paths between stages; NULL to move in straight lines
 	// Out:				N/a
-	Ghost (Player *PlayerListener);
+	Ghost (Player *PlayerListener, unsigned int Seed, const RoomLayout &Layout, UINT32 RoomIndex, PathFinder *RoomPaths);
 
 	// Function:		~Ghost() - Ghost Destructor
-	// Description:		The ghost destructor calls StopEmitter on both of the emitters within the class to stop playing their sounds
+	// Description:		The ghost destructor calls StopEmitter on both of the emitters within the class to stop playing their sounds,
+	//					then deletes the emitters and the sounds
 	// In:				N/a
 	// Out:				N/a
 	virtual ~Ghost();
@@ -90,13 +111,13 @@ public:
 	// Out:				N/a
 	void InitialiseGhost();
 
-	// Function:		UpdateGhost() - Update Ghost function
+	// Function:		UpdateGhost(float) - Update Ghost function
 	// Description:		This function carries out the frame updates for the ghost. The only case where this is needed is if the ghost has
 	//					a new target and needs to move to that target, meaning mMoving will be set to true. This then calls 
 	//					MoveGhostToNewPosition() each frame until the ghost is no longer moving.
-	// In:				N/a
+	// In:				float DeltaTime - the time in seconds since the last update
 	// Out:				N/a
-	void UpdateGhost();
+	void UpdateGhost(float DeltaTime);
 
 	// Function:		Reset() - Reset function
 	// Description:		Update the Ghost and Event emitter so that they reflect the settings of the reseted player Listener
@@ -116,6 +137,36 @@ public:
 	// Out:				X3DAUDIO_VECTOR mGhostPosition - the current position of the ghost
 	inline X3DAUDIO_VECTOR Ghost::GetGhostPosition() const { return mGhostPosition; };
 
+	// Function:		GetStageCount() - Get Stage Count function
+	// Description:		Returns the number of stages the ghost has completed, for tracing the game state
+	// In:				N/a
+	// Out:				int mStageCount - the number of completed stages
+	inline int GetStageCount() const { return mStageCount; };
+
+	// Function:		IsMoving() - Is Moving function
+	// Description:		Returns true while the ghost is moving between stages
+	// In:				N/a
+	// Out:				bool mMoving - true if the ghost is moving
+	inline bool IsMoving() const { return mMoving; };
+
+	// Function:		GetJourneyTime() - Get Journey Time function
+	// Description:		Returns the game time the ghost's last journey to a stage took, as its sub-steps, so it is the same at any tick rate
+	// In:				N/a
+	// Out:				float - the time in seconds, or 0 before the ghost first reaches a stage
+	inline float GetJourneyTime() const { return mJourneySteps * GHOST_SUBSTEP_TIME; };
+
+	// Function:		GetJourneys() - Get Journeys function
+	// Description:		Returns the number of journeys to a stage the ghost has finished; a short journey can start and finish in one update
+	// In:				N/a
+	// Out:				unsigned int mJourneys - the finished journeys
+	inline unsigned int GetJourneys() const { return mJourneys; };
+
+	// Function:		GetRandom() - Get Random function
+	// Description:		Returns the ghost's random generator so its state can be saved and restored
+	// In:				N/a
+	// Out:				Random& - the ghost's random generator
+	inline Random& GetRandom() { return mRandom; };
+
 	// Function:		UpdateEmitter() - Update Emitter function
 	// Description:		Inline function that calls UpdateEmitter for both of the emitter objects in this class
 	// In:				N/a
@@ -124,7 +175,7 @@ public:
 
 	// Function:		SetNewStage() - Set New Stage function
 	// Description:		This function is called when the ghost needs to change its stage, and if the ghost hasn't reached its stage
-	//					limit, will randomly select a stage to carry out as long as that stage is available. This ensures each play
+	//					limit, will draw a stage that hasn't been visited yet from the stage bag. This ensures each play
 	//					of the game is different and randomised. It then sets the ghost state, target position and path to the new stage.
 	//					The Ghost yell sound is played if it is not the first movement to a stage, and the event emitter is stopped.
 	// In:				N/a
@@ -157,12 +208,12 @@ public:
 
 // Private Member Functions and Variables
 private:
-	// Function:		SetUpGhost() - Set Up Ghost function
-	// Description:		This function sets the positions of the objects that the ghost can interact with in the room, and also initialises
-	//					the bools to signify these stages are available to true so that the ghost can interact with them
-	// In:				N/a
+	// Function:		SetUpGhost(LayoutStage) - Set Up Ghost function
+	// Description:		This function sets the positions of the objects that the ghost can interact with in the room, and also refills
+	//					the bag of stages so that all of the stages are available for the ghost to interact with
+	// In:				const LayoutStage *Stages - the room's stages from its layout, in GhostState order
 	// Out:				N/a
-	void SetUpGhost();
+	void SetUpGhost(const LayoutStage *Stages);
 
 	// Function:		SetGhostActive() - Set Ghost Active function
 	// Description:		This function updates and plays the ghost emitter after the player's intro has finished 
@@ -171,18 +222,28 @@ private:
 	void SetGhostActive();
 
 	// Function:		SetGhostPath() - Set Ghost Path function
-	// Description:		Finds the vector between the ghost starting position and the target position from one ghost stage to the next
-	//					This vector is then used to move the ghost dynamically along that path in the MoveGhostToNewPosition function
+	// Description:		Finds the path from the ghost's position round the room's walls and obstacles to its target position, as the
+	//					waypoints the ghost heads for in turn; if there is no path the only waypoint is the target. Then heads the ghost
+	//					for the first waypoint
 	// In:				N/a
 	// Out:				N/a
 	void SetGhostPath();
 
-	// Function:		MoveGhostToNewPosition() - Move Ghost To New Position function
-	// Description:		Move the ghost along the path vector found in SetGhostPath until it reaches its target position
-	//					Then changes the sound used for the emitter to the sound for the current state
+	// Function:		HeadForNextWaypoint() - Head For Next Waypoint function
+	// Description:		Finds the vector from the ghost's position to its next waypoint, normalised and multiplied by the ghost's speed
+	//					This vector (the ghost's velocity in units per second) is then used to move the ghost in the
+	//					MoveGhostToNewPosition function
 	// In:				N/a
 	// Out:				N/a
-	void MoveGhostToNewPosition();
+	void HeadForNextWaypoint();
+
+	// Function:		MoveGhostToNewPosition(float) - Move Ghost To New Position function
+	// Description:		Move the ghost along its path's waypoints until it reaches its target position, in sub-steps
+	//					of GHOST_SUBSTEP_TIME so that it can't pass through the target range during a long update.
+	//					Then changes the sound used for the emitter to the sound for the current state
+	// In:				float DeltaTime - the time in seconds to move the ghost for
+	// Out:				N/a
+	void MoveGhostToNewPosition(float DeltaTime);
 
 	// Function:		DefeatGhost() - Defeat Ghost function
 	// Description:		Changes the Ghost emitter sound toplay the ghost death sound, and sets the mGhostDefeated bool to true to 
@@ -218,7 +279,7 @@ private:
 	// The Event Emitter object
 	Emitter *mEventEmitter;
 
-	// Enumerator for the current state of the ghost
+	// Enumerator for the current state of the ghost; the stages of a RoomLayout are in the same order
 	enum GhostState { KNOCKING, PIANO, TYPEWRITER, RADIO};
 	GhostState mCurrentState;		// Holds the current state
 
@@ -230,15 +291,28 @@ private:
 	X3DAUDIO_VECTOR mGhostTargetPosition;
 	X3DAUDIO_VECTOR mGhostPath;
 
+	// The room's path finder, and the waypoints of the path to the target with the one the ghost is heading for
+	PathFinder *mPathFinder;
+	vector<X3DAUDIO_VECTOR> mGhostWaypoints;
+	size_t mNextWaypoint;
+
+	// The time of the updates since the last sub-step that the ghost hasn't been moved for yet, the sub-steps of its journey,
+	// and the journeys it has finished
+	float mUnmovedTime;
+	unsigned int mJourneySteps;
+	unsigned int mJourneys;
+
 	// Bools for the state of the ghost class
 	bool mGhostStart;
 	bool mMoving;
-	bool mPianoAvailable;
-	bool mTypewriterAvailable;
-	bool mDoorAvailable;
-	bool mRadioAvailable;
 	bool mGhostLaughing;
 
+	// The stages that haven't been visited yet; each is drawn once, in a random order
+	ShuffleBag mStageBag;
+
+	// The ghost's own random generator, for choosing stages and laughs
+	Random mRandom;
+
 	// Counts the amount of stages the ghost has completed
 	int mStageCount;
 }; 
@@ -12,7 +12,7 @@
 	Date:	5th May 2015
 
 	Exposes:	implementation of the GhostEscape class.
-	Requires:	XACore, Room.
+	Requires:	XACore, XASound, InputQueue, Profiler, TraceLog, Room, RoomLayout, SessionRecording.
 	
 	Description:
 	This is the implementation of the Room class members;
@@ -29,11 +29,20 @@ using namespace std;
 
 // Framework includes.
 #include "XACore.hpp"
+#include "XASound.hpp"
+#include "InputQueue.hpp"
+#include "Profiler.hpp"
+#include "TraceLog.hpp"
 using AllanMilne::Audio::XACore;
+using AllanMilne::Audio::XASound;
+using AllanMilne::InputQueue;
+using AllanMilne::TraceLog;
 
 // Application includes.
 #include "GhostEscape.hpp"
 #include "Room.hpp"
+#include "RoomLayout.hpp"
+#include "SessionRecording.hpp"
 
 //--- Anonymous namespace defining constants and helper functions used in the implementation.
 namespace 
@@ -54,6 +63,8 @@ namespace
 		msg <<" escape \t\t = end the application. " <<endl <<endl;
 		const string msgStr = msg.str();
 		MessageBox (NULL, msgStr.c_str(), TEXT("Ghost Escape"), MB_OK | MB_ICONINFORMATION);
+		// Keys pressed while the message box was open were meant for it, not the game
+		InputQueue::GetInstance().Clear();
 	} // end Instructions function.
 
 } // end anonymous namespace.
@@ -69,12 +80,40 @@ bool GhostEscape::Initialize (HWND aWindow)
 	// guard against uninitialized or invalid XACore.
 	if (XACore::GetStatus() != XACore::OK) return false;
 
-	mRoom.reset(new Room ());
+	// Seed the room with the current time so each game is different
+	const unsigned int seed = (unsigned int)time(NULL);
+	if (mLayoutFile.empty())
+	{
+		mRoom.reset(new Room (seed));
+	}
+	else
+	{
+		// Set the room up from the layout asked for
+		mLayout.reset(new RoomLayout());
+		if (!mLayout->Load(mLayoutFile) || (mLayoutRoom >= mLayout->GetRoomCount()))
+		{
+			const string error = mLayout->GetError().empty() ? (mLayoutFile + " has no such room.") : mLayout->GetError();
+			MessageBox (NULL, error.c_str(), TEXT ("Initialize() - FAILED"), MB_OK | MB_ICONERROR );
+			return false;
+		}
+		mRoom.reset(new Room (seed, *mLayout, mLayoutRoom));
+	}
 	if (!mRoom->IsValid()) 
 	{
 		MessageBox (NULL, "Error creating the room.", TEXT ("Initialize() - FAILED"), MB_OK | MB_ICONERROR );
 		return false;
 	}
+
+	// Start the recording with the seed; the commands are added as they are actioned
+	if (!mRecordingFile.empty())
+	{
+		mRecorder.reset(new SessionRecorder());
+		if (!mRecorder->Open(mRecordingFile, seed, TICK_RATE))
+		{
+			MessageBox (NULL, "Error creating the session recording.", TEXT ("Initialize() - FAILED"), MB_OK | MB_ICONERROR );
+			return false;
+		}
+	}
 	
 	return true;		// everything was initialized correctly.
 } 
@@ -83,11 +122,20 @@ bool GhostEscape::Initialize (HWND aWindow)
 
 	
 // Function:		Setup() - Setup function
-// Description:		Called at the start of processing; resets room, displays instructions and plays the sounds.
+// Description:		Called at the start of processing; maps the keys to commands, resets room, displays instructions and plays the sounds.
 // In:				N/a
 // Out:				N/a
 bool GhostEscape::Setup ()
 {
+	// Map the keys to the game's commands; holding a movement key repeats it, the other commands need a fresh press
+	InputQueue &Input = InputQueue::GetInstance();
+	Input.MapKey(VK_UP, MOVE_FORWARD_COMMAND, true);
+	Input.MapKey(VK_LEFT, TURN_LEFT_COMMAND, true);
+	Input.MapKey(VK_RIGHT, TURN_RIGHT_COMMAND, true);
+	Input.MapKey(VK_SPACE, CAPTURE_COMMAND);
+	Input.MapKey('R', RESET_COMMAND);
+	Input.MapKey('I', INSTRUCTIONS_COMMAND);
+
 	Instructions();
 	mRoom->Reset();
 	return true;		// All has been setup without error.
@@ -97,52 +145,88 @@ bool GhostEscape::Setup ()
 
 
 // Function:		ProcessFrame(const float) - Process Frame function
-// Description:		Uses delta time to process a single application frame.  Check for key user pressess, pass actions as 
-//					appropriate to the Room object for action.
+// Description:		Uses delta time to process a single application frame.  Takes the commands for the keys pressed since the
+//					last frame from the input queue, in the order pressed, and passes actions as appropriate to the Room object for action.
 // In:				const float deltaTime
 // Out:				N/a
 bool GhostEscape::ProcessFrame (const float deltaTime)
 {
-	// Check if keys were pressed since last key state call - least significant bit.
-	if (GetAsyncKeyState (VK_UP) & 0x0001) {
-		mRoom->MovePlayer();
-		// check for exiting the room - this indicates success in this application.
-		if (mRoom->DoorExited())
+	PROFILE_SCOPE ("GhostEscape::ProcessFrame");
+	TRACE_SCOPE ("GhostEscape::ProcessFrame", "game");
+	InputQueue &Input = InputQueue::GetInstance();
+	int Command;
+	float PressTime;
+	while (Input.NextCommand(Command, PressTime))
+	{
+		TRACE_SCOPE ("Command", "game");
+#ifdef TRACING_ENABLED
+		// Continue the key press's flow; sounds started while the command is actioned continue it to the mixer
+		TraceLog::SetCurrentFlow(Input.GetCommandFlow());
+		if (TraceLog::IsTracing() && (TraceLog::GetCurrentFlow() != 0))
 		{
-			MessageBox (NULL, TEXT("\n\n You escaped the ghost! \n\n "), TEXT(" Ghost Escape "), MB_OK | MB_ICONINFORMATION);
-			mRoom->Stop();
-			return false;
+			TraceLog::GetInstance().AddFlow("Command", "game", TraceLog::FlowStep, TraceLog::GetCurrentFlow());
+		}
+#endif
+		// Record the delay between the key press and its action
+		float Latency = Input.GetTime() - PressTime;
+		mTotalInputLatency += Latency;
+		mCommandCount++;
+		if (Latency > mMaxInputLatency)
+		{
+			mMaxInputLatency = Latency;
+		}
+
+		// Record the command against this tick so a replay gives it before the same update
+		if (mRecorder)
+		{
+			mRecorder->Record(UINT32(mTick), GameCommand(Command));
+		}
+
+		switch (Command)
+		{
+		case MOVE_FORWARD_COMMAND:
+			mRoom->MovePlayer();
+			// check for exiting the room - this indicates success in this application.
+			if (mRoom->DoorExited())
+			{
+				MessageBox (NULL, TEXT("\n\n You escaped the ghost! \n\n "), TEXT(" Ghost Escape "), MB_OK | MB_ICONINFORMATION);
+				mRoom->Stop();
+				return false;
+			}
+			break;
+		// Turn the player left or right
+		case TURN_LEFT_COMMAND:
+			mRoom->TurnPlayerLeft();
+			break;
+		case TURN_RIGHT_COMMAND:
+			mRoom->TurnPlayerRight();
+			break;
+		// Try to capture the ghost with the spirit drainer
+		case CAPTURE_COMMAND:
+			mRoom->TryToCaptureGhost();
+			break;
+		// Reset the player back to the start position
+		case RESET_COMMAND:
+			mRoom->Reset();
+			break;
+		// Show the instructions
+		case INSTRUCTIONS_COMMAND:
+			Instructions();
+			break;
 		}
-	}
-	// If the left arrow is pressed, turn the player left
-	if (GetAsyncKeyState (VK_LEFT) & 0x0001) 
-	{
-		mRoom->TurnPlayerLeft();
-	}
-	// If the right arrow is pressed, turn the player right
-	if (GetAsyncKeyState (VK_RIGHT) & 0x0001) 
-	{
-		mRoom->TurnPlayerRight();
-	}
-	// If the Space key is pressed, call TryToCaptureGhost from the mRoom object
-	if (GetAsyncKeyState (VK_SPACE) & 0x0001)
-	{
-		mRoom->TryToCaptureGhost();
-	}
-	// If the R key is pressed, call the Reset function from the mRoom object
-	if (GetAsyncKeyState ('R') & 0x0001) 
-	{
-		mRoom->Reset();
-	}
-	// If the I key is pressed, show the instructions
-	if (GetAsyncKeyState ('I') & 0x0001) 
-	{
-		Instructions();
 	}
 
+#ifdef TRACING_ENABLED
+	TraceLog::SetCurrentFlow(0);
+#endif
+
 	// Updates
-	mRoom->UpdateRoom();
+	mRoom->UpdateRoom(deltaTime);
+
+	// Send this frame's volume/pitch/filter/3D changes to the voices together, ramped to avoid zipper noise
+	XASound::CommitChanges(deltaTime);
 
+	mTick++;
 	return true;
 } 
 // end ProcessFrame function.
@@ -150,12 +234,16 @@ bool GhostEscape::ProcessFrame (const float deltaTime)
 
 
 // Function:		Cleanup() - Cleanup function
-// Description:		Stop the sounds playing.
+// Description:		Stop the sounds playing and close the session recording.
 // In:				N/a
 // Out:				N/a
 void GhostEscape::Cleanup ()
 {
 	mRoom->Stop();
+	if (mRecorder)
+	{
+		mRecorder->Close();
+	}
 } 
 // end cleanup function.
 
@@ -169,7 +257,7 @@ void GhostEscape::Cleanup ()
 // In:				N/a
 // Out:				N/a
 GhostEscape::GhostEscape()
-	: mRoom(nullptr)
+	: mRoom(nullptr), mLayoutRoom(0), mTick(0), mCommandCount(0), mTotalInputLatency(0.0f), mMaxInputLatency(0.0f)
 { 
 } 
 // end GhostEscape constructor.
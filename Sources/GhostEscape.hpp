@@ -11,7 +11,7 @@
 	Version:	2.0
 	Date:	5th May 2015
 
-	Requires:	IState, Room.
+	Requires:	IState, InputQueue, Room, RoomLayout, SessionRecording.
 	
 	Description:
 	This class was provided by Allan Milne in the RoomEscape lab. It has been edited slightly for this application.
@@ -19,6 +19,19 @@
 	This is the concrete strategy class called  from the context WinCore class as part of a strategy pattern.
 	*	See IState.hpp for details of this interface.
 
+	Key presses are taken from the framework's InputQueue, which is fed from the window procedure; the keys are mapped to
+	GameCommand values when the application is set up. The delay from each key press to its action is recorded.
+
+	If RecordSession() is called before Initialize(), the room's seed and each command, with the tick it was actioned on, are
+	written to a recording file as the game is played; the HeadlessDriver can replay the recording (-replay).
+	The replay advances the game's timers by exactly one tick per update, so a recorded game must too: the WinCore running
+	it is asked to drive GameTimer's simulated clock from its fixed tick (see WinCore.hpp).
+	*	See SessionRecording.hpp for details.
+	The recording doesn't hold the room's layout, so a game played with UseLayout() is replayed with the same layout.
+
+	If UseLayout() is called before Initialize(), the room is set up from a room of a layout file rather than the default layout.
+	*	See RoomLayout.hpp for details.
+
 	This class exposes a user interface controlling the user walking and turning within a room.
 	The Room class models a room layout and is composed with a Player class that encapsulates the X3DAudio listener that is ultimately being controlled.
 
@@ -32,14 +45,31 @@
 
 // System includes.
 #include <memory>
+#include <string>
 using std::unique_ptr;
+using std::string;
 
 // Framework includes.
 #include "IState.hpp"
 using AllanMilne::IState;
 
+// The number of times a second the game is updated (the WinCore tick rate)
+#define TICK_RATE 60.0f
+
+// The actions the player's keys are mapped to
+enum GameCommand {
+	MOVE_FORWARD_COMMAND,
+	TURN_LEFT_COMMAND,
+	TURN_RIGHT_COMMAND,
+	CAPTURE_COMMAND,
+	RESET_COMMAND,
+	INSTRUCTIONS_COMMAND
+};
+
 // Forward declarations.
 class Room;
+class RoomLayout;
+class SessionRecorder;
 
 // The GhostEscape class (inheriting from IState)
 class GhostEscape : public IState 
@@ -56,20 +86,20 @@ public:
 	bool Initialize (HWND aWindow);
 
 	// Function:		Setup() - Setup function
-	// Description:		Called at the start of processing; resets room, displays instructions and plays the sounds.
+	// Description:		Called at the start of processing; maps the keys to commands, resets room, displays instructions and plays the sounds.
 	// In:				N/a
 	// Out:				N/a
 	bool Setup ();
 
 	// Function:		ProcessFrame(const float) - Process Frame function
-	// Description:		Uses delta time to process a single application frame.  Check for key user pressess, pass actions as 
-	//					appropriate to the Room object for action.
+	// Description:		Uses delta time to process a single application frame.  Takes the commands for the keys pressed since the
+	//					last frame from the input queue, in the order pressed, and passes actions as appropriate to the Room object for action.
 	// In:				const float deltaTime
 	// Out:				N/a
 	bool ProcessFrame (const float deltaTime);
 
 	// Function:		Cleanup() - Cleanup function
-	// Description:		Stop the sounds playing.
+	// Description:		Stop the sounds playing and close the session recording.
 	// In:				N/a
 	// Out:				N/a
 	void Cleanup ();
@@ -88,11 +118,42 @@ public:
 	// Out:				N/a
 	virtual ~GhostEscape();
 
+	// Functions to access the input latency measurements; the time in seconds from a key press to its command being actioned
+	inline float GetMaxInputLatency() const { return mMaxInputLatency; }
+	inline float GetAverageInputLatency() const { return (mCommandCount > 0) ? (mTotalInputLatency / mCommandCount) : 0.0f; }
+
+	// Function:		RecordSession(string) - Record Session function
+	// Description:		Asks for the game to be recorded to a file; must be called before Initialize, which creates the file
+	// In:				const string &FileName - the recording file
+	// Out:				N/a
+	inline void RecordSession(const string &FileName) { mRecordingFile = FileName; }
+
+	// Function:		UseLayout(string, unsigned int) - Use Layout function
+	// Description:		Asks for the room to be set up from a layout file; must be called before Initialize, which loads the file
+	// In:				const string &FileName - the text or binary layout file, unsigned int RoomIndex - the room of the layout
+	// Out:				N/a
+	inline void UseLayout(const string &FileName, unsigned int RoomIndex) { mLayoutFile = FileName; mLayoutRoom = RoomIndex; }
+
 // Private Member Functions and Variables
 private:
 	
 	//--- Encapsulation of the Room object.
 	unique_ptr<Room> mRoom;
+
+	//--- The layout the room is set up from, if one was asked for.
+	string mLayoutFile;
+	unsigned int mLayoutRoom;
+	unique_ptr<RoomLayout> mLayout;
+
+	//--- The recording of the game, if one was asked for; mTick counts the frames processed, one per fixed tick.
+	string mRecordingFile;
+	unique_ptr<SessionRecorder> mRecorder;
+	unsigned long mTick;
+
+	// Input latency measurements
+	unsigned long mCommandCount;
+	float mTotalInputLatency;
+	float mMaxInputLatency;
 	
 }; 
 // end GhostEscape class.
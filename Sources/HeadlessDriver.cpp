@@ -0,0 +1,972 @@
+/*
+	File:	HeadlessDriver.cpp
+	Version:	1.1
+	Date:	18th October 2026
+	Author:	agent
+
+	Exposes:	Implementation of the HeadlessDriver class.
+	Requires:	Room, RoomLayout, XACore, XASound, Spatializer, GameTimer, Profiler, TraceLog, SessionRecording, Emitter, DistanceCurves.
+
+	Description:
+	Runs the Room game loop without a window, audio device or keyboard.
+	*	See HeadlessDriver.hpp for details.
+*/
+
+// System includes.
+#include <windows.h>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+#include <math.h>
+using std::string;
+using std::vector;
+using std::ifstream;
+using std::istringstream;
+using std::endl;
+
+// Framework includes.
+#include "XACore.hpp"
+#include "XASound.hpp"
+#include "Spatializer.hpp"
+#include "GameTimer.h"
+#include "Profiler.hpp"
+#include "TraceLog.hpp"
+using AllanMilne::Audio::XACore;
+using AllanMilne::Audio::XASound;
+using AllanMilne::Audio::Spatializer;
+using AllanMilne::TraceLog;
+
+// Application includes.
+#include "HeadlessDriver.hpp"
+#include "Room.hpp"
+#include "SessionRecording.hpp"
+#include "Emitter.hpp"
+#include "DistanceCurves.hpp"
+
+// Anonymous namespace for the helper functions
+namespace
+{
+	// The emitter types' names for the checks' reports
+	const char *EmitterTypeNames[EMITTER_TYPE_COUNT] = { "ghost", "event", "critter", "outdoor" };
+
+	// Convert a script command name to its command; returns false if the name isn't a command
+	bool ParseCommand(const string &Name, GameCommand &Command)
+	{
+		if (Name == "move") { Command = MOVE_FORWARD_COMMAND; }
+		else if (Name == "left") { Command = TURN_LEFT_COMMAND; }
+		else if (Name == "right") { Command = TURN_RIGHT_COMMAND; }
+		else if (Name == "capture") { Command = CAPTURE_COMMAND; }
+		else if (Name == "reset") { Command = RESET_COMMAND; }
+		else { return false; }
+		return true;
+	}
+
+	// Orders the scripted commands by time, keeping the order of commands given at the same time
+	bool EarlierCommand(const ScriptedCommand &First, const ScriptedCommand &Second)
+	{
+		return First.Time < Second.Time;
+	}
+
+	// The real time in seconds, for measuring how fast the playthroughs run; GameTimer may be on the simulated clock
+	double WallClock()
+	{
+		__int64 Count;
+		__int64 CountsPerSecond;
+		QueryPerformanceCounter((LARGE_INTEGER*)&Count);
+		QueryPerformanceFrequency((LARGE_INTEGER*)&CountsPerSecond);
+		return double(Count) / double(CountsPerSecond);
+	}
+
+	// The distance between two positions
+	double Separation(const X3DAUDIO_VECTOR &From, const X3DAUDIO_VECTOR &To)
+	{
+		double dx = To.x - From.x;
+		double dy = To.y - From.y;
+		double dz = To.z - From.z;
+		return sqrt((dx * dx) + (dy * dy) + (dz * dz));
+	}
+
+	// The journeys' times as a list for a report
+	string JourneyList(const vector<float> &Journeys)
+	{
+		std::ostringstream List;
+		for (size_t i = 0; i < Journeys.size(); i++)
+		{
+			List << ((i > 0) ? " " : "") << Journeys[i] << 's';
+		}
+		return Journeys.empty() ? string("none") : List.str();
+	}
+
+	// The speed over a distance and time, or 0 if no time was measured
+	double Speed(double Distance, double Time)
+	{
+		return (Time > 0.0) ? (Distance / Time) : 0.0;
+	}
+
+	// The value of a curve at a normalised distance, interpolated between its points as X3DAudio does; past 1 it holds the last value
+	float CurveValue(const X3DAUDIO_DISTANCE_CURVE *Curve, float Distance)
+	{
+		const X3DAUDIO_DISTANCE_CURVE_POINT *Points = Curve->pPoints;
+		if (Distance >= 1.0f)
+		{
+			return Points[Curve->PointCount - 1].DSPSetting;
+		}
+		UINT32 End = 1;
+		while (Points[End].Distance < Distance)
+		{
+			End++;
+		}
+		float Fraction = (Distance - Points[End - 1].Distance) / (Points[End].Distance - Points[End - 1].Distance);
+		return Points[End - 1].DSPSetting + ((Points[End].DSPSetting - Points[End - 1].DSPSetting) * Fraction);
+	}
+}
+// end anonymous namespace.
+
+
+
+// Function:		HeadlessDriver() - HeadlessDriver constructor
+// Description:		Sets the default options; nothing is created until Run or RunPlaythroughs is called
+// In:				N/a
+// Out:				N/a
+HeadlessDriver::HeadlessDriver()
+	: mTracing(false), mLayoutRoom(0), mSwarmSize(0), mTimeLimit(HEADLESS_TIME_LIMIT), mTickRate(TICK_RATE), mSpeed(0.0f), mDifferences(0), mPlaythroughs(0), mEscapes(0), mTicksRun(0), mWallTime(0.0)
+{
+}
+// End HeadlessDriver constructor
+
+
+
+// Function:		~HeadlessDriver() - HeadlessDriver destructor
+// Description:		Closes the trace file and switches the simulated clock off
+// In:				N/a
+// Out:				N/a
+HeadlessDriver::~HeadlessDriver()
+{
+	if (mTracing)
+	{
+		mTrace.close();
+	}
+	GameTimer::UseSimulatedClock(false);
+}
+// End HeadlessDriver destructor
+
+
+
+// Function:		Run(string) - Run function
+// Description:		Reads the options from the command line, runs the playthroughs and writes the summary to standard output
+// In:				const string &CommandLine - the application's command line
+// Out:				int - the application exit code; 0 if all playthroughs ran, 1 if the options or the room were invalid
+int HeadlessDriver::Run(const string &CommandLine)
+{
+	unsigned int FirstSeed = 1;
+	unsigned int Runs = 1;
+	bool CheckDistanceCurves = false;
+	bool CheckSpatial = false;
+
+	istringstream Arguments(CommandLine);
+	string Option;
+	while (Arguments >> Option)
+	{
+		bool Valid = true;
+		if (Option == "-headless")
+		{
+			continue;
+		}
+		else if (Option == "-seed")
+		{
+			Valid = !(Arguments >> FirstSeed).fail();
+		}
+		else if (Option == "-runs")
+		{
+			Valid = !(Arguments >> Runs).fail();
+		}
+		else if (Option == "-limit")
+		{
+			Valid = !(Arguments >> mTimeLimit).fail();
+		}
+		else if (Option == "-script")
+		{
+			string FileName;
+			Valid = (Arguments >> FileName) && LoadScript(FileName);
+		}
+		else if (Option == "-replay")
+		{
+			string FileName;
+			Valid = (Arguments >> FileName) && LoadRecording(FileName, FirstSeed);
+		}
+		else if (Option == "-record")
+		{
+			string FileName;
+			Valid = !(Arguments >> FileName).fail();
+			if (Valid)
+			{
+				RecordTo(FileName);
+			}
+		}
+		else if (Option == "-layout")
+		{
+			string FileName;
+			Valid = (Arguments >> FileName) && LoadLayout(FileName);
+		}
+		else if (Option == "-room")
+		{
+			Valid = !(Arguments >> mLayoutRoom).fail();
+		}
+		else if (Option == "-swarm")
+		{
+			Valid = !(Arguments >> mSwarmSize).fail();
+		}
+		else if (Option == "-speed")
+		{
+			Valid = !(Arguments >> mSpeed).fail();
+		}
+		else if (Option == "-tickrate")
+		{
+			Valid = (Arguments >> mTickRate) && (mTickRate > 0.0f);
+		}
+		else if (Option == "-tickrates")
+		{
+			// The rates are separated by commas
+			string List;
+			Valid = !(Arguments >> List).fail();
+			std::replace(List.begin(), List.end(), ',', ' ');
+			istringstream RateList(List);
+			vector<float> Rates;
+			float Rate;
+			while (Valid && (RateList >> Rate))
+			{
+				Valid = (Rate > 0.0f);
+				Rates.push_back(Rate);
+			}
+			Valid = Valid && RateList.eof() && (Rates.size() >= 2);
+			if (Valid)
+			{
+				CompareTickRates(Rates);
+			}
+		}
+		else if (Option == "-timeline")
+		{
+			string FileName;
+			Valid = (Arguments >> FileName) && TraceLog::GetInstance().Start(FileName);
+		}
+		else if (Option == "-trace")
+		{
+			string FileName;
+			Valid = (Arguments >> FileName) && OpenTrace(FileName);
+		}
+		else if (Option == "-checkcurves")
+		{
+			CheckDistanceCurves = true;
+		}
+		else if (Option == "-checkspatializer")
+		{
+			CheckSpatial = true;
+		}
+		else
+		{
+			Valid = false;
+		}
+
+		if (!Valid)
+		{
+			std::cerr << "Headless run: invalid option " << Option << endl;
+			return 1;
+		}
+	}
+
+	if (CheckDistanceCurves || CheckSpatial)
+	{
+		bool Ok = (!CheckDistanceCurves) || CheckCurves(std::cout);
+		Ok = ((!CheckSpatial) || CheckSpatializer(std::cout)) && Ok;
+		return Ok ? 0 : 1;
+	}
+
+	if ((mLayout.GetRoomCount() > 0) && (mLayoutRoom >= mLayout.GetRoomCount()))
+	{
+		std::cerr << "Headless run: the layout has no room " << mLayoutRoom << endl;
+		return 1;
+	}
+
+	if (TraceLog::IsTracing())
+	{
+		TraceLog::GetInstance().NameThread("Headless game");
+	}
+	bool Ok = RunPlaythroughs(FirstSeed, Runs);
+	TraceLog::GetInstance().Stop();
+	WriteSummary(std::cout);
+	return (Ok && (mDifferences == 0)) ? 0 : 1;
+}
+// End Run function
+
+
+
+// Function:		LoadScript(string) - Load Script function
+// Description:		Reads the scripted commands from a file, sorted into time order
+// In:				const string &FileName - the script file
+// Out:				bool - false if the file could not be read or has a line that is not a valid command
+bool HeadlessDriver::LoadScript(const string &FileName)
+{
+	ifstream Script(FileName.c_str());
+	if (!Script.is_open())
+	{
+		return false;
+	}
+
+	mScript.clear();
+	string Line;
+	while (std::getline(Script, Line))
+	{
+		istringstream Fields(Line);
+		string Name;
+		ScriptedCommand Scripted;
+		// Skip blank and comment lines
+		if (!(Fields >> Name) || Name[0] == '#')
+		{
+			continue;
+		}
+		istringstream TimeField(Name);
+		if (!(TimeField >> Scripted.Time) || !(Fields >> Name) || !ParseCommand(Name, Scripted.Command))
+		{
+			mScript.clear();
+			return false;
+		}
+		mScript.push_back(Scripted);
+	}
+
+	std::stable_sort(mScript.begin(), mScript.end(), EarlierCommand);
+	return true;
+}
+// End LoadScript function
+
+
+
+// Function:		LoadRecording(string, unsigned int) - Load Recording function
+// Description:		Reads a recorded game; its commands replace the script and its tick rate is used for the playthroughs
+// In:				const string &FileName - the recording file, unsigned int &Seed - set to the recording's seed
+// Out:				bool - false if the file could not be read or isn't a recording
+bool HeadlessDriver::LoadRecording(const string &FileName, unsigned int &Seed)
+{
+	SessionRecording Recording;
+	if (!Recording.Load(FileName))
+	{
+		return false;
+	}
+
+	mTickRate = Recording.GetTickRate();
+	Seed = Recording.GetSeed();
+
+	// Each command's time is worked out exactly as RunPlaythrough works out the time of its tick, so it is given on that tick
+	const float DeltaTime = 1.0f / mTickRate;
+	mScript.clear();
+	const vector<RecordedCommand> &Commands = Recording.GetCommands();
+	for (auto Recorded = Commands.begin(); Recorded != Commands.end(); ++Recorded)
+	{
+		ScriptedCommand Scripted;
+		Scripted.Time = float(Recorded->Tick) * DeltaTime;
+		Scripted.Command = Recorded->Command;
+		mScript.push_back(Scripted);
+	}
+	return true;
+}
+// End LoadRecording function
+
+
+
+// Function:		LoadLayout(string) - Load Layout function
+// Description:		Reads the layout the rooms are set up from
+// In:				const string &FileName - the text or binary layout file
+// Out:				bool - false if the file could not be read or isn't a valid layout; the reason is written to standard error
+bool HeadlessDriver::LoadLayout(const string &FileName)
+{
+	if (!mLayout.Load(FileName))
+	{
+		std::cerr << "Headless run: " << mLayout.GetError() << endl;
+		return false;
+	}
+	return true;
+}
+// End LoadLayout function
+
+
+
+// Function:		OpenTrace(string) - Open Trace function
+// Description:		Opens the file the per tick trace is written to and writes the column names
+// In:				const string &FileName - the trace file
+// Out:				bool - false if the file could not be opened
+bool HeadlessDriver::OpenTrace(const string &FileName)
+{
+	mTrace.open(FileName.c_str());
+	mTracing = mTrace.is_open();
+	if (mTracing)
+	{
+		mTrace << "seed,";
+		Room::WriteTraceHeader(mTrace);
+	}
+	return mTracing;
+}
+// End OpenTrace function
+
+
+
+// Function:		RunPlaythroughs(unsigned int, unsigned int) - Run Playthroughs function
+// Description:		Creates the null audio device and the simulated clock, and runs a number of playthroughs with consecutive seeds
+// In:				unsigned int FirstSeed - the seed of the first playthrough, unsigned int Count - the number of playthroughs
+// Out:				bool - false if the null audio device or a room could not be created
+bool HeadlessDriver::RunPlaythroughs(unsigned int FirstSeed, unsigned int Count)
+{
+	// The null device has to be the first core created; the sounds would otherwise try to use a real device
+	if (!XACore::CreateInstance(true) || !XACore::GetInstance()->IsNullDevice())
+	{
+		return false;
+	}
+
+	double StartTime = WallClock();
+	bool Ok = true;
+	for (unsigned int i = 0; (i < Count) && Ok; i++)
+	{
+		if (mCompareRates.empty())
+		{
+			PlaythroughOutcome Outcome;
+			Ok = RunPlaythrough(FirstSeed + i, Outcome);
+		}
+		else
+		{
+			Ok = RunAtTickRates(FirstSeed + i);
+		}
+	}
+	mWallTime += WallClock() - StartTime;
+	return Ok;
+}
+// End RunPlaythroughs function
+
+
+
+// Function:		CompareTickRates(vector<float>) - Compare Tick Rates function
+// Description:		Asks for each playthrough to be run at each of the tick rates and compared with the first rate's
+// In:				const vector<float> &Rates - the tick rates, each more than 0; fewer than 2 runs each playthrough once
+// Out:				N/a
+void HeadlessDriver::CompareTickRates(const vector<float> &Rates)
+{
+	mCompareRates.clear();
+	mRateTotals.clear();
+	if (Rates.size() >= 2)
+	{
+		// The totals are value initialised, so they start at 0
+		mCompareRates = Rates;
+		mRateTotals.assign(Rates.size(), PlaythroughOutcome());
+	}
+}
+// End CompareTickRates function
+
+
+
+// Function:		RunAtTickRates(unsigned int) - Run At Tick Rates function
+// Description:		Runs a playthrough at each of the compared tick rates, adds the outcomes to the rates' totals, and writes
+//					how each run differs from the first rate's to standard error
+// In:				unsigned int Seed - the seed for the room
+// Out:				bool - false if a room could not be created
+bool HeadlessDriver::RunAtTickRates(unsigned int Seed)
+{
+	vector<PlaythroughOutcome> Outcomes(mCompareRates.size());
+	for (size_t i = 0; i < mCompareRates.size(); i++)
+	{
+		mTickRate = mCompareRates[i];
+		if (!RunPlaythrough(Seed, Outcomes[i]))
+		{
+			return false;
+		}
+		PlaythroughOutcome &Totals = mRateTotals[i];
+		Totals.Escapes += Outcomes[i].Escapes;
+		Totals.Stages += Outcomes[i].Stages;
+		Totals.EndTime += Outcomes[i].EndTime;
+		Totals.WallTime += Outcomes[i].WallTime;
+		Totals.GhostDistance += Outcomes[i].GhostDistance;
+		Totals.GhostTime += Outcomes[i].GhostTime;
+		Totals.CritterDistance += Outcomes[i].CritterDistance;
+		Totals.CritterTime += Outcomes[i].CritterTime;
+		Totals.GhostJourneys.insert(Totals.GhostJourneys.end(), Outcomes[i].GhostJourneys.begin(), Outcomes[i].GhostJourneys.end());
+		Totals.CritterJourneys.insert(Totals.CritterJourneys.end(), Outcomes[i].CritterJourneys.begin(), Outcomes[i].CritterJourneys.end());
+	}
+
+	const PlaythroughOutcome &First = Outcomes[0];
+	const double FirstGhostSpeed = Speed(First.GhostDistance, First.GhostTime);
+	const double FirstCritterSpeed = Speed(First.CritterDistance, First.CritterTime);
+	for (size_t i = 1; i < mCompareRates.size(); i++)
+	{
+		const PlaythroughOutcome &Outcome = Outcomes[i];
+		const float LowerRate = (mCompareRates[i] < mCompareRates[0]) ? mCompareRates[i] : mCompareRates[0];
+		const double GhostSpeed = Speed(Outcome.GhostDistance, Outcome.GhostTime);
+		const double CritterSpeed = Speed(Outcome.CritterDistance, Outcome.CritterTime);
+
+		// A speed is only compared if it was measured at both rates
+		std::ostringstream Differences;
+		if (Outcome.Escapes != First.Escapes)
+		{
+			Differences << " escaped " << Outcome.Escapes << " not " << First.Escapes << ';';
+		}
+		if (Outcome.Stages != First.Stages)
+		{
+			Differences << " stages " << Outcome.Stages << " not " << First.Stages << ';';
+		}
+		if (fabs(Outcome.EndTime - First.EndTime) > (HEADLESS_COMPARE_TICKS / LowerRate))
+		{
+			Differences << " ended at " << Outcome.EndTime << "s not " << First.EndTime << "s;";
+		}
+		if ((GhostSpeed > 0.0) && (FirstGhostSpeed > 0.0) && (fabs(GhostSpeed - FirstGhostSpeed) > (HEADLESS_SPEED_TOLERANCE * FirstGhostSpeed)))
+		{
+			Differences << " ghost speed " << GhostSpeed << " not " << FirstGhostSpeed << ';';
+		}
+		if ((CritterSpeed > 0.0) && (FirstCritterSpeed > 0.0) && (fabs(CritterSpeed - FirstCritterSpeed) > (HEADLESS_SPEED_TOLERANCE * FirstCritterSpeed)))
+		{
+			Differences << " critter speed " << CritterSpeed << " not " << FirstCritterSpeed << ';';
+		}
+		if (Outcome.GhostJourneys != First.GhostJourneys)
+		{
+			Differences << " ghost journeys " << JourneyList(Outcome.GhostJourneys) << " not " << JourneyList(First.GhostJourneys) << ';';
+		}
+		if (Outcome.CritterJourneys != First.CritterJourneys)
+		{
+			Differences << " critter crossings " << JourneyList(Outcome.CritterJourneys) << " not " << JourneyList(First.CritterJourneys) << ';';
+		}
+		if (!Differences.str().empty())
+		{
+			mDifferences++;
+			std::cerr << "Headless run: seed " << Seed << " at " << mCompareRates[i] << " Hz differs from " << mCompareRates[0] << " Hz:" << Differences.str() << endl;
+		}
+	}
+	return true;
+}
+// End RunAtTickRates function
+
+
+
+// Function:		RunPlaythrough(unsigned int, PlaythroughOutcome) - Run Playthrough function
+// Description:		Runs one playthrough in a new room until the player escapes or the time limit is reached
+// In:				unsigned int Seed - the seed for the room, PlaythroughOutcome &Outcome - set to the playthrough's outcome
+// Out:				bool - false if the room could not be created
+bool HeadlessDriver::RunPlaythrough(unsigned int Seed, PlaythroughOutcome &Outcome)
+{
+	Outcome = PlaythroughOutcome();
+
+	// Restart the simulated clock so the playthrough sees the same times whichever playthroughs ran before it
+	GameTimer::UseSimulatedClock(true);
+
+	Room *TheRoom = (mLayout.GetRoomCount() > 0) ? new Room(Seed, mLayout, mLayoutRoom) : new Room(Seed);
+	if ((!TheRoom->IsValid()) || ((mSwarmSize > 0) && (!TheRoom->AddSwarm(mSwarmSize))))
+	{
+		delete TheRoom;
+		return false;
+	}
+	// As GhostEscape::Setup does before the first frame
+	TheRoom->Reset();
+
+	// Only the first playthrough is recorded; a recording holds a single seed
+	if ((!mRecordingFile.empty()) && (mPlaythroughs == 0) && (!mRecorder.Open(mRecordingFile, Seed, mTickRate)))
+	{
+		delete TheRoom;
+		return false;
+	}
+
+	const float DeltaTime = 1.0f / mTickRate;
+	unsigned long Tick = 0;
+	float Time = 0.0f;
+	double StartTime = WallClock();
+	auto NextCommand = mScript.begin();
+	while ((!TheRoom->DoorExited()) && (Time < mTimeLimit))
+	{
+		TRACE_SCOPE("Tick", "game");
+
+		// Give the commands due by this tick, in script order
+		while ((NextCommand != mScript.end()) && (NextCommand->Time <= Time) && (!TheRoom->DoorExited()))
+		{
+			mRecorder.Record(UINT32(Tick), NextCommand->Command);
+			DoCommand(*TheRoom, NextCommand->Command);
+			++NextCommand;
+		}
+
+		// The ghost's and critters' movement is measured over the ticks they are moving throughout
+		const X3DAUDIO_VECTOR GhostStart = TheRoom->GetGhost().GetGhostPosition();
+		const X3DAUDIO_VECTOR CritterStart = TheRoom->GetCritters().GetCritterPosition();
+		const bool GhostMoving = TheRoom->GetGhost().IsMoving();
+		const bool CritterMoving = TheRoom->GetCritters().IsMoving();
+		const unsigned int GhostJourneys = TheRoom->GetGhost().GetJourneys();
+		const unsigned int CritterJourneys = TheRoom->GetCritters().GetJourneys();
+
+		TheRoom->UpdateRoom(DeltaTime);
+		XASound::CommitChanges(DeltaTime);
+
+		// A journey that has finished took the same game time at every tick rate; a short one may have started this tick too
+		if (TheRoom->GetGhost().GetJourneys() != GhostJourneys)
+		{
+			Outcome.GhostJourneys.push_back(TheRoom->GetGhost().GetJourneyTime());
+		}
+		if (TheRoom->GetCritters().GetJourneys() != CritterJourneys)
+		{
+			Outcome.CritterJourneys.push_back(TheRoom->GetCritters().GetJourneyTime());
+		}
+		if (GhostMoving && TheRoom->GetGhost().IsMoving())
+		{
+			Outcome.GhostDistance += Separation(GhostStart, TheRoom->GetGhost().GetGhostPosition());
+			Outcome.GhostTime += DeltaTime;
+		}
+		if (CritterMoving && TheRoom->GetCritters().IsMoving())
+		{
+			Outcome.CritterDistance += Separation(CritterStart, TheRoom->GetCritters().GetCritterPosition());
+			Outcome.CritterTime += DeltaTime;
+		}
+		if (mTracing)
+		{
+			mTrace << Seed << ',';
+			TheRoom->WriteTrace(mTrace, Time);
+		}
+
+		// Time is counted in whole ticks so it doesn't drift from the simulated clock
+		GameTimer::AdvanceSimulatedClock(DeltaTime);
+		Tick++;
+		Time = float(Tick) * DeltaTime;
+
+		// Wait for the tick's real time when paced; sleeping may overshoot a little, but the next wait takes up the difference
+		if (mSpeed > 0.0f)
+		{
+			double DueTime = StartTime + (double(Tick) / mTickRate) / mSpeed;
+			double Now = WallClock();
+			if (DueTime > Now)
+			{
+				Sleep(DWORD((DueTime - Now) * 1000.0));
+			}
+		}
+	}
+	mRecorder.Close();
+
+	mPlaythroughs++;
+	mTicksRun += Tick;
+	if (TheRoom->DoorExited())
+	{
+		mEscapes++;
+	}
+	Outcome.Escapes = TheRoom->DoorExited() ? 1 : 0;
+	Outcome.Stages = UINT32(TheRoom->GetGhost().GetStageCount());
+	Outcome.EndTime = Time;
+	Outcome.WallTime = WallClock() - StartTime;
+	TheRoom->Stop();
+	delete TheRoom;
+	return true;
+}
+// End RunPlaythrough function
+
+
+
+// Function:		DoCommand(Room, GameCommand) - Do Command function
+// Description:		Gives a command to the room as GhostEscape does for a key press
+// In:				Room &TheRoom - the room, GameCommand Command - the command
+// Out:				N/a
+void HeadlessDriver::DoCommand(Room &TheRoom, GameCommand Command)
+{
+	TRACE_SCOPE("Command", "game");
+#ifdef TRACING_ENABLED
+	// There is no key press, so the command starts the flow its sounds continue
+	if (TraceLog::IsTracing())
+	{
+		TraceLog &Trace = TraceLog::GetInstance();
+		TraceLog::SetCurrentFlow(Trace.NewFlowId());
+		Trace.AddFlow("Command", "game", TraceLog::FlowStart, TraceLog::GetCurrentFlow());
+	}
+#endif
+
+	switch (Command)
+	{
+	case MOVE_FORWARD_COMMAND:
+		TheRoom.MovePlayer();
+		break;
+	case TURN_LEFT_COMMAND:
+		TheRoom.TurnPlayerLeft();
+		break;
+	case TURN_RIGHT_COMMAND:
+		TheRoom.TurnPlayerRight();
+		break;
+	case CAPTURE_COMMAND:
+		TheRoom.TryToCaptureGhost();
+		break;
+	case RESET_COMMAND:
+		TheRoom.Reset();
+		break;
+	default:
+		// The instructions have nothing to show without a window
+		break;
+	}
+
+#ifdef TRACING_ENABLED
+	TraceLog::SetCurrentFlow(0);
+#endif
+}
+// End DoCommand function
+
+
+
+// Function:		CheckCurves(ostream) - Check Curves function
+// Description:		Creates the null audio device and sweeps an emitter of each type from the listener to a quarter past the end of
+//					its curves. At each distance the gain of the output matrix, relative to that at the first distance, is compared
+//					with the volume curve, and the voice's filter with the LPF direct curve; the curves' lookup tables, which the
+//					game evaluates e.g. the reverb send with, are compared with their points. The LFE curve is only checked through
+//					its table, as the null device has no LFE channel
+// In:				ostream &Report - the stream the largest differences for each type are written to
+// Out:				bool - true if every curve is honoured to within the tolerances
+bool HeadlessDriver::CheckCurves(ostream &Report)
+{
+	if (!XACore::CreateInstance(true) || !XACore::GetInstance()->IsNullDevice())
+	{
+		return false;
+	}
+	const UINT32 Destinations = XACore::GetInstance()->GetChannelCount();
+
+	// The listener stands at the origin facing along z, and the emitter is moved away along z, so only its distance changes
+	X3DAUDIO_LISTENER Listener;
+	SecureZeroMemory(&Listener, sizeof(X3DAUDIO_LISTENER));
+	Listener.OrientFront.z = 1.0f;
+	Listener.OrientTop.y = 1.0f;
+
+	bool Ok = true;
+	for (int Type = 0; Type < EMITTER_TYPE_COUNT; Type++)
+	{
+		XASound Sound(HEADLESS_CURVE_SOUND, true);
+		DistanceCurveSet *Curves = DistanceCurves::GetCurveSet(EmitterType(Type));
+		if ((!Sound.IsValid()) || (Curves == NULL) || (Curves->Volume.GetCurve() == NULL)
+			|| ((Sound.GetChannelCount() * Destinations) > UINT32(XASound::MaxMatrixSize)))
+		{
+			Report << "curve check " << EmitterTypeNames[Type] << ": could not set up the emitter" << endl;
+			return false;
+		}
+		X3DAUDIO_VECTOR Position = { 0.0f, 0.0f, 0.0f };
+		Emitter SweepEmitter(&Sound, Position, &Listener, true);
+		SweepEmitter.SetEmitterType(EmitterType(Type));
+		SweepEmitter.PlayEmitter();
+
+		DistanceCurve *Tabled[] = { &Curves->Volume, &Curves->LFE, &Curves->LPFDirect, &Curves->Reverb };
+		float VolumeError = 0.0f;
+		float FilterError = 0.0f;
+		float TableError = 0.0f;
+		float ReferenceGain = 0.0f;
+		float ReferenceVolume = 0.0f;
+		for (int Step = 1; Step <= HEADLESS_CURVE_STEPS; Step++)
+		{
+			// Set the emitter's settings for the distance on its voice straight away, rather than ramped to
+			float Distance = 1.25f * float(Step) / float(HEADLESS_CURVE_STEPS);
+			Position.z = Distance * Curves->DistanceScaler;
+			SweepEmitter.SetPosition(Position);
+			SweepEmitter.UpdateEmitter();
+			Sound.ApplyChangesNow();
+
+			// The panning is the same at every distance, so the matrix's gain relative to the first distance's is the volume curve's
+			float Matrix[XASound::MaxMatrixSize];
+			Sound.GetSourceVoice()->GetOutputMatrix(NULL, Sound.GetChannelCount(), Destinations, Matrix);
+			float Gain = 0.0f;
+			for (UINT32 i = 0; i < (Sound.GetChannelCount() * Destinations); i++)
+			{
+				Gain += Matrix[i] * Matrix[i];
+			}
+			Gain = sqrtf(Gain);
+			float Volume = CurveValue(Curves->Volume.GetCurve(), Distance);
+			if (Step == 1)
+			{
+				ReferenceGain = Gain;
+				ReferenceVolume = Volume;
+			}
+			if ((ReferenceGain <= 0.0f) || (ReferenceVolume <= 0.0f))
+			{
+				VolumeError = 1.0f;
+			}
+			else if (fabsf((Gain / ReferenceGain) - (Volume / ReferenceVolume)) > VolumeError)
+			{
+				VolumeError = fabsf((Gain / ReferenceGain) - (Volume / ReferenceVolume));
+			}
+
+			// The filter's frequency is 2 sin(pi/6 * coefficient), as XASound::Apply3DSettings sets it
+			if (Curves->LPFDirect.GetCurve() != NULL)
+			{
+				XAUDIO2_FILTER_PARAMETERS Filter;
+				Sound.GetSourceVoice()->GetFilterParameters(&Filter);
+				float Error = fabsf((asinf(Filter.Frequency / 2.0f) * 6.0f / X3DAUDIO_PI) - CurveValue(Curves->LPFDirect.GetCurve(), Distance));
+				if (Error > FilterError)
+				{
+					FilterError = Error;
+				}
+			}
+
+			for (int i = 0; i < 4; i++)
+			{
+				float Error = (Tabled[i]->GetCurve() != NULL) ? fabsf(Tabled[i]->Evaluate(Distance) - CurveValue(Tabled[i]->GetCurve(), Distance)) : 0.0f;
+				if (Error > TableError)
+				{
+					TableError = Error;
+				}
+			}
+		}
+		SweepEmitter.StopEmitter();
+
+		bool Honoured = (VolumeError <= HEADLESS_CURVE_TOLERANCE) && (FilterError <= HEADLESS_CURVE_TOLERANCE) && (TableError <= HEADLESS_TABLE_TOLERANCE);
+		Report << "curve check " << EmitterTypeNames[Type] << ": volume error " << VolumeError << ", filter error " << FilterError
+			<< ", table error " << TableError << (Honoured ? " - ok" : " - not honoured") << endl;
+		Ok = Ok && Honoured;
+	}
+	Report << "curve check " << (Ok ? "passed" : "failed") << endl;
+	return Ok;
+}
+// End CheckCurves function
+
+
+
+// Function:		CheckSpatializer(ostream) - Check Spatializer function
+// Description:		Works out the output matrices of emitters of each type round the listener with the Spatializer and with X3DAudio,
+//					for each of the speaker layouts from mono to 7.1, and compares every coefficient. The emitters are at
+//					HEADLESS_SPATIAL_AZIMUTHS azimuths round the listener and at a few multiples of their curves' distance scaler,
+//					every other one with a cone like Emitter::CreateEmitterCone's
+// In:				ostream &Report - the stream the largest difference for each layout is written to
+// Out:				bool - true if every coefficient is within SPATIALIZER_TOLERANCE of X3DAudio's
+bool HeadlessDriver::CheckSpatializer(ostream &Report)
+{
+	const UINT32 Masks[] = { SPEAKER_MONO, SPEAKER_STEREO, SPEAKER_2POINT1, SPEAKER_QUAD, SPEAKER_5POINT1, SPEAKER_5POINT1_SURROUND, SPEAKER_7POINT1_SURROUND };
+	const char *MaskNames[] = { "mono", "stereo", "2.1", "quad", "5.1", "5.1 surround", "7.1 surround" };
+	const int MaskCount = sizeof(Masks) / sizeof(Masks[0]);
+	const float Distances[] = { 0.25f, 0.75f, 1.5f, 3.0f };
+	const int DistanceCount = sizeof(Distances) / sizeof(Distances[0]);
+
+	// The listener stands at the origin, turned a little so its axes aren't the world's
+	X3DAUDIO_LISTENER Listener;
+	SecureZeroMemory(&Listener, sizeof(X3DAUDIO_LISTENER));
+	Listener.OrientFront.x = sinf(0.3f);
+	Listener.OrientFront.z = cosf(0.3f);
+	Listener.OrientTop.y = 1.0f;
+	X3DAUDIO_CONE Cone;
+	SecureZeroMemory(&Cone, sizeof(X3DAUDIO_CONE));
+	Cone.InnerAngle = 1.0f;
+	Cone.InnerVolume = 1.5f;
+	Cone.OuterAngle = 1.2f;
+	Cone.OuterVolume = 0.5f;
+
+	// The emitters a little above the listener's ears, facing every way so the cones are heard from inside, outside and between
+	vector<X3DAUDIO_EMITTER> Emitters(EMITTER_TYPE_COUNT * DistanceCount * HEADLESS_SPATIAL_AZIMUTHS);
+	vector<const X3DAUDIO_EMITTER*> EmitterList(Emitters.size());
+	for (size_t i = 0; i < Emitters.size(); i++)
+	{
+		int Type = int(i % EMITTER_TYPE_COUNT);
+		int Distance = int((i / EMITTER_TYPE_COUNT) % DistanceCount);
+		int Step = int(i / (EMITTER_TYPE_COUNT * DistanceCount));
+		DistanceCurveSet *Curves = DistanceCurves::GetCurveSet(EmitterType(Type));
+		if ((Curves == NULL) || (Curves->Volume.GetCurve() == NULL))
+		{
+			Report << "spatializer check " << EmitterTypeNames[Type] << ": the emitter type has no curves" << endl;
+			return false;
+		}
+		float Azimuth = float(Step) * (X3DAUDIO_2PI / float(HEADLESS_SPATIAL_AZIMUTHS));
+		float Range = Distances[Distance] * Curves->DistanceScaler;
+		float Facing = float(i) * 0.37f;
+		X3DAUDIO_EMITTER &Spatial = Emitters[i];
+		SecureZeroMemory(&Spatial, sizeof(X3DAUDIO_EMITTER));
+		Spatial.Position.x = Range * sinf(Azimuth);
+		Spatial.Position.y = 0.5f;
+		Spatial.Position.z = Range * cosf(Azimuth);
+		Spatial.OrientFront.x = sinf(Facing);
+		Spatial.OrientFront.z = cosf(Facing);
+		Spatial.OrientTop.y = 1.0f;
+		Spatial.ChannelCount = 1;
+		Spatial.DopplerScaler = 1.0f;
+		Spatial.CurveDistanceScaler = Curves->DistanceScaler;
+		Spatial.pVolumeCurve = Curves->Volume.GetCurve();
+		Spatial.pLFECurve = Curves->LFE.GetCurve();
+		Spatial.pCone = ((Step % 2) == 0) ? &Cone : NULL;
+		EmitterList[i] = &Spatial;
+	}
+
+	bool Ok = true;
+	for (int Mask = 0; Mask < MaskCount; Mask++)
+	{
+		Spatializer Speakers(Masks[Mask]);
+		if ((!Speakers.IsValid()) || (!Speakers.IsSupported(EmitterList[0], &Listener)))
+		{
+			Report << "spatializer check " << MaskNames[Mask] << ": could not set up the speakers" << endl;
+			return false;
+		}
+		const UINT32 Channels = Speakers.GetChannelCount();
+		vector<float> Matrices(Emitters.size() * Channels);
+		Speakers.CalculateMatrices(&Listener, &EmitterList[0], EmitterList.size(), &Matrices[0], Channels);
+
+		X3DAUDIO_HANDLE Handle;
+		X3DAudioInitialize(Masks[Mask], X3DAUDIO_SPEED_OF_SOUND, Handle);
+		vector<float> Reference(Channels);
+		float Largest = 0.0f;
+		size_t LargestAt = 0;
+		for (size_t i = 0; i < Emitters.size(); i++)
+		{
+			X3DAUDIO_DSP_SETTINGS Settings;
+			SecureZeroMemory(&Settings, sizeof(X3DAUDIO_DSP_SETTINGS));
+			Settings.SrcChannelCount = 1;
+			Settings.DstChannelCount = Channels;
+			Settings.pMatrixCoefficients = &Reference[0];
+			X3DAudioCalculate(Handle, &Listener, &Emitters[i], X3DAUDIO_CALCULATE_MATRIX, &Settings);
+			for (UINT32 Speaker = 0; Speaker < Channels; Speaker++)
+			{
+				float Difference = fabsf(Matrices[(i * Channels) + Speaker] - Reference[Speaker]);
+				if (Difference > Largest)
+				{
+					Largest = Difference;
+					LargestAt = (i * Channels) + Speaker;
+				}
+			}
+		}
+
+		size_t Worst = LargestAt / Channels;
+		bool Matches = (Largest <= SPATIALIZER_TOLERANCE);
+		Report << "spatializer check " << MaskNames[Mask] << ": largest difference " << Largest << ", speaker " << (LargestAt % Channels)
+			<< " for the " << EmitterTypeNames[Worst % EMITTER_TYPE_COUNT] << " emitter at "
+			<< (Worst / (EMITTER_TYPE_COUNT * DistanceCount)) * (360 / HEADLESS_SPATIAL_AZIMUTHS) << " degrees and "
+			<< Distances[(Worst / EMITTER_TYPE_COUNT) % DistanceCount] << " of its distance scaler" << (Matches ? " - ok" : " - does not match") << endl;
+		Ok = Ok && Matches;
+	}
+	Report << "spatializer check " << (Ok ? "passed" : "failed") << endl;
+	return Ok;
+}
+// End CheckSpatializer function
+
+
+
+// Function:		WriteSummary(ostream) - Write Summary function
+// Description:		Writes the number of playthroughs, escapes and ticks, and the rate they were run at
+// In:				ostream &Summary - the stream to write to
+// Out:				N/a
+void HeadlessDriver::WriteSummary(ostream &Summary) const
+{
+	Summary << "playthroughs " << mPlaythroughs << endl;
+	Summary << "escapes " << mEscapes << endl;
+	Summary << "ticks " << mTicksRun << endl;
+	if (mSwarmSize > 0)
+	{
+		Summary << "swarm critters " << mSwarmSize << endl;
+	}
+	for (size_t i = 0; i < mCompareRates.size(); i++)
+	{
+		// The real time a second of game time takes is the fraction of a core the game thread would use at this rate
+		const PlaythroughOutcome &Totals = mRateTotals[i];
+		Summary << "tick rate " << mCompareRates[i] << " Hz: escapes " << Totals.Escapes << ", stages " << Totals.Stages
+			<< ", ghost speed " << Speed(Totals.GhostDistance, Totals.GhostTime) << ", critter speed " << Speed(Totals.CritterDistance, Totals.CritterTime)
+			<< ", ghost journeys " << Totals.GhostJourneys.size() << ", critter crossings " << Totals.CritterJourneys.size()
+			<< ", real time per game second " << ((Totals.EndTime > 0.0) ? (Totals.WallTime / Totals.EndTime) : 0.0) << endl;
+	}
+	if (!mCompareRates.empty())
+	{
+		Summary << "tick rate differences " << mDifferences << endl;
+	}
+	Summary << "wall time (s) " << mWallTime << endl;
+	if (mWallTime > 0.0)
+	{
+		Summary << "playthroughs per second " << (mPlaythroughs / mWallTime) << endl;
+		Summary << "ticks per second " << (mTicksRun / mWallTime) << endl;
+	}
+#ifdef PROFILING_ENABLED
+	Summary << endl;
+	AllanMilne::Profiler::GetInstance().WriteReport(Summary);
+#endif
+}
+// End WriteSummary function
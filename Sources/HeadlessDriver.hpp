@@ -0,0 +1,315 @@
+/*
+	File:	HeadlessDriver.hpp
+	Version:	1.1
+	Date:	18th October 2026
+	Author:	agent
+
+	Exposes:	HeadlessDriver, ScriptedCommand.
+	Requires:	Room, RoomLayout, XACore, GameTimer, Profiler, TraceLog, SessionRecording, GhostEscape (for the GameCommand values),
+				Emitter and DistanceCurves (for the curve check), Spatializer (for the spatializer check).
+
+	Description:
+	Runs the Room game loop without a window, audio device or keyboard, for soak and performance testing.
+
+	*	XACore is created on its null device, so the sounds are software voices whose playback is simulated;
+	*	GameTimer's simulated clock is used, and is moved on by exactly one tick (1 / TICK_RATE seconds, the recording's
+		tick rate when replaying, or the tick rate asked for) per update, so every timer in the game sees the same times on every run;
+	*	each playthrough creates a new Room seeded from its own seed, so a playthrough can be repeated on its own;
+		the room is set up from the default layout, or a room of a layout file;
+	*	the game's commands are read from a script, or from a game recorded with GhostEscape::RecordSession(), and given to the
+		room at their scripted times or recorded ticks, in the same way GhostEscape::ProcessFrame() gives it the commands from the keyboard;
+	*	the ticks are run as fast as possible, or paced to a multiple of real time;
+	*	a playthrough ends when the player exits the door or the time limit is reached;
+	*	optionally, a comma separated trace of the game state (see Room::WriteTrace) is written for every tick, prefixed with the seed.
+
+	The game's speed shouldn't depend on its tick rate, so each playthrough can be run at several tick rates and the runs
+	compared with the first rate's. A run differs if the player escapes in one and not the other, the ghost reaches a
+	different number of stages, the playthrough ends more than HEADLESS_COMPARE_TICKS ticks of the lower rate apart, the
+	ghost's or critters' speed differs by more than HEADLESS_SPEED_TOLERANCE of the first rate's, or the ghost's journeys to its
+	stages or the critters' crossings take different times. They move in fixed sub-steps (see Ghost.hpp and MovingCritter.hpp),
+	so their journeys should take exactly the same time at any rate; the critters chase the player, so their crossings only
+	match while the player stands still, and scripts for comparisons should have the player still. The speeds are measured over
+	the ticks they were moving throughout, and the real time each rate takes for a second of game time is reported as the
+	fraction of a core the game thread would use at that rate. A scripted command can land a tick later at a lower rate, so
+	scripts for comparisons should give their commands clear of the moments things happen.
+
+	Instead of the playthroughs it can check that the emitters' distance curves (see DistanceCurves.hpp) are honoured: an
+	emitter of each type is swept away from the listener on the null device, and the matrix and filter sent to its voice
+	are compared with the curves' points (see CheckCurves). It can also check that the portable Spatializer's output matrices
+	match X3DAudio's on each speaker layout from mono to 7.1 (see CheckSpatializer and Spatializer.hpp).
+
+	The script is a text file with one command per line: the time in seconds followed by one of
+	move, left, right, capture or reset. Blank lines and lines starting with '#' are ignored.
+
+	It is run from WinMain when the command line contains -headless, with the optional arguments:
+		-seed <n>		the seed of the first playthrough (default 1); playthroughs use consecutive seeds;
+		-runs <n>		the number of playthroughs (default 1);
+		-script <file>	the command script (default none - the player does nothing);
+		-replay <file>	replay a recorded game; its commands replace the script, and its seed is used unless -seed follows;
+		-record <file>	record the first playthrough's seed and commands, e.g. to turn a script into a recording;
+		-layout <file>	set the rooms up from a text or binary layout file (see RoomLayout.hpp);
+		-room <n>		the room of the layout to use (default 0);
+		-swarm <n>		add a swarm of n critters to each room (see CritterSwarm.hpp), to time the game with many actors;
+		-speed <x>		run at x times real time (default 0 - as fast as possible);
+		-tickrate <hz>	the ticks per second of game time (default TICK_RATE);
+		-tickrates <hz>,<hz>...	run each playthrough at each of the tick rates and compare them; the exit code is 1 if any differ;
+		-timeline <file>	write a Chrome Trace Event timeline of the ticks, commands and sounds (builds with tracing);
+		-trace <file>	write the per tick trace to the file;
+		-limit <s>		the game time limit of each playthrough in seconds (default HEADLESS_TIME_LIMIT);
+		-checkcurves	check the distance curves instead; the exit code is 1 if one isn't honoured;
+		-checkspatializer	check the Spatializer against X3DAudio instead; the exit code is 1 if a coefficient differs by more
+						than SPATIALIZER_TOLERANCE. With -checkcurves both checks are made.
+	A summary of the runs, including the playthroughs and ticks run per second, is written to standard output;
+	in builds with profiling it is followed by the Profiler's report of the instrumented scopes.
+*/
+
+// Define the class
+#ifndef __HEADLESSDRIVER_HPP__
+#define __HEADLESSDRIVER_HPP__
+
+// System includes.
+#include <string>
+#include <vector>
+#include <fstream>
+#include <ostream>
+using std::string;
+using std::vector;
+using std::ofstream;
+using std::ostream;
+
+// Application includes.
+#include "GhostEscape.hpp"
+#include "SessionRecording.hpp"
+#include "RoomLayout.hpp"
+
+// The default game time limit of a playthrough, in seconds
+#define HEADLESS_TIME_LIMIT 300.0f
+
+// The curve check's sound, the distances it sweeps, and how far the settings sent to the voice (as a fraction of full scale) and
+// the curves' lookup tables may differ from the curves' points
+#define HEADLESS_CURVE_SOUND "Sounds/DefaultGhostNoise.wav"
+#define HEADLESS_CURVE_STEPS 45
+#define HEADLESS_CURVE_TOLERANCE 0.001f
+#define HEADLESS_TABLE_TOLERANCE 0.01f
+
+// The spatializer check's emitters are at this many azimuths round the listener, evenly spaced
+#define HEADLESS_SPATIAL_AZIMUTHS 72
+
+// How far apart, in ticks of the lower rate, playthroughs run at two tick rates may end, and how much, as a fraction, the
+// ghost's and critters' speeds may differ: a tick's movement is measured as a straight line, which cuts the corners of a path
+#define HEADLESS_COMPARE_TICKS 4
+#define HEADLESS_SPEED_TOLERANCE 0.01f
+
+// A command from the script and the game time it is given at
+struct ScriptedCommand
+{
+	float Time;				// Game time in seconds
+	GameCommand Command;	// The command given
+};
+
+// The outcome of a playthrough, compared between tick rates; summed over the playthroughs run at each rate
+struct PlaythroughOutcome
+{
+	unsigned int Escapes;		// 1 if the player escaped
+	unsigned int Stages;		// Stages the ghost moved to
+	double EndTime;				// Game time in seconds when the playthrough ended
+	double WallTime;			// Real time in seconds the playthrough took
+	double GhostDistance;		// Distance the ghost moved in the ticks it moved throughout, and the time of those ticks
+	double GhostTime;
+	double CritterDistance;		// The same for the critters
+	double CritterTime;
+	vector<float> GhostJourneys;	// The game time each journey of the ghost to a stage took, and each crossing of the critters
+	vector<float> CritterJourneys;
+};
+
+// Forward declarations.
+class Room;
+
+// The HeadlessDriver class
+class HeadlessDriver
+{
+// Public Member functions and variables
+public:
+
+	// Function:		HeadlessDriver() - HeadlessDriver constructor
+	// Description:		Sets the default options; nothing is created until Run or RunPlaythroughs is called
+	// In:				N/a
+	// Out:				N/a
+	HeadlessDriver();
+
+	// Function:		~HeadlessDriver() - HeadlessDriver destructor
+	// Description:		Closes the trace file and switches the simulated clock off
+	// In:				N/a
+	// Out:				N/a
+	~HeadlessDriver();
+
+	// Function:		Run(string) - Run function
+	// Description:		Reads the options from the command line, runs the playthroughs and writes the summary to standard output
+	// In:				const string &CommandLine - the application's command line
+	// Out:				int - the application exit code; 0 if all playthroughs ran, 1 if the options or the room were invalid
+	int Run(const string &CommandLine);
+
+	// Function:		LoadScript(string) - Load Script function
+	// Description:		Reads the scripted commands from a file, sorted into time order
+	// In:				const string &FileName - the script file
+	// Out:				bool - false if the file could not be read or has a line that is not a valid command
+	bool LoadScript(const string &FileName);
+
+	// Function:		LoadRecording(string, unsigned int) - Load Recording function
+	// Description:		Reads a recorded game; its commands replace the script and its tick rate is used for the playthroughs
+	// In:				const string &FileName - the recording file, unsigned int &Seed - set to the recording's seed
+	// Out:				bool - false if the file could not be read or isn't a recording
+	bool LoadRecording(const string &FileName, unsigned int &Seed);
+
+	// Function:		RecordTo(string) - Record To function
+	// Description:		Asks for the first playthrough to be recorded; the file is created when the playthrough starts
+	// In:				const string &FileName - the recording file
+	// Out:				N/a
+	inline void RecordTo(const string &FileName) { mRecordingFile = FileName; }
+
+	// Function:		LoadLayout(string) - Load Layout function
+	// Description:		Reads the layout the rooms are set up from
+	// In:				const string &FileName - the text or binary layout file
+	// Out:				bool - false if the file could not be read or isn't a valid layout; the reason is written to standard error
+	bool LoadLayout(const string &FileName);
+
+	// Function:		SetLayoutRoom(unsigned int) - Set Layout Room function
+	// Description:		Sets the room of the layout the playthroughs are played in
+	// In:				unsigned int RoomIndex - the room
+	// Out:				N/a
+	inline void SetLayoutRoom(unsigned int RoomIndex) { mLayoutRoom = RoomIndex; }
+
+	// Function:		SetSwarmSize(unsigned int) - Set Swarm Size function
+	// Description:		Sets the number of critters in the swarm added to each room
+	// In:				unsigned int Count - the number of critters; 0 for no swarm
+	// Out:				N/a
+	inline void SetSwarmSize(unsigned int Count) { mSwarmSize = Count; }
+
+	// Function:		OpenTrace(string) - Open Trace function
+	// Description:		Opens the file the per tick trace is written to and writes the column names
+	// In:				const string &FileName - the trace file
+	// Out:				bool - false if the file could not be opened
+	bool OpenTrace(const string &FileName);
+
+	// Function:		SetTimeLimit(float) - Set Time Limit function
+	// Description:		Sets the game time after which a playthrough is ended if the player hasn't escaped
+	// In:				float Seconds - the limit in seconds of game time
+	// Out:				N/a
+	inline void SetTimeLimit(float Seconds) { mTimeLimit = Seconds; }
+
+	// Function:		SetSpeed(float) - Set Speed function
+	// Description:		Paces the ticks to a multiple of real time
+	// In:				float Speed - e.g. 1 for real time or 4 for four times as fast; 0 or less runs as fast as possible
+	// Out:				N/a
+	inline void SetSpeed(float Speed) { mSpeed = Speed; }
+
+	// Function:		SetTickRate(float) - Set Tick Rate function
+	// Description:		Sets the ticks per second of game time the playthroughs are run at
+	// In:				float Rate - the tick rate; must be more than 0
+	// Out:				N/a
+	inline void SetTickRate(float Rate) { mTickRate = Rate; }
+
+	// Function:		CompareTickRates(vector<float>) - Compare Tick Rates function
+	// Description:		Asks for each playthrough to be run at each of the tick rates and compared with the first rate's
+	// In:				const vector<float> &Rates - the tick rates, each more than 0; fewer than 2 runs each playthrough once
+	// Out:				N/a
+	void CompareTickRates(const vector<float> &Rates);
+
+	// Function:		RunPlaythroughs(unsigned int, unsigned int) - Run Playthroughs function
+	// Description:		Creates the null audio device and the simulated clock, and runs a number of playthroughs with consecutive seeds
+	// In:				unsigned int FirstSeed - the seed of the first playthrough, unsigned int Count - the number of playthroughs
+	// Out:				bool - false if the null audio device or a room could not be created
+	bool RunPlaythroughs(unsigned int FirstSeed, unsigned int Count);
+
+	// Function:		CheckCurves(ostream) - Check Curves function
+	// Description:		Creates the null audio device and sweeps an emitter of each type from the listener to a quarter past the end of
+	//					its curves. At each distance the gain of the output matrix, relative to that at the first distance, is compared
+	//					with the volume curve, and the voice's filter with the LPF direct curve; the curves' lookup tables, which the
+	//					game evaluates e.g. the reverb send with, are compared with their points. The LFE curve is only checked through
+	//					its table, as the null device has no LFE channel
+	// In:				ostream &Report - the stream the largest differences for each type are written to
+	// Out:				bool - true if every curve is honoured to within the tolerances
+	bool CheckCurves(ostream &Report);
+
+	// Function:		CheckSpatializer(ostream) - Check Spatializer function
+	// Description:		Works out the output matrices of emitters of each type round the listener with the Spatializer and with X3DAudio,
+	//					for each of the speaker layouts from mono to 7.1, and compares every coefficient
+	// In:				ostream &Report - the stream the largest difference for each layout is written to
+	// Out:				bool - true if every coefficient is within SPATIALIZER_TOLERANCE of X3DAudio's
+	bool CheckSpatializer(ostream &Report);
+
+	// Function:		WriteSummary(ostream) - Write Summary function
+	// Description:		Writes the number of playthroughs, escapes and ticks, and the rate they were run at
+	// In:				ostream &Summary - the stream to write to
+	// Out:				N/a
+	void WriteSummary(ostream &Summary) const;
+
+	// Accessors for the results of the runs
+	inline unsigned int GetPlaythroughs() const { return mPlaythroughs; }
+	inline unsigned int GetEscapes() const { return mEscapes; }
+	inline unsigned long GetTicksRun() const { return mTicksRun; }
+	inline double GetWallTime() const { return mWallTime; }
+	inline unsigned int GetDifferences() const { return mDifferences; }
+
+// Private member functions and variables
+private:
+
+	// Function:		RunPlaythrough(unsigned int, PlaythroughOutcome) - Run Playthrough function
+	// Description:		Runs one playthrough in a new room until the player escapes or the time limit is reached
+	// In:				unsigned int Seed - the seed for the room, PlaythroughOutcome &Outcome - set to the playthrough's outcome
+	// Out:				bool - false if the room could not be created
+	bool RunPlaythrough(unsigned int Seed, PlaythroughOutcome &Outcome);
+
+	// Function:		RunAtTickRates(unsigned int) - Run At Tick Rates function
+	// Description:		Runs a playthrough at each of the compared tick rates, adds the outcomes to the rates' totals, and writes
+	//					how each run differs from the first rate's to standard error
+	// In:				unsigned int Seed - the seed for the room
+	// Out:				bool - false if a room could not be created
+	bool RunAtTickRates(unsigned int Seed);
+
+	// Function:		DoCommand(Room, GameCommand) - Do Command function
+	// Description:		Gives a command to the room as GhostEscape does for a key press
+	// In:				Room &TheRoom - the room, GameCommand Command - the command
+	// Out:				N/a
+	void DoCommand(Room &TheRoom, GameCommand Command);
+
+	// The scripted commands in time order
+	vector<ScriptedCommand> mScript;
+
+	// The trace file, and true if it is open
+	ofstream mTrace;
+	bool mTracing;
+
+	// The recording of the first playthrough, if one was asked for
+	string mRecordingFile;
+	SessionRecorder mRecorder;
+
+	// The layout the rooms are set up from, if one was loaded, and its room
+	RoomLayout mLayout;
+	unsigned int mLayoutRoom;
+
+	// The number of critters in the swarm added to each room; 0 for none
+	unsigned int mSwarmSize;
+
+	// Game time limit of a playthrough in seconds
+	float mTimeLimit;
+
+	// Updates per second of game time, and the multiple of real time to run at (0 for as fast as possible)
+	float mTickRate;
+	float mSpeed;
+
+	// The tick rates each playthrough is run at, if they are compared, with the totals of the outcomes at each rate,
+	// and the number of runs that differed from the first rate's
+	vector<float> mCompareRates;
+	vector<PlaythroughOutcome> mRateTotals;
+	unsigned int mDifferences;
+
+	// Results of the runs
+	unsigned int mPlaythroughs;
+	unsigned int mEscapes;
+	unsigned long mTicksRun;
+	double mWallTime;		// Real time taken by the playthroughs in seconds
+};
+// end HeadlessDriver class.
+
+#endif
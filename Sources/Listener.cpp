@@ -1,12 +1,12 @@
 /*
 	--Original--
 	file:	Listener.cpp
-	Version:	2.5
-	Date:	27th April 2015
+	Version:	2.6
+	Date:	18th October 2026
 	Author:	Cassie Bennett
 
 	Exposes:	Implementation of the Listener class.
-	Requires:	X3DAudio
+	Requires:	X3DAudio, GameTimer
 
 	Description:
 	Has the functionality for the Listener object to initialise and set the new positions/orientations of the Listener throughout
@@ -48,6 +48,15 @@ Listener::Listener(X3DAUDIO_VECTOR StartPosition, Direction StartOrientation)
 	mBodyOrient = mListener.OrientFront;
 	mBodyOrientation = StartOrientation;
 
+	// No move or turn in progress
+	mTargetPosition = mListener.Position;
+	mMoveStartPosition = mListener.Position;
+	mTurnStartFront = mListener.OrientFront;
+	mMoveDuration = 0.0f;
+	mTurnDuration = 0.0f;
+	mMoveTweening = false;
+	mTurnTweening = false;
+
 	// Set the OrientTop vector so that positive y is the upright axis
 	mListener.OrientTop.x = 0.0f;
 	mListener.OrientTop.y = 1.0f;
@@ -62,7 +71,7 @@ Listener::Listener(X3DAUDIO_VECTOR StartPosition, Direction StartOrientation)
 
 
 // Function:		Reset() - Reset function
-// Description:		Resets the listener's position and orientation to the initial vectors 
+// Description:		Resets the listener's position and orientation to the initial vectors, cancelling any move or turn in progress
 // In:				N/a
 // Out:				N/a
 void Listener::Reset()
@@ -81,8 +90,13 @@ void Listener::Reset()
 // Out:				N/a
 void Listener::MoveTo (X3DAUDIO_VECTOR NewPosition)
 {
-	// Set the position of the Listener to the new position passed into the function
+	// Set the position of the Listener to the new position passed into the function, stopping any move in progress
 	mListener.Position = NewPosition;
+	mTargetPosition = NewPosition;
+	mListener.Velocity.x = 0.0f;
+	mListener.Velocity.y = 0.0f;
+	mListener.Velocity.z = 0.0f;
+	mMoveTweening = false;
 	// Set the mListenerMoving function to true to tell the Player class that the Listener has moved
 	mListenerMoving = true;
 } 
@@ -91,20 +105,43 @@ void Listener::MoveTo (X3DAUDIO_VECTOR NewPosition)
 
 
 // Move forward supplied number of units in current orientation direction.
-// Function:		MoveForward() - Move Forward function
+// Function:		MoveForward(float, float) - Move Forward function
 // Description:		Uses the current orientation of the Listener, and moves the Listener forward in this direction by the distance
 //					Default distance is set to 1.0f, therefore moves 1 unit in the orientation direction when this function is called
 //					When the Up Arrow is pressed in the Room function when the player can move forward.
+//					If a duration is given the listener moves there over that time in UpdateTween, otherwise it moves straight away.
 // In:				float ThisDistance - Value for the distance the Listener will move in that direction, by default is set to 1.0f
+//					float Duration - Time in seconds to take over the move, by default 0 (immediate)
 // Out:				N/a
-void Listener::MoveForward(float Distance)
+void Listener::MoveForward(float Distance, float Duration)
 {
 	// Use the current orientation of the player and find the values of the x y and z
-	// Add these values multiplied by the distance passed in in order to move the Listener in that direction
+	// Add these values multiplied by the distance passed in in order to find where the Listener moves to in that direction
 	// E.g. if mBodyOrientation = South {0.0f, 0.0f, -1.0f} therefore will move by -1 + (-1 * distance) in the z axis
-	mListener.Position.x += Orientations[mBodyOrientation].x * Distance;
-	mListener.Position.y += Orientations[mBodyOrientation].y * Distance;
-	mListener.Position.z += Orientations[mBodyOrientation].z * Distance;
+	// The move is from the target of any move still in progress, so the listener always ends on the grid
+	mTargetPosition.x += Orientations[mBodyOrientation].x * Distance;
+	mTargetPosition.y += Orientations[mBodyOrientation].y * Distance;
+	mTargetPosition.z += Orientations[mBodyOrientation].z * Distance;
+
+	if (Duration > 0.0f)
+	{
+		// Glide from where the listener is now, at a constant velocity
+		mMoveStartPosition = mListener.Position;
+		mMoveDuration = Duration;
+		mListener.Velocity.x = (mTargetPosition.x - mMoveStartPosition.x) / Duration;
+		mListener.Velocity.y = (mTargetPosition.y - mMoveStartPosition.y) / Duration;
+		mListener.Velocity.z = (mTargetPosition.z - mMoveStartPosition.z) / Duration;
+		mMoveTimer.Reset();
+		mMoveTweening = true;
+	}
+	else
+	{
+		mListener.Position = mTargetPosition;
+		mListener.Velocity.x = 0.0f;
+		mListener.Velocity.y = 0.0f;
+		mListener.Velocity.z = 0.0f;
+		mMoveTweening = false;
+	}
 
 	// Set mListenerMoving to true to tell the Player class that the Listener is moving
 	mListenerMoving = true;
@@ -114,17 +151,31 @@ void Listener::MoveForward(float Distance)
 
 
 // Turn (rotate about Y-axis) the listener to a specific direction.
-// Function:		TurnTo(const Listener::Direction) - Turn To function
+// Function:		TurnTo(const Listener::Direction, float) - Turn To function
 // Description:		Turns the Listener orientation to the direction that is passed in. This function is called within the
 //					TurnClockwise and TurnCounterClockwise functions in order to use the new found direction and set the Listener
-//					to this new direciton
-// In:				const List
-void Listener::TurnTo (const Listener::Direction NewDirection)
+//					to this new direciton. With a duration the turn starts from the listener's current front vector.
+// In:				const Listener::Direction - The name of the new direction that the Listener is to be set to
+//					float Duration - Time in seconds to take over the turn, by default 0 (immediate)
+// Out:				N/a
+void Listener::TurnTo (const Listener::Direction NewDirection, float Duration)
 {
 	// Set the orientation of the Listener to the new direction passed into the function
 	mBodyOrientation = NewDirection;
-	// Use the orientation within the array of Orientations to find the vector to respresent this direction
-	mListener.OrientFront = Orientations[mBodyOrientation];
+	if (Duration > 0.0f)
+	{
+		// Turn from the current front vector; calling this again part way through a turn restarts it from there
+		mTurnStartFront = mListener.OrientFront;
+		mTurnDuration = Duration;
+		mTurnTimer.Reset();
+		mTurnTweening = true;
+	}
+	else
+	{
+		// Use the orientation within the array of Orientations to find the vector to respresent this direction
+		mListener.OrientFront = Orientations[mBodyOrientation];
+		mTurnTweening = false;
+	}
 	// Set mListenerTurning to true to tell the Player class that the Listener is turning
 	mListenerTurning = true;
 } 
@@ -136,9 +187,9 @@ void Listener::TurnTo (const Listener::Direction NewDirection)
 // Description:		This function finds the current direction of the Listener and changes it to the direction that is 'Counterclockwise' 
 //					to the current direction based on the order of them  in the Direction enum. For counterclockwise, the direction  
 //					moves negatively along the enum to turn the player Left 
-// In:				N/a
+// In:				float Duration - Time in seconds to take over the turn, by default 0 (immediate)
 // Out:				N/a
-void Listener::TurnCounterClockwise()
+void Listener::TurnCounterClockwise(float Duration)
 {
 	// Get the integer value of the enum current BodyOrientation
 	int NewDirection = int(mBodyOrientation);
@@ -156,7 +207,7 @@ void Listener::TurnCounterClockwise()
 	mBodyOrientation = (Direction)NewDirection;
 	
 	// Use this orientation to turn the Listener to this new orientation in the TurnTo function
-	TurnTo(mBodyOrientation);
+	TurnTo(mBodyOrientation, Duration);
 
 	// Set the mListenerTurning function to true to tell the player that the Listener is turning
 	mListenerTurning = true;
@@ -169,9 +220,9 @@ void Listener::TurnCounterClockwise()
 // Description:		This function finds the current direction of the Listener and changes it to the direction that is 'Clockwise' 
 //					to the current direction based on the order of them  in the Direction enum. For clockwise, the direction  
 //					moves positively along the enum to turn the player right
-// In:				N/a
+// In:				float Duration - Time in seconds to take over the turn, by default 0 (immediate)
 // Out:				N/a
-void Listener::TurnClockwise ()
+void Listener::TurnClockwise (float Duration)
 {
 	// Get the integer value of the enum current BodyOrientation
 	int NewDirection = int(mBodyOrientation);
@@ -189,11 +240,107 @@ void Listener::TurnClockwise ()
 	mBodyOrientation = (Direction)NewDirection;
 
 	// Use this orientation to turn the Listener to this new orientation in the TurnTo function
-	TurnTo(mBodyOrientation);
+	TurnTo(mBodyOrientation, Duration);
 
 	// Set the mListenerTurning function to true to tell the player that the Listener is turning
 	mListenerTurning = true;
 } 
 // end TurnClockwise function.
 
+
+
+// Function:		UpdateTween() - Update Tween function
+// Description:		Called every frame. Moves the listener struct along any move or turn in progress based on the time since it started;
+//					the position is interpolated and the orientation slerped. Sets the listener velocity while moving, zero otherwise.
+// In:				N/a
+// Out:				bool - true if the listener's position or orientation changed
+bool Listener::UpdateTween()
+{
+	bool Changed = false;
+
+	if (mMoveTweening)
+	{
+		// Find how far through the move the listener is
+		mMoveTimer.Tick();
+		float Fraction = mMoveTimer.GetElapsedTime() / mMoveDuration;
+		if (Fraction >= 1.0f)
+		{
+			// The move has finished, so the listener is at its target and no longer moving
+			Fraction = 1.0f;
+			mMoveTweening = false;
+			mListener.Velocity.x = 0.0f;
+			mListener.Velocity.y = 0.0f;
+			mListener.Velocity.z = 0.0f;
+		}
+		mListener.Position.x = mMoveStartPosition.x + ((mTargetPosition.x - mMoveStartPosition.x) * Fraction);
+		mListener.Position.y = mMoveStartPosition.y + ((mTargetPosition.y - mMoveStartPosition.y) * Fraction);
+		mListener.Position.z = mMoveStartPosition.z + ((mTargetPosition.z - mMoveStartPosition.z) * Fraction);
+		Changed = true;
+	}
+
+	if (mTurnTweening)
+	{
+		// Find how far through the turn the listener is
+		mTurnTimer.Tick();
+		float Fraction = mTurnTimer.GetElapsedTime() / mTurnDuration;
+		if (Fraction >= 1.0f)
+		{
+			Fraction = 1.0f;
+			mTurnTweening = false;
+		}
+		mListener.OrientFront = Slerp(mTurnStartFront, Orientations[mBodyOrientation], Fraction);
+		Changed = true;
+	}
+
+	return Changed;
+}
+// End UpdateTween function
+
+
+
+// Function:		Slerp(X3DAUDIO_VECTOR, X3DAUDIO_VECTOR, float) - Slerp function
+// Description:		Spherical linear interpolation between two unit vectors
+// In:				const X3DAUDIO_VECTOR &From, const X3DAUDIO_VECTOR &To - the start and end vectors, float Fraction - 0 to 1
+// Out:				X3DAUDIO_VECTOR - the interpolated unit vector
+X3DAUDIO_VECTOR Listener::Slerp(const X3DAUDIO_VECTOR &From, const X3DAUDIO_VECTOR &To, float Fraction)
+{
+	// The angle between the two vectors
+	float Dot = (From.x * To.x) + (From.y * To.y) + (From.z * To.z);
+	if (Dot > 1.0f)
+	{
+		Dot = 1.0f;
+	}
+	if (Dot < -1.0f)
+	{
+		Dot = -1.0f;
+	}
+	float Angle = acosf(Dot);
+	float SinAngle = sinf(Angle);
+
+	// Weights for each vector; if they are (nearly) the same, a linear interpolation is accurate enough and avoids dividing by 0
+	float FromWeight = 1.0f - Fraction;
+	float ToWeight = Fraction;
+	if (SinAngle > 0.001f)
+	{
+		FromWeight = sinf((1.0f - Fraction) * Angle) / SinAngle;
+		ToWeight = sinf(Fraction * Angle) / SinAngle;
+	}
+
+	X3DAUDIO_VECTOR Result;
+	Result.x = (From.x * FromWeight) + (To.x * ToWeight);
+	Result.y = (From.y * FromWeight) + (To.y * ToWeight);
+	Result.z = (From.z * FromWeight) + (To.z * ToWeight);
+
+	// X3DAudio needs a unit front vector; keep it normalised against rounding
+	float Length = sqrtf((Result.x * Result.x) + (Result.y * Result.y) + (Result.z * Result.z));
+	if (Length > 0.0f)
+	{
+		Result.x /= Length;
+		Result.y /= Length;
+		Result.z /= Length;
+	}
+	return Result;
+}
+// End Slerp function
+
 // end of code.
\ No newline at end of file
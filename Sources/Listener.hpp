@@ -1,11 +1,11 @@
 /*
 	file:	Listener.hpp
-	Version:	2.0 (Previous ver - 1.5)
-	Date:	27th April 2015
+	Version:	2.1 (Previous ver - 2.0)
+	Date:	18th October 2026
 	Author:	Cassie Bennett
 
 	Exposes:	Listener
-	Requires:	X3DAudio
+	Requires:	X3DAudio, GameTimer
 
 	Description:
 	This Listener class is based and expanded upon the Listener initialisation code given by Allan Milne and created
@@ -18,6 +18,12 @@
 	The listener can be moved and rotated:
 	*	The orientation of the listener can be turned by 45 degrees clockwise and anticlockwise
 	*	The position of the listener can be moved forward in the direction of the orientation by 1 unit
+
+	Moves and turns can be given a duration (the length of the footstep or turning sound) so that the listener glides to its new
+	position and orientation rather than jumping there. The target position and direction are set straight away, so collision checks
+	use where the player is going; UpdateTween moves the X3DAudio listener along the way each frame:
+	*	The position is interpolated linearly and the listener's Velocity is set for the Doppler calculations while it is moving
+	*	The front orientation is slerped from where it was to the new direction
 	
 	A listener object is used for the player in order to hear the sounds around the room. 
 */
@@ -30,6 +36,10 @@
 #include <Windows.h>
 #include <X3DAudio.h>
 #include <memory>
+#include <math.h>
+
+// Framework includes
+#include "GameTimer.h"
 
 // Directions namespace for the orientations used for the listener
 namespace Directions
@@ -81,35 +91,56 @@ public:
 	Listener::Listener(X3DAUDIO_VECTOR StartPosition, Direction StartOrientation);
 
 	// Function:		Reset() - Reset function
-	// Description:		Resets the listener's position and orientation to the initial vectors 
+	// Description:		Resets the listener's position and orientation to the initial vectors, cancelling any move or turn in progress
 	// In:				N/a
 	// Out:				N/a
 	void Reset();
 
 	// Move forward supplied number of units in current orientation direction.
-	// Function:		MoveForward() - Move Forward function
+	// Function:		MoveForward(float, float) - Move Forward function
 	// Description:		Uses the current orientation of the Listener, and moves the Listener forward in this direction by the distance
 	//					Default distance is set to 1.0f, therefore moves 1 unit in the orientation direction when this function is called
 	//					When the Up Arrow is pressed in the Room function when the player can move forward.
+	//					If a duration is given the listener moves there over that time in UpdateTween, otherwise it moves straight away.
 	// In:				float ThisDistance - Value for the distance the Listener will move in that direction, by default is set to 1.0f
+	//					float Duration - Time in seconds to take over the move, by default 0 (immediate)
 	// Out:				N/a
-	void MoveForward (float ThisDistance = 1.0f);
+	void MoveForward (float ThisDistance = 1.0f, float Duration = 0.0f);
 
-	// Function:		TurnCounterClockwise - Turn Counter Clockwise Function
+	// Function:		TurnCounterClockwise(float) - Turn Counter Clockwise Function
 	// Description:		This function finds the current direction of the Listener and changes it to the direction that is 'Counterclockwise' 
 	//					to the current direction based on the order of them  in the Direction enum. For counterclockwise, the direction  
 	//					moves negatively along the enum to turn the player Left 
-	// In:				N/a
+	// In:				float Duration - Time in seconds to take over the turn, by default 0 (immediate)
 	// Out:				N/a
-	void TurnCounterClockwise ();
+	void TurnCounterClockwise (float Duration = 0.0f);
 
-	// Function:		TurnClockwise - Turn Counter Clockwise Function
+	// Function:		TurnClockwise(float) - Turn Counter Clockwise Function
 	// Description:		This function finds the current direction of the Listener and changes it to the direction that is 'Clockwise' 
 	//					to the current direction based on the order of them  in the Direction enum. For clockwise, the direction  
 	//					moves positively along the enum to turn the player right
-	// In:				N/a
+	// In:				float Duration - Time in seconds to take over the turn, by default 0 (immediate)
 	// Out:				N/a
-	void TurnClockwise ();
+	void TurnClockwise (float Duration = 0.0f);
+
+	// Function:		UpdateTween() - Update Tween function
+	// Description:		Called every frame. Moves the listener struct along any move or turn in progress based on the time since it started;
+	//					the position is interpolated and the orientation slerped. Sets the listener velocity while moving, zero otherwise.
+	// In:				N/a
+	// Out:				bool - true if the listener's position or orientation changed
+	bool UpdateTween();
+
+	// Function:		IsTweening() - Is Tweening function
+	// Description:		Returns true if the listener is part way through a move or a turn
+	// In:				N/a
+	// Out:				bool - true if moving or turning
+	inline bool IsTweening() const { return (mMoveTweening || mTurnTweening); }
+
+	// Function:		GetTargetPosition() - Get Target Position function
+	// Description:		Returns the position the listener is moving to (its current position if it isn't moving)
+	// In:				N/a
+	// Out:				X3DAUDIO_VECTOR - the target position
+	inline X3DAUDIO_VECTOR GetTargetPosition() const { return mTargetPosition; }
 
 	// The XAudio2 listener struct.
 	X3DAUDIO_LISTENER mListener;
@@ -131,13 +162,20 @@ private:
 	void MoveTo (X3DAUDIO_VECTOR NewPosition);
 
 	// Turn (rotate about Y-axis) the listener to a specific direction.
-	// Function:		TurnTo(const Listener::Direction) - Turn To function
+	// Function:		TurnTo(const Listener::Direction, float) - Turn To function
 	// Description:		Turns the Listener orientation to the direction that is passed in. This function is called within the
 	//					TurnClockwise and TurnCounterClockwise functions in order to use the new found direction and set the Listener
-	//					to this new direciton
+	//					to this new direciton. With a duration the turn starts from the listener's current front vector.
 	// In:				const Listener::Direction - The name of the new direction that the Listener is to be set to
+	//					float Duration - Time in seconds to take over the turn, by default 0 (immediate)
 	// Out:				N/a
-	void TurnTo (const Listener::Direction NewDirection);
+	void TurnTo (const Listener::Direction NewDirection, float Duration = 0.0f);
+
+	// Function:		Slerp(X3DAUDIO_VECTOR, X3DAUDIO_VECTOR, float) - Slerp function
+	// Description:		Spherical linear interpolation between two unit vectors
+	// In:				const X3DAUDIO_VECTOR &From, const X3DAUDIO_VECTOR &To - the start and end vectors, float Fraction - 0 to 1
+	// Out:				X3DAUDIO_VECTOR - the interpolated unit vector
+	static X3DAUDIO_VECTOR Slerp(const X3DAUDIO_VECTOR &From, const X3DAUDIO_VECTOR &To, float Fraction);
 
 	// Used for storing the start position and direction of the Listener so they can be used in the Reset() function
 	X3DAUDIO_VECTOR mStartPosition;
@@ -147,6 +185,20 @@ private:
 	X3DAUDIO_VECTOR mCurrentPosition;
 	X3DAUDIO_VECTOR mBodyOrient;
 
+	// The position being moved to, and where the current move started
+	X3DAUDIO_VECTOR mTargetPosition;
+	X3DAUDIO_VECTOR mMoveStartPosition;
+	// The front vector when the current turn started
+	X3DAUDIO_VECTOR mTurnStartFront;
+
+	// Timers and durations for the move and turn in progress; a turn can start while a move is still going
+	GameTimer mMoveTimer;
+	GameTimer mTurnTimer;
+	float mMoveDuration;
+	float mTurnDuration;
+	bool mMoveTweening;
+	bool mTurnTweening;
+
 };
 // end Listener class.
 
@@ -9,7 +9,7 @@
 	Version:	2.0
 	Date:	5th May 2015
 
-	Uses:	WinCore, IState, XACore, GhostEscape.
+	Uses:	WinCore, IState, XACore, InputQueue, Profiler, TraceLog, LoopFinder, GhostEscape, RoomLayout, HeadlessDriver, BenchmarkSuite.
 
 	Description:
 	Modified from Main_Framework.cpp v2.2 as supplied in WinCore framework.
@@ -18,23 +18,101 @@
 	*	See WinCore.hpp for details of the windows abstraction.
 	*	see IState.hpp for details of the frame processing abstraction.
 	*	see XACore.hpp for details of the audio engine abstraction.
+	*	see HeadlessDriver.hpp for running the game without a window or audio device (-headless).
+	*	see BenchmarkSuite.hpp for timing the framework and game hot paths (-benchmark).
+	*	see SessionRecording.hpp for recording a game to replay it headless (-record <file>).
+	*	see RoomLayout.hpp for playing a room of a layout file (-layout <file> [-room <n>]), and for compiling a
+		text layout to its binary form (-compilelayout <text file> <binary file>).
+	*	see LoopFinder.hpp for trimming a looped sound to an intro and a seamless loop
+		(-trimloop <wave file> <trimmed file> <shortest loop> <longest loop> [longest intro], in seconds).
+	*	see Profiler.hpp for the timing report written to the debugger output on exit in builds with profiling.
+	*	see TraceLog.hpp for writing a timeline of the game and audio events (-timeline <file>) in builds with tracing.
+	The output of -compilelayout, -trimloop, -benchmark and -headless is written to the console of the command prompt
+	that started the game, or to a new console; run them with "start /wait" so the prompt waits for them.
 
 */
 
 // System includes.
 #include <windows.h>
+#include <cstdio>
 #include <memory>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iostream>
 
 // Framework includes.
 #include "WinCore.hpp"
 #include "IState.hpp"
 #include "XACore.hpp"
 #include "waveFileManager.hpp"
+#include "InputQueue.hpp"
+#include "Profiler.hpp"
+#include "TraceLog.hpp"
+#include "PCMWave.hpp"
+#include "LoopFinder.hpp"
 using namespace AllanMilne;
 using namespace AllanMilne::Audio;
 
 // Application specific include.
 #include "GhostEscape.hpp"
+#include "RoomLayout.hpp"
+#include "HeadlessDriver.hpp"
+#include "BenchmarkSuite.hpp"
+
+//--- Anonymous namespace for the command line helpers.
+namespace {
+	//--- Split the command line into its space separated arguments.
+	std::vector<std::string> SplitArguments (const char *cmdLine)
+	{
+		std::vector<std::string> arguments;
+		std::istringstream args (cmdLine);
+		std::string argument;
+		while (args >> argument) arguments.push_back (argument);
+		return arguments;
+	} // end SplitArguments function.
+
+	//--- The index of an option among the arguments, matching the whole argument; the number of arguments if it is not there.
+	size_t FindOption (const std::vector<std::string> &arguments, const char *option)
+	{
+		size_t index = 0;
+		while (index < arguments.size() && arguments[index] != option) ++index;
+		return index;
+	} // end FindOption function.
+
+	//--- Get the value following an option on the command line; returns false if the option or its value is missing.
+	bool OptionValue (const std::vector<std::string> &arguments, const char *option, std::string &value)
+	{
+		const size_t index = FindOption (arguments, option);
+		if (index + 1 >= arguments.size()) return false;
+		value = arguments[index + 1];
+		return true;
+	} // end OptionValue function.
+
+	//--- Read the argument at an index as a number; returns false, leaving the value unchanged, if there is no such argument or it is not a number.
+	bool NumberValue (const std::vector<std::string> &arguments, const size_t index, float &value)
+	{
+		if (index >= arguments.size()) return false;
+		std::istringstream args (arguments[index]);
+		float number;
+		if ((args >> number).fail() || !args.eof()) return false;
+		value = number;
+		return true;
+	} // end NumberValue function.
+
+	//--- Connect standard output and error to the console of the command prompt that started the game, or a new console
+	//--- if there is none; the game is a Windows subsystem application, so has no console of its own for the tools' output.
+	//--- The prompt does not wait for a Windows application, so run the tools with "start /wait" to keep their output in order.
+	void AttachOutput ()
+	{
+		if (!AttachConsole (ATTACH_PARENT_PROCESS) && !AllocConsole()) return;
+		FILE *stream;
+		freopen_s (&stream, "CONOUT$", "w", stdout);
+		freopen_s (&stream, "CONOUT$", "w", stderr);
+		std::cout.clear();
+		std::cerr.clear();
+	} // end AttachOutput function.
+} // end anonymous namespace.
 
 //=== Application entry point. ===
 int WINAPI WinMain (HINSTANCE hinstance,
@@ -44,6 +122,94 @@ int WINAPI WinMain (HINSTANCE hinstance,
 {
 	std::unique_ptr<WinCore> windowApp;
 	std::unique_ptr<IState> frameProcessor;
+
+	//--- The options are matched as whole arguments, so a file name containing an option's name is not taken for it.
+	const std::vector<std::string> arguments = SplitArguments (cmdLine);
+
+	//--- Compile a text room layout to its binary form if asked to; the reason for a failure is written to standard error.
+	const size_t compileOption = FindOption (arguments, "-compilelayout");
+	if (compileOption < arguments.size()) {
+		AttachOutput();
+		RoomLayout layout;
+		if (compileOption + 2 >= arguments.size()) {
+			std::cerr << "Compile layout: expected -compilelayout <text file> <binary file>" << std::endl;
+			return 1;
+		}
+		const std::string &textFile = arguments[compileOption + 1];
+		const std::string &binaryFile = arguments[compileOption + 2];
+		if (!layout.Load (textFile)) {
+			std::cerr << "Compile layout: " << layout.GetError() << std::endl;
+			return 1;
+		}
+		if (!layout.Save (binaryFile)) {
+			std::cerr << "Compile layout: " << binaryFile << " could not be written" << std::endl;
+			return 1;
+		}
+		return 0;
+	}
+
+	//--- Trim a looped sound to an intro and a seamless loop if asked to; the loop and the sizes are written to standard output.
+	const size_t trimOption = FindOption (arguments, "-trimloop");
+	if (trimOption < arguments.size()) {
+		AttachOutput();
+		float minLength, maxLength, maxIntro = 1.0f;
+		if (trimOption + 4 >= arguments.size() || !NumberValue (arguments, trimOption + 3, minLength) || !NumberValue (arguments, trimOption + 4, maxLength)) {
+			std::cerr << "Trim loop: expected -trimloop <wave file> <trimmed file> <shortest loop> <longest loop> [longest intro]" << std::endl;
+			return 1;
+		}
+		NumberValue (arguments, trimOption + 5, maxIntro);
+		const std::string &waveFile = arguments[trimOption + 1];
+		const std::string &trimmedFile = arguments[trimOption + 2];
+		PCMWave wave (waveFile);
+		LoopFinder finder;
+		if (wave.GetStatus() != PCMWave::OK) {
+			std::cerr << "Trim loop: " << waveFile << ": " << wave.GetStatusDescription() << std::endl;
+			return 1;
+		}
+		if (!finder.Find (wave, minLength, maxLength, maxIntro)) {
+			std::cerr << "Trim loop: no loop of that length found in " << waveFile << " (16 bit PCM only)" << std::endl;
+			return 1;
+		}
+		std::unique_ptr<PCMWave> trimmed (finder.Trim (wave));
+		if (trimmed.get() == NULL || !trimmed->SaveToFileAs (trimmedFile)) {
+			std::cerr << "Trim loop: " << trimmedFile << " could not be written" << std::endl;
+			return 1;
+		}
+		const float rate = float(wave.GetWaveFormat().nSamplesPerSec);
+		std::cout << waveFile << ": intro " << finder.GetLoopBegin() / rate << "s, loop " << finder.GetLoopLength() / rate
+			<< "s, mismatch " << finder.GetMismatch() << " at " << finder.GetJoinLoudness() << " of the average loudness; " << wave.GetDataSize() << " bytes of samples -> " << trimmed->GetDataSize() << std::endl;
+		return 0;
+	}
+
+	//--- Run the microbenchmarks without a window if asked to; the suite creates XACore on its null device.
+	if (FindOption (arguments, "-benchmark") < arguments.size()) {
+		AttachOutput();
+		int exitCode;
+		{
+			BenchmarkSuite benchmarks;
+			exitCode = benchmarks.Run (cmdLine);
+		}
+		XACore::DeleteInstance();
+		WaveFileManager::DeleteInstance();
+		Profiler::DeleteInstance();
+		TraceLog::DeleteInstance();
+		return exitCode;
+	}
+
+	//--- Run scripted playthroughs without a window or audio device if asked to; the driver creates XACore on its null device.
+	if (FindOption (arguments, "-headless") < arguments.size()) {
+		AttachOutput();
+		int exitCode;
+		{
+			HeadlessDriver headless;
+			exitCode = headless.Run (cmdLine);
+		}
+		XACore::DeleteInstance();
+		WaveFileManager::DeleteInstance();
+		Profiler::DeleteInstance();
+		TraceLog::DeleteInstance();
+		return exitCode;
+	}
 	
 	//--- Create the singleton XACore objec that will initialize XAudio2 and X3DAudio.
 	//--- Must do this before creating/initializing other objects since these may require XAudio2 functionality in creating sounds, etc.
@@ -54,11 +220,30 @@ int WINAPI WinMain (HINSTANCE hinstance,
 	}
 
 	//--- create the object that encapsulates frame processing.
-	frameProcessor.reset(new GhostEscape());
+	GhostEscape *game = new GhostEscape();
+	frameProcessor.reset(game);
+
+	//--- Record the game if asked to; the recording is started when the room is created in Initialize().
+	std::string recordFile;
+	if (OptionValue (arguments, "-record", recordFile)) {
+		game->RecordSession (recordFile);
+	}
+
+	//--- Play a room of a layout file if asked to; the layout is loaded when the room is created in Initialize().
+	std::string layoutFile, layoutRoom;
+	if (OptionValue (arguments, "-layout", layoutFile)) {
+		game->UseLayout (layoutFile, OptionValue (arguments, "-room", layoutRoom) ? (unsigned int)atoi (layoutRoom.c_str()) : 0);
+	}
 
 	//--- Create the WinCore object composed with the frame processor.
 	windowApp.reset(new WinCore (frameProcessor.get()));
 
+	//--- A recorded game's timers run on the fixed tick, as they do when the recording is replayed headless;
+	//--- the simulated clock must be switched on before Initialize() creates the room and its timers.
+	if (!recordFile.empty()) {
+		windowApp->UseSimulatedClock (true);
+	}
+
 	//--- Initialize the WinCore object including creating the application window;
 	//--- this will also call the IState::Initialize() method of the frame processor.
 	bool ok = windowApp->Initialize (
@@ -71,8 +256,24 @@ int WINAPI WinMain (HINSTANCE hinstance,
 		return 0;
 	}
 
-	//--- Run the application Windows messsage loop and associated frame processing.
+	//--- Run the application Windows messsage loop and associated frame processing, updating the game at a fixed tick rate.
+	windowApp->SetTickRate (TICK_RATE);
+#ifdef TRACING_ENABLED
+	//--- Write a timeline of the game if asked to.
+	std::string timelineFile;
+	if (OptionValue (arguments, "-timeline", timelineFile) && TraceLog::GetInstance().Start (timelineFile)) {
+		TraceLog::GetInstance().NameThread ("Game");
+	}
+#endif
 	windowApp->RunApp();
+	TraceLog::GetInstance().Stop();
+
+#ifdef PROFILING_ENABLED
+	//--- Report how long the instrumented scopes took to the debugger output.
+	std::ostringstream profileReport;
+	Profiler::GetInstance().WriteReport (profileReport);
+	OutputDebugString (profileReport.str().c_str());
+#endif
 
 	//--- Delete resources.
 	//--- NB order of deletion is important - is in opposite order of creation.
@@ -89,6 +290,13 @@ int WINAPI WinMain (HINSTANCE hinstance,
 	//--- Delete the WaveFileManager Instance to release all PCMWave objects that might have been created.
 	WaveFileManager::DeleteInstance();
 
+	//--- Delete the InputQueue instance.
+	InputQueue::DeleteInstance();
+
+	//--- Delete the Profiler and TraceLog instances.
+	Profiler::DeleteInstance();
+	TraceLog::DeleteInstance();
+
 	return 0;
 } // end WinMain function.
 
@@ -43,17 +43,21 @@ namespace
 
 
 
-// Function:		MovingCritter(Player) - Moving Critter constructor
+// Function:		MovingCritter(Player, unsigned int, PathFinder) - Moving Critter constructor
 // Description:		The MovingCritter constructor sets up the XASound objects for the emitter and creates the mAnimalEmitter.
 //					It stores the pointer to the Player object passed so that it can be used in other functions, and initialises
-//					the mNewCritterTimer game timer object.
+//					the mNewCritterTimer game timer object and the random generator for the critters' timing and paths.
 // In:				Player *PlayerListener - This is the pointer to the player object
+//					unsigned int Seed - the seed for the critters' random generator
+//					PathFinder *RoomPaths - the room's path finder, for chasing the player; NULL to move in straight lines
 // Out:				N/a
-MovingCritter::MovingCritter(Player *PlayerListener)
+MovingCritter::MovingCritter(Player *PlayerListener, unsigned int Seed, PathFinder *RoomPaths)
+	: mPathFinder(RoomPaths), mChasing(false), mChaseTime(0.0f), mNextWaypoint(0), mRandom(Seed, CRITTER_RANDOM_STREAM)
 {
 	// Create the XASound objects needed for this class using the strings from the anonymous namespace above
-	mMiceSound = new XASound(BatSoundFile);
-	mBatsSound = new XASound(MiceSoundFile);
+	// Filtering is enabled so that the critter distance curve's low pass filter can be applied to them
+	mMiceSound = new XASound(BatSoundFile, true);
+	mBatsSound = new XASound(MiceSoundFile, true);
 
 	// Store the pointer to the player object so that it can be used in other functions
 	mPlayerReference = PlayerListener;
@@ -71,12 +75,20 @@ MovingCritter::MovingCritter(Player *PlayerListener)
 	// Set up the Moving Critter
 	mInitialised = false;	// Critter not initialised
 	mMoving = false;		// Critter not moving
+	mUnmovedTime = 0.0f;	// No crossing yet
+	mJourneySteps = 0;
+	mJourneys = 0;
 	mCritterTargetX = 0;	// Initialise critter target to 0
 	RoomSide = LEFT_SIDE;	// First side is LEFT_SIDE
 	mCurrentType = BATS;	// First critter type is BATS
 
 	// Create the mAnimalEmitter object
 	mAnimalEmitter = new Emitter(mMiceSound, mCritterPosition, mPlayerReference->GetListenerStruct(), true);
+	mAnimalEmitter->SetEmitterType(CRITTER_EMITTER);
+	// The critters rush past the player, so exaggerate their doppler shift
+	mAnimalEmitter->EnableDoppler(10.0f);
+	// The critters start and end outside the room; reflections are only rendered while they pass through it
+	mAnimalEmitter->EnableReflections();
 
 	// Create the NewCritterTime and reset it so that it is inialised, this timer is used to countdown when the critters movement should occur
 	mNewCritterTimer = new GameTimer();
@@ -90,24 +102,30 @@ MovingCritter::MovingCritter(Player *PlayerListener)
 
 
 // Function:		~MovingCritter() - Moving Critter destructor
-// Description:		The destructor calls StopEmitter() on the mAnimalEmitter to stop the sounds from playing
+// Description:		The destructor calls StopEmitter() on the mAnimalEmitter to stop the sounds from playing, then deletes
+//					the emitter, sounds and timer
 // In:				N/a
 // Out:				N/a
 MovingCritter::~MovingCritter()
 {
 	mAnimalEmitter->StopEmitter();
+
+	delete mAnimalEmitter;
+	delete mMiceSound;
+	delete mBatsSound;
+	delete mNewCritterTimer;
 } 
 // end destructor.
 
 
 
-// Function:		UpdateCritter() - Update Critter function
+// Function:		UpdateCritter(float) - Update Critter function
 // Description:		This function updates the mNewCritterTimer every frame if the critter object has been initialised
 //					and if the timer reaches above the NextCritterTime will set a new critter path, play the emitter and
 //					move the critter along this path.
-// In:				N/a
+// In:				float DeltaTime - the time in seconds since the last update
 // Out:				N/a
-void MovingCritter::UpdateCritter()
+void MovingCritter::UpdateCritter(float DeltaTime)
 {
 	// If the critter object has been initialised
 	if (mInitialised)
@@ -129,7 +147,7 @@ void MovingCritter::UpdateCritter()
 	// If the critter is moving, call the MoveCritter function to move the emitter dynamically
 	if (mMoving)
 	{
-		MoveCritter();
+		MoveCritter(DeltaTime);
 	}
 }
 // End UpdateCritter function
@@ -148,7 +166,7 @@ void MovingCritter::GetNextTime()
 	int UpperTimeLimit = 25;
 
 	// Get random time between these limits and set as the new NextCritterTime
-	NextCritterTime = rand() % (UpperTimeLimit - 20) + LowerTimeLimit;
+	NextCritterTime = int(mRandom.NextBelow(UpperTimeLimit - 20)) + LowerTimeLimit;
 }
 // End GetNextTime function
 
@@ -173,56 +191,101 @@ void MovingCritter::InitialiseCritter()
 
 
 
-// Function:		MoveCritter() - Move Critter function
-// Description:		This function uses the Direction Vector set in SetCritterPath and moves the emitter along this path dynamically. 
+// Function:		MoveCritter(float) - Move Critter function
+// Description:		This function moves the emitter dynamically: while the critter chases the player it follows the room's flow field
+//					towards them, or heads straight for them while it is outside the room or in a wall; once it reaches them, or gives up,
+//					it follows the waypoints found in SetCritterExit.
 //					If the critter reaches its destination target X, it then switches the side of the critter and the type so that they
 //					alternate. Also pauses the emitter so that the sounds don't continue playing while the critters aren't active.
-// In:				N/a
+// In:				float DeltaTime - the time in seconds to move the critter for
 // Out:				N/a
-void MovingCritter::MoveCritter()
+void MovingCritter::MoveCritter(float DeltaTime)
 {
-	// Increment the critters position by the direction vector 
-	mCritterPosition.x += mDirectionVector.x;
-	mCritterPosition.y += mDirectionVector.y;
-	mCritterPosition.z += mDirectionVector.z;
-
-	// Set the position of the emitter to the new position and update the emitter to reflect these changes
-	mAnimalEmitter->SetPosition(mCritterPosition);
-	mAnimalEmitter->UpdateEmitter();
-
-	// If the Critter is moving from the left side and it reaches its target X position
-	if ((RoomSide == LEFT_SIDE) && (mCritterPosition.x > mCritterTargetX))
+	// Increment the critters position by the direction vector (its velocity) for the time passed, in sub-steps of
+	// CRITTER_SUBSTEP_TIME so that the critter turns as it follows its path and stops at its target however long the update is.
+	// Time short of a sub-step is kept for the next update, so the crossing takes the same sub-steps at any tick rate
+	mUnmovedTime += DeltaTime;
+	const unsigned int FirstStep = mJourneySteps;
+	bool Arrived = false;
+	while ((mUnmovedTime >= CRITTER_SUBSTEP_TIME) && (!Arrived))
 	{
-		// Pause the emitter so it stops playing
-		mAnimalEmitter->PauseEmitter();
-		mMoving = false;			// Set moving to false so it stops its movement
-		RoomSide = RIGHT_SIDE;		// Set the RoomSide to the RIGHT_SIDE to alternate sides
+		const float StepTime = CRITTER_SUBSTEP_TIME;
+		mUnmovedTime -= StepTime;
+		mJourneySteps++;
 
-		// If the current type of the critter is Bats, alternate to Mice and change the sound for the emitter
-		if (mCurrentType == BATS)
+		if (mChasing)
 		{
-			mCurrentType = MICE;
-			mAnimalEmitter->ChangeEmitterSound(mMiceSound, mCritterPosition, true);
-			mAnimalEmitter->PauseEmitter();
+			// Follow the flow field towards the player (discarding the Y because only moving in the x and z plane); outside the room,
+			// or in a wall, there is no field, so head straight for them
+			X3DAUDIO_VECTOR PlayerPosition = mPlayerReference->GetPosition();
+			PlayerPosition.y = mCritterPosition.y;
+			X3DAUDIO_VECTOR FlowDirection;
+			if ((mPathFinder != NULL) && mPathFinder->GetFlowDirection(mCritterPosition, PlayerPosition, FlowDirection))
+			{
+				mDirectionVector.x = FlowDirection.x * CRITTER_SPEED;
+				mDirectionVector.y = 0.0f;
+				mDirectionVector.z = FlowDirection.z * CRITTER_SPEED;
+			}
+			else
+			{
+				HeadFor(PlayerPosition);
+			}
+
+			mCritterPosition.x += mDirectionVector.x * StepTime;
+			mCritterPosition.z += mDirectionVector.z * StepTime;
+			mChaseTime += StepTime;
+
+			// Once the critter reaches the player, or has chased them for long enough, it runs for the far side
+			float ToPlayerX = PlayerPosition.x - mCritterPosition.x;
+			float ToPlayerZ = PlayerPosition.z - mCritterPosition.z;
+			if ((((ToPlayerX * ToPlayerX) + (ToPlayerZ * ToPlayerZ)) < (CRITTER_REACH_RANGE * CRITTER_REACH_RANGE)) ||
+				(mChaseTime > CRITTER_CHASE_TIME))
+			{
+				SetCritterExit();
+			}
 		}
-		// Else if the current type of the critter is Mice, alternate to Bats and change the sound for the emitter
-		else if (mCurrentType == MICE)
+		else
 		{
-			mCurrentType = BATS;
-			mAnimalEmitter->ChangeEmitterSound(mBatsSound, mCritterPosition, true);
-			mAnimalEmitter->PauseEmitter();
+			// Move towards the next waypoint; on reaching it, stop there and head for the one after it, until the last is reached
+			const X3DAUDIO_VECTOR &Waypoint = mExitWaypoints[mNextWaypoint];
+			float ToX = Waypoint.x - mCritterPosition.x;
+			float ToZ = Waypoint.z - mCritterPosition.z;
+			float StepLength = CRITTER_SPEED * StepTime;
+			if (((ToX * ToX) + (ToZ * ToZ)) <= (StepLength * StepLength))
+			{
+				mCritterPosition.x = Waypoint.x;
+				mCritterPosition.z = Waypoint.z;
+				mNextWaypoint++;
+				Arrived = (mNextWaypoint == mExitWaypoints.size());
+				if (!Arrived)
+				{
+					HeadFor(mExitWaypoints[mNextWaypoint]);
+				}
+			}
+			else
+			{
+				mCritterPosition.x += mDirectionVector.x * StepTime;
+				mCritterPosition.z += mDirectionVector.z * StepTime;
+			}
 		}
-		// Reset the new critter timer so that it will now count up to the NextCritterTime
-		mNewCritterTimer->Reset();
 	}
 
-	// If the Critter is moving from the right side and it reaches its target X position
-	if ((RoomSide == RIGHT_SIDE) && (mCritterPosition.x < mCritterTargetX))
+	// Set the position of the emitter to the new position and update the emitter to reflect these changes, if it has moved
+	if (mJourneySteps != FirstStep)
+	{
+		mAnimalEmitter->SetPosition(mCritterPosition);
+		mAnimalEmitter->UpdateEmitter();
+	}
+
+	// If the Critter has reached its target X position on the far side
+	if (Arrived)
 	{
 		// Pause the emitter so it stops playing
 		mAnimalEmitter->PauseEmitter();
 		mMoving = false;			// Set moving to false so it stops its movement
-		RoomSide = LEFT_SIDE;		// Set the RoomSide to the LEFT_SIDE to alternate sides
+		mJourneys++;
+		// Set the RoomSide to the other side to alternate sides
+		RoomSide = (RoomSide == LEFT_SIDE) ? RIGHT_SIDE : LEFT_SIDE;
 
 		// If the current type of the critter is Bats, alternate to Mice and change the sound for the emitter
 		if (mCurrentType == BATS)
@@ -252,7 +315,7 @@ void MovingCritter::MoveCritter()
 //					and its starting X position. The starting Y position depends on the type of critter it is, and the z position is 
 //					randomly generated alongside the room's z plane so it is different every time.
 //					The vector from this position to the player's position is then found, normalised, and multiplied by the movement speed
-//					The MoveCritter function then uses this vector to move the critter along this path
+//					The MoveCritter function then uses this vector (the velocity in units per second) to move the critter along this path
 // In:				N/a
 // Out:				N/a
 void MovingCritter::SetCritterPath()
@@ -282,14 +345,21 @@ void MovingCritter::SetCritterPath()
 	}
 
 	// Get Critter Start Z which is random between the height of the room value and 1
-	CritterPosition.z = float((rand() % 16) + 1);
+	CritterPosition.z = float(mRandom.Range(1, 16));
 	
-	// Find the player's position (discard the Y because only moving in the x and z plane)
-	v3f PlayerPosition = { mPlayerReference->GetPosition().x, CritterPosition.y, mPlayerReference->GetPosition().z } ;
-	// Find the direction vector between the critters position and the players, normalise it and multiply it by the movement speed
-	mDirectionVector = PlayerPosition - CritterPosition;
-	mDirectionVector.Normalise();
-	mDirectionVector *= SPEED;
+	// Start the critter there, heading for the player's position (discard the Y because only moving in the x and z plane)
+	mCritterPosition.x = CritterPosition.x;
+	mCritterPosition.y = CritterPosition.y;
+	mCritterPosition.z = CritterPosition.z;
+	X3DAUDIO_VECTOR PlayerPosition = mPlayerReference->GetPosition();
+	PlayerPosition.y = CritterPosition.y;
+	HeadFor(PlayerPosition);
+
+	// The critter chases the player until it reaches them; the crossing's sub-steps are counted from now
+	mChasing = true;
+	mChaseTime = 0.0f;
+	mUnmovedTime = 0.0f;
+	mJourneySteps = 0;
 	// Set mMoving to true so that UpdateCritter will call MoveCritter to move the emitter along this path
 	mMoving = true;
 }
@@ -297,6 +367,47 @@ void MovingCritter::SetCritterPath()
 
 
 
+// Function:		SetCritterExit() - Set Critter Exit function
+// Description:		Ends the chase, finding the path from the critter round the room's obstacles to its target X on the far side,
+//					as the waypoints it heads for in turn; if there is no path the only waypoint is the target
+// In:				N/a
+// Out:				N/a
+void MovingCritter::SetCritterExit()
+{
+	// The target is outside the room, so the path finder takes the path to the nearest free cell and the critter
+	// leaves through the wall from there
+	X3DAUDIO_VECTOR Target = mCritterPosition;
+	Target.x = mCritterTargetX;
+	if ((mPathFinder == NULL) || (!mPathFinder->FindPath(mCritterPosition, Target, mExitWaypoints)))
+	{
+		mExitWaypoints.assign(1, Target);
+	}
+	mNextWaypoint = 0;
+	HeadFor(mExitWaypoints[0]);
+	mChasing = false;
+}
+// End SetCritterExit function
+
+
+
+// Function:		HeadFor(X3DAUDIO_VECTOR) - Head For function
+// Description:		Sets the direction vector to the movement speed along the x and z plane towards a position
+// In:				const X3DAUDIO_VECTOR &Position - the position
+// Out:				N/a
+void MovingCritter::HeadFor(const X3DAUDIO_VECTOR &Position)
+{
+	// Find the direction vector between the critters position and the position, normalise it and multiply it by the movement speed
+	v3f Direction = { Position.x - mCritterPosition.x, 0.0f, Position.z - mCritterPosition.z };
+	if (v3f::Dot(Direction, Direction) > 0.0f)
+	{
+		Direction.Normalise();
+		mDirectionVector = Direction * CRITTER_SPEED;
+	}
+}
+// End HeadFor function
+
+
+
 // Function:		Reset() - Reset function
 // Description:		Update the animal emitter so it reflects the settings of the player Listener
 // In:				N/a
@@ -5,7 +5,7 @@
 	Author:	Cassie Bennett
 
 	Exposes:	MovingCritter
-	Requires:	XASound, Player, Emitter, GameTimer, StuVector3
+	Requires:	XASound, Player, Emitter, GameTimer, StuVector3, PathFinder
 
 	Description:
 	This class models a group of critters that move dynamically across the room. The class alternates between two types of critters for
@@ -16,6 +16,7 @@
 	*	Creation of an emitter for the critters
 	*	Dynamic movement of the emitter 
 	*	Randomly generate the start position of the critter however create its path towards the players position
+	*	Chase the player across the room by the room's flow field, round the obstacles, then run round them to the far side
 	*	Alternate between bats and mice critters in the scene
 	
 */
@@ -55,7 +56,9 @@
 #include <X3DAudio.h>
 #include <memory>
 #include <list>
+#include <vector>
 using std::list;
+using std::vector;
 
 // Framework includes.
 #include "XASound.hpp"
@@ -66,6 +69,8 @@ using AllanMilne::Audio::XASound;
 #include "Emitter.hpp"
 #include "Framework\GameTimer.h"
 #include "StuVector3.hpp"
+#include "Random.hpp"
+#include "PathFinder.hpp"
 using namespace stu;
 
 // Definitions for the Left and Right side target/starting values
@@ -76,8 +81,21 @@ using namespace stu;
 #define LEFT_SIDE 1
 #define RIGHT_SIDE 2
 
-// The movement speed value for the emitter movement
-#define SPEED 0.00005
+// The movement speed of the emitter in units per second
+#define CRITTER_SPEED 4.0f
+
+// The time (in seconds) the critter is moved for between arrival tests. The updates' times are added up and the critter is moved
+// in whole sub-steps, the rest being kept for the next update, so a crossing takes the same number of sub-steps at any tick rate
+#define CRITTER_SUBSTEP_TIME (1.0f / 120.0f)
+
+// The distance from the player at which the critter has caught up with them and runs for the far side of the room
+#define CRITTER_REACH_RANGE 1.0f
+
+// The longest time (in seconds) the critter chases the player for before it gives up and runs for the far side of the room
+#define CRITTER_CHASE_TIME 6.0f
+
+// The stream of the critters' random generator, so its sequence differs from the player's and ghost's for the same seed
+#define CRITTER_RANDOM_STREAM 3
 
 // The MovingCritter class
 class MovingCritter
@@ -85,13 +103,15 @@ class MovingCritter
 
 // Public Member Functions and Variables
 public:
-	// Function:		MovingCritter(Player) - Moving Critter constructor
+	// Function:		MovingCritter(Player, unsigned int, PathFinder) - Moving Critter constructor
 	// Description:		The MovingCritter constructor sets up the XASound objects for the emitter and creates the mAnimalEmitter.
 	//					It stores the pointer to the Player object passed so that it can be used in other functions, and initialises
-	//					the mNewCritterTimer game timer object.
+	//					the mNewCritterTimer game timer object and the random generator for the critters' timing and paths.
 	// In:				Player *PlayerListener - This is the pointer to the player object
+	//					unsigned int Seed - the seed for the critters' random generator
+	//					PathFinder *RoomPaths - the room's path finder, for chasing the player; NULL to move in straight lines
 	// Out:				N/a
-	MovingCritter(Player *PlayerListener);
+	MovingCritter(Player *PlayerListener, unsigned int Seed, PathFinder *RoomPaths);
 
 	// Function:		UpdateEmitter() - Update Emitter function
 	// Description:		This calls the UpdateEmitter function on the mAnimalEmitter
@@ -99,19 +119,51 @@ public:
 	// Out:				N/a
 	inline void UpdateEmitter() const { mAnimalEmitter->UpdateEmitter(); };
 
+	// Function:		GetRandom() - Get Random function
+	// Description:		Returns the critters' random generator so its state can be saved and restored
+	// In:				N/a
+	// Out:				Random& - the critters' random generator
+	inline Random& GetRandom() { return mRandom; };
+
+	// Function:		GetCritterPosition() - Get Critter Position function
+	// Description:		Returns the current position of the critter, e.g. for the headless driver to measure its speed
+	// In:				N/a
+	// Out:				X3DAUDIO_VECTOR - the critter's position
+	inline X3DAUDIO_VECTOR GetCritterPosition() const { return mCritterPosition; };
+
+	// Function:		IsMoving() - Is Moving function
+	// Description:		Returns true while a critter is crossing the room
+	// In:				N/a
+	// Out:				bool - true if the critter is moving
+	inline bool IsMoving() const { return mMoving; };
+
+	// Function:		GetJourneyTime() - Get Journey Time function
+	// Description:		Returns the game time the last critter's crossing took, as its sub-steps, so it is the same at any tick rate
+	//					while the player stands still (the critter chases the player as they were at each sub-step)
+	// In:				N/a
+	// Out:				float - the time in seconds, or 0 before the first crossing
+	inline float GetJourneyTime() const { return mJourneySteps * CRITTER_SUBSTEP_TIME; };
+
+	// Function:		GetJourneys() - Get Journeys function
+	// Description:		Returns the number of crossings the critters have finished
+	// In:				N/a
+	// Out:				unsigned int mJourneys - the finished crossings
+	inline unsigned int GetJourneys() const { return mJourneys; };
+
 	// Function:		~MovingCritter() - Moving Critter destructor
-	// Description:		The destructor calls StopEmitter() on the mAnimalEmitter to stop the sounds from playing
+	// Description:		The destructor calls StopEmitter() on the mAnimalEmitter to stop the sounds from playing, then deletes
+	//					the emitter, sounds and timer
 	// In:				N/a
 	// Out:				N/a
 	~MovingCritter();
 
-	// Function:		UpdateCritter() - Update Critter function
+	// Function:		UpdateCritter(float) - Update Critter function
 	// Description:		This function updates the mNewCritterTimer every frame if the critter object has been initialised
 	//					and if the timer reaches above the NextCritterTime will set a new critter path, play the emitter and
 	//					move the critter along this path.
-	// In:				N/a
+	// In:				float DeltaTime - the time in seconds since the last update
 	// Out:				N/a
-	void UpdateCritter();
+	void UpdateCritter(float DeltaTime);
 
 	// Function:		InitialiseCritter() - Initialise Critter function
 	// Description:		This function resets the NewCritterTimer when it is called to reset the critter and sets mInitialised to true
@@ -152,24 +204,40 @@ private:
 	// Out:				N/a
 	void GetNextTime();
 
-	// Function:		MoveCritter() - Move Critter function
-	// Description:		This function uses the Direction Vector set in SetCritterPath and moves the emitter along this path dynamically. 
+	// Function:		MoveCritter(float) - Move Critter function
+	// Description:		This function moves the emitter dynamically: while the critter chases the player it follows the room's flow field
+	//					towards them, or heads straight for them while it is outside the room or in a wall; once it reaches them, or gives up,
+	//					it follows the waypoints found in SetCritterExit.
 	//					If the critter reaches its destination target X, it then switches the side of the critter and the type so that they
 	//					alternate. Also pauses the emitter so that the sounds don't continue playing while the critters aren't active.
-	// In:				N/a
+	// In:				float DeltaTime - the time in seconds to move the critter for
 	// Out:				N/a
-	void MoveCritter();
+	void MoveCritter(float DeltaTime);
 
 	// Function:		SetCritterPath() - Set Critter Path function
 	// Description:		This function finds the target position of the critter based on the side it is assigned to (LEFT_SIDE or RIGHT_SIDE)
 	//					and its starting X position. The starting Y position depends on the type of critter it is, and the z position is 
 	//					randomly generated alongside the room's z plane so it is different every time.
 	//					The vector from this position to the player's position is then found, normalised, and multiplied by the movement speed
-	//					The MoveCritter function then uses this vector to move the critter along this path
+	//					The MoveCritter function then uses this vector (the velocity in units per second) to move the critter along this path
+	//					until it enters the room and can chase the player by the flow field
 	// In:				N/a
 	// Out:				N/a
 	void SetCritterPath();
 
+	// Function:		SetCritterExit() - Set Critter Exit function
+	// Description:		Ends the chase, finding the path from the critter round the room's obstacles to its target X on the far side,
+	//					as the waypoints it heads for in turn; if there is no path the only waypoint is the target
+	// In:				N/a
+	// Out:				N/a
+	void SetCritterExit();
+
+	// Function:		HeadFor(X3DAUDIO_VECTOR) - Head For function
+	// Description:		Sets the direction vector to the movement speed along the x and z plane towards a position
+	// In:				const X3DAUDIO_VECTOR &Position - the position
+	// Out:				N/a
+	void HeadFor(const X3DAUDIO_VECTOR &Position);
+
 	// Store the pointer to the player object
 	Player *mPlayerReference;
 	
@@ -200,8 +268,24 @@ private:
 	// Holds the current target X for the critter 
 	float mCritterTargetX;
 
+	// The room's path finder; whether the critter is chasing the player and for how long it has, and the waypoints of its way out
+	PathFinder *mPathFinder;
+	bool mChasing;
+	float mChaseTime;
+	vector<X3DAUDIO_VECTOR> mExitWaypoints;
+	size_t mNextWaypoint;
+
+	// The time of the updates since the last sub-step that the critter hasn't been moved for yet, the sub-steps of its crossing,
+	// and the crossings finished
+	float mUnmovedTime;
+	unsigned int mJourneySteps;
+	unsigned int mJourneys;
+
 	// GameTimer object to count the time between a critter movement finishes and the time when the critter should move again
 	GameTimer *mNewCritterTimer;
+
+	// The critters' own random generator, for the time until the next critter and its path
+	Random mRandom;
 };
 // End MovingCritter class
 
@@ -0,0 +1,178 @@
+/*
+	File:	PanningTable.cpp
+	Version:	1.1
+	Date:	18th October 2026
+	Author:	agent
+
+	Exposes:	Implementation of the PanningTable class.
+	Requires:	X3DAudio, XACore, XASound, Listener (for the Directions).
+
+	Description:
+	Keeps a static emitter's 3D settings for the listener poses it has been heard from.
+	*	See PanningTable.hpp for details.
+*/
+
+// System includes
+#include <math.h>
+
+// Framework includes
+#include "XACore.hpp"
+using AllanMilne::Audio::XACore;
+using AllanMilne::Audio::IXACore;
+
+// Application includes
+#include "PanningTable.hpp"
+#include "Listener.hpp"
+
+
+
+// Function:		PanningTable() - PanningTable constructor
+// Description:		Creates an empty table
+// In:				N/a
+// Out:				N/a
+PanningTable::PanningTable()
+{
+	mFlags = 0;
+	mHits = 0;
+	mMisses = 0;
+	Clear();
+}
+// End PanningTable constructor
+
+
+
+// Function:		Clear() - Clear function
+// Description:		Empties the table, e.g. when its emitter moves
+// In:				N/a
+// Out:				N/a
+void PanningTable::Clear()
+{
+	for (int i = 0; i < PANNING_TABLE_SLOTS; i++)
+	{
+		mSlots[i].Used = 0;
+	}
+	mClock = 0;
+}
+// End Clear function
+
+
+
+// Function:		FindPose(X3DAUDIO_LISTENER, int, int, int) - Find Pose function
+// Description:		Finds the listener's pose: its rounded position and the index of its orientation in Directions::Orientations
+// In:				const X3DAUDIO_LISTENER *Listener - the listener, int &X, int &Z, int &Orientation - set to the pose
+// Out:				bool - false if the listener is moving, too far from the origin or not facing one of the orientations
+bool PanningTable::FindPose(const X3DAUDIO_LISTENER *Listener, int &X, int &Z, int &Orientation) const
+{
+	// The listener only has a velocity part way through a move
+	if ((Listener->Velocity.x != 0.0f) || (Listener->Velocity.y != 0.0f) || (Listener->Velocity.z != 0.0f))
+	{
+		return false;
+	}
+
+	// The position rounded to the pose steps, which must fit the slot
+	float StepX = floorf((Listener->Position.x * PANNING_POSE_STEPS) + 0.5f);
+	float StepZ = floorf((Listener->Position.z * PANNING_POSE_STEPS) + 0.5f);
+	if ((fabsf(StepX) > 32767.0f) || (fabsf(StepZ) > 32767.0f))
+	{
+		return false;
+	}
+	X = int(StepX);
+	Z = int(StepZ);
+
+	// The listener's front is set to the orientation's vector at the end of a turn, so it is compared exactly
+	const X3DAUDIO_VECTOR &Front = Listener->OrientFront;
+	for (int i = 0; i < 8; i++)
+	{
+		if ((Front.x == Directions::Orientations[i].x) && (Front.y == Directions::Orientations[i].y) && (Front.z == Directions::Orientations[i].z))
+		{
+			Orientation = i;
+			return true;
+		}
+	}
+	return false;
+}
+// End FindPose function
+
+
+
+// Function:		GetSettings(X3DAUDIO_EMITTER, X3DAUDIO_LISTENER, unsigned int, X3DAUDIO_DSP_SETTINGS) - Get Settings function
+// Description:		Finds the settings of the emitter for the listener's pose, calculating them into the least recently used
+//					slot if the pose isn't in the table
+// In:				const X3DAUDIO_EMITTER *Emitter - the emitter, const X3DAUDIO_LISTENER *Listener - the listener,
+//					unsigned int Flags - the X3DAudio flags; only the matrix and direct low pass filter are tabled,
+//					X3DAUDIO_DSP_SETTINGS &Settings - set to the settings; the matrix is the table's, valid until the next call
+// Out:				bool - false if the listener has no pose, or the flags ask for settings that aren't tabled
+bool PanningTable::GetSettings(const X3DAUDIO_EMITTER *Emitter, const X3DAUDIO_LISTENER *Listener, unsigned int Flags, X3DAUDIO_DSP_SETTINGS &Settings)
+{
+	IXACore *Core = XACore::GetInstance();
+	int X = 0;
+	int Z = 0;
+	int Orientation = 0;
+	if ((Core == NULL) || ((Flags & ~(X3DAUDIO_CALCULATE_MATRIX | X3DAUDIO_CALCULATE_LPF_DIRECT)) != 0) || (!FindPose(Listener, X, Z, Orientation)))
+	{
+		return false;
+	}
+
+	// Settings calculated for other flags are no use
+	if (Flags != mFlags)
+	{
+		Clear();
+		mFlags = Flags;
+	}
+
+	// Look for the pose, noting the least recently used slot in case it isn't there
+	int Oldest = 0;
+	int Found = -1;
+	for (int i = 0; i < PANNING_TABLE_SLOTS; i++)
+	{
+		const Slot &Pose = mSlots[i];
+		if ((Pose.Used != 0) && (Pose.X == X) && (Pose.Z == Z) && (Pose.Orientation == Orientation))
+		{
+			Found = i;
+			break;
+		}
+		if (Pose.Used < mSlots[Oldest].Used)
+		{
+			Oldest = i;
+		}
+	}
+
+	if (Found >= 0)
+	{
+		mHits++;
+	}
+	else
+	{
+		// Calculate the pose's settings into the oldest slot; a matrix larger than the slot's isn't calculated, as in XASound::Apply3D
+		mMisses++;
+		Found = Oldest;
+		Slot &Pose = mSlots[Found];
+		SecureZeroMemory(&Settings, sizeof(X3DAUDIO_DSP_SETTINGS));
+		Settings.SrcChannelCount = Emitter->ChannelCount;
+		Settings.DstChannelCount = Core->GetChannelCount();
+		Settings.pMatrixCoefficients = Pose.Matrix;
+		unsigned int CalculateFlags = Flags;
+		if ((Settings.SrcChannelCount * Settings.DstChannelCount) > UINT32(XASound::MaxMatrixSize))
+		{
+			CalculateFlags &= ~X3DAUDIO_CALCULATE_MATRIX;
+		}
+		Core->Calculate3D(Emitter, Listener, CalculateFlags, Settings);
+		Pose.X = short(X);
+		Pose.Z = short(Z);
+		Pose.Orientation = BYTE(Orientation);
+		Pose.SrcChannels = (CalculateFlags & X3DAUDIO_CALCULATE_MATRIX) ? Settings.SrcChannelCount : 0;
+		Pose.DstChannels = Settings.DstChannelCount;
+		Pose.LPFDirectCoefficient = Settings.LPFDirectCoefficient;
+	}
+	mSlots[Found].Used = ++mClock;
+
+	// The settings point at the slot's matrix, or none if it was too large to calculate
+	const Slot &Pose = mSlots[Found];
+	SecureZeroMemory(&Settings, sizeof(X3DAUDIO_DSP_SETTINGS));
+	Settings.SrcChannelCount = Pose.SrcChannels;
+	Settings.DstChannelCount = Pose.DstChannels;
+	Settings.pMatrixCoefficients = (Pose.SrcChannels > 0) ? const_cast<float*>(Pose.Matrix) : NULL;
+	Settings.LPFDirectCoefficient = Pose.LPFDirectCoefficient;
+	return true;
+}
+// End GetSettings function
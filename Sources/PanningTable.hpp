@@ -0,0 +1,113 @@
+/*
+	File:	PanningTable.hpp
+	Version:	1.1
+	Date:	18th October 2026
+	Author:	agent
+
+	Exposes:	PanningTable.
+	Requires:	X3DAudio, XACore, XASound, Listener (for the Directions).
+
+	Description:
+	Keeps the 3D settings of a static emitter for the listener poses it has been heard from, so that when the listener comes
+	back to a pose the settings are copied rather than calculated again.
+
+	The player steps one unit at a time and faces one of the 8 Directions::Orientations, so while it stands still the listener
+	is at one of a few poses:
+	*	a pose is the listener's position, with x and z rounded to 1/PANNING_POSE_STEPS of a unit, and its orientation; a step
+		along a diagonal is 1/sqrt(2) of a unit in x and z, so the positions a player stands at aren't only whole cells, and
+		the rounding lets a position reached by different paths, and so with different rounding errors, be the same pose;
+	*	a listener that is moving (its velocity isn't zero) or turning (not facing one of the orientations) has no pose and
+		isn't tabled, so a walk doesn't fill the table with the positions part way through each step;
+	*	the table has PANNING_TABLE_SLOTS slots, each holding a pose's output matrix and direct low pass filter coefficient,
+		so the memory of each emitter's table is bounded; a pose that isn't in the table is calculated with X3DAudio into
+		the least recently used slot, so the table fills lazily with the poses the player visits;
+	*	the settings depend on the emitter as well as the listener, so the emitter clears the table when it moves or its
+		sound, curves or cone change; the table is also cleared if it is asked for different X3DAudio flags.
+
+	Doppler is not tabled; it depends on the listener's velocity, which is zero at every pose.
+*/
+
+// Define the class
+#ifndef __PANNINGTABLE_HPP__
+#define __PANNINGTABLE_HPP__
+
+// System includes.
+#include <Windows.h>
+#include <X3DAudio.h>
+
+// Framework includes.
+#include "XASound.hpp"
+using AllanMilne::Audio::XASound;
+
+// The number of listener poses each table holds
+#define PANNING_TABLE_SLOTS 32
+
+// The listener's position is rounded to this many steps a unit to find its pose; the settings of a pose are those of the
+// first position in it, up to half a step from where the listener stands
+#define PANNING_POSE_STEPS 16
+
+// The PanningTable class
+class PanningTable
+{
+// Public Member functions and variables
+public:
+
+	// Function:		PanningTable() - PanningTable constructor
+	// Description:		Creates an empty table
+	// In:				N/a
+	// Out:				N/a
+	PanningTable();
+
+	// Function:		Clear() - Clear function
+	// Description:		Empties the table, e.g. when its emitter moves
+	// In:				N/a
+	// Out:				N/a
+	void Clear();
+
+	// Function:		GetSettings(X3DAUDIO_EMITTER, X3DAUDIO_LISTENER, unsigned int, X3DAUDIO_DSP_SETTINGS) - Get Settings function
+	// Description:		Finds the settings of the emitter for the listener's pose, calculating them into the least recently used
+	//					slot if the pose isn't in the table
+	// In:				const X3DAUDIO_EMITTER *Emitter - the emitter, const X3DAUDIO_LISTENER *Listener - the listener,
+	//					unsigned int Flags - the X3DAudio flags; only the matrix and direct low pass filter are tabled,
+	//					X3DAUDIO_DSP_SETTINGS &Settings - set to the settings; the matrix is the table's, valid until the next call
+	// Out:				bool - false if the listener has no pose, or the flags ask for settings that aren't tabled
+	bool GetSettings(const X3DAUDIO_EMITTER *Emitter, const X3DAUDIO_LISTENER *Listener, unsigned int Flags, X3DAUDIO_DSP_SETTINGS &Settings);
+
+	// Accessors for the number of lookups found in the table and calculated, and the memory the table takes
+	inline unsigned long GetHits() const { return mHits; }
+	inline unsigned long GetMisses() const { return mMisses; }
+	inline size_t GetMemoryUsed() const { return sizeof(PanningTable); }
+
+// Private member functions and variables
+private:
+
+	// Function:		FindPose(X3DAUDIO_LISTENER, int, int, int) - Find Pose function
+	// Description:		Finds the listener's pose: its rounded position and the index of its orientation in Directions::Orientations
+	// In:				const X3DAUDIO_LISTENER *Listener - the listener, int &X, int &Z, int &Orientation - set to the pose
+	// Out:				bool - false if the listener is moving, too far from the origin or not facing one of the orientations
+	bool FindPose(const X3DAUDIO_LISTENER *Listener, int &X, int &Z, int &Orientation) const;
+
+	// A pose's settings; Used is 0 for an empty slot
+	struct Slot
+	{
+		short X;
+		short Z;
+		BYTE Orientation;
+		unsigned long Used;
+		UINT32 SrcChannels;
+		UINT32 DstChannels;
+		float LPFDirectCoefficient;
+		float Matrix[XASound::MaxMatrixSize];
+	};
+	Slot mSlots[PANNING_TABLE_SLOTS];
+
+	// The flags the settings were calculated with, and the count the slots' use is marked with
+	unsigned int mFlags;
+	unsigned long mClock;
+
+	unsigned long mHits;
+	unsigned long mMisses;
+};
+// end PanningTable class.
+
+#endif
@@ -0,0 +1,638 @@
+/*
+	File:	PathFinder.cpp
+	Version:	1.0
+	Date:	18th October 2026
+	Author:	agent
+
+	Exposes:	Implementation of the PathFinder and FlowField classes.
+	Requires:	RoomGrid.
+
+	Description:
+	A* paths and flow fields across a RoomGrid.
+	*	See PathFinder.hpp for details.
+*/
+
+// System includes.
+#include <Windows.h>
+#include <X3DAudio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <vector>
+#include <algorithm>
+using std::vector;
+
+// Application includes.
+#include "PathFinder.hpp"
+
+// Anonymous namespace for the steps between cells and the helper functions
+namespace
+{
+	// The 8 steps from a cell: the 4 straight steps, then the 4 diagonal steps
+	const int DirectionCount = 8;
+	const int StepX[DirectionCount] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+	const int StepZ[DirectionCount] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+	const UINT32 StepCost[DirectionCount] = { PATH_STRAIGHT_COST, PATH_STRAIGHT_COST, PATH_STRAIGHT_COST, PATH_STRAIGHT_COST,
+		PATH_DIAGONAL_COST, PATH_DIAGONAL_COST, PATH_DIAGONAL_COST, PATH_DIAGONAL_COST };
+	// The step back the way each step came
+	const BYTE Opposite[DirectionCount] = { 1, 0, 3, 2, 7, 6, 5, 4 };
+
+	// The values of a flow field's steps: a direction, or none for the target and the cells not reached yet, with a flag once settled
+	const BYTE NoStep = 0x0F;
+	const BYTE StepMask = 0x0F;
+	const BYTE Settled = 0x10;
+
+	// Orders A*'s heap so the lowest cost is at the front; of equal costs, the entry nearest the goal is taken first,
+	// so a search along an open stretch follows one path rather than widening across all the equally good ones
+	inline bool CostsMore(const PathNode &First, const PathNode &Second)
+	{
+		return First.Order > Second.Order;
+	}
+
+	// The order of an entry in A*'s heap
+	inline UINT64 PathOrder(UINT32 Cost, UINT32 Remaining)
+	{
+		return (UINT64(Cost + Remaining) << 32) | UINT64(Remaining);
+	}
+
+	// Checks a step can be made from a free cell; a diagonal step also needs both cells beside it free
+	bool CanStep(const RoomGrid &Grid, int X, int Z, int Direction)
+	{
+		int NextX = X + StepX[Direction];
+		int NextZ = Z + StepZ[Direction];
+		if (Grid.IsBlocked(NextX, NextZ))
+		{
+			return false;
+		}
+		return (Direction < 4) || ((!Grid.IsBlocked(NextX, Z)) && (!Grid.IsBlocked(X, NextZ)));
+	}
+
+	// The cost of the shortest path between two cells with nothing in the way; A*'s estimate of the cost still to go
+	inline UINT32 OctileDistance(int X, int Z, int GoalX, int GoalZ)
+	{
+		UINT32 Across = UINT32(abs(GoalX - X));
+		UINT32 Along = UINT32(abs(GoalZ - Z));
+		UINT32 Diagonal = (Across < Along) ? Across : Along;
+		return (Across + Along - 2 * Diagonal) * PATH_STRAIGHT_COST + Diagonal * PATH_DIAGONAL_COST;
+	}
+}
+// end anonymous namespace.
+
+
+
+// Function:		FlowField() - FlowField constructor
+// Description:		Creates an empty field, with no target
+// In:				N/a
+// Out:				N/a
+FlowField::FlowField()
+	: mWidth(0), mDepth(0), mTargetX(0), mTargetZ(0), mStarted(false), mSettling(0), mWaiting(0)
+{
+}
+// End FlowField constructor
+
+
+
+// Function:		Start(int, int, int, int) - Start function
+// Description:		Clears the field for a grid's size and starts it from a target cell; no cell has its step until Advance is called
+// In:				int Width, int Depth - the size of the grid, int TargetX, int TargetZ - the target cell, which must be free
+// Out:				N/a
+void FlowField::Start(int Width, int Depth, int TargetX, int TargetZ)
+{
+	Clear();
+	mWidth = Width;
+	mDepth = Depth;
+	mTargetX = TargetX;
+	mTargetZ = TargetZ;
+	mStarted = true;
+
+	// Every cell starts unreached; the memory is kept from the last target when the grid is the same size
+	size_t Cells = size_t(mWidth) * size_t(mDepth);
+	mDistance.assign(Cells, UINT32(0xFFFFFFFF));
+	mStep.assign(Cells, NoStep);
+
+	UINT32 Target = UINT32(TargetZ) * UINT32(mWidth) + UINT32(TargetX);
+	mDistance[Target] = 0;
+	mBuckets[0].push_back(Target);
+	mWaiting = 1;
+}
+// End Start function
+
+
+
+// Function:		Advance(BYTE, size_t) - Advance function
+// Description:		Settles the next cells out from the target, nearest first, giving each the step towards the target
+// In:				const BYTE *Moves - the steps that can be made from each cell, as the PathFinder keeps them,
+//					size_t MaxCells - the most cells to settle
+// Out:				bool - true once every cell that can reach the target has its step
+bool FlowField::Advance(const BYTE *Moves, size_t MaxCells)
+{
+	size_t SettledCells = 0;
+	while ((mWaiting > 0) && (SettledCells < MaxCells))
+	{
+		// Move on to the next cost with cells waiting
+		vector<UINT32> &Bucket = mBuckets[mSettling % PATH_FLOW_BUCKETS];
+		if (Bucket.empty())
+		{
+			mSettling++;
+			continue;
+		}
+		UINT32 Cell = Bucket.back();
+		Bucket.pop_back();
+		mWaiting--;
+
+		// A cell is added again each time a cheaper way to it is found; the older entries are skipped
+		if (((mStep[Cell] & Settled) != 0) || (mDistance[Cell] != mSettling))
+		{
+			continue;
+		}
+		mStep[Cell] |= Settled;
+		SettledCells++;
+
+		// Offer the cells around a way to the target through this one; the way back from a cell is the step opposite the one taken to it
+		BYTE CellMoves = Moves[Cell];
+		for (int Direction = 0; Direction < DirectionCount; Direction++)
+		{
+			if ((CellMoves & (1 << Direction)) == 0)
+			{
+				continue;
+			}
+			UINT32 Next = UINT32(int(Cell) + StepZ[Direction] * mWidth + StepX[Direction]);
+			UINT32 Distance = mSettling + StepCost[Direction];
+			if (Distance < mDistance[Next])
+			{
+				mDistance[Next] = Distance;
+				mStep[Next] = Opposite[Direction];
+				mBuckets[Distance % PATH_FLOW_BUCKETS].push_back(Next);
+				mWaiting++;
+			}
+		}
+	}
+	return (mWaiting == 0);
+}
+// End Advance function
+
+
+
+// Function:		GetStep(int, int, int, int) - Get Step function
+// Description:		Gets the step from a cell towards the target; the step is 0, 0 at the target
+// In:				int X, int Z - the cell, int &ToX, int &ToZ - set to the step
+// Out:				bool - false if the cell is outside the grid, can't reach the target, or hasn't been settled yet
+bool FlowField::GetStep(int X, int Z, int &ToX, int &ToZ) const
+{
+	if ((!mStarted) || ((unsigned int)(X) >= (unsigned int)(mWidth)) || ((unsigned int)(Z) >= (unsigned int)(mDepth)))
+	{
+		return false;
+	}
+	BYTE Step = mStep[size_t(Z) * size_t(mWidth) + size_t(X)];
+	if ((Step & Settled) == 0)
+	{
+		return false;
+	}
+
+	// Only the target is settled without a step
+	Step &= StepMask;
+	ToX = (Step == NoStep) ? 0 : StepX[Step];
+	ToZ = (Step == NoStep) ? 0 : StepZ[Step];
+	return true;
+}
+// End GetStep function
+
+
+
+// Function:		Clear() - Clear function
+// Description:		Forgets the target, so the field is started again before it is used; the memory is kept
+// In:				N/a
+// Out:				N/a
+void FlowField::Clear()
+{
+	for (int i = 0; i < PATH_FLOW_BUCKETS; i++)
+	{
+		mBuckets[i].clear();
+	}
+	mSettling = 0;
+	mWaiting = 0;
+	mStarted = false;
+}
+// End Clear function
+
+
+
+// Function:		GetMemoryUsed() - Get Memory Used function
+// Description:		Works out the memory the field takes
+// In:				N/a
+// Out:				size_t - the bytes used
+size_t FlowField::GetMemoryUsed() const
+{
+	size_t Bytes = sizeof(FlowField) + mDistance.capacity() * sizeof(UINT32) + mStep.capacity() * sizeof(BYTE);
+	for (int i = 0; i < PATH_FLOW_BUCKETS; i++)
+	{
+		Bytes += mBuckets[i].capacity() * sizeof(UINT32);
+	}
+	return Bytes;
+}
+// End GetMemoryUsed function
+
+
+
+// Function:		PathFinder() - PathFinder constructor
+// Description:		Creates a path finder with no grid; SetGrid gives it one
+// In:				N/a
+// Out:				N/a
+PathFinder::PathFinder()
+	: mGrid(NULL), mWidth(0), mDepth(0), mSearch(0), mFlowClock(0), mFlowBudget(PATH_FLOW_BUDGET)
+{
+	for (int i = 0; i < PATH_FLOW_FIELD_CACHE; i++)
+	{
+		mFlowUsed[i] = 0;
+	}
+}
+// End PathFinder constructor
+
+
+
+// Function:		SetGrid(RoomGrid) - Set Grid function
+// Description:		Sets the grid the paths are found on, works out the steps that can be made from each cell and forgets the
+//					flow fields; the grid must outlive the path finder, and SetGrid or Invalidate must be called again if its cells change
+// In:				const RoomGrid &Grid - the grid
+// Out:				N/a
+void PathFinder::SetGrid(const RoomGrid &Grid)
+{
+	mGrid = &Grid;
+	Invalidate();
+}
+// End SetGrid function
+
+
+
+// Function:		Invalidate() - Invalidate function
+// Description:		Works out the steps from each cell again and forgets the flow fields, so they are built again for the grid as it is now
+// In:				N/a
+// Out:				N/a
+void PathFinder::Invalidate()
+{
+	mWidth = (mGrid != NULL) ? mGrid->GetWidth() : 0;
+	mDepth = (mGrid != NULL) ? mGrid->GetDepth() : 0;
+	mMoves.assign(size_t(mWidth) * size_t(mDepth), BYTE(0));
+	for (int Z = 0; Z < mDepth; Z++)
+	{
+		for (int X = 0; X < mWidth; X++)
+		{
+			if (mGrid->IsBlocked(X, Z))
+			{
+				continue;
+			}
+			BYTE CellMoves = 0;
+			for (int Direction = 0; Direction < DirectionCount; Direction++)
+			{
+				if (CanStep(*mGrid, X, Z, Direction))
+				{
+					CellMoves |= BYTE(1 << Direction);
+				}
+			}
+			mMoves[size_t(Z) * size_t(mWidth) + size_t(X)] = CellMoves;
+		}
+	}
+
+	for (int i = 0; i < PATH_FLOW_FIELD_CACHE; i++)
+	{
+		mFlowFields[i].Clear();
+		mFlowUsed[i] = 0;
+	}
+}
+// End Invalidate function
+
+
+
+// Function:		FindPath(int, int, int, int, vector<GridCell>) - Find Path function
+// Description:		Finds the shortest path between two free cells with A*
+// In:				int StartX, int StartZ - the start cell, int GoalX, int GoalZ - the goal cell,
+//					vector<GridCell> &Path - set to the cells of the path, from the start to the goal
+// Out:				bool - false if either cell is blocked or outside the grid, or the goal can't be reached; the path is then empty
+bool PathFinder::FindPath(int StartX, int StartZ, int GoalX, int GoalZ, vector<GridCell> &Path)
+{
+	Path.clear();
+	if ((mGrid == NULL) || mGrid->IsBlocked(StartX, StartZ) || mGrid->IsBlocked(GoalX, GoalZ))
+	{
+		return false;
+	}
+
+	// Grow the buffers to the grid; they are only cleared when they grow, or when the stamps run out
+	const UINT32 Width = UINT32(mWidth);
+	const size_t Cells = size_t(mWidth) * size_t(mDepth);
+	if ((mStamp.size() < Cells) || (mSearch >= 0xFFFFFFFD))
+	{
+		mCost.resize(Cells);
+		mCameFrom.resize(Cells);
+		mStamp.assign(Cells, 0);
+		mSearch = 0;
+	}
+	mSearch += 2;
+	const UINT32 Open = mSearch;
+	const UINT32 Closed = mSearch + 1;
+
+	const UINT32 Start = UINT32(StartZ) * Width + UINT32(StartX);
+	const UINT32 Goal = UINT32(GoalZ) * Width + UINT32(GoalX);
+	mCost[Start] = 0;
+	mCameFrom[Start] = NoStep;
+	mStamp[Start] = Open;
+	mOpen.clear();
+	PathNode First = { PathOrder(0, OctileDistance(StartX, StartZ, GoalX, GoalZ)), Start };
+	mOpen.push_back(First);
+
+	bool Found = false;
+	while (!mOpen.empty())
+	{
+		PathNode Node = mOpen.front();
+		std::pop_heap(mOpen.begin(), mOpen.end(), CostsMore);
+		mOpen.pop_back();
+
+		// A cell is added again each time a cheaper way to it is found; the older entries are skipped
+		if (mStamp[Node.Index] == Closed)
+		{
+			continue;
+		}
+		if (Node.Index == Goal)
+		{
+			Found = true;
+			break;
+		}
+		mStamp[Node.Index] = Closed;
+
+		int X = int(Node.Index % Width);
+		int Z = int(Node.Index / Width);
+		BYTE CellMoves = mMoves[Node.Index];
+		for (int Direction = 0; Direction < DirectionCount; Direction++)
+		{
+			if ((CellMoves & (1 << Direction)) == 0)
+			{
+				continue;
+			}
+			int NextX = X + StepX[Direction];
+			int NextZ = Z + StepZ[Direction];
+			UINT32 Next = UINT32(NextZ) * Width + UINT32(NextX);
+			if (mStamp[Next] == Closed)
+			{
+				continue;
+			}
+			UINT32 Cost = mCost[Node.Index] + StepCost[Direction];
+			if ((mStamp[Next] != Open) || (Cost < mCost[Next]))
+			{
+				mCost[Next] = Cost;
+				mCameFrom[Next] = BYTE(Direction);
+				mStamp[Next] = Open;
+				UINT32 Remaining = OctileDistance(NextX, NextZ, GoalX, GoalZ);
+				PathNode Reached = { PathOrder(Cost, Remaining), Next };
+				mOpen.push_back(Reached);
+				std::push_heap(mOpen.begin(), mOpen.end(), CostsMore);
+			}
+		}
+	}
+	if (!Found)
+	{
+		return false;
+	}
+
+	// Walk back from the goal along the steps each cell was reached by, then turn the path round
+	GridCell Cell = { GoalX, GoalZ };
+	while (true)
+	{
+		Path.push_back(Cell);
+		BYTE Direction = mCameFrom[UINT32(Cell.Z) * Width + UINT32(Cell.X)];
+		if (Direction == NoStep)
+		{
+			break;
+		}
+		Cell.X -= StepX[Direction];
+		Cell.Z -= StepZ[Direction];
+	}
+	std::reverse(Path.begin(), Path.end());
+	return true;
+}
+// End FindPath function
+
+
+
+// Function:		FindPath(X3DAUDIO_VECTOR, X3DAUDIO_VECTOR, vector<X3DAUDIO_VECTOR>) - Find Path function
+// Description:		Finds the path between two positions, moving each to the nearest free cell if it is outside the grid or blocked
+// In:				const X3DAUDIO_VECTOR &Start - the start, const X3DAUDIO_VECTOR &Goal - the goal,
+//					vector<X3DAUDIO_VECTOR> &Waypoints - set to the positions to head for in turn, at the start's height,
+//					ending with the goal
+// Out:				bool - false if there is no free cell or the goal can't be reached; the waypoints are then empty
+bool PathFinder::FindPath(const X3DAUDIO_VECTOR &Start, const X3DAUDIO_VECTOR &Goal, vector<X3DAUDIO_VECTOR> &Waypoints)
+{
+	Waypoints.clear();
+	if (mGrid == NULL)
+	{
+		return false;
+	}
+
+	int StartX = PositionToCell(Start.x);
+	int StartZ = PositionToCell(Start.z);
+	int GoalX = PositionToCell(Goal.x);
+	int GoalZ = PositionToCell(Goal.z);
+	bool StartMoved = mGrid->IsBlocked(StartX, StartZ);
+	bool GoalMoved = mGrid->IsBlocked(GoalX, GoalZ);
+	if ((!FindNearestFree(StartX, StartZ)) || (!FindNearestFree(GoalX, GoalZ)) || (!FindPath(StartX, StartZ, GoalX, GoalZ, mCellPath)))
+	{
+		return false;
+	}
+
+	// A start that was moved is first taken to its free cell; the path's other cells are only kept where it turns,
+	// and the last is only kept if the goal was moved, as otherwise the goal is in it
+	X3DAUDIO_VECTOR Waypoint = Start;
+	const size_t Last = mCellPath.size() - 1;
+	for (size_t i = 0; i <= Last; i++)
+	{
+		bool Keep;
+		if (i == 0)
+		{
+			Keep = StartMoved;
+		}
+		else if (i == Last)
+		{
+			Keep = GoalMoved;
+		}
+		else
+		{
+			Keep = ((mCellPath[i].X - mCellPath[i - 1].X) != (mCellPath[i + 1].X - mCellPath[i].X)) ||
+				   ((mCellPath[i].Z - mCellPath[i - 1].Z) != (mCellPath[i + 1].Z - mCellPath[i].Z));
+		}
+		if (Keep)
+		{
+			Waypoint.x = CellToPosition(mCellPath[i].X);
+			Waypoint.z = CellToPosition(mCellPath[i].Z);
+			Waypoints.push_back(Waypoint);
+		}
+	}
+	Waypoint.x = Goal.x;
+	Waypoint.z = Goal.z;
+	Waypoints.push_back(Waypoint);
+	return true;
+}
+// End FindPath function
+
+
+
+// Function:		GetFlowDirection(X3DAUDIO_VECTOR, X3DAUDIO_VECTOR, X3DAUDIO_VECTOR) - Get Flow Direction function
+// Description:		Gives the direction to move in from a position to follow the flow field towards a target, building the
+//					target cell's field further if it isn't complete
+// In:				const X3DAUDIO_VECTOR &Position - the mover, const X3DAUDIO_VECTOR &Target - the target,
+//					X3DAUDIO_VECTOR &Direction - set to the unit direction, along the x and z axes
+// Out:				bool - false if the position is outside the grid or blocked, no field leads from it yet, or it is at the target
+bool PathFinder::GetFlowDirection(const X3DAUDIO_VECTOR &Position, const X3DAUDIO_VECTOR &Target, X3DAUDIO_VECTOR &Direction)
+{
+	if (mGrid == NULL)
+	{
+		return false;
+	}
+	int X = PositionToCell(Position.x);
+	int Z = PositionToCell(Position.z);
+	int TargetX = PositionToCell(Target.x);
+	int TargetZ = PositionToCell(Target.z);
+	if (mGrid->IsBlocked(X, Z) || (!FindNearestFree(TargetX, TargetZ)))
+	{
+		return false;
+	}
+
+	// Use the target cell's field if it has reached this cell; otherwise the most recently used complete field
+	const FlowField *Field = &GetFlowField(TargetX, TargetZ);
+	int ToX, ToZ;
+	if (!Field->GetStep(X, Z, ToX, ToZ))
+	{
+		int Latest = -1;
+		for (int i = 0; i < PATH_FLOW_FIELD_CACHE; i++)
+		{
+			if ((&mFlowFields[i] != Field) && mFlowFields[i].IsComplete() && ((Latest < 0) || (mFlowUsed[i] > mFlowUsed[Latest])))
+			{
+				Latest = i;
+			}
+		}
+		if ((Latest < 0) || (!mFlowFields[Latest].GetStep(X, Z, ToX, ToZ)))
+		{
+			return false;
+		}
+	}
+
+	// Head for the centre of the next cell, or for the target itself once in its cell
+	float NextX = ((ToX == 0) && (ToZ == 0)) ? Target.x : CellToPosition(X + ToX);
+	float NextZ = ((ToX == 0) && (ToZ == 0)) ? Target.z : CellToPosition(Z + ToZ);
+	float AcrossX = NextX - Position.x;
+	float AcrossZ = NextZ - Position.z;
+	float Length = sqrt((AcrossX * AcrossX) + (AcrossZ * AcrossZ));
+	if (Length < 0.0001f)
+	{
+		return false;
+	}
+	Direction.x = AcrossX / Length;
+	Direction.y = 0.0f;
+	Direction.z = AcrossZ / Length;
+	return true;
+}
+// End GetFlowDirection function
+
+
+
+// Function:		GetFlowField(int, int) - Get Flow Field function
+// Description:		Finds the cached field for a target cell, or starts one in place of the least recently used, then builds
+//					it by up to the flow budget's number of cells
+// In:				int TargetX, int TargetZ - the target cell, which must be free
+// Out:				const FlowField& - the field
+const FlowField& PathFinder::GetFlowField(int TargetX, int TargetZ)
+{
+	int Slot = -1;
+	int Oldest = 0;
+	for (int i = 0; (i < PATH_FLOW_FIELD_CACHE) && (Slot < 0); i++)
+	{
+		const FlowField &Field = mFlowFields[i];
+		if (Field.IsStarted() && (Field.GetTargetX() == TargetX) && (Field.GetTargetZ() == TargetZ))
+		{
+			Slot = i;
+		}
+		else if (mFlowUsed[i] < mFlowUsed[Oldest])
+		{
+			Oldest = i;
+		}
+	}
+	if (Slot < 0)
+	{
+		Slot = Oldest;
+		mFlowFields[Slot].Start(mWidth, mDepth, TargetX, TargetZ);
+	}
+	mFlowUsed[Slot] = ++mFlowClock;
+
+	if (!mFlowFields[Slot].IsComplete())
+	{
+		mFlowFields[Slot].Advance(&mMoves[0], mFlowBudget);
+	}
+	return mFlowFields[Slot];
+}
+// End GetFlowField function
+
+
+
+// Function:		FindNearestFree(int, int) - Find Nearest Free function
+// Description:		Moves a cell into the grid, then to the nearest free cell around it, searching out a ring of cells at a time
+// In:				int &X, int &Z - the cell; set to the free cell
+// Out:				bool - false if the grid has no free cell
+bool PathFinder::FindNearestFree(int &X, int &Z) const
+{
+	if ((mGrid == NULL) || (mGrid->GetWidth() == 0))
+	{
+		return false;
+	}
+	const int LastX = mGrid->GetWidth() - 1;
+	const int LastZ = mGrid->GetDepth() - 1;
+	int CentreX = (X < 0) ? 0 : ((X > LastX) ? LastX : X);
+	int CentreZ = (Z < 0) ? 0 : ((Z > LastZ) ? LastZ : Z);
+
+	// Of the free cells in the first ring that has one, take the closest; the cells outside the grid read as blocked
+	const int MaxRing = (LastX > LastZ) ? LastX : LastZ;
+	for (int Ring = 0; Ring <= MaxRing; Ring++)
+	{
+		int Best = -1;
+		for (int RingZ = CentreZ - Ring; RingZ <= CentreZ + Ring; RingZ++)
+		{
+			// Only the first and last rows of the ring are whole; the others only have their two ends
+			bool EdgeRow = (RingZ == CentreZ - Ring) || (RingZ == CentreZ + Ring);
+			int StepAcross = (EdgeRow || (Ring == 0)) ? 1 : 2 * Ring;
+			for (int RingX = CentreX - Ring; RingX <= CentreX + Ring; RingX += StepAcross)
+			{
+				if (mGrid->IsBlocked(RingX, RingZ))
+				{
+					continue;
+				}
+				int Distance = (RingX - CentreX) * (RingX - CentreX) + (RingZ - CentreZ) * (RingZ - CentreZ);
+				if ((Best < 0) || (Distance < Best))
+				{
+					Best = Distance;
+					X = RingX;
+					Z = RingZ;
+				}
+			}
+		}
+		if (Best >= 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+// End FindNearestFree function
+
+
+
+// Function:		GetMemoryUsed() - Get Memory Used function
+// Description:		Works out the memory the search buffers and flow fields take
+// In:				N/a
+// Out:				size_t - the bytes used
+size_t PathFinder::GetMemoryUsed() const
+{
+	size_t Bytes = sizeof(PathFinder) + mMoves.capacity() * sizeof(BYTE) + mCost.capacity() * sizeof(UINT32) + mCameFrom.capacity() * sizeof(BYTE) +
+		mStamp.capacity() * sizeof(UINT32) + mOpen.capacity() * sizeof(PathNode) + mCellPath.capacity() * sizeof(GridCell);
+	for (int i = 0; i < PATH_FLOW_FIELD_CACHE; i++)
+	{
+		// The fields themselves are counted in sizeof(PathFinder)
+		Bytes += mFlowFields[i].GetMemoryUsed() - sizeof(FlowField);
+	}
+	return Bytes;
+}
+// End GetMemoryUsed function
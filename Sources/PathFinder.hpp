@@ -0,0 +1,258 @@
+/*
+	File:	PathFinder.hpp
+	Version:	1.0
+	Date:	18th October 2026
+	Author:	agent
+
+	Exposes:	PathFinder, FlowField, GridCell, PathNode.
+	Requires:	RoomGrid.
+
+	Description:
+	Finds the way across a RoomGrid for the things that move in the room, so they go round the walls and obstacles rather than
+	through them. Steps are made to the 8 cells around a cell; a diagonal step is only made when both cells beside it are free,
+	so nothing cuts the corner of an obstacle. Straight steps cost PATH_STRAIGHT_COST and diagonal steps PATH_DIAGONAL_COST.
+
+	The PathFinder exposes behaviour to:
+	*	Find a path from one cell to another with A*, for a move to a fixed place such as the ghost's next stage;
+		the open set is a binary heap and the buffers are kept between searches, so a search allocates nothing once the
+		buffers have grown to the grid's size; each search stamps the cells it reaches rather than clearing the buffers;
+	*	Find a path between two positions, which is given as the positions the mover heads for in turn: the centres of the
+		cells the path turns at, then the goal itself. A start or goal outside the grid or in a blocked cell, such as a stage
+		on top of its obstacle, is moved to the nearest free cell first;
+	*	Give the direction towards a target from anywhere in the room from a flow field, for things chasing the player.
+
+	A FlowField holds, for every cell, the step to take towards its target cell; it is built outwards from the target with
+	Dijkstra's algorithm, so the cells nearest the target get their steps first.
+	*	the PathFinder keeps the fields of the last PATH_FLOW_FIELD_CACHE target cells, so a target moving back and forth
+		between cells, or standing still, doesn't rebuild its field;
+	*	a field is built incrementally: each request for it settles at most the flow budget's number of cells, so the cost of a
+		new target on a large map is spread over several updates. Until the new field reaches a cell, a mover there follows
+		the most recent complete field, which leads to where the target was a moment before;
+	*	the fields are built with a bucket queue rather than a heap: the step costs are small whole numbers, so the cells waiting
+		to be settled are kept in a ring of buckets by their cost, and each is added and taken out in constant time;
+	*	the fields and cells are indexed by row (z * width + x), separately from the grid's tiles.
+
+	When it is given a grid, the PathFinder works out once which of the 8 steps can be made from each cell, as a bit per step in a
+	byte per cell, so the searches test a single bit for each step rather than looking up to three cells in the grid.
+
+	Positions are in room units as used by Room: the cell at (X, Z) covers the positions from (X + 1, Z + 1) to (X + 2, Z + 2).
+*/
+
+// Define the class
+#ifndef __PATHFINDER_HPP__
+#define __PATHFINDER_HPP__
+
+// System includes.
+#include <Windows.h>
+#include <X3DAudio.h>
+#include <math.h>
+#include <vector>
+using std::vector;
+
+// Application includes.
+#include "RoomGrid.hpp"
+
+// The cost of a step to the cell beside, and to the cell diagonally across; in the ratio of 1 to the square root of 2
+#define PATH_STRAIGHT_COST 10
+#define PATH_DIAGONAL_COST 14
+
+// The number of flow fields kept, for the most recently used target cells
+#define PATH_FLOW_FIELD_CACHE 4
+
+// The default number of cells a flow field settles each time it is asked for; enough to build a 64 by 64 room at once
+#define PATH_FLOW_BUDGET 4096
+
+// The number of buckets in a flow field's ring, more than the largest step cost so a step never wraps onto the bucket being settled
+#define PATH_FLOW_BUCKETS 16
+
+// A cell of the grid
+struct GridCell
+{
+	int X;
+	int Z;
+};
+
+// An entry of A*'s open set: a cell's index, and its order; the order is the cell's estimated total cost in the high 32 bits
+// and the part of that still to go in the low 32 bits, so the binary heap gives the lowest total first, and of equal totals
+// the one nearest the goal, with a single comparison
+struct PathNode
+{
+	UINT64 Order;
+	UINT32 Index;
+};
+
+// The FlowField class; fields are built by the PathFinder, which keeps them
+class FlowField
+{
+// Public Member functions and variables
+public:
+
+	// Function:		FlowField() - FlowField constructor
+	// Description:		Creates an empty field, with no target
+	// In:				N/a
+	// Out:				N/a
+	FlowField();
+
+	// Function:		GetStep(int, int, int, int) - Get Step function
+	// Description:		Gets the step from a cell towards the target; the step is 0, 0 at the target
+	// In:				int X, int Z - the cell, int &ToX, int &ToZ - set to the step
+	// Out:				bool - false if the cell is outside the grid, can't reach the target, or hasn't been settled yet
+	bool GetStep(int X, int Z, int &ToX, int &ToZ) const;
+
+	// Function:		GetMemoryUsed() - Get Memory Used function
+	// Description:		Works out the memory the field takes
+	// In:				N/a
+	// Out:				size_t - the bytes used
+	size_t GetMemoryUsed() const;
+
+	inline bool IsStarted() const { return mStarted; }
+	inline bool IsComplete() const { return mStarted && (mWaiting == 0); }
+	inline int GetTargetX() const { return mTargetX; }
+	inline int GetTargetZ() const { return mTargetZ; }
+
+// Private member functions and variables
+private:
+
+	friend class PathFinder;
+
+	// Function:		Start(int, int, int, int) - Start function
+	// Description:		Clears the field for a grid's size and starts it from a target cell; no cell has its step until Advance is called
+	// In:				int Width, int Depth - the size of the grid, int TargetX, int TargetZ - the target cell, which must be free
+	// Out:				N/a
+	void Start(int Width, int Depth, int TargetX, int TargetZ);
+
+	// Function:		Advance(BYTE, size_t) - Advance function
+	// Description:		Settles the next cells out from the target, nearest first, giving each the step towards the target
+	// In:				const BYTE *Moves - the steps that can be made from each cell, as the PathFinder keeps them,
+	//					size_t MaxCells - the most cells to settle
+	// Out:				bool - true once every cell that can reach the target has its step
+	bool Advance(const BYTE *Moves, size_t MaxCells);
+
+	// Function:		Clear() - Clear function
+	// Description:		Forgets the target, so the field is started again before it is used; the memory is kept
+	// In:				N/a
+	// Out:				N/a
+	void Clear();
+
+	int mWidth;
+	int mDepth;
+	int mTargetX;
+	int mTargetZ;
+	bool mStarted;
+
+	// The cost from each cell to the target so far, and its step: a direction, with a flag set once the cell is settled
+	vector<UINT32> mDistance;
+	vector<BYTE> mStep;
+
+	// The cells reached but not yet settled, in the bucket of their cost; the cost being settled, and the number of entries waiting
+	vector<UINT32> mBuckets[PATH_FLOW_BUCKETS];
+	UINT32 mSettling;
+	size_t mWaiting;
+};
+// end FlowField class.
+
+// The PathFinder class
+class PathFinder
+{
+// Public Member functions and variables
+public:
+
+	// Function:		PathFinder() - PathFinder constructor
+	// Description:		Creates a path finder with no grid; SetGrid gives it one
+	// In:				N/a
+	// Out:				N/a
+	PathFinder();
+
+	// Function:		SetGrid(RoomGrid) - Set Grid function
+	// Description:		Sets the grid the paths are found on, works out the steps that can be made from each cell and forgets the
+	//					flow fields; the grid must outlive the path finder, and SetGrid or Invalidate must be called again if its cells change
+	// In:				const RoomGrid &Grid - the grid
+	// Out:				N/a
+	void SetGrid(const RoomGrid &Grid);
+
+	// Function:		Invalidate() - Invalidate function
+	// Description:		Works out the steps from each cell again and forgets the flow fields, so they are built again for the grid as it is now
+	// In:				N/a
+	// Out:				N/a
+	void Invalidate();
+
+	// Function:		FindPath(int, int, int, int, vector<GridCell>) - Find Path function
+	// Description:		Finds the shortest path between two free cells with A*
+	// In:				int StartX, int StartZ - the start cell, int GoalX, int GoalZ - the goal cell,
+	//					vector<GridCell> &Path - set to the cells of the path, from the start to the goal
+	// Out:				bool - false if either cell is blocked or outside the grid, or the goal can't be reached; the path is then empty
+	bool FindPath(int StartX, int StartZ, int GoalX, int GoalZ, vector<GridCell> &Path);
+
+	// Function:		FindPath(X3DAUDIO_VECTOR, X3DAUDIO_VECTOR, vector<X3DAUDIO_VECTOR>) - Find Path function
+	// Description:		Finds the path between two positions, moving each to the nearest free cell if it is outside the grid or blocked
+	// In:				const X3DAUDIO_VECTOR &Start - the start, const X3DAUDIO_VECTOR &Goal - the goal,
+	//					vector<X3DAUDIO_VECTOR> &Waypoints - set to the positions to head for in turn, at the start's height,
+	//					ending with the goal
+	// Out:				bool - false if there is no free cell or the goal can't be reached; the waypoints are then empty
+	bool FindPath(const X3DAUDIO_VECTOR &Start, const X3DAUDIO_VECTOR &Goal, vector<X3DAUDIO_VECTOR> &Waypoints);
+
+	// Function:		GetFlowDirection(X3DAUDIO_VECTOR, X3DAUDIO_VECTOR, X3DAUDIO_VECTOR) - Get Flow Direction function
+	// Description:		Gives the direction to move in from a position to follow the flow field towards a target, building the
+	//					target cell's field further if it isn't complete
+	// In:				const X3DAUDIO_VECTOR &Position - the mover, const X3DAUDIO_VECTOR &Target - the target,
+	//					X3DAUDIO_VECTOR &Direction - set to the unit direction, along the x and z axes
+	// Out:				bool - false if the position is outside the grid or blocked, no field leads from it yet, or it is at the target
+	bool GetFlowDirection(const X3DAUDIO_VECTOR &Position, const X3DAUDIO_VECTOR &Target, X3DAUDIO_VECTOR &Direction);
+
+	// Function:		GetFlowField(int, int) - Get Flow Field function
+	// Description:		Finds the cached field for a target cell, or starts one in place of the least recently used, then builds
+	//					it by up to the flow budget's number of cells
+	// In:				int TargetX, int TargetZ - the target cell, which must be free
+	// Out:				const FlowField& - the field
+	const FlowField& GetFlowField(int TargetX, int TargetZ);
+
+	// Function:		FindNearestFree(int, int) - Find Nearest Free function
+	// Description:		Moves a cell into the grid, then to the nearest free cell around it, searching out a ring of cells at a time
+	// In:				int &X, int &Z - the cell; set to the free cell
+	// Out:				bool - false if the grid has no free cell
+	bool FindNearestFree(int &X, int &Z) const;
+
+	// Function:		GetMemoryUsed() - Get Memory Used function
+	// Description:		Works out the memory the search buffers and flow fields take
+	// In:				N/a
+	// Out:				size_t - the bytes used
+	size_t GetMemoryUsed() const;
+
+	// The number of cells a field settles each time it is asked for
+	inline void SetFlowBudget(size_t Cells) { mFlowBudget = Cells; }
+
+	// The cell holding a position along an axis, and the position of the centre of a cell
+	static inline int PositionToCell(float Position) { return int(floor(Position)) - 1; }
+	static inline float CellToPosition(int Cell) { return float(Cell) + 1.5f; }
+
+// Private member functions and variables
+private:
+
+	// The grid, which isn't owned, and its size
+	const RoomGrid *mGrid;
+	int mWidth;
+	int mDepth;
+
+	// The steps that can be made from each cell, indexed by row; bit n is set if step n can be made
+	vector<BYTE> mMoves;
+
+	// The A* buffers, indexed by row: each cell's cost from the start, the direction it was reached in, and the stamp of the
+	// search that reached it; a search's stamp is even while a cell is open and odd once it is closed
+	vector<UINT32> mCost;
+	vector<BYTE> mCameFrom;
+	vector<UINT32> mStamp;
+	UINT32 mSearch;
+	vector<PathNode> mOpen;
+
+	// The cells of the last path between positions
+	vector<GridCell> mCellPath;
+
+	// The cached flow fields, with the time each was last used
+	FlowField mFlowFields[PATH_FLOW_FIELD_CACHE];
+	UINT32 mFlowUsed[PATH_FLOW_FIELD_CACHE];
+	UINT32 mFlowClock;
+	size_t mFlowBudget;
+};
+// end PathFinder class.
+
+#endif
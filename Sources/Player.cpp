@@ -31,7 +31,11 @@ using std::string;
 
 //--- Framework includes.
 #include "XASound.hpp"
+#include "PCMWave.hpp"
+#include "SoundSheet.hpp"
 using AllanMilne::Audio::XASound;
+using AllanMilne::Audio::PCMWave;
+using AllanMilne::Audio::SoundSheet;
 
 //--- application includes.
 #include "Player.hpp"
@@ -43,28 +47,41 @@ using namespace Directions;
 namespace 
 {
 	const string CaptureNoiseFile = "Sounds/CaptureNoise.wav";
-	const string CreakingFootstepsFile = "Sounds/CreakingFootsteps.wav";
 	const string DefaultBreathingFile = "Sounds/DefaultBreathing.wav";
-	const string DefaultFootstepsFile = "Sounds/DefaultFootsteps.wav";
 	const string DefaultTurningFile = "Sounds/DefaultTurning.wav";
-	const string FootstepsVariant1File = "Sounds/FootstepsVariant1.wav";
 	const string HeartBeatFile = "Sounds/HeartBeat.wav";
 	const string IntroSoundFile = "Sounds/RoomIntro.wav";
 	const string OutroSoundFile = "Sounds/PlayerOutro.wav";
-	const string PainSound1 = "Sounds/PainSound1.wav";
-	const string PainSound2 = "Sounds/PainSound2.wav";
-	const string PainSound3 = "Sounds/PainSound3.wav";
+
+	// The sound sheets, and the names of their regions in the order of the footstep IDs and pain sound IDs
+	const string FootstepsSheetFile = "Sounds/PlayerFootsteps.wav";
+	const string PainSheetFile = "Sounds/PlayerPain.wav";
+	const string FootstepsRegions[PLAYER_SOUND_VARIANTS] = { "DefaultFootsteps", "FootstepsVariant1", "CreakingFootsteps" };
+	const string PainRegions[PLAYER_SOUND_VARIANTS] = { "PainSound1", "PainSound2", "PainSound3" };
+
+	// Returns the length of a sound's wave in seconds, or 0 if it isn't valid
+	float GetSoundDuration(XASound *Sound)
+	{
+		PCMWave *Wave = Sound->GetWave();
+		if ((!Sound->IsValid()) || (Wave == NULL) || (Wave->GetWaveFormat().nSamplesPerSec == 0))
+		{
+			return 0.0f;
+		}
+		return float(Wave->GetNumberOfSamples()) / float(Wave->GetWaveFormat().nSamplesPerSec);
+	}
 }
 
 
 
-// Function:		Player() - Player Constructor
+// Function:		Player(unsigned int) - Player Constructor
 // Description:		The constructor for the Player class creates the Listener object and sets the object with its start position/orientation
 //					Initialises all variables to their defaults at the start of the game and creates the XASound objects with the string
 //					file names in the anonymous namespace within Player.cpp.
-// In:				N/a
+//					The player's random generator, used to choose the footstep and pain sounds, is seeded from the seed passed.
+// In:				unsigned int Seed - the seed for the player's random generator
 // Out:				N/a
-Player::Player ()
+Player::Player (unsigned int Seed)
+	: mRandom(Seed, PLAYER_RANDOM_STREAM)
 {
 	// Set the starting position and orientation of the player/listener
 	X3DAUDIO_VECTOR StartPos = {8.0f, 0.0f, 2.0f};
@@ -87,29 +104,20 @@ Player::Player ()
 	mOutroSound = new XASound(OutroSoundFile);
 
 	// Create the new XASound objects using the string files from the anonymous namespace above
-	mNormalFootsteps = new XASound(DefaultFootstepsFile);		// Normal footsteps sound
-	mPlayerSounds.push_back(mNormalFootsteps);
-
-	mCreakingFootsteps = new XASound(CreakingFootstepsFile);	// Creaking Footsteps sound
-	mPlayerSounds.push_back(mCreakingFootsteps);
-
-	mVariant1Footsteps = new XASound(FootstepsVariant1File);	// Variant 1 Footsteps sound
-	mPlayerSounds.push_back(mVariant1Footsteps);
-
 	mTurning = new XASound(DefaultTurningFile);					// Turning sound
 	mPlayerSounds.push_back(mTurning);
 
 	mCaptureSound = new XASound(CaptureNoiseFile);				// Capture Sound
 	mPlayerSounds.push_back(mCaptureSound);
 
-	mPainSound1 = new XASound(PainSound1);						// Pain Sound 1
-	mPlayerSounds.push_back(mPainSound1);
-
-	mPainSound2 = new XASound(PainSound2);						// Pain Sound 2
-	mPlayerSounds.push_back(mPainSound2);
-
-	mPainSound3 = new XASound(PainSound3);						// Pain Sound 3
-	mPlayerSounds.push_back(mPainSound3);
+	// Load the footsteps and pain sound sheets, and find the region of each variant in them
+	mFootstepSheet = new SoundSheet(FootstepsSheetFile, PLAYER_SHEET_VOICES);
+	mPainSheet = new SoundSheet(PainSheetFile, PLAYER_SHEET_VOICES);
+	for (int i = 0; i < PLAYER_SOUND_VARIANTS; i++)
+	{
+		mFootstepRegions[i] = mFootstepSheet->FindRegion(FootstepsRegions[i]);
+		mPainRegions[i] = mPainSheet->FindRegion(PainRegions[i]);
+	}
 
 	// Set up the breathing and heartbeat sounds to loop
 	mBreathing = new XASound(DefaultBreathingFile);
@@ -127,13 +135,37 @@ Player::Player ()
 	mTurningTimer->Reset();
 
 	// Set the initial footsteps and pain sounds
-	mFootsteps = mNormalFootsteps;
-	mCurrentPainSound = mPainSound1;
+	mFootstepRegion = mFootstepRegions[DEFAULT_FOOTSTEPS - 1];
+	mPainRegion = mPainRegions[0];
 } 
 // end Player constructor.
 
 
 
+// Function:		~Player() - Player Destructor
+// Description:		Deletes the player's sounds, timers and Listener object
+// In:				N/a
+// Out:				N/a
+Player::~Player ()
+{
+	for (auto PlayerSound = mPlayerSounds.begin(); PlayerSound != mPlayerSounds.end(); ++ PlayerSound)
+	{
+		delete *PlayerSound;
+	}
+	// The intro and outro sounds are not in the list of player sounds
+	delete mIntroSound;
+	delete mOutroSound;
+	delete mFootstepSheet;
+	delete mPainSheet;
+
+	delete mFootstepTimer;
+	delete mTurningTimer;
+	delete mPlayerListener;
+} 
+// end Player destructor.
+
+
+
 // Function:		IsValid() - Is Valid function
 // Description:		This function checks to see if the sounds needed for the player have been created successfully
 //					and if the Listener has been created successfully.
@@ -150,6 +182,18 @@ bool Player::IsValid()
 			return false;
 		}
 	}
+	// The sheets must have loaded with all of the variants
+	if ((!mFootstepSheet->IsValid()) || (!mPainSheet->IsValid()))
+	{
+		return false;
+	}
+	for (int i = 0; i < PLAYER_SOUND_VARIANTS; i++)
+	{
+		if ((mFootstepRegions[i] < 0) || (mPainRegions[i] < 0))
+		{
+			return false;
+		}
+	}
 	return true;
 }
 // End IsValid function
@@ -160,13 +204,14 @@ bool Player::IsValid()
 // Description:		This function uses the players current position and the listeners orientation and adds this orientation to the 
 //					current position in order to find the position the player would be in if they were to move in this direction.
 //					This is used in the Room.cpp file to check for collisions within the room and it is called every frame
+//					Uses the position and direction the listener is moving/turning to, so a move part way through is on the grid.
 // In:				N/a
 // Out:				N/a
 X3DAUDIO_VECTOR Player::GetNextPosition ()
 {
-	// Get the Listener's position and the vector of the listeners current orientation
-	X3DAUDIO_VECTOR ListenerPosition = mPlayerListener->mListener.Position;
-	X3DAUDIO_VECTOR DirectionVector = mPlayerListener->mListener.OrientFront;
+	// Get the position the Listener is moving to and the vector of the direction it is turning to
+	X3DAUDIO_VECTOR ListenerPosition = mPlayerListener->GetTargetPosition();
+	X3DAUDIO_VECTOR DirectionVector = Orientations[mPlayerListener->mBodyOrientation];
 
 	// Find the next position the player will move in if they moved forward in this direction
 	// Add the x y and z values of the direction vector to the current position to get the next position
@@ -182,6 +227,31 @@ X3DAUDIO_VECTOR Player::GetNextPosition ()
 
 
 
+// Function:		GetFootstepsDuration() - Get Footsteps Duration function
+// Description:		Returns the length of the footsteps sound that will be played for the next move, so the listener can move
+//					over the same time
+// In:				N/a
+// Out:				float - the length of the sound in seconds
+float Player::GetFootstepsDuration () const
+{
+	return mFootstepSheet->GetRegionDuration(mFootstepRegion);
+}
+// End GetFootstepsDuration function
+
+
+
+// Function:		GetTurningDuration() - Get Turning Duration function
+// Description:		Returns the length of the turning sound, so the listener can turn over the same time
+// In:				N/a
+// Out:				float - the length of the sound in seconds
+float Player::GetTurningDuration () const
+{
+	return GetSoundDuration(mTurning);
+}
+// End GetTurningDuration function
+
+
+
 // Function:		UpdatePlayer(float, float) - Update Player function
 // Description:		This function plays sounds given the current state of the player. For example, if the Listener is moving, 
 //					this function checks the mListenerMoving bool and plays the footsteps sound. It stores the distance from the 
@@ -218,7 +288,7 @@ void Player::UpdatePlayer(float GhostDistance, bool PlayerFree)
 	mTurningTimer->Tick();
 
 	// If the footsteps sound is no longer playing, and the footstep timer is above 1.0 (1 second) the player can move
-	if ((!mFootsteps->IsPlaying()) && (mFootstepTimer->GetElapsedTime() > 1.0))
+	if ((!mFootstepSheet->IsPlaying()) && (mFootstepTimer->GetElapsedTime() > 1.0))
 	{
 		mPlayerCanMove = true;
 	}
@@ -231,10 +301,9 @@ void Player::UpdatePlayer(float GhostDistance, bool PlayerFree)
 	// If the listener has moved, play the footsteps sound and set the next footsteps sound
 	if (mPlayerListener->mListenerMoving)
 	{
-		if (mFootsteps->IsValid())
+		if (mFootstepSheet->IsValid())
 		{
-			mFootsteps->Stop();
-			mFootsteps->Play();
+			mFootstepSheet->Play(mFootstepRegion);
 			// Set the new random footsteps sound
 			SetFootstepsSound();
 		}
@@ -256,9 +325,9 @@ void Player::UpdatePlayer(float GhostDistance, bool PlayerFree)
 	if (mInPain)
 	{
 		// Play the current pain sound
-		if (mCurrentPainSound->IsValid())
+		if (mPainSheet->IsValid())
 		{
-			mCurrentPainSound->Play();
+			mPainSheet->Play(mPainRegion);
 		}
 		// Get the next random pain sound
 		SetPainSound();
@@ -281,6 +350,8 @@ void Player::Stop()
 			(*PlayerSound)->Stop();
 		}
 	}
+	mFootstepSheet->Stop();
+	mPainSheet->Stop();
 }
 
 
@@ -383,7 +454,7 @@ void Player::UpdateHeartbeat()
 
 // Function:		SetFootstepsSound() - Set Footsteps Sound function
 // Description:		This function is called whenever the footsteps sound is played when the player moves in order to randomly
-//					select the next footsteps sound. There are 3 different footstep sound files and one is randomly selected to give the 
+//					select the next footsteps sound. There are 3 different footstep sounds and one is randomly selected to give the 
 //					room diversity by making the floor sound different in different places
 // In:				N/a
 // Out:				N/a
@@ -393,21 +464,10 @@ void Player::SetFootstepsSound()
 	mFootstepTimer->Reset();
 
 	// Get the random next footstep ID between 1 and 3
-	int FootstepsID = rand() % 3 + 1;
+	int FootstepsID = mRandom.Range(1, 3);
 
-	// Use this random ID to select the next footsteps sound file
-	if (FootstepsID == DEFAULT_FOOTSTEPS)
-	{
-		mFootsteps = mNormalFootsteps;
-	}
-	if (FootstepsID == FOOTSTEPS_2_VARIANT)
-	{
-		mFootsteps = mVariant1Footsteps;
-	}
-	if (FootstepsID == FOOTSTEPS_3_VARIANT)
-	{
-		mFootsteps = mCreakingFootsteps;
-	}
+	// Use this random ID to select the region of the next footsteps sound
+	mFootstepRegion = mFootstepRegions[FootstepsID - 1];
 	// Set PlayerCanMove to false so that the player cannot move until the timer has reached 1 second
 	mPlayerCanMove = false;
 }
@@ -417,28 +477,17 @@ void Player::SetFootstepsSound()
 
 // Function:		SetPainsound() - Set Pain Sound function
 // Description:		This function is called when the player collides with a wall or an object in order to randomly select the next
-//					pain sound file to use. There are 3 different pain sound files and one is randomly selected to give the player 
+//					pain sound to use. There are 3 different pain sounds and one is randomly selected to give the player 
 //					more variety in how they sound when they collide with an object.
 // In:				N/a
 // Out:				N/a
 void Player::SetPainSound()
 {
 	// Get the random next pain sound ID between 1 and 3
-	int PainID = rand() % 3 + 1;
+	int PainID = mRandom.Range(1, 3);
 
-	// Use this ID to select the next pain sound
-	if (PainID == 1)
-	{
-		mCurrentPainSound = mPainSound1;
-	}
-	if (PainID == 2)
-	{
-		mCurrentPainSound = mPainSound2;
-	}
-	if (PainID == 3)
-	{
-		mCurrentPainSound = mPainSound3;
-	}
+	// Use this ID to select the region of the next pain sound
+	mPainRegion = mPainRegions[PainID - 1];
 	// Set InPain to false so that the pain sound doesn't keep playing after it has played once
 	mInPain = false;
 }
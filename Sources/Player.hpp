@@ -11,7 +11,7 @@
 	Date:	25th April 2015
 
 	Exposes:	Player.
-	Requires:	XASound, Listener, GameTimer.
+	Requires:	XASound, SoundSheet, Listener, GameTimer.
 
 	Description:
 	This class models a player within a 3D game that is rendered in audio.
@@ -31,6 +31,9 @@
 	Different sounds are played on moving forward or rotating. In addition sounds are played based on the stage of the game such
 	as the intro or the outro, as well as the constant sounds such as breathing and the heartbeat.
 	If the sounds are not created successfully then the Player behaviour will still work, except without audio feedback.
+
+	The footsteps and pain sounds each have three variants, so each set is a SoundSheet: one file and buffer holding the variants
+	as named regions, played on PLAYER_SHEET_VOICES voices rather than a voice for each variant.
 */
 
 #ifndef __PLAYER_HPP__
@@ -51,26 +54,43 @@ using std::string;;
 #include "Listener.hpp"
 #include "GameTimer.h"
 #include "XASound.hpp"
+#include "SoundSheet.hpp"
+#include "Random.hpp"
 using AllanMilne::Audio::XASound;
+using AllanMilne::Audio::SoundSheet;
 
 // Define the integer ID for each footstep type
 #define DEFAULT_FOOTSTEPS 1
 #define FOOTSTEPS_2_VARIANT 2
 #define FOOTSTEPS_3_VARIANT 3
 
+// The number of variants of the footsteps and pain sounds, and the voices each of their sound sheets plays them on
+#define PLAYER_SOUND_VARIANTS 3
+#define PLAYER_SHEET_VOICES 2
+
+// The stream of the player's random generator, so its sequence differs from the ghost's and critters' for the same seed
+#define PLAYER_RANDOM_STREAM 1
+
 // The Player Class
 class Player 
 {
 
 // Public Member functions and variables
 public:
-	// Function:		Player() - Player Constructor
+	// Function:		Player(unsigned int) - Player Constructor
 	// Description:		The constructor for the Player class creates the Listener object and sets the object with its start position/orientation
 	//					Initialises all variables to their defaults at the start of the game and creates the XASound objects with the string
 	//					file names in the anonymous namespace within Player.cpp.
+	//					The player's random generator, used to choose the footstep and pain sounds, is seeded from the seed passed.
+	// In:				unsigned int Seed - the seed for the player's random generator
+	// Out:				N/a
+	Player (unsigned int Seed);
+
+	// Function:		~Player() - Player Destructor
+	// Description:		Deletes the player's sounds, timers and Listener object
 	// In:				N/a
 	// Out:				N/a
-	Player ();
+	~Player ();
 
 	// Function:		IsValid() - Is Valid function
 	// Description:		This function checks to see if the sounds needed for the player have been created successfully
@@ -83,10 +103,24 @@ public:
 	// Description:		This function uses the players current position and the listeners orientation and adds this orientation to the 
 	//					current position in order to find the position the player would be in if they were to move in this direction.
 	//					This is used in the Room.cpp file to check for collisions within the room and it is called every frame
+	//					Uses the position and direction the listener is moving/turning to, so a move part way through is on the grid.
 	// In:				N/a
 	// Out:				XA3DAUDIO_VECTOR NextPosition - the vector for the next position the player will be in 
 	X3DAUDIO_VECTOR GetNextPosition ();
 
+	// Function:		GetFootstepsDuration() - Get Footsteps Duration function
+	// Description:		Returns the length of the footsteps sound that will be played for the next move, so the listener can move
+	//					over the same time
+	// In:				N/a
+	// Out:				float - the length of the sound in seconds
+	float GetFootstepsDuration () const;
+
+	// Function:		GetTurningDuration() - Get Turning Duration function
+	// Description:		Returns the length of the turning sound, so the listener can turn over the same time
+	// In:				N/a
+	// Out:				float - the length of the sound in seconds
+	float GetTurningDuration () const;
+
 	// Function:		GetPosition() - Get Position Function
 	// Description:		This function returns the current position of the player's Listener object
 	// In:				N/a
@@ -105,6 +139,12 @@ public:
 	// Out:				Listener::Direction - The enum value of the Listeners current orientation
 	inline Listener::Direction GetDirection() const { return mPlayerListener->mBodyOrientation; }
 
+	// Function:		GetRandom() - Get Random function
+	// Description:		Returns the player's random generator so its state can be saved and restored
+	// In:				N/a
+	// Out:				Random& - the player's random generator
+	inline Random& GetRandom() { return mRandom; }
+
 	// Function:		ResetPlayer() - Reset Player function
 	// Description:		This player calls the Listeners Reset() function to reset the position and orientation of the Listener
 	// In:				N/a
@@ -160,7 +200,7 @@ private:
 
 	// Function:		SetFootstepsSound() - Set Footsteps Sound function
 	// Description:		This function is called whenever the footsteps sound is played when the player moves in order to randomly
-	//					select the next footsteps sound. There are 3 different footstep sound files and one is randomly selected to give the 
+	//					select the next footsteps sound. There are 3 different footstep sounds and one is randomly selected to give the 
 	//					room diversity by making the floor sound different in different places
 	// In:				N/a
 	// Out:				N/a
@@ -168,28 +208,29 @@ private:
 
 	// Function:		SetPainsound() - Set Pain Sound function
 	// Description:		This function is called when the player collides with a wall or an object in order to randomly select the next
-	//					pain sound file to use. There are 3 different pain sound files and one is randomly selected to give the player 
+	//					pain sound to use. There are 3 different pain sounds and one is randomly selected to give the player 
 	//					more variety in how they sound when they collide with an object.
 	// In:				N/a
 	// Out:				N/a
 	void SetPainSound();
 
 	// All Sounds used for the Player 
-	XASound *mFootsteps;
-	XASound *mNormalFootsteps;
-	XASound *mCreakingFootsteps;
-	XASound *mVariant1Footsteps;
 	XASound *mTurning;
 	XASound *mCaptureSound;
 	XASound *mBreathing;
 	XASound *mHeartBeat;
 	XASound *mIntroSound;
-	XASound *mPainSound1;
-	XASound *mPainSound2;
-	XASound *mPainSound3;
-	XASound *mCurrentPainSound;
 	XASound *mOutroSound;
 
+	// The sound sheets of the footsteps and pain sounds, the region of each variant (indexed by its ID - 1), and the region
+	// of the variant to play next
+	SoundSheet *mFootstepSheet;
+	SoundSheet *mPainSheet;
+	int mFootstepRegions[PLAYER_SOUND_VARIANTS];
+	int mPainRegions[PLAYER_SOUND_VARIANTS];
+	int mFootstepRegion;
+	int mPainRegion;
+
 	// Pointer list of all XASound objects in the player class so they can be interacted with
 	list<XASound*> mPlayerSounds;
 
@@ -197,6 +238,9 @@ private:
 	GameTimer *mFootstepTimer;
 	GameTimer *mTurningTimer;
 
+	// The player's own random generator, for choosing sounds
+	Random mRandom;
+
 	// Bool used to signify if the outro sound for the player has been played
 	bool mOutroPlayed;
 
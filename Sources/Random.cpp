@@ -0,0 +1,174 @@
+/*
+	file:	Random.cpp
+	Version:	1.0
+	Date:		18th October 2026
+	Author:	agent
+
+	Exposes:	Implementation of the Random and ShuffleBag classes
+	Requires:	N/a
+
+	Description:
+	The PCG32 random number generator and a shuffle bag drawing from it.
+	*	See Random.hpp for details.
+*/
+
+// System includes.
+#include <Windows.h>
+#include <vector>
+using std::vector;
+
+// Application includes.
+#include "Random.hpp"
+
+// Anonymous namespace for the generator constants
+namespace
+{
+	// The PCG32 linear congruential multiplier
+	const UINT64 Multiplier = 6364136223846793005ULL;
+}
+// end anonymous namespace.
+
+
+
+// Function:		Random(UINT64, UINT64) - Random Constructor
+// Description:		Creates the generator with the given seed and stream
+// In:				UINT64 SeedValue - the seed, UINT64 Stream - the stream selector
+// Out:				N/a
+Random::Random(UINT64 SeedValue, UINT64 Stream)
+{
+	Seed(SeedValue, Stream);
+}
+// End Random constructor
+
+
+
+// Function:		Seed(UINT64, UINT64) - Seed function
+// Description:		Restarts the generator from a seed on a stream
+// In:				UINT64 SeedValue - the seed, UINT64 Stream - the stream selector
+// Out:				N/a
+void Random::Seed(UINT64 SeedValue, UINT64 Stream)
+{
+	// As pcg32_srandom; the increment must be odd
+	mState.State = 0;
+	mState.Increment = (Stream << 1) | 1;
+	Next();
+	mState.State += SeedValue;
+	Next();
+}
+// End Seed function
+
+
+
+// Function:		Next() - Next function
+// Description:		Returns the next value in the sequence
+// In:				N/a
+// Out:				UINT32 - a value from 0 to 0xFFFFFFFF
+UINT32 Random::Next()
+{
+	UINT64 OldState = mState.State;
+	mState.State = OldState * Multiplier + mState.Increment;
+
+	// Output is a permutation of the old state: an xorshift, then a rotation chosen by the top bits
+	UINT32 XorShifted = UINT32(((OldState >> 18) ^ OldState) >> 27);
+	UINT32 Rotation = UINT32(OldState >> 59);
+	return (XorShifted >> Rotation) | (XorShifted << ((32 - Rotation) & 31));
+}
+// End Next function
+
+
+
+// Function:		NextBelow(UINT32) - Next Below function
+// Description:		Returns an unbiased value less than the bound. Multiplies a value by the bound and takes the high 32 bits;
+//					the few values that would make some results more likely than others are rejected.
+// In:				UINT32 Bound - one more than the largest value wanted; must be greater than 0
+// Out:				UINT32 - a value from 0 to Bound - 1
+UINT32 Random::NextBelow(UINT32 Bound)
+{
+	if (Bound == 0)
+	{
+		return 0;
+	}
+
+	UINT64 Product = UINT64(Next()) * Bound;
+	UINT32 Low = UINT32(Product);
+	if (Low < Bound)
+	{
+		// (2^32 - Bound) % Bound; only calculated in the rare case it may be needed
+		UINT32 Threshold = (0xFFFFFFFFu - Bound + 1) % Bound;
+		while (Low < Threshold)
+		{
+			Product = UINT64(Next()) * Bound;
+			Low = UINT32(Product);
+		}
+	}
+	return UINT32(Product >> 32);
+}
+// End NextBelow function
+
+
+
+// Function:		Range(int, int) - Range function
+// Description:		Returns an unbiased value between the limits, including both
+// In:				int Lowest, int Highest - the limits; Highest must not be less than Lowest
+// Out:				int - a value from Lowest to Highest
+int Random::Range(int Lowest, int Highest)
+{
+	if (Highest <= Lowest)
+	{
+		return Lowest;
+	}
+	return Lowest + int(NextBelow(UINT32(Highest - Lowest) + 1));
+}
+// End Range function
+
+
+
+// Function:		NextFloat() - Next Float function
+// Description:		Returns a value in the range 0 to 1, not including 1; uses the top 24 bits so every value is exact in a float
+// In:				N/a
+// Out:				float - a value from 0.0 up to 1.0
+float Random::NextFloat()
+{
+	return float(Next() >> 8) * (1.0f / 16777216.0f);
+}
+// End NextFloat function
+
+
+
+// Function:		ShuffleBag(int) - Shuffle Bag Constructor
+// Description:		Creates a full bag holding the values 0 to Count - 1
+// In:				int Count - the number of values
+// Out:				N/a
+ShuffleBag::ShuffleBag(int Count)
+{
+	for (int i = 0; i < Count; i++)
+	{
+		mValues.push_back(i);
+	}
+	mRemaining = Count;
+}
+// End ShuffleBag constructor
+
+
+
+// Function:		Draw(Random, int) - Draw function
+// Description:		Takes a random value out of the bag; the value is moved to the end of the bag's array so no value is drawn
+//					twice and the draw takes constant time
+// In:				Random &Generator - the generator to draw with, int &Value - set to the value drawn
+// Out:				bool - false if the bag is empty
+bool ShuffleBag::Draw(Random &Generator, int &Value)
+{
+	if (mRemaining <= 0)
+	{
+		return false;
+	}
+
+	// Swap the chosen value with the last one still in the bag, then shrink the bag past it
+	int Chosen = int(Generator.NextBelow(UINT32(mRemaining)));
+	mRemaining--;
+	Value = mValues[Chosen];
+	mValues[Chosen] = mValues[mRemaining];
+	mValues[mRemaining] = Value;
+	return true;
+}
+// End Draw function
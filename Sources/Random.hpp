@@ -0,0 +1,137 @@
+/*
+	file:	Random.hpp
+	Version:	1.0
+	Date:		18th October 2026
+	Author:	agent
+
+	Exposes:	Random, RandomState, ShuffleBag
+	Requires:	N/a
+
+	Description:
+	A small seedable random number generator, so each part of the game can own its own random sequence rather than
+	sharing the global rand() state; the choices one part makes then don't change the choices of another, and a run
+	can be repeated from its seed.
+
+	Random is the PCG32 generator (M.E. O'Neill, pcg-random.org): 64 bits of state and a stream selector, producing 32 bit values.
+	*	the seed and stream are set when it is created or with Seed(); generators with different streams give independent
+		sequences from the same seed;
+	*	bounded values are unbiased;
+	*	GetState() and SetState() save and restore the generator, e.g. to replay from a point in a game.
+
+	ShuffleBag holds the values 0 to Count - 1 and draws them in a random order without repeats, each draw taking constant time;
+	when it is empty it must be refilled before it gives any more values.
+*/
+
+// Define the classes
+#ifndef __RANDOM_HPP__
+#define __RANDOM_HPP__
+
+// System includes.
+#include <Windows.h>
+#include <vector>
+using std::vector;
+
+// The saved state of a Random generator
+struct RandomState
+{
+	UINT64 State;
+	UINT64 Increment;		// Selects the stream; always odd
+};
+
+// The Random class
+class Random
+{
+// Public Member functions and variables
+public:
+
+	// Function:		Random(UINT64, UINT64) - Random Constructor
+	// Description:		Creates the generator with the given seed and stream
+	// In:				UINT64 SeedValue - the seed, UINT64 Stream - the stream selector
+	// Out:				N/a
+	Random(UINT64 SeedValue = 0, UINT64 Stream = 0);
+
+	// Function:		Seed(UINT64, UINT64) - Seed function
+	// Description:		Restarts the generator from a seed on a stream
+	// In:				UINT64 SeedValue - the seed, UINT64 Stream - the stream selector
+	// Out:				N/a
+	void Seed(UINT64 SeedValue, UINT64 Stream = 0);
+
+	// Function:		Next() - Next function
+	// Description:		Returns the next value in the sequence
+	// In:				N/a
+	// Out:				UINT32 - a value from 0 to 0xFFFFFFFF
+	UINT32 Next();
+
+	// Function:		NextBelow(UINT32) - Next Below function
+	// Description:		Returns an unbiased value less than the bound
+	// In:				UINT32 Bound - one more than the largest value wanted; must be greater than 0
+	// Out:				UINT32 - a value from 0 to Bound - 1
+	UINT32 NextBelow(UINT32 Bound);
+
+	// Function:		Range(int, int) - Range function
+	// Description:		Returns an unbiased value between the limits, including both
+	// In:				int Lowest, int Highest - the limits; Highest must not be less than Lowest
+	// Out:				int - a value from Lowest to Highest
+	int Range(int Lowest, int Highest);
+
+	// Function:		NextFloat() - Next Float function
+	// Description:		Returns a value in the range 0 to 1, not including 1
+	// In:				N/a
+	// Out:				float - a value from 0.0 up to 1.0
+	float NextFloat();
+
+	// Function:		GetState()/SetState(RandomState) - Get State and Set State functions
+	// Description:		Save and restore the generator
+	// In:				const RandomState &NewState - a state from GetState
+	// Out:				RandomState - the current state
+	inline RandomState GetState() const { return mState; }
+	inline void SetState(const RandomState &NewState) { mState = NewState; mState.Increment |= 1; }
+
+// Private member functions and variables
+private:
+	RandomState mState;
+};
+// end Random class.
+
+
+
+// The ShuffleBag class
+class ShuffleBag
+{
+// Public Member functions and variables
+public:
+
+	// Function:		ShuffleBag(int) - Shuffle Bag Constructor
+	// Description:		Creates a full bag holding the values 0 to Count - 1
+	// In:				int Count - the number of values
+	// Out:				N/a
+	ShuffleBag(int Count);
+
+	// Function:		Draw(Random, int) - Draw function
+	// Description:		Takes a random value out of the bag; the value is moved to the end of the bag's array so no value is drawn
+	//					twice and the draw takes constant time
+	// In:				Random &Generator - the generator to draw with, int &Value - set to the value drawn
+	// Out:				bool - false if the bag is empty
+	bool Draw(Random &Generator, int &Value);
+
+	// Function:		Refill() - Refill function
+	// Description:		Puts all of the values back into the bag
+	// In:				N/a
+	// Out:				N/a
+	inline void Refill() { mRemaining = int(mValues.size()); }
+
+	// Function:		GetRemaining() - Get Remaining function
+	// Description:		Returns the number of values still in the bag
+	// In:				N/a
+	// Out:				int - the number of values that can be drawn before the bag is refilled
+	inline int GetRemaining() const { return mRemaining; }
+
+// Private member functions and variables
+private:
+	// The values; the first mRemaining are still in the bag
+	vector<int> mValues;
+	int mRemaining;
+};
+// end ShuffleBag class.
+
+#endif
@@ -11,7 +11,7 @@
 	Date:	5th May 2015
 
 	Exposes:	Implementation of the Room class.
-	Requires:	Player, XACore, XASound, stu::v3f.
+	Requires:	Player, XACore, XASound, Profiler, TraceLog, RoomLayout, PathFinder, stu::v3f, stu::batch.
 
 	Description:
 	Models a square room on the X-Z plane with a door through which can be heard the outside sounds, appropriately oriented.
@@ -19,8 +19,8 @@
 	successfully defeated the ghost. 
 	*	See Room.hpp for details.
 
-	This version has a fixed room layout;
-	This layout is defined by the definitions in Room.hpp and the positions are set in the initialisation functions
+	The room's layout is read from a RoomLayout when the room is created;
+	The sounds that aren't part of the layout, and the outside sound used if the layout has no outdoor emitter, are set below
 
 	Although the Room is entirely on the X-Z horizontal plane, the stu::v3f vector and X3DAUDIO_VECTOR representation is used.
 
@@ -42,6 +42,8 @@ using std::string;
 // Framework includes.
 #include "XACore.hpp"
 #include "XASound.hpp"
+#include "Profiler.hpp"
+#include "TraceLog.hpp"
 using AllanMilne::Audio::XACore;
 using AllanMilne::Audio::XASound;
 
@@ -59,26 +61,36 @@ namespace
 	const string HitWallFile = "Sounds/HitWallNoise.wav";
 	const string LockedDoorFile = "Sounds/LockedDoor.wav";
 	const string OutsideFile = "Sounds/OutdoorSound.wav";
-	const string PianoCollisionFile = "Sounds/PianoCollision.wav";
-	const string RadioCollisionFile = "Sounds/RadioCollision.wav";
-	const string TableCollisionFile = "Sounds/TableCollision.wav";
-	const string TypewriterCollisionFile = "Sounds/TypewriterCollision.wav";
 } 
 // end anonymous namespace.
 
 
 
-// Function:		Room() - Room Constructor
-// Description:		Initialises sounds/objects and emitters for the game
-// In:				N/a
+// Function:		Room(unsigned int, RoomLayout, UINT32) - Room Constructor
+// Description:		Initialises sounds/objects and emitters for the game from a room of a layout, and seeds the random generators
+//					of the player, ghost and critters, so a run can be repeated with the same seed. The layout is only used while
+//					the room is created; the default layout's room is used if the layout has no such room
+// In:				unsigned int Seed - the seed for the random generators, const RoomLayout &Layout - the layout,
+//					UINT32 RoomIndex - the room of the layout
 // Out:				N/a
-Room::Room ()
+Room::Room (unsigned int Seed, const RoomLayout &Layout, UINT32 RoomIndex)
 {
-	// Initialise all XASound objects for the room using the file names from the anonymous namespace
+	const RoomLayout &TheLayout = (RoomIndex < Layout.GetRoomCount()) ? Layout : RoomLayout::GetDefault();
+	if (&TheLayout != &Layout)
+	{
+		RoomIndex = 0;
+	}
+	const LayoutRoom &LayoutOfRoom = TheLayout.GetRoom(RoomIndex);
+
+	// The outdoor emitter is placed by the layout; without one the outside sound is just behind the door
+	const LayoutEmitter *OutdoorPlacement = TheLayout.FindEmitter(RoomIndex, OUTDOOR_EMITTER);
+
+	// Initialise all XASound objects for the room using the file names from the anonymous namespace and the layout
 	mHitWallSound = new XASound(HitWallFile);			// Sound used for when player collides with wall
 	mRoomSounds.push_back(mHitWallSound);
 
-	mForestSound = new XASound(OutsideFile, true);		// Sound used for the OutdoorEmitter
+	// Sound used for the OutdoorEmitter
+	mForestSound = new XASound((OutdoorPlacement != NULL) ? string(TheLayout.GetString(OutdoorPlacement->Sound)) : OutsideFile, true);
 	mRoomSounds.push_back(mForestSound);
 
 	mHitDoorSound = new XASound(LockedDoorFile);		// Sound used for when player collides with the locked door
@@ -90,25 +102,29 @@ Room::Room ()
 	mDoorOpenSound = new XASound(DoorOpenFile);			// Sound used for when the door opens
 	mRoomSounds.push_back(mDoorOpenSound);
 
-	mTableCollisionSound = new XASound(TableCollisionFile);	// Sound used when player collides with the table
-	mRoomSounds.push_back(mTableCollisionSound);
-
-	mPianoCollisionSound = new XASound(PianoCollisionFile);	// Sound used when player collides with the piano
-	mRoomSounds.push_back(mPianoCollisionSound);
-
-	mRadioCollisionSound = new XASound(RadioCollisionFile);	// Sound used when player collides with the radio
-	mRoomSounds.push_back(mRadioCollisionSound);
-
-	mTypeWriterCollisionSound = new XASound(TypewriterCollisionFile);	// Sound used when player collides with the typewriter
-	mRoomSounds.push_back(mTypeWriterCollisionSound);
-
-	// Seed the random generator with the current time
-	srand (time(NULL));
+	// Sounds used when the player collides with the obstacles; obstacles of the same type share the first sound the layout gives,
+	// and walls, and obstacles without a sound, sound like the walls
+	for (int Value = 0; Value < CELL_VALUE_COUNT; Value++)
+	{
+		mCollisionSounds[Value] = mHitWallSound;
+	}
+	const LayoutObstacle *Obstacles = TheLayout.GetObstacles(RoomIndex);
+	for (UINT32 i = 0; i < LayoutOfRoom.ObstacleCount; i++)
+	{
+		const LayoutObstacle &Obstacle = Obstacles[i];
+		if ((Obstacle.Value != WALL_VALUE) && (Obstacle.Sound != 0) && (mCollisionSounds[Obstacle.Value] == mHitWallSound))
+		{
+			mCollisionSounds[Obstacle.Value] = new XASound(TheLayout.GetString(Obstacle.Sound));
+			mRoomSounds.push_back(mCollisionSounds[Obstacle.Value]);
+		}
+	}
 
-	// Create the Player, Ghost and Critter objects for the room
-	mPlayer = new Player();
-	mGhost = new Ghost(mPlayer);
-	mCritters = new MovingCritter(mPlayer);
+	// Create the Player, Ghost and Critter objects for the room; each has its own random generator on its own stream of the seed
+	mPlayer = new Player(Seed);
+	mGhost = new Ghost(mPlayer, Seed, TheLayout, RoomIndex, &mPathFinder);
+	mCritters = new MovingCritter(mPlayer, Seed, &mPathFinder);
+	mSwarm = NULL;
+	mSwarmSeed = Seed;
 
 	// Set initial bool states for the room
 	mInitialised = false;		// The room has not been initialised
@@ -120,15 +136,19 @@ Room::Room ()
 	// Initialise the ghost distance value to 0
 	mGhostDistance = 0;
 
+	// Create the timer for updating the emitters while the player moves
+	mControlTimer = new GameTimer();
+	mControlTimer->Reset();
+
 	// Position of the door in the scene
-	mDoorPosition.x = 8.0f;
+	mDoorPosition.x = LayoutOfRoom.DoorX;
 	mDoorPosition.y = 0.0f;
-	mDoorPosition.z = 0.0f; 
+	mDoorPosition.z = LayoutOfRoom.DoorZ;
 
-	// Position of outside sound; in this case 1.5 units perpindicular to middle of door so that the noise is positioned just behind it
-	mOutsideSoundPosition.x = mDoorPosition.x;
+	// Position of outside sound; by default 1.5 units perpindicular to middle of door so that the noise is positioned just behind it
+	mOutsideSoundPosition.x = (OutdoorPlacement != NULL) ? OutdoorPlacement->X : mDoorPosition.x;
 	mOutsideSoundPosition.y = 0.0f;
-	mOutsideSoundPosition.z = mDoorPosition.z - 1.5f;
+	mOutsideSoundPosition.z = (OutdoorPlacement != NULL) ? OutdoorPlacement->Z : (mDoorPosition.z - 1.5f);
 
 	// Get stu::v3f objects of the X3DAUDIO_VECTOR objects so they can be used to initialise the emitters
 	v3f SoundPosition = {mOutsideSoundPosition.x, mOutsideSoundPosition.y, mOutsideSoundPosition.z};
@@ -136,25 +156,56 @@ Room::Room ()
 
 	// Create the Outdoor emitter with a cone using the mForestSound and setting it to looped
 	mOutdoorEmitter = new Emitter(mForestSound, mOutsideSoundPosition, mPlayer->GetListenerStruct(), &SoundPosition, &DoorPosition, true);
+	// Use the outdoor distance curves; these have no low pass filter curve as the door controls the filter
+	mOutdoorEmitter->SetEmitterType(OUTDOOR_EMITTER);
+	// The outdoor sound never moves, so its settings are kept for the places the player stands
+	mOutdoorEmitter->EnablePanningTable();
 	// Set the filter for the Outdoor emitter to a Low Pass Filter so it sounds muffled while the door is closed
 	mOutdoorEmitter->SetEmitterFilter(LowPassFilter, 550.0f, 1.2);
 
+	// Create the layout's other emitters; each plays its sound looped, with the distance curves of its type
+	const LayoutEmitter *Placements = TheLayout.GetEmitters(RoomIndex);
+	for (UINT32 i = 0; i < LayoutOfRoom.EmitterCount; i++)
+	{
+		const LayoutEmitter &Placement = Placements[i];
+		if (&Placement == OutdoorPlacement)
+		{
+			continue;
+		}
+		XASound *PlacedSound = new XASound(TheLayout.GetString(Placement.Sound), true);
+		mRoomSounds.push_back(PlacedSound);
+		X3DAUDIO_VECTOR PlacedPosition = { Placement.X, 0.0f, Placement.Z };
+		Emitter *PlacedEmitter = new Emitter(PlacedSound, PlacedPosition, mPlayer->GetListenerStruct(), true);
+		PlacedEmitter->SetEmitterType(EmitterType(Placement.Type));
+		PlacedEmitter->EnableReflections();
+		PlacedEmitter->EnablePanningTable();
+		mLayoutEmitters.push_back(PlacedEmitter);
+	}
+
 	// Call the SetUpRoom function to fill the 2D room grid with the correct values placing the walls, door and obstacles
-	SetUpRoom();
+	SetUpRoom(TheLayout, RoomIndex);
+
+	// Set up the walls and door used for the early reflections of the emitters; the walls are the outer cells of the grid.
+	// The grid is indexed at position - 1, so the 3 door cells centred on index mDoorPosition.x cover positions x to x + 3
+	EarlyReflections::SetRoomBounds(1.0f, float(mRoomGrid.GetWidth()), 1.0f, float(mRoomGrid.GetDepth()));
+	EarlyReflections::SetDoor(mDoorPosition.x + 1.5f, 3.0f, false);
 } 
 // end Room constructor.
 	
 
 
 // Function:		~Room() - Room Destructor
-// Description:		Destructor stops the sounds playing in the scene
+// Description:		Destructor stops the sounds playing in the scene and deletes the room's objects
 // In:				N/a
 // Out:				N/a
 Room::~Room()
 {
-	// Stop the outdoor emitter sound playing and delete the cone
+	// Stop the outdoor emitter sound playing; its cone is a member of the emitter, so is deleted with it
 	mOutdoorEmitter->StopEmitter();
-	delete mOutdoorEmitter->mEmitter.pCone;
+	for (auto PlacedEmitter = mLayoutEmitters.begin(); PlacedEmitter != mLayoutEmitters.end(); ++ PlacedEmitter)
+	{
+		(*PlacedEmitter)->StopEmitter();
+	}
 
 	// Check through all XASound objects in the room and stop them
 	for (auto RoomSound = mRoomSounds.begin(); RoomSound != mRoomSounds.end(); ++ RoomSound)
@@ -168,122 +219,48 @@ Room::~Room()
 	mPlayer->Stop();
 	mGhost->Stop();
 	mCritters->Stop();
+	if (mSwarm != NULL)
+	{
+		mSwarm->Stop();
+	}
+
+	// Delete the emitters' owners before the player, as the emitters use the player's listener, and the emitter before its sound
+	delete mOutdoorEmitter;
+	for (auto PlacedEmitter = mLayoutEmitters.begin(); PlacedEmitter != mLayoutEmitters.end(); ++ PlacedEmitter)
+	{
+		delete *PlacedEmitter;
+	}
+	delete mSwarm;
+	delete mCritters;
+	delete mGhost;
+	delete mPlayer;
+	for (auto RoomSound = mRoomSounds.begin(); RoomSound != mRoomSounds.end(); ++ RoomSound)
+	{
+		delete *RoomSound;
+	}
+
+	delete mControlTimer;
 } 
 // end Room destructor.
 
 
 
-// Function:		SetUpRoom() - Set Up Room Function
+// Function:		SetUpRoom(RoomLayout, UINT32) - Set Up Room Function
 // Description:		Set up the map/grid of the room with the walls, obstacles, and the spaces that are free for the player to walk
-// In:				N/a
+// In:				const RoomLayout &Layout - the layout, UINT32 RoomIndex - the room of the layout
 // Out:				N/a
-void Room::SetUpRoom()
+void Room::SetUpRoom(const RoomLayout &Layout, UINT32 RoomIndex)
 {
-	// Set up the room objects with their type, position, and dimensions
-	// Some positions are already set within the Ghost class
-
-	// Piano Object
-	mPianoObject.ObjectType = PIANO_VALUE;
-	mPianoObject.ObjectPosition = mGhost->mPianoPosition;
-	mPianoObject.ObjectWidth = 4.0f;
-	mPianoObject.ObjectHeight = 4.0f;
-
-	// Typewriter Object
-	mTypewriterObject.ObjectType = TYPEWRITER_VALUE;
-	mTypewriterObject.ObjectPosition = mGhost->mTypeWriterPosition;
-	mTypewriterObject.ObjectWidth = 2.0f;
-	mTypewriterObject.ObjectHeight = 2.0f;
-
-	// Table object
-	mTableObject.ObjectType = TABLE_VALUE;
-	mTableObject.ObjectPosition.x = 8.0f;
-	mTableObject.ObjectPosition.y = 0.0f;
-	mTableObject.ObjectPosition.z = 9.0f;
-	mTableObject.ObjectWidth = 2.0f;
-	mTableObject.ObjectHeight = 4.0f;
-
-	// Radio Object
-	mRadioObject.ObjectType = RADIO_VALUE;
-	mRadioObject.ObjectPosition = mGhost->mRadioPosition;
-	mRadioObject.ObjectWidth = 2.0f;
-	mRadioObject.ObjectHeight = 2.0f;
-
-	// Set the collision variables to false, these are true when the player collides with these objects to play the appropriate sound
-	mPianoCollision = false;
-	mRadioCollision = false;
-	mTypeWriterCollision = false;
-	mTableCollision = false;
-
-	// Each cell in the grid represents 1.0 on the map
-	// Check through the grid and set the cells to their appropriate values based on if they are a free space,
-	// a door, or a specific type of obstacle
-	for (int i = 0; i < ROOM_X_SIZE; i ++)
-	{
-		for (int j = 0; j < ROOM_Z_SIZE; j ++)
-		{
-			// Set the values of the cells at the outer edges of the grid to the WALL_VALUE
-			if ((i == 0) || (j == 0) || (i == ROOM_X_SIZE - 1) || (j == ROOM_Z_SIZE - 1))
-			{
-				// These are the walls around the room
-				mRoomBase[i][j] = WALL_VALUE;
-			}
-			else
-			{
-				// Else set the cells to the NORMAL_FLOOR_VALUE to indicate it is free space
-				mRoomBase[i][j] = NORMAL_FLOOR_VALUE;
-			}
+	// The player hasn't collided with anything; mCollisionValue is set to an obstacle's value when the player collides with it
+	// to play the appropriate sound
+	mCollisionValue = NORMAL_FLOOR_VALUE;
 
-			// Set the values for the door in the room based on the doors position, and + 1 and - 1 in the x axis so that the door is
-			// 3 cells wide
-			if (((i == mDoorPosition.x) || (i == mDoorPosition.x - 1) || (i == mDoorPosition.x + 1)) 
-				&& (j == mDoorPosition.z))
-			{
-				// Fill in values for the door
-				mRoomBase[i][j] = DOOR_VALUE;
-			}
-		}
-	}
+	// Size the grid for the room and set the cells to their appropriate values based on if they are a wall, a door, or a specific
+	// type of obstacle, as given by the room's layout
+	Layout.Rasterize(RoomIndex, mRoomGrid);
 
-	// Fill room with collidable objects
-	for (int i = 0; i < OBJECT_COUNT; i++)
-	{
-		CollidableObject CurrentObject;
-		// Set the current object to the piano object
-		if (i == 0)
-		{
-			CurrentObject = mPianoObject;
-		}
-		// Set the current object to the typewriter object
-		if (i == 1)
-		{
-			CurrentObject = mTypewriterObject;
-		}
-		// Set the current object to the radio object
-		if (i == 2)
-		{
-			CurrentObject = mRadioObject;
-		}
-		// Set the current object to the table object
-		if (i == 3)
-		{
-			CurrentObject = mTableObject;
-		}
-
-		// Find the half height and width dimension values to calculate the bottom left and top right positions
-		float HalfHeight = int(0.5 * CurrentObject.ObjectHeight);
-		float HalfWidth = int(0.5 * CurrentObject.ObjectWidth);
-
-		// Fill in the X Axis from the left of the obstacle to the right
-		for (int i = CurrentObject.ObjectPosition.x - HalfWidth; i <= (CurrentObject.ObjectPosition.x + HalfWidth) - 1; i++)
-		{
-			// Fill in the Z Axis from the bottom of the obstacle to the top
-			for (int j = CurrentObject.ObjectPosition.z - HalfHeight; j <= (CurrentObject.ObjectPosition.z + HalfHeight) - 1; j++)
-			{
-				// Set the cell value to the current objects ObjectType value, indicating what kind of obstacle is in this position
-				mRoomBase[i][j] = CurrentObject.ObjectType;
-	 		}
-		}
-	}
+	// Find the ghost's and critters' paths on the grid
+	mPathFinder.SetGrid(mRoomGrid);
 
 	// Set up ambient music
 	mAmbientMusic->SetLooped(true);
@@ -294,6 +271,33 @@ void Room::SetUpRoom()
 
 
 
+// Function:		AddSwarm(size_t) - Add Swarm function
+// Description:		Adds a swarm of critters to the room, in place of any added before; it starts moving once the ghost
+//					and critters have been initialised
+// In:				size_t Count - the number of critters
+// Out:				bool - false if the swarm's sounds could not be set up; the room then has no swarm
+bool Room::AddSwarm(size_t Count)
+{
+	if (mSwarm != NULL)
+	{
+		mSwarm->Stop();
+		delete mSwarm;
+	}
+
+	// The swarm scurries about the same grid as the player, on its own stream of the room's seed
+	mSwarm = new CritterSwarm(mPlayer->GetListenerStruct(), mSwarmSeed, Count, mRoomGrid);
+	if (!mSwarm->IsValid())
+	{
+		delete mSwarm;
+		mSwarm = NULL;
+		return false;
+	}
+	return true;
+}
+// End AddSwarm function
+
+
+
 // Function:		InitialiseRoomObjects()
 // Description:		Initialises the Ghost and Critter objects when the intro sounds are finished playing
 // In:				N/a
@@ -318,13 +322,15 @@ void Room::InitialiseRoomObjects()
 
 
 
-// Function:		UpdateRoom() - Update Room function
+// Function:		UpdateRoom(float) - Update Room function
 // Description:		Update the room based on the current state of the application, and updates the Player, Ghost and
 //					MovingCritter objects
-// In:				N/a
+// In:				float DeltaTime - the time in seconds since the last update (one tick)
 // Out:				N/a
-void Room::UpdateRoom()
+void Room::UpdateRoom(float DeltaTime)
 {
+	PROFILE_SCOPE("Room::UpdateRoom");
+
 	// Updates
 
 	// If the Room has not been fully initialised, and the player is active (after the intro has played) call InitialiseRoomObjects
@@ -356,14 +362,70 @@ void Room::UpdateRoom()
 	// TryToCaptureGhost function
 	GetDistance();
 
+	// Move the listener along any move or turn in progress
+	UpdateListenerMotion();
+
 	// Update the player, ghost and critter objects every frame
 	mPlayer->UpdatePlayer(mGhostDistance, mPlayerFree);
-	mGhost->UpdateGhost();
-	mCritters->UpdateCritter();
+	mGhost->UpdateGhost(DeltaTime);
+	mCritters->UpdateCritter(DeltaTime);
+	if ((mSwarm != NULL) && mInitialised)
+	{
+		mSwarm->UpdateSwarm(DeltaTime);
+	}
+
+	// Start and update the early reflections of the emitters, within the per-frame budget
+	EarlyReflections::UpdateFrame();
 }
 // End UpdateRoom function
 
 
+
+// Function:		UpdateListenerMotion() - Update Listener Motion function
+// Description:		Moves the player's listener along any move or turn in progress. While it is moving the emitters are updated
+//					at EMITTER_CONTROL_RATE rather than every frame, with a final update when the move or turn finishes.
+// In:				N/a
+// Out:				N/a
+void Room::UpdateListenerMotion()
+{
+	if (!mPlayer->mPlayerListener->UpdateTween())
+	{
+		return;
+	}
+
+	// Update the emitters if a control period has passed since the last update, or the listener has reached its target
+	mControlTimer->Tick();
+	if ((mControlTimer->GetElapsedTime() >= (1.0f / EMITTER_CONTROL_RATE)) || (!mPlayer->mPlayerListener->IsTweening()))
+	{
+		UpdateEmitters();
+		mControlTimer->Reset();
+	}
+}
+// End UpdateListenerMotion function
+
+
+
+// Function:		UpdateEmitters() - Update Emitters function
+// Description:		Updates the outdoor, ghost and critter emitters for the player listener's current position and orientation
+// In:				N/a
+// Out:				N/a
+void Room::UpdateEmitters()
+{
+	mOutdoorEmitter->UpdateEmitter();
+	for (auto PlacedEmitter = mLayoutEmitters.begin(); PlacedEmitter != mLayoutEmitters.end(); ++ PlacedEmitter)
+	{
+		(*PlacedEmitter)->UpdateEmitter();
+	}
+	mGhost->UpdateEmitter();
+	mCritters->UpdateEmitter();
+	if (mSwarm != NULL)
+	{
+		mSwarm->UpdateEmitters();
+	}
+}
+// End UpdateEmitters function
+
+
 // Function:		GetDistance() - Get Distance function
 // Description:		Finds the distance between the player's position and the ghost's in order to find if the player is within range
 //					Sets this distance to the member variable mGhostDistance so that the distance can be checked in the TryToCaptureGhost function
@@ -371,14 +433,9 @@ void Room::UpdateRoom()
 // Out:				N/a
 void Room::GetDistance()
 {
-	// Use stu::v3f objects of the Player Position and Ghost Position in order to find the distance between them
-	X3DAUDIO_VECTOR PlayerPosition = mPlayer->GetPosition();
-	v3f PlayerPos = {PlayerPosition.x, PlayerPosition.y, PlayerPosition.z };
-	v3f GhostPos = {mGhost->GetGhostPosition().x, mGhost->GetGhostPosition().y, mGhost->GetGhostPosition().z };
-
-	// Set the distance to the value returned from the stu::v3f::Distance function between the Player and Ghost position
-	// This distance is then used in the TryToCaptureGhost function to check if the player is within range
-	mGhostDistance = stu::v3f::Distance(PlayerPos, GhostPos);
+	// Find the distance between the Player and Ghost positions straight from their X3DAUDIO_VECTORs, without copying them into
+	// stu::v3f objects first. This distance is then used in the TryToCaptureGhost function to check if the player is within range
+	mGhostDistance = stu::batch::Distance(mPlayer->GetPosition(), mGhost->GetGhostPosition());
 } 
 // End GetDistance function
 
@@ -395,8 +452,12 @@ void Room::Reset()
 	// Reset the Ghost and Critter objects to update their emitters for the new player position/orientation
 	mGhost->Reset();
 	mCritters->Reset();
-	// Reset the Outdoor emitter
+	// Reset the Outdoor emitter and the layout's emitters
 	mOutdoorEmitter->ResetEmitter(true);
+	for (auto PlacedEmitter = mLayoutEmitters.begin(); PlacedEmitter != mLayoutEmitters.end(); ++ PlacedEmitter)
+	{
+		(*PlacedEmitter)->ResetEmitter(true);
+	}
 } 
 // end Reset function.
 
@@ -408,14 +469,53 @@ void Room::Reset()
 void Room::Stop()
 {
 	mOutdoorEmitter->StopEmitter();
+	for (auto PlacedEmitter = mLayoutEmitters.begin(); PlacedEmitter != mLayoutEmitters.end(); ++ PlacedEmitter)
+	{
+		(*PlacedEmitter)->StopEmitter();
+	}
 	mPlayer->Stop();
 	mGhost->Stop();
 	mCritters->Stop();
+	if (mSwarm != NULL)
+	{
+		mSwarm->Stop();
+	}
 } 
 // end Stop function.
 
 
 
+// Function:		WriteTrace(ostream, float) - Write Trace function
+// Description:		Writes one comma separated line of the game state: the time, player position and direction, ghost position,
+//					completed stages and state flags, and the door flags. WriteTraceHeader writes the matching column names.
+// In:				ostream &Trace - the stream to write to, float Time - the game time of this state in seconds
+// Out:				N/a
+void Room::WriteTrace(ostream &Trace, float Time) const
+{
+	X3DAUDIO_VECTOR PlayerPosition = mPlayer->GetPosition();
+	X3DAUDIO_VECTOR GhostPosition = mGhost->GetGhostPosition();
+	Trace << Time << ','
+		<< PlayerPosition.x << ',' << PlayerPosition.z << ',' << int(mPlayer->GetDirection()) << ','
+		<< GhostPosition.x << ',' << GhostPosition.z << ',' << mGhost->GetStageCount() << ','
+		<< mGhost->mGhostActive << ',' << mGhost->IsMoving() << ',' << mGhost->mGhostDefeated << ','
+		<< mDoorOpen << ',' << mDoorExited << '\n';
+}
+// End WriteTrace function
+
+
+
+// Function:		WriteTraceHeader(ostream) - Write Trace Header function
+// Description:		Writes the comma separated column names of the lines written by WriteTrace
+// In:				ostream &Trace - the stream to write to
+// Out:				N/a
+void Room::WriteTraceHeader(ostream &Trace)
+{
+	Trace << "time,player_x,player_z,direction,ghost_x,ghost_z,stages,ghost_active,ghost_moving,ghost_defeated,door_open,door_exited\n";
+}
+// End WriteTraceHeader function
+
+
+
 // Function:		OpenDoor() - Open Door function
 // Description:		Plays the sound for opening the door and sets mDoorOpen to true so that player can then leave the room
 // In:				N/a
@@ -427,6 +527,8 @@ void Room::OpenDoor()
 	// Change the filter for the OutdoorEmitter to a HighPassFilter with the frequency being 0.0, effectively removing the previous LowPassFilter
 	// This is so that the sound no longer sounds as if it is muffled behind the door, and the player can follow it to escape the room
 	mOutdoorEmitter->SetEmitterFilter(HighPassFilter, 0.0f, 0.0);
+	// The open door no longer reflects the sounds in the room
+	EarlyReflections::SetDoor(mDoorPosition.x + 1.5f, 3.0f, true);
 	// Set the door open bool to true so that the player can then escape
 	mDoorOpen = true;
 }
@@ -434,9 +536,8 @@ void Room::OpenDoor()
 
 
 // Function:		HitWallOrDoor() - Hit Wall or Door function
-// Description:		Return true if one step forward will hit a wall/obstacle or exit the door, if the latter then the mDoorExited flag is set.
-//					Otherwise the collision bools for each type of collision (e.g. collision with the piano) are set to true and the appropriate sound 
-//					is played.
+// Description:		Return true if one step forward will hit a wall/obstacle or exit the door, if the latter then the mDoorTry flag is set.
+//					If it will hit an obstacle, mCollisionValue is set to the obstacle's value so the appropriate sound is played.
 // In:				N/a
 // Out:				Bool - true or false based on if the player has hit a wall or an object (true)
 bool Room::HitWallOrDoor() 
@@ -444,59 +545,33 @@ bool Room::HitWallOrDoor()
 	// Find the next position of the player from the Player object, based on the direction they are facing
 	X3DAUDIO_VECTOR NextPos = mPlayer->GetNextPosition();
 
-	// The array starts at 0, positions of the player must take away 1 to be in the correct cell 
-	// Use these values in the array to find what part of the room it is
+	// The grid starts at 0, positions of the player must take away 1 to be in the correct cell 
+	// Use these values in the grid to find what part of the room it is
 	int NextX = int(NextPos.x - 1);
 	int NextZ = int(NextPos.z - 1);
 
-	// If the Next Position is at a cell with a NORMAL_FLOOR_VALUE, returns false so that player can move in the MovePlayer function
-	if (mRoomBase[NextX][NextZ] == NORMAL_FLOOR_VALUE)
+	// Look up what is in the cell once; cells outside the grid read as walls
+	BYTE NextCell = mRoomGrid.GetCell(NextX, NextZ);
+	switch (NextCell)
 	{
+	// If the Next Position is at a cell with a NORMAL_FLOOR_VALUE, returns false so that player can move in the MovePlayer function
+	case NORMAL_FLOOR_VALUE:
 		return false;
-	}
 	// If the next position is at a cell with the DOOR_VALUE, set mDoorTry to true to tell the MovePlayer function the player is colliding
 	// with a door and return true so that player can't move in that direction
-	else if (mRoomBase[NextX][NextZ] == DOOR_VALUE)
-	{
+	case DOOR_VALUE:
 		mDoorTry = true;
 		return true;
-	}
-	// If the next position is at a cell with the TABLE_VALUE, set mTableCollision to true so player knows it collided with a table
-	// and return true so that player can't move in that direction
-	else if (mRoomBase[NextX][NextZ] == TABLE_VALUE)
-	{
-		mTableCollision = true;
-		return true;
-	}
-	// If the next position is at a cell with the PIANO_VALUE, set mPianoCollision to true so player knows it collided with the piano
-	// and return true so that player can't move in that direction
-	else if (mRoomBase[NextX][NextZ] == PIANO_VALUE)
-	{
-		mPianoCollision = true;
-		return true;
-	}
-	// If the next position is at a cell with the RADIO_VALUE, set mRadioCollision to true so player knows it collided with the radio
-	// and return true so that player can't move in that direction
-	else if (mRoomBase[NextX][NextZ] == RADIO_VALUE)
-	{
-		mRadioCollision = true;
-		return true;
-	}
-	// If the next position is at a cell with the TYPEWRITER_VALUE, set mTypeWriterCollision to true so player knows it collided with the typewriter
-	// and return true so that player can't move in that direction
-	else if (mRoomBase[NextX][NextZ] == TYPEWRITER_VALUE)
-	{
-		mTypeWriterCollision = true;
-		return true;
-	}
 	// If the next position is at a cell with the WALL_VALUE, and return true so that player can't move in that direction and knows it collided
 	// with a wall.
-	else if (mRoomBase[NextX][NextZ] == WALL_VALUE)
-	{
+	case WALL_VALUE:
+		return true;
+	// Otherwise the next position is at a cell with an obstacle's value (e.g. the PIANO_VALUE), so set mCollisionValue to it so the player
+	// knows what it collided with and return true so that player can't move in that direction
+	default:
+		mCollisionValue = NextCell;
 		return true;
 	}
-
-	return false;		// Will not hit a wall or obstacle or exit door.
 } 
 // end HitWallOrDoor function
 
@@ -511,6 +586,8 @@ bool Room::HitWallOrDoor()
 // Out:				N/a
 void Room::MovePlayer()
 {
+	TRACE_SCOPE("Room::MovePlayer", "game");
+
 	// Call the HitWallOrDoor function to find if will collide with something and what that object is.
 	if (HitWallOrDoor())
 	{ 
@@ -538,48 +615,16 @@ void Room::MovePlayer()
 				}
 				return;
 			}
-			// Else if the player has collided with the Table (this is set to true when this occurs in the HitDoorOrWall function)
-			else if (mTableCollision)
-			{
-				// Play the sound and set the bool to false so it can be checked again next move
-				if (mTableCollisionSound->IsValid())
-				{
-					mTableCollisionSound->Play();
-					mTableCollision = false;
-				}
-				return;
-			}
-			// Else if the player has collided with the Piano (this is set to true when this occurs in the HitDoorOrWall function)
-			else if (mPianoCollision)
-			{
-				// Play the sound and set the bool to false so it can be checked again next move
-				if (mPianoCollisionSound->IsValid())
-				{
-					mPianoCollisionSound->Play();
-					mPianoCollision = false;
-				}
-				return;
-			}
-			// Else if the player has collided with the Radio (this is set to true when this occurs in the HitDoorOrWall function)
-			else if (mRadioCollision)
-			{
-				// Play the sound and set the bool to false so it can be checked again next move
-				if (mRadioCollisionSound->IsValid())
-				{
-					mRadioCollisionSound->Play();
-					mRadioCollision = false;
-				}
-				return;
-			}
-			// Else if the player has collided with the Typewriter (this is set to true when this occurs in the HitDoorOrWall function)
-			else if (mTypeWriterCollision)
+			// Else if the player has collided with an obstacle (mCollisionValue is set to its value when this occurs in the HitDoorOrWall function)
+			else if (mCollisionValue != NORMAL_FLOOR_VALUE)
 			{
-				// Play the sound and set the bool to false so it can be checked again next move
-				if (mTypeWriterCollisionSound->IsValid())
+				// Play the obstacle's sound and reset the value so it can be checked again next move
+				XASound *CollisionSound = mCollisionSounds[mCollisionValue];
+				if (CollisionSound->IsValid())
 				{
-					mTypeWriterCollisionSound->Play();
-					mTypeWriterCollision = false;
+					CollisionSound->Play();
 				}
+				mCollisionValue = NORMAL_FLOOR_VALUE;
 				return;
 			}
 			else
@@ -599,14 +644,11 @@ void Room::MovePlayer()
 	// If the player can move forward (can only move forward one step at a time)
 	if (mPlayer->mPlayerCanMove)
 	{
-		// Call the MoveForward function for the Player's listener object
-		mPlayer->mPlayerListener->MoveForward();
+		// Call the MoveForward function for the Player's listener object, moving over the length of the footsteps sound
+		// The emitters are updated as the listener moves in UpdateListenerMotion
+		mPlayer->mPlayerListener->MoveForward(1.0f, mPlayer->GetFootstepsDuration());
+		mControlTimer->Reset();
 	}
-
-	// Update the emitters within the room to reflect the player's new position
-	mOutdoorEmitter->UpdateEmitter();
-	mGhost->UpdateEmitter();
-	mCritters->UpdateEmitter();
 } 
 // end MovePlayer function.
 
@@ -614,8 +656,7 @@ void Room::MovePlayer()
 
 // Function:		TurnPlayerLeft() - Turn Player Left function
 // Description:		Calls TurnCounterClockwise twice on the player's Listener object so that it will turn 90 degrees
-//					Also updates the emitters in the application so that their new relativity to the player's position
-//					and orientation is updated
+//					over the length of the turning sound. The emitters are updated as the listener turns in UpdateListenerMotion
 // In:				N/a
 // Out:				N/a
 void Room::TurnPlayerLeft()
@@ -624,12 +665,10 @@ void Room::TurnPlayerLeft()
 	if (mPlayer->mPlayerCanTurn)
 	{
 		// Turn the player's listener CounterClockwise twice in order to turn by 90 degrees (one call turns by 45 degrees)
-		mPlayer->mPlayerListener->TurnCounterClockwise();
-		mPlayer->mPlayerListener->TurnCounterClockwise();
-		// Update the emitters in the room to reflect the player listener's new orientation
-		mOutdoorEmitter->UpdateEmitter();
-		mGhost->UpdateEmitter();
-		mCritters->UpdateEmitter();
+		// The turn takes the length of the turning sound; the emitters are updated as it turns in UpdateListenerMotion
+		mPlayer->mPlayerListener->TurnCounterClockwise(mPlayer->GetTurningDuration());
+		mPlayer->mPlayerListener->TurnCounterClockwise(mPlayer->GetTurningDuration());
+		mControlTimer->Reset();
 	}
 } 
 // end TurnPlayerLeft function.
@@ -638,8 +677,7 @@ void Room::TurnPlayerLeft()
 
 // Function:		TurnPlayerRight() - Turn Player Right function
 // Description:		Calls TurnClockwise twice on the player's Listener object so that it will turn 90 degrees
-//					Also updates the emitters in the application so that their new relativity to the player's position
-//					and orientation is updated
+//					over the length of the turning sound. The emitters are updated as the listener turns in UpdateListenerMotion
 // In:				N/a
 // Out:				N/a
 void Room::TurnPlayerRight()
@@ -648,12 +686,10 @@ void Room::TurnPlayerRight()
 	if (mPlayer->mPlayerCanTurn)
 	{
 		// Turn the player's listener Clockwise twice in order to turn by 90 degrees (one call turns by 45 degrees)
-		mPlayer->mPlayerListener->TurnClockwise();
-		mPlayer->mPlayerListener->TurnClockwise();
-		// Update the emitters in the room to reflect the player listener's new orientation
-		mOutdoorEmitter->UpdateEmitter();
-		mGhost->UpdateEmitter();
-		mCritters->UpdateEmitter();
+		// The turn takes the length of the turning sound; the emitters are updated as it turns in UpdateListenerMotion
+		mPlayer->mPlayerListener->TurnClockwise(mPlayer->GetTurningDuration());
+		mPlayer->mPlayerListener->TurnClockwise(mPlayer->GetTurningDuration());
+		mControlTimer->Reset();
 	}
 } // end turnPlayerRight function.
 
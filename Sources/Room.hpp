@@ -11,7 +11,7 @@
 	Date:	5th May 2015
 
 	Exposes:	Room.
-	Requires:	Player, Ghost, MovingCritter, Stuvector3, XASound.
+	Requires:	Player, Ghost, MovingCritter, Stuvector3, XASound, EarlyReflections, GameTimer, RoomGrid, RoomLayout, PathFinder, CritterSwarm.
 
 	Description:
 	This room class is based on the room class provided in the RoomEscape solution and has been edited for this applications purpose
@@ -22,6 +22,7 @@
 	The player can be moved around the room:
 	*	movement is in 1 step increments in the current player direction;
 	*	turns are by 90 degrees;
+	*	moves and turns take the length of their footstep/turning sound, the emitters being updated at a fixed rate as the player moves;
 	*	cannot move past a wall, or obstacle
 	*	can only move out the door if the ghost has been defeated by the player
 	*	all the above actions have relevant audio feedback.
@@ -32,11 +33,14 @@
 	When the ghost is defeated, it disappears and the doors can be heard opening. The filter is then removed from the outside noise
 	emitter and the player can then exit through the door and win the game.
 
-	The room is a fixed layout of 16 by 16 units. It uses a 2 dimensional grid array to store the positions of the walls/obstacles
+	The room's size, door, obstacles and their collision sounds, the ghost's stages and the emitters placed in the room are read from
+	a room of a RoomLayout; by default the original 16 by 16 unit room. It uses a RoomGrid to store the positions of the walls/obstacles
 	based on the values used in those positions on the grid, and the player checks this grid before moving to check if they bump into
-	an obstacle or not, so the appropriate reaction and noise can be carried out.
+	an obstacle or not, so the appropriate reaction and noise can be carried out. The ghost and critters find their way round
+	the same grid with the room's PathFinder.
 
-	The class calls the update functions for the Ghost, Player and Moving Critter objects.
+	The class calls the update functions for the Ghost, Player and Moving Critter objects, and of a CritterSwarm if one has
+	been added to the room, e.g. to see how the game copes with hundreds of critters.
 
 	All sound files needed for this class are created in an anonymous namespace within the .cpp file.
 */
@@ -52,8 +56,10 @@
 #include <stdlib.h>
 #include <time.h>
 #include <list>
+#include <ostream>
 using std::list;
 using std::unique_ptr;
+using std::ostream;
 
 // Framework includes.
 #include "XASound.hpp"
@@ -64,33 +70,21 @@ using AllanMilne::Audio::XASound;
 #include "Emitter.hpp"
 #include "MovingCritter.hpp"
 #include "StuVector3.hpp"
+#include "StuVector3Batch.hpp"
 #include "Ghost.hpp"
+#include "EarlyReflections.hpp"
+#include "RoomGrid.hpp"
+#include "RoomLayout.hpp"
+#include "PathFinder.hpp"
+#include "CritterSwarm.hpp"
 using namespace stu;
 
-// Define the room dimensions
+// Define the dimensions of the default room; the values used within the grid are defined in RoomGrid.hpp
 #define ROOM_X_SIZE 16
 #define ROOM_Z_SIZE 16
 
-// Define the values to be used within the grid to identify what is within the maps space
-#define NORMAL_FLOOR_VALUE 0
-#define WALL_VALUE 1
-#define DOOR_VALUE 2
-#define TABLE_VALUE 3
-#define PIANO_VALUE 4
-#define RADIO_VALUE 5
-#define TYPEWRITER_VALUE 6
-
-// The amount of obstacles in the scene
-#define OBJECT_COUNT 4
-
-// Struct for the collidable objects to hold the information needed to place them in the grid array
-struct CollidableObject
-{
-	int ObjectType;						// To recognise the type of the object
-	X3DAUDIO_VECTOR ObjectPosition;		// So the position can be set within the grid
-	float ObjectWidth;					// Dimensions needed so that appropriate grid cells are filled with the object's value
-	float ObjectHeight;
-};
+// The rate (updates per second) the emitters are updated at while the player is moving or turning
+#define EMITTER_CONTROL_RATE 60.0f
 
 // The Room class
 class Room 
@@ -99,24 +93,27 @@ class Room
 // Public Member functions and variables
 public:
 
-	// Function:		Room() - Room Constructor
-	// Description:		Initialises sounds/objects and emitters for the game
-	// In:				N/a
+	// Function:		Room(unsigned int, RoomLayout, UINT32) - Room Constructor
+	// Description:		Initialises sounds/objects and emitters for the game from a room of a layout, and seeds the random generators
+	//					of the player, ghost and critters, so a run can be repeated with the same seed. The layout is only used while
+	//					the room is created; the default layout's room is used if the layout has no such room
+	// In:				unsigned int Seed - the seed for the random generators, const RoomLayout &Layout - the layout,
+	//					UINT32 RoomIndex - the room of the layout
 	// Out:				N/a
-	Room ();
+	Room (unsigned int Seed, const RoomLayout &Layout = RoomLayout::GetDefault(), UINT32 RoomIndex = 0);
 
 	// Function:		~Room() - Room Destructor
-	// Description:		Destructor stops the sounds playing in the scene
+	// Description:		Destructor stops the sounds playing in the scene and deletes the room's objects
 	// In:				N/a
 	// Out:				N/a
 	virtual ~Room();
 
-	// Function:		UpdateRoom() - Update Room function
+	// Function:		UpdateRoom(float) - Update Room function
 	// Description:		Update the room based on the current state of the application, and updates the Player, Ghost and
 	//					MovingCritter objects. 
-	// In:				N/a
+	// In:				float DeltaTime - the time in seconds since the last update (one tick)
 	// Out:				N/a
-	void UpdateRoom();
+	void UpdateRoom(float DeltaTime);
 		
 	// Function:		Reset() - Reset function
 	// Description:		Reset the player to the starting position and update the emitters in the scene again to reflect the players new position/orientation
@@ -143,16 +140,14 @@ public:
 
 	// Function:		TurnPlayerLeft() - Turn Player Left function
 	// Description:		Calls TurnCounterClockwise twice on the player's Listener object so that it will turn 90 degrees
-	//					Also updates the emitters in the application so that their new relativity to the player's position
-	//					and orientation is updated
+	//					over the length of the turning sound. The emitters are updated as the listener turns in UpdateListenerMotion
 	// In:				N/a
 	// Out:				N/a
 	void TurnPlayerLeft();
 
 	// Function:		TurnPlayerRight() - Turn Player Right function
 	// Description:		Calls TurnClockwise twice on the player's Listener object so that it will turn 90 degrees
-	//					Also updates the emitters in the application so that their new relativity to the player's position
-	//					and orientation is updated
+	//					over the length of the turning sound. The emitters are updated as the listener turns in UpdateListenerMotion
 	// In:				N/a
 	// Out:				N/a
 	void TurnPlayerRight();
@@ -182,14 +177,50 @@ public:
 
 	inline bool DoorExited () const { return mDoorExited; }
 
+	// Function:		GetGhost() / GetCritters() - Get Ghost / Get Critters functions
+	// Description:		Give the room's ghost and critters, e.g. for the headless driver to follow their movement
+	// In:				N/a
+	// Out:				const Ghost& / const MovingCritter& - the ghost or critters
+	inline const Ghost& GetGhost() const { return *mGhost; }
+	inline const MovingCritter& GetCritters() const { return *mCritters; }
+
+	// Function:		AddSwarm(size_t) - Add Swarm function
+	// Description:		Adds a swarm of critters to the room, in place of any added before; it starts moving once the ghost
+	//					and critters have been initialised
+	// In:				size_t Count - the number of critters
+	// Out:				bool - false if the swarm's sounds could not be set up; the room then has no swarm
+	bool AddSwarm(size_t Count);
+
+	// Function:		GetGrid() - Get Grid function
+	// Description:		Gives the grid of the room's layout, e.g. for finding paths through the room
+	// In:				N/a
+	// Out:				const RoomGrid& - the grid; cell (x, z) is the room position (x + 1, z + 1)
+	inline const RoomGrid& GetGrid() const { return mRoomGrid; }
+
+	// Function:		WriteTrace(ostream, float) - Write Trace function
+	// Description:		Writes one comma separated line of the game state: the time, player position and direction, ghost position,
+	//					completed stages and state flags, and the door flags. WriteTraceHeader writes the matching column names.
+	// In:				ostream &Trace - the stream to write to, float Time - the game time of this state in seconds
+	// Out:				N/a
+	void WriteTrace(ostream &Trace, float Time) const;
+
+	// Function:		WriteTraceHeader(ostream) - Write Trace Header function
+	// Description:		Writes the comma separated column names of the lines written by WriteTrace
+	// In:				ostream &Trace - the stream to write to
+	// Out:				N/a
+	static void WriteTraceHeader(ostream &Trace);
+
 
 // Private member functions and variables
 private:
-	// Function:		SetUpRoom() - Set Up Room Function
+	// The benchmarks time HitWallOrDoor on its own
+	friend class BenchmarkSuite;
+
+	// Function:		SetUpRoom(RoomLayout, UINT32) - Set Up Room Function
 	// Description:		Set up the map/grid of the room with the walls, obstacles, and the spaces that are free for the player to walk
-	// In:				N/a
+	// In:				const RoomLayout &Layout - the layout, UINT32 RoomIndex - the room of the layout
 	// Out:				N/a
-	void SetUpRoom();
+	void SetUpRoom(const RoomLayout &Layout, UINT32 RoomIndex);
 	
 	// Function:		InitialiseRoomObjects()
 	// Description:		Initialises the Ghost and Critter objects when the intro sounds are finished playing
@@ -211,15 +242,30 @@ private:
 	void OpenDoor();
 
 	// Function:		HitWallOrDoor() - Hit Wall or Door function
-	// Description:		Return true if one step forward will hit a wall/obstacle or exit the door, if the latter then the mDoorExited flag is set.
-	//					Otherwise the collision bools for each type of collision (e.g. collision with the piano) are set to true and the appropriate sound 
-	//					is played.
+	// Description:		Return true if one step forward will hit a wall/obstacle or exit the door, if the latter then the mDoorTry flag is set.
+	//					If it will hit an obstacle, mCollisionValue is set to the obstacle's value so the appropriate sound is played.
 	// In:				N/a
 	// Out:				Bool - true or false based on if the player has hit a wall or an object (true)
 	bool HitWallOrDoor();
 
-	// The 2D Array grid for the room's layout
-	float mRoomBase[ROOM_X_SIZE][ROOM_Z_SIZE];
+	// Function:		UpdateListenerMotion() - Update Listener Motion function
+	// Description:		Moves the player's listener along any move or turn in progress. While it is moving the emitters are updated
+	//					at EMITTER_CONTROL_RATE rather than every frame, with a final update when the move or turn finishes.
+	// In:				N/a
+	// Out:				N/a
+	void UpdateListenerMotion();
+
+	// Function:		UpdateEmitters() - Update Emitters function
+	// Description:		Updates the outdoor, ghost and critter emitters for the player listener's current position and orientation
+	// In:				N/a
+	// Out:				N/a
+	void UpdateEmitters();
+
+	// The grid for the room's layout
+	RoomGrid mRoomGrid;
+
+	// Finds the ghost's and critters' paths round the walls and obstacles of the grid
+	PathFinder mPathFinder;
 
 	// The player object, which has the X3DAudio listener object.
 	Player *mPlayer;
@@ -230,16 +276,14 @@ private:
 	// The MovingCritter object, which handles the dynamic movement of the rats and bats within the scene
 	MovingCritter *mCritters;
 
+	// The swarm of critters added to the room, NULL if none, and the room's seed for its random generator
+	CritterSwarm *mSwarm;
+	unsigned int mSwarmSeed;
+
 	// Positions needed for the class
 	X3DAUDIO_VECTOR mDoorPosition;
 	X3DAUDIO_VECTOR mOutsideSoundPosition;
 
-	// Collidable Objects needed for placing the obstacles within the grid
-	CollidableObject mPianoObject;
-	CollidableObject mTypewriterObject;
-	CollidableObject mTableObject;
-	CollidableObject mRadioObject;
-
 	// Bool to check if the room has been initialised
 	bool mInitialised;
 
@@ -252,29 +296,31 @@ private:
 	// Bool used when door can't be exited yet
 	bool mDoorTry;
 	
-	// Tell Player when they have bumped into specific objects
-	bool mPianoCollision;
-	bool mRadioCollision;
-	bool mTypeWriterCollision;
-	bool mTableCollision;
+	// The value of the obstacle the player has bumped into; NORMAL_FLOOR_VALUE if none
+	BYTE mCollisionValue;
 
 	// XASound objects for all sounds needed for the game
 	XASound *mHitWallSound;
 	XASound *mHitDoorSound;
 	XASound *mAmbientMusic;
 	XASound *mDoorOpenSound;
-	XASound *mTableCollisionSound;
-	XASound *mPianoCollisionSound;
-	XASound *mRadioCollisionSound;
-	XASound *mTypeWriterCollisionSound;
 	XASound *mForestSound;
 
+	// The sound played on bumping into each type of obstacle, indexed by its grid value; mHitWallSound if the layout gives none
+	XASound *mCollisionSounds[CELL_VALUE_COUNT];
+
 	// Pointer list of all XASound objects in the room so they can be interacted with
 	list<XASound*> mRoomSounds;
 
 	// Emitter for sound outside of the room
 	Emitter *mOutdoorEmitter;
 
+	// The other emitters placed in the room by its layout
+	list<Emitter*> mLayoutEmitters;
+
+	// Timer for the emitter updates made while the listener moves
+	GameTimer *mControlTimer;
+
 	// True when the door is open
 	bool mDoorOpen;
 
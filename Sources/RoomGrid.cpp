@@ -0,0 +1,216 @@
+/*
+	File:	RoomGrid.cpp
+	Version:	1.1
+	Date:	18th October 2026
+	Author:	agent
+
+	Exposes:	Implementation of the RoomGrid class.
+	Requires:	N/a
+
+	Description:
+	The map of a room as a tiled grid of cell values with a collision layer.
+	*	See RoomGrid.hpp for details.
+*/
+
+// System includes.
+#include <Windows.h>
+#include <cmath>
+#include <cfloat>
+#include <vector>
+using std::vector;
+
+// Application includes.
+#include "RoomGrid.hpp"
+
+
+
+// Function:		RoomGrid() - RoomGrid constructor
+// Description:		Creates an empty grid; Resize sets its size
+// In:				N/a
+// Out:				N/a
+RoomGrid::RoomGrid()
+	: mWidth(0), mDepth(0), mTilesX(0)
+{
+}
+// End RoomGrid constructor
+
+
+
+// Function:		RoomGrid(int, int) - RoomGrid constructor
+// Description:		Creates a grid of the given size with every cell floor; the grid is empty if the size is invalid
+// In:				int Width - cells along the x axis, int Depth - cells along the z axis
+// Out:				N/a
+RoomGrid::RoomGrid(int Width, int Depth)
+	: mWidth(0), mDepth(0), mTilesX(0)
+{
+	Resize(Width, Depth);
+}
+// End RoomGrid constructor
+
+
+
+// Function:		Resize(int, int) - Resize function
+// Description:		Sets the size of the grid and sets every cell to floor
+// In:				int Width - cells along the x axis, int Depth - cells along the z axis
+// Out:				bool - false if either size is less than 1 or more than ROOM_GRID_MAX_SIZE; the grid is then left unchanged
+bool RoomGrid::Resize(int Width, int Depth)
+{
+	if ((Width < 1) || (Depth < 1) || (Width > ROOM_GRID_MAX_SIZE) || (Depth > ROOM_GRID_MAX_SIZE))
+	{
+		return false;
+	}
+
+	// Whole tiles are stored, so a grid that isn't a multiple of the tile size has tiles overhanging its far edges
+	mWidth = Width;
+	mDepth = Depth;
+	mTilesX = size_t((Width + ROOM_GRID_TILE_MASK) >> ROOM_GRID_TILE_BITS);
+	size_t TilesZ = size_t((Depth + ROOM_GRID_TILE_MASK) >> ROOM_GRID_TILE_BITS);
+	size_t Tiles = mTilesX * TilesZ;
+
+	// Replace the storage rather than resizing it, so a smaller grid gives the memory back
+	vector<BYTE>(Tiles * ROOM_GRID_TILE_SIZE * ROOM_GRID_TILE_SIZE, BYTE(NORMAL_FLOOR_VALUE)).swap(mCells);
+	vector<WORD>(Tiles * ROOM_GRID_TILE_SIZE, WORD(0)).swap(mBlocked);
+	return true;
+}
+// End Resize function
+
+
+
+// Function:		SetCell(int, int, BYTE) - Set Cell function
+// Description:		Sets the value of a cell and its collision bit; no effect if the cell is outside the grid
+// In:				int X, int Z - the cell, BYTE Value - the value
+// Out:				N/a
+void RoomGrid::SetCell(int X, int Z, BYTE Value)
+{
+	if (!InGrid(X, Z))
+	{
+		return;
+	}
+	mCells[CellIndex(X, Z)] = Value;
+
+	WORD Bit = WORD(1 << (X & ROOM_GRID_TILE_MASK));
+	if (Value == NORMAL_FLOOR_VALUE)
+	{
+		mBlocked[RowIndex(X, Z)] &= WORD(~Bit);
+	}
+	else
+	{
+		mBlocked[RowIndex(X, Z)] |= Bit;
+	}
+}
+// End SetCell function
+
+
+
+// Function:		FillRect(int, int, int, int, BYTE) - Fill Rectangle function
+// Description:		Sets the value of every cell in a rectangle, clipped to the grid
+// In:				int MinX, int MinZ - the first corner, int MaxX, int MaxZ - the opposite corner, inclusive, BYTE Value - the value
+// Out:				N/a
+void RoomGrid::FillRect(int MinX, int MinZ, int MaxX, int MaxZ, BYTE Value)
+{
+	// Clip the rectangle to the grid
+	if (MinX < 0) { MinX = 0; }
+	if (MinZ < 0) { MinZ = 0; }
+	if (MaxX > mWidth - 1) { MaxX = mWidth - 1; }
+	if (MaxZ > mDepth - 1) { MaxZ = mDepth - 1; }
+
+	for (int Z = MinZ; Z <= MaxZ; Z++)
+	{
+		for (int X = MinX; X <= MaxX; X++)
+		{
+			SetCell(X, Z, Value);
+		}
+	}
+}
+// End FillRect function
+
+
+
+// Function:		IsLineClear(float, float, float, float) - Is Line Clear function
+// Description:		Checks the cells a straight line passes through, in order, for any that are blocked; where the line
+//					crosses a corner of four cells, both cells beside the corner must be free, as for PathFinder's diagonal steps
+// In:				float FromX, float FromZ - the start, float ToX, float ToZ - the end; in cells, so cell (x, z) runs from
+//					(x, z) to (x + 1, z + 1)
+// Out:				bool - true if none of the cells is blocked
+bool RoomGrid::IsLineClear(float FromX, float FromZ, float ToX, float ToZ) const
+{
+	int X = int(floorf(FromX));
+	int Z = int(floorf(FromZ));
+	const int EndX = int(floorf(ToX));
+	const int EndZ = int(floorf(ToZ));
+	if (IsBlocked(X, Z))
+	{
+		return false;
+	}
+
+	// The fraction of the line at which it next crosses a cell edge along each axis, and the fraction between crossings
+	const float DeltaX = ToX - FromX;
+	const float DeltaZ = ToZ - FromZ;
+	const int StepX = (EndX > X) ? 1 : -1;
+	const int StepZ = (EndZ > Z) ? 1 : -1;
+	float NextX = FLT_MAX;
+	float NextZ = FLT_MAX;
+	float EveryX = FLT_MAX;
+	float EveryZ = FLT_MAX;
+	if (EndX != X)
+	{
+		NextX = ((StepX > 0) ? (float(X + 1) - FromX) : (FromX - float(X))) / fabsf(DeltaX);
+		EveryX = 1.0f / fabsf(DeltaX);
+	}
+	if (EndZ != Z)
+	{
+		NextZ = ((StepZ > 0) ? (float(Z + 1) - FromZ) : (FromZ - float(Z))) / fabsf(DeltaZ);
+		EveryZ = 1.0f / fabsf(DeltaZ);
+	}
+
+	// Crossings within a thousandth of a cell of each other are taken as the line going through the corner, as rounding,
+	// here or in whatever moves along the line, could put it on either side
+	const float Longest = (fabsf(DeltaX) > fabsf(DeltaZ)) ? fabsf(DeltaX) : fabsf(DeltaZ);
+	const float Margin = (Longest > 0.0f) ? 0.001f / Longest : 0.0f;
+
+	// Step to whichever edge comes first until the end cell is reached; an axis that has reached its end isn't stepped
+	// again, so rounding can't carry the walk past the end
+	while ((X != EndX) || (Z != EndZ))
+	{
+		if ((Z == EndZ) || ((X != EndX) && (NextX < NextZ - Margin)))
+		{
+			X += StepX;
+			NextX += EveryX;
+		}
+		else if ((X == EndX) || (NextZ < NextX - Margin))
+		{
+			Z += StepZ;
+			NextZ += EveryZ;
+		}
+		else
+		{
+			// Through the corner: both cells beside it must be free
+			if (IsBlocked(X + StepX, Z) || IsBlocked(X, Z + StepZ))
+			{
+				return false;
+			}
+			X += StepX;
+			Z += StepZ;
+			NextX += EveryX;
+			NextZ += EveryZ;
+		}
+		if (IsBlocked(X, Z))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+// End IsLineClear function
+
+
+
+// Function:		GetMemoryUsed() - Get Memory Used function
+// Description:		Works out the memory the grid takes, including the tiles that overhang the edges of the grid
+// In:				N/a
+// Out:				size_t - the bytes used
+size_t RoomGrid::GetMemoryUsed() const
+{
+	return sizeof(RoomGrid) + mCells.capacity() * sizeof(BYTE) + mBlocked.capacity() * sizeof(WORD);
+}
+// End GetMemoryUsed function
@@ -0,0 +1,164 @@
+/*
+	File:	RoomGrid.hpp
+	Version:	1.1
+	Date:	18th October 2026
+	Author:	agent
+
+	Exposes:	RoomGrid, the grid cell values.
+	Requires:	N/a
+
+	Description:
+	The map of a room: a grid of cells, each holding a one byte value saying what is in it (floor, wall, door or an obstacle),
+	with a separate collision layer of one bit per cell that is set for every cell that isn't floor.
+
+	*	the size is set when the grid is created or resized, up to ROOM_GRID_MAX_SIZE cells along each axis;
+	*	the cells are stored in square tiles of ROOM_GRID_TILE_SIZE by ROOM_GRID_TILE_SIZE cells, tile after tile, so cells that are
+		near each other in the room are near each other in memory whichever direction is being searched, and a tile's values
+		fit in a few cache lines; the collision bits of a tile are stored together in the same way;
+	*	a cell is looked up with a single indexed load; cells outside the grid read as walls and are blocked,
+		so a search can step off the edge without checking the bounds first;
+	*	a straight line across the grid can be checked for walls and obstacles, for actors that move in straight lines
+		rather than along paths.
+
+	A 16 by 16 room takes 256 bytes of values and 32 bytes of collision bits; a 4096 by 4096 map takes 16MB and 2MB.
+*/
+
+// Define the class
+#ifndef __ROOMGRID_HPP__
+#define __ROOMGRID_HPP__
+
+// System includes.
+#include <Windows.h>
+#include <vector>
+using std::vector;
+
+// Define the values to be used within the grid to identify what is within the maps space
+#define NORMAL_FLOOR_VALUE 0
+#define WALL_VALUE 1
+#define DOOR_VALUE 2
+#define TABLE_VALUE 3
+#define PIANO_VALUE 4
+#define RADIO_VALUE 5
+#define TYPEWRITER_VALUE 6
+
+// The number of cell values
+#define CELL_VALUE_COUNT 7
+
+// The largest grid, in cells along each axis
+#define ROOM_GRID_MAX_SIZE 4096
+
+// Tiles are ROOM_GRID_TILE_SIZE cells square; the size is a power of 2 so a cell's tile and place in it are found with shifts and masks
+#define ROOM_GRID_TILE_BITS 4
+#define ROOM_GRID_TILE_SIZE (1 << ROOM_GRID_TILE_BITS)
+#define ROOM_GRID_TILE_MASK (ROOM_GRID_TILE_SIZE - 1)
+
+// The RoomGrid class
+class RoomGrid
+{
+// Public Member functions and variables
+public:
+
+	// Function:		RoomGrid() - RoomGrid constructor
+	// Description:		Creates an empty grid; Resize sets its size
+	// In:				N/a
+	// Out:				N/a
+	RoomGrid();
+
+	// Function:		RoomGrid(int, int) - RoomGrid constructor
+	// Description:		Creates a grid of the given size with every cell floor; the grid is empty if the size is invalid
+	// In:				int Width - cells along the x axis, int Depth - cells along the z axis
+	// Out:				N/a
+	RoomGrid(int Width, int Depth);
+
+	// Function:		Resize(int, int) - Resize function
+	// Description:		Sets the size of the grid and sets every cell to floor
+	// In:				int Width - cells along the x axis, int Depth - cells along the z axis
+	// Out:				bool - false if either size is less than 1 or more than ROOM_GRID_MAX_SIZE; the grid is then left unchanged
+	bool Resize(int Width, int Depth);
+
+	// Function:		GetCell(int, int) - Get Cell function
+	// Description:		Gets the value of a cell
+	// In:				int X, int Z - the cell
+	// Out:				BYTE - the cell's value; WALL_VALUE if the cell is outside the grid
+	inline BYTE GetCell(int X, int Z) const
+	{
+		return InGrid(X, Z) ? mCells[CellIndex(X, Z)] : BYTE(WALL_VALUE);
+	}
+
+	// Function:		IsBlocked(int, int) - Is Blocked function
+	// Description:		Reads a cell's collision bit
+	// In:				int X, int Z - the cell
+	// Out:				bool - true if the cell isn't floor, or is outside the grid
+	inline bool IsBlocked(int X, int Z) const
+	{
+		return (!InGrid(X, Z)) || (((mBlocked[RowIndex(X, Z)] >> (X & ROOM_GRID_TILE_MASK)) & 1) != 0);
+	}
+
+	// Function:		SetCell(int, int, BYTE) - Set Cell function
+	// Description:		Sets the value of a cell and its collision bit; no effect if the cell is outside the grid
+	// In:				int X, int Z - the cell, BYTE Value - the value
+	// Out:				N/a
+	void SetCell(int X, int Z, BYTE Value);
+
+	// Function:		FillRect(int, int, int, int, BYTE) - Fill Rectangle function
+	// Description:		Sets the value of every cell in a rectangle, clipped to the grid
+	// In:				int MinX, int MinZ - the first corner, int MaxX, int MaxZ - the opposite corner, inclusive, BYTE Value - the value
+	// Out:				N/a
+	void FillRect(int MinX, int MinZ, int MaxX, int MaxZ, BYTE Value);
+
+	// Function:		IsLineClear(float, float, float, float) - Is Line Clear function
+	// Description:		Checks the cells a straight line passes through, in order, for any that are blocked; where the line
+	//					crosses a corner of four cells, both cells beside the corner must be free, as for PathFinder's diagonal steps
+	// In:				float FromX, float FromZ - the start, float ToX, float ToZ - the end; in cells, so cell (x, z) runs from
+	//					(x, z) to (x + 1, z + 1)
+	// Out:				bool - true if none of the cells is blocked
+	bool IsLineClear(float FromX, float FromZ, float ToX, float ToZ) const;
+
+	// Function:		InGrid(int, int) - In Grid function
+	// Description:		Checks a cell is inside the grid
+	// In:				int X, int Z - the cell
+	// Out:				bool - true if the cell is inside the grid
+	inline bool InGrid(int X, int Z) const
+	{
+		// Negative values become large unsigned values, so one comparison checks both ends
+		return (unsigned int)(X) < (unsigned int)(mWidth) && (unsigned int)(Z) < (unsigned int)(mDepth);
+	}
+
+	// Function:		GetMemoryUsed() - Get Memory Used function
+	// Description:		Works out the memory the grid takes, including the tiles that overhang the edges of the grid
+	// In:				N/a
+	// Out:				size_t - the bytes used
+	size_t GetMemoryUsed() const;
+
+	inline int GetWidth() const { return mWidth; }
+	inline int GetDepth() const { return mDepth; }
+
+// Private member functions and variables
+private:
+
+	// The index of a cell's value; the tile's values come first, then the cell's row and column within the tile
+	inline size_t CellIndex(int X, int Z) const
+	{
+		size_t Tile = size_t(Z >> ROOM_GRID_TILE_BITS) * mTilesX + size_t(X >> ROOM_GRID_TILE_BITS);
+		return (Tile << (2 * ROOM_GRID_TILE_BITS)) | (size_t(Z & ROOM_GRID_TILE_MASK) << ROOM_GRID_TILE_BITS) | size_t(X & ROOM_GRID_TILE_MASK);
+	}
+
+	// The index of the collision bits of a cell's row within its tile; the cell's bit is its column within the tile
+	inline size_t RowIndex(int X, int Z) const
+	{
+		size_t Tile = size_t(Z >> ROOM_GRID_TILE_BITS) * mTilesX + size_t(X >> ROOM_GRID_TILE_BITS);
+		return (Tile << ROOM_GRID_TILE_BITS) | size_t(Z & ROOM_GRID_TILE_MASK);
+	}
+
+	// Size in cells, and in tiles along the x axis
+	int mWidth;
+	int mDepth;
+	size_t mTilesX;
+
+	// The cell values and the collision bits, tile by tile; each tile row's bits are held in one WORD
+	vector<BYTE> mCells;
+	vector<WORD> mBlocked;
+};
+// end RoomGrid class.
+
+#endif
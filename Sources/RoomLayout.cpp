@@ -0,0 +1,652 @@
+/*
+	File:	RoomLayout.cpp
+	Version:	1.0
+	Date:	18th October 2026
+	Author:	agent
+
+	Exposes:	Implementation of the RoomLayout class.
+	Requires:	RoomGrid, DistanceCurves (for the EmitterType values).
+
+	Description:
+	Loads, parses and saves the layouts of the rooms, and fills a room's grid from its layout.
+	*	See RoomLayout.hpp for details and the text and binary formats.
+*/
+
+// System includes.
+#include <Windows.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <sstream>
+#include <fstream>
+#include <cstring>
+using std::string;
+using std::vector;
+using std::map;
+using std::istringstream;
+using std::ostringstream;
+using std::ofstream;
+using std::ios;
+
+// Application includes.
+#include "RoomLayout.hpp"
+#include "DistanceCurves.hpp"
+
+// Anonymous namespace for the format constants and the parsing helpers
+namespace
+{
+	// The tag at the start of a binary layout
+	const char LayoutTag[4] = { 'G', 'E', 'R', 'L' };
+
+	// The original Ghost Escape room, as set up in code by Room::SetUpRoom and Ghost::SetUpGhost before layouts were used
+	const char DefaultLayoutText[] =
+		"# The Ghost Escape room\n"
+		"room GhostEscape 16 16\n"
+		"door 8 0\n"
+		"emitter outdoor 8 -1.5 Sounds/OutdoorSound.wav\n"
+		"obstacle piano 2 14 4 4 Sounds/PianoCollision.wav\n"
+		"obstacle typewriter 2 2 2 2 Sounds/TypewriterCollision.wav\n"
+		"obstacle radio 13 9 2 2 Sounds/RadioCollision.wav\n"
+		"obstacle table 8 9 2 4 Sounds/TableCollision.wav\n"
+		"stage knocking 8 0 Sounds/KnockingSound.wav\n"
+		"stage piano 2 14 Sounds/PianoMusic.wav\n"
+		"stage typewriter 2 2 Sounds/typewriter.wav\n"
+		"stage radio 13 9 Sounds/RadioSound.wav\n";
+
+	// The names used for the types in the text form
+	struct NamedValue
+	{
+		const char *Name;
+		BYTE Value;
+	};
+
+	const NamedValue ObstacleTypes[] = {
+		{ "wall", WALL_VALUE }, { "table", TABLE_VALUE }, { "piano", PIANO_VALUE },
+		{ "radio", RADIO_VALUE }, { "typewriter", TYPEWRITER_VALUE }
+	};
+
+	// In the order of Ghost's GhostState values
+	const NamedValue StageTypes[] = {
+		{ "knocking", 0 }, { "piano", 1 }, { "typewriter", 2 }, { "radio", 3 }
+	};
+
+	const NamedValue EmitterTypes[] = {
+		{ "ghost", GHOST_EMITTER }, { "event", EVENT_EMITTER }, { "critter", CRITTER_EMITTER }, { "outdoor", OUTDOOR_EMITTER }
+	};
+
+	// Finds the value of a type's name; returns false if the name isn't in the table
+	template <size_t Count>
+	bool FindValue(const NamedValue (&Table)[Count], const string &Name, BYTE &Value)
+	{
+		for (size_t i = 0; i < Count; i++)
+		{
+			if (Name == Table[i].Name)
+			{
+				Value = Table[i].Value;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Adds a string to the strings of a layout being built, once however often it is used; returns its offset
+	UINT32 AddString(const string &Text, vector<char> &Strings, map<string, UINT32> &Offsets)
+	{
+		if (Text.empty())
+		{
+			return 0;
+		}
+		map<string, UINT32>::const_iterator Found = Offsets.find(Text);
+		if (Found != Offsets.end())
+		{
+			return Found->second;
+		}
+		UINT32 Offset = UINT32(Strings.size());
+		Strings.insert(Strings.end(), Text.begin(), Text.end());
+		Strings.push_back('\0');
+		Offsets[Text] = Offset;
+		return Offset;
+	}
+
+	// Copies a run of records into a binary layout being built, returning the position after them
+	template <typename Record>
+	size_t CopyRecords(const vector<Record> &Records, vector<BYTE> &Image, size_t Position)
+	{
+		if (!Records.empty())
+		{
+			memcpy(&Image[Position], &Records[0], Records.size() * sizeof(Record));
+		}
+		return Position + Records.size() * sizeof(Record);
+	}
+}
+// end anonymous namespace.
+
+
+
+// Function:		RoomLayout() - RoomLayout constructor
+// Description:		Creates an empty layout
+// In:				N/a
+// Out:				N/a
+RoomLayout::RoomLayout()
+	: mFile(INVALID_HANDLE_VALUE), mMapping(NULL), mView(NULL), mHeader(NULL), mRooms(NULL), mObstacles(NULL), mStages(NULL),
+	mEmitters(NULL), mStrings(NULL)
+{
+}
+// End RoomLayout constructor
+
+
+
+// Function:		~RoomLayout() - RoomLayout destructor
+// Description:		Unmaps the binary file, if one is loaded
+// In:				N/a
+// Out:				N/a
+RoomLayout::~RoomLayout()
+{
+	Clear();
+}
+// End RoomLayout destructor
+
+
+
+// Function:		Load(string) - Load function
+// Description:		Loads a layout from a text or binary file; a binary file is mapped into memory and used in place
+// In:				const string &FileName - the file
+// Out:				bool - false if the file could not be read or isn't a valid layout; GetError() says why, and the layout is empty
+bool RoomLayout::Load(const string &FileName)
+{
+	Clear();
+	mError.clear();
+
+	mFile = CreateFile(FileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (mFile == INVALID_HANDLE_VALUE)
+	{
+		mError = FileName + ": could not be opened";
+		return false;
+	}
+	LARGE_INTEGER FileSize;
+	if ((!GetFileSizeEx(mFile, &FileSize)) || (FileSize.QuadPart <= 0) || (FileSize.QuadPart > LONGLONG(0xFFFFFFFF)))
+	{
+		Clear();
+		mError = FileName + ": is empty or too large";
+		return false;
+	}
+	mMapping = CreateFileMapping(mFile, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mMapping != NULL)
+	{
+		mView = MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0);
+	}
+	if (mView == NULL)
+	{
+		Clear();
+		mError = FileName + ": could not be mapped";
+		return false;
+	}
+
+	const BYTE *Data = (const BYTE*)mView;
+	size_t Size = size_t(FileSize.QuadPart);
+
+	// A binary layout is used where it is mapped
+	if ((Size >= sizeof(LayoutTag)) && (memcmp(Data, LayoutTag, sizeof(LayoutTag)) == 0))
+	{
+		if (!Attach(Data, Size))
+		{
+			Clear();
+			mError = FileName + ": " + mError;
+			return false;
+		}
+		return true;
+	}
+
+	// Anything else is text, parsed into a binary layout of its own
+	string Text((const char*)Data, Size);
+	Clear();
+	if (!Parse(Text))
+	{
+		mError = FileName + ", " + mError;
+		return false;
+	}
+	return true;
+}
+// End Load function
+
+
+
+// Function:		Parse(string) - Parse function
+// Description:		Reads a layout from its text form
+// In:				const string &Text - the text
+// Out:				bool - false if the text isn't a valid layout; GetError() gives the line and the reason, and the layout is empty
+bool RoomLayout::Parse(const string &Text)
+{
+	Clear();
+	mError.clear();
+
+	vector<LayoutRoom> Rooms;
+	vector<LayoutObstacle> Obstacles;
+	vector<LayoutStage> Stages;
+	vector<LayoutEmitter> Emitters;
+	vector<char> Strings(1, '\0');
+	map<string, UINT32> StringOffsets;
+
+	// The current room's stages, added to the layout in stage order when the room is finished
+	LayoutStage RoomStages[LAYOUT_STAGE_COUNT];
+	bool StageSet[LAYOUT_STAGE_COUNT];
+	memset(RoomStages, 0, sizeof(RoomStages));
+	memset(StageSet, 0, sizeof(StageSet));
+
+	istringstream Lines(Text);
+	string Line;
+	int LineNumber = 0;
+	ostringstream Error;
+	while (Error.str().empty())
+	{
+		bool EndOfText = !std::getline(Lines, Line);
+		LineNumber++;
+		istringstream Fields(Line);
+		string Record;
+		if ((!EndOfText) && ((!(Fields >> Record)) || (Record[0] == '#')))
+		{
+			continue;
+		}
+
+		// Finish the previous room when the next starts or the text ends
+		if ((EndOfText || (Record == "room")) && (!Rooms.empty()))
+		{
+			for (int Stage = 0; Stage < LAYOUT_STAGE_COUNT; Stage++)
+			{
+				if (!StageSet[Stage])
+				{
+					Error << "room " << &Strings[Rooms.back().Name] << " has no " << StageTypes[Stage].Name << " stage";
+					break;
+				}
+				Stages.push_back(RoomStages[Stage]);
+			}
+		}
+		if (EndOfText || (!Error.str().empty()))
+		{
+			break;
+		}
+
+		string TypeName;
+		string Sound;
+		if (Record == "room")
+		{
+			string Name;
+			LayoutRoom Room;
+			memset(&Room, 0, sizeof(Room));
+			if ((!(Fields >> Name >> Room.Width >> Room.Depth)) || (Room.Width < 1) || (Room.Depth < 1)
+				|| (Room.Width > ROOM_GRID_MAX_SIZE) || (Room.Depth > ROOM_GRID_MAX_SIZE))
+			{
+				Error << "line " << LineNumber << ": expected room <name> <width> <depth>, each size 1 to " << ROOM_GRID_MAX_SIZE;
+				break;
+			}
+			Room.Name = AddString(Name, Strings, StringOffsets);
+			Room.FirstObstacle = UINT32(Obstacles.size());
+			Room.FirstStage = UINT32(Stages.size());
+			Room.FirstEmitter = UINT32(Emitters.size());
+			Rooms.push_back(Room);
+			memset(StageSet, 0, sizeof(StageSet));
+		}
+		else if (Rooms.empty())
+		{
+			Error << "line " << LineNumber << ": " << Record << " before the first room";
+			break;
+		}
+		else if (Record == "door")
+		{
+			if (!(Fields >> Rooms.back().DoorX >> Rooms.back().DoorZ))
+			{
+				Error << "line " << LineNumber << ": expected door <x> <z>";
+				break;
+			}
+		}
+		else if (Record == "obstacle")
+		{
+			LayoutObstacle Obstacle;
+			memset(&Obstacle, 0, sizeof(Obstacle));
+			if ((!(Fields >> TypeName >> Obstacle.X >> Obstacle.Z >> Obstacle.Width >> Obstacle.Depth))
+				|| (!FindValue(ObstacleTypes, TypeName, Obstacle.Value)))
+			{
+				Error << "line " << LineNumber << ": expected obstacle <wall|table|piano|radio|typewriter> <x> <z> <width> <depth> [sound]";
+				break;
+			}
+			Fields >> Sound;
+			Obstacle.Sound = AddString(Sound, Strings, StringOffsets);
+			Obstacles.push_back(Obstacle);
+			Rooms.back().ObstacleCount++;
+		}
+		else if (Record == "stage")
+		{
+			LayoutStage Stage;
+			memset(&Stage, 0, sizeof(Stage));
+			if ((!(Fields >> TypeName >> Stage.X >> Stage.Z)) || (!FindValue(StageTypes, TypeName, Stage.Stage)))
+			{
+				Error << "line " << LineNumber << ": expected stage <knocking|piano|typewriter|radio> <x> <z> [sound]";
+				break;
+			}
+			if (StageSet[Stage.Stage])
+			{
+				Error << "line " << LineNumber << ": the room already has a " << TypeName << " stage";
+				break;
+			}
+			Fields >> Sound;
+			Stage.Sound = AddString(Sound, Strings, StringOffsets);
+			RoomStages[Stage.Stage] = Stage;
+			StageSet[Stage.Stage] = true;
+		}
+		else if (Record == "emitter")
+		{
+			LayoutEmitter Placed;
+			memset(&Placed, 0, sizeof(Placed));
+			if ((!(Fields >> TypeName >> Placed.X >> Placed.Z >> Sound)) || (!FindValue(EmitterTypes, TypeName, Placed.Type)))
+			{
+				Error << "line " << LineNumber << ": expected emitter <outdoor|ghost|event|critter> <x> <z> <sound>";
+				break;
+			}
+			Placed.Sound = AddString(Sound, Strings, StringOffsets);
+			Emitters.push_back(Placed);
+			Rooms.back().EmitterCount++;
+		}
+		else
+		{
+			Error << "line " << LineNumber << ": unknown record " << Record;
+			break;
+		}
+
+		// Anything left on the line is a mistake, e.g. a sound file name with a space in it
+		string Extra;
+		if (Fields >> Extra)
+		{
+			Error << "line " << LineNumber << ": unexpected " << Extra;
+		}
+	}
+
+	if ((Error.str().empty()) && (Rooms.empty()))
+	{
+		Error << "no rooms";
+	}
+	if (!Error.str().empty())
+	{
+		mError = Error.str();
+		return false;
+	}
+
+	// Build the binary layout, in the order it is written to a file
+	UINT64 Size = sizeof(RoomLayoutHeader) + Rooms.size() * sizeof(LayoutRoom) + Obstacles.size() * sizeof(LayoutObstacle)
+		+ Stages.size() * sizeof(LayoutStage) + Emitters.size() * sizeof(LayoutEmitter) + Strings.size();
+	if (Size > 0xFFFFFFFF)
+	{
+		mError = "the layout is larger than 4GB";
+		return false;
+	}
+
+	RoomLayoutHeader Header;
+	memcpy(Header.Tag, LayoutTag, sizeof(LayoutTag));
+	Header.Version = ROOM_LAYOUT_VERSION;
+	Header.FileSize = UINT32(Size);
+	Header.RoomCount = UINT32(Rooms.size());
+	Header.ObstacleCount = UINT32(Obstacles.size());
+	Header.StageCount = UINT32(Stages.size());
+	Header.EmitterCount = UINT32(Emitters.size());
+	Header.StringBytes = UINT32(Strings.size());
+
+	vector<BYTE> Image((size_t)Size);
+	memcpy(&Image[0], &Header, sizeof(Header));
+	size_t Position = sizeof(Header);
+	Position = CopyRecords(Rooms, Image, Position);
+	Position = CopyRecords(Obstacles, Image, Position);
+	Position = CopyRecords(Stages, Image, Position);
+	Position = CopyRecords(Emitters, Image, Position);
+	CopyRecords(Strings, Image, Position);
+
+	mImage.swap(Image);
+	return Attach(&mImage[0], mImage.size());
+}
+// End Parse function
+
+
+
+// Function:		Save(string) - Save function
+// Description:		Writes the layout in its binary form
+// In:				const string &FileName - the file
+// Out:				bool - false if the layout is empty or the file could not be written
+bool RoomLayout::Save(const string &FileName) const
+{
+	if (mHeader == NULL)
+	{
+		return false;
+	}
+	ofstream File(FileName.c_str(), ios::binary);
+	if (!File.is_open())
+	{
+		return false;
+	}
+	File.write((const char*)mHeader, mHeader->FileSize);
+	File.close();
+	return !File.fail();
+}
+// End Save function
+
+
+
+// Function:		Rasterize(UINT32, RoomGrid) - Rasterize function
+// Description:		Sizes the grid for a room and fills in its walls, door and obstacles, as Room::SetUpRoom did; the grid is indexed
+//					at room position - 1, and each obstacle covers the cells from its position less half its size
+// In:				UINT32 Room - the room, RoomGrid &Grid - the grid to fill
+// Out:				bool - false if there is no such room
+bool RoomLayout::Rasterize(UINT32 Room, RoomGrid &Grid) const
+{
+	if (Room >= GetRoomCount())
+	{
+		return false;
+	}
+	const LayoutRoom &TheRoom = mRooms[Room];
+
+	// Each cell in the grid represents 1.0 on the map
+	// Size the grid for the room, which sets every cell to the NORMAL_FLOOR_VALUE to indicate it is free space
+	if (!Grid.Resize(int(TheRoom.Width), int(TheRoom.Depth)))
+	{
+		return false;
+	}
+	int LastX = Grid.GetWidth() - 1;
+	int LastZ = Grid.GetDepth() - 1;
+
+	// Set the values of the cells at the outer edges of the grid to the WALL_VALUE; these are the walls around the room
+	Grid.FillRect(0, 0, LastX, 0, WALL_VALUE);
+	Grid.FillRect(0, LastZ, LastX, LastZ, WALL_VALUE);
+	Grid.FillRect(0, 0, 0, LastZ, WALL_VALUE);
+	Grid.FillRect(LastX, 0, LastX, LastZ, WALL_VALUE);
+
+	// The door is 3 cells wide, centred on the cell at its position
+	int DoorX = int(TheRoom.DoorX);
+	int DoorZ = int(TheRoom.DoorZ);
+	Grid.FillRect(DoorX - 1, DoorZ, DoorX + 1, DoorZ, DOOR_VALUE);
+
+	// Fill in the cells from the bottom left of each obstacle to the top right with its value, in the order they were given
+	const LayoutObstacle *Obstacles = GetObstacles(Room);
+	for (UINT32 i = 0; i < TheRoom.ObstacleCount; i++)
+	{
+		const LayoutObstacle &Obstacle = Obstacles[i];
+		float HalfWidth = float(int(0.5f * Obstacle.Width));
+		float HalfDepth = float(int(0.5f * Obstacle.Depth));
+		Grid.FillRect(int(Obstacle.X - HalfWidth), int(Obstacle.Z - HalfDepth),
+			int((Obstacle.X + HalfWidth) - 1), int((Obstacle.Z + HalfDepth) - 1), Obstacle.Value);
+	}
+	return true;
+}
+// End Rasterize function
+
+
+
+// Function:		FindEmitter(UINT32, BYTE) - Find Emitter function
+// Description:		Finds the first emitter of a type in a room
+// In:				UINT32 Room - the room, BYTE Type - the EmitterType
+// Out:				const LayoutEmitter* - the emitter; NULL if the room has none of the type
+const LayoutEmitter* RoomLayout::FindEmitter(UINT32 Room, BYTE Type) const
+{
+	if (Room >= GetRoomCount())
+	{
+		return NULL;
+	}
+	const LayoutEmitter *Emitters = GetEmitters(Room);
+	for (UINT32 i = 0; i < mRooms[Room].EmitterCount; i++)
+	{
+		if (Emitters[i].Type == Type)
+		{
+			return &Emitters[i];
+		}
+	}
+	return NULL;
+}
+// End FindEmitter function
+
+
+
+// Function:		GetDefault() - Get Default function
+// Description:		Gives the layout of the original Ghost Escape room, parsed from text held in the code the first time it is asked for
+// In:				N/a
+// Out:				const RoomLayout& - the default layout
+const RoomLayout& RoomLayout::GetDefault()
+{
+	static RoomLayout Default;
+	if (Default.GetRoomCount() == 0)
+	{
+		Default.Parse(DefaultLayoutText);
+	}
+	return Default;
+}
+// End GetDefault function
+
+
+
+// Function:		Attach(BYTE, size_t) - Attach function
+// Description:		Checks the header and records of a binary layout and points the record accessors at them
+// In:				const BYTE *Data - the binary layout, size_t Size - its size in bytes
+// Out:				bool - false if the layout isn't valid
+bool RoomLayout::Attach(const BYTE *Data, size_t Size)
+{
+	// Every record is a multiple of 4 bytes, so records that follow each other from the start of the data stay aligned
+	const RoomLayoutHeader *Header = (const RoomLayoutHeader*)Data;
+	if ((Size < sizeof(RoomLayoutHeader)) || (memcmp(Header->Tag, LayoutTag, sizeof(LayoutTag)) != 0))
+	{
+		mError = "not a binary layout";
+		return false;
+	}
+	if (Header->Version != ROOM_LAYOUT_VERSION)
+	{
+		mError = "unsupported layout version";
+		return false;
+	}
+	UINT64 Expected = sizeof(RoomLayoutHeader) + UINT64(Header->RoomCount) * sizeof(LayoutRoom)
+		+ UINT64(Header->ObstacleCount) * sizeof(LayoutObstacle) + UINT64(Header->StageCount) * sizeof(LayoutStage)
+		+ UINT64(Header->EmitterCount) * sizeof(LayoutEmitter) + UINT64(Header->StringBytes);
+	if ((Header->FileSize != Size) || (Expected != Size))
+	{
+		mError = "the layout is cut short or has the wrong size";
+		return false;
+	}
+
+	const LayoutRoom *Rooms = (const LayoutRoom*)(Data + sizeof(RoomLayoutHeader));
+	const LayoutObstacle *Obstacles = (const LayoutObstacle*)(Rooms + Header->RoomCount);
+	const LayoutStage *Stages = (const LayoutStage*)(Obstacles + Header->ObstacleCount);
+	const LayoutEmitter *Emitters = (const LayoutEmitter*)(Stages + Header->StageCount);
+	const char *Strings = (const char*)(Emitters + Header->EmitterCount);
+
+	// Every string must end within the strings, which it does if they start and end with a 0 and every offset is within them
+	UINT32 StringBytes = Header->StringBytes;
+	if ((StringBytes == 0) || (Strings[0] != '\0') || (Strings[StringBytes - 1] != '\0'))
+	{
+		mError = "the strings are not terminated";
+		return false;
+	}
+
+	// Check each room's runs of records are within the layout; the records are checked once each below
+	for (UINT32 i = 0; i < Header->RoomCount; i++)
+	{
+		const LayoutRoom &Room = Rooms[i];
+		if ((Room.Name >= StringBytes) || (Room.Width < 1) || (Room.Depth < 1) || (Room.Width > ROOM_GRID_MAX_SIZE)
+			|| (Room.Depth > ROOM_GRID_MAX_SIZE)
+			|| (UINT64(Room.FirstObstacle) + Room.ObstacleCount > Header->ObstacleCount)
+			|| (UINT64(Room.FirstStage) + LAYOUT_STAGE_COUNT > Header->StageCount)
+			|| (UINT64(Room.FirstEmitter) + Room.EmitterCount > Header->EmitterCount))
+		{
+			mError = "a room is invalid";
+			return false;
+		}
+		for (UINT32 Stage = 0; Stage < LAYOUT_STAGE_COUNT; Stage++)
+		{
+			if (Stages[Room.FirstStage + Stage].Stage != Stage)
+			{
+				mError = "a room's stages are missing or out of order";
+				return false;
+			}
+		}
+	}
+	for (UINT32 i = 0; i < Header->ObstacleCount; i++)
+	{
+		BYTE Value = Obstacles[i].Value;
+		if ((Obstacles[i].Sound >= StringBytes) || ((Value != WALL_VALUE) && ((Value < TABLE_VALUE) || (Value >= CELL_VALUE_COUNT))))
+		{
+			mError = "an obstacle is invalid";
+			return false;
+		}
+	}
+	for (UINT32 i = 0; i < Header->StageCount; i++)
+	{
+		if (Stages[i].Sound >= StringBytes)
+		{
+			mError = "a stage is invalid";
+			return false;
+		}
+	}
+	for (UINT32 i = 0; i < Header->EmitterCount; i++)
+	{
+		if ((Emitters[i].Sound >= StringBytes) || (Emitters[i].Type >= EMITTER_TYPE_COUNT))
+		{
+			mError = "an emitter is invalid";
+			return false;
+		}
+	}
+
+	mHeader = Header;
+	mRooms = Rooms;
+	mObstacles = Obstacles;
+	mStages = Stages;
+	mEmitters = Emitters;
+	mStrings = Strings;
+	return true;
+}
+// End Attach function
+
+
+
+// Function:		Clear() - Clear function
+// Description:		Empties the layout, unmapping the binary file if one is loaded
+// In:				N/a
+// Out:				N/a
+void RoomLayout::Clear()
+{
+	mHeader = NULL;
+	mRooms = NULL;
+	mObstacles = NULL;
+	mStages = NULL;
+	mEmitters = NULL;
+	mStrings = NULL;
+	vector<BYTE>().swap(mImage);
+
+	if (mView != NULL)
+	{
+		UnmapViewOfFile(mView);
+		mView = NULL;
+	}
+	if (mMapping != NULL)
+	{
+		CloseHandle(mMapping);
+		mMapping = NULL;
+	}
+	if (mFile != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(mFile);
+		mFile = INVALID_HANDLE_VALUE;
+	}
+}
+// End Clear function
@@ -0,0 +1,221 @@
+/*
+	File:	RoomLayout.hpp
+	Version:	1.0
+	Date:	18th October 2026
+	Author:	agent
+
+	Exposes:	RoomLayout, RoomLayoutHeader, LayoutRoom, LayoutObstacle, LayoutStage, LayoutEmitter.
+	Requires:	RoomGrid, DistanceCurves (for the EmitterType values).
+
+	Description:
+	Describes the rooms of the game in a file rather than in code: for each room its grid size, door, obstacles with their
+	footprints and collision sounds, the ghost's stages and their sounds, and the emitters placed in it.
+	Room and Ghost are set up from a room of a layout; GetDefault() gives the original Ghost Escape room.
+
+	A layout is written as text and can be compiled to a binary form:
+	*	the text is parsed into the binary form in memory, so both are used in the same way;
+	*	the binary form is the records themselves, so a binary file is mapped into memory and used where it is, with no parsing
+		and no allocation per object; loading only checks the header and that every record is within the file;
+	*	Load() reads either form, telling them apart by the tag at the start of a binary file; Save() writes the binary form.
+
+	The text has one record per line; blank lines and lines starting with '#' are ignored. Positions are in room units, as
+	used by Room and Ghost, and sounds are .wav files, optional where shown in brackets:
+		room <name> <width> <depth>						starts a room; the records after it belong to it;
+		door <x> <z>									the centre of the 3 cell door in the bottom wall;
+		obstacle <type> <x> <z> <width> <depth> [sound]	type is wall, table, piano, radio or typewriter; the sound is played when
+														the player walks into it; obstacles of the same type share the first sound given,
+														and walls always sound like the room's walls;
+		stage <type> <x> <z> [sound]					type is knocking, piano, typewriter or radio; every room has each stage once;
+		emitter <type> <x> <z> <sound>					a looped sound; type is outdoor, ghost, event or critter, choosing its distance
+														curves; the first outdoor emitter is heard through the door.
+
+	The binary file is, in the machine's byte order:
+		header:		RoomLayoutHeader, with the tag "GERL", the version (1), the file size and the number of each record;
+		records:	the LayoutRoom records, then the LayoutObstacle, LayoutStage and LayoutEmitter records of all the rooms;
+		strings:	the names and sound files, each ending with a 0; records give a string as its offset into the strings,
+					and offset 0 is the empty string.
+*/
+
+// Define the class
+#ifndef __ROOMLAYOUT_HPP__
+#define __ROOMLAYOUT_HPP__
+
+// System includes.
+#include <Windows.h>
+#include <string>
+#include <vector>
+using std::string;
+using std::vector;
+
+// Application includes.
+#include "RoomGrid.hpp"
+
+// The version of the binary layout format
+#define ROOM_LAYOUT_VERSION 1
+
+// The number of ghost stages in every room; the stages are numbered as in Ghost's GhostState
+#define LAYOUT_STAGE_COUNT 4
+
+// The header of a binary layout
+struct RoomLayoutHeader
+{
+	char Tag[4];
+	UINT32 Version;
+	UINT32 FileSize;
+	UINT32 RoomCount;
+	UINT32 ObstacleCount;
+	UINT32 StageCount;
+	UINT32 EmitterCount;
+	UINT32 StringBytes;
+};
+
+// A room; its obstacles, stages and emitters are runs of the layout's records
+struct LayoutRoom
+{
+	UINT32 Name;
+	UINT32 Width;
+	UINT32 Depth;
+	float DoorX;
+	float DoorZ;
+	UINT32 FirstObstacle;
+	UINT32 ObstacleCount;
+	UINT32 FirstStage;
+	UINT32 FirstEmitter;
+	UINT32 EmitterCount;
+};
+
+// An obstacle filling a rectangle of cells with its cell value
+struct LayoutObstacle
+{
+	float X;
+	float Z;
+	float Width;
+	float Depth;
+	UINT32 Sound;
+	BYTE Value;
+	BYTE Padding[3];
+};
+
+// A stage the ghost moves to, and the sound of its event
+struct LayoutStage
+{
+	float X;
+	float Z;
+	UINT32 Sound;
+	BYTE Stage;
+	BYTE Padding[3];
+};
+
+// A looped emitter placed in the room
+struct LayoutEmitter
+{
+	float X;
+	float Z;
+	UINT32 Sound;
+	BYTE Type;
+	BYTE Padding[3];
+};
+
+// The RoomLayout class
+class RoomLayout
+{
+// Public Member functions and variables
+public:
+
+	// Function:		RoomLayout() - RoomLayout constructor
+	// Description:		Creates an empty layout
+	// In:				N/a
+	// Out:				N/a
+	RoomLayout();
+
+	// Function:		~RoomLayout() - RoomLayout destructor
+	// Description:		Unmaps the binary file, if one is loaded
+	// In:				N/a
+	// Out:				N/a
+	~RoomLayout();
+
+	// Function:		Load(string) - Load function
+	// Description:		Loads a layout from a text or binary file; a binary file is mapped into memory and used in place
+	// In:				const string &FileName - the file
+	// Out:				bool - false if the file could not be read or isn't a valid layout; GetError() says why, and the layout is empty
+	bool Load(const string &FileName);
+
+	// Function:		Parse(string) - Parse function
+	// Description:		Reads a layout from its text form
+	// In:				const string &Text - the text
+	// Out:				bool - false if the text isn't a valid layout; GetError() gives the line and the reason, and the layout is empty
+	bool Parse(const string &Text);
+
+	// Function:		Save(string) - Save function
+	// Description:		Writes the layout in its binary form
+	// In:				const string &FileName - the file
+	// Out:				bool - false if the layout is empty or the file could not be written
+	bool Save(const string &FileName) const;
+
+	// Function:		Rasterize(UINT32, RoomGrid) - Rasterize function
+	// Description:		Sizes the grid for a room and fills in its walls, door and obstacles, as Room::SetUpRoom did; the grid is indexed
+	//					at room position - 1, and each obstacle covers the cells from its position less half its size
+	// In:				UINT32 Room - the room, RoomGrid &Grid - the grid to fill
+	// Out:				bool - false if there is no such room
+	bool Rasterize(UINT32 Room, RoomGrid &Grid) const;
+
+	// Function:		FindEmitter(UINT32, BYTE) - Find Emitter function
+	// Description:		Finds the first emitter of a type in a room
+	// In:				UINT32 Room - the room, BYTE Type - the EmitterType
+	// Out:				const LayoutEmitter* - the emitter; NULL if the room has none of the type
+	const LayoutEmitter* FindEmitter(UINT32 Room, BYTE Type) const;
+
+	// Function:		GetDefault() - Get Default function
+	// Description:		Gives the layout of the original Ghost Escape room, parsed from text held in the code the first time it is asked for
+	// In:				N/a
+	// Out:				const RoomLayout& - the default layout
+	static const RoomLayout& GetDefault();
+
+	// Accessors for the records; a room's stages are GetStages(Room)[0 to LAYOUT_STAGE_COUNT - 1], in stage order
+	inline UINT32 GetRoomCount() const { return (mHeader != NULL) ? mHeader->RoomCount : 0; }
+	inline const LayoutRoom& GetRoom(UINT32 Room) const { return mRooms[Room]; }
+	inline const LayoutObstacle* GetObstacles(UINT32 Room) const { return mObstacles + mRooms[Room].FirstObstacle; }
+	inline const LayoutStage* GetStages(UINT32 Room) const { return mStages + mRooms[Room].FirstStage; }
+	inline const LayoutEmitter* GetEmitters(UINT32 Room) const { return mEmitters + mRooms[Room].FirstEmitter; }
+	inline const char* GetString(UINT32 Offset) const { return mStrings + Offset; }
+	inline size_t GetSize() const { return (mHeader != NULL) ? mHeader->FileSize : 0; }
+	inline const string& GetError() const { return mError; }
+
+// Private member functions and variables
+private:
+
+	// Layouts hold pointers into their own memory, so are not copied
+	RoomLayout(const RoomLayout&);
+	RoomLayout& operator=(const RoomLayout&);
+
+	// Function:		Attach(BYTE, size_t) - Attach function
+	// Description:		Checks the header and records of a binary layout and points the record accessors at them
+	// In:				const BYTE *Data - the binary layout, size_t Size - its size in bytes
+	// Out:				bool - false if the layout isn't valid
+	bool Attach(const BYTE *Data, size_t Size);
+
+	// Function:		Clear() - Clear function
+	// Description:		Empties the layout, unmapping the binary file if one is loaded
+	// In:				N/a
+	// Out:				N/a
+	void Clear();
+
+	// The binary layout; held in mImage when parsed from text, or in the mapped view of a binary file
+	vector<BYTE> mImage;
+	HANDLE mFile;
+	HANDLE mMapping;
+	const void *mView;
+
+	// The parts of the binary layout
+	const RoomLayoutHeader *mHeader;
+	const LayoutRoom *mRooms;
+	const LayoutObstacle *mObstacles;
+	const LayoutStage *mStages;
+	const LayoutEmitter *mEmitters;
+	const char *mStrings;
+
+	string mError;
+};
+// end RoomLayout class.
+
+#endif
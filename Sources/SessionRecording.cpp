@@ -0,0 +1,182 @@
+/*
+	File:	SessionRecording.cpp
+	Version:	1.0
+	Date:	18th October 2026
+	Author:	agent
+
+	Exposes:	Implementation of the SessionRecorder and SessionRecording classes.
+	Requires:	GhostEscape (for the GameCommand values).
+
+	Description:
+	Writes and reads recordings of the commands given to the room during a game.
+	*	See SessionRecording.hpp for details and the file format.
+*/
+
+// System includes.
+#include <Windows.h>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstring>
+using std::string;
+using std::vector;
+using std::ifstream;
+using std::ofstream;
+using std::ios;
+
+// Application includes.
+#include "SessionRecording.hpp"
+
+// Anonymous namespace for the file format constants
+namespace
+{
+	// The tag at the start of a recording file
+	const char RecordingTag[4] = { 'G', 'E', 'S', 'R' };
+}
+// end anonymous namespace.
+
+
+
+// Function:		SessionRecorder() - SessionRecorder constructor
+// Description:		Creates a recorder that isn't recording
+// In:				N/a
+// Out:				N/a
+SessionRecorder::SessionRecorder()
+	: mRecording(false)
+{
+}
+// End SessionRecorder constructor
+
+
+
+// Function:		~SessionRecorder() - SessionRecorder destructor
+// Description:		Closes the recording
+// In:				N/a
+// Out:				N/a
+SessionRecorder::~SessionRecorder()
+{
+	Close();
+}
+// End SessionRecorder destructor
+
+
+
+// Function:		Open(string, unsigned int, float) - Open function
+// Description:		Creates the recording file and writes the header
+// In:				const string &FileName - the file, unsigned int Seed - the room's seed, float TickRate - updates per second
+// Out:				bool - false if the file could not be created
+bool SessionRecorder::Open(const string &FileName, unsigned int Seed, float TickRate)
+{
+	Close();
+	mFile.open(FileName.c_str(), ios::binary);
+	if (!mFile.is_open())
+	{
+		return false;
+	}
+
+	UINT32 Version = SESSION_RECORDING_VERSION;
+	UINT32 SeedValue = Seed;
+	mFile.write(RecordingTag, sizeof(RecordingTag));
+	mFile.write((char*)&Version, sizeof(Version));
+	mFile.write((char*)&SeedValue, sizeof(SeedValue));
+	mFile.write((char*)&TickRate, sizeof(TickRate));
+	mFile.flush();
+	mRecording = mFile.good();
+	return mRecording;
+}
+// End Open function
+
+
+
+// Function:		Record(UINT32, GameCommand) - Record function
+// Description:		Writes a command and the tick it was given on; no effect if not recording
+// In:				UINT32 Tick - the tick, GameCommand Command - the command
+// Out:				N/a
+void SessionRecorder::Record(UINT32 Tick, GameCommand Command)
+{
+	if (!mRecording)
+	{
+		return;
+	}
+	BYTE CommandValue = BYTE(Command);
+	mFile.write((char*)&Tick, sizeof(Tick));
+	mFile.write((char*)&CommandValue, sizeof(CommandValue));
+	// Commands are only a few a second, so flushing each one costs little and keeps the recording if the game stops
+	mFile.flush();
+}
+// End Record function
+
+
+
+// Function:		Close() - Close function
+// Description:		Closes the recording file
+// In:				N/a
+// Out:				N/a
+void SessionRecorder::Close()
+{
+	if (mFile.is_open())
+	{
+		mFile.close();
+	}
+	mRecording = false;
+}
+// End Close function
+
+
+
+// Function:		SessionRecording() - SessionRecording constructor
+// Description:		Creates an empty recording
+// In:				N/a
+// Out:				N/a
+SessionRecording::SessionRecording()
+	: mSeed(0), mTickRate(TICK_RATE)
+{
+}
+// End SessionRecording constructor
+
+
+
+// Function:		Load(string) - Load function
+// Description:		Reads a recording written by SessionRecorder; a command cut short at the end of the file is ignored
+// In:				const string &FileName - the file
+// Out:				bool - false if the file could not be read or isn't a recording
+bool SessionRecording::Load(const string &FileName)
+{
+	ifstream File(FileName.c_str(), ios::binary);
+	if (!File.is_open())
+	{
+		return false;
+	}
+
+	char Tag[4];
+	UINT32 Version;
+	UINT32 SeedValue;
+	float TickRate;
+	File.read(Tag, sizeof(Tag));
+	File.read((char*)&Version, sizeof(Version));
+	File.read((char*)&SeedValue, sizeof(SeedValue));
+	File.read((char*)&TickRate, sizeof(TickRate));
+	if ((!File) || (memcmp(Tag, RecordingTag, sizeof(Tag)) != 0) || (Version != SESSION_RECORDING_VERSION) || (TickRate <= 0.0f))
+	{
+		return false;
+	}
+
+	mSeed = SeedValue;
+	mTickRate = TickRate;
+	mCommands.clear();
+	RecordedCommand Recorded;
+	UINT32 Tick;
+	BYTE CommandValue;
+	while (File.read((char*)&Tick, sizeof(Tick)) && File.read((char*)&CommandValue, sizeof(CommandValue)))
+	{
+		if (CommandValue > INSTRUCTIONS_COMMAND)
+		{
+			return false;
+		}
+		Recorded.Tick = Tick;
+		Recorded.Command = GameCommand(CommandValue);
+		mCommands.push_back(Recorded);
+	}
+	return true;
+}
+// End Load function
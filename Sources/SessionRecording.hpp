@@ -0,0 +1,128 @@
+/*
+	File:	SessionRecording.hpp
+	Version:	1.0
+	Date:	18th October 2026
+	Author:	agent
+
+	Exposes:	RecordedCommand, SessionRecorder, SessionRecording.
+	Requires:	GhostEscape (for the GameCommand values).
+
+	Description:
+	Records the commands given to the room during a game so the game can be replayed, e.g. by the HeadlessDriver to reproduce
+	a hitch or glitch, or as a repeatable benchmark.
+
+	A game is fully described by the room's seed, the tick rate and the tick each command was given on, since the room's random
+	generators are seeded from the seed and the game is updated at a fixed tick rate.
+
+	*	SessionRecorder writes the recording as the game is played; each command is written (and flushed) as it is given, so
+		the recording is kept if the game stops unexpectedly;
+	*	SessionRecording reads a recording back.
+
+	The file is binary, in the machine's byte order:
+		header:		4 byte tag "GESR", UINT32 version (1), UINT32 seed, float tick rate;
+		commands:	UINT32 tick, BYTE command; repeated to the end of the file.
+*/
+
+// Define the classes
+#ifndef __SESSIONRECORDING_HPP__
+#define __SESSIONRECORDING_HPP__
+
+// System includes.
+#include <Windows.h>
+#include <string>
+#include <vector>
+#include <fstream>
+using std::string;
+using std::vector;
+using std::ofstream;
+
+// Application includes.
+#include "GhostEscape.hpp"
+
+// The version of the recording file format
+#define SESSION_RECORDING_VERSION 1
+
+// A command and the tick it was given on; ticks are counted from 0 at the first update of the room
+struct RecordedCommand
+{
+	UINT32 Tick;
+	GameCommand Command;
+};
+
+// The SessionRecorder class
+class SessionRecorder
+{
+// Public Member functions and variables
+public:
+
+	// Function:		SessionRecorder() - SessionRecorder constructor
+	// Description:		Creates a recorder that isn't recording
+	// In:				N/a
+	// Out:				N/a
+	SessionRecorder();
+
+	// Function:		~SessionRecorder() - SessionRecorder destructor
+	// Description:		Closes the recording
+	// In:				N/a
+	// Out:				N/a
+	~SessionRecorder();
+
+	// Function:		Open(string, unsigned int, float) - Open function
+	// Description:		Creates the recording file and writes the header
+	// In:				const string &FileName - the file, unsigned int Seed - the room's seed, float TickRate - updates per second
+	// Out:				bool - false if the file could not be created
+	bool Open(const string &FileName, unsigned int Seed, float TickRate);
+
+	// Function:		Record(UINT32, GameCommand) - Record function
+	// Description:		Writes a command and the tick it was given on; no effect if not recording
+	// In:				UINT32 Tick - the tick, GameCommand Command - the command
+	// Out:				N/a
+	void Record(UINT32 Tick, GameCommand Command);
+
+	// Function:		Close() - Close function
+	// Description:		Closes the recording file
+	// In:				N/a
+	// Out:				N/a
+	void Close();
+
+	inline bool IsRecording() const { return mRecording; }
+
+// Private member functions and variables
+private:
+	ofstream mFile;
+	bool mRecording;
+};
+// end SessionRecorder class.
+
+// The SessionRecording class
+class SessionRecording
+{
+// Public Member functions and variables
+public:
+
+	// Function:		SessionRecording() - SessionRecording constructor
+	// Description:		Creates an empty recording
+	// In:				N/a
+	// Out:				N/a
+	SessionRecording();
+
+	// Function:		Load(string) - Load function
+	// Description:		Reads a recording written by SessionRecorder
+	// In:				const string &FileName - the file
+	// Out:				bool - false if the file could not be read or isn't a recording
+	bool Load(const string &FileName);
+
+	// Accessors for the recording
+	inline unsigned int GetSeed() const { return mSeed; }
+	inline float GetTickRate() const { return mTickRate; }
+	inline const vector<RecordedCommand>& GetCommands() const { return mCommands; }
+
+// Private member functions and variables
+private:
+	unsigned int mSeed;
+	float mTickRate;
+	vector<RecordedCommand> mCommands;
+};
+// end SessionRecording class.
+
+#endif
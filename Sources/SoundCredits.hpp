@@ -24,6 +24,7 @@ modified: Reduced the amplification of the sound so that it is quieter
 mono; 16 bit; 48000Hz.
 
 + CreakingFootsteps.wav
+held in: the PlayerFootsteps.wav sound sheet, as its region 'CreakingFootsteps'
 source: Two Files - https://www.freesound.org/people/tmkappelt/sounds/85687/ and https://www.freesound.org/people/Mydo1/sounds/198962/
 renamed from: '198962__mydo1__footsteps-on-wood.wav' and '85687__tmkappelt__footsteps-squeeky-wood.wav'
 how it is used: This sound file is used randomly when the player moves forward to imply a creaking floorboard
@@ -39,6 +40,7 @@ modified: Cropped the sound file to make it shorter, and amplified the sound and
 mono; 16 bit; 48000Hz.
 
 + DefaultFootsteps.wav
+held in: the PlayerFootsteps.wav sound sheet, as its region 'DefaultFootsteps'
 source: https://www.freesound.org/people/Mydo1/sounds/198962/
 renamed from: '198962__mydo1__footsteps-on-wood.wav'
 how it is used: This sound file is used randomly when the player moves forward to show the player has moved
@@ -51,6 +53,7 @@ renamed from: '198363__qubodup__ghosts.flac'
 how it is used: This sound is used for the ghost when not laughing or moving, to give an extra clue to the player where he is
 modified: Slightly decreased the amplification of the sound file and also cropped for a shorter sound file that can be looped
 	  also changed from stereo to mono
+	  Trimmed from 10.08s to a 0.36s intro and a 4.01s loop, marked in a smpl chunk, with the game's -trimloop option.
 mono; 16 bit; 48000Hz.
 
 + DefaultTurning.wav
@@ -76,6 +79,7 @@ modified: increased the tempo of this sound so that the sound will play faster,
 stereo; 16 bit; 96000Hz.
 
 + FootstepsVariant1.wav
+held in: the PlayerFootsteps.wav sound sheet, as its region 'FootstepsVariant1'
 source: https://www.freesound.org/people/Mydo1/sounds/198962/
 renamed from: '198962__mydo1__footsteps-on-wood.wav'
 how it is used: This sound file is used randomly when the player moves forward to show the player has moved
@@ -133,6 +137,7 @@ source: https://www.freesound.org/people/Vosvoy/sounds/178932/
 renamed from: '178932__vosvoy__heartbeat-loop.wav'
 how it is used: This sound is used to show the players heartbeat. The frequency and volume of the sound increase the closer the player gets to the  ghost
 modified: Cropped to have a smaller sound file that could be looped
+	  Trimmed from 3.44s to a 0.20s intro and a 1.65s loop, marked in a smpl chunk, with the game's -trimloop option.
 stereo; 16 bit; 48000Hz.
 
 + HitWallNoise.wav
@@ -151,6 +156,7 @@ renamed from: '209220__mark646__tur-klopfen-04.wav' and '174640__altfuture__door
 how it is used: This sound is used for the KNOCKING event for the ghost so that the door is knocking and draws player towards it
 modified: Cropped pieces from each file and spliced them together to create different knocking noises in a sequence. Amplified the volume so that
 	  door knocks are louder and also added reverb. Changed all from stereo to mono.
+	  Trimmed from 32.22s to a 0.02s intro and a 13.69s loop, marked in a smpl chunk, with the game's -trimloop option.
 mono; 16 bit; 44100Hz.
 
 + LockedDoor.wav
@@ -176,6 +182,7 @@ modified: Cropped to use a smaller sound file that can be looped. Also changed f
 mono; 16 bit; 44100Hz.
 
 + PainSound1.wav
+held in: the PlayerPain.wav sound sheet, as its region 'PainSound1'
 source: https://www.freesound.org/people/MadamVicious/sounds/218190/
 renamed from: '218190__madamvicious__girl-taking-damage.wav'
 how it is used: This sound is randomly selected from the 3 pain sounds and used when the player collides with an object/wall
@@ -183,6 +190,7 @@ modified: Cropped and added reverb
 stereo; 16 bit; 44100Hz.
 
 + PainSound2.wav
+held in: the PlayerPain.wav sound sheet, as its region 'PainSound2'
 source: https://www.freesound.org/people/MadamVicious/sounds/218190/
 renamed from: '218190__madamvicious__girl-taking-damage.wav'
 how it is used: This sound is randomly selected from the 3 pain sounds and used when the player collides with an object/wall
@@ -190,6 +198,7 @@ modified: Cropped and added reverb
 stereo; 16 bit; 44100Hz.
 
 + PainSound3.wav
+held in: the PlayerPain.wav sound sheet, as its region 'PainSound3'
 source: https://www.freesound.org/people/MadamVicious/sounds/218190/
 renamed from: '218190__madamvicious__girl-taking-damage.wav'
 how it is used: This sound is randomly selected from the 3 pain sounds and used when the player collides with an object/wall
@@ -211,6 +220,12 @@ modified: Changed the pitch of the piano music lower to suit the game, cropped f
 	  and increased the tempo of the piece to give a more angry feeling to the piano playing
 mono; 16 bit; 44100Hz.
 
++ PlayerFootsteps.wav
+source: DefaultFootsteps.wav, FootstepsVariant1.wav and CreakingFootsteps.wav above
+how it is used: A sound sheet of the three footsteps sounds, one of which is randomly played when the player moves forward
+modified: Joined into one file, with a cue point and a labelled region for each sound
+mono; 16 bit; 44100Hz.
+
 + PlayerOutro.wav
 source: Two files - https://www.freesound.org/people/Reitanna/sounds/242909/  and https://www.freesound.org/people/Ch0cchi/sounds/15288/
 renamed from: '242909__reitanna__relieved-sigh.wav' and '15288__ch0cchi__female-giggle.wav'
@@ -218,6 +233,12 @@ how it is used: This sound is used when the ghost is defeated to show the player
 modified: Combined and cropped these files to give a relieved sounding sigh and laugh. Increased the tempo. 
 mono; 16 bit; 44100Hz.
 
++ PlayerPain.wav
+source: PainSound1.wav, PainSound2.wav and PainSound3.wav above
+how it is used: A sound sheet of the three pain sounds, one of which is randomly played when the player collides with an object/wall
+modified: Joined into one file, with a cue point and a labelled region for each sound
+stereo; 16 bit; 44100Hz.
+
 + RadioCollision.wav
 source: Two Files - https://www.freesound.org/people/groovyrandomness/sounds/171257/  and https://www.freesound.org/people/zerolagtime/sounds/245033/
 renamed from: '171257__groovyrandomness__static.wav' and '245033__zerolagtime__thuds-on-window.wav'
@@ -230,6 +251,7 @@ source: https://www.freesound.org/people/JimiMod/sounds/215702/
 renamed from: '215702__jimimod__abstract-radio-communications.aiff'
 how it is used: This sound is used for the ghost event RADIO to play the radio and draw the player towards it
 modified: Cropped original so it is only a short loopable sound file, added reverb and changed from stereo to mono.
+	  Trimmed from 15.16s to a 0.01s intro and a 8.59s loop, marked in a smpl chunk, with the game's -trimloop option.
 mono; 16 bit; 44100Hz.
 
 + RoomIntro.wav
@@ -258,6 +280,7 @@ source: https://www.freesound.org/people/TOC1/sounds/244414/
 renamed from: '244414__toc1__typewriter.aiff'
 how it is used: This sound is used for the ghost event TYPEWRITER to play the typewriter sound and draw player closer
 modified: Cropped the sound to a shorter sound file and amplified the sound and added reverb. Also changed from stereo to mono.
+	  Trimmed from 31.75s to a 0.31s intro and a 14.46s loop, marked in a smpl chunk, with the game's -trimloop option.
 mono; 16 bit; 44100Hz.
 
 + TypewriterCollision.wav
@@ -173,7 +173,7 @@ namespace stu
 
 	float v3f::Dot( const v3f&v1, const v3f &v2)	// friend
 	{
-		return(v1.x*v2.x + v1.y*v2.y + v1.z+v2.z);
+		return(v1.x*v2.x + v1.y*v2.y + v1.z*v2.z);
 	}
 
 	v3f v3f::Cross( const v3f &v )
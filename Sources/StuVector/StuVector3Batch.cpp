@@ -0,0 +1,392 @@
+/*
+	file:	StuVector3Batch.cpp
+	Version:	1.0
+	Date:	18th October 2026.
+	Author:	agent.
+
+	Namespace:	stu
+	Exposes:	stu::batch functions implementation.
+	Requires:	StuVector3 (v3f), StuMath.
+
+	Description:
+	Loading and storing packs, and the batch functions.
+	this is the implementation file - see StuVector3Batch.hpp for details.
+
+*/
+
+#include "StuVector3Batch.hpp"
+
+namespace stu
+{
+	namespace
+	{
+		// Gather 4 floats a stride apart
+		inline simd4f Gather4(const float *p, size_t stride)
+		{
+			float f[4] = { p[0], p[stride], p[2 * stride], p[3 * stride] };
+			return Load4(f);
+		}
+
+		inline void Scatter4(float *p, size_t stride, simd4f a)
+		{
+			float f[4];
+			Store4(f, a);
+			p[0] = f[0]; p[stride] = f[1]; p[2 * stride] = f[2]; p[3 * stride] = f[3];
+		}
+
+		// 4 vectors packed as x, y, z, x, y, z... e.g. X3DAUDIO_VECTORs, to a pack and back
+		inline void LoadPacked3(const float *p, simd4f &x, simd4f &y, simd4f &z)
+		{
+#if defined(STU_SIMD_SSE)
+			// a0 = x0 y0 z0 x1, a1 = y1 z1 x2 y2, a2 = z2 x3 y3 z3
+			__m128 a0 = _mm_loadu_ps(p), a1 = _mm_loadu_ps(p + 4), a2 = _mm_loadu_ps(p + 8);
+			__m128 t0 = _mm_shuffle_ps(a1, a2, _MM_SHUFFLE(2, 1, 3, 2));	// x2 y2 x3 y3
+			__m128 t1 = _mm_shuffle_ps(a0, a1, _MM_SHUFFLE(1, 0, 2, 1));	// y0 z0 y1 z1
+			x = _mm_shuffle_ps(a0, t0, _MM_SHUFFLE(2, 0, 3, 0));			// x0 x1 x2 x3
+			y = _mm_shuffle_ps(t1, t0, _MM_SHUFFLE(3, 1, 2, 0));			// y0 y1 y2 y3
+			z = _mm_shuffle_ps(t1, a2, _MM_SHUFFLE(3, 0, 3, 1));			// z0 z1 z2 z3
+#elif defined(STU_SIMD_NEON)
+			float32x4x3_t v = vld3q_f32(p);
+			x = v.val[0]; y = v.val[1]; z = v.val[2];
+#else
+			x = Gather4(p, 3); y = Gather4(p + 1, 3); z = Gather4(p + 2, 3);
+#endif
+		}
+
+		inline void StorePacked3(float *p, simd4f x, simd4f y, simd4f z)
+		{
+#if defined(STU_SIMD_SSE)
+			__m128 xylo = _mm_unpacklo_ps(x, y);													// x0 y0 x1 y1
+			__m128 xyhi = _mm_unpackhi_ps(x, y);													// x2 y2 x3 y3
+			__m128 a0 = _mm_shuffle_ps(xylo, _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 1, 0));	// x0 y0 z0 x1
+			__m128 a1 = _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), xyhi, _MM_SHUFFLE(1, 0, 2, 0));	// y1 z1 x2 y2
+			__m128 t = _mm_shuffle_ps(z, xyhi, _MM_SHUFFLE(3, 2, 3, 2));							// z2 z3 x3 y3
+			__m128 a2 = _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 3, 2, 0));								// z2 x3 y3 z3
+			_mm_storeu_ps(p, a0); _mm_storeu_ps(p + 4, a1); _mm_storeu_ps(p + 8, a2);
+#elif defined(STU_SIMD_NEON)
+			float32x4x3_t v;
+			v.val[0] = x; v.val[1] = y; v.val[2] = z;
+			vst3q_f32(p, v);
+#else
+			Scatter4(p, 3, x); Scatter4(p + 1, 3, y); Scatter4(p + 2, 3, z);
+#endif
+		}
+
+		// 4 vectors 4 floats apart, e.g. v3fs; the fourth float is left alone
+		inline void LoadPadded4(const float *p, simd4f &x, simd4f &y, simd4f &z)
+		{
+#if defined(STU_SIMD_SSE)
+			__m128 a0 = _mm_loadu_ps(p), a1 = _mm_loadu_ps(p + 4), a2 = _mm_loadu_ps(p + 8), a3 = _mm_loadu_ps(p + 12);
+			_MM_TRANSPOSE4_PS(a0, a1, a2, a3);
+			x = a0; y = a1; z = a2;
+#elif defined(STU_SIMD_NEON)
+			float32x4x4_t v = vld4q_f32(p);
+			x = v.val[0]; y = v.val[1]; z = v.val[2];
+#else
+			x = Gather4(p, 4); y = Gather4(p + 1, 4); z = Gather4(p + 2, 4);
+#endif
+		}
+
+		// The layouts of view the loads and stores have a fast way for; LAYOUT_ANY works the layout out for each pack
+		enum Layout { LAYOUT_SEPARATE, LAYOUT_PACKED3, LAYOUT_PADDED4, LAYOUT_STRIDED, LAYOUT_ANY };
+
+		inline int LayoutOf(const v3fView &view)
+		{
+			if (view.isSeparate())
+			{
+				return LAYOUT_SEPARATE;
+			}
+			if (view.isInterleaved() && (view.stride == 3))
+			{
+				return LAYOUT_PACKED3;
+			}
+			if (view.isInterleaved() && (view.stride == 4))
+			{
+				return LAYOUT_PADDED4;
+			}
+			return LAYOUT_STRIDED;
+		}
+
+		// Load and store 4 vectors of a view with the given layout; the switch is on a constant unless the layout is LAYOUT_ANY,
+		// so the compiler keeps just the one case
+		template<int L>
+		inline void LoadPack(const v3fView &view, size_t first, simd4f &x, simd4f &y, simd4f &z)
+		{
+			const size_t offset = first * view.stride;
+			switch ((L == LAYOUT_ANY) ? LayoutOf(view) : L)
+			{
+			case LAYOUT_SEPARATE:
+				x = Load4(view.x + offset); y = Load4(view.y + offset); z = Load4(view.z + offset);
+				break;
+			case LAYOUT_PACKED3:
+				LoadPacked3(view.x + offset, x, y, z);
+				break;
+			case LAYOUT_PADDED4:
+				LoadPadded4(view.x + offset, x, y, z);
+				break;
+			default:
+				x = Gather4(view.x + offset, view.stride); y = Gather4(view.y + offset, view.stride); z = Gather4(view.z + offset, view.stride);
+				break;
+			}
+		}
+
+		template<int L>
+		inline void StorePack(const v3fView &view, size_t first, simd4f x, simd4f y, simd4f z)
+		{
+			const size_t offset = first * view.stride;
+			switch ((L == LAYOUT_ANY) ? LayoutOf(view) : L)
+			{
+			case LAYOUT_SEPARATE:
+				Store4(view.x + offset, x); Store4(view.y + offset, y); Store4(view.z + offset, z);
+				break;
+			case LAYOUT_PACKED3:
+				StorePacked3(view.x + offset, x, y, z);
+				break;
+			default:
+				Scatter4(view.x + offset, view.stride, x); Scatter4(view.y + offset, view.stride, y); Scatter4(view.z + offset, view.stride, z);
+				break;
+			}
+		}
+
+		// 8 vectors of a view with the given layout
+		template<int L>
+		inline v3f8 LoadPack8(const v3fView &view, size_t first)
+		{
+			simd4f lox, loy, loz, hix, hiy, hiz;
+			LoadPack<L>(view, first, lox, loy, loz);
+			LoadPack<L>(view, first + 4, hix, hiy, hiz);
+			v3f8 r = { Join(lox, hix), Join(loy, hiy), Join(loz, hiz) };
+			return r;
+		}
+
+		template<int L>
+		inline void StorePack8(const v3f8 &v, const v3fView &view, size_t first)
+		{
+			StorePack<L>(view, first, Low(v.x), Low(v.y), Low(v.z));
+			StorePack<L>(view, first + 4, High(v.x), High(v.y), High(v.z));
+		}
+
+		// Runs a kernel with the layout of its views fixed at compile time when they all have the same fast layout, which is
+		// the usual case, and with LAYOUT_ANY otherwise
+		template<typename Kernel>
+		inline void Dispatch(Kernel &kernel, const v3fView &a, const v3fView &b, const v3fView &c)
+		{
+			const int layout = LayoutOf(a);
+			if ((LayoutOf(b) != layout) || (LayoutOf(c) != layout))
+			{
+				kernel.template Run<LAYOUT_ANY>();
+				return;
+			}
+			switch (layout)
+			{
+			case LAYOUT_SEPARATE:	kernel.template Run<LAYOUT_SEPARATE>(); break;
+			case LAYOUT_PACKED3:	kernel.template Run<LAYOUT_PACKED3>(); break;
+			case LAYOUT_PADDED4:	kernel.template Run<LAYOUT_PADDED4>(); break;
+			default:				kernel.template Run<LAYOUT_STRIDED>(); break;
+			}
+		}
+
+		// One vector of a view, for the vectors left over after the packs
+		inline v3f Get(const v3fView &view, size_t i)
+		{
+			const size_t offset = i * view.stride;
+			v3f v = { view.x[offset], view.y[offset], view.z[offset] };
+			return v;
+		}
+
+		inline void Put(const v3fView &view, size_t i, const v3f &v)
+		{
+			const size_t offset = i * view.stride;
+			view.x[offset] = v.x; view.y[offset] = v.y; view.z[offset] = v.z;
+		}
+
+		inline float DistanceSquared(const v3f &a, const v3f &b)
+		{
+			float dx = a.x - b.x, dy = a.y - b.y, dz = a.z - b.z;
+			return dx*dx + dy*dy + dz*dz;
+		}
+
+		// The difference of two packs
+		inline v3f8 Difference(const v3f8 &a, const v3f8 &b)
+		{
+			v3f8 r = { Sub(a.x, b.x), Sub(a.y, b.y), Sub(a.z, b.z) };
+			return r;
+		}
+	}//namespace
+
+
+
+	// Packs
+	v3f4 v3f4::Load(const v3fView &view, size_t first)
+	{
+		v3f4 r;
+		stu::LoadPack<LAYOUT_ANY>(view, first, r.x, r.y, r.z);
+		return r;
+	}
+
+	void v3f4::Store(const v3fView &view, size_t first) const
+	{
+		stu::StorePack<LAYOUT_ANY>(view, first, x, y, z);
+	}
+
+	v3f8 v3f8::Load(const v3fView &view, size_t first)
+	{
+		return stu::LoadPack8<LAYOUT_ANY>(view, first);
+	}
+
+	void v3f8::Store(const v3fView &view, size_t first) const
+	{
+		stu::StorePack8<LAYOUT_ANY>(*this, view, first);
+	}
+
+
+
+	// Batch functions; each works 8 vectors at a time, then on the rest one at a time
+	namespace batch
+	{
+		namespace
+		{
+			// The kernels, run by Dispatch with the layout of their views
+			struct DotKernel
+			{
+				const v3fView &a, &b;
+				float *out;
+				size_t count;
+
+				template<int L> void Run()
+				{
+					size_t i = 0;
+					for (; i + 8 <= count; i += 8)
+					{
+						stu::Store8(out + i, stu::Dot(stu::LoadPack8<L>(a, i), stu::LoadPack8<L>(b, i)));
+					}
+					for (; i < count; ++i)
+					{
+						v3f va = Get(a, i), vb = Get(b, i);
+						out[i] = va.x*vb.x + va.y*vb.y + va.z*vb.z;
+					}
+				}
+			};
+
+			// The distance or squared distance between the vectors of two views, or of one view from a point
+			template<bool Squared, bool ToPoint>
+			struct DistanceKernel
+			{
+				const v3fView &a, &b;
+				const v3f &point;
+				float *out;
+				size_t count;
+
+				template<int L> void Run()
+				{
+					const v3f8 p = v3f8::Splat(point);
+					size_t i = 0;
+					for (; i + 8 <= count; i += 8)
+					{
+						v3f8 d = Difference(stu::LoadPack8<L>(a, i), ToPoint ? p : stu::LoadPack8<L>(b, i));
+						simd8f dsquared = stu::Dot(d, d);
+						stu::Store8(out + i, Squared ? dsquared : Sqrt(dsquared));
+					}
+					for (; i < count; ++i)
+					{
+						float dsquared = stu::DistanceSquared(Get(a, i), ToPoint ? point : Get(b, i));
+						out[i] = Squared ? dsquared : math::Sqrt(dsquared);
+					}
+				}
+			};
+
+			struct NormaliseKernel
+			{
+				const v3fView &v;
+				size_t count;
+
+				template<int L> void Run()
+				{
+					size_t i = 0;
+					for (; i + 8 <= count; i += 8)
+					{
+						stu::StorePack8<L>(stu::Normalise(stu::LoadPack8<L>(v, i)), v, i);
+					}
+					for (; i < count; ++i)
+					{
+						v3f n = Get(v, i);
+						n.Normalise();
+						Put(v, i, n);
+					}
+				}
+			};
+
+			struct LerpKernel
+			{
+				const v3fView &a, &b;
+				float t;
+				const v3fView &out;
+				size_t count;
+
+				template<int L> void Run()
+				{
+					size_t i = 0;
+					for (; i + 8 <= count; i += 8)
+					{
+						stu::StorePack8<L>(stu::Lerp(stu::LoadPack8<L>(a, i), stu::LoadPack8<L>(b, i), t), out, i);
+					}
+					for (; i < count; ++i)
+					{
+						v3f va = Get(a, i), vb = Get(b, i);
+						v3f r = { va.x + (vb.x - va.x) * t, va.y + (vb.y - va.y) * t, va.z + (vb.z - va.z) * t };
+						Put(out, i, r);
+					}
+				}
+			};
+		}//namespace
+
+		void Dot(const v3fView &a, const v3fView &b, float *out, size_t count)
+		{
+			DotKernel kernel = { a, b, out, count };
+			Dispatch(kernel, a, b, b);
+		}
+
+		void DistanceSquared(const v3fView &a, const v3fView &b, float *out, size_t count)
+		{
+			DistanceKernel<true, false> kernel = { a, b, ZeroVector3, out, count };
+			Dispatch(kernel, a, b, b);
+		}
+
+		void Distance(const v3fView &a, const v3fView &b, float *out, size_t count)
+		{
+			DistanceKernel<false, false> kernel = { a, b, ZeroVector3, out, count };
+			Dispatch(kernel, a, b, b);
+		}
+
+		void Distance(const v3fView &a, const v3f &point, float *out, size_t count)
+		{
+			DistanceKernel<false, true> kernel = { a, a, point, out, count };
+			Dispatch(kernel, a, a, a);
+		}
+
+		void Normalise(const v3fView &v, size_t count)
+		{
+			NormaliseKernel kernel = { v, count };
+			Dispatch(kernel, v, v, v);
+		}
+
+		void Lerp(const v3fView &a, const v3fView &b, float t, const v3fView &out, size_t count)
+		{
+			LerpKernel kernel = { a, b, t, out, count };
+			Dispatch(kernel, a, b, out);
+		}
+
+		const char *InstructionSet()
+		{
+#if defined(STU_SIMD_AVX)
+			return "AVX";
+#elif defined(STU_SIMD_SSE)
+			return "SSE";
+#elif defined(STU_SIMD_NEON)
+			return "NEON";
+#else
+			return "scalar";
+#endif
+		}
+	}//namespace
+}//namespace
@@ -0,0 +1,272 @@
+/*
+	file:	StuVector3Batch.hpp
+	Version:	1.0
+	Date:	18th October 2026.
+	Author:	agent.
+
+	Namespace:	stu
+	Exposes:	simd4f, simd8f, v3fView, v3f4, v3f8, MakeView and the stu::batch functions.
+	Requires:	StuVector3 (v3f), StuMath.
+
+	Description:
+	Batch vector math alongside v3f.
+
+	v3f works on one vector at a time, each operator returning a temporary. This works on many: the vectors are taken a pack
+	at a time as structure of arrays - the x of 4 (or 8) vectors in one register, their y in another and their z in a third -
+	so each instruction works on all of them.
+
+	*	simd4f and simd8f are 4 and 8 floats in a register: SSE and AVX on x86, NEON on ARM, or plain floats where there is
+		none (or if STU_SIMD_SCALAR is defined); simd8f is a pair of simd4f without AVX;
+	*	v3f4 and v3f8 are packs of 4 and 8 vectors, with Dot, Length, Normalise and Lerp on the whole pack;
+	*	v3fView describes where an array of vectors is without copying it: the addresses of the first x, y and z and the floats
+		between one vector and the next. MakeView gives the view of an array of any struct beginning with its float x, y and z,
+		such as X3DAUDIO_VECTOR (3 floats apart) or v3f (4 floats apart), or of separate x, y and z arrays (1 float apart);
+	*	the batch functions (stu::batch) take views and work along them a pack at a time, with the last few vectors done one
+		at a time. Loads and stores are fastest for separate arrays and for packed X3DAUDIO_VECTORs, which are turned into
+		packs with shuffles, and the layout is chosen once for the call when all its views share one; other layouts are
+		gathered a float at a time.
+
+	Normalise gives a zero vector for a vector of near-zero length, as v3f::Normalise does.
+*/
+
+#pragma once
+#ifndef STU_VECTOR3_BATCH_INCLUDED
+#define STU_VECTOR3_BATCH_INCLUDED
+
+#include <cstddef>
+#include "StuVector3.hpp"
+#include "StuMath.hpp"
+
+// Choose the instruction set
+#if !defined(STU_SIMD_SCALAR)
+#if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM) || defined(_M_ARM64)
+#define STU_SIMD_NEON
+#elif defined(_M_X64) || defined(__SSE__) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 1))
+#define STU_SIMD_SSE
+#if defined(__AVX__)
+#define STU_SIMD_AVX
+#endif
+#else
+#define STU_SIMD_SCALAR
+#endif
+#endif
+
+#if defined(STU_SIMD_NEON)
+#include <arm_neon.h>
+#elif defined(STU_SIMD_AVX)
+#include <immintrin.h>
+#elif defined(STU_SIMD_SSE)
+#include <xmmintrin.h>
+#endif
+
+namespace stu
+{
+	// 4 floats //////////////////////////////////////////////////////////////
+#if defined(STU_SIMD_SSE)
+	typedef __m128 simd4f;
+	inline simd4f Load4(const float *p)						{ return _mm_loadu_ps(p); }
+	inline void Store4(float *p, simd4f a)					{ _mm_storeu_ps(p, a); }
+	inline simd4f Splat4(float f)							{ return _mm_set1_ps(f); }
+	inline simd4f Add(simd4f a, simd4f b)					{ return _mm_add_ps(a, b); }
+	inline simd4f Sub(simd4f a, simd4f b)					{ return _mm_sub_ps(a, b); }
+	inline simd4f Mul(simd4f a, simd4f b)					{ return _mm_mul_ps(a, b); }
+	inline simd4f Div(simd4f a, simd4f b)					{ return _mm_div_ps(a, b); }
+	inline simd4f Sqrt(simd4f a)							{ return _mm_sqrt_ps(a); }
+	// value where a >= b, else 0
+	inline simd4f KeepIfAtLeast(simd4f a, simd4f b, simd4f value)	{ return _mm_and_ps(_mm_cmpge_ps(a, b), value); }
+#elif defined(STU_SIMD_NEON)
+	typedef float32x4_t simd4f;
+	inline simd4f Load4(const float *p)						{ return vld1q_f32(p); }
+	inline void Store4(float *p, simd4f a)					{ vst1q_f32(p, a); }
+	inline simd4f Splat4(float f)							{ return vdupq_n_f32(f); }
+	inline simd4f Add(simd4f a, simd4f b)					{ return vaddq_f32(a, b); }
+	inline simd4f Sub(simd4f a, simd4f b)					{ return vsubq_f32(a, b); }
+	inline simd4f Mul(simd4f a, simd4f b)					{ return vmulq_f32(a, b); }
+	inline simd4f Div(simd4f a, simd4f b)
+	{
+		// Reciprocal estimate refined by two Newton-Raphson steps, which is as close as a divide for these uses
+		float32x4_t r = vrecpeq_f32(b);
+		r = vmulq_f32(vrecpsq_f32(b, r), r);
+		r = vmulq_f32(vrecpsq_f32(b, r), r);
+		return vmulq_f32(a, r);
+	}
+	inline simd4f Sqrt(simd4f a)
+	{
+		// sqrt(a) = a * (1 / sqrt(a)), with the reciprocal square root estimate refined by two steps; 0 stays 0
+		float32x4_t r = vrsqrteq_f32(a);
+		r = vmulq_f32(vrsqrtsq_f32(vmulq_f32(a, r), r), r);
+		r = vmulq_f32(vrsqrtsq_f32(vmulq_f32(a, r), r), r);
+		uint32x4_t nonzero = vcgtq_f32(a, vdupq_n_f32(0.0f));
+		return vreinterpretq_f32_u32(vandq_u32(nonzero, vreinterpretq_u32_f32(vmulq_f32(a, r))));
+	}
+	inline simd4f KeepIfAtLeast(simd4f a, simd4f b, simd4f value)
+	{
+		return vreinterpretq_f32_u32(vandq_u32(vcgeq_f32(a, b), vreinterpretq_u32_f32(value)));
+	}
+#else
+	struct simd4f { float v[4]; };
+	inline simd4f Load4(const float *p)						{ simd4f r = { { p[0], p[1], p[2], p[3] } }; return r; }
+	inline void Store4(float *p, simd4f a)					{ p[0] = a.v[0]; p[1] = a.v[1]; p[2] = a.v[2]; p[3] = a.v[3]; }
+	inline simd4f Splat4(float f)							{ simd4f r = { { f, f, f, f } }; return r; }
+	inline simd4f Add(simd4f a, simd4f b)					{ for (int i = 0; i < 4; ++i) a.v[i] += b.v[i]; return a; }
+	inline simd4f Sub(simd4f a, simd4f b)					{ for (int i = 0; i < 4; ++i) a.v[i] -= b.v[i]; return a; }
+	inline simd4f Mul(simd4f a, simd4f b)					{ for (int i = 0; i < 4; ++i) a.v[i] *= b.v[i]; return a; }
+	inline simd4f Div(simd4f a, simd4f b)					{ for (int i = 0; i < 4; ++i) a.v[i] /= b.v[i]; return a; }
+	inline simd4f Sqrt(simd4f a)							{ for (int i = 0; i < 4; ++i) a.v[i] = sqrtf(a.v[i]); return a; }
+	inline simd4f KeepIfAtLeast(simd4f a, simd4f b, simd4f value)
+	{
+		for (int i = 0; i < 4; ++i) value.v[i] = (a.v[i] >= b.v[i]) ? value.v[i] : 0.0f;
+		return value;
+	}
+#endif
+
+	// 8 floats //////////////////////////////////////////////////////////////
+#if defined(STU_SIMD_AVX)
+	typedef __m256 simd8f;
+	inline simd8f Load8(const float *p)						{ return _mm256_loadu_ps(p); }
+	inline void Store8(float *p, simd8f a)					{ _mm256_storeu_ps(p, a); }
+	inline simd8f Splat8(float f)							{ return _mm256_set1_ps(f); }
+	inline simd8f Join(simd4f lo, simd4f hi)				{ return _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1); }
+	inline simd4f Low(simd8f a)								{ return _mm256_castps256_ps128(a); }
+	inline simd4f High(simd8f a)							{ return _mm256_extractf128_ps(a, 1); }
+	inline simd8f Add(simd8f a, simd8f b)					{ return _mm256_add_ps(a, b); }
+	inline simd8f Sub(simd8f a, simd8f b)					{ return _mm256_sub_ps(a, b); }
+	inline simd8f Mul(simd8f a, simd8f b)					{ return _mm256_mul_ps(a, b); }
+	inline simd8f Div(simd8f a, simd8f b)					{ return _mm256_div_ps(a, b); }
+	inline simd8f Sqrt(simd8f a)							{ return _mm256_sqrt_ps(a); }
+	inline simd8f KeepIfAtLeast(simd8f a, simd8f b, simd8f value)	{ return _mm256_and_ps(_mm256_cmp_ps(a, b, _CMP_GE_OQ), value); }
+#else
+	struct simd8f { simd4f lo, hi; };
+	inline simd8f Load8(const float *p)						{ simd8f r = { Load4(p), Load4(p + 4) }; return r; }
+	inline void Store8(float *p, simd8f a)					{ Store4(p, a.lo); Store4(p + 4, a.hi); }
+	inline simd8f Splat8(float f)							{ simd8f r = { Splat4(f), Splat4(f) }; return r; }
+	inline simd8f Join(simd4f lo, simd4f hi)				{ simd8f r = { lo, hi }; return r; }
+	inline simd4f Low(simd8f a)								{ return a.lo; }
+	inline simd4f High(simd8f a)							{ return a.hi; }
+	inline simd8f Add(simd8f a, simd8f b)					{ return Join(Add(a.lo, b.lo), Add(a.hi, b.hi)); }
+	inline simd8f Sub(simd8f a, simd8f b)					{ return Join(Sub(a.lo, b.lo), Sub(a.hi, b.hi)); }
+	inline simd8f Mul(simd8f a, simd8f b)					{ return Join(Mul(a.lo, b.lo), Mul(a.hi, b.hi)); }
+	inline simd8f Div(simd8f a, simd8f b)					{ return Join(Div(a.lo, b.lo), Div(a.hi, b.hi)); }
+	inline simd8f Sqrt(simd8f a)							{ return Join(Sqrt(a.lo), Sqrt(a.hi)); }
+	inline simd8f KeepIfAtLeast(simd8f a, simd8f b, simd8f value)
+	{
+		return Join(KeepIfAtLeast(a.lo, b.lo, value.lo), KeepIfAtLeast(a.hi, b.hi, value.hi));
+	}
+#endif
+
+	// Views /////////////////////////////////////////////////////////////////
+	// Where an array of vectors is; vector i is (x[i * stride], y[i * stride], z[i * stride])
+	struct v3fView
+	{
+		float *x, *y, *z;
+		size_t stride;
+
+		inline bool isSeparate() const { return (stride == 1); }
+		inline bool isInterleaved() const { return (y == x + 1) && (z == x + 2); }
+	};
+
+	// The view of an array of structs beginning with float x, y and z, e.g. X3DAUDIO_VECTOR or v3f. The batch functions only
+	// write to the view they are given as their output, so a const array may be viewed as an input
+	template<typename T>
+	inline v3fView MakeView(const T *vectors)
+	{
+		float *x = const_cast<float*>(&vectors->x);
+		v3fView view = { x, x + 1, x + 2, sizeof(T) / sizeof(float) };
+		return view;
+	}
+
+	// The view of separate x, y and z arrays
+	inline v3fView MakeView(const float *x, const float *y, const float *z)
+	{
+		v3fView view = { const_cast<float*>(x), const_cast<float*>(y), const_cast<float*>(z), 1 };
+		return view;
+	}
+
+	// Packs /////////////////////////////////////////////////////////////////
+	// 4 vectors as structure of arrays
+	struct v3f4
+	{
+		simd4f x, y, z;
+
+		// Load vectors first to first + 3 of a view, and store them back
+		static v3f4 Load(const v3fView &view, size_t first);
+		void Store(const v3fView &view, size_t first) const;
+		static inline v3f4 Splat(const v3f &v) { v3f4 r = { Splat4(v.x), Splat4(v.y), Splat4(v.z) }; return r; }
+	};
+
+	// 8 vectors as structure of arrays
+	struct v3f8
+	{
+		simd8f x, y, z;
+
+		static v3f8 Load(const v3fView &view, size_t first);
+		void Store(const v3fView &view, size_t first) const;
+		static inline v3f8 Splat(const v3f &v) { v3f8 r = { Splat8(v.x), Splat8(v.y), Splat8(v.z) }; return r; }
+	};
+
+	// Pack math, for both widths
+	template<typename Pack, typename Lanes>
+	inline Lanes PackDot(const Pack &a, const Pack &b)
+	{
+		return Add(Add(Mul(a.x, b.x), Mul(a.y, b.y)), Mul(a.z, b.z));
+	}
+
+	inline simd4f Dot(const v3f4 &a, const v3f4 &b)			{ return PackDot<v3f4, simd4f>(a, b); }
+	inline simd8f Dot(const v3f8 &a, const v3f8 &b)			{ return PackDot<v3f8, simd8f>(a, b); }
+	inline simd4f Length(const v3f4 &a)						{ return Sqrt(Dot(a, a)); }
+	inline simd8f Length(const v3f8 &a)						{ return Sqrt(Dot(a, a)); }
+
+	template<typename Pack>
+	inline Pack PackLerp(const Pack &a, const Pack &b, const Pack &t)
+	{
+		Pack r = { Add(a.x, Mul(Sub(b.x, a.x), t.x)), Add(a.y, Mul(Sub(b.y, a.y), t.y)), Add(a.z, Mul(Sub(b.z, a.z), t.z)) };
+		return r;
+	}
+
+	inline v3f4 Lerp(const v3f4 &a, const v3f4 &b, float t)	{ v3f4 tt = { Splat4(t), Splat4(t), Splat4(t) }; return PackLerp(a, b, tt); }
+	inline v3f8 Lerp(const v3f8 &a, const v3f8 &b, float t)	{ v3f8 tt = { Splat8(t), Splat8(t), Splat8(t) }; return PackLerp(a, b, tt); }
+
+	// Vectors of near-zero length become zero, as with v3f::Normalise
+	inline v3f4 Normalise(const v3f4 &a)
+	{
+		simd4f magsquared = Dot(a, a);
+		simd4f factor = KeepIfAtLeast(magsquared, Splat4(math::FloatZeroBarrier), Div(Splat4(1.0f), Sqrt(magsquared)));
+		v3f4 r = { Mul(a.x, factor), Mul(a.y, factor), Mul(a.z, factor) };
+		return r;
+	}
+
+	inline v3f8 Normalise(const v3f8 &a)
+	{
+		simd8f magsquared = Dot(a, a);
+		simd8f factor = KeepIfAtLeast(magsquared, Splat8(math::FloatZeroBarrier), Div(Splat8(1.0f), Sqrt(magsquared)));
+		v3f8 r = { Mul(a.x, factor), Mul(a.y, factor), Mul(a.z, factor) };
+		return r;
+	}
+
+	// Batch functions over views of count vectors ///////////////////////////
+	namespace batch
+	{
+		void Dot(const v3fView &a, const v3fView &b, float *out, size_t count);
+		void Distance(const v3fView &a, const v3fView &b, float *out, size_t count);
+		void DistanceSquared(const v3fView &a, const v3fView &b, float *out, size_t count);
+		// The distance of each vector from one point, e.g. of the emitters from the listener
+		void Distance(const v3fView &a, const v3f &point, float *out, size_t count);
+		// In place
+		void Normalise(const v3fView &v, size_t count);
+		// out may be a or b
+		void Lerp(const v3fView &a, const v3fView &b, float t, const v3fView &out, size_t count);
+
+		// The name of the instruction set the batch functions use
+		const char *InstructionSet();
+
+		// The distance between two points of any types beginning with float x, y and z, e.g. X3DAUDIO_VECTOR and v3f,
+		// without converting them to v3f first
+		template<typename A, typename B>
+		inline float Distance(const A &a, const B &b)
+		{
+			float dx = a.x - b.x, dy = a.y - b.y, dz = a.z - b.z;
+			return math::Sqrt(dx*dx + dy*dy + dz*dz);
+		}
+	}
+}//namespace
+#endif // STU_VECTOR3_BATCH_INCLUDED